@@ -80,6 +80,22 @@ PROTO UINT16(*pAPPL_EEPROM_Write)(UINT32 wordaddr);
 *////////////////////////////////////////////////////////////////////////////////////////
 PROTO UINT16(*pAPPL_EEPROM_Reload)(void);
 
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+\brief    This function is called from PDI_Isr (interrupt context) when a mailbox event (see MAILBOX_EVENT_MASK)
+\brief    was latched. It shall only wake up the task calling MainLoop(), the mailbox itself is handled in ECAT_Main.
+\brief    If the pointer is NULL the mailbox events are handled with the next (polled) MainLoop() call.
+*////////////////////////////////////////////////////////////////////////////////////////
+PROTO void (* pAPPL_MbxEventInd)(void);
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+\brief    This function is called first in Sync0_Isr (interrupt context) while DC synchronisation is active,
+\brief    before ECAT_Application(). It is intended for work that has to be aligned to the SYNC0 event (e.g. sampling).
+\brief    If the pointer is NULL nothing is called.
+*////////////////////////////////////////////////////////////////////////////////////////
+PROTO void (* pAPPL_Sync0Ind)(void);
+
 
 
 /*-----------------------------------------------------------------------------------------
@@ -219,7 +219,7 @@ NOTE: The file "EtherCATSampleLibrary.h" includes the library interface (maybe n
 USE_DEFAULT_MAIN: Set to 1 if the main function of a default application shall be used.<br>
 Otherwise the Init functions and the mainloop handler shall be called for a user specific function (see ET9300 Application Note for further details www.beckhoff.com/english.asp?download/ethercat_development_products.htm?id=71003127100387). */
 #ifndef USE_DEFAULT_MAIN
-#define USE_DEFAULT_MAIN                          1 //This define was already evaluated by ET9300 Project Handler(V. 1.3.3.0)!
+#define USE_DEFAULT_MAIN                          0 //This define was already evaluated by ET9300 Project Handler(V. 1.3.3.0)!
 #endif
 
 /** 
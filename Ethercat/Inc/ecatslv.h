@@ -310,6 +310,10 @@ V5.01 : Start file change log
 #define     MAILBOX_READ_EVENT                  ((UINT16) 0x0200) /**< \brief MBoxIn read event*/
 #define     PROCESS_OUTPUT_EVENT                ((UINT16) 0x0400) /**< \brief Output process data write event*/
 #define     PROCESS_INPUT_EVENT                 ((UINT16) 0x0800) /**< \brief Input process data read event*/
+#define     MAILBOX_EVENT_MASK                  ((MAILBOX_WRITE_EVENT) | (MAILBOX_READ_EVENT) | (SM_CHANGE_EVENT)) /**< \brief AL events mapped to the PDI IRQ while the mailbox is running, ECAT_Main handles the mailbox only if one of them was latched*/
+#ifndef MBX_EVENT_POLL_MS
+#define     MBX_EVENT_POLL_MS                   100 /**< \brief Interval in ms (counted in ECAT_CheckTimer) in which all mailbox events are latched without an ESC interrupt, fallback if the ESC IRQ is not connected or an event was missed*/
+#endif
 
 
 #ifndef MAX_PD_SYNC_MAN_CHANNELS
@@ -398,6 +402,8 @@ PROTO UINT16                            LatchInputSync0Counter; /**< \brief Sync
 PROTO BOOL                              bEscIntEnabled; /**< \brief Indicates that the ESC interrupt is enabled (SM2/3 or SYNC0/1-event),
                                                                      will be set in StartInputHandler and reset in StopInputHandler*/
 
+PROTO VARVOLATILE UINT16                u16MbxEventPending; /**< \brief Mailbox events (MAILBOX_EVENT_MASK) latched in PDI_Isr and not yet handled in ECAT_Main*/
+
 PROTO BOOL                              b3BufferMode; /**< \brief Indicates that inputs and outputs are running in 3-Buffer-Mode*/
 
 PROTO BOOL                              bLocalErrorFlag; /**< \brief Contains the information if the application has a local error*/
@@ -28,7 +28,11 @@ V5.01 : Start file change log
 #include  "esc.h"
 
 
+#if defined(STM32F407xx)
+#include "stm32f4xx.h"
+#else
 #include <p24Hxxxx.h>
+#endif
 
 
 /*-----------------------------------------------------------------------------------------
@@ -82,7 +86,11 @@ V5.01 : Start file change log
 -    hardware timer settings
 -----------------------------------------------*/
 
+#if defined(STM32F407xx)
+#define ECAT_TIMER_INC_P_MS                2000 /**< \brief TIM2: 84MHz / (41+1) => 2000 ticks per ms*/
+#else
 #define ECAT_TIMER_INC_P_MS                0x271 /**< \brief 625 ticks per ms*/
+#endif
 
 
 
@@ -90,6 +98,23 @@ V5.01 : Start file change log
 -    Interrupt and Timer defines
 -----------------------------------------------*/
 
+#if defined(STM32F407xx)
+/* STM32: ESC IRQ is connected to PC0 (EXTI0), see HAL_GPIO_EXTI_Callback */
+#ifndef DISABLE_ESC_INT
+#define    DISABLE_ESC_INT()            NVIC_DisableIRQ(EXTI0_IRQn) /**< \brief Disable interrupt source EXTI0*/
+#endif
+#ifndef ENABLE_ESC_INT
+#define    ENABLE_ESC_INT()            NVIC_EnableIRQ(EXTI0_IRQn) /**< \brief Enable interrupt source EXTI0*/
+#endif
+
+#ifndef HW_GetTimer
+#define HW_GetTimer()        ((UINT32)(TIM2->CNT)) /**< \brief Access to the hardware timer (TIM2, see TIM_Configuration)*/
+#endif
+
+#ifndef HW_ClearTimer
+#define HW_ClearTimer()        {(TIM2->CNT) = 0;} /**< \brief Clear the hardware timer*/
+#endif
+#else
 #ifndef DISABLE_ESC_INT
 #define    DISABLE_ESC_INT()            {(_INT1IE)=0;} /**< \brief Disable interrupt source INT1*/
 #endif
@@ -104,6 +129,7 @@ V5.01 : Start file change log
 #ifndef HW_ClearTimer
 #define HW_ClearTimer()        {(TMR7) = 0;} /**< \brief Clear the hardware timer*/
 #endif
+#endif
 
 
 
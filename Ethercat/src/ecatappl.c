@@ -153,6 +153,7 @@ V4.00 APPL 6: The main function was split in MainInit and MainLoop
 UINT16 u16BusCycleCntMs;        //used to calculate the bus cycle time in Ms
 UINT32 StartTimerCnt;    //variable to store the timer register value when get cycle time was triggered
 BOOL bCycleTimeMeasurementStarted; // indicates if the bus cycle measurement is started
+UINT16 u16MbxEventPollCntMs;    //ms since the last timed mailbox event check
 
 UINT16             aPdOutputData[(MAX_PD_OUTPUT_SIZE>>1)];
 UINT16           aPdInputData[(MAX_PD_INPUT_SIZE>>1)];
@@ -216,7 +217,23 @@ void ECAT_CheckTimer(void)
         EsmTimeoutCounter--;
     }
 
+    /*timed fallback of the mailbox events, the mailbox is handled even if PDI_Isr is not called (ESC interrupt not connected)*/
+    if(bMbxRunning)
+    {
+        u16MbxEventPollCntMs++;
+        if(u16MbxEventPollCntMs >= MBX_EVENT_POLL_MS)
+        {
+            u16MbxEventPollCntMs = 0;
 
+            DISABLE_ESC_INT();
+            u16MbxEventPending |= MAILBOX_EVENT_MASK;
+            ENABLE_ESC_INT();
+        }
+    }
+    else
+    {
+        u16MbxEventPollCntMs = 0;
+    }
 
     DC_CheckWatchdog();
 }
@@ -279,12 +296,32 @@ void HandleBusCycleCalculation(void)
 
 void PDI_Isr(void)
 {
-    if(bEscIntEnabled)
+    /* get the AL event register */
+    UINT16  ALEvent = HW_GetALEventRegister_Isr();
+    ALEvent = SWAPWORD(ALEvent);
+
+    if ( ALEvent & MAILBOX_EVENT_MASK )
     {
-        /* get the AL event register */
-        UINT16  ALEvent = HW_GetALEventRegister_Isr();
-        ALEvent = SWAPWORD(ALEvent);
+        /* Mailbox events stay set until the mailbox is read/written in ECAT_Main. Remove them from the AL event mask
+           so that the IRQ line is released; ECAT_Main enables them again after the mailbox was handled */
+        UINT16 mask;
+        HW_EscReadWordIsr(mask, ESC_AL_EVENTMASK_OFFSET);
+        mask &= ~(MAILBOX_EVENT_MASK);
+        HW_EscWriteWordIsr(mask, ESC_AL_EVENTMASK_OFFSET);
+
+        if ( bMbxRunning )
+        {
+            u16MbxEventPending |= (ALEvent & MAILBOX_EVENT_MASK);
 
+            if (pAPPL_MbxEventInd != NULL)
+            {
+                pAPPL_MbxEventInd();
+            }
+        }
+    }
+
+    if(bEscIntEnabled)
+    {
         if ( ALEvent & PROCESS_OUTPUT_EVENT )
         {
             if(bDcRunning && bDcSyncActive)
@@ -373,6 +410,10 @@ void Sync0_Isr(void)
 
     if(bDcSyncActive)
     {
+        if (pAPPL_Sync0Ind != NULL)
+        {
+            pAPPL_Sync0Ind();
+        }
 
         if ( bEcatInputUpdateRunning )
         {
@@ -498,6 +539,12 @@ UINT16 MainInit(void)
 #endif
 /*ECATCHANGE_END(V5.11) EEPROM1*/
 
+    /* no mailbox event indication registered yet (set by the application after MainInit) */
+    pAPPL_MbxEventInd = NULL;
+
+    /* no SYNC0 indication registered yet (set by the application when the input handler is started) */
+    pAPPL_Sync0Ind = NULL;
+
     /* initialize the EtherCAT Slave Interface */
     ECAT_Init();
     /* initialize the objects */
@@ -205,6 +205,8 @@ V4.00 ECAT 7: The return values for the AL-StatusCode were changed to UINT16
 -----------------------------------------------------------------------------------------*/
 UINT16    u16ALEventMask;                      // Value which will be written to the 0x204 register (AL event mask) during the state transition PreOP to SafeOP
 
+BOOL      bMbxEventsEnabled;                   // Indicates that the mailbox events (MAILBOX_EVENT_MASK) are handled via the PDI IRQ
+
 /*Dummy variable to trigger read or writes events in the ESC*/
     VARVOLATILE UINT16    u16dummy;
 
@@ -230,12 +232,13 @@ BOOL EepromLoaded = FALSE;
 void ResetALEventMask(UINT16 intMask)
 {
     UINT16 mask;
-    HW_EscReadWord(mask, ESC_AL_EVENTMASK_OFFSET);
-    
-    mask &= intMask;
 
+    /* PDI_Isr modifies the AL Event Mask, too => the whole read-modify-write has to be done with the ESC interrupt disabled */
     DISABLE_ESC_INT();
 
+    HW_EscReadWord(mask, ESC_AL_EVENTMASK_OFFSET);
+    
+    mask &= intMask;
 
     HW_EscWriteWord(mask, ESC_AL_EVENTMASK_OFFSET);
     ENABLE_ESC_INT();
@@ -250,12 +253,13 @@ void ResetALEventMask(UINT16 intMask)
 void SetALEventMask(UINT16 intMask)
 {
     UINT16 mask;
-    HW_EscReadWord(mask, ESC_AL_EVENTMASK_OFFSET);
-    
-    mask |= intMask;
 
+    /* PDI_Isr modifies the AL Event Mask, too => the whole read-modify-write has to be done with the ESC interrupt disabled */
     DISABLE_ESC_INT();
 
+    HW_EscReadWord(mask, ESC_AL_EVENTMASK_OFFSET);
+    
+    mask |= intMask;
 
     HW_EscWriteWord(mask, ESC_AL_EVENTMASK_OFFSET);
     ENABLE_ESC_INT();
@@ -2366,6 +2370,9 @@ void ECAT_Init(void)
     bEscIntEnabled = FALSE;
 /* ECATCHANGE_END(V5.11) ECAT5*/
 
+    bMbxEventsEnabled = FALSE;
+    u16MbxEventPending = 0;
+
     /* initialize the COE part */
     COE_Init();
 }
@@ -2380,6 +2387,7 @@ void ECAT_Main(void)
     UINT16 ALEventReg;
     UINT16 EscAlControl = 0x0000;
     UINT16 sm1Activate = SM_SETTING_ENABLE_VALUE;
+    UINT16 MbxEvents = 0;
 
     /* check if services are stored in the mailbox */
     MBX_Main();
@@ -2387,17 +2395,43 @@ void ECAT_Main(void)
 
     if ( bMbxRunning )
     {
-        /* Slave is at least in PREOP, Mailbox is running */
-        /* get the Activate-Byte of SM 1 (Register 0x80E) to check if a mailbox repeat request was received */
-        HW_EscReadWord(sm1Activate,(ESC_SYNCMAN_ACTIVE_OFFSET + SIZEOF_SM_REGISTER));
-        sm1Activate = SWAPWORD(sm1Activate);
+        if ( !bMbxEventsEnabled )
+        {
+            /* the mailbox was started, handle all mailbox events once, they will be mapped to the PDI IRQ afterwards */
+            bMbxEventsEnabled = TRUE;
+            MbxEvents = MAILBOX_EVENT_MASK;
+        }
+        else
+        {
+            /* get the mailbox events latched in PDI_Isr */
+            DISABLE_ESC_INT();
+            MbxEvents = u16MbxEventPending;
+            u16MbxEventPending = 0;
+            ENABLE_ESC_INT();
+        }
+
+        if ( MbxEvents != 0 )
+        {
+            /* Slave is at least in PREOP, Mailbox is running */
+            /* get the Activate-Byte of SM 1 (Register 0x80E) to check if a mailbox repeat request was received.
+               The master toggles the Repeat Bit in this register, that sets the SM Change event (0x220:4) which is
+               latched in PDI_Isr (or by the timed fallback in ECAT_CheckTimer), so it is only read if a mailbox event is pending */
+            HW_EscReadWord(sm1Activate,(ESC_SYNCMAN_ACTIVE_OFFSET + SIZEOF_SM_REGISTER));
+            sm1Activate = SWAPWORD(sm1Activate);
+        }
+    }
+    else if ( bMbxEventsEnabled )
+    {
+        /* the mailbox was stopped, the mailbox events shall not trigger the PDI IRQ anymore */
+        bMbxEventsEnabled = FALSE;
+        ResetALEventMask( ~(MAILBOX_EVENT_MASK) );
+        u16MbxEventPending = 0;
     }
 
     /* Read AL Event-Register from ESC */
     ALEventReg = HW_GetALEventRegister();
     ALEventReg = SWAPWORD(ALEventReg);
 
-
     if ((ALEventReg & AL_CONTROL_EVENT) && !bEcatWaitForAlControlRes)
     {
         /* AL Control event is set, get the AL Control register sent by the Master to acknowledge the event
@@ -2434,8 +2468,10 @@ void ECAT_Main(void)
         1. Handle Mailbox Read event
         2. Handle repeat toggle request
         3. Handle Mailbox write event
+      The mailbox events are latched in PDI_Isr or every MBX_EVENT_POLL_MS by ECAT_CheckTimer (ESC interrupt not connected),
+      the mailbox is only handled if one of them is pending
     */
-    if ( bMbxRunning )
+    if ( bMbxRunning && MbxEvents != 0 )
     {
         /*SnycManger change event (0x220:4) could be acknowledged by reading the SM1 control register without notification to the local application
         => check if the SyncManger 1 is still enabled*/
@@ -2492,6 +2528,23 @@ void ECAT_Main(void)
             MBX_CheckAndCopyMailbox();
 
         }
+
+        /* Events which are still set (e.g. the receive mailbox is locked) are handled again with the next call,
+           all other mailbox events are mapped to the PDI IRQ again */
+        ALEventReg = HW_GetALEventRegister();
+        ALEventReg = SWAPWORD(ALEventReg) & MAILBOX_EVENT_MASK;
+
+        if ( ALEventReg != 0 )
+        {
+            DISABLE_ESC_INT();
+            u16MbxEventPending |= ALEventReg;
+            ENABLE_ESC_INT();
+        }
+
+        if ( ALEventReg != MAILBOX_EVENT_MASK )
+        {
+            SetALEventMask( MAILBOX_EVENT_MASK & ~ALEventReg );
+        }
     }
 }
 
@@ -118,6 +118,7 @@
 #define configUSE_NEWLIB_REENTRANT               0
 #define configENABLE_BACKWARD_COMPATIBILITY      0
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS  5
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    2   /* 下标1: EtherCAT输出监控字段变化 */
 
 /* ========================================================================== */
 /* 中断嵌套配置 (关键for EtherCAT) */
@@ -1,412 +0,0 @@
-/*
-* This source file is part of the EtherCAT Slave Stack Code licensed by Beckhoff Automation GmbH & Co KG, 33415 Verl, Germany.
-* The corresponding license agreement applies. This hint shall not be removed.
-*/
-
-/**
-* \addtogroup SSC-Device SSC-Device
-* @{
-*/
-
-/**
-\file SSC-DeviceObjects
-\author ET9300Utilities.ApplicationHandler (Version 1.5.0.0) | EthercatSSC@beckhoff.com
-
-\brief SSC-Device specific objects<br>
-\brief NOTE : This file will be overwritten if a new object dictionary is generated!<br>
-*/
-
-#if defined(_SSC_DEVICE_) && (_SSC_DEVICE_ == 1)
-#define PROTO
-#else
-#define PROTO extern
-#endif
-/******************************************************************************
-*                    Object 0x1601 : Output mapping 1
-******************************************************************************/
-/**
-* \addtogroup 0x1601 0x1601 | Output mapping 1
-* @{
-* \brief Object 0x1601 (Output mapping 1) definition
-*/
-#ifdef _OBJD_
-/**
-* \brief Object entry descriptions<br>
-* <br>
-* SubIndex 0<br>
-* SubIndex 1 - Reference to 0x7010.1<br>
-* SubIndex 2 - Reference to 0x7010.2<br>
-*/
-OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x1601[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex1 - Reference to 0x7010.1 */
-{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }}; /* Subindex2 - Reference to 0x7010.2 */
-
-/**
-* \brief Object/Entry names
-*/
-OBJCONST UCHAR OBJMEM aName0x1601[] = "Output mapping 1\000"
-"SubIndex 001\000"
-"SubIndex 002\000\377";
-#endif //#ifdef _OBJD_
-
-#ifndef _SSC_DEVICE_OBJECTS_H_
-/**
-* \brief Object structure
-*/
-typedef struct OBJ_STRUCT_PACKED_START {
-UINT16 u16SubIndex0;
-UINT32 SI1; /* Subindex1 - Reference to 0x7010.1 */
-UINT32 SI2; /* Subindex2 - Reference to 0x7010.2 */
-} OBJ_STRUCT_PACKED_END
-TOBJ1601;
-#endif //#ifndef _SSC_DEVICE_OBJECTS_H_
-
-/**
-* \brief Object variable
-*/
-PROTO TOBJ1601 OutputMapping10x1601
-#if defined(_SSC_DEVICE_) && (_SSC_DEVICE_ == 1)
-={2,0x70100101,0x70100201}
-#endif
-;
-/** @}*/
-
-
-
-/******************************************************************************
-*                    Object 0x1A00 : Input mapping 0
-******************************************************************************/
-/**
-* \addtogroup 0x1A00 0x1A00 | Input mapping 0
-* @{
-* \brief Object 0x1A00 (Input mapping 0) definition
-*/
-#ifdef _OBJD_
-/**
-* \brief Object entry descriptions<br>
-* <br>
-* SubIndex 0<br>
-* SubIndex 1 - Reference to 0x6000.1<br>
-* SubIndex 2 - Reference to 0x6000.2<br>
-*/
-OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x1A00[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex1 - Reference to 0x6000.1 */
-{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }}; /* Subindex2 - Reference to 0x6000.2 */
-
-/**
-* \brief Object/Entry names
-*/
-OBJCONST UCHAR OBJMEM aName0x1A00[] = "Input mapping 0\000"
-"SubIndex 001\000"
-"SubIndex 002\000\377";
-#endif //#ifdef _OBJD_
-
-#ifndef _SSC_DEVICE_OBJECTS_H_
-/**
-* \brief Object structure
-*/
-typedef struct OBJ_STRUCT_PACKED_START {
-UINT16 u16SubIndex0;
-UINT32 SI1; /* Subindex1 - Reference to 0x6000.1 */
-UINT32 SI2; /* Subindex2 - Reference to 0x6000.2 */
-} OBJ_STRUCT_PACKED_END
-TOBJ1A00;
-#endif //#ifndef _SSC_DEVICE_OBJECTS_H_
-
-/**
-* \brief Object variable
-*/
-PROTO TOBJ1A00 InputMapping00x1A00
-#if defined(_SSC_DEVICE_) && (_SSC_DEVICE_ == 1)
-={2,0x60000101,0x60000201}
-#endif
-;
-/** @}*/
-
-
-
-/******************************************************************************
-*                    Object 0x1C12 : SyncManager 2 assignment
-******************************************************************************/
-/**
-* \addtogroup 0x1C12 0x1C12 | SyncManager 2 assignment
-* @{
-* \brief Object 0x1C12 (SyncManager 2 assignment) definition
-*/
-#ifdef _OBJD_
-/**
-* \brief Entry descriptions<br>
-* 
-* Subindex 0<br>
-* Subindex 1 - n (the same entry description is used)<br>
-*/
-OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x1C12[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ }};
-
-/**
-* \brief Object name definition<br>
-* For Subindex 1 to n the syntax 'Subindex XXX' is used
-*/
-OBJCONST UCHAR OBJMEM aName0x1C12[] = "SyncManager 2 assignment\000\377";
-#endif //#ifdef _OBJD_
-
-#ifndef _SSC_DEVICE_OBJECTS_H_
-/**
-* \brief Object structure
-*/
-typedef struct OBJ_STRUCT_PACKED_START {
-UINT16   u16SubIndex0;  /**< \brief Subindex 0 */
-UINT16 aEntries[1];  /**< \brief Subindex 1 - 1 */
-} OBJ_STRUCT_PACKED_END
-TOBJ1C12;
-#endif //#ifndef _SSC_DEVICE_OBJECTS_H_
-
-/**
-* \brief Object variable
-*/
-PROTO TOBJ1C12 sRxPDOassign
-#if defined(_SSC_DEVICE_) && (_SSC_DEVICE_ == 1)
-={1,{0x1601}}
-#endif
-;
-/** @}*/
-
-
-
-/******************************************************************************
-*                    Object 0x1C13 : SyncManager 3 assignment
-******************************************************************************/
-/**
-* \addtogroup 0x1C13 0x1C13 | SyncManager 3 assignment
-* @{
-* \brief Object 0x1C13 (SyncManager 3 assignment) definition
-*/
-#ifdef _OBJD_
-/**
-* \brief Entry descriptions<br>
-* 
-* Subindex 0<br>
-* Subindex 1 - n (the same entry description is used)<br>
-*/
-OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x1C13[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ }};
-
-/**
-* \brief Object name definition<br>
-* For Subindex 1 to n the syntax 'Subindex XXX' is used
-*/
-OBJCONST UCHAR OBJMEM aName0x1C13[] = "SyncManager 3 assignment\000\377";
-#endif //#ifdef _OBJD_
-
-#ifndef _SSC_DEVICE_OBJECTS_H_
-/**
-* \brief Object structure
-*/
-typedef struct OBJ_STRUCT_PACKED_START {
-UINT16   u16SubIndex0;  /**< \brief Subindex 0 */
-UINT16 aEntries[1];  /**< \brief Subindex 1 - 1 */
-} OBJ_STRUCT_PACKED_END
-TOBJ1C13;
-#endif //#ifndef _SSC_DEVICE_OBJECTS_H_
-
-/**
-* \brief Object variable
-*/
-PROTO TOBJ1C13 sTxPDOassign
-#if defined(_SSC_DEVICE_) && (_SSC_DEVICE_ == 1)
-={1,{0x1A00}}
-#endif
-;
-/** @}*/
-
-
-
-/******************************************************************************
-*                    Object 0x6000 : Obj0x6000
-******************************************************************************/
-/**
-* \addtogroup 0x6000 0x6000 | Obj0x6000
-* @{
-* \brief Object 0x6000 (Obj0x6000) definition
-*/
-#ifdef _OBJD_
-/**
-* \brief Object entry descriptions<br>
-* <br>
-* SubIndex 0<br>
-* SubIndex 1 - switch1<br>
-* SubIndex 2 - switch2<br>
-*/
-OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x6000[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_BOOLEAN , 0x01 , ACCESS_READ }, /* Subindex1 - switch1 */
-{ DEFTYPE_BOOLEAN , 0x01 , ACCESS_READ }}; /* Subindex2 - switch2 */
-
-/**
-* \brief Object/Entry names
-*/
-OBJCONST UCHAR OBJMEM aName0x6000[] = "Obj0x6000\000"
-"switch1\000"
-"switch2\000\377";
-#endif //#ifdef _OBJD_
-
-#ifndef _SSC_DEVICE_OBJECTS_H_
-/**
-* \brief Object structure
-*/
-typedef struct OBJ_STRUCT_PACKED_START {
-UINT16 u16SubIndex0;
-BOOLEAN(Switch1); /* Subindex1 - switch1 */
-BOOLEAN(Switch2); /* Subindex2 - switch2 */
-} OBJ_STRUCT_PACKED_END
-TOBJ6000;
-#endif //#ifndef _SSC_DEVICE_OBJECTS_H_
-
-/**
-* \brief Object variable
-*/
-PROTO TOBJ6000 Obj0x6000
-#if defined(_SSC_DEVICE_) && (_SSC_DEVICE_ == 1)
-={2,0,0}
-#endif
-;
-/** @}*/
-
-
-
-/******************************************************************************
-*                    Object 0x7010 : Obj0x7010
-******************************************************************************/
-/**
-* \addtogroup 0x7010 0x7010 | Obj0x7010
-* @{
-* \brief Object 0x7010 (Obj0x7010) definition
-*/
-#ifdef _OBJD_
-/**
-* \brief Object entry descriptions<br>
-* <br>
-* SubIndex 0<br>
-* SubIndex 1 - led1<br>
-* SubIndex 2 - led2<br>
-*/
-OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x7010[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_BOOLEAN , 0x01 , ACCESS_READ }, /* Subindex1 - led1 */
-{ DEFTYPE_BOOLEAN , 0x01 , ACCESS_READ }}; /* Subindex2 - led2 */
-
-/**
-* \brief Object/Entry names
-*/
-OBJCONST UCHAR OBJMEM aName0x7010[] = "Obj0x7010\000"
-"led1\000"
-"led2\000\377";
-#endif //#ifdef _OBJD_
-
-#ifndef _SSC_DEVICE_OBJECTS_H_
-/**
-* \brief Object structure
-*/
-typedef struct OBJ_STRUCT_PACKED_START {
-UINT16 u16SubIndex0;
-BOOLEAN(Led1); /* Subindex1 - led1 */
-BOOLEAN(Led2); /* Subindex2 - led2 */
-} OBJ_STRUCT_PACKED_END
-TOBJ7010;
-#endif //#ifndef _SSC_DEVICE_OBJECTS_H_
-
-/**
-* \brief Object variable
-*/
-PROTO TOBJ7010 Obj0x7010
-#if defined(_SSC_DEVICE_) && (_SSC_DEVICE_ == 1)
-={2,0,0}
-#endif
-;
-/** @}*/
-
-
-
-/******************************************************************************
-*                    Object 0xF000 : Modular Device Profile
-******************************************************************************/
-/**
-* \addtogroup 0xF000 0xF000 | Modular Device Profile
-* @{
-* \brief Object 0xF000 (Modular Device Profile) definition
-*/
-#ifdef _OBJD_
-/**
-* \brief Object entry descriptions<br>
-* <br>
-* SubIndex 0<br>
-* SubIndex 1 - Index distance <br>
-* SubIndex 2 - Maximum number of modules <br>
-*/
-OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0xF000[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ }, /* Subindex1 - Index distance  */
-{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ }}; /* Subindex2 - Maximum number of modules  */
-
-/**
-* \brief Object/Entry names
-*/
-OBJCONST UCHAR OBJMEM aName0xF000[] = "Modular Device Profile\000"
-"Index distance \000"
-"Maximum number of modules \000\377";
-#endif //#ifdef _OBJD_
-
-#ifndef _SSC_DEVICE_OBJECTS_H_
-/**
-* \brief Object structure
-*/
-typedef struct OBJ_STRUCT_PACKED_START {
-UINT16 u16SubIndex0;
-UINT16 IndexDistance; /* Subindex1 - Index distance  */
-UINT16 MaximumNumberOfModules; /* Subindex2 - Maximum number of modules  */
-} OBJ_STRUCT_PACKED_END
-TOBJF000;
-#endif //#ifndef _SSC_DEVICE_OBJECTS_H_
-
-/**
-* \brief Object variable
-*/
-PROTO TOBJF000 ModularDeviceProfile0xF000
-#if defined(_SSC_DEVICE_) && (_SSC_DEVICE_ == 1)
-={2,0x0010,0}
-#endif
-;
-/** @}*/
-
-
-
-
-
-
-
-#ifdef _OBJD_
-TOBJECT    OBJMEM ApplicationObjDic[] = {
-/* Object 0x1601 */
-{NULL , NULL ,  0x1601 , {DEFTYPE_PDOMAPPING , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x1601 , aName0x1601 , &OutputMapping10x1601 , NULL , NULL , 0x0000 },
-/* Object 0x1A00 */
-{NULL , NULL ,  0x1A00 , {DEFTYPE_PDOMAPPING , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x1A00 , aName0x1A00 , &InputMapping00x1A00 , NULL , NULL , 0x0000 },
-/* Object 0x1C12 */
-{NULL , NULL ,  0x1C12 , {DEFTYPE_UNSIGNED16 , 1 | (OBJCODE_ARR << 8)} , asEntryDesc0x1C12 , aName0x1C12 , &sRxPDOassign , NULL , NULL , 0x0000 },
-/* Object 0x1C13 */
-{NULL , NULL ,  0x1C13 , {DEFTYPE_UNSIGNED16 , 1 | (OBJCODE_ARR << 8)} , asEntryDesc0x1C13 , aName0x1C13 , &sTxPDOassign , NULL , NULL , 0x0000 },
-/* Object 0x6000 */
-{NULL , NULL ,  0x6000 , {DEFTYPE_RECORD , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x6000 , aName0x6000 , &Obj0x6000 , NULL , NULL , 0x0000 },
-/* Object 0x7010 */
-{NULL , NULL ,  0x7010 , {DEFTYPE_RECORD , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x7010 , aName0x7010 , &Obj0x7010 , NULL , NULL , 0x0000 },
-/* Object 0xF000 */
-{NULL , NULL ,  0xF000 , {DEFTYPE_RECORD , 2 | (OBJCODE_REC << 8)} , asEntryDesc0xF000 , aName0xF000 , &ModularDeviceProfile0xF000 , NULL , NULL , 0x0000 },
-{NULL,NULL, 0xFFFF, {0, 0}, NULL, NULL, NULL, NULL}};
-#endif    //#ifdef _OBJD_
-#undef PROTO
-
-/** @}*/
-#define _SSC_DEVICE_OBJECTS_H_
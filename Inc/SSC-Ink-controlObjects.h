@@ -69,6 +69,97 @@ PROTO TOBJ1600 NumberOfEntriesProcessDataMapping0x1600
 
 
 
+/******************************************************************************
+*                    Object 0x1601 : Master output mapping
+******************************************************************************/
+/**
+* \addtogroup 0x1601 0x1601 | Master output mapping
+* @{
+* \brief Object 0x1601 (Master output mapping) definition<br>
+* Optional RxPDO, assigned in PREOP via 0x1C12. The entries follow OutputField_t,
+* every received frame is latched into the output monitor (see APPL_OutputMapping)
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Reference to 0x7010.1<br>
+* SubIndex 2 - Reference to 0x7010.2<br>
+* SubIndex 3 - Reference to 0x7010.3<br>
+* SubIndex 4 - Reference to 0x7010.4<br>
+* SubIndex 5 - Reference to 0x7010.5<br>
+* SubIndex 6 - Reference to 0x7010.6<br>
+* SubIndex 7 - Reference to 0x7010.7<br>
+* SubIndex 8 - Reference to 0x7010.8<br>
+* SubIndex 9 - Reference to 0x7010.9<br>
+* SubIndex 10 - Reference to 0x7010.10<br>
+* SubIndex 11 - Reference to 0x7010.11<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x1601[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex1 - Reference to 0x7010.1 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex2 - Reference to 0x7010.2 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex3 - Reference to 0x7010.3 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex4 - Reference to 0x7010.4 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex5 - Reference to 0x7010.5 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex6 - Reference to 0x7010.6 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex7 - Reference to 0x7010.7 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex8 - Reference to 0x7010.8 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex9 - Reference to 0x7010.9 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex10 - Reference to 0x7010.10 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }}; /* Subindex11 - Reference to 0x7010.11 */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x1601[] = "Master output mapping\000"
+"SubIndex 001\000"
+"SubIndex 002\000"
+"SubIndex 003\000"
+"SubIndex 004\000"
+"SubIndex 005\000"
+"SubIndex 006\000"
+"SubIndex 007\000"
+"SubIndex 008\000"
+"SubIndex 009\000"
+"SubIndex 010\000"
+"SubIndex 011\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT32 SI1; /* Subindex1 - Reference to 0x7010.1 */
+UINT32 SI2; /* Subindex2 - Reference to 0x7010.2 */
+UINT32 SI3; /* Subindex3 - Reference to 0x7010.3 */
+UINT32 SI4; /* Subindex4 - Reference to 0x7010.4 */
+UINT32 SI5; /* Subindex5 - Reference to 0x7010.5 */
+UINT32 SI6; /* Subindex6 - Reference to 0x7010.6 */
+UINT32 SI7; /* Subindex7 - Reference to 0x7010.7 */
+UINT32 SI8; /* Subindex8 - Reference to 0x7010.8 */
+UINT32 SI9; /* Subindex9 - Reference to 0x7010.9 */
+UINT32 SI10; /* Subindex10 - Reference to 0x7010.10 */
+UINT32 SI11; /* Subindex11 - Reference to 0x7010.11 */
+} OBJ_STRUCT_PACKED_END
+TOBJ1601;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ1601 MasterOutputMapping0x1601
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={11,0x70100110,0x70100210,0x70100310,0x70100410,0x70100510,0x70100610,0x70100710,0x70100810,0x70100910,0x70100A10,0x70100B10}
+#endif
+;
+/** @}*/
+
+
+
 /******************************************************************************
 *                    Object 0x1A00 : Input mapping 0
 ******************************************************************************/
@@ -214,6 +305,121 @@ PROTO TOBJ1A00 InputMapping00x1A00
 
 
 
+/******************************************************************************
+*                    Object 0x1A01 : Oversampling input mapping
+******************************************************************************/
+/**
+* \addtogroup 0x1A01 0x1A01 | Oversampling input mapping
+* @{
+* \brief Object 0x1A01 (Oversampling input mapping) definition<br>
+* The entries are generated from the oversampling settings (0x8010) and are
+* rebuilt on every write to 0x8010: 0x6010.1, 0x6010.2, then factor entries
+* of 0x6011 and (with a second channel) factor entries of 0x6012
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Mapping entry 1<br>
+* SubIndex 2 - Mapping entry 2<br>
+* SubIndex 3 - Mapping entry 3<br>
+* SubIndex 4 - Mapping entry 4<br>
+* SubIndex 5 - Mapping entry 5<br>
+* SubIndex 6 - Mapping entry 6<br>
+* SubIndex 7 - Mapping entry 7<br>
+* SubIndex 8 - Mapping entry 8<br>
+* SubIndex 9 - Mapping entry 9<br>
+* SubIndex 10 - Mapping entry 10<br>
+* SubIndex 11 - Mapping entry 11<br>
+* SubIndex 12 - Mapping entry 12<br>
+* SubIndex 13 - Mapping entry 13<br>
+* SubIndex 14 - Mapping entry 14<br>
+* SubIndex 15 - Mapping entry 15<br>
+* SubIndex 16 - Mapping entry 16<br>
+* SubIndex 17 - Mapping entry 17<br>
+* SubIndex 18 - Mapping entry 18<br>
+* SubIndex 19 - Mapping entry 19<br>
+* SubIndex 20 - Mapping entry 20<br>
+* SubIndex 21 - Mapping entry 21<br>
+* SubIndex 22 - Mapping entry 22<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x1A01[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex1 - Mapping entry 1 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex2 - Mapping entry 2 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex3 - Mapping entry 3 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex4 - Mapping entry 4 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex5 - Mapping entry 5 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex6 - Mapping entry 6 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex7 - Mapping entry 7 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex8 - Mapping entry 8 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex9 - Mapping entry 9 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex10 - Mapping entry 10 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex11 - Mapping entry 11 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex12 - Mapping entry 12 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex13 - Mapping entry 13 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex14 - Mapping entry 14 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex15 - Mapping entry 15 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex16 - Mapping entry 16 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex17 - Mapping entry 17 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex18 - Mapping entry 18 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex19 - Mapping entry 19 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex20 - Mapping entry 20 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex21 - Mapping entry 21 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }}; /* Subindex22 - Mapping entry 22 */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x1A01[] = "Oversampling input mapping\000"
+"SubIndex 001\000"
+"SubIndex 002\000"
+"SubIndex 003\000"
+"SubIndex 004\000"
+"SubIndex 005\000"
+"SubIndex 006\000"
+"SubIndex 007\000"
+"SubIndex 008\000"
+"SubIndex 009\000"
+"SubIndex 010\000"
+"SubIndex 011\000"
+"SubIndex 012\000"
+"SubIndex 013\000"
+"SubIndex 014\000"
+"SubIndex 015\000"
+"SubIndex 016\000"
+"SubIndex 017\000"
+"SubIndex 018\000"
+"SubIndex 019\000"
+"SubIndex 020\000"
+"SubIndex 021\000"
+"SubIndex 022\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT32 aEntries[22]; /* Subindex1 - 22 (2 + 10 samples x 2 channels) */
+} OBJ_STRUCT_PACKED_END
+TOBJ1A01;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ1A01 OversamplingInputMapping0x1A01
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={3,{0x60100120,0x60100210,0x60110110}}
+#endif
+;
+/** @}*/
+
+
+
 /******************************************************************************
 *                    Object 0x1C12 : SyncManager 2 assignment
 ******************************************************************************/
@@ -230,8 +436,8 @@ PROTO TOBJ1A00 InputMapping00x1A00
 * Subindex 1 - n (the same entry description is used)<br>
 */
 OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x1C12[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ }};
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ | ACCESS_WRITE_PREOP },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ | ACCESS_WRITE_PREOP }};
 
 /**
 * \brief Object name definition<br>
@@ -246,7 +452,7 @@ OBJCONST UCHAR OBJMEM aName0x1C12[] = "SyncManager 2 assignment\000\377";
 */
 typedef struct OBJ_STRUCT_PACKED_START {
 UINT16   u16SubIndex0;  /**< \brief Subindex 0 */
-UINT16 aEntries[1];  /**< \brief Subindex 1 - 1 */
+UINT16 aEntries[2];  /**< \brief Subindex 1 - 2 */
 } OBJ_STRUCT_PACKED_END
 TOBJ1C12;
 #endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
@@ -256,7 +462,7 @@ TOBJ1C12;
 */
 PROTO TOBJ1C12 sRxPDOassign
 #if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
-={1,{0x1600}}
+={1,{0x1600,0x0000}}
 #endif
 ;
 /** @}*/
@@ -279,8 +485,8 @@ PROTO TOBJ1C12 sRxPDOassign
 * Subindex 1 - n (the same entry description is used)<br>
 */
 OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x1C13[] = {
-{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
-{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ }};
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ | ACCESS_WRITE_PREOP },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ | ACCESS_WRITE_PREOP }};
 
 /**
 * \brief Object name definition<br>
@@ -295,7 +501,7 @@ OBJCONST UCHAR OBJMEM aName0x1C13[] = "SyncManager 3 assignment\000\377";
 */
 typedef struct OBJ_STRUCT_PACKED_START {
 UINT16   u16SubIndex0;  /**< \brief Subindex 0 */
-UINT16 aEntries[1];  /**< \brief Subindex 1 - 1 */
+UINT16 aEntries[2];  /**< \brief Subindex 1 - 2 */
 } OBJ_STRUCT_PACKED_END
 TOBJ1C13;
 #endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
@@ -305,7 +511,468 @@ TOBJ1C13;
 */
 PROTO TOBJ1C13 sTxPDOassign
 #if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
-={1,{0x1A00}}
+={1,{0x1A00,0x0000}}
+#endif
+;
+/** @}*/
+
+
+
+/******************************************************************************
+*                    Object 0x2000 : Sensor statistics
+******************************************************************************/
+/**
+* \addtogroup 0x2000 0x2000 | Sensor statistics
+* @{
+* \brief Object 0x2000 (Sensor statistics) definition<br>
+* Subindex 1 selects the sensor channel (sensor_type_t), the other entries are refreshed
+* from the streaming statistics of that channel on every read (see Read0x2000)
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Channel select<br>
+* SubIndex 2 - Sample count<br>
+* SubIndex 3 - Mean<br>
+* SubIndex 4 - Standard deviation<br>
+* SubIndex 5 - Minimum<br>
+* SubIndex 6 - Maximum<br>
+* SubIndex 7 - Window minimum<br>
+* SubIndex 8 - Window maximum<br>
+* SubIndex 9 - Percentile 50<br>
+* SubIndex 10 - Percentile 95<br>
+* SubIndex 11 - Percentile 99<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x2000[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE }, /* Subindex1 - Channel select */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex2 - Sample count */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex3 - Mean */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex4 - Standard deviation */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex5 - Minimum */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex6 - Maximum */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex7 - Window minimum */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex8 - Window maximum */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex9 - Percentile 50 */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex10 - Percentile 95 */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }}; /* Subindex11 - Percentile 99 */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x2000[] = "Sensor statistics\000"
+"Channel select\000"
+"Sample count\000"
+"Mean\000"
+"Standard deviation\000"
+"Minimum\000"
+"Maximum\000"
+"Window minimum\000"
+"Window maximum\000"
+"Percentile 50\000"
+"Percentile 95\000"
+"Percentile 99\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT16 ChannelSelect; /* Subindex1 - Channel select */
+UINT32 SampleCount; /* Subindex2 - Sample count */
+float Mean; /* Subindex3 - Mean */
+float StandardDeviation; /* Subindex4 - Standard deviation */
+float Minimum; /* Subindex5 - Minimum */
+float Maximum; /* Subindex6 - Maximum */
+float WindowMinimum; /* Subindex7 - Window minimum */
+float WindowMaximum; /* Subindex8 - Window maximum */
+float Percentile50; /* Subindex9 - Percentile 50 */
+float Percentile95; /* Subindex10 - Percentile 95 */
+float Percentile99; /* Subindex11 - Percentile 99 */
+} OBJ_STRUCT_PACKED_END
+TOBJ2000;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object read function (refreshes the entries from the selected channel)
+*/
+PROTO UINT8 Read0x2000( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess );
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ2000 SensorStatistics0x2000
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={11,0,0,0.0f,0.0f,0.0f,0.0f,0.0f,0.0f,0.0f,0.0f,0.0f}
+#endif
+;
+/** @}*/
+
+
+
+/******************************************************************************
+*                    Object 0x2001 : Loop latency
+******************************************************************************/
+/**
+* \addtogroup 0x2001 0x2001 | Loop latency
+* @{
+* \brief Object 0x2001 (Loop latency) definition<br>
+* Subindex 1 selects the control loop (control_loop_t), the other entries are refreshed
+* from the sample-to-output latency trace of that loop on every read (see Read0x2001).
+* Times are in us, measured from the acquisition of the input sample. "Control" ends when
+* the loop output is computed, "Output" when it is written to the actuator hardware.
+* Output histogram k counts latencies in [2^(k-1), 2^k) us, bin 0 < 1 us, the last bin
+* holds everything longer.
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Loop select<br>
+* SubIndex 2 - Control sample count<br>
+* SubIndex 3 - Control minimum<br>
+* SubIndex 4 - Control mean<br>
+* SubIndex 5 - Control maximum<br>
+* SubIndex 6 - Output sample count<br>
+* SubIndex 7 - Output minimum<br>
+* SubIndex 8 - Output mean<br>
+* SubIndex 9 - Output maximum<br>
+* SubIndex 10 - Output histogram 0<br>
+* SubIndex 11 - Output histogram 1<br>
+* SubIndex 12 - Output histogram 2<br>
+* SubIndex 13 - Output histogram 3<br>
+* SubIndex 14 - Output histogram 4<br>
+* SubIndex 15 - Output histogram 5<br>
+* SubIndex 16 - Output histogram 6<br>
+* SubIndex 17 - Output histogram 7<br>
+* SubIndex 18 - Output histogram 8<br>
+* SubIndex 19 - Output histogram 9<br>
+* SubIndex 20 - Output histogram 10<br>
+* SubIndex 21 - Output histogram 11<br>
+* SubIndex 22 - Output histogram 12<br>
+* SubIndex 23 - Output histogram 13<br>
+* SubIndex 24 - Output histogram 14<br>
+* SubIndex 25 - Output histogram 15<br>
+* SubIndex 26 - Output histogram 16<br>
+* SubIndex 27 - Output histogram 17<br>
+* SubIndex 28 - Output histogram 18<br>
+* SubIndex 29 - Output histogram 19<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x2001[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE }, /* Subindex1 - Loop select */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex2 - Control sample count */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex3 - Control minimum */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex4 - Control mean */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex5 - Control maximum */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex6 - Output sample count */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex7 - Output minimum */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex8 - Output mean */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex9 - Output maximum */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex10 - Output histogram 0 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex11 - Output histogram 1 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex12 - Output histogram 2 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex13 - Output histogram 3 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex14 - Output histogram 4 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex15 - Output histogram 5 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex16 - Output histogram 6 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex17 - Output histogram 7 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex18 - Output histogram 8 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex19 - Output histogram 9 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex20 - Output histogram 10 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex21 - Output histogram 11 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex22 - Output histogram 12 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex23 - Output histogram 13 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex24 - Output histogram 14 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex25 - Output histogram 15 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex26 - Output histogram 16 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex27 - Output histogram 17 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex28 - Output histogram 18 */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }}; /* Subindex29 - Output histogram 19 */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x2001[] = "Loop latency\000"
+"Loop select\000"
+"Control sample count\000"
+"Control minimum\000"
+"Control mean\000"
+"Control maximum\000"
+"Output sample count\000"
+"Output minimum\000"
+"Output mean\000"
+"Output maximum\000"
+"Output histogram 0\000"
+"Output histogram 1\000"
+"Output histogram 2\000"
+"Output histogram 3\000"
+"Output histogram 4\000"
+"Output histogram 5\000"
+"Output histogram 6\000"
+"Output histogram 7\000"
+"Output histogram 8\000"
+"Output histogram 9\000"
+"Output histogram 10\000"
+"Output histogram 11\000"
+"Output histogram 12\000"
+"Output histogram 13\000"
+"Output histogram 14\000"
+"Output histogram 15\000"
+"Output histogram 16\000"
+"Output histogram 17\000"
+"Output histogram 18\000"
+"Output histogram 19\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT16 LoopSelect; /* Subindex1 - Loop select */
+UINT32 ControlSampleCount; /* Subindex2 - Control sample count */
+float ControlMinimum; /* Subindex3 - Control minimum */
+float ControlMean; /* Subindex4 - Control mean */
+float ControlMaximum; /* Subindex5 - Control maximum */
+UINT32 OutputSampleCount; /* Subindex6 - Output sample count */
+float OutputMinimum; /* Subindex7 - Output minimum */
+float OutputMean; /* Subindex8 - Output mean */
+float OutputMaximum; /* Subindex9 - Output maximum */
+UINT32 OutputHistogram0; /* Subindex10 - Output histogram 0 */
+UINT32 OutputHistogram1; /* Subindex11 - Output histogram 1 */
+UINT32 OutputHistogram2; /* Subindex12 - Output histogram 2 */
+UINT32 OutputHistogram3; /* Subindex13 - Output histogram 3 */
+UINT32 OutputHistogram4; /* Subindex14 - Output histogram 4 */
+UINT32 OutputHistogram5; /* Subindex15 - Output histogram 5 */
+UINT32 OutputHistogram6; /* Subindex16 - Output histogram 6 */
+UINT32 OutputHistogram7; /* Subindex17 - Output histogram 7 */
+UINT32 OutputHistogram8; /* Subindex18 - Output histogram 8 */
+UINT32 OutputHistogram9; /* Subindex19 - Output histogram 9 */
+UINT32 OutputHistogram10; /* Subindex20 - Output histogram 10 */
+UINT32 OutputHistogram11; /* Subindex21 - Output histogram 11 */
+UINT32 OutputHistogram12; /* Subindex22 - Output histogram 12 */
+UINT32 OutputHistogram13; /* Subindex23 - Output histogram 13 */
+UINT32 OutputHistogram14; /* Subindex24 - Output histogram 14 */
+UINT32 OutputHistogram15; /* Subindex25 - Output histogram 15 */
+UINT32 OutputHistogram16; /* Subindex26 - Output histogram 16 */
+UINT32 OutputHistogram17; /* Subindex27 - Output histogram 17 */
+UINT32 OutputHistogram18; /* Subindex28 - Output histogram 18 */
+UINT32 OutputHistogram19; /* Subindex29 - Output histogram 19 */
+} OBJ_STRUCT_PACKED_END
+TOBJ2001;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object read function (refreshes the entries from the selected loop)
+*/
+PROTO UINT8 Read0x2001( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess );
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ2001 LoopLatency0x2001
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={29,0,0,0.0f,0.0f,0.0f,0,0.0f,0.0f,0.0f,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
+#endif
+;
+/** @}*/
+
+
+
+/******************************************************************************
+*                    Object 0x2002 : Loop KPI
+******************************************************************************/
+/**
+* \addtogroup 0x2002 0x2002 | Loop KPI
+* @{
+* \brief Object 0x2002 (Loop KPI) definition<br>
+* Subindex 1 selects the control loop (control_loop_t), the other entries are the control
+* performance indicators of that loop, refreshed by the control task every supervision cycle
+* (see Read0x2002). IAE/ISE/ITAE, oscillation index and saturation cover the sliding window
+* (10 s, 60 s for the temperature loops), overshoot (%) and settling time (s) refer to the
+* most recent setpoint step. The oscillation index is the number of error oscillation periods
+* within the window, saturation the fraction of the window with the output at a limit.
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Loop select<br>
+* SubIndex 2 - Sample count<br>
+* SubIndex 3 - Window time<br>
+* SubIndex 4 - IAE<br>
+* SubIndex 5 - ISE<br>
+* SubIndex 6 - ITAE<br>
+* SubIndex 7 - Overshoot<br>
+* SubIndex 8 - Settling time<br>
+* SubIndex 9 - Settled<br>
+* SubIndex 10 - Oscillation index<br>
+* SubIndex 11 - Saturation<br>
+* SubIndex 12 - Step count<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x2002[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE }, /* Subindex1 - Loop select */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex2 - Sample count */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex3 - Window time */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex4 - IAE */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex5 - ISE */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex6 - ITAE */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex7 - Overshoot */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex8 - Settling time */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }, /* Subindex9 - Settled */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex10 - Oscillation index */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }, /* Subindex11 - Saturation */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ }}; /* Subindex12 - Step count */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x2002[] = "Loop KPI\000"
+"Loop select\000"
+"Sample count\000"
+"Window time\000"
+"IAE\000"
+"ISE\000"
+"ITAE\000"
+"Overshoot\000"
+"Settling time\000"
+"Settled\000"
+"Oscillation index\000"
+"Saturation\000"
+"Step count\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT16 LoopSelect; /* Subindex1 - Loop select */
+UINT32 SampleCount; /* Subindex2 - Sample count */
+float WindowTime; /* Subindex3 - Window time */
+float IAE; /* Subindex4 - IAE */
+float ISE; /* Subindex5 - ISE */
+float ITAE; /* Subindex6 - ITAE */
+float Overshoot; /* Subindex7 - Overshoot */
+float SettlingTime; /* Subindex8 - Settling time */
+UINT32 Settled; /* Subindex9 - Settled */
+float OscillationIndex; /* Subindex10 - Oscillation index */
+float Saturation; /* Subindex11 - Saturation */
+UINT32 StepCount; /* Subindex12 - Step count */
+} OBJ_STRUCT_PACKED_END
+TOBJ2002;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object read function (refreshes the entries from the selected loop)
+*/
+PROTO UINT8 Read0x2002( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess );
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ2002 LoopKpi0x2002
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={12,0,0,0.0f,0.0f,0.0f,0.0f,0.0f,0.0f,0,0.0f,0.0f,0}
+#endif
+;
+/** @}*/
+
+
+
+/******************************************************************************
+*                    Object 0x2003 : Dead-time compensation
+******************************************************************************/
+/**
+* \addtogroup 0x2003 0x2003 | Dead-time compensation
+* @{
+* \brief Object 0x2003 (Dead-time compensation) definition<br>
+* Smith predictor of the control loop selected in subindex 1 (see Write0x2003). Writing the loop
+* select loads the current process model of that loop, gain/time constant/dead time/IMC lambda
+* are only staged until Active is written: 1 applies the staged model and switches the loop to
+* CONTROL_MODE_SMITH, 0 switches it back to CONTROL_MODE_AUTO. Gain = 0 takes the FOPDT model of
+* the last auto tuning, IMC lambda > 0 also retunes the loop as PI (Kp = tau/(K*lambda),
+* Ki = 1/(K*lambda)). Prediction is the correction added to the process value in the last cycle.
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Loop select<br>
+* SubIndex 2 - Gain<br>
+* SubIndex 3 - Time constant<br>
+* SubIndex 4 - Dead time<br>
+* SubIndex 5 - IMC lambda<br>
+* SubIndex 6 - Active<br>
+* SubIndex 7 - Prediction<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x2003[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE }, /* Subindex1 - Loop select */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READWRITE }, /* Subindex2 - Gain */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READWRITE }, /* Subindex3 - Time constant */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READWRITE }, /* Subindex4 - Dead time */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READWRITE }, /* Subindex5 - IMC lambda */
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READWRITE }, /* Subindex6 - Active */
+{ DEFTYPE_REAL32 , 0x20 , ACCESS_READ }}; /* Subindex7 - Prediction */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x2003[] = "Dead-time compensation\000"
+"Loop select\000"
+"Gain\000"
+"Time constant\000"
+"Dead time\000"
+"IMC lambda\000"
+"Active\000"
+"Prediction\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT16 LoopSelect; /* Subindex1 - Loop select */
+float Gain; /* Subindex2 - Gain */
+float TimeConstant; /* Subindex3 - Time constant */
+float DeadTime; /* Subindex4 - Dead time */
+float ImcLambda; /* Subindex5 - IMC lambda */
+UINT32 Active; /* Subindex6 - Active */
+float Prediction; /* Subindex7 - Prediction */
+} OBJ_STRUCT_PACKED_END
+TOBJ2003;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object read function (refreshes Active and Prediction from the selected loop)
+*/
+PROTO UINT8 Read0x2003( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess );
+
+/**
+* \brief Object write function (loads, stages and applies the process model)
+*/
+PROTO UINT8 Write0x2003( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess );
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ2003 DeadTimeCompensation0x2003
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={7,0,0.0f,0.0f,0.0f,0.0f,0,0.0f}
 #endif
 ;
 /** @}*/
@@ -616,8 +1283,8 @@ OBJCONST UCHAR OBJMEM aName0x6005[] = "Number of Entries\000"
 */
 typedef struct OBJ_STRUCT_PACKED_START {
 UINT16 u16SubIndex0;
-INT16 供墨泵流量%; /* Subindex1 - 供墨泵流量% */
-INT16 回墨泵流量%; /* Subindex2 - 回墨泵流量% */
+INT16 供墨泵流量百分比; /* Subindex1 - 供墨泵流量% */
+INT16 回墨泵流量百分比; /* Subindex2 - 回墨泵流量% */
 } OBJ_STRUCT_PACKED_END
 TOBJ6005;
 #endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
@@ -772,6 +1439,159 @@ PROTO TOBJ6007 NumberOfEntries0x6007
 
 
 
+/******************************************************************************
+*                    Object 0x6010 : Oversampling status
+******************************************************************************/
+/**
+* \addtogroup 0x6010 0x6010 | Oversampling status
+* @{
+* \brief Object 0x6010 (Oversampling status) definition
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Timestamp<br>
+* SubIndex 2 - Missed samples<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x6010[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED32 , 0x20 , ACCESS_READ | OBJACCESS_TXPDOMAPPING }, /* Subindex1 - Timestamp */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ | OBJACCESS_TXPDOMAPPING }}; /* Subindex2 - Missed samples */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x6010[] = "Oversampling status\000"
+"Timestamp\000"
+"Missed samples\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT32 Timestamp; /* Subindex1 - Timestamp */
+UINT16 MissedSamples; /* Subindex2 - Missed samples */
+} OBJ_STRUCT_PACKED_END
+TOBJ6010;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ6010 OversamplingStatus0x6010
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={2,0x00000000,0x0000}
+#endif
+;
+/** @}*/
+
+
+
+/******************************************************************************
+*                    Object 0x6011 : Oversampling channel A
+******************************************************************************/
+/**
+* \addtogroup 0x6011 0x6011 | Oversampling channel A
+* @{
+* \brief Object 0x6011 (Oversampling channel A) definition<br>
+* Only the first factor entries (0x8010.1) are sampled and mapped
+*/
+#ifdef _OBJD_
+/**
+* \brief Entry descriptions<br>
+* 
+* Subindex 0<br>
+* Subindex 1 - n (the same entry description is used)<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x6011[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ | OBJACCESS_TXPDOMAPPING }};
+
+/**
+* \brief Object name definition<br>
+* For Subindex 1 to n the syntax 'Subindex XXX' is used
+*/
+OBJCONST UCHAR OBJMEM aName0x6011[] = "Oversampling channel A\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16   u16SubIndex0;  /**< \brief Subindex 0 */
+UINT16 aEntries[10];  /**< \brief Subindex 1 - 10 */
+} OBJ_STRUCT_PACKED_END
+TOBJ6011;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ6011 OversamplingChannelA0x6011
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={10,{0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}}
+#endif
+;
+/** @}*/
+
+
+
+/******************************************************************************
+*                    Object 0x6012 : Oversampling channel B
+******************************************************************************/
+/**
+* \addtogroup 0x6012 0x6012 | Oversampling channel B
+* @{
+* \brief Object 0x6012 (Oversampling channel B) definition<br>
+* Only the first factor entries (0x8010.1) are sampled and mapped
+*/
+#ifdef _OBJD_
+/**
+* \brief Entry descriptions<br>
+* 
+* Subindex 0<br>
+* Subindex 1 - n (the same entry description is used)<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x6012[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ | OBJACCESS_TXPDOMAPPING }};
+
+/**
+* \brief Object name definition<br>
+* For Subindex 1 to n the syntax 'Subindex XXX' is used
+*/
+OBJCONST UCHAR OBJMEM aName0x6012[] = "Oversampling channel B\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16   u16SubIndex0;  /**< \brief Subindex 0 */
+UINT16 aEntries[10];  /**< \brief Subindex 1 - 10 */
+} OBJ_STRUCT_PACKED_END
+TOBJ6012;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ6012 OversamplingChannelB0x6012
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={10,{0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}}
+#endif
+;
+/** @}*/
+
+
+
 /******************************************************************************
 *                    Object 0x7000 : Number of Entries
 ******************************************************************************/
@@ -825,6 +1645,96 @@ PROTO TOBJ7000 NumberOfEntries0x7000
 
 
 
+/******************************************************************************
+*                    Object 0x7010 : Master outputs
+******************************************************************************/
+/**
+* \addtogroup 0x7010 0x7010 | Master outputs
+* @{
+* \brief Object 0x7010 (Master outputs) definition<br>
+* One 16 bit entry per OutputField_t, in the same order as OutputDataCache_t
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Digital outputs<br>
+* SubIndex 2 - Digital output mask<br>
+* SubIndex 3 - Analog output 0<br>
+* SubIndex 4 - Analog output 1<br>
+* SubIndex 5 - Analog output 2<br>
+* SubIndex 6 - Analog output 3<br>
+* SubIndex 7 - Analog output mask<br>
+* SubIndex 8 - Sensor command<br>
+* SubIndex 9 - System command<br>
+* SubIndex 10 - Sampling rate<br>
+* SubIndex 11 - Filter enable<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x7010[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ | OBJACCESS_RXPDOMAPPING },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex1 - Digital outputs */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex2 - Digital output mask */
+{ DEFTYPE_INTEGER16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex3 - Analog output 0 */
+{ DEFTYPE_INTEGER16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex4 - Analog output 1 */
+{ DEFTYPE_INTEGER16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex5 - Analog output 2 */
+{ DEFTYPE_INTEGER16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex6 - Analog output 3 */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex7 - Analog output mask */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex8 - Sensor command */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex9 - System command */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }, /* Subindex10 - Sampling rate */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READWRITE | OBJACCESS_RXPDOMAPPING }}; /* Subindex11 - Filter enable */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x7010[] = "Master outputs\000"
+"Digital outputs\000"
+"Digital output mask\000"
+"Analog output 0\000"
+"Analog output 1\000"
+"Analog output 2\000"
+"Analog output 3\000"
+"Analog output mask\000"
+"Sensor command\000"
+"System command\000"
+"Sampling rate\000"
+"Filter enable\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT16 DigitalOutputs; /* Subindex1 - Digital outputs */
+UINT16 DigitalOutputMask; /* Subindex2 - Digital output mask */
+INT16 AnalogOutput0; /* Subindex3 - Analog output 0 */
+INT16 AnalogOutput1; /* Subindex4 - Analog output 1 */
+INT16 AnalogOutput2; /* Subindex5 - Analog output 2 */
+INT16 AnalogOutput3; /* Subindex6 - Analog output 3 */
+UINT16 AnalogOutputMask; /* Subindex7 - Analog output mask */
+UINT16 SensorCommand; /* Subindex8 - Sensor command */
+UINT16 SystemCommand; /* Subindex9 - System command */
+UINT16 SamplingRate; /* Subindex10 - Sampling rate */
+UINT16 FilterEnable; /* Subindex11 - Filter enable */
+} OBJ_STRUCT_PACKED_END
+TOBJ7010;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ7010 MasterOutputs0x7010
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={11,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}
+#endif
+;
+/** @}*/
+
+
+
 /******************************************************************************
 *                    Object 0x8000 : Number of Entries
 ******************************************************************************/
@@ -1761,11 +2671,11 @@ INT16 收墨时间; /* Subindex17 - 收墨时间 */
 INT16 压墨压力; /* Subindex18 - 压墨压力 */
 INT16 待机DP; /* Subindex19 - 待机DP */
 INT16 待机Pm; /* Subindex20 - 待机Pm */
-INT16 备用; /* Subindex21 - 备用 */
-INT16 备用; /* Subindex22 - 备用 */
-INT16 备用; /* Subindex23 - 备用 */
-INT16 备用; /* Subindex24 - 备用 */
-INT16 备用; /* Subindex25 - 备用 */
+INT16 备用1; /* Subindex21 - 备用 */
+INT16 备用2; /* Subindex22 - 备用 */
+INT16 备用3; /* Subindex23 - 备用 */
+INT16 备用4; /* Subindex24 - 备用 */
+INT16 备用5; /* Subindex25 - 备用 */
 } OBJ_STRUCT_PACKED_END
 TOBJ800C;
 #endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
@@ -1782,6 +2692,70 @@ PROTO TOBJ800C NumberOfEntries0x800C
 
 
 
+/******************************************************************************
+*                    Object 0x8010 : Oversampling settings
+******************************************************************************/
+/**
+* \addtogroup 0x8010 0x8010 | Oversampling settings
+* @{
+* \brief Object 0x8010 (Oversampling settings) definition<br>
+* Writable in PREOP only, the settings are locked on PREOP->SAFEOP.
+* Channel B = 0xFF disables the second channel (see Write0x8010)
+*/
+#ifdef _OBJD_
+/**
+* \brief Object entry descriptions<br>
+* <br>
+* SubIndex 0<br>
+* SubIndex 1 - Factor<br>
+* SubIndex 2 - Channel A<br>
+* SubIndex 3 - Channel B<br>
+*/
+OBJCONST TSDOINFOENTRYDESC    OBJMEM asEntryDesc0x8010[] = {
+{ DEFTYPE_UNSIGNED8 , 0x8 , ACCESS_READ },
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ | ACCESS_WRITE_PREOP }, /* Subindex1 - Factor */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ | ACCESS_WRITE_PREOP }, /* Subindex2 - Channel A */
+{ DEFTYPE_UNSIGNED16 , 0x10 , ACCESS_READ | ACCESS_WRITE_PREOP }}; /* Subindex3 - Channel B */
+
+/**
+* \brief Object/Entry names
+*/
+OBJCONST UCHAR OBJMEM aName0x8010[] = "Oversampling settings\000"
+"Factor\000"
+"Channel A\000"
+"Channel B\000\377";
+#endif //#ifdef _OBJD_
+
+#ifndef _SSC_INKCONTROL_OBJECTS_H_
+/**
+* \brief Object structure
+*/
+typedef struct OBJ_STRUCT_PACKED_START {
+UINT16 u16SubIndex0;
+UINT16 Factor; /* Subindex1 - Factor */
+UINT16 ChannelA; /* Subindex2 - Channel A */
+UINT16 ChannelB; /* Subindex3 - Channel B */
+} OBJ_STRUCT_PACKED_END
+TOBJ8010;
+#endif //#ifndef _SSC_INKCONTROL_OBJECTS_H_
+
+/**
+* \brief Object write function (validates the settings and rebuilds 0x1A01)
+*/
+PROTO UINT8 Write0x8010( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess );
+
+/**
+* \brief Object variable
+*/
+PROTO TOBJ8010 OversamplingSettings0x8010
+#if defined(_SSC_INKCONTROL_) && (_SSC_INKCONTROL_ == 1)
+={3,1,0,0xFF}
+#endif
+;
+/** @}*/
+
+
+
 /******************************************************************************
 *                    Object 0xF000 : Modular Device Profile
 ******************************************************************************/
@@ -1843,12 +2817,24 @@ PROTO TOBJF000 ModularDeviceProfile0xF000
 TOBJECT    OBJMEM ApplicationObjDic[] = {
 /* Object 0x1600 */
 {NULL , NULL ,  0x1600 , {DEFTYPE_PDOMAPPING , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x1600 , aName0x1600 , &NumberOfEntriesProcessDataMapping0x1600, NULL , NULL , 0x0000 },
+/* Object 0x1601 */
+{NULL , NULL ,  0x1601 , {DEFTYPE_PDOMAPPING , 11 | (OBJCODE_REC << 8)} , asEntryDesc0x1601 , aName0x1601 , &MasterOutputMapping0x1601, NULL , NULL , 0x0000 },
 /* Object 0x1A00 */
 {NULL , NULL ,  0x1A00 , {DEFTYPE_PDOMAPPING , 25 | (OBJCODE_REC << 8)} , asEntryDesc0x1A00 , aName0x1A00 , &InputMapping00x1A00, NULL , NULL , 0x0000 },
+/* Object 0x1A01 */
+{NULL , NULL ,  0x1A01 , {DEFTYPE_PDOMAPPING , 22 | (OBJCODE_REC << 8)} , asEntryDesc0x1A01 , aName0x1A01 , &OversamplingInputMapping0x1A01, NULL , NULL , 0x0000 },
 /* Object 0x1C12 */
-{NULL , NULL ,  0x1C12 , {DEFTYPE_UNSIGNED16 , 1 | (OBJCODE_ARR << 8)} , asEntryDesc0x1C12 , aName0x1C12 , &sRxPDOassign, NULL , NULL , 0x0000 },
+{NULL , NULL ,  0x1C12 , {DEFTYPE_UNSIGNED16 , 2 | (OBJCODE_ARR << 8)} , asEntryDesc0x1C12 , aName0x1C12 , &sRxPDOassign, NULL , NULL , 0x0000 },
 /* Object 0x1C13 */
-{NULL , NULL ,  0x1C13 , {DEFTYPE_UNSIGNED16 , 1 | (OBJCODE_ARR << 8)} , asEntryDesc0x1C13 , aName0x1C13 , &sTxPDOassign, NULL , NULL , 0x0000 },
+{NULL , NULL ,  0x1C13 , {DEFTYPE_UNSIGNED16 , 2 | (OBJCODE_ARR << 8)} , asEntryDesc0x1C13 , aName0x1C13 , &sTxPDOassign, NULL , NULL , 0x0000 },
+/* Object 0x2000 */
+{NULL , NULL ,  0x2000 , {DEFTYPE_RECORD , 11 | (OBJCODE_REC << 8)} , asEntryDesc0x2000 , aName0x2000 , &SensorStatistics0x2000, Read0x2000 , NULL , 0x0000 },
+/* Object 0x2001 */
+{NULL , NULL ,  0x2001 , {DEFTYPE_RECORD , 29 | (OBJCODE_REC << 8)} , asEntryDesc0x2001 , aName0x2001 , &LoopLatency0x2001, Read0x2001 , NULL , 0x0000 },
+/* Object 0x2002 */
+{NULL , NULL ,  0x2002 , {DEFTYPE_RECORD , 12 | (OBJCODE_REC << 8)} , asEntryDesc0x2002 , aName0x2002 , &LoopKpi0x2002, Read0x2002 , NULL , 0x0000 },
+/* Object 0x2003 */
+{NULL , NULL ,  0x2003 , {DEFTYPE_RECORD , 7 | (OBJCODE_REC << 8)} , asEntryDesc0x2003 , aName0x2003 , &DeadTimeCompensation0x2003, Read0x2003 , Write0x2003 , 0x0000 },
 /* Object 0x6000 */
 {NULL , NULL ,  0x6000 , {DEFTYPE_UNSIGNED8 , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x6000 , aName0x6000 , &NumberOfEntries0x6000, NULL , NULL , 0x0000 },
 /* Object 0x6001 */
@@ -1865,8 +2851,16 @@ TOBJECT    OBJMEM ApplicationObjDic[] = {
 {NULL , NULL ,  0x6006 , {DEFTYPE_UNSIGNED8 , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x6006 , aName0x6006 , &NumberOfEntries0x6006, NULL , NULL , 0x0000 },
 /* Object 0x6007 */
 {NULL , NULL ,  0x6007 , {DEFTYPE_UNSIGNED8 , 10 | (OBJCODE_REC << 8)} , asEntryDesc0x6007 , aName0x6007 , &NumberOfEntries0x6007, NULL , NULL , 0x0000 },
+/* Object 0x6010 */
+{NULL , NULL ,  0x6010 , {DEFTYPE_RECORD , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x6010 , aName0x6010 , &OversamplingStatus0x6010, NULL , NULL , 0x0000 },
+/* Object 0x6011 */
+{NULL , NULL ,  0x6011 , {DEFTYPE_UNSIGNED16 , 10 | (OBJCODE_ARR << 8)} , asEntryDesc0x6011 , aName0x6011 , &OversamplingChannelA0x6011, NULL , NULL , 0x0000 },
+/* Object 0x6012 */
+{NULL , NULL ,  0x6012 , {DEFTYPE_UNSIGNED16 , 10 | (OBJCODE_ARR << 8)} , asEntryDesc0x6012 , aName0x6012 , &OversamplingChannelB0x6012, NULL , NULL , 0x0000 },
 /* Object 0x7000 */
 {NULL , NULL ,  0x7000 , {DEFTYPE_UNSIGNED8 , 2 | (OBJCODE_REC << 8)} , asEntryDesc0x7000 , aName0x7000 , &NumberOfEntries0x7000, NULL , NULL , 0x0000 },
+/* Object 0x7010 */
+{NULL , NULL ,  0x7010 , {DEFTYPE_UNSIGNED8 , 11 | (OBJCODE_REC << 8)} , asEntryDesc0x7010 , aName0x7010 , &MasterOutputs0x7010, NULL , NULL , 0x0000 },
 /* Object 0x8000 */
 {NULL , NULL ,  0x8000 , {DEFTYPE_UNSIGNED8 , 11 | (OBJCODE_REC << 8)} , asEntryDesc0x8000 , aName0x8000 , &NumberOfEntries0x8000, NULL , NULL , 0x0000 },
 /* Object 0x8001 */
@@ -1893,6 +2887,8 @@ TOBJECT    OBJMEM ApplicationObjDic[] = {
 {NULL , NULL ,  0x800B , {DEFTYPE_UNSIGNED8 , 4 | (OBJCODE_REC << 8)} , asEntryDesc0x800B , aName0x800B , &NumberOfEntries0x800B, NULL , NULL , 0x0000 },
 /* Object 0x800C */
 {NULL , NULL ,  0x800C , {DEFTYPE_UNSIGNED8 , 25 | (OBJCODE_REC << 8)} , asEntryDesc0x800C , aName0x800C , &NumberOfEntries0x800C, NULL , NULL , 0x0000 },
+/* Object 0x8010 */
+{NULL , NULL ,  0x8010 , {DEFTYPE_RECORD , 3 | (OBJCODE_REC << 8)} , asEntryDesc0x8010 , aName0x8010 , &OversamplingSettings0x8010, NULL , Write0x8010 , 0x0000 },
 /* Object 0xF000 */
 {NULL , NULL ,  0xF000 , {DEFTYPE_RECORD , 2 | (OBJCODE_REC << 8)} , asEntryDesc0xF000 , aName0xF000 , &ModularDeviceProfile0xF000, NULL , NULL , 0x0000 },
 {NULL,NULL, 0xFFFF, {0, 0}, NULL, NULL, NULL, NULL}};
@@ -16,7 +16,7 @@
  *
  * 执行器任务负责:
  * 1. 控制电磁阀 (24V x2)
- * 2. 控制加热器 (继电器 x3)
+ * 2. 控制加热器 (继电器 x3, 时间比例输出)
  * 3. 控制调速泵 (PWM x2)
  * 4. 控制直流泵 (IO x2)
  * 5. 执行安全输出保护
@@ -33,6 +33,9 @@
 #include "queue.h"
 #include "semphr.h"
 #include "event_groups.h"
+#include "task_profiler.h"
+#include "time_proportion.h"
+#include "latency_trace.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -114,6 +117,9 @@ typedef enum {
     ACTUATOR_COUNT          = 9     // 执行器总数
 } actuator_type_t;
 
+// 泵驱动量快照长度 (ACTUATOR_PUMP_SPEED_1 ~ ACTUATOR_PUMP_DC_2, 见ActuatorTaskV3_ReadPumpOutputs)
+#define ACTUATOR_PUMP_OUTPUTS           (ACTUATOR_PUMP_DC_2 - ACTUATOR_PUMP_SPEED_1 + 1)
+
 // 执行器输出类型
 typedef enum {
     OUTPUT_TYPE_DIGITAL,            // 数字输出 (ON/OFF)
@@ -197,17 +203,31 @@ typedef enum {
     ACTUATOR_CMD_DISABLE,           // 禁用执行器
     ACTUATOR_CMD_RESET_FAULT,       // 复位故障
     ACTUATOR_CMD_EMERGENCY_STOP,    // 紧急停止
-    ACTUATOR_CMD_RESUME             // 恢复运行
+    ACTUATOR_CMD_RESUME,            // 恢复运行
+    ACTUATOR_CMD_SET_HEATER_TIMING  // 设置加热器时间比例参数
 } actuator_cmd_type_t;
 
 typedef struct {
     actuator_cmd_type_t cmd_type;   // 命令类型
     actuator_type_t actuator_type;  // 执行器类型
     float value;                    // 命令值
+    time_proportion_config_t heater_timing; // 时间比例参数 (ACTUATOR_CMD_SET_HEATER_TIMING)
+    latency_stamp_t trace;          // 输入样本标记 (ACTUATOR_CMD_SET_OUTPUT)
     uint32_t timestamp;             // 时间戳
     bool urgent;                    // 紧急标志
 } actuator_command_t;
 
+/* ========================================================================== */
+/* 设定值向量 */
+/* ========================================================================== */
+
+// 控制任务每周期整体发布一次, 执行器任务在下一个节拍读取 (不经过命令队列)
+typedef struct {
+    float value[ACTUATOR_COUNT];            // 目标输出值 (0-100%)
+    latency_stamp_t trace[ACTUATOR_COUNT];  // 输入样本标记
+    uint32_t revision[ACTUATOR_COUNT];      // 写入次数 (变化时才应用, 0=不由设定值向量控制)
+} actuator_setpoint_vector_t;
+
 /* ========================================================================== */
 /* 执行器任务统计信息 */
 /* ========================================================================== */
@@ -218,8 +238,10 @@ typedef struct {
     uint32_t command_errors;        // 命令错误数
     uint32_t safety_triggers;       // 安全触发次数
     uint32_t emergency_stops;       // 紧急停止次数
-    uint16_t max_cycle_time_us;     // 最大循环时间 (微秒)
-    uint16_t avg_cycle_time_us;     // 平均循环时间 (微秒)
+    uint32_t setpoint_updates;      // 从设定值向量应用的输出更新数
+    uint32_t setpoint_read_retries; // 设定值向量读取冲突次数 (下个节拍重读)
+    uint32_t max_cycle_time_us;     // 最大循环时间 (微秒, DWT计时)
+    uint32_t avg_cycle_time_us;     // 平均循环时间 (微秒, DWT计时)
 } actuator_task_stats_t;
 
 /* ========================================================================== */
@@ -271,6 +293,15 @@ typedef struct {
 #define ACTUATOR_FAULT_RETRY_COUNT      3           // 故障重试次数
 #define ACTUATOR_RAMP_DEFAULT_RATE      10.0f       // 默认爬坡速率 (%/s)
 
+/* ========================================================================== */
+/* 加热器时间比例输出参数 */
+/* ========================================================================== */
+
+// 0-100%需求在窗口内转换为导通时间, 三路加热器窗口起点错开1/3窗口
+#define ACTUATOR_HEATER_WINDOW_MS       10000       // 时间比例窗口
+#define ACTUATOR_HEATER_MIN_ON_MS       500         // 继电器最小导通时间
+#define ACTUATOR_HEATER_MIN_OFF_MS      500         // 继电器最小关断时间
+
 /* ========================================================================== */
 /* 全局变量声明 */
 /* ========================================================================== */
@@ -311,6 +342,25 @@ void Task_ActuatorV3(void *pvParameters);
  */
 BaseType_t ActuatorTaskV3_SetOutput(actuator_type_t actuator_type, float value);
 
+/**
+ * @brief 设置执行器输出值并携带输入样本标记 (写入硬件时记录采样->输出延迟)
+ * @param actuator_type 执行器类型
+ * @param value 输出值 (0-100%)
+ * @param trace 输入样本标记 (NULL=不跟踪)
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ActuatorTaskV3_SetOutputTraced(actuator_type_t actuator_type, float value,
+                                          const latency_stamp_t *trace);
+
+/**
+ * @brief 发布设定值向量 (无锁, 不阻塞; 只允许控制任务一个写者)
+ * @param setpoints 设定值向量
+ * @return pdTRUE=成功, pdFALSE=失败
+ * @note 执行器任务每个节拍只应用revision有变化的执行器, 错过的中间版本
+ *       不影响结果; 与ACTUATOR_CMD_SET_OUTPUT命令按到达顺序生效
+ */
+BaseType_t ActuatorTaskV3_PublishSetpoints(const actuator_setpoint_vector_t *setpoints);
+
 /**
  * @brief 使能执行器
  * @param actuator_type 执行器类型
@@ -386,6 +436,12 @@ void ActuatorTaskV3_GetStatistics(actuator_task_stats_t *stats);
  */
 void ActuatorTaskV3_ResetStatistics(void);
 
+/**
+ * @brief 获取执行器任务分阶段计时器 (阶段: commands/safety/outputs/status),
+ *        通过Profiler_GetSummary读取
+ */
+const profiler_t *ActuatorTaskV3_GetProfiler(void);
+
 /**
  * @brief 设置电磁阀状态
  * @param valve_id 阀门ID (0 or 1)
@@ -402,6 +458,14 @@ BaseType_t ActuatorTaskV3_SetValve(uint8_t valve_id, bool state);
  */
 BaseType_t ActuatorTaskV3_SetHeater(uint8_t heater_id, bool state);
 
+/**
+ * @brief 设置加热器时间比例参数 (窗口/最小导通/最小关断时间)
+ * @param heater_id 加热器ID (0, 1, or 2)
+ * @param timing 时间比例参数
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ActuatorTaskV3_SetHeaterTiming(uint8_t heater_id, const time_proportion_config_t *timing);
+
 /**
  * @brief 设置调速泵速度
  * @param pump_id 泵ID (0 or 1)
@@ -439,6 +503,13 @@ BaseType_t ActuatorTaskV3_GetHeaterStates(bool *heater_states);
  */
 BaseType_t ActuatorTaskV3_GetPumpSpeeds(float *pump_speeds);
 
+/**
+ * @brief 读取最近一个周期实际输出的泵驱动量 (顺序锁快照, 不阻塞, 供液位估计等周期性读者使用)
+ * @param outputs 输出数组 (至少ACTUATOR_PUMP_OUTPUTS个: 调速泵1/2占空比, 直流泵1/2为0/100, 单位%)
+ * @return pdTRUE=成功, pdFALSE=尚未发布或读取冲突
+ */
+BaseType_t ActuatorTaskV3_ReadPumpOutputs(float *outputs);
+
 /**
  * @brief 检查是否处于安全模式
  * @return true=安全模式, false=正常模式
@@ -50,6 +50,12 @@
 
 #define CHNS_NUM_READ 8			// the number of channel you want to get the raw data (you also have to adjust the AUTO_SEQ_EN register value to match with the number of channel you like to read)
 
+// SPI frame (8 bit data size, MSB first, SDO format 3), the same for every access path:
+// [command/register 15:8][7:0][conversion 15:8][7:0][channel address 7:4 | ...][...]
+#define ADS_FRAME_BYTES 6
+#define ADS_FRAME_CODE(rx)		((uint16_t)(((uint16_t)(rx)[2] << 8) | (rx)[3]))	// 16 bit conversion result
+#define ADS_FRAME_CHANNEL(rx)	((uint8_t)((rx)[4] >> 4))							// channel of that result
+
 typedef struct {
 
 	/* SPI */
@@ -75,6 +81,7 @@ uint8_t ADS8688_Init(ADS8688 *ads, SPI_HandleTypeDef *spiHandle, GPIO_TypeDef *c
 HAL_StatusTypeDef ADS_Prog_Read(ADS8688 *ads, uint8_t addr, uint8_t *data);
 HAL_StatusTypeDef ADS_Prog_Write(ADS8688 *ads, uint8_t addr, uint8_t *data);
 HAL_StatusTypeDef ADS_Cmd_Write(ADS8688 *ads, uint8_t cmd, uint8_t *data);
+HAL_StatusTypeDef ADS_Cmd_Read(ADS8688 *ads, uint8_t cmd, uint16_t *code, uint8_t *channel);
 
 
 /*
@@ -6,6 +6,27 @@
 #include "ads8688/ADS8688.h"
 
 /* 类型定义 ------------------------------------------------------------------*/
+/* 后台采集帧: 一次定时器触发的8通道自动序列 */
+typedef struct {
+    uint32_t seq;                                  // 帧序号 (从1开始, 连续递增)
+    uint32_t tick;                                 // 触发该帧的定时器节拍序号
+    uint32_t timestamp_us;                         // 帧开始时刻 (us, 以启动采集为0点, 约71分钟回绕)
+    uint16_t raw[8];                               // 16位原始转换值 (ADS_FRAME_CODE, 各读取路径相同)
+} ads8688_frame_t;
+
+/* 后台采集统计 */
+typedef struct {
+    uint32_t ticks;                                // 定时器节拍数
+    uint32_t frames;                               // 已发布帧数
+    uint32_t overruns;                             // 上一帧未完成时到达的节拍数
+    uint32_t bus_busy;                             // 总线被中断采样占用而跳过的节拍数
+    uint32_t order_errors;                         // 通道地址与序列不符而丢弃的帧数
+    uint32_t spi_errors;                           // SPI/DMA错误次数
+} ads8688_acq_stats_t;
+
+/* 中断采样完成回调 (在DMA中断中调用), status非HAL_OK时data无效 */
+typedef void (*ads8688_read_done_t)(HAL_StatusTypeDef status, const uint16_t *data);
+
 /* 宏定义 --------------------------------------------------------------------*/
 /* ADS8688使用SPI3接口 - 根据接线图ADC-spi3.png */
 #define ADS8688_SPIx                                   SPI3
@@ -39,13 +60,68 @@
 #define ADS8688_RST_PORT                               GPIOB
 #define ADS8688_RST_PIN                                GPIO_PIN_8
 
+/* SPI3 DMA: RX -> DMA1 Stream0 Channel0, TX -> DMA1 Stream5 Channel0 */
+#define ADS8688_SPI_DMA_CLK_ENABLE()                   __HAL_RCC_DMA1_CLK_ENABLE()
+#define ADS8688_SPI_RX_DMA_STREAM                      DMA1_Stream0
+#define ADS8688_SPI_RX_DMA_CHANNEL                     DMA_CHANNEL_0
+#define ADS8688_SPI_RX_DMA_IRQ                         DMA1_Stream0_IRQn
+#define ADS8688_SPI_RX_DMA_INT_FUN                     DMA1_Stream0_IRQHandler
+#define ADS8688_SPI_TX_DMA_STREAM                      DMA1_Stream5
+#define ADS8688_SPI_TX_DMA_CHANNEL                     DMA_CHANNEL_0
+#define ADS8688_SPI_TX_DMA_IRQ                         DMA1_Stream5_IRQn
+#define ADS8688_SPI_TX_DMA_INT_FUN                     DMA1_Stream5_IRQHandler
+
+/* 采集节拍定时器 (APB1定时器时钟84MHz, 1MHz计数) */
+#define ADS8688_ACQ_TIMx                               TIM5
+#define ADS8688_ACQ_TIM_RCC_CLK_ENABLE()               __HAL_RCC_TIM5_CLK_ENABLE()
+#define ADS8688_ACQ_TIM_IRQ                            TIM5_IRQn
+#define ADS8688_ACQ_TIM_INT_FUN                        TIM5_IRQHandler
+#define ADS8688_ACQ_TIM_PRESCALER                      83
+
+/* 采集节拍定时器, SPI DMA和过采样定时器共用的抢占优先级: 同级中断互不嵌套,
+ * 总线占用标志和传输状态无需关中断保护. 这些中断不调用RTOS接口, 可高于
+ * configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+#define ADS8688_ACQ_IRQ_PRIORITY                       2
+
+/* 后台采集参数 */
+#define ADS8688_ACQ_CHANNELS                           8
+#define ADS8688_ACQ_RING_SIZE                          16     // 帧环形缓冲长度
+#define ADS8688_ACQ_PERIOD_US_DEFAULT                  1000   // 默认帧周期 (us)
+#define ADS8688_ACQ_PERIOD_US_MIN                      500    // 9次48位传输@1.3125MHz约330us, 含DMA中断开销
+#define ADS8688_ACQ_STALE_TICKS                        4      // 最新帧落后超过该节拍数视为采集停滞
+#define ADS8688_ACQ_SPI_BYTES                          ADS_FRAME_BYTES  // 16位命令 + 16位结果 + 通道地址/量程 (SDO格式3)
+#define ADS8688_ACQ_CHECK_ORDER                        1      // 按SDO中的通道地址校验帧顺序
+
+/* 中断采样 (手动通道序列) 最大通道数 */
+#define ADS8688_ISR_MAX_CHANNELS                       ADS8688_ACQ_CHANNELS
+
+/* 各通道1LSB对应的电压 (V), 与初始化配置的量程一致:
+ * CH0,1,6,7: 0-5V (0x06); CH2-5: 0-10V (0x05) */
+#define ADS8688_LSB_VOLTS_5V                           (5.0f / 65536.0f)
+#define ADS8688_LSB_VOLTS_10V                          (10.0f / 65536.0f)
+#define ADS8688_LSB_VOLTS_TABLE                        { ADS8688_LSB_VOLTS_5V,  ADS8688_LSB_VOLTS_5V,  \
+                                                         ADS8688_LSB_VOLTS_10V, ADS8688_LSB_VOLTS_10V, \
+                                                         ADS8688_LSB_VOLTS_10V, ADS8688_LSB_VOLTS_10V, \
+                                                         ADS8688_LSB_VOLTS_5V,  ADS8688_LSB_VOLTS_5V }
+
 /* 扩展变量 ------------------------------------------------------------------*/
 extern SPI_HandleTypeDef hads8688_spi;
+extern DMA_HandleTypeDef hads8688_dma_rx;
+extern DMA_HandleTypeDef hads8688_dma_tx;
 extern ADS8688 ads8688_device;
 
 /* 函数声明 ------------------------------------------------------------------*/
 void BSP_ADS8688_Init(void);
 HAL_StatusTypeDef BSP_ADS8688_ReadAllChannels(uint16_t *data);
+HAL_StatusTypeDef BSP_ADS8688_StartChannelsIsr(const uint8_t *channels, uint8_t count, ads8688_read_done_t done);
 void BSP_ADS8688_ConvertToVoltage(uint16_t *raw_data, float *voltage_data, uint8_t channel_count);
 
+HAL_StatusTypeDef BSP_ADS8688_StartAcquisition(uint32_t period_us);
+void BSP_ADS8688_StopAcquisition(void);
+uint8_t BSP_ADS8688_IsAcquiring(void);
+HAL_StatusTypeDef BSP_ADS8688_GetLatestFrame(ads8688_frame_t *frame);
+uint8_t BSP_ADS8688_GetFrames(ads8688_frame_t *frames, uint8_t count);
+void BSP_ADS8688_GetAcqStats(ads8688_acq_stats_t *stats);
+void BSP_ADS8688_AcqTimerIsr(void);
+
 #endif /* __BSP_ADS8688_H__ */
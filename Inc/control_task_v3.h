@@ -35,6 +35,10 @@
 #include "event_groups.h"
 #include "sensor_task_v3.h"
 #include "actuator_task_v3.h"
+#include "task_profiler.h"
+#include "pid_autotune.h"
+#include "loop_kpi.h"
+#include "fopdt_model.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -50,6 +54,22 @@ extern "C" {
 #define CONTROL_TASK_STACK_SIZE     1024    // 堆栈大小 (words) - 与传感器和执行器任务保持一致
 #define CONTROL_TASK_PERIOD_MS      20      // 任务周期 20ms (参考V3表格)
 
+// 调度方式: 0=按CONTROL_TASK_PERIOD_MS周期执行全部回路;
+// 1=数据驱动, 传感器任务发布快照后唤醒, 回路仅在输入通道有新样本时计算,
+//   积分/微分按样本实际间隔, 报警/质量/状态消息仍按CONTROL_TASK_PERIOD_MS执行
+// 默认0: derivative_filter是每个样本的系数, 现有回路参数按20ms整定; 数据驱动时压力回路
+//   每10ms、温度回路每1s计算一次, 微分滤波时间常数随之改变, 需按通道输出周期重新整定后再启用.
+//   两种方式的唤醒/计算次数/样本使用/延迟对比见Test/test_control_schedule.c
+#ifndef CONTROL_DATA_DRIVEN
+#define CONTROL_DATA_DRIVEN         0
+#endif
+
+// 液位回路测量值: 0=模拟液位滤波值; 1=液位融合估计 (模拟液位+浮球开关+泵驱动量, 见level_estimator.h),
+//   有效性仍以模拟液位通道为准
+#ifndef CONTROL_LEVEL_ESTIMATE
+#define CONTROL_LEVEL_ESTIMATE      1
+#endif
+
 /* ========================================================================== */
 /* 控制回路定义 (参考设计文档V3 第2.4节) */
 /* ========================================================================== */
@@ -78,7 +98,8 @@ typedef enum {
     CONTROL_MODE_CASCADE,           // 串级控制
     CONTROL_MODE_FEEDFORWARD,       // 前馈控制
     CONTROL_MODE_ADAPTIVE,          // 自适应控制
-    CONTROL_MODE_SAFETY             // 安全模式
+    CONTROL_MODE_SAFETY,            // 安全模式
+    CONTROL_MODE_SMITH              // 纯滞后补偿 (Smith预估器)
 } control_mode_t;
 
 // 控制状态
@@ -151,10 +172,37 @@ typedef struct {
     // 统计信息
     uint32_t cycle_count;           // 控制周期计数
     float max_error;                // 最大误差
-    float avg_error;                // 平均误差
+    float avg_error;                // 平均绝对误差 (KPI滑动窗口)
     float steady_state_error;       // 稳态误差
 } pid_state_t;
 
+/* ========================================================================== */
+/* 串级/前馈配置结构 */
+/* ========================================================================== */
+
+// 串级配置 (设在外环上, 外环输出作为内环设定值)
+typedef struct {
+    control_loop_t inner_loop;      // 内环 (CONTROL_LOOP_COUNT=未配置)
+    uint8_t rate_ratio;             // 内环/外环执行频率比 (外环每rate_ratio个控制周期执行一次)
+} control_cascade_config_t;
+
+// 前馈配置: u_ff = gain · (T_lead·s + 1)/(T_lag·s + 1) · (d - reference)
+typedef struct {
+    sensor_type_t sensor;           // 扰动测量传感器 (SENSOR_COUNT=未配置)
+    float reference;                // 扰动参考值 (扰动等于该值时前馈为0)
+    float gain;                     // 静态增益
+    float lead_time;                // 超前时间常数 (秒, 与lag_time同为0时为静态前馈)
+    float lag_time;                 // 滞后时间常数 (秒)
+} control_feedforward_config_t;
+
+// 纯滞后补偿配置: 过程模型 K·e^(-θs)/(τs + 1), PID反馈取 pv + 模型(无滞后) - 模型(滞后θ)
+typedef struct {
+    float gain;                     // 静态增益 K (0=取最近一次自整定辨识的FOPDT模型)
+    float time_constant;            // 时间常数 τ (秒)
+    float dead_time;                // 纯滞后 θ (秒)
+    float imc_lambda;               // IMC闭环时间常数 λ (秒, >0时按 Kp=τ/(K·λ), Ki=1/(K·λ) 重设PI参数, 0=保留现有PID参数)
+} control_smith_config_t;
+
 /* ========================================================================== */
 /* 控制回路配置结构 */
 /* ========================================================================== */
@@ -199,6 +247,15 @@ typedef struct {
     // 质量指标
     float control_quality;          // 控制质量分数 (0-100)
     uint32_t quality_update_count;  // 质量更新次数
+
+    // 串级与前馈 (分别在CONTROL_MODE_CASCADE/CONTROL_MODE_FEEDFORWARD下生效)
+    control_cascade_config_t cascade;           // 串级配置
+    control_feedforward_config_t feedforward;   // 前馈配置
+    float feedforward_output;       // 本周期前馈量
+
+    // 纯滞后补偿 (CONTROL_MODE_SMITH下生效)
+    control_smith_config_t smith;   // 过程模型 (gain=0表示未配置)
+    float smith_correction;         // 本周期预估校正量 (加到过程值上)
 } control_loop_config_t;
 
 /* ========================================================================== */
@@ -234,8 +291,8 @@ typedef struct {
     // 性能指标
     uint8_t overall_quality;        // 整体控制质量 (0-100)
     float system_stability;         // 系统稳定性指标
-    uint16_t max_cycle_time_us;     // 最大控制周期时间 (微秒)
-    uint16_t avg_cycle_time_us;     // 平均控制周期时间 (微秒)
+    uint32_t max_cycle_time_us;     // 最大控制周期时间 (微秒)
+    uint32_t avg_cycle_time_us;     // 平均控制周期时间 (微秒)
 } control_context_t;
 
 /* ========================================================================== */
@@ -251,7 +308,10 @@ typedef enum {
     CONTROL_CMD_RESET_LOOP,         // 复位控制回路
     CONTROL_CMD_EMERGENCY_STOP,     // 紧急停止
     CONTROL_CMD_RESUME,             // 恢复运行
-    CONTROL_CMD_UPDATE_PARAMS       // 更新参数
+    CONTROL_CMD_UPDATE_PARAMS,      // 更新参数
+    CONTROL_CMD_SET_CASCADE,        // 设置串级配置
+    CONTROL_CMD_SET_FEEDFORWARD,    // 设置前馈配置
+    CONTROL_CMD_SET_SMITH           // 设置纯滞后补偿模型
 } control_cmd_type_t;
 
 typedef struct {
@@ -260,6 +320,9 @@ typedef struct {
     float value;                    // 命令值
     control_mode_t mode;            // 控制模式 (用于模式切换命令)
     pid_params_t pid_params;        // PID参数 (用于参数更新命令)
+    control_cascade_config_t cascade;           // 串级配置 (用于串级设置命令)
+    control_feedforward_config_t feedforward;   // 前馈配置 (用于前馈设置命令)
+    control_smith_config_t smith;   // 纯滞后补偿模型 (用于纯滞后补偿设置命令)
     uint32_t timestamp;             // 时间戳
     bool urgent;                    // 紧急标志
 } control_command_t;
@@ -276,8 +339,8 @@ typedef struct {
     uint32_t actuator_errors;       // 执行器错误次数
     uint32_t mode_switches;         // 模式切换次数
     uint32_t emergency_stops;       // 紧急停止次数
-    uint16_t max_cycle_time_us;     // 最大周期时间 (微秒)
-    uint16_t avg_cycle_time_us;     // 平均周期时间 (微秒)
+    uint32_t max_cycle_time_us;     // 最大周期时间 (微秒, DWT计时)
+    uint32_t avg_cycle_time_us;     // 平均周期时间 (微秒, DWT计时)
     float avg_control_quality;     // 平均控制质量
     uint32_t quality_degradation;   // 质量下降次数
 } control_task_stats_t;
@@ -294,7 +357,7 @@ typedef enum {
     MSG_CONTROL_QUALITY             // 控制质量消息
 } control_msg_type_t;
 
-// 控制消息结构
+// 控制消息结构 (消息总线MSG_BUS_TOPIC_CONTROL_STATUS的消息体)
 typedef struct {
     control_msg_type_t type;        // 消息类型
     uint32_t timestamp;             // 时间戳
@@ -327,7 +390,11 @@ typedef struct {
 /* ========================================================================== */
 
 #define CONTROL_CMD_QUEUE_SIZE          16          // 命令队列大小
-#define CONTROL_MSG_QUEUE_SIZE          16          // 消息队列大小
+#define CONTROL_MSG_POOL_BLOCKS         3           // 状态消息内存块数
+
+/* 主站系统命令 (0x7010.9 System command, 变化时由输出监控通知控制任务) */
+#define CONTROL_MASTER_CMD_RUN          1           // 恢复运行
+#define CONTROL_MASTER_CMD_EMERGENCY_STOP 2         // 紧急停止
 
 /* ========================================================================== */
 /* 控制参数定义 */
@@ -336,8 +403,15 @@ typedef struct {
 #define CONTROL_QUALITY_THRESHOLD       80          // 控制质量阈值
 #define CONTROL_SETPOINT_CHANGE_RATE    10.0f       // 设定值变化速率限制 (%/s)
 #define CONTROL_OUTPUT_FILTER_COEFF     0.9f        // 输出滤波系数
-#define CONTROL_AUTO_TUNE_CYCLES        50          // 自整定周期数
+#define CONTROL_AUTO_TUNE_CYCLES        50          // 自整定最多继电切换次数
+#define CONTROL_AUTO_TUNE_AMPLITUDE     0.2f        // 自整定继电幅值 (占输出范围比例)
+#define CONTROL_AUTO_TUNE_DEVIATION     0.1f        // 自整定允许偏离 (占设定值范围比例)
+#define CONTROL_AUTO_TUNE_HALF_PERIOD_S 600.0f      // 自整定半周期超时 (秒)
+#define CONTROL_AUTO_TUNE_RULE          PID_AUTOTUNE_RULE_SIMC_PI   // 整定规则 (失败时退回ZN PI)
+#define CONTROL_AUTO_TUNE_APPLY         1           // 1=整定完成后自动写入PID参数
 #define CONTROL_STABILITY_WINDOW        100         // 稳定性检测窗口
+#define CONTROL_KPI_WINDOW_S            10.0f       // 回路KPI滑动窗口 (秒)
+#define CONTROL_KPI_TEMP_WINDOW_S       60.0f       // 温度回路KPI滑动窗口 (秒, 传感器1s更新)
 
 /* ========================================================================== */
 /* 全局变量声明 */
@@ -345,7 +419,6 @@ typedef struct {
 
 extern TaskHandle_t xTaskHandle_ControlV3;
 extern QueueHandle_t xQueue_ControlCmd;
-extern QueueHandle_t xQueue_ControlMsg;
 extern SemaphoreHandle_t xMutex_ControlContext;
 extern EventGroupHandle_t xEventGroup_Control;
 
@@ -409,6 +482,45 @@ BaseType_t ControlTaskV3_DisableLoop(control_loop_t loop_id);
  */
 BaseType_t ControlTaskV3_SetPIDParams(control_loop_t loop_id, const pid_params_t *params);
 
+/**
+ * @brief 配置串级控制 (外环切到CONTROL_MODE_CASCADE后生效)
+ * @param outer_loop 外环
+ * @param inner_loop 内环 (CONTROL_LOOP_COUNT=取消串级)
+ * @param rate_ratio 内环/外环执行频率比 (>=1)
+ * @return pdTRUE=成功, pdFALSE=失败
+ * @note 外环输出范围和采样时间按内环设定值范围和频率比重设;
+ *       只支持单级串级, 内环不能再做外环, 一个内环只能有一个外环
+ */
+BaseType_t ControlTaskV3_SetCascade(control_loop_t outer_loop, control_loop_t inner_loop, uint8_t rate_ratio);
+
+/**
+ * @brief 配置前馈 (回路切到CONTROL_MODE_FEEDFORWARD后生效)
+ * @param loop_id 控制回路ID
+ * @param config 前馈配置
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ControlTaskV3_SetFeedforward(control_loop_t loop_id, const control_feedforward_config_t *config);
+
+/**
+ * @brief 配置纯滞后补偿 (回路切到CONTROL_MODE_SMITH后生效)
+ * @param loop_id 控制回路ID
+ * @param config 过程模型 (gain=0时取最近一次自整定结果, 无结果则命令失败)
+ * @return pdTRUE=成功, pdFALSE=失败
+ * @note imc_lambda>0时同时按IMC规则重设PI参数, 不需要可先设为0再单独调PID
+ */
+BaseType_t ControlTaskV3_SetSmithPredictor(control_loop_t loop_id, const control_smith_config_t *config);
+
+/**
+ * @brief 获取纯滞后补偿当前模型
+ * @param loop_id 控制回路ID
+ * @param config 输出模型 (未配置时gain=0)
+ * @param correction 输出本周期预估校正量 (可为NULL)
+ * @param active 输出回路是否处于CONTROL_MODE_SMITH (可为NULL)
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ControlTaskV3_GetSmithPredictor(control_loop_t loop_id, control_smith_config_t *config,
+                                          float *correction, bool *active);
+
 /**
  * @brief 启动PID自整定
  * @param loop_id 控制回路ID
@@ -423,6 +535,22 @@ BaseType_t ControlTaskV3_StartAutoTune(control_loop_t loop_id);
  */
 BaseType_t ControlTaskV3_StopAutoTune(control_loop_t loop_id);
 
+/**
+ * @brief 获取最近一次成功的自整定结果
+ * @param loop_id 控制回路ID
+ * @param result 输出辨识结果 (可用PidAutotune_ComputeGains换算为其他规则的参数)
+ * @return pdTRUE=有结果, pdFALSE=未整定过或获取失败
+ */
+BaseType_t ControlTaskV3_GetAutoTuneResult(control_loop_t loop_id, pid_autotune_result_t *result);
+
+/**
+ * @brief 获取回路性能指标 (IAE/ISE/ITAE/超调/调节时间/振荡/饱和)
+ * @param loop_id 控制回路ID
+ * @param summary 输出结果 (监视周期刷新, 失败时清零)
+ * @return pdTRUE=有样本, pdFALSE=回路未运行过或获取失败
+ */
+BaseType_t ControlTaskV3_GetLoopKpi(control_loop_t loop_id, loop_kpi_summary_t *summary);
+
 /**
  * @brief 紧急停止所有控制回路
  * @return pdTRUE=成功, pdFALSE=失败
@@ -474,20 +602,12 @@ BaseType_t ControlTaskV3_GetLoopConfig(control_loop_t loop_id, control_loop_conf
 BaseType_t ControlTaskV3_GetPIDState(control_loop_t loop_id, pid_state_t *state);
 
 /**
- * @brief 发送控制消息到队列
- * @param msg 消息结构指针
- * @param timeout_ms 超时时间
- * @return pdTRUE=成功, pdFALSE=失败
+ * @brief 订阅控制状态消息
+ * @param depth 订阅者队列深度
+ * @return 订阅者, NULL=失败
+ * @note 用MsgBus_Receive取得const control_msg_t*, 用完后MsgBus_Release
  */
-BaseType_t ControlTaskV3_SendMessage(const control_msg_t *msg, uint32_t timeout_ms);
-
-/**
- * @brief 从队列接收控制消息
- * @param msg 消息结构指针
- * @param timeout_ms 超时时间
- * @return pdTRUE=成功, pdFALSE=失败
- */
-BaseType_t ControlTaskV3_ReceiveMessage(control_msg_t *msg, uint32_t timeout_ms);
+msg_bus_subscriber_t *ControlTaskV3_Subscribe(uint8_t depth);
 
 /**
  * @brief 获取控制任务统计信息
@@ -500,6 +620,12 @@ void ControlTaskV3_GetStatistics(control_task_stats_t *stats);
  */
 void ControlTaskV3_ResetStatistics(void);
 
+/**
+ * @brief 获取控制任务分阶段计时器 (阶段: commands/sensors/pid/outputs/supervise),
+ *        通过Profiler_GetSummary读取
+ */
+const profiler_t *ControlTaskV3_GetProfiler(void);
+
 /**
  * @brief 检查控制系统健康状态
  * @return 健康分数 (0-100)
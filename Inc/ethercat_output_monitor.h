@@ -11,6 +11,8 @@
 
 #include "stm32f4xx_hal.h"
 #include "ecat_def.h"
+#include "FreeRTOS.h"
+#include "task.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -33,6 +35,30 @@ typedef enum {
     OUTPUT_CHANGE_CONFIG = 8         /**< 配置参数变化 */
 } OutputChangeType_t;
 
+/**
+ * @brief 输出数据字段编号（即脏位掩码中的位号）
+ */
+typedef enum {
+    OUTPUT_FIELD_DIGITAL_OUTPUTS = 0,    /**< 数字输出状态 */
+    OUTPUT_FIELD_DIGITAL_MASK,           /**< 数字输出掩码 */
+    OUTPUT_FIELD_ANALOG_0,               /**< 模拟输出通道0 */
+    OUTPUT_FIELD_ANALOG_1,               /**< 模拟输出通道1 */
+    OUTPUT_FIELD_ANALOG_2,               /**< 模拟输出通道2 */
+    OUTPUT_FIELD_ANALOG_3,               /**< 模拟输出通道3 */
+    OUTPUT_FIELD_ANALOG_MASK,            /**< 模拟输出掩码 */
+    OUTPUT_FIELD_SENSOR_CMD,             /**< 传感器配置命令 */
+    OUTPUT_FIELD_SYSTEM_CMD,             /**< 系统控制命令 */
+    OUTPUT_FIELD_SAMPLING_RATE,          /**< 采样率 */
+    OUTPUT_FIELD_FILTER_ENABLE,          /**< 滤波使能 */
+    OUTPUT_FIELD_COUNT
+} OutputField_t;
+
+#define OUTPUT_FIELD_BIT(field)          ((uint32_t)1u << (field))
+#define OUTPUT_FIELD_ALL                 (OUTPUT_FIELD_BIT(OUTPUT_FIELD_COUNT) - 1u)
+
+#define OUTPUT_MONITOR_MAX_SUBSCRIBERS   4  /**< 最大订阅任务数 */
+#define OUTPUT_MONITOR_NOTIFY_INDEX      1  /**< 字段变化使用的任务通知下标 (下标0留给任务自身使用) */
+
 /**
  * @brief 输出监控统计信息
  */
@@ -48,23 +74,27 @@ typedef struct {
 
 /**
  * @brief 输出数据缓存结构
+ * @note 每个字段占一个16位字，顺序与OutputField_t一致，
+ *       变化检测按32位字异或比较后再拆分为字段脏位
  */
 typedef struct {
-    /* 数字输出缓存 */
-    uint16_t digital_outputs_prev;       /**< 上次数字输出状态 */
-    uint16_t digital_output_mask_prev;   /**< 上次数字输出掩码 */
+    /* 数字输出 */
+    uint16_t digital_outputs;            /**< 数字输出状态 */
+    uint16_t digital_output_mask;        /**< 数字输出掩码 */
+
+    /* 模拟输出 */
+    int16_t analog_outputs[4];           /**< 模拟输出值 */
+    uint16_t analog_output_mask;         /**< 模拟输出掩码 */
 
-    /* 模拟输出缓存 */
-    int16_t analog_outputs_prev[4];      /**< 上次模拟输出值 */
-    uint8_t analog_output_mask_prev;     /**< 上次模拟输出掩码 */
+    /* 控制命令 */
+    uint16_t sensor_config_cmd;          /**< 传感器配置命令 */
+    uint16_t system_control_cmd;         /**< 系统控制命令 */
 
-    /* 控制命令缓存 */
-    uint8_t sensor_config_cmd_prev;      /**< 上次传感器配置命令 */
-    uint8_t system_control_cmd_prev;     /**< 上次系统控制命令 */
+    /* 配置参数 */
+    uint16_t sampling_rate;              /**< 采样率 */
+    uint16_t filter_enable;              /**< 滤波使能 */
 
-    /* 配置参数缓存 */
-    uint16_t sampling_rate_prev;         /**< 上次采样率 */
-    uint8_t filter_enable_prev;          /**< 上次滤波使能 */
+    uint16_t reserved;                   /**< 保留（补齐到32位字） */
 } OutputDataCache_t;
 
 /* ========================================================================== */
@@ -76,12 +106,53 @@ typedef struct {
  */
 void EtherCAT_OutputMonitor_Init(void);
 
+/**
+ * @brief 锁存主站最新下发的数据（在输出映射/应用周期中调用，可在中断中调用）
+ * @param outputs 最新输出数据
+ */
+void EtherCAT_OutputMonitor_Latch(const OutputDataCache_t *outputs);
+
 /**
  * @brief 检测主站下发数据是否有变化
+ * @note 与缓存逐字异或比较得到字段脏位，并以任务通知(eSetBits)
+ *       唤醒订阅了对应字段的任务，可在中断中调用
  * @return 变化类型掩码，参见 OutputChangeType_t
  */
 uint8_t EtherCAT_OutputMonitor_CheckChanges(void);
 
+/**
+ * @brief 获取最近一次检测到的字段脏位
+ * @return 字段脏位掩码（OUTPUT_FIELD_BIT）
+ */
+uint32_t EtherCAT_OutputMonitor_GetDirtyFields(void);
+
+/**
+ * @brief 字段脏位转换为变化类型
+ * @param field_mask 字段脏位掩码
+ * @return 变化类型掩码，参见 OutputChangeType_t
+ */
+uint8_t EtherCAT_OutputMonitor_FieldsToChangeType(uint32_t field_mask);
+
+/**
+ * @brief 订阅字段变化
+ * @param task 被唤醒的任务，下标OUTPUT_MONITOR_NOTIFY_INDEX的通知值按位或上变化的字段脏位
+ * @param field_mask 关注的字段（OUTPUT_FIELD_BIT组合）
+ * @return true: 成功, false: 订阅表已满或参数错误
+ */
+bool EtherCAT_OutputMonitor_Subscribe(TaskHandle_t task, uint32_t field_mask);
+
+/**
+ * @brief 取消订阅
+ * @param task 订阅任务
+ */
+void EtherCAT_OutputMonitor_Unsubscribe(TaskHandle_t task);
+
+/**
+ * @brief 获取当前锁存的输出数据
+ * @param outputs 输出数据
+ */
+void EtherCAT_OutputMonitor_GetOutputs(OutputDataCache_t *outputs);
+
 /**
  * @brief 更新输出数据缓存
  * @param force_update 强制更新（用于心跳或周期性检查）
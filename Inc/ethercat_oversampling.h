@@ -0,0 +1,189 @@
+/**
+ ******************************************************************************
+ * @file    ethercat_oversampling.h
+ * @brief   模拟通道过采样输入PDO模块头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 在每个DC同步周期(SYNC0)内对选定的ADS8688通道等间隔采样N次,
+ * 打包为TxPDO 0x1A01:
+ *
+ *   0x6010.1  首个采样点对应SYNC0事件的DC系统时间 (UINT32, ns)
+ *   0x6010.2  累计丢失采样点数 (UINT16)
+ *   0x6011.1-N 通道A的N个采样 (UINT16, ADS8688原始值)
+ *   0x6012.1-N 通道B的N个采样 (仅选择两个通道时)
+ *
+ * 第1个采样在SYNC0之后立即启动, 其余N-1个由硬件定时器按 周期/N
+ * 的间隔触发, 各采样点由SPI DMA完成, 中断中不等待传输.
+ * 过采样倍数和通道只能在PREOP下通过0x8010修改,
+ * PREOP->SAFEOP时按SYNC0周期锁定, 运行期间不再变化.
+ ******************************************************************************
+ */
+
+#ifndef __ETHERCAT_OVERSAMPLING_H
+#define __ETHERCAT_OVERSAMPLING_H
+
+#include "FreeRTOS.h"
+#include "stm32f4xx_hal.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define OVERSAMPLING_MAX_FACTOR         10          // 每周期最大采样次数
+#define OVERSAMPLING_MAX_CHANNELS       2           // 最大过采样通道数
+#define OVERSAMPLING_ADC_CHANNELS       8           // ADS8688通道数
+#define OVERSAMPLING_CHANNEL_NONE       0xFF        // 未使用的通道
+#define OVERSAMPLING_SAMPLE_INVALID     0xFFFF      // 丢失的采样点
+#define OVERSAMPLING_SAMPLE_MAX         0xFFFE      // 有效采样上限 (16位满量程码饱和到此值, 与丢失标记区分)
+
+#define OVERSAMPLING_MIN_CYCLE_NS       500000UL    // 最小SYNC0周期 (ns)
+#define OVERSAMPLING_SPI_FRAME_NS       40000UL     // 单个ADS8688 SPI帧耗时上限 (48位@1.3125MHz约36.6us, 含DMA中断开销)
+
+// TxPDO 0x1A01 最大条目数: 时间戳 + 丢失计数 + 采样
+#define OVERSAMPLING_MAX_PDO_ENTRIES    (2 + OVERSAMPLING_MAX_FACTOR * OVERSAMPLING_MAX_CHANNELS)
+
+// 采样间隔定时器 (APB1定时器时钟84MHz, 1MHz计数)
+#define OVERSAMPLING_TIMx               TIM4
+#define OVERSAMPLING_TIM_RCC_CLK_ENABLE() __HAL_RCC_TIM4_CLK_ENABLE()
+#define OVERSAMPLING_TIM_IRQ            TIM4_IRQn
+#define OVERSAMPLING_TIM_INT_FUN        TIM4_IRQHandler
+#define OVERSAMPLING_TIM_PRESCALER      83
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 过采样配置
+typedef struct {
+    uint8_t factor;                                 // 每周期采样次数 (1-OVERSAMPLING_MAX_FACTOR)
+    uint8_t channel_count;                          // 通道数 (1-OVERSAMPLING_MAX_CHANNELS)
+    uint8_t channels[OVERSAMPLING_MAX_CHANNELS];    // ADS8688通道号 (0-7)
+} oversampling_config_t;
+
+// 一个同步周期的采样帧
+typedef struct {
+    uint32_t timestamp;                             // 首个采样点对应SYNC0事件的DC系统时间 (ns)
+    uint16_t missed;                                // 累计丢失采样点数
+    uint16_t samples[OVERSAMPLING_MAX_CHANNELS][OVERSAMPLING_MAX_FACTOR];
+} oversampling_frame_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化过采样模块 (默认: 通道0, 不过采样)
+ */
+void Oversampling_Init(void);
+
+/**
+ * @brief 检查配置是否合法 (与SYNC0周期无关的部分)
+ * @param config 配置
+ * @return true=合法, false=不合法
+ */
+bool Oversampling_CheckConfig(const oversampling_config_t *config);
+
+/**
+ * @brief 设置配置 (仅在未运行时, 即PREOP下允许)
+ * @param config 配置
+ * @return pdPASS=成功, pdFAIL=运行中或配置不合法
+ */
+BaseType_t Oversampling_SetConfig(const oversampling_config_t *config);
+
+/**
+ * @brief 获取当前配置
+ * @param config 输出配置
+ */
+void Oversampling_GetConfig(oversampling_config_t *config);
+
+/**
+ * @brief 计算采样间隔 (按定时器分辨率1us向下取整)
+ * @param cycle_time_ns SYNC0周期 (ns)
+ * @param factor 每周期采样次数
+ * @return 采样间隔 (us)
+ */
+uint32_t Oversampling_GetSpacingUs(uint32_t cycle_time_ns, uint8_t factor);
+
+/**
+ * @brief 检查配置在给定SYNC0周期下能否完成采样
+ * @param config 配置
+ * @param cycle_time_ns SYNC0周期 (ns)
+ * @return true=可行, false=周期过短或采样间隔容纳不下SPI传输
+ */
+bool Oversampling_CheckTiming(const oversampling_config_t *config, uint32_t cycle_time_ns);
+
+/**
+ * @brief 生成TxPDO 0x1A01映射条目
+ * @param config 配置
+ * @param entries 输出条目 (至少OVERSAMPLING_MAX_PDO_ENTRIES个)
+ * @return 条目数
+ */
+uint16_t Oversampling_BuildMapping(const oversampling_config_t *config, uint32_t *entries);
+
+/**
+ * @brief 获取TxPDO 0x1A01长度
+ * @param config 配置
+ * @return 字数 (UINT16)
+ */
+uint16_t Oversampling_GetPdoWords(const oversampling_config_t *config);
+
+/**
+ * @brief 按0x1A01布局打包采样帧
+ * @param config 配置
+ * @param frame 采样帧
+ * @param pdo 输出 (Oversampling_GetPdoWords个字)
+ */
+void Oversampling_PackFrame(const oversampling_config_t *config, const oversampling_frame_t *frame,
+                            uint16_t *pdo);
+
+/**
+ * @brief 锁定配置并开始同步采样 (PREOP->SAFEOP)
+ * @param cycle_time_ns SYNC0周期 (ns)
+ * @return pdPASS=成功, pdFAIL=周期不满足要求
+ */
+BaseType_t Oversampling_Start(uint32_t cycle_time_ns);
+
+/**
+ * @brief 停止同步采样并解锁配置 (SAFEOP->PREOP)
+ */
+void Oversampling_Stop(void);
+
+/**
+ * @brief 是否正在同步采样
+ */
+bool Oversampling_IsRunning(void);
+
+/**
+ * @brief SYNC0事件处理: 挂起定时器中断, 由其启动第1个采样和间隔定时器 (SYNC0中断调用)
+ * @param dc_time SYNC0事件的DC系统时间 (ns), 写入新采样帧
+ */
+void Oversampling_OnSync0(uint32_t dc_time);
+
+/**
+ * @brief 采样间隔定时器中断处理 (同时处理SYNC0挂起的新帧)
+ */
+void Oversampling_TimerIsr(void);
+
+/**
+ * @brief 按0x1A01布局复制最新的完整采样帧 (APPL_InputMapping调用)
+ * @param pdo 输出 (Oversampling_GetPdoWords个字)
+ */
+void Oversampling_CopyPdo(uint16_t *pdo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ETHERCAT_OVERSAMPLING_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,191 @@
+/**
+ ******************************************************************************
+ * @file    ethercat_process_image.h
+ * @brief   墨路控制TxPDO过程映像转换模块头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 0x6000-0x6007输入对象的每个通道在映像表中只描述一次
+ * (数据源、缩放、偏移、饱和上下限), 由一个转换函数按表一次性
+ * 将传感器快照和应用数据转换为TxPDO 0x1A00的INT16映像:
+ *
+ *   image = saturate((value + offset) * scale, min, max)  (向零截断)
+ *
+ * 映像采用双缓冲: 任务上下文中转换, 完成后切换发布索引,
+ * APPL_InputMapping (PDI中断) 只复制最新的完整映像.
+ ******************************************************************************
+ */
+
+#ifndef __ETHERCAT_PROCESS_IMAGE_H
+#define __ETHERCAT_PROCESS_IMAGE_H
+
+#include "sensor_task_v3.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 过程映像定义 */
+/* ========================================================================== */
+
+#define PROCESS_IMAGE_TXPDO_WORDS       25          // TxPDO 0x1A00映射的INT16条目数
+
+// 通道数据源类型
+typedef enum {
+    PI_SOURCE_SENSOR = 0,           // 传感器快照 (sensor_context_t中的float字段)
+    PI_SOURCE_APPL   = 1            // 应用数据 (ProcessImage_SetApplValue设置)
+} pi_source_t;
+
+// 应用数据通道 (非传感器量, 由控制/执行器/状态机写入)
+typedef enum {
+    PI_APPL_INPUT_STATUS = 0,       // 0x6000.1 输入状态
+    PI_APPL_OUTPUT_STATUS,          // 0x6000.2 输出状态
+    PI_APPL_ALARM_1,                // 0x6001.1 报警信息1
+    PI_APPL_ALARM_2,                // 0x6001.2 报警信息2
+    PI_APPL_INFO_1,                 // 0x6002.1 提示信息1
+    PI_APPL_INFO_2,                 // 0x6002.2 提示信息2
+    PI_APPL_STATE_DISPLAY,          // 0x6003.1 状态显示
+    PI_APPL_STATE_CODE,             // 0x6003.2 状态码
+    PI_APPL_SUPPLY_PUMP_PERCENT,    // 0x6005.1 供墨泵流量% (0-100%)
+    PI_APPL_RETURN_PUMP_PERCENT,    // 0x6005.2 回墨泵流量% (0-100%)
+    PI_APPL_PIN_SETPOINT,           // 0x6006.1 Pin目标值 (kPa)
+    PI_APPL_POUT_SETPOINT,          // 0x6006.2 Pout目标值 (kPa)
+    PI_APPL_FILL_PUMP_ANIM,         // 0x6007.5 填墨泵动画
+    PI_APPL_SUPPLY_PUMP_ANIM,       // 0x6007.6 供墨泵动画
+    PI_APPL_RETURN_PUMP_ANIM,       // 0x6007.7 回墨泵动画
+    PI_APPL_REFILL_PUMP_ANIM,       // 0x6007.8 补墨泵动画
+    PI_APPL_COLLECT_VALVE_ANIM,     // 0x6007.9 收墨电磁阀动画
+    PI_APPL_DRUM_RETURN_VALVE_ANIM, // 0x6007.10 墨桶回墨阀动画
+    PI_APPL_COUNT
+} pi_appl_value_t;
+
+// 过程映像通道描述 (映像表的一行)
+typedef struct {
+    uint16_t index;                 // 对象索引 (0x6000-0x6007)
+    uint8_t subindex;               // 子索引
+    uint8_t source;                 // 数据源 (pi_source_t)
+    uint16_t source_offset;         // PI_SOURCE_SENSOR: sensor_context_t内字节偏移; PI_SOURCE_APPL: pi_appl_value_t
+    float offset;                   // 缩放前偏移
+    float scale;                    // 缩放系数 (工程单位 -> PDO单位)
+    int16_t min;                    // 饱和下限
+    int16_t max;                    // 饱和上限
+} process_image_channel_t;
+
+/* ========================================================================== */
+/* 饱和转换 (桥接模块与映像转换共用, 保证结果逐位一致) */
+/* ========================================================================== */
+
+/**
+ * @brief 浮点值缩放并饱和为INT16 (向零截断)
+ * @param value 工程值
+ * @param offset 缩放前偏移
+ * @param scale 缩放系数
+ * @param min 饱和下限
+ * @param max 饱和上限
+ * @return 转换结果 (NaN为0, 与Cortex-M4 VCVT对原实现的结果一致)
+ */
+static inline int16_t ProcessImage_ScaleToInt16(float value, float offset, float scale,
+                                                int16_t min, int16_t max)
+{
+    float scaled_value = (value + offset) * scale;
+
+    if (scaled_value != scaled_value) {
+        return 0;
+    } else if (scaled_value > (float)max) {
+        return max;
+    } else if (scaled_value < (float)min) {
+        return min;
+    } else {
+        return (int16_t)scaled_value;
+    }
+}
+
+/**
+ * @brief 浮点值缩放并饱和为UINT16 (向零截断)
+ * @param value 工程值
+ * @param offset 缩放前偏移
+ * @param scale 缩放系数
+ * @return 转换结果 (0-65535)
+ */
+static inline uint16_t ProcessImage_ScaleToUInt16(float value, float offset, float scale)
+{
+    float scaled_value = (value + offset) * scale;
+
+    if (scaled_value > 65535.0f) {
+        return 65535;
+    } else if (scaled_value < 0.0f) {
+        return 0;
+    } else {
+        return (uint16_t)scaled_value;
+    }
+}
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化过程映像 (清零映像和应用数据)
+ */
+void ProcessImage_Init(void);
+
+/**
+ * @brief 获取TxPDO映像表
+ * @param count 输出通道数 (可为NULL)
+ * @return 映像表指针 (按0x1A00映射顺序)
+ */
+const process_image_channel_t *ProcessImage_GetSchema(uint16_t *count);
+
+/**
+ * @brief 按映像表一次性转换所有通道
+ * @param schema 映像表
+ * @param count 通道数
+ * @param snapshot 传感器快照
+ * @param appl_values 应用数据数组 (PI_APPL_COUNT个元素)
+ * @param image 输出映像 (count个INT16)
+ */
+void ProcessImage_Convert(const process_image_channel_t *schema, uint16_t count,
+                          const sensor_context_t *snapshot, const float *appl_values,
+                          int16_t *image);
+
+/**
+ * @brief 用传感器快照刷新TxPDO映像 (任务上下文调用)
+ * @param snapshot 传感器快照
+ */
+void ProcessImage_UpdateFromSensors(const sensor_context_t *snapshot);
+
+/**
+ * @brief 设置应用数据通道 (下次刷新映像时生效)
+ * @param id 应用数据通道
+ * @param value 工程值
+ */
+void ProcessImage_SetApplValue(pi_appl_value_t id, float value);
+
+/**
+ * @brief 获取最新的完整TxPDO映像 (可在中断中调用)
+ * @return 映像指针 (PROCESS_IMAGE_TXPDO_WORDS个INT16)
+ */
+const int16_t *ProcessImage_GetTxPdo(void);
+
+/**
+ * @brief 检查PDO映射条目是否与映像表一致
+ * @param entries 映射条目 (0xIIIISSLL格式, 同0x1A00子索引)
+ * @param count 条目数
+ * @return true=一致, false=不一致
+ */
+bool ProcessImage_MatchesMapping(const uint32_t *entries, uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ETHERCAT_PROCESS_IMAGE_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
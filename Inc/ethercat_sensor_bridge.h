@@ -15,7 +15,7 @@
 
 #include "main.h"
 #include "sensor_simulator.h"
-#include "SSC-Device.h"
+#include "stream_stats.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -226,4 +226,14 @@ int EtherCAT_SensorBridge_GetSensorStats(uint8_t sensor_id,
                                          float *max_value,
                                          float *avg_value);
 
+/**
+ * @brief 获取传感器完整统计信息
+ * @param sensor_id 传感器ID
+ * @param summary 输出统计结果 (均值/方差/窗口极值/分位数)
+ * @return 获取结果
+ * @retval 0 成功
+ * @retval -1 失败
+ */
+int EtherCAT_SensorBridge_GetSensorStatsSummary(uint8_t sensor_id, stream_stats_summary_t *summary);
+
 #endif /* _ETHERCAT_SENSOR_BRIDGE_H_ */
@@ -0,0 +1,99 @@
+/**
+ ******************************************************************************
+ * @file    fopdt_model.h
+ * @brief   一阶加纯滞后(FOPDT)过程模型头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * G(s) = K·e^(-θs) / (τs + 1), 用于Smith预估器/内模控制:
+ * - 一阶部分按零阶保持精确离散: x = a·x + (1-a)·K·u, a = e^(-dt/τ)
+ * - 纯滞后用FOPDT_MODEL_DELAY_SLOTS格延迟线, 每格θ/N秒, 两格之间线性插值
+ *
+ * 延迟线长度固定, 与θ折合的采样数无关; 每次更新写入本间隔经过的格
+ * (采样间隔不超过θ/N时最多1格, 任何情况下不超过N+1格).
+ * 模型输出为 K·u 的响应, 不含过程偏置, 预估器只使用有/无滞后输出之差.
+ ******************************************************************************
+ */
+
+#ifndef __FOPDT_MODEL_H
+#define __FOPDT_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define FOPDT_MODEL_DELAY_SLOTS         64          // 纯滞后延迟线格数 N (不大于254)
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+typedef struct {
+    // 模型参数
+    float gain;                         // 静态增益 K
+    float time_constant;                // 时间常数 τ (秒)
+    float dead_time;                    // 纯滞后 θ (秒)
+    float slot_time;                    // 延迟线每格时长 θ/N (秒)
+
+    // 状态
+    float state;                        // 无滞后输出
+    float elapsed;                      // 距最近一格写入的时间 (秒)
+    float history[FOPDT_MODEL_DELAY_SLOTS + 1];     // 延迟线 (环形, 每格一个无滞后输出)
+    uint8_t head;                       // 最近写入的格
+} fopdt_model_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化模型 (状态按输入0预置)
+ * @param model 模型
+ * @param gain 静态增益 K
+ * @param time_constant 时间常数 τ (秒, 0=无惯性)
+ * @param dead_time 纯滞后 θ (秒, 0=无滞后)
+ */
+void FopdtModel_Init(fopdt_model_t *model, float gain, float time_constant, float dead_time);
+
+/**
+ * @brief 按稳态预置 (模型输出和延迟线都取 K·input, 预估校正量为0)
+ * @param model 模型
+ * @param input 当前输入
+ */
+void FopdtModel_Reset(fopdt_model_t *model, float input);
+
+/**
+ * @brief 推进一个采样间隔
+ * @param model 模型
+ * @param input 本间隔内保持的输入
+ * @param dt 采样间隔 (秒)
+ */
+void FopdtModel_Update(fopdt_model_t *model, float input, float dt);
+
+/**
+ * @brief 无滞后模型输出
+ */
+float FopdtModel_GetOutput(const fopdt_model_t *model);
+
+/**
+ * @brief 滞后θ后的模型输出
+ */
+float FopdtModel_GetDelayedOutput(const fopdt_model_t *model);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FOPDT_MODEL_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,108 @@
+/**
+ ******************************************************************************
+ * @file    latency_trace.h
+ * @brief   采样到输出端到端延迟跟踪头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 每个采集样本带通道输出序号和采集时刻 (Profiler_Now计数), 经传感器、
+ * 控制、执行器任务传递到写硬件输出为止:
+ * - 传感器任务: sensor_data_t.sequence / acquire_time
+ * - 控制任务: 回路计算时生成latency_stamp_t, 记录"采样->控制"延迟,
+ *   随ACTUATOR_CMD_SET_OUTPUT命令下发
+ * - 执行器任务: 新值第一次写入GPIO/PWM时记录"采样->输出"延迟
+ *
+ * 同一样本只在每个阶段首次到达时记录一次 (周期调度下同一样本会被
+ * 重复计算和下发). 每个阶段由一个任务更新, 统计格式与task_profiler相同.
+ * 计时基于DWT计数器, 单个延迟不得超过其回绕时长 (168MHz下约25.5秒).
+ ******************************************************************************
+ */
+
+#ifndef __LATENCY_TRACE_H
+#define __LATENCY_TRACE_H
+
+#include "task_profiler.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define LATENCY_TRACE_MAX_LOOPS         12      // 跟踪的回路数 (不小于CONTROL_LOOP_COUNT)
+#define LATENCY_TRACE_NO_LOOP           0xFF    // 不跟踪
+
+// 跟踪阶段 (均从采集时刻起算)
+typedef enum {
+    LATENCY_STAGE_CONTROL = 0,                  // 采样 -> 控制输出计算完成
+    LATENCY_STAGE_OUTPUT = 1,                   // 采样 -> 写入执行器硬件
+    LATENCY_STAGE_COUNT = 2
+} latency_stage_t;
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 样本标记 (随数据在任务间传递)
+typedef struct {
+    uint32_t sequence;                          // 输入通道输出序号 (0=无样本)
+    uint32_t acquire_time;                      // 采集时刻 (Profiler_Now计数)
+    uint8_t loop;                               // 控制回路 (LATENCY_TRACE_NO_LOOP=不跟踪)
+} latency_stamp_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化延迟跟踪 (DWT计数器由Profiler_Init启用)
+ */
+void LatencyTrace_Init(void);
+
+/**
+ * @brief 清除统计
+ */
+void LatencyTrace_Reset(void);
+
+/**
+ * @brief 清空样本标记 (不跟踪)
+ * @param stamp 样本标记
+ */
+void LatencyTrace_ClearStamp(latency_stamp_t *stamp);
+
+/**
+ * @brief 记录样本到达某阶段的延迟 (同一样本每阶段只记录首次)
+ * @param stamp 样本标记
+ * @param stage 阶段
+ * @return true=已记录, false=不跟踪或该样本已记录过
+ */
+bool LatencyTrace_Record(const latency_stamp_t *stamp, latency_stage_t stage);
+
+/**
+ * @brief 获取统计结果
+ * @param loop 控制回路
+ * @param stage 阶段
+ * @param summary 输出结果 (name为阶段名称)
+ * @return true=成功, false=回路或阶段无效
+ */
+bool LatencyTrace_GetSummary(uint8_t loop, latency_stage_t stage, profiler_summary_t *summary);
+
+/**
+ * @brief 打印各回路延迟统计 (调试用)
+ */
+void LatencyTrace_PrintStats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LATENCY_TRACE_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
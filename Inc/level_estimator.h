@@ -0,0 +1,143 @@
+/**
+ ******************************************************************************
+ * @file    level_estimator.h
+ * @brief   墨水液位卡尔曼估计器头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 两状态卡尔曼滤波 x = [液位h, 未建模净流量b], 融合三类信息:
+ * - 泵驱动量: 预测 h += (Σ pump_gain·驱动量 + b)·dt, b按随机游走
+ * - 模拟液位: 标量观测 z = h, 新息超过门限的样本剔除 (气泡/毛刺)
+ * - 浮球开关: 状态翻转时观测 z = 开关高度; 状态与估计矛盾时同样拉回开关高度
+ *
+ * 协方差只有3个独立元素, 预测/更新均手工展开, 每步O(1).
+ * 液位与流量单位由配置决定 (默认mm, mm/s), 流量即液位变化率.
+ ******************************************************************************
+ */
+
+#ifndef __LEVEL_ESTIMATOR_H
+#define __LEVEL_ESTIMATOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define LEVEL_ESTIMATOR_SWITCH_COUNT    3           // 浮球开关数
+#define LEVEL_ESTIMATOR_PUMP_COUNT      4           // 泵数 (调速泵1/2, 直流泵1/2)
+#define LEVEL_ESTIMATOR_GATE            5.0f        // 模拟液位新息门限 (σ)
+#define LEVEL_ESTIMATOR_MAX_REJECTS     10          // 连续剔除次数上限, 超过后按测量值重新初始化
+#define LEVEL_ESTIMATOR_INIT_FLOW_STD   1.0f        // 初始化时净流量的标准差 (mm/s)
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 估计器配置
+typedef struct {
+    float level_noise;              // 模拟液位测量噪声σ (mm)
+    float flow_noise;               // 未建模净流量变化强度 (mm/s/√s, 越大跟踪越快, 噪声越大)
+    float switch_height[LEVEL_ESTIMATOR_SWITCH_COUNT];  // 浮球开关动作高度 (mm, <0=不参与)
+    float switch_noise;             // 开关动作高度不确定度σ (mm)
+    float pump_gain[LEVEL_ESTIMATOR_PUMP_COUNT];        // 各泵100%驱动时的液位变化率 (mm/s, 抽出为负, 0=不计入)
+} level_estimator_config_t;
+
+// 估计结果
+typedef struct {
+    float level;                    // 液位 (mm)
+    float flow;                     // 净流量 (液位变化率, mm/s)
+    float level_std;                // 液位估计标准差 (mm)
+    float flow_std;                 // 净流量估计标准差 (mm/s)
+    bool valid;                     // 已由模拟液位或开关翻转初始化
+} level_estimate_t;
+
+// 估计器状态
+typedef struct {
+    level_estimator_config_t config;
+    float level;                    // 液位
+    float bias;                     // 未建模净流量 (泵模型之外的部分, 如供墨消耗)
+    float inflow;                   // 最近一次预测所用的泵流量
+    float p00;                      // 协方差 [p00 p01; p01 p11]
+    float p01;
+    float p11;
+    uint8_t switch_state[LEVEL_ESTIMATOR_SWITCH_COUNT];  // 上次开关状态 (0/1, 0xFF=未知)
+    uint16_t rejects;               // 连续剔除的模拟液位样本数
+    uint32_t rejected_total;        // 累计剔除数
+    bool initialized;
+} level_estimator_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 获取默认配置 (开关高度按报警/设定值位置, 泵增益为0需按现场标定)
+ * @param config 输出配置
+ */
+void LevelEstimator_DefaultConfig(level_estimator_config_t *config);
+
+/**
+ * @brief 检查配置
+ * @return true=合法 (噪声为正, 开关高度递增)
+ */
+bool LevelEstimator_CheckConfig(const level_estimator_config_t *config);
+
+/**
+ * @brief 初始化估计器 (未初始化状态, 等待第一个模拟液位样本或开关翻转)
+ * @param est 估计器
+ * @param config 配置 (NULL=默认配置)
+ */
+void LevelEstimator_Init(level_estimator_t *est, const level_estimator_config_t *config);
+
+/**
+ * @brief 更换配置 (状态保留, 开关边沿记录清除)
+ */
+void LevelEstimator_SetConfig(level_estimator_t *est, const level_estimator_config_t *config);
+
+/**
+ * @brief 时间更新
+ * @param est 估计器
+ * @param pump 各泵驱动量 (0-100%, LEVEL_ESTIMATOR_PUMP_COUNT个, NULL=全部为0)
+ * @param dt 距上次预测的时间 (秒)
+ */
+void LevelEstimator_Predict(level_estimator_t *est, const float *pump, float dt);
+
+/**
+ * @brief 模拟液位观测更新
+ * @param est 估计器
+ * @param level 测量液位 (未滤波)
+ * @return true=已采用, false=超出新息门限被剔除
+ */
+bool LevelEstimator_UpdateLevel(level_estimator_t *est, float level);
+
+/**
+ * @brief 浮球开关观测更新
+ * @param est 估计器
+ * @param index 开关序号 (0-2)
+ * @param active true=液位到达开关高度
+ */
+void LevelEstimator_UpdateSwitch(level_estimator_t *est, uint8_t index, bool active);
+
+/**
+ * @brief 获取估计结果
+ * @param est 估计器
+ * @param estimate 输出结果 (未初始化时valid=false)
+ */
+void LevelEstimator_GetEstimate(const level_estimator_t *est, level_estimate_t *estimate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LEVEL_ESTIMATOR_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,158 @@
+/**
+ ******************************************************************************
+ * @file    loop_kpi.h
+ * @brief   控制回路性能指标(KPI)头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 滑动时间窗口指标 (窗口按时间等分为LOOP_KPI_BUCKETS个桶, 每个样本O(1)):
+ * - IAE = ∫|e|dt, ISE = ∫e²dt
+ * - ITAE = ∫t·|e|dt, t从窗口起点计 (越新的误差权重越大)
+ * - 振荡指数: 窗口内误差过零次数/2 (带回差), 即窗口内振荡周期数
+ * - 饱和比例: 输出饱和时间/窗口时间
+ *
+ * 最近一次设定值阶跃的响应指标:
+ * - 超调量: 过程值越过设定值的最大量/阶跃幅值 (%)
+ * - 调节时间: 阶跃后误差最后一次超出 ±LOOP_KPI_SETTLING_BAND×阶跃幅值 的时刻
+ *
+ * 窗口累加和在桶环每转一圈时重新求和一次, 防止浮点加减长期漂移.
+ ******************************************************************************
+ */
+
+#ifndef __LOOP_KPI_H
+#define __LOOP_KPI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define LOOP_KPI_BUCKETS                20          // 窗口分桶数 (不大于255)
+#define LOOP_KPI_STEP_THRESHOLD         0.01f       // 设定值阶跃检测阈值 (量程的比例)
+#define LOOP_KPI_SETTLING_BAND          0.02f       // 调节时间误差带 (阶跃幅值的比例)
+#define LOOP_KPI_CROSSING_BAND          0.005f      // 过零检测回差 (量程的比例)
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 窗口桶 (桶内部分和)
+typedef struct {
+    float duration;                 // 桶内时间 (秒)
+    float iae;                      // Σ|e|dt
+    float ise;                      // Σe²dt
+    float itae;                     // Σt·|e|dt, t从桶起点计
+    float saturated_time;           // 输出饱和时间 (秒)
+    uint16_t samples;               // 样本数
+    uint16_t crossings;             // 误差过零次数
+} loop_kpi_bucket_t;
+
+// 单回路KPI
+typedef struct {
+    // 配置
+    float bucket_time;              // 每桶时长 (秒)
+    float step_threshold;           // 设定值阶跃检测阈值
+    float crossing_band;            // 过零检测回差
+
+    // 滑动窗口
+    loop_kpi_bucket_t buckets[LOOP_KPI_BUCKETS];
+    uint8_t head;                   // 当前(未满)桶
+    uint8_t count;                  // 已用桶数 (含当前桶)
+    float window_time;              // 窗口合计
+    float iae;
+    float ise;
+    float itae;                     // t从窗口起点计
+    float saturated_time;
+    uint32_t samples;
+    uint32_t crossings;
+    int8_t error_sign;              // 上次越过回差时的误差符号 (0=尚未越过)
+
+    // 阶跃响应
+    bool primed;                    // 已有样本
+    bool step_active;               // 最近一次阶跃幅值足够大, 响应指标有效
+    bool settled;                   // 误差当前在调节误差带内
+    float last_setpoint;
+    float step_size;                // 阶跃幅值 (阶跃时刻的|误差|)
+    float step_direction;           // 过程值应变化的方向 (+1/-1)
+    float step_peak;                // 过程值越过设定值的最大量
+    float step_elapsed;             // 阶跃后经过时间 (秒)
+    float settling_time;            // 误差最后一次超出误差带的时刻 (秒)
+    uint32_t step_count;            // 检测到的阶跃次数
+} loop_kpi_t;
+
+// KPI结果
+typedef struct {
+    uint32_t samples;               // 窗口内样本数
+    float window_time;              // 窗口时长 (秒)
+    float iae;                      // 绝对误差积分
+    float ise;                      // 平方误差积分
+    float itae;                     // 时间加权绝对误差积分
+    float mean_abs_error;           // 平均绝对误差 (IAE/窗口时长)
+    float oscillation_index;        // 振荡指数 (窗口内振荡周期数)
+    float saturation;               // 输出饱和时间比例 (0-1)
+    float overshoot;                // 最近一次阶跃超调量 (%)
+    float settling_time;            // 最近一次阶跃调节时间 (秒)
+    bool settled;                   // 已进入调节误差带
+    uint32_t step_count;            // 检测到的阶跃次数
+} loop_kpi_summary_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化KPI
+ * @param kpi KPI对象
+ * @param range 过程值量程 (阶跃检测和过零回差按量程比例计算)
+ * @param window_time 窗口时长 (秒, 含未满的当前桶, 实际窗口约为其(N-1)/N到1倍;
+ *                    桶在时长达到后才关闭, 每桶可多出不到一个采样周期)
+ */
+void LoopKpi_Init(loop_kpi_t *kpi, float range, float window_time);
+
+/**
+ * @brief 清空窗口和阶跃响应 (保留配置)
+ * @param kpi KPI对象
+ */
+void LoopKpi_Reset(loop_kpi_t *kpi);
+
+/**
+ * @brief 加入一个控制周期的样本
+ * @param kpi KPI对象
+ * @param setpoint 设定值
+ * @param process_value 过程值
+ * @param dt 本周期采样时间 (秒)
+ * @param saturated 输出是否饱和
+ */
+void LoopKpi_Update(loop_kpi_t *kpi, float setpoint, float process_value, float dt, bool saturated);
+
+/**
+ * @brief 获取窗口平均绝对误差
+ * @param kpi KPI对象
+ * @return IAE/窗口时长 (无样本时为0)
+ */
+float LoopKpi_GetMeanAbsError(const loop_kpi_t *kpi);
+
+/**
+ * @brief 获取KPI结果
+ * @param kpi KPI对象
+ * @param summary 输出结果
+ * @return true=有样本, false=无样本(结果清零)
+ */
+bool LoopKpi_GetSummary(const loop_kpi_t *kpi, loop_kpi_summary_t *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOOP_KPI_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
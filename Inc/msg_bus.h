@@ -0,0 +1,146 @@
+/**
+ ******************************************************************************
+ * @file    msg_bus.h
+ * @brief   零拷贝发布/订阅消息总线头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 按主题发布消息, 消息体放在各主题固定大小的内存池块中, 带引用计数:
+ * - 发布者先MsgBus_Alloc取得块, 直接在块内填写数据, 再MsgBus_Publish
+ * - 主题没有订阅者时MsgBus_Alloc返回NULL, 发布者不做任何复制,
+ *   内存池也不分配
+ * - 订阅者队列中只传递块指针, 用完后MsgBus_Release, 最后一个释放者归还块
+ *
+ * 只能在任务上下文中调用, 不支持中断.
+ ******************************************************************************
+ */
+
+#ifndef __MSG_BUS_H
+#define __MSG_BUS_H
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define MSG_BUS_MAX_SUBSCRIBERS         4       // 每个主题最多订阅者数
+#define MSG_BUS_MAX_BLOCKS              8       // 每个主题最多内存块数
+
+// 主题
+typedef enum {
+    MSG_BUS_TOPIC_SENSOR_DATA = 0,      // 传感器上下文 (sensor_msg_t)
+    MSG_BUS_TOPIC_CONTROL_STATUS = 1,   // 控制状态 (control_msg_t)
+    MSG_BUS_TOPIC_COUNT = 2
+} msg_bus_topic_t;
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 订阅者
+typedef struct {
+    QueueHandle_t queue;            // 块指针队列
+    msg_bus_topic_t topic;          // 订阅的主题
+    uint32_t dropped;               // 队列满丢弃的消息数
+} msg_bus_subscriber_t;
+
+// 主题统计
+typedef struct {
+    uint32_t published;             // 已投递的消息数
+    uint32_t skipped;               // 无订阅者而跳过的发布次数
+    uint32_t alloc_failures;        // 内存块耗尽次数
+    uint32_t deliver_failures;      // 订阅者队列满次数
+    uint32_t pool_bytes;            // 内存池大小 (字节, 含块头)
+    uint16_t payload_size;          // 消息体大小 (字节)
+    uint8_t block_count;            // 内存块数
+    uint8_t blocks_in_use;          // 当前占用块数
+    uint8_t blocks_peak;            // 峰值占用块数
+    uint8_t subscriber_count;       // 订阅者数
+} msg_bus_topic_stats_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 创建主题 (内存池在第一个订阅者出现时分配)
+ * @param topic 主题
+ * @param payload_size 消息体大小 (字节)
+ * @param block_count 内存块数 (1-MSG_BUS_MAX_BLOCKS)
+ * @return pdPASS=成功, pdFAIL=参数错误、重复创建或内存不足
+ */
+BaseType_t MsgBus_CreateTopic(msg_bus_topic_t topic, uint16_t payload_size, uint8_t block_count);
+
+/**
+ * @brief 订阅主题 (可在主题创建之前调用)
+ * @param topic 主题
+ * @param depth 订阅者队列深度 (块指针个数)
+ * @return 订阅者, NULL=订阅者已满或内存不足
+ */
+msg_bus_subscriber_t *MsgBus_Subscribe(msg_bus_topic_t topic, uint8_t depth);
+
+/**
+ * @brief 主题是否有订阅者
+ * @param topic 主题
+ * @return true=有订阅者
+ */
+bool MsgBus_HasSubscribers(msg_bus_topic_t topic);
+
+/**
+ * @brief 为发布申请一个消息块
+ * @param topic 主题
+ * @return 消息体指针, NULL=无订阅者、主题未创建或内存块耗尽
+ */
+void *MsgBus_Alloc(msg_bus_topic_t topic);
+
+/**
+ * @brief 发布消息块 (调用后发布者不得再访问该块)
+ * @param payload MsgBus_Alloc返回的消息体指针
+ */
+void MsgBus_Publish(void *payload);
+
+/**
+ * @brief 放弃未发布的消息块
+ * @param payload MsgBus_Alloc返回的消息体指针
+ */
+void MsgBus_Discard(void *payload);
+
+/**
+ * @brief 接收消息
+ * @param subscriber 订阅者
+ * @param timeout_ms 超时时间
+ * @return 消息体指针 (只读, 用完必须MsgBus_Release), NULL=超时
+ */
+const void *MsgBus_Receive(msg_bus_subscriber_t *subscriber, uint32_t timeout_ms);
+
+/**
+ * @brief 释放接收到的消息
+ * @param payload MsgBus_Receive返回的消息体指针
+ */
+void MsgBus_Release(const void *payload);
+
+/**
+ * @brief 获取主题统计
+ * @param topic 主题
+ * @param stats 输出统计
+ */
+void MsgBus_GetTopicStats(msg_bus_topic_t topic, msg_bus_topic_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MSG_BUS_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
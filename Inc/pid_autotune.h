@@ -0,0 +1,161 @@
+/**
+ ******************************************************************************
+ * @file    pid_autotune.h
+ * @brief   继电反馈PID自整定头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * Åström–Hägglund继电反馈法: 输出在 bias±amplitude 之间切换 (带回差),
+ * 过程值进入极限环后测量:
+ * - 临界周期 Tu: 相邻两次向上切换的间隔
+ * - 临界增益 Ku = 4d / (π·sqrt(a² - ε²)), a为过程值振幅, ε为回差
+ * - 纯滞后 θ: 继电器切换到过程值出现极值的时间
+ *
+ * 由Ku/Tu/θ按一阶加纯滞后(FOPDT)模型反推 K 和 τ, 给出Ziegler–Nichols
+ * 或SIMC整定参数. 每次调用只做O(1)计算, 在控制周期内逐拍运行, 不阻塞
+ * 其他回路. 只支持正作用回路 (输出增大过程值增大).
+ ******************************************************************************
+ */
+
+#ifndef __PID_AUTOTUNE_H
+#define __PID_AUTOTUNE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define PID_AUTOTUNE_MIN_PERIODS        3           // 最少完整振荡周期数 (首个周期视为过渡过程)
+#define PID_AUTOTUNE_TOLERANCE          0.05f       // 相邻周期周期/振幅相对偏差上限
+
+// 整定规则
+typedef enum {
+    PID_AUTOTUNE_RULE_ZN_PID = 0,       // Ziegler–Nichols PID: Kp=0.6Ku, Ti=Tu/2, Td=Tu/8
+    PID_AUTOTUNE_RULE_ZN_PI = 1,        // Ziegler–Nichols PI: Kp=0.45Ku, Ti=Tu/1.2
+    PID_AUTOTUNE_RULE_SIMC_PI = 2       // SIMC PI (τc=θ): Kp=τ/(2Kθ), Ti=min(τ, 8θ)
+} pid_autotune_rule_t;
+
+// 整定状态
+typedef enum {
+    PID_AUTOTUNE_IDLE = 0,              // 未运行
+    PID_AUTOTUNE_RUNNING = 1,           // 继电试验中
+    PID_AUTOTUNE_DONE = 2,              // 完成, 结果有效
+    PID_AUTOTUNE_FAILED = 3             // 失败
+} pid_autotune_state_t;
+
+// 失败原因
+typedef enum {
+    PID_AUTOTUNE_ERR_NONE = 0,
+    PID_AUTOTUNE_ERR_DEVIATION = 1,     // 过程值偏离设定值超限
+    PID_AUTOTUNE_ERR_TIMEOUT = 2,       // 切换次数用完仍未收敛
+    PID_AUTOTUNE_ERR_NO_OSCILLATION = 3,// 半周期超时, 继电器不再切换
+    PID_AUTOTUNE_ERR_AMPLITUDE = 4,     // 振幅不大于回差, 无法计算Ku
+    PID_AUTOTUNE_ERR_ABORTED = 5        // 外部中止
+} pid_autotune_error_t;
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 试验配置
+typedef struct {
+    float setpoint;                     // 振荡中心
+    float bias;                         // 输出中心值
+    float amplitude;                    // 继电幅值 d
+    float hysteresis;                   // 回差 ε
+    float max_deviation;                // 过程值允许偏离设定值的最大量
+    float sample_time;                  // 调用周期 (秒)
+    float max_half_period;              // 半周期超时 (秒)
+    uint16_t max_switches;              // 最多切换次数
+} pid_autotune_config_t;
+
+// 辨识结果
+typedef struct {
+    float ku;                           // 临界增益
+    float tu;                           // 临界周期 (秒)
+    float amplitude;                    // 过程值振幅
+    float dead_time;                    // 纯滞后 θ (秒)
+    float gain;                         // FOPDT静态增益 K
+    float time_constant;                // FOPDT时间常数 τ (秒)
+} pid_autotune_result_t;
+
+// 自整定器
+typedef struct {
+    pid_autotune_config_t config;
+    pid_autotune_state_t state;
+    pid_autotune_error_t error;
+
+    bool relay_high;                    // 当前继电输出为高
+    uint32_t tick;                      // 已运行拍数
+    uint32_t switch_tick;               // 上次切换时刻
+    uint32_t rise_tick;                 // 上次向上切换时刻
+    uint16_t switches;                  // 切换次数
+    uint16_t periods;                   // 完整周期数
+
+    float pv_max;                       // 本周期过程值最大值
+    float pv_min;                       // 本周期过程值最小值
+    float extreme;                      // 本半周期过程值极值
+    uint32_t extreme_tick;              // 极值时刻
+
+    float period[2];                    // 最近两个周期 (秒)
+    float peak[2];                      // 最近两个振幅
+    float dead_time_sum;                // 纯滞后样本累加
+    uint16_t dead_time_count;
+
+    pid_autotune_result_t result;
+} pid_autotune_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 开始继电试验
+ * @param tuner 自整定器
+ * @param config 试验配置
+ * @return true=成功, false=配置不合法
+ */
+bool PidAutotune_Start(pid_autotune_t *tuner, const pid_autotune_config_t *config);
+
+/**
+ * @brief 运行一拍
+ * @param tuner 自整定器
+ * @param process_value 过程值
+ * @return 本拍输出 (结束或失败后为bias)
+ */
+float PidAutotune_Update(pid_autotune_t *tuner, float process_value);
+
+/**
+ * @brief 中止试验
+ * @param tuner 自整定器
+ */
+void PidAutotune_Abort(pid_autotune_t *tuner);
+
+/**
+ * @brief 按规则计算PID参数 (ki/kd按 输出 = kp·e + ki·∫e·dt + kd·de/dt 的形式)
+ * @param result 辨识结果
+ * @param rule 整定规则
+ * @param kp 输出比例系数
+ * @param ki 输出积分系数
+ * @param kd 输出微分系数
+ * @return true=成功, false=结果不足以使用该规则 (如SIMC需要有效的FOPDT模型)
+ */
+bool PidAutotune_ComputeGains(const pid_autotune_result_t *result, pid_autotune_rule_t rule,
+                              float *kp, float *ki, float *kd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PID_AUTOTUNE_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
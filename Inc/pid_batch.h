@@ -0,0 +1,135 @@
+/**
+ ******************************************************************************
+ * @file    pid_batch.h
+ * @brief   批量PID计算引擎头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 所有控制回路的参数和状态按"数组结构"(SoA)存放, 每周期一趟循环计算全部
+ * 激活回路, 热路径只访问增益/限幅/积分/微分等连续数组, 不触碰报警限制和
+ * 统计字段, 也不调用HAL_GetTick().
+ *
+ * 默认内核与原PID_Calculate逐项等价 (位置式, 死区, 积分限幅, 一阶微分
+ * 滤波, 输出限幅后回退积分抗饱和), 仅微分项改为乘以预先计算的1/Ts.
+ * 前馈量在限幅前加到输出上, 饱和判断和抗积分饱和包含前馈.
+ *
+ * 不使用CMSIS-DSP arm_pid_f32: 其增量式内核不保存积分量, 无法实现积分限幅、
+ * 死区内保持积分和微分滤波, 与现有回路整定不等价. PID_BATCH_USE_CMSIS置1时编译报错.
+ ******************************************************************************
+ */
+
+#ifndef __PID_BATCH_H
+#define __PID_BATCH_H
+
+#include "control_task_v3.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define PID_BATCH_MAX_LOOPS         CONTROL_LOOP_COUNT  // 回路数 (不大于32)
+
+#if defined(PID_BATCH_USE_CMSIS) && PID_BATCH_USE_CMSIS
+#error "PID_BATCH_USE_CMSIS: arm_pid_f32 has no integral clamp, deadband integral hold or derivative filter"
+#endif
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+typedef struct {
+    // 参数
+    float kp[PID_BATCH_MAX_LOOPS];
+    float ki[PID_BATCH_MAX_LOOPS];
+    float kd[PID_BATCH_MAX_LOOPS];
+    float output_min[PID_BATCH_MAX_LOOPS];
+    float output_max[PID_BATCH_MAX_LOOPS];
+    float integral_min[PID_BATCH_MAX_LOOPS];
+    float integral_max[PID_BATCH_MAX_LOOPS];
+    float derivative_filter[PID_BATCH_MAX_LOOPS];
+    float deadband[PID_BATCH_MAX_LOOPS];
+    float sample_time[PID_BATCH_MAX_LOOPS];         // 本周期采样时间 (默认取参数, 可由PidBatch_SetElapsed覆盖)
+    float inv_sample_time[PID_BATCH_MAX_LOOPS];
+
+    // 使能位图 (bit i = 回路i)
+    uint32_t enabled_mask;                          // PID使能
+    uint32_t integral_mask;                         // 积分项使能
+    uint32_t derivative_mask;                       // 微分项使能
+    uint32_t anti_windup_mask;                      // 抗积分饱和使能
+
+    // 状态
+    float integral[PID_BATCH_MAX_LOOPS];
+    float last_error[PID_BATCH_MAX_LOOPS];          // 上次误差 (死区处理后)
+    float filtered_derivative[PID_BATCH_MAX_LOOPS];
+    uint32_t primed_mask;                           // 已运行过至少一次 (微分项有效)
+
+    // 每周期输入
+    float setpoint[PID_BATCH_MAX_LOOPS];
+    float process_value[PID_BATCH_MAX_LOOPS];
+    float feedforward[PID_BATCH_MAX_LOOPS];         // 前馈量 (不用时为0)
+
+    // 每周期输出
+    float error[PID_BATCH_MAX_LOOPS];               // 原始误差
+    float output[PID_BATCH_MAX_LOOPS];
+    uint32_t deadband_mask;                         // 误差在死区内
+    uint32_t saturated_mask;                        // 输出饱和
+} pid_batch_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化批量PID (全部回路禁用, 状态清零)
+ * @param batch 批量PID
+ */
+void PidBatch_Init(pid_batch_t *batch);
+
+/**
+ * @brief 设置单个回路参数 (不清除状态)
+ * @param batch 批量PID
+ * @param index 回路索引
+ * @param params PID参数
+ */
+void PidBatch_SetParams(pid_batch_t *batch, uint8_t index, const pid_params_t *params);
+
+/**
+ * @brief 复位单个回路状态 (积分/微分/首次运行)
+ * @param batch 批量PID
+ * @param index 回路索引
+ */
+void PidBatch_Reset(pid_batch_t *batch, uint8_t index);
+
+/**
+ * @brief 设置单个回路本次计算的实际采样间隔 (非周期调度时使用,
+ *        积分和微分项按实际间隔计算, 直到下次调用或PidBatch_SetParams)
+ * @param batch 批量PID
+ * @param index 回路索引
+ * @param elapsed 距上次计算的时间 (秒, 不大于0时忽略)
+ */
+void PidBatch_SetElapsed(pid_batch_t *batch, uint8_t index, float elapsed);
+
+/**
+ * @brief 计算一个控制周期
+ * @param batch 批量PID (调用前填好setpoint/process_value/feedforward)
+ * @param active_mask 本周期参与计算的回路位图
+ * @note 位于active_mask但PID未使能的回路输出0且状态不变
+ */
+void PidBatch_Execute(pid_batch_t *batch, uint32_t active_mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PID_BATCH_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
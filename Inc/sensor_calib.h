@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ * @file    sensor_calib.h
+ * @brief   传感器多点标定拟合头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 标定模型: 标定值 = c2*x^2 + c1*x + c0, x为滤波后值, 系数按{c0, c1, c2}存放.
+ * - 0阶: 保留c1/c2, 只按各点残差均值修正c0 (单点零点标定)
+ * - 1阶: 最小二乘直线, 两点时即两点标定, c2清零
+ * - 2阶: 最小二乘二次曲线, 至少3点
+ * 拟合前将x平移/缩放到[-1, 1]附近再解正规方程, 避免原始量程较大时病态.
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_CALIB_H
+#define __SENSOR_CALIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define SENSOR_CALIB_MAX_POINTS         8       // 最多标定点数
+#define SENSOR_CALIB_MAX_ORDER          2       // 最高拟合阶数
+#define SENSOR_CALIB_COEFF_COUNT        (SENSOR_CALIB_MAX_ORDER + 1)
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 拟合标定系数
+ * @param x 各点测量值 (滤波后值)
+ * @param y 各点参考值
+ * @param count 点数 (不少于order+1, 不大于SENSOR_CALIB_MAX_POINTS)
+ * @param order 拟合阶数 (0-SENSOR_CALIB_MAX_ORDER)
+ * @param coeffs 输入当前系数{c0, c1, c2} (0阶时保留c1/c2), 成功时输出新系数
+ * @param rms 输出拟合残差均方根 (可为NULL)
+ * @return true=成功, false=点数不足或各点测量值过于接近(方程奇异)
+ */
+bool SensorCalib_Fit(const float *x, const float *y, uint8_t count, uint8_t order,
+                     float *coeffs, float *rms);
+
+/**
+ * @brief 计算标定值
+ * @param coeffs 系数{c0, c1, c2}
+ * @param x 滤波后值
+ * @return 标定值
+ */
+float SensorCalib_Apply(const float *coeffs, float x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_CALIB_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
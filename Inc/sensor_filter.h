@@ -0,0 +1,156 @@
+/**
+ ******************************************************************************
+ * @file    sensor_filter.h
+ * @brief   传感器滤波链头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 每个传感器一条可配置的滤波链, 最多SENSOR_FILTER_MAX_STAGES级, 按顺序执行:
+ * - 移动平均: 累加和递推, 每样本O(1), 每绕一圈重算一次累加和消除舍入误差
+ * - 指数滤波: y += alpha * (x - y), alpha为新样本权重 (1.0=不滤波)
+ * - 中值滤波: 有序窗口插入/删除, 抑制单点尖峰 (窗口长度为奇数, 不大于7)
+ * - 双二阶IIR: CMSIS-DSP arm_biquad_cascade_df1_f32, 系数按CMSIS顺序
+ *   {b0, b1, b2, a1, a2}, 其中a1/a2为差分方程中的正号系数
+ *   (y = b0*x0 + b1*x1 + b2*x2 + a1*y1 + a2*y2)
+ *
+ * 各级在第一个样本时按该样本预置为稳态, 上电后输出不会从0爬升.
+ * 非有限样本(NaN/Inf)不进入滤波链, 输出保持上一次的值并计入rejected,
+ * 否则会永久污染移动平均累加和, IIR状态和中值窗口.
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_FILTER_H
+#define __SENSOR_FILTER_H
+
+#include "stm32f4xx.h"       // 先于arm_math.h, 提供__FPU_PRESENT
+#include "arm_math.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define SENSOR_FILTER_MAX_STAGES            4       // 每条滤波链最多级数
+#define SENSOR_FILTER_MA_MAX_LENGTH         16      // 移动平均最大窗口
+#define SENSOR_FILTER_MEDIAN_MAX_LENGTH     7       // 中值滤波最大窗口 (奇数)
+#define SENSOR_FILTER_BIQUAD_MAX_SECTIONS   2       // 双二阶最多节数
+
+// 滤波级类型
+typedef enum {
+    SENSOR_FILTER_NONE = 0,                 // 直通
+    SENSOR_FILTER_MOVING_AVERAGE = 1,       // 移动平均
+    SENSOR_FILTER_EXPONENTIAL = 2,          // 指数滤波
+    SENSOR_FILTER_MEDIAN = 3,               // 中值滤波
+    SENSOR_FILTER_BIQUAD = 4                // 双二阶IIR
+} sensor_filter_type_t;
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 滤波级配置
+typedef struct {
+    sensor_filter_type_t type;              // 类型
+    uint8_t length;                         // 移动平均/中值窗口长度, 双二阶节数
+    float alpha;                            // 指数滤波新样本权重 (0-1]
+    float coeffs[5 * SENSOR_FILTER_BIQUAD_MAX_SECTIONS];    // 双二阶系数
+} sensor_filter_stage_config_t;
+
+// 滤波链配置
+typedef struct {
+    uint8_t stage_count;                    // 级数
+    sensor_filter_stage_config_t stages[SENSOR_FILTER_MAX_STAGES];
+} sensor_filter_config_t;
+
+// 滤波级状态
+typedef struct {
+    sensor_filter_stage_config_t config;
+    union {
+        struct {
+            float buffer[SENSOR_FILTER_MA_MAX_LENGTH];
+            float sum;
+            uint8_t index;
+        } ma;
+        struct {
+            float value;
+        } ema;
+        struct {
+            float window[SENSOR_FILTER_MEDIAN_MAX_LENGTH];  // 按到达顺序
+            float sorted[SENSOR_FILTER_MEDIAN_MAX_LENGTH];  // 升序
+            uint8_t index;
+        } median;
+        struct {
+            arm_biquad_casd_df1_inst_f32 instance;
+            float state[4 * SENSOR_FILTER_BIQUAD_MAX_SECTIONS];
+        } biquad;
+    } s;
+} sensor_filter_stage_t;
+
+// 滤波链
+typedef struct {
+    uint8_t stage_count;
+    bool primed;                            // 已用首个样本预置
+    uint32_t samples;                       // 已处理样本数
+    uint32_t rejected;                      // 丢弃的非有限样本数
+    float output;                           // 最近一次输出
+    sensor_filter_stage_t stages[SENSOR_FILTER_MAX_STAGES];
+} sensor_filter_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 检查滤波链配置
+ * @param config 配置
+ * @return true=合法
+ */
+bool SensorFilter_CheckConfig(const sensor_filter_config_t *config);
+
+/**
+ * @brief 按配置初始化(复位)滤波链
+ * @param filter 滤波链
+ * @param config 配置 (NULL=直通)
+ * @return true=成功, false=配置不合法 (滤波链置为直通)
+ */
+bool SensorFilter_Init(sensor_filter_t *filter, const sensor_filter_config_t *config);
+
+/**
+ * @brief 处理一个样本
+ * @param filter 滤波链
+ * @param value 输入
+ * @return 输出; 输入非有限时返回上一次输出 (尚未预置时原样返回输入)
+ */
+float SensorFilter_Process(sensor_filter_t *filter, float value);
+
+/**
+ * @brief 设置所有指数滤波级的系数
+ * @param filter 滤波链
+ * @param alpha 新样本权重 (0-1], 超出范围时忽略
+ */
+void SensorFilter_SetExponentialAlpha(sensor_filter_t *filter, float alpha);
+
+/**
+ * @brief 计算二阶巴特沃斯低通双二阶系数 (双线性变换)
+ * @param cutoff_hz 截止频率 (Hz)
+ * @param sample_hz 采样频率 (Hz)
+ * @param coeffs 输出5个系数 (CMSIS顺序)
+ * @return true=成功, false=截止频率不在(0, sample_hz/2)内
+ */
+bool SensorFilter_DesignLowpass(float cutoff_hz, float sample_hz, float *coeffs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_FILTER_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,138 @@
+/**
+ ******************************************************************************
+ * @file    sensor_linearize.h
+ * @brief   温度传感器线性化查表头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 热电阻/热敏电阻的解析公式(Callendar-Van Dusen反解需要开方或迭代,
+ * Steinhart-Hart需要对数和除法)不适合每个样本都计算. 本模块在初始化时
+ * 按解析公式在给定输入范围内均匀生成查找表, 运行时只做一次定位和
+ * 线性/二次插值, 每样本开销固定:
+ * - RTD: IEC 60751 CVD系数, 输入为电阻 (Ω)
+ * - NTC: Steinhart-Hart系数, 输入为分压比 R/(R+R_pullup), 比直接用
+ *   电阻作自变量更均匀, 两端用二次插值
+ *
+ * 输入超出表范围时按端点值钳位.
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_LINEARIZE_H
+#define __SENSOR_LINEARIZE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define SENSOR_LUT_MAX_POINTS           65      // 查找表最多点数 (64段)
+
+// IEC 60751 铂电阻CVD系数
+#define SENSOR_RTD_CVD_A                3.9083e-3f
+#define SENSOR_RTD_CVD_B                (-5.775e-7f)
+#define SENSOR_RTD_CVD_C                (-4.183e-12f)   // 仅0°C以下
+
+#define SENSOR_KELVIN_OFFSET            273.15f
+
+// 插值方式
+typedef enum {
+    SENSOR_LUT_LINEAR = 0,                  // 相邻两点线性插值
+    SENSOR_LUT_QUADRATIC = 1                // 最近三点二次插值
+} sensor_lut_interp_t;
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 均匀间隔查找表
+typedef struct {
+    float x_min;                            // 首点输入
+    float x_max;                            // 末点输入
+    float inv_step;                         // 1/点间隔
+    uint16_t points;                        // 点数
+    sensor_lut_interp_t interp;             // 插值方式
+    float y[SENSOR_LUT_MAX_POINTS];         // 各点输出
+} sensor_lut_t;
+
+// 热电阻参数
+typedef struct {
+    float r0;                               // 0°C电阻 (Pt100=100Ω, Pt1000=1000Ω)
+} sensor_rtd_params_t;
+
+// 热敏电阻参数 (NTC接下桥臂, 上拉电阻接ADC基准)
+typedef struct {
+    float a;                                // Steinhart-Hart系数 1/T = a + b*ln(R) + c*ln(R)^3
+    float b;
+    float c;
+    float r_pullup;                         // 上拉电阻 (Ω)
+} sensor_ntc_params_t;
+
+// 查表生成函数: 输入 -> 温度 (°C)
+typedef float (*sensor_lut_func_t)(float x, const void *params);
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 按函数在[x_min, x_max]上均匀生成查找表
+ * @param lut 查找表
+ * @param func 生成函数
+ * @param params 生成函数参数
+ * @param x_min 首点输入
+ * @param x_max 末点输入
+ * @param points 点数 (二次插值至少3点, 不大于SENSOR_LUT_MAX_POINTS)
+ * @param interp 插值方式
+ * @return true=成功, false=参数不合法
+ */
+bool SensorLut_Build(sensor_lut_t *lut, sensor_lut_func_t func, const void *params,
+                     float x_min, float x_max, uint16_t points, sensor_lut_interp_t interp);
+
+/**
+ * @brief 查表插值
+ * @param lut 查找表
+ * @param x 输入 (超出范围时钳位到端点)
+ * @return 输出
+ */
+float SensorLut_Lookup(const sensor_lut_t *lut, float x);
+
+/**
+ * @brief 热电阻电阻值 (CVD正向公式)
+ * @param temperature 温度 (°C)
+ * @param params 热电阻参数
+ * @return 电阻 (Ω)
+ */
+float SensorLinearize_RtdResistance(float temperature, const sensor_rtd_params_t *params);
+
+/**
+ * @brief 热电阻温度 (CVD反解: 0°C以上解二次方程, 以下牛顿迭代)
+ * @param resistance 电阻 (Ω)
+ * @param params 热电阻参数 (sensor_rtd_params_t)
+ * @return 温度 (°C)
+ */
+float SensorLinearize_RtdTemperature(float resistance, const void *params);
+
+/**
+ * @brief 热敏电阻温度 (Steinhart-Hart)
+ * @param ratio 分压比 R/(R+R_pullup), (0, 1)
+ * @param params 热敏电阻参数 (sensor_ntc_params_t)
+ * @return 温度 (°C)
+ */
+float SensorLinearize_NtcTemperature(float ratio, const void *params);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_LINEARIZE_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
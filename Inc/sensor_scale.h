@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ * @file    sensor_scale.h
+ * @brief   ADC通道批量工程量换算头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 一帧全部通道一次换算: 工程量 = 电压 * gain[ch] + offset[ch].
+ * 定义ARM_MATH_CM4时使用CMSIS-DSP arm_mult_f32/arm_add_f32 (按通道向量,
+ * arm_scale_f32/arm_offset_f32只接受标量), 否则用等价的C循环.
+ * 两种实现都是先乘后加, 逐通道舍入与标量 V*k+b 完全相同.
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_SCALE_H
+#define __SENSOR_SCALE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 按通道增益/偏置向量换算一帧
+ * @param voltage 各通道电压 (V)
+ * @param gain 各通道增益 (单位/V)
+ * @param offset 各通道偏置 (单位)
+ * @param value 输出工程量, 可与voltage相同
+ * @param count 通道数
+ */
+void SensorScale_Apply(const float *voltage, const float *gain, const float *offset,
+                       float *value, uint32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_SCALE_H */
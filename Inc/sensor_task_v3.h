@@ -36,6 +36,13 @@
 #include "semphr.h"
 #include "event_groups.h"
 #include "ads8688/bsp_ads8688.h"
+#include "stream_stats.h"
+#include "msg_bus.h"
+#include "sensor_filter.h"
+#include "sensor_linearize.h"
+#include "sensor_calib.h"
+#include "level_estimator.h"
+#include "task_profiler.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -68,7 +75,8 @@ extern "C" {
 
 #define SENSOR_TASK_PRIORITY           8        // 传感器任务优先级 (参考V3表格)
 #define SENSOR_TASK_STACK_SIZE         1024     // 堆栈大小 (words)
-#define SENSOR_TASK_PERIOD_MS          50       // 任务周期 50ms (参考V3表格)
+#define SENSOR_TASK_PERIOD_MS          50       // 任务周期 50ms (参考V3表格): 消息/事件/过程映像/健康检查
+#define SENSOR_BASE_TICK_MS            10       // 采样基础节拍 10ms, 各通道按sample_period_ms分频采样
 
 /* ========================================================================== */
 /* 传感器通道定义 (参考设计文档V3 第2.2.1节) */
@@ -99,11 +107,20 @@ typedef struct {
     uint8_t channel;              // ADC通道或I2C地址
     float scale_factor;           // 标定系数
     float offset;                 // 零点偏移
-    float filter_coefficient;     // 滤波系数 (0.0-1.0)
-    uint16_t sample_count;        // 采样次数
+    float quadratic_factor;       // 二次标定系数 (标定值 = quadratic_factor*x^2 + scale_factor*x + offset)
+    float filter_coefficient;     // 指数滤波系数 (新样本权重, 0.0-1.0, 1.0=不滤波)
+    uint16_t sample_count;        // 输出抽取比 (每N次采样更新一次输出, 0/1=不抽取)
+    uint16_t sample_period_ms;    // 采样周期 (ms, 按基础节拍向下取整, 0=每个节拍)
     bool enabled;                 // 使能标志
 } sensor_config_t;
 
+// 温度传感器前端模型 (决定ADC电压到温度的换算)
+typedef enum {
+    SENSOR_TEMP_MODEL_TRANSMITTER = 0,  // 温度变送器, 0-5V线性对应-50~150°C (默认)
+    SENSOR_TEMP_MODEL_PT100 = 1,        // Pt100直连: 1mA恒流激励, 10倍放大 (R = V*100Ω), 表范围-51~156°C
+    SENSOR_TEMP_MODEL_NTC = 2           // 10k NTC(B3950)接下桥臂, 10k上拉至5V (比值 = V/5), 表范围-8~119°C
+} sensor_temp_model_t;
+
 /* ========================================================================== */
 /* 传感器数据结构 (参考设计文档V3 第2.2.2节) */
 /* ========================================================================== */
@@ -113,6 +130,8 @@ typedef struct {
     float filtered_value;         // 滤波后值
     float calibrated_value;       // 标定后值
     uint32_t timestamp;           // 时间戳 (ms)
+    uint32_t sequence;            // 输出序号 (该通道每产生一个新输出加1, 0=尚无输出)
+    uint32_t acquire_time;        // 采集时刻 (Profiler_Now计数, 用于端到端延迟跟踪)
     bool valid;                   // 数据有效性
     uint16_t error_count;         // 错误计数
     uint8_t quality;              // 数据质量 (0-100)
@@ -130,9 +149,11 @@ typedef struct {
     float temp_values[3];         // 温度值 (°C) - 来自ADS8688 CH0-2
     float pressure_values[4];     // 压力值 (kPa) - 来自ADS8688 CH3-6
     float level_values[4];        // 液位值: [0-2]=浮球开关状态(0/1), [3]=模拟液位(mm, ADS8688 CH7)
+    level_estimate_t level_estimate;    // 液位/净流量融合估计 (模拟液位 + 浮球开关 + 泵驱动量)
     float flow_value;             // 流量值 (L/min)
 
     // 整体状态
+    uint32_t sequence;            // 快照序号 (每发布一次加1, 0=尚未发布)
     uint32_t cycle_count;         // 循环计数
     uint32_t last_update_time;    // 最后更新时间
     uint8_t overall_quality;      // 整体质量 (0-100)
@@ -148,9 +169,11 @@ typedef struct {
     uint32_t data_errors;         // 数据错误次数
     uint32_t queue_full_count;    // 队列满次数
     uint32_t timeout_count;       // 超时次数
-    uint16_t max_cycle_time_us;   // 最大循环时间 (微秒)
-    uint16_t avg_cycle_time_us;   // 平均循环时间 (微秒)
+    uint32_t max_cycle_time_us;   // 最大循环时间 (微秒, DWT计时)
+    uint32_t avg_cycle_time_us;   // 平均循环时间 (微秒, DWT计时)
     uint32_t total_samples;       // 总采样次数
+    uint32_t adc_scans;           // ADS8688全通道扫描次数 (有ADC通道到期的节拍扫描一次)
+    uint32_t deferred_samples;    // 多速率调度省去的采样次数 (相对全部通道每个节拍采样)
 } sensor_task_stats_t;
 
 /* ========================================================================== */
@@ -165,7 +188,7 @@ typedef enum {
     MSG_SENSOR_CALIBRATE          // 传感器校准消息
 } sensor_msg_type_t;
 
-// 传感器消息结构
+// 传感器消息结构 (消息总线MSG_BUS_TOPIC_SENSOR_DATA的消息体)
 typedef struct {
     sensor_msg_type_t type;       // 消息类型
     uint32_t timestamp;           // 时间戳
@@ -173,28 +196,49 @@ typedef struct {
     sensor_context_t context;     // 传感器上下文
 } sensor_msg_t;
 
+/* ========================================================================== */
+/* 标定服务 */
+/* ========================================================================== */
+
+// 标定服务状态
+typedef enum {
+    SENSOR_CALIB_IDLE = 0,        // 空闲
+    SENSOR_CALIB_COLLECTING = 1,  // 正在采集标定点
+    SENSOR_CALIB_READY = 2,       // 标定点已采集, 等待下一个点或提交
+    SENSOR_CALIB_DONE = 3,        // 新系数已生效
+    SENSOR_CALIB_FAILED = 4       // 拟合失败 (点数不足或各点过近), 系数未改变
+} sensor_calib_state_t;
+
+// 标定服务状态查询结果
+typedef struct {
+    sensor_calib_state_t state;   // 状态
+    sensor_type_t sensor_type;    // 正在标定的传感器
+    uint8_t point_count;          // 已采集点数
+    float coeffs[SENSOR_CALIB_COEFF_COUNT]; // 最近一次生效的系数 {offset, scale_factor, quadratic_factor}
+    float rms;                    // 最近一次拟合残差均方根
+} sensor_calib_status_t;
+
 /* ========================================================================== */
 /* 事件标志定义 */
 /* ========================================================================== */
 
 #define EVENT_SENSOR_DATA_READY      (1 << 0)   // 传感器数据就绪
 #define EVENT_SENSOR_ERROR           (1 << 1)   // 传感器错误
-#define EVENT_SENSOR_CALIBRATE       (1 << 2)   // 传感器校准请求
+#define EVENT_SENSOR_CALIBRATE       (1 << 2)   // 传感器标定结束 (新系数已生效或拟合失败)
 #define EVENT_SENSOR_CONFIG_UPDATE   (1 << 3)   // 传感器配置更新
+#define EVENT_SENSOR_CALIB_POINT     (1 << 4)   // 标定点采集完成
 
 /* ========================================================================== */
-/* 队列大小定义 */
+/* 消息总线定义 */
 /* ========================================================================== */
 
-#define SENSOR_MSG_QUEUE_SIZE        16         // 传感器消息队列大小
+#define SENSOR_MSG_POOL_BLOCKS       3          // 传感器消息内存块数 (填写中/排队中/订阅者持有)
 
 /* ========================================================================== */
 /* 全局变量声明 */
 /* ========================================================================== */
 
 extern TaskHandle_t xTaskHandle_SensorV3;
-extern QueueHandle_t xQueue_SensorMsg;
-extern SemaphoreHandle_t xMutex_SensorContext;
 extern EventGroupHandle_t xEventGroup_Sensor;
 
 /* ========================================================================== */
@@ -243,13 +287,56 @@ BaseType_t SensorTaskV3_ConfigureSensor(sensor_type_t sensor_type, const sensor_
 BaseType_t SensorTaskV3_GetSensorData(sensor_type_t sensor_type, sensor_data_t *data);
 
 /**
- * @brief 校准传感器
+ * @brief 获取通道输出周期 (采样周期 × 输出抽取比)
+ * @param sensor_type 传感器类型
+ * @return 输出周期 (ms), 参数错误时为0
+ */
+uint32_t SensorTaskV3_GetOutputPeriod(sensor_type_t sensor_type);
+
+/**
+ * @brief 注册快照发布通知: 有通道产生新输出的节拍, 发布快照后向该任务
+ *        发送任务通知 (xTaskNotifyGive), 接收方用ulTaskNotifyTake等待
+ * @param task 接收通知的任务 (NULL=取消)
+ */
+void SensorTaskV3_SetPublishNotify(TaskHandle_t task);
+
+/**
+ * @brief 单点零点标定 (不阻塞, 等效于AddPoint + Commit(0), 完成时置EVENT_SENSOR_CALIBRATE)
  * @param sensor_type 传感器类型
  * @param reference_value 参考值
- * @return pdTRUE=成功, pdFALSE=失败
+ * @return pdTRUE=请求已接受, pdFALSE=参数错误或标定服务忙
  */
 BaseType_t SensorTaskV3_CalibrateSensor(sensor_type_t sensor_type, float reference_value);
 
+/**
+ * @brief 采集一个标定点 (不阻塞, 传感器任务采集CALIBRATION_SAMPLES个滤波样本取均值,
+ *        完成时置EVENT_SENSOR_CALIB_POINT)
+ * @param sensor_type 传感器类型 (浮球开关除外; 与当前会话不同的传感器需先提交或取消)
+ * @param reference_value 参考值
+ * @return pdTRUE=请求已接受, pdFALSE=参数错误, 正在采集或点数已满
+ */
+BaseType_t SensorTaskV3_CalibrationAddPoint(sensor_type_t sensor_type, float reference_value);
+
+/**
+ * @brief 提交标定 (正在采集的点完成后拟合, 在传感器任务周期边界整体替换系数,
+ *        完成时置EVENT_SENSOR_CALIBRATE)
+ * @param sensor_type 传感器类型 (须与当前会话一致)
+ * @param order 拟合阶数: 0=零点修正, 1=增益+零点 (至少2点), 2=二次 (至少3点)
+ * @return pdTRUE=请求已接受, pdFALSE=无会话或参数错误
+ */
+BaseType_t SensorTaskV3_CalibrationCommit(sensor_type_t sensor_type, uint8_t order);
+
+/**
+ * @brief 取消当前标定会话 (系数不变)
+ */
+void SensorTaskV3_CalibrationCancel(void);
+
+/**
+ * @brief 查询标定服务状态
+ * @param status 状态输出
+ */
+void SensorTaskV3_GetCalibrationStatus(sensor_calib_status_t *status);
+
 /**
  * @brief 获取传感器任务统计信息
  * @param stats 统计信息结构指针
@@ -262,20 +349,57 @@ void SensorTaskV3_GetStatistics(sensor_task_stats_t *stats);
 void SensorTaskV3_ResetStatistics(void);
 
 /**
- * @brief 发送传感器消息到队列
- * @param msg 消息结构指针
- * @param timeout_ms 超时时间
- * @return pdTRUE=成功, pdFALSE=失败
+ * @brief 获取传感器任务分阶段计时器 (阶段: acquire/process/context/publish),
+ *        通过Profiler_GetSummary读取
  */
-BaseType_t SensorTaskV3_SendMessage(const sensor_msg_t *msg, uint32_t timeout_ms);
+const profiler_t *SensorTaskV3_GetProfiler(void);
 
 /**
- * @brief 从队列接收传感器消息
- * @param msg 消息结构指针
- * @param timeout_ms 超时时间
- * @return pdTRUE=成功, pdFALSE=失败
+ * @brief 获取传感器通道流式统计 (均值/方差/窗口极值/分位数)
+ * @param sensor_type 传感器类型
+ * @param summary 统计结果输出
+ * @return pdTRUE=成功 (无样本时summary全零), pdFALSE=参数错误或快照读取失败
+ * @note 读取传感器任务发布的快照, 不阻塞传感器任务
+ */
+BaseType_t SensorTaskV3_GetChannelStats(sensor_type_t sensor_type, stream_stats_summary_t *summary);
+
+/**
+ * @brief 复位传感器通道流式统计 (在传感器任务下一个节拍生效)
+ * @param sensor_type 传感器类型
+ * @return pdTRUE=成功, pdFALSE=参数错误
+ */
+BaseType_t SensorTaskV3_ResetChannelStats(sensor_type_t sensor_type);
+
+/**
+ * @brief 设置传感器滤波链 (在传感器任务下一周期生效, 滤波状态复位)
+ * @param sensor_type 传感器类型
+ * @param config 滤波链配置 (指数滤波级的系数始终取sensor_config_t.filter_coefficient)
+ * @return pdTRUE=成功, pdFALSE=参数错误
+ */
+BaseType_t SensorTaskV3_SetFilterChain(sensor_type_t sensor_type, const sensor_filter_config_t *config);
+
+/**
+ * @brief 设置温度传感器前端模型 (下一次采样生效)
+ * @param sensor_type 温度传感器 (SENSOR_TEMP_1 - SENSOR_TEMP_3)
+ * @param model 前端模型
+ * @return pdTRUE=成功, pdFALSE=参数错误
+ */
+BaseType_t SensorTaskV3_SetTemperatureModel(sensor_type_t sensor_type, sensor_temp_model_t model);
+
+/**
+ * @brief 设置液位估计器配置 (下一次模拟液位采样生效, 估计状态保留)
+ * @param config 配置 (浮球开关高度按安装位置, 泵增益按现场标定, 顺序同ACTUATOR_PUMP_OUTPUTS)
+ * @return pdTRUE=成功, pdFALSE=参数错误
  */
-BaseType_t SensorTaskV3_ReceiveMessage(sensor_msg_t *msg, uint32_t timeout_ms);
+BaseType_t SensorTaskV3_SetLevelEstimator(const level_estimator_config_t *config);
+
+/**
+ * @brief 订阅传感器数据消息
+ * @param depth 订阅者队列深度
+ * @return 订阅者, NULL=失败
+ * @note 用MsgBus_Receive取得const sensor_msg_t*, 用完后MsgBus_Release
+ */
+msg_bus_subscriber_t *SensorTaskV3_Subscribe(uint8_t depth);
 
 /**
  * @brief 获取温度传感器数组
@@ -313,6 +437,13 @@ BaseType_t SensorTaskV3_GetFloatSwitchStates(bool *switch_states);
  */
 float SensorTaskV3_GetAnalogLevel(void);
 
+/**
+ * @brief 获取液位融合估计
+ * @param estimate 输出估计 (液位mm, 净流量mm/s, 标准差)
+ * @return pdTRUE=估计有效, pdFALSE=尚未建立或读取失败
+ */
+BaseType_t SensorTaskV3_GetLevelEstimate(level_estimate_t *estimate);
+
 /**
  * @brief 获取流量值
  * @return 流量值 (L/min)
@@ -0,0 +1,96 @@
+/**
+ ******************************************************************************
+ * @file    seqlock.h
+ * @brief   双缓冲顺序锁(seqlock)快照发布头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 单写者/多读者的快照发布:
+ * - 写者交替写两个缓冲区, 从不等待读者
+ * - 读者复制最近一次发布的缓冲区, 复制期间若写者已开始覆盖该缓冲区
+ *   (即又完成一次发布并开始下一次), 则重试, 不会读到撕裂的数据
+ * - 序号: sequence为偶数表示稳定, 奇数表示写入中, sequence/2为已发布次数
+ *
+ * 写者只能有一个(同一任务), 读者可在任意任务中调用.
+ *
+ * 重试次数: 一次复制失败需要写者在复制期间开始两次新的发布. 写者按任务周期
+ * (毫秒级) 发布, 复制只需数微秒, 单核上读者须在复制中被抢占超过一个写者周期
+ * 才会重试, SEQLOCK_READ_RETRIES次都如此几乎不可能. 重试耗尽时返回false,
+ * 由调用者沿用上一次读到的快照或稍后再读 (Test/test_seqlock在发布间隔2us时断言耗尽比例<1e-3).
+ ******************************************************************************
+ */
+
+#ifndef __SEQLOCK_H
+#define __SEQLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define SEQLOCK_READ_RETRIES            4       // 读者最多重试次数
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+typedef struct {
+    volatile uint32_t sequence;     // 偶数=稳定, 奇数=写入中
+    void *buffers[2];               // 双缓冲区
+    uint16_t size;                  // 快照大小 (字节)
+} seqlock_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化顺序锁
+ * @param lock 顺序锁
+ * @param buffer0 缓冲区0
+ * @param buffer1 缓冲区1
+ * @param size 快照大小 (字节)
+ */
+void Seqlock_Init(seqlock_t *lock, void *buffer0, void *buffer1, uint16_t size);
+
+/**
+ * @brief 发布一份快照 (仅写者调用, 不阻塞)
+ * @param lock 顺序锁
+ * @param data 快照数据 (size字节)
+ */
+void Seqlock_Publish(seqlock_t *lock, const void *data);
+
+/**
+ * @brief 读取最近一次发布的快照的一部分
+ * @param lock 顺序锁
+ * @param offset 起始偏移 (字节)
+ * @param dst 输出
+ * @param size 读取长度 (字节)
+ * @param sequence 输出快照序号 (已发布次数, 可为NULL)
+ * @return true=成功, false=尚未发布或重试次数耗尽
+ */
+bool Seqlock_Read(const seqlock_t *lock, uint16_t offset, void *dst, uint16_t size, uint32_t *sequence);
+
+/**
+ * @brief 获取已发布次数
+ * @param lock 顺序锁
+ * @return 已发布次数
+ */
+uint32_t Seqlock_GetSequence(const seqlock_t *lock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SEQLOCK_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,129 @@
+/**
+ ******************************************************************************
+ * @file    stream_stats.h
+ * @brief   流式统计引擎头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 每个样本O(1)更新, 不保存历史数据:
+ * - 均值/方差: Welford递推, 累加量用double (float在10^5~10^6个样本后
+ *   delta/count小于均值的1 ULP, 均值不再更新), 非有限值不计入
+ * - 滑动窗口最小/最大值: 单调双端队列, 均摊O(1)
+ * - 分位数(P50/P95/P99): P²算法, 每个分位数5个标记点, 期望位置用double
+ *   (float超过2^24个样本后无法跟踪整数位置)
+ ******************************************************************************
+ */
+
+#ifndef __STREAM_STATS_H
+#define __STREAM_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define STREAM_STATS_WINDOW_SIZE        32      // 滑动窗口长度 (样本数, 不大于256)
+
+// 分位数索引
+typedef enum {
+    STREAM_STATS_P50 = 0,
+    STREAM_STATS_P95 = 1,
+    STREAM_STATS_P99 = 2,
+    STREAM_STATS_QUANTILE_COUNT = 3
+} stream_stats_quantile_t;
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 单调双端队列 (环形缓冲, 保存窗口内候选极值)
+typedef struct {
+    float value[STREAM_STATS_WINDOW_SIZE];
+    uint32_t seq[STREAM_STATS_WINDOW_SIZE];
+    uint8_t head;                   // 队首位置
+    uint8_t size;                   // 队列长度
+} stream_stats_deque_t;
+
+// P²分位数估计器
+typedef struct {
+    float p;                        // 目标分位 (0-1)
+    float q[5];                     // 标记点高度
+    double np[5];                   // 期望位置
+    double dn[5];                   // 期望位置增量
+    int32_t n[5];                   // 实际位置
+} stream_stats_p2_t;
+
+// 单通道流式统计
+typedef struct {
+    uint32_t count;                 // 样本总数
+    double mean;                    // 均值
+    double m2;                      // 偏差平方和
+    float min;                      // 累计最小值
+    float max;                      // 累计最大值
+    stream_stats_deque_t win_min;   // 窗口最小值候选
+    stream_stats_deque_t win_max;   // 窗口最大值候选
+    stream_stats_p2_t quantiles[STREAM_STATS_QUANTILE_COUNT];
+} stream_stats_t;
+
+// 统计结果
+typedef struct {
+    uint32_t count;                 // 样本总数
+    float mean;                     // 均值
+    float variance;                 // 样本方差
+    float stddev;                   // 标准差
+    float min;                      // 累计最小值
+    float max;                      // 累计最大值
+    float window_min;               // 窗口最小值
+    float window_max;               // 窗口最大值
+    float quantiles[STREAM_STATS_QUANTILE_COUNT];   // P50/P95/P99
+} stream_stats_summary_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化(复位)统计
+ * @param stats 统计对象
+ */
+void StreamStats_Init(stream_stats_t *stats);
+
+/**
+ * @brief 加入一个样本
+ * @param stats 统计对象
+ * @param value 样本值 (NaN/Inf忽略)
+ */
+void StreamStats_Update(stream_stats_t *stats, float value);
+
+/**
+ * @brief 获取统计结果
+ * @param stats 统计对象
+ * @param summary 输出结果
+ * @return true=有样本, false=无样本(结果清零)
+ */
+bool StreamStats_GetSummary(const stream_stats_t *stats, stream_stats_summary_t *summary);
+
+/**
+ * @brief 获取单个分位数估计
+ * @param stats 统计对象
+ * @param quantile 分位数索引
+ * @return 估计值 (无样本时为0)
+ */
+float StreamStats_GetQuantile(const stream_stats_t *stats, stream_stats_quantile_t quantile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STREAM_STATS_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,183 @@
+/**
+ ******************************************************************************
+ * @file    task_profiler.h
+ * @brief   任务分阶段周期计时头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 基于DWT周期计数器(CYCCNT, 168MHz下分辨率约6ns)的分阶段计时:
+ * - 任务在周期开始调用Profiler_CycleBegin, 每进入一个阶段调用
+ *   Profiler_Phase (同时结束上一阶段), 周期结束调用Profiler_CycleEnd
+ * - 每个标记只读一次计数器, 各阶段和整个周期分别统计
+ *   最小/最大/平均值和对数直方图
+ * - 直方图按微秒取2的幂分档: 第0档<1us, 第k档[2^(k-1), 2^k)us,
+ *   最后一档收纳所有更长的耗时
+ *
+ * 标记开销: 每个阶段的耗时包含一次标记的开销 (读计数器 + Profiler_Record).
+ * 测量方法: 在一个周期内对同一阶段连续调用Profiler_Phase N次, 该阶段的
+ * min_cycles即单个标记的开销 (目标板上在初始化后执行一次, 经Profiler_GetSummary读取).
+ * Test/test_task_profiler按此方法在主机上测得约40ns.
+ *
+ * CYCCNT为32位, 168MHz下约25.5秒回绕, 单次测量不得超过该时长.
+ * 定义PROFILER_HOST_CLOCK时改用主机单调时钟 (1个计数=1ns), 便于在主机上验证.
+ * 统计由所属任务更新, 其他任务通过Profiler_GetSummary读取一致的副本.
+ ******************************************************************************
+ */
+
+#ifndef __TASK_PROFILER_H
+#define __TASK_PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef PROFILER_HOST_CLOCK
+#include <time.h>
+#else
+#include "stm32f4xx.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 配置参数 */
+/* ========================================================================== */
+
+#define PROFILER_MAX_PHASES             6       // 每个任务最多阶段数
+#define PROFILER_HIST_BINS              20      // 直方图档数 (最后一档 >= 2^18 us, 覆盖采样->输出延迟)
+#define PROFILER_PHASE_NONE             0xFF    // 没有打开的阶段
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 单个阶段的统计
+typedef struct {
+    uint32_t count;                             // 测量次数
+    uint32_t min_cycles;                        // 最小耗时 (计数)
+    uint32_t max_cycles;                        // 最大耗时 (计数)
+    uint64_t total_cycles;                      // 累计耗时 (计数)
+    uint32_t hist[PROFILER_HIST_BINS];          // 对数直方图
+} profiler_stats_t;
+
+// 任务计时器
+typedef struct {
+    const char *const *phase_names;             // 阶段名称
+    uint8_t phase_count;                        // 阶段数
+    uint8_t current;                            // 当前打开的阶段
+    uint32_t cycles_per_us;                     // 每微秒计数
+    uint32_t phase_start;                       // 当前阶段开始计数
+    uint32_t cycle_start;                       // 当前周期开始计数
+    profiler_stats_t phases[PROFILER_MAX_PHASES];
+    profiler_stats_t cycle;                     // 整个周期
+} profiler_t;
+
+// 统计结果 (微秒)
+typedef struct {
+    const char *name;                           // 阶段名称 (整个周期为NULL)
+    uint32_t count;                             // 测量次数
+    float min_us;                               // 最小耗时
+    float max_us;                               // 最大耗时
+    float mean_us;                              // 平均耗时
+    uint32_t hist[PROFILER_HIST_BINS];          // 对数直方图
+} profiler_summary_t;
+
+/* ========================================================================== */
+/* 计数器 */
+/* ========================================================================== */
+
+/**
+ * @brief 读取当前计数
+ */
+static inline uint32_t Profiler_Now(void)
+{
+#ifdef PROFILER_HOST_CLOCK
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化计时器 (首次调用时启用DWT周期计数器)
+ * @param profiler 计时器
+ * @param phase_names 阶段名称表 (须为静态存储, 不少于phase_count项)
+ * @param phase_count 阶段数 (不大于PROFILER_MAX_PHASES)
+ */
+void Profiler_Init(profiler_t *profiler, const char *const *phase_names, uint8_t phase_count);
+
+/**
+ * @brief 清除统计
+ * @param profiler 计时器
+ */
+void Profiler_Reset(profiler_t *profiler);
+
+/**
+ * @brief 周期开始
+ * @param profiler 计时器
+ */
+void Profiler_CycleBegin(profiler_t *profiler);
+
+/**
+ * @brief 进入阶段 (结束上一阶段)
+ * @param profiler 计时器
+ * @param phase 阶段号
+ */
+void Profiler_Phase(profiler_t *profiler, uint8_t phase);
+
+/**
+ * @brief 周期结束 (结束当前阶段)
+ * @param profiler 计时器
+ * @return 本周期耗时 (us)
+ */
+uint32_t Profiler_CycleEnd(profiler_t *profiler);
+
+/**
+ * @brief 记录一次耗时 (供非标记方式的测量使用)
+ * @param stats 统计
+ * @param cycles 耗时 (计数)
+ * @param cycles_per_us 每微秒计数
+ */
+void Profiler_Record(profiler_stats_t *stats, uint32_t cycles, uint32_t cycles_per_us);
+
+/**
+ * @brief 耗时对应的直方图档
+ * @param us 耗时 (us)
+ * @return 档号 (0 - PROFILER_HIST_BINS-1)
+ */
+uint8_t Profiler_HistBin(uint32_t us);
+
+/**
+ * @brief 整个周期的最大/平均耗时 (所属任务调用, 不加锁)
+ * @param profiler 计时器
+ * @param max_us 输出最大耗时 (us)
+ * @param mean_us 输出平均耗时 (us)
+ */
+void Profiler_GetCycleTimes(const profiler_t *profiler, uint32_t *max_us, uint32_t *mean_us);
+
+/**
+ * @brief 获取统计结果
+ * @param profiler 计时器
+ * @param phase 阶段号, PROFILER_PHASE_NONE表示整个周期
+ * @param summary 输出结果
+ * @return true=成功, false=阶段号无效
+ */
+bool Profiler_GetSummary(const profiler_t *profiler, uint8_t phase, profiler_summary_t *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TASK_PROFILER_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file    time_proportion.h
+ * @brief   继电器时间比例输出头文件
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 把0-100%的连续需求转换为固定窗口内的导通时间:
+ * - 导通时长 = 需求 × 窗口, 窗口前段导通, 后段关断
+ * - 导通时长不足最小导通时间时本窗口不导通, 剩余关断时间不足最小关断
+ *   时间时整窗导通; 舍入误差累积到下一窗口, 长期平均占空比与需求一致
+ * - 相位偏移错开多路输出的窗口起点, 降低同时合闸的冲击电流
+ * - 需求降为0时, 满足最小导通时间后立即关断, 不等窗口结束
+ * - 复位(急停等)立即关断, 之后仍保证最小关断时间再重新导通
+ ******************************************************************************
+ */
+
+#ifndef __TIME_PROPORTION_H
+#define __TIME_PROPORTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* 数据结构 */
+/* ========================================================================== */
+
+// 时间比例配置
+typedef struct {
+    uint32_t window_ms;                 // 窗口长度 (ms)
+    uint32_t min_on_ms;                 // 最小导通时间 (ms)
+    uint32_t min_off_ms;                // 最小关断时间 (ms)
+} time_proportion_config_t;
+
+// 时间比例输出通道
+typedef struct {
+    time_proportion_config_t config;
+    uint32_t phase_ms;                  // 当前窗口内位置 (ms)
+    uint32_t on_time_ms;                // 本窗口导通时长 (ms)
+    uint32_t state_time_ms;             // 当前输出状态已持续时间 (ms)
+    float demand_ms;                    // 本窗口需求积分 (ms)
+    float delivered_ms;                 // 本窗口实际导通时间 (ms)
+    float carry_ms;                     // 累积的未输出导通时间 (ms, 可为负)
+    bool window_done;                   // 本窗口导通段已结束
+    bool window_start;                  // 本拍开始新窗口
+    bool synced;                        // 已进入完整窗口 (初始化/复位后的残余窗口不计需求)
+    bool output;                        // 当前输出
+    uint32_t switch_count;              // 开关次数
+} time_proportion_t;
+
+/* ========================================================================== */
+/* 公共函数声明 */
+/* ========================================================================== */
+
+/**
+ * @brief 检查配置是否合法
+ * @param config 配置
+ * @return true=合法, false=窗口为0或容纳不下最小导通+最小关断时间
+ */
+bool TimeProportion_CheckConfig(const time_proportion_config_t *config);
+
+/**
+ * @brief 初始化通道 (输出关断)
+ * @param tp 通道
+ * @param config 配置
+ * @param phase_offset_ms 窗口相位偏移 (ms), 首个窗口在 window-offset 后开始
+ * @return true=成功, false=配置不合法
+ */
+bool TimeProportion_Init(time_proportion_t *tp, const time_proportion_config_t *config,
+                         uint32_t phase_offset_ms);
+
+/**
+ * @brief 运行一拍
+ * @param tp 通道
+ * @param demand 需求 (0-100%)
+ * @param elapsed_ms 距上一拍的时间 (ms), 即调用周期
+ * @return 本拍输出 (true=导通)
+ */
+bool TimeProportion_Update(time_proportion_t *tp, float demand, uint32_t elapsed_ms);
+
+/**
+ * @brief 立即关断并清除累积量 (急停/禁用/故障, 不受最小导通时间限制)
+ * @param tp 通道
+ */
+void TimeProportion_Reset(time_proportion_t *tp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIME_PROPORTION_H */
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -12,7 +12,7 @@
  *
  * 主要功能:
  * 1. 控制电磁阀 (24V x2) - 数字输出
- * 2. 控制加热器 (继电器 x3) - 数字输出
+ * 2. 控制加热器 (继电器 x3) - 时间比例数字输出
  * 3. 控制调速泵 (PWM x2) - PWM输出
  * 4. 控制直流泵 (IO x2) - 数字输出
  * 5. 执行安全输出保护和故障检测
@@ -22,6 +22,8 @@
  */
 
 #include "actuator_task_v3.h"
+#include "seqlock.h"
+#include "ethercat_process_image.h"
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -65,9 +67,41 @@ static actuator_config_t g_actuator_configs[ACTUATOR_COUNT] = {0};
 // 统计信息
 static actuator_task_stats_t g_actuator_stats = {0};
 
+// 分阶段计时
+enum {
+    ACTUATOR_PHASE_COMMANDS = 0,        // 命令处理
+    ACTUATOR_PHASE_SAFETY,              // 安全与故障检查
+    ACTUATOR_PHASE_OUTPUTS,             // 输出更新
+    ACTUATOR_PHASE_STATUS,              // 统计与状态消息
+    ACTUATOR_PHASE_COUNT
+};
+
+static const char *const g_actuator_phase_names[ACTUATOR_PHASE_COUNT] = {
+    "commands", "safety", "outputs", "status"
+};
+static profiler_t g_actuator_profiler;
+
 // 故障防抖计数器
 static uint8_t g_fault_debounce[ACTUATOR_COUNT] = {0};
 
+// 加热器时间比例输出
+static time_proportion_t g_heater_tp[3];
+
+// 各执行器待写入硬件的输入样本标记
+static latency_stamp_t g_output_trace[ACTUATOR_COUNT];
+
+// 控制任务发布的设定值向量 (双缓冲顺序锁, 控制任务写, 本任务读)
+static actuator_setpoint_vector_t g_setpoint_snapshots[2];
+static seqlock_t g_setpoint_seqlock;
+
+// 实际输出的泵驱动量 (双缓冲顺序锁, 本任务每周期写, 传感器任务读)
+static float g_pump_snapshots[2][ACTUATOR_PUMP_OUTPUTS];
+static seqlock_t g_pump_seqlock;
+
+// 已应用的设定值向量发布序号和各执行器版本
+static uint32_t g_setpoint_sequence = 0;
+static uint32_t g_setpoint_applied[ACTUATOR_COUNT] = {0};
+
 // 安全检查计数器
 static uint32_t g_safety_check_counter = 0;
 
@@ -77,11 +111,17 @@ static uint32_t g_safety_check_counter = 0;
 
 static void Actuator_InitializeConfigs(void);
 static void Actuator_InitializeHardware(void);
+static void Actuator_RunCycle(void);
 static void Actuator_ProcessCommands(void);
+static void Actuator_ApplySetpoints(void);
+static void Actuator_SetTarget(actuator_type_t actuator_type, float value, const latency_stamp_t *trace);
 static void Actuator_UpdateOutputs(void);
 static void Actuator_UpdateValves(void);
 static void Actuator_UpdateHeaters(void);
+static bool Actuator_InitializeHeaterTiming(uint8_t heater_id, const time_proportion_config_t *timing);
 static void Actuator_UpdatePumps(void);
+static void Actuator_PublishPumpOutputs(void);
+static void Actuator_PublishProcessImage(void);
 static void Actuator_ApplyRamping(actuator_type_t actuator_type);
 static void Actuator_CheckSafety(void);
 static void Actuator_CheckFaults(void);
@@ -89,6 +129,7 @@ static void Actuator_UpdateStatistics(void);
 static void Actuator_SendStatus(void);
 static BaseType_t Actuator_SetDigitalOutput(uint8_t channel, bool state);
 static BaseType_t Actuator_SetPWMOutput(uint8_t channel, float duty_cycle);
+static void Actuator_TraceOutput(actuator_type_t actuator_type);
 static bool Actuator_ReadFaultStatus(actuator_type_t actuator_type);
 
 /* ========================================================================== */
@@ -143,6 +184,21 @@ BaseType_t ActuatorTaskV3_Init(void)
 
     // 初始化统计信息
     memset(&g_actuator_stats, 0, sizeof(actuator_task_stats_t));
+    Profiler_Init(&g_actuator_profiler, g_actuator_phase_names, ACTUATOR_PHASE_COUNT);
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        LatencyTrace_ClearStamp(&g_output_trace[i]);
+    }
+
+    // 初始化设定值向量
+    memset(g_setpoint_snapshots, 0, sizeof(g_setpoint_snapshots));
+    Seqlock_Init(&g_setpoint_seqlock, &g_setpoint_snapshots[0], &g_setpoint_snapshots[1],
+                 sizeof(actuator_setpoint_vector_t));
+    g_setpoint_sequence = 0;
+    memset(g_setpoint_applied, 0, sizeof(g_setpoint_applied));
+
+    // 初始化泵驱动量快照
+    memset(g_pump_snapshots, 0, sizeof(g_pump_snapshots));
+    Seqlock_Init(&g_pump_seqlock, g_pump_snapshots[0], g_pump_snapshots[1], sizeof(g_pump_snapshots[0]));
 
     printf("[ActuatorV3] 执行器任务系统初始化成功\r\n");
     return pdPASS;
@@ -181,7 +237,6 @@ BaseType_t ActuatorTaskV3_Create(void)
 void Task_ActuatorV3(void *pvParameters)
 {
     TickType_t xLastWakeTime;
-    uint32_t cycle_start_time, cycle_end_time;
 
     // 初始化延时基准时间
     xLastWakeTime = xTaskGetTickCount();
@@ -197,56 +252,7 @@ void Task_ActuatorV3(void *pvParameters)
 
     for (;;)
     {
-        // 记录周期开始时间
-        cycle_start_time = HAL_GetTick();
-
-        // 1. 处理命令队列中的命令
-        Actuator_ProcessCommands();
-
-        // 2. 检查安全状态和故障
-        Actuator_CheckSafety();
-        Actuator_CheckFaults();
-
-        // 3. 更新所有执行器输出
-        if (!g_actuator_context.emergency_stop) {
-            Actuator_UpdateOutputs();
-        }
-
-        // 4. 更新统计信息
-        Actuator_UpdateStatistics();
-
-        // 5. 发送状态消息
-        if ((g_actuator_context.cycle_count % 10) == 0) {  // 每100ms发送一次状态
-            Actuator_SendStatus();
-        }
-
-        // 6. 记录周期结束时间和更新统计
-        cycle_end_time = HAL_GetTick();
-        uint32_t cycle_time_us = (cycle_end_time - cycle_start_time) * 1000;
-
-        g_actuator_stats.total_cycles++;
-        if (cycle_time_us > g_actuator_stats.max_cycle_time_us) {
-            g_actuator_stats.max_cycle_time_us = (uint16_t)cycle_time_us;
-        }
-
-        // 计算平均循环时间
-        g_actuator_stats.avg_cycle_time_us = (uint16_t)(
-            (g_actuator_stats.avg_cycle_time_us * (g_actuator_stats.total_cycles - 1) + cycle_time_us) /
-            g_actuator_stats.total_cycles
-        );
-
-        // 7. 定期打印调试信息 (每1000个周期 = 10秒)
-        if ((g_actuator_context.cycle_count % 1000) == 0) {
-            // printf("[ActuatorV3] 周期=%lu, 安全模式=%s, 紧急停止=%s, 执行时间=%luμs\r\n",
-            //        g_actuator_context.cycle_count,
-            //        g_actuator_context.safety_mode ? "是" : "否",
-            //        g_actuator_context.emergency_stop ? "是" : "否",
-            //        cycle_time_us);
-        }
-
-        // 8. 更新周期计数
-        g_actuator_context.cycle_count++;
-        g_actuator_context.last_update_time = HAL_GetTick();
+        Actuator_RunCycle();
 
         // 9. 按照固定周期执行
         vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(ACTUATOR_TASK_PERIOD_MS));
@@ -260,6 +266,19 @@ void Task_ActuatorV3(void *pvParameters)
  * @return pdTRUE=成功, pdFALSE=失败
  */
 BaseType_t ActuatorTaskV3_SetOutput(actuator_type_t actuator_type, float value)
+{
+    return ActuatorTaskV3_SetOutputTraced(actuator_type, value, NULL);
+}
+
+/**
+ * @brief 设置执行器输出值并携带输入样本标记
+ * @param actuator_type 执行器类型
+ * @param value 输出值 (0-100%)
+ * @param trace 输入样本标记 (NULL=不跟踪)
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ActuatorTaskV3_SetOutputTraced(actuator_type_t actuator_type, float value,
+                                          const latency_stamp_t *trace)
 {
     actuator_command_t command;
 
@@ -274,9 +293,30 @@ BaseType_t ActuatorTaskV3_SetOutput(actuator_type_t actuator_type, float value)
     command.timestamp = HAL_GetTick();
     command.urgent = false;
 
+    if (trace != NULL) {
+        command.trace = *trace;
+    } else {
+        LatencyTrace_ClearStamp(&command.trace);
+    }
+
     return ActuatorTaskV3_SendCommand(&command, 10);
 }
 
+/**
+ * @brief 发布设定值向量
+ * @param setpoints 设定值向量
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ActuatorTaskV3_PublishSetpoints(const actuator_setpoint_vector_t *setpoints)
+{
+    if (setpoints == NULL) {
+        return pdFALSE;
+    }
+
+    Seqlock_Publish(&g_setpoint_seqlock, setpoints);
+    return pdTRUE;
+}
+
 /**
  * @brief 使能执行器
  * @param actuator_type 执行器类型
@@ -441,6 +481,30 @@ BaseType_t ActuatorTaskV3_SetHeater(uint8_t heater_id, bool state)
     return ActuatorTaskV3_SetOutput(actuator_type, value);
 }
 
+/**
+ * @brief 设置加热器时间比例参数
+ * @param heater_id 加热器ID (0, 1, or 2)
+ * @param timing 时间比例参数
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ActuatorTaskV3_SetHeaterTiming(uint8_t heater_id, const time_proportion_config_t *timing)
+{
+    actuator_command_t command;
+
+    if (heater_id > 2 || !TimeProportion_CheckConfig(timing)) {
+        return pdFALSE;
+    }
+
+    command.cmd_type = ACTUATOR_CMD_SET_HEATER_TIMING;
+    command.actuator_type = ACTUATOR_HEATER_1 + heater_id;
+    command.value = 0.0f;
+    command.heater_timing = *timing;
+    command.timestamp = HAL_GetTick();
+    command.urgent = false;
+
+    return ActuatorTaskV3_SendCommand(&command, 10);
+}
+
 /**
  * @brief 设置调速泵速度
  * @param pump_id 泵ID (0 or 1)
@@ -549,9 +613,18 @@ void ActuatorTaskV3_GetStatistics(actuator_task_stats_t *stats)
 void ActuatorTaskV3_ResetStatistics(void)
 {
     memset(&g_actuator_stats, 0, sizeof(actuator_task_stats_t));
+    Profiler_Reset(&g_actuator_profiler);
     printf("[ActuatorV3] 统计信息已重置\r\n");
 }
 
+/**
+ * @brief 获取执行器任务分阶段计时器
+ */
+const profiler_t *ActuatorTaskV3_GetProfiler(void)
+{
+    return &g_actuator_profiler;
+}
+
 /* ========================================================================== */
 /* 私有函数实现 */
 /* ========================================================================== */
@@ -575,7 +648,11 @@ static void Actuator_InitializeConfigs(void)
     }
 
     // 初始化加热器配置 (继电器数字输出)
+    const time_proportion_config_t heater_timing = {
+        ACTUATOR_HEATER_WINDOW_MS, ACTUATOR_HEATER_MIN_ON_MS, ACTUATOR_HEATER_MIN_OFF_MS
+    };
     for (uint8_t i = ACTUATOR_HEATER_1; i <= ACTUATOR_HEATER_3; i++) {
+        Actuator_InitializeHeaterTiming(i - ACTUATOR_HEATER_1, &heater_timing);
         g_actuator_configs[i].channel = i;
         g_actuator_configs[i].output_type = OUTPUT_TYPE_DIGITAL;
         g_actuator_configs[i].current_output = 0.0f;
@@ -770,6 +847,62 @@ static void Actuator_InitializeHardware(void)
     printf("  直流泵: PF6, PF7\r\n");
 }
 
+/**
+ * @brief 执行一个执行器周期 (命令->设定值->安全->输出->统计)
+ */
+static void Actuator_RunCycle(void)
+{
+    // 记录周期开始时间
+    Profiler_CycleBegin(&g_actuator_profiler);
+
+    // 1. 处理命令队列中的命令, 再应用控制任务发布的设定值向量
+    Profiler_Phase(&g_actuator_profiler, ACTUATOR_PHASE_COMMANDS);
+    Actuator_ProcessCommands();
+    Actuator_ApplySetpoints();
+
+    // 2. 检查安全状态和故障
+    Profiler_Phase(&g_actuator_profiler, ACTUATOR_PHASE_SAFETY);
+    Actuator_CheckSafety();
+    Actuator_CheckFaults();
+
+    // 3. 更新所有执行器输出
+    Profiler_Phase(&g_actuator_profiler, ACTUATOR_PHASE_OUTPUTS);
+    if (!g_actuator_context.emergency_stop) {
+        Actuator_UpdateOutputs();
+    }
+    Actuator_PublishPumpOutputs();
+    Actuator_PublishProcessImage();
+
+    // 4. 更新统计信息
+    Profiler_Phase(&g_actuator_profiler, ACTUATOR_PHASE_STATUS);
+    Actuator_UpdateStatistics();
+
+    // 5. 发送状态消息
+    if ((g_actuator_context.cycle_count % 10) == 0) {  // 每100ms发送一次状态
+        Actuator_SendStatus();
+    }
+
+    // 6. 记录周期结束时间和更新统计
+    Profiler_CycleEnd(&g_actuator_profiler);
+
+    g_actuator_stats.total_cycles++;
+    Profiler_GetCycleTimes(&g_actuator_profiler, &g_actuator_stats.max_cycle_time_us,
+                           &g_actuator_stats.avg_cycle_time_us);
+
+    // 7. 定期打印调试信息 (每1000个周期 = 10秒)
+    if ((g_actuator_context.cycle_count % 1000) == 0) {
+        // printf("[ActuatorV3] 周期=%lu, 安全模式=%s, 紧急停止=%s, 执行时间=%luμs\r\n",
+        //        g_actuator_context.cycle_count,
+        //        g_actuator_context.safety_mode ? "是" : "否",
+        //        g_actuator_context.emergency_stop ? "是" : "否",
+        //        cycle_time_us);
+    }
+
+    // 8. 更新周期计数
+    g_actuator_context.cycle_count++;
+    g_actuator_context.last_update_time = HAL_GetTick();
+}
+
 /**
  * @brief 处理命令队列中的命令
  */
@@ -789,22 +922,7 @@ static void Actuator_ProcessCommands(void)
         // 处理不同类型的命令
         switch (command.cmd_type) {
             case ACTUATOR_CMD_SET_OUTPUT:
-                // 限制输出值范围
-                if (command.value < g_actuator_configs[command.actuator_type].min_output) {
-                    command.value = g_actuator_configs[command.actuator_type].min_output;
-                }
-                if (command.value > g_actuator_configs[command.actuator_type].max_output) {
-                    command.value = g_actuator_configs[command.actuator_type].max_output;
-                }
-
-                // 设置目标输出值
-                g_actuator_configs[command.actuator_type].target_output = command.value;
-                g_actuator_configs[command.actuator_type].last_update = HAL_GetTick();
-
-                // 更新执行器状态
-                if (g_actuator_context.status[command.actuator_type].state == ACTUATOR_STATE_IDLE) {
-                    g_actuator_context.status[command.actuator_type].state = ACTUATOR_STATE_RUNNING;
-                }
+                Actuator_SetTarget(command.actuator_type, command.value, &command.trace);
                 break;
 
             case ACTUATOR_CMD_ENABLE:
@@ -818,6 +936,7 @@ static void Actuator_ProcessCommands(void)
                 g_actuator_configs[command.actuator_type].target_output = 0.0f;
                 g_actuator_configs[command.actuator_type].current_output = 0.0f;
                 g_actuator_context.status[command.actuator_type].state = ACTUATOR_STATE_DISABLED;
+                LatencyTrace_ClearStamp(&g_output_trace[command.actuator_type]);
                 printf("[ActuatorV3] 执行器 %d 已禁用\r\n", command.actuator_type);
                 break;
 
@@ -838,6 +957,10 @@ static void Actuator_ProcessCommands(void)
                     g_actuator_configs[i].target_output = 0.0f;
                     g_actuator_configs[i].current_output = 0.0f;
                     g_actuator_context.status[i].state = ACTUATOR_STATE_DISABLED;
+                    LatencyTrace_ClearStamp(&g_output_trace[i]);
+                }
+                for (uint8_t i = 0; i < 3; i++) {
+                    TimeProportion_Reset(&g_heater_tp[i]);
                 }
 
                 // 设置事件标志
@@ -860,6 +983,14 @@ static void Actuator_ProcessCommands(void)
                 printf("[ActuatorV3] 系统恢复运行完成\r\n");
                 break;
 
+            case ACTUATOR_CMD_SET_HEATER_TIMING:
+                if (command.actuator_type < ACTUATOR_HEATER_1 || command.actuator_type > ACTUATOR_HEATER_3 ||
+                    !Actuator_InitializeHeaterTiming(command.actuator_type - ACTUATOR_HEATER_1,
+                                                     &command.heater_timing)) {
+                    g_actuator_stats.command_errors++;
+                }
+                break;
+
             default:
                 g_actuator_stats.command_errors++;
                 break;
@@ -867,6 +998,65 @@ static void Actuator_ProcessCommands(void)
     }
 }
 
+/**
+ * @brief 应用控制任务发布的设定值向量 (只应用版本有变化的执行器)
+ */
+static void Actuator_ApplySetpoints(void)
+{
+    actuator_setpoint_vector_t setpoints;
+    uint32_t sequence;
+
+    if (!Seqlock_Read(&g_setpoint_seqlock, 0, &setpoints, sizeof(setpoints), &sequence)) {
+        // 尚未发布, 或读取期间被连续覆盖 (下个节拍重读)
+        if (Seqlock_GetSequence(&g_setpoint_seqlock) != 0) {
+            g_actuator_stats.setpoint_read_retries++;
+        }
+        return;
+    }
+
+    if (sequence == g_setpoint_sequence) {
+        return;
+    }
+    g_setpoint_sequence = sequence;
+
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        if (setpoints.revision[i] == g_setpoint_applied[i]) {
+            continue;
+        }
+
+        g_setpoint_applied[i] = setpoints.revision[i];
+        Actuator_SetTarget((actuator_type_t)i, setpoints.value[i], &setpoints.trace[i]);
+        g_actuator_stats.setpoint_updates++;
+    }
+}
+
+/**
+ * @brief 设置执行器目标输出值
+ * @param actuator_type 执行器类型
+ * @param value 输出值 (按配置限幅)
+ * @param trace 输入样本标记
+ */
+static void Actuator_SetTarget(actuator_type_t actuator_type, float value, const latency_stamp_t *trace)
+{
+    // 限制输出值范围
+    if (value < g_actuator_configs[actuator_type].min_output) {
+        value = g_actuator_configs[actuator_type].min_output;
+    }
+    if (value > g_actuator_configs[actuator_type].max_output) {
+        value = g_actuator_configs[actuator_type].max_output;
+    }
+
+    // 设置目标输出值
+    g_actuator_configs[actuator_type].target_output = value;
+    g_actuator_configs[actuator_type].last_update = HAL_GetTick();
+    g_output_trace[actuator_type] = *trace;
+
+    // 更新执行器状态
+    if (g_actuator_context.status[actuator_type].state == ACTUATOR_STATE_IDLE) {
+        g_actuator_context.status[actuator_type].state = ACTUATOR_STATE_RUNNING;
+    }
+}
+
 /**
  * @brief 更新所有执行器输出
  */
@@ -902,6 +1092,7 @@ static void Actuator_UpdateValves(void)
         if (Actuator_SetDigitalOutput(g_actuator_configs[i].channel, valve_state) == pdTRUE) {
             // 更新状态
             g_actuator_context.valve_states[i - ACTUATOR_VALVE_1] = valve_state;
+            Actuator_TraceOutput((actuator_type_t)i);
             g_actuator_context.status[i].output_value = valve_state ? 100.0f : 0.0f;
             g_actuator_context.status[i].timestamp = HAL_GetTick();
 
@@ -921,17 +1112,22 @@ static void Actuator_UpdateValves(void)
 static void Actuator_UpdateHeaters(void)
 {
     for (uint8_t i = ACTUATOR_HEATER_1; i <= ACTUATOR_HEATER_3; i++) {
+        time_proportion_t *tp = &g_heater_tp[i - ACTUATOR_HEATER_1];
+
         if (!g_actuator_configs[i].enabled || g_actuator_context.status[i].fault) {
+            TimeProportion_Reset(tp);
             continue;
         }
 
-        // 数字输出: >50% 为开，<=50% 为关
-        bool heater_state = (g_actuator_configs[i].current_output > 50.0f);
+        // 时间比例输出: 0-100%需求转换为窗口内导通时间
+        bool heater_state = TimeProportion_Update(tp, g_actuator_configs[i].current_output,
+                                                  ACTUATOR_TASK_PERIOD_MS);
 
         // 调用HAL层接口输出
         if (Actuator_SetDigitalOutput(g_actuator_configs[i].channel, heater_state) == pdTRUE) {
             // 更新状态
             g_actuator_context.heater_states[i - ACTUATOR_HEATER_1] = heater_state;
+            Actuator_TraceOutput((actuator_type_t)i);
             g_actuator_context.status[i].output_value = heater_state ? 100.0f : 0.0f;
             g_actuator_context.status[i].timestamp = HAL_GetTick();
 
@@ -950,6 +1146,21 @@ static void Actuator_UpdateHeaters(void)
     }
 }
 
+/**
+ * @brief 设置加热器时间比例参数 (窗口起点按加热器序号错开1/3窗口)
+ * @param heater_id 加热器ID (0, 1, or 2)
+ * @param timing 时间比例参数
+ * @return true=成功, false=参数不合法
+ */
+static bool Actuator_InitializeHeaterTiming(uint8_t heater_id, const time_proportion_config_t *timing)
+{
+    if (!TimeProportion_CheckConfig(timing)) {
+        return false;
+    }
+
+    return TimeProportion_Init(&g_heater_tp[heater_id], timing, heater_id * timing->window_ms / 3);
+}
+
 /**
  * @brief 更新泵输出
  */
@@ -968,6 +1179,7 @@ static void Actuator_UpdatePumps(void)
         if (Actuator_SetPWMOutput(g_actuator_configs[i].channel, duty_cycle) == pdTRUE) {
             // 更新状态
             g_actuator_context.pump_speed[i - ACTUATOR_PUMP_SPEED_1] = duty_cycle;
+            Actuator_TraceOutput((actuator_type_t)i);
             g_actuator_context.status[i].output_value = duty_cycle;
             g_actuator_context.status[i].timestamp = HAL_GetTick();
 
@@ -991,6 +1203,7 @@ static void Actuator_UpdatePumps(void)
         if (Actuator_SetDigitalOutput(g_actuator_configs[i].channel, pump_state) == pdTRUE) {
             // 更新状态
             g_actuator_context.pump_dc_states[i - ACTUATOR_PUMP_DC_1] = pump_state;
+            Actuator_TraceOutput((actuator_type_t)i);
             g_actuator_context.status[i].output_value = pump_state ? 100.0f : 0.0f;
             g_actuator_context.status[i].timestamp = HAL_GetTick();
 
@@ -1009,6 +1222,61 @@ static void Actuator_UpdatePumps(void)
     }
 }
 
+/**
+ * @brief 发布本周期的泵驱动量 (紧急停止时为0)
+ */
+static void Actuator_PublishPumpOutputs(void)
+{
+    float outputs[ACTUATOR_PUMP_OUTPUTS];
+
+    for (uint8_t i = 0; i < ACTUATOR_PUMP_OUTPUTS; i++) {
+        outputs[i] = g_actuator_context.emergency_stop ? 0.0f :
+                     g_actuator_context.status[ACTUATOR_PUMP_SPEED_1 + i].output_value;
+    }
+
+    Seqlock_Publish(&g_pump_seqlock, outputs);
+}
+
+/**
+ * @brief 刷新TxPDO中由执行器提供的应用数据 (0x6000.2, 0x6001.2, 0x6005, 0x6007.5-10)
+ * @note  输出状态/故障字的位号即actuator_type_t; 故障字位13=安全模式, 位14=紧急停止
+ */
+static void Actuator_PublishProcessImage(void)
+{
+    const actuator_status_t *status = g_actuator_context.status;
+    bool stopped = g_actuator_context.emergency_stop;
+    uint16_t output_bits = 0;
+    uint16_t fault_bits = 0;
+
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        if (!stopped && status[i].output_value > 0.0f) {
+            output_bits |= (uint16_t)(1u << i);
+        }
+        if (status[i].fault) {
+            fault_bits |= (uint16_t)(1u << i);
+        }
+    }
+    if (g_actuator_context.safety_mode) {
+        fault_bits |= (uint16_t)(1u << 13);
+    }
+    if (stopped) {
+        fault_bits |= (uint16_t)(1u << 14);
+    }
+
+    ProcessImage_SetApplValue(PI_APPL_OUTPUT_STATUS, (float)output_bits);
+    ProcessImage_SetApplValue(PI_APPL_ALARM_2, (float)fault_bits);
+
+    // 供墨泵=调速泵1, 回墨泵=调速泵2, 填墨泵=直流泵1, 补墨泵=直流泵2, 收墨阀=电磁阀1, 墨桶回墨阀=电磁阀2
+    ProcessImage_SetApplValue(PI_APPL_SUPPLY_PUMP_PERCENT, stopped ? 0.0f : status[ACTUATOR_PUMP_SPEED_1].output_value);
+    ProcessImage_SetApplValue(PI_APPL_RETURN_PUMP_PERCENT, stopped ? 0.0f : status[ACTUATOR_PUMP_SPEED_2].output_value);
+    ProcessImage_SetApplValue(PI_APPL_SUPPLY_PUMP_ANIM, (output_bits >> ACTUATOR_PUMP_SPEED_1) & 1u);
+    ProcessImage_SetApplValue(PI_APPL_RETURN_PUMP_ANIM, (output_bits >> ACTUATOR_PUMP_SPEED_2) & 1u);
+    ProcessImage_SetApplValue(PI_APPL_FILL_PUMP_ANIM, (output_bits >> ACTUATOR_PUMP_DC_1) & 1u);
+    ProcessImage_SetApplValue(PI_APPL_REFILL_PUMP_ANIM, (output_bits >> ACTUATOR_PUMP_DC_2) & 1u);
+    ProcessImage_SetApplValue(PI_APPL_COLLECT_VALVE_ANIM, (output_bits >> ACTUATOR_VALVE_1) & 1u);
+    ProcessImage_SetApplValue(PI_APPL_DRUM_RETURN_VALVE_ANIM, (output_bits >> ACTUATOR_VALVE_2) & 1u);
+}
+
 /**
  * @brief 应用爬坡控制
  * @param actuator_type 执行器类型
@@ -1258,7 +1526,7 @@ static BaseType_t Actuator_SetDigitalOutput(uint8_t channel, bool state)
  */
 static BaseType_t Actuator_SetPWMOutput(uint8_t channel, float duty_cycle)
 {
-    TIM_HandleTypeDef* htim = NULL;
+    TIM_HandleTypeDef htim = {0};
     uint32_t tim_channel = 0;
 
     // 限制占空比范围
@@ -1268,11 +1536,11 @@ static BaseType_t Actuator_SetPWMOutput(uint8_t channel, float duty_cycle)
     // 根据通道号选择对应的定时器和通道
     switch (channel) {
         case ACTUATOR_PUMP_SPEED_1:
-            htim = &(TIM_HandleTypeDef){.Instance = TIM14};
+            htim.Instance = TIM14;
             tim_channel = TIM_CHANNEL_1;
             break;
         case ACTUATOR_PUMP_SPEED_2:
-            htim = &(TIM_HandleTypeDef){.Instance = TIM1};
+            htim.Instance = TIM1;
             tim_channel = TIM_CHANNEL_3;
             break;
         default:
@@ -1281,15 +1549,29 @@ static BaseType_t Actuator_SetPWMOutput(uint8_t channel, float duty_cycle)
     }
 
     // 计算PWM比较值
-    uint32_t period = __HAL_TIM_GET_AUTORELOAD(htim);
+    uint32_t period = __HAL_TIM_GET_AUTORELOAD(&htim);
     uint32_t pulse = (uint32_t)((duty_cycle / 100.0f) * period);
 
     // 设置PWM占空比
-    __HAL_TIM_SET_COMPARE(htim, tim_channel, pulse);
+    __HAL_TIM_SET_COMPARE(&htim, tim_channel, pulse);
 
     return pdTRUE;
 }
 
+/**
+ * @brief 输出已写入硬件: 记录携带样本的采样->输出延迟 (每个样本只记录一次)
+ * @param actuator_type 执行器类型
+ */
+static void Actuator_TraceOutput(actuator_type_t actuator_type)
+{
+    latency_stamp_t *trace = &g_output_trace[actuator_type];
+
+    if (trace->loop != LATENCY_TRACE_NO_LOOP) {
+        LatencyTrace_Record(trace, LATENCY_STAGE_OUTPUT);
+        LatencyTrace_ClearStamp(trace);
+    }
+}
+
 /**
  * @brief 读取故障状态
  * @param actuator_type 执行器类型
@@ -1461,6 +1743,20 @@ BaseType_t ActuatorTaskV3_GetPumpSpeeds(float *pump_speeds)
     return pdFALSE;
 }
 
+/**
+ * @brief 读取最近一个周期实际输出的泵驱动量
+ * @param outputs 输出数组 (至少ACTUATOR_PUMP_OUTPUTS个)
+ * @return pdTRUE=成功, pdFALSE=尚未发布或读取冲突
+ */
+BaseType_t ActuatorTaskV3_ReadPumpOutputs(float *outputs)
+{
+    if (outputs == NULL) {
+        return pdFALSE;
+    }
+
+    return Seqlock_Read(&g_pump_seqlock, 0, outputs, sizeof(g_pump_snapshots[0]), NULL) ? pdTRUE : pdFALSE;
+}
+
 /**
  * @brief 获取所有直流泵状态
  * @param dc_pump_states 直流泵状态数组指针 (至少2个元素)
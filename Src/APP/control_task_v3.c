@@ -21,6 +21,13 @@
  */
 
 #include "control_task_v3.h"
+#include "pid_batch.h"
+#include "pid_autotune.h"
+#include "latency_trace.h"
+#include "loop_kpi.h"
+#include "fopdt_model.h"
+#include "ethercat_process_image.h"
+#include "ethercat_output_monitor.h"
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -33,8 +40,6 @@
 #define PID_DERIVATIVE_FILTER_MIN   0.1f    // 微分滤波最小值
 #define SETPOINT_FILTER_COEFF       0.95f   // 设定值滤波系数
 #define PROCESS_VALUE_TIMEOUT_MS    200     // 过程值超时时间
-#define CONTROL_QUALITY_SAMPLES     20      // 质量计算样本数
-#define STABILITY_CHECK_CYCLES      50      // 稳定性检查周期
 
 /* ========================================================================== */
 /* 全局变量定义 */
@@ -45,7 +50,6 @@ TaskHandle_t xTaskHandle_ControlV3 = NULL;
 
 // 队列句柄
 QueueHandle_t xQueue_ControlCmd = NULL;
-QueueHandle_t xQueue_ControlMsg = NULL;
 
 // 互斥体
 SemaphoreHandle_t xMutex_ControlContext = NULL;
@@ -63,20 +67,73 @@ static control_context_t g_control_context = {0};
 // 控制任务统计信息
 static control_task_stats_t g_control_stats = {0};
 
-// 控制质量历史缓冲区 (用于计算平均值)
-static float g_quality_history[CONTROL_LOOP_COUNT][CONTROL_QUALITY_SAMPLES] = {0};
-static uint8_t g_quality_index[CONTROL_LOOP_COUNT] = {0};
-
-// 稳定性检测缓冲区
-static float g_stability_buffer[CONTROL_LOOP_COUNT][STABILITY_CHECK_CYCLES] = {0};
-static uint8_t g_stability_index[CONTROL_LOOP_COUNT] = {0};
+// 分阶段计时
+enum {
+    CONTROL_PHASE_COMMANDS = 0,         // 命令处理
+    CONTROL_PHASE_SENSORS,              // 传感器数据更新
+    CONTROL_PHASE_PID,                  // 控制算法
+    CONTROL_PHASE_OUTPUTS,              // 执行器输出
+    CONTROL_PHASE_SUPERVISE,            // 报警/质量/稳定性/状态消息
+    CONTROL_PHASE_COUNT
+};
+
+static const char *const g_control_phase_names[CONTROL_PHASE_COUNT] = {
+    "commands", "sensors", "pid", "outputs", "supervise"
+};
+static profiler_t g_control_profiler;
+
+// 回路性能指标 (滑动窗口, 每次PID计算后更新), 结果在监视周期刷新
+static loop_kpi_t g_loop_kpi[CONTROL_LOOP_COUNT];
+static loop_kpi_summary_t g_loop_kpi_summary[CONTROL_LOOP_COUNT];
+
+// 批量PID (参数/状态按数组存放, pid_state在每周期计算后同步)
+static pid_batch_t g_pid_batch;
+
+// 继电自整定 (位图中的回路由自整定器接管输出)
+static pid_autotune_t g_autotune[CONTROL_LOOP_COUNT];
+static uint32_t g_autotune_mask = 0;
+static pid_autotune_result_t g_autotune_result[CONTROL_LOOP_COUNT];
+static uint32_t g_autotune_valid_mask = 0;
+static control_state_t g_autotune_prev_state[CONTROL_LOOP_COUNT];  // 整定前的回路状态
+static bool g_autotune_prev_enabled[CONTROL_LOOP_COUNT];           // 整定前的回路使能
+
+// 串级外环分频计数
+static uint8_t g_cascade_countdown[CONTROL_LOOP_COUNT] = {0};
+
+// 前馈超前滞后环节状态
+static float g_ff_last_input[CONTROL_LOOP_COUNT] = {0};
+static float g_ff_state[CONTROL_LOOP_COUNT] = {0};
+static uint32_t g_ff_primed_mask = 0;
+
+// 纯滞后补偿过程模型 (接入及中断后按当前输出稳态预置)
+static fopdt_model_t g_smith_model[CONTROL_LOOP_COUNT];
+static uint32_t g_smith_primed_mask = 0;
+
+#if CONTROL_DATA_DRIVEN
+// 数据驱动调度: 各回路已处理的输入序号, 上次计算所用样本的时间戳
+static uint32_t g_input_sequence[CONTROL_LOOP_COUNT] = {0};
+static uint32_t g_input_timestamp[CONTROL_LOOP_COUNT] = {0};
+static uint32_t g_input_primed_mask = 0;        // 上次计算后未中断, 时间戳间隔有效
+static TickType_t g_last_supervision_tick = 0;
+#endif
+
+// 本次唤醒重新计算过输出的回路 (数据驱动时只下发这些回路)
+static uint32_t g_output_mask = 0;
+
+// 各回路本次计算所用输入样本的标记 (随输出下发到执行器)
+static latency_stamp_t g_loop_trace[CONTROL_LOOP_COUNT];
+
+// 下发给执行器任务的设定值向量 (每周期整体发布一次)
+static actuator_setpoint_vector_t g_actuator_setpoints;
 
 /* ========================================================================== */
 /* 私有函数声明 */
 /* ========================================================================== */
 
 static void Control_InitializeLoops(void);
+static void Control_RunCycle(void);
 static void Control_ProcessCommands(void);
+static void Control_ProcessMasterOutputs(void);
 static void Control_UpdateSensorData(void);
 static void Control_ExecuteControlLoops(void);
 static void Control_UpdateActuators(void);
@@ -84,13 +141,36 @@ static void Control_CheckAlarms(void);
 static void Control_UpdateQuality(void);
 static void Control_CheckStability(void);
 static void Control_SendStatusMessage(void);
+static void Control_PublishProcessImage(void);
 
 // PID控制器相关函数
-static float PID_Calculate(control_loop_t loop_id, float setpoint, float process_value);
 static void PID_Reset(control_loop_t loop_id);
 static void PID_SetParams(control_loop_t loop_id, const pid_params_t *params);
 static float PID_AntiWindup(control_loop_t loop_id, float output);
 
+// 自整定
+static BaseType_t Control_StartAutoTune(control_loop_t loop_id);
+static void Control_StopAutoTune(control_loop_t loop_id);
+static void Control_FinishAutoTune(control_loop_t loop_id);
+static void Control_PresetIntegral(control_loop_t loop_id, float output);
+
+// 串级与前馈
+static bool Control_IsCascadeOuter(const control_loop_config_t *loop);
+static BaseType_t Control_ConfigureCascade(control_loop_t outer_loop, const control_cascade_config_t *config);
+static void Control_ApplyCascadeSetpoint(const control_loop_config_t *outer, float output);
+static float Control_UpdateFeedforward(control_loop_t loop_id);
+
+// 纯滞后补偿
+static BaseType_t Control_ConfigureSmith(control_loop_t loop_id, const control_smith_config_t *config);
+static float Control_UpdateSmithCorrection(control_loop_t loop_id);
+
+// 调度
+static bool Control_TakeFreshInput(control_loop_t loop_id);
+static void Control_SetElapsed(control_loop_t loop_id);
+static void Control_RestartElapsed(control_loop_t loop_id);
+static float Control_GetInputPeriod(control_loop_t loop_id);
+static bool Control_SupervisionDue(void);
+
 // 传感器数据映射函数
 static float Control_GetSensorValue(control_loop_t loop_id);
 static bool Control_IsSensorValid(control_loop_t loop_id);
@@ -126,10 +206,9 @@ BaseType_t ControlTaskV3_Init(void)
         return pdFAIL;
     }
 
-    // 创建消息队列
-    xQueue_ControlMsg = xQueueCreate(CONTROL_MSG_QUEUE_SIZE, sizeof(control_msg_t));
-    if (xQueue_ControlMsg == NULL) {
-        printf("[ControlV3] ERROR: 创建消息队列失败\r\n");
+    // 创建消息总线主题
+    if (MsgBus_CreateTopic(MSG_BUS_TOPIC_CONTROL_STATUS, sizeof(control_msg_t), CONTROL_MSG_POOL_BLOCKS) != pdPASS) {
+        printf("[ControlV3] ERROR: 创建消息主题失败\r\n");
         return pdFAIL;
     }
 
@@ -140,9 +219,6 @@ BaseType_t ControlTaskV3_Init(void)
         return pdFAIL;
     }
 
-    // 初始化控制回路
-    Control_InitializeLoops();
-
     // 初始化上下文
     memset(&g_control_context, 0, sizeof(control_context_t));
     g_control_context.system_mode = CONTROL_MODE_MANUAL;
@@ -151,8 +227,27 @@ BaseType_t ControlTaskV3_Init(void)
     g_control_context.emergency_stop = false;
     g_control_context.safety_mode = false;
 
+    // 初始化控制回路 (须在上下文清零之后)
+    Control_InitializeLoops();
+
     // 初始化统计信息
     memset(&g_control_stats, 0, sizeof(control_task_stats_t));
+    Profiler_Init(&g_control_profiler, g_control_phase_names, CONTROL_PHASE_COUNT);
+
+    // 初始化延迟跟踪 (DWT计数器已由Profiler_Init启用)
+    LatencyTrace_Init();
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        LatencyTrace_ClearStamp(&g_loop_trace[i]);
+    }
+
+    // 初始化回路性能指标 (阶跃/过零阈值按设定值范围)
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        control_loop_config_t *loop = &g_control_context.loops[i];
+
+        LoopKpi_Init(&g_loop_kpi[i], loop->setpoint_max - loop->setpoint_min,
+                     (i <= CONTROL_LOOP_TEMP_3) ? CONTROL_KPI_TEMP_WINDOW_S : CONTROL_KPI_WINDOW_S);
+    }
+    memset(g_loop_kpi_summary, 0, sizeof(g_loop_kpi_summary));
 
     printf("[ControlV3] 控制任务系统初始化成功\r\n");
     return pdPASS;
@@ -191,7 +286,6 @@ BaseType_t ControlTaskV3_Create(void)
 void Task_ControlV3(void *pvParameters)
 {
     TickType_t xLastWakeTime;
-    uint32_t cycle_start_time, cycle_end_time;
 
     // 初始化延时基准时间
     xLastWakeTime = xTaskGetTickCount();
@@ -206,73 +300,27 @@ void Task_ControlV3(void *pvParameters)
     g_control_context.system_enabled = true;
     g_control_context.system_state = CONTROL_STATE_RUNNING;
 
-    for (;;)
-    {
-        // 记录周期开始时间
-        cycle_start_time = HAL_GetTick();
-
-        // 1. 处理命令队列中的命令
-        Control_ProcessCommands();
-
-        // 2. 更新传感器数据
-        Control_UpdateSensorData();
-
-        // 3. 执行控制算法 (如果系统未紧急停止)
-        if (!g_control_context.emergency_stop) {
-            Control_ExecuteControlLoops();
-        }
-
-        // 4. 更新执行器输出
-        Control_UpdateActuators();
-
-        // 5. 检查报警和安全状态
-        Control_CheckAlarms();
-
-        // 6. 更新控制质量评估
-        Control_UpdateQuality();
-
-        // 7. 检查系统稳定性
-        Control_CheckStability();
-
-        // 8. 发送状态消息 (每5个周期发送一次)
-        if ((g_control_context.cycle_count % 5) == 0) {
-            Control_SendStatusMessage();
-        }
-
-        // 9. 更新统计信息
-        cycle_end_time = HAL_GetTick();
-        uint32_t cycle_time_us = (cycle_end_time - cycle_start_time) * 1000;
-
-        g_control_stats.total_cycles++;
-        if (cycle_time_us > g_control_stats.max_cycle_time_us) {
-            g_control_stats.max_cycle_time_us = (uint16_t)cycle_time_us;
-        }
-
-        // 计算平均周期时间
-        g_control_stats.avg_cycle_time_us = (uint16_t)(
-            (g_control_stats.avg_cycle_time_us * (g_control_stats.total_cycles - 1) + cycle_time_us) /
-            g_control_stats.total_cycles
-        );
-
-        // 更新上下文中的周期时间统计
-        g_control_context.max_cycle_time_us = g_control_stats.max_cycle_time_us;
-        g_control_context.avg_cycle_time_us = g_control_stats.avg_cycle_time_us;
+#if CONTROL_DATA_DRIVEN
+    // 由传感器任务在发布新样本后唤醒
+    SensorTaskV3_SetPublishNotify(xTaskGetCurrentTaskHandle());
+#endif
 
-        // 10. 定期打印调试信息 (每100个周期 = 2秒)
-        if ((g_control_context.cycle_count % 100) == 0) {
-            printf("[ControlV3] 周期=%lu, 质量=%d%%, 稳定性=%.2f, 执行时间=%luμs\r\n",
-                   g_control_context.cycle_count,
-                   g_control_context.overall_quality,
-                   g_control_context.system_stability,
-                   cycle_time_us);
-        }
+    // 主站系统命令变化时由输出监控置位通知 (OUTPUT_MONITOR_NOTIFY_INDEX)
+    EtherCAT_OutputMonitor_Subscribe(xTaskGetCurrentTaskHandle(),
+                                     OUTPUT_FIELD_BIT(OUTPUT_FIELD_SYSTEM_CMD));
 
-        // 11. 更新周期计数和时间戳
-        g_control_context.cycle_count++;
-        g_control_context.last_update_time = HAL_GetTick();
+    for (;;)
+    {
+        Control_RunCycle();
 
+#if CONTROL_DATA_DRIVEN
+        // 12. 等待新样本 (超时保证传感器停发时命令处理和监视照常进行)
+        (void)xLastWakeTime;
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONTROL_TASK_PERIOD_MS));
+#else
         // 12. 按照固定周期执行
         vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(CONTROL_TASK_PERIOD_MS));
+#endif
     }
 }
 
@@ -639,9 +687,105 @@ static void Control_InitializeLoops(void)
     flow_loop->pid_state.first_run = true;
     flow_loop->pid_state.last_update_time = HAL_GetTick();
 
+    // 串级/前馈/纯滞后补偿默认未配置
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        control_loop_config_t *loop = &g_control_context.loops[i];
+
+        loop->cascade.inner_loop = CONTROL_LOOP_COUNT;
+        loop->cascade.rate_ratio = 1;
+        loop->feedforward.sensor = SENSOR_COUNT;
+        loop->feedforward.gain = 0.0f;
+        loop->smith.gain = 0.0f;
+    }
+
+    // 载入批量PID参数
+    PidBatch_Init(&g_pid_batch);
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        PidBatch_SetParams(&g_pid_batch, i, &g_control_context.loops[i].pid_params);
+    }
+
     printf("[ControlV3] 控制回路配置初始化完成\r\n");
 }
 
+/**
+ * @brief 执行一个控制周期 (命令->采样->计算->输出->监视->统计)
+ */
+static void Control_RunCycle(void)
+{
+    uint32_t cycle_time_us;
+    bool supervise;
+
+    // 记录周期开始时间
+    Profiler_CycleBegin(&g_control_profiler);
+
+    // 1. 处理命令队列中的命令
+    Profiler_Phase(&g_control_profiler, CONTROL_PHASE_COMMANDS);
+    Control_ProcessMasterOutputs();
+    Control_ProcessCommands();
+
+    // 2. 更新传感器数据
+    Profiler_Phase(&g_control_profiler, CONTROL_PHASE_SENSORS);
+    Control_UpdateSensorData();
+
+    // 3. 执行控制算法 (如果系统未紧急停止)
+    Profiler_Phase(&g_control_profiler, CONTROL_PHASE_PID);
+    if (!g_control_context.emergency_stop) {
+        Control_ExecuteControlLoops();
+    }
+
+    // 4. 更新执行器输出
+    Profiler_Phase(&g_control_profiler, CONTROL_PHASE_OUTPUTS);
+    Control_UpdateActuators();
+
+    // 5-8. 监视 (数据驱动时仍按CONTROL_TASK_PERIOD_MS执行)
+    Profiler_Phase(&g_control_profiler, CONTROL_PHASE_SUPERVISE);
+    supervise = Control_SupervisionDue();
+    if (supervise) {
+        // 5. 检查报警和安全状态
+        Control_CheckAlarms();
+
+        // 6. 更新控制质量评估
+        Control_UpdateQuality();
+
+        // 7. 检查系统稳定性
+        Control_CheckStability();
+
+        // 8. 发送状态消息 (每5个周期发送一次)
+        if ((g_control_context.cycle_count % 5) == 0) {
+            Control_SendStatusMessage();
+        }
+
+        // 8a. 刷新TxPDO中的报警/状态/压力目标值
+        Control_PublishProcessImage();
+    }
+
+    // 9. 更新统计信息
+    cycle_time_us = Profiler_CycleEnd(&g_control_profiler);
+
+    g_control_stats.total_cycles++;
+    Profiler_GetCycleTimes(&g_control_profiler, &g_control_stats.max_cycle_time_us,
+                           &g_control_stats.avg_cycle_time_us);
+
+    // 更新上下文中的周期时间统计
+    g_control_context.max_cycle_time_us = g_control_stats.max_cycle_time_us;
+    g_control_context.avg_cycle_time_us = g_control_stats.avg_cycle_time_us;
+
+    if (supervise) {
+        // 10. 定期打印调试信息 (每100个周期 = 2秒)
+        if ((g_control_context.cycle_count % 100) == 0) {
+            printf("[ControlV3] 周期=%lu, 质量=%d%%, 稳定性=%.2f, 执行时间=%luμs\r\n",
+                   g_control_context.cycle_count,
+                   g_control_context.overall_quality,
+                   g_control_context.system_stability,
+                   cycle_time_us);
+        }
+
+        // 11. 更新周期计数和时间戳
+        g_control_context.cycle_count++;
+        g_control_context.last_update_time = HAL_GetTick();
+    }
+}
+
 /**
  * @brief 处理命令队列中的命令
  */
@@ -675,7 +819,13 @@ static void Control_ProcessCommands(void)
 
             case CONTROL_CMD_SET_MODE:
                 loop->mode = command.mode;
-                loop->auto_mode = (command.mode == CONTROL_MODE_AUTO);
+                loop->auto_mode = (command.mode == CONTROL_MODE_AUTO ||
+                                   command.mode == CONTROL_MODE_CASCADE ||
+                                   command.mode == CONTROL_MODE_FEEDFORWARD ||
+                                   command.mode == CONTROL_MODE_SMITH);
+                g_ff_primed_mask &= ~(1UL << command.loop_id);
+                g_smith_primed_mask &= ~(1UL << command.loop_id);
+                g_cascade_countdown[command.loop_id] = 0;
                 g_control_stats.mode_switches++;
                 xEventGroupSetBits(xEventGroup_Control, EVENT_CONTROL_MODE_SWITCH);
                 break;
@@ -692,7 +842,18 @@ static void Control_ProcessCommands(void)
                 loop->output_value = 0.0f;
                 break;
 
+            case CONTROL_CMD_TUNE_PID:
+                if (command.value != 0.0f) {
+                    if (Control_StartAutoTune(command.loop_id) != pdTRUE) {
+                        g_control_stats.command_errors++;
+                    }
+                } else {
+                    Control_StopAutoTune(command.loop_id);
+                }
+                break;
+
             case CONTROL_CMD_RESET_LOOP:
+                Control_StopAutoTune(command.loop_id);
                 PID_Reset(command.loop_id);
                 loop->state = CONTROL_STATE_IDLE;
                 break;
@@ -701,6 +862,7 @@ static void Control_ProcessCommands(void)
                 g_control_context.emergency_stop = true;
                 g_control_context.safety_mode = true;
                 for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+                    Control_StopAutoTune((control_loop_t)i);
                     g_control_context.loops[i].enabled = false;
                     g_control_context.loops[i].state = CONTROL_STATE_SAFETY;
                     g_control_context.loops[i].output_value = 0.0f;
@@ -718,6 +880,29 @@ static void Control_ProcessCommands(void)
                 PID_SetParams(command.loop_id, &command.pid_params);
                 break;
 
+            case CONTROL_CMD_SET_CASCADE:
+                if (Control_ConfigureCascade(command.loop_id, &command.cascade) != pdTRUE) {
+                    g_control_stats.command_errors++;
+                }
+                break;
+
+            case CONTROL_CMD_SET_FEEDFORWARD:
+                if (command.feedforward.sensor >= SENSOR_COUNT ||
+                    command.feedforward.lead_time < 0.0f || command.feedforward.lag_time < 0.0f) {
+                    g_control_stats.command_errors++;
+                    break;
+                }
+                loop->feedforward = command.feedforward;
+                loop->feedforward_output = 0.0f;
+                g_ff_primed_mask &= ~(1UL << command.loop_id);
+                break;
+
+            case CONTROL_CMD_SET_SMITH:
+                if (Control_ConfigureSmith(command.loop_id, &command.smith) != pdTRUE) {
+                    g_control_stats.command_errors++;
+                }
+                break;
+
             default:
                 g_control_stats.command_errors++;
                 break;
@@ -752,11 +937,18 @@ static void Control_UpdateSensorData(void)
  */
 static void Control_ExecuteControlLoops(void)
 {
+    uint32_t active_mask = 0;
+    uint32_t outer_mask = 0;
+    uint32_t now = HAL_GetTick();
+
+    // 1. 采集过程值和设定值
     for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
         control_loop_config_t *loop = &g_control_context.loops[i];
 
-        // 跳过未使能或非自动模式的回路
+        // 跳过未使能或非自动模式的回路 (自整定随之中止)
         if (!loop->enabled || !loop->auto_mode) {
+            Control_StopAutoTune((control_loop_t)i);
+            Control_RestartElapsed((control_loop_t)i);
             continue;
         }
 
@@ -766,18 +958,121 @@ static void Control_ExecuteControlLoops(void)
 
         // 检查传感器数据有效性
         if (!Control_IsSensorValid((control_loop_t)i)) {
+            Control_StopAutoTune((control_loop_t)i);
+            Control_RestartElapsed((control_loop_t)i);
             loop->state = CONTROL_STATE_ERROR;
             continue;
         }
 
-        // 执行PID控制
-        float output = PID_Calculate((control_loop_t)i, loop->setpoint, process_value);
-        loop->output_value = output;
+        // 数据驱动: 输入通道没有新样本时不计算, 输出保持
+        if (!Control_TakeFreshInput((control_loop_t)i)) {
+            continue;
+        }
+
+        // 记录输入样本, 用于采样->输出延迟跟踪
+        g_loop_trace[i].sequence = g_control_context.sensor_data.sensors[loop->sensor_type].sequence;
+        g_loop_trace[i].acquire_time = g_control_context.sensor_data.sensors[loop->sensor_type].acquire_time;
+        g_loop_trace[i].loop = i;
+
+        // 自整定中: 继电器输出, 每拍O(1), 不影响其他回路 (串级外环的继电量作用于内环设定值)
+        if (g_autotune_mask & (1UL << i)) {
+            Control_RestartElapsed((control_loop_t)i);
+            g_output_mask |= (1UL << i);
+            loop->output_value = PidAutotune_Update(&g_autotune[i], process_value);
+            LatencyTrace_Record(&g_loop_trace[i], LATENCY_STAGE_CONTROL);
+            if (g_autotune[i].state != PID_AUTOTUNE_RUNNING) {
+                Control_FinishAutoTune((control_loop_t)i);
+            }
+            if (Control_IsCascadeOuter(loop)) {
+                Control_ApplyCascadeSetpoint(loop, loop->output_value);
+            }
+            continue;
+        }
+
+        // 串级外环按频率比分频执行, 其余周期保持内环设定值
+        if (Control_IsCascadeOuter(loop)) {
+            if (g_cascade_countdown[i] > 0) {
+                g_cascade_countdown[i]--;
+                continue;
+            }
+            g_cascade_countdown[i] = loop->cascade.rate_ratio - 1;
+            outer_mask |= (1UL << i);
+        }
+
+        Control_SetElapsed((control_loop_t)i);
+        g_pid_batch.setpoint[i] = loop->setpoint;
+        loop->smith_correction = (loop->mode == CONTROL_MODE_SMITH) ?
+                                 Control_UpdateSmithCorrection((control_loop_t)i) : 0.0f;
+        g_pid_batch.process_value[i] = process_value + loop->smith_correction;
+        g_pid_batch.feedforward[i] = (loop->mode == CONTROL_MODE_FEEDFORWARD) ?
+                                     Control_UpdateFeedforward((control_loop_t)i) : 0.0f;
+        loop->feedforward_output = g_pid_batch.feedforward[i];
+        active_mask |= (1UL << i);
+    }
+
+    // 2. 先算串级外环, 输出写入内环设定值, 再一次计算其余回路
+    if (outer_mask != 0) {
+        PidBatch_Execute(&g_pid_batch, outer_mask);
+        for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+            if (outer_mask & (1UL << i)) {
+                Control_ApplyCascadeSetpoint(&g_control_context.loops[i], g_pid_batch.output[i]);
+            }
+        }
+    }
+    PidBatch_Execute(&g_pid_batch, active_mask & ~outer_mask);
+    g_output_mask |= active_mask;
+
+    // 3. 写回输出并同步PID状态 (非热路径)
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        if ((active_mask & (1UL << i)) == 0) {
+            continue;
+        }
+
+        control_loop_config_t *loop = &g_control_context.loops[i];
+        pid_state_t *state = &loop->pid_state;
+
+        loop->output_value = g_pid_batch.output[i];
         loop->state = CONTROL_STATE_RUNNING;
+        LatencyTrace_Record(&g_loop_trace[i], LATENCY_STAGE_CONTROL);
+
+        // 预估模型以本周期输出推进, 下周期给出校正量
+        if (g_smith_primed_mask & (1UL << i)) {
+            FopdtModel_Update(&g_smith_model[i], loop->output_value, g_pid_batch.sample_time[i]);
+        }
+
+        if (loop->pid_params.enabled) {
+            float abs_error = fabsf(g_pid_batch.last_error[i]);
+
+            state->setpoint = g_pid_batch.setpoint[i];
+            state->process_value = g_pid_batch.process_value[i];
+            state->error = g_pid_batch.error[i];
+            state->last_error = g_pid_batch.last_error[i];
+            state->integral = g_pid_batch.integral[i];
+            state->filtered_derivative = g_pid_batch.filtered_derivative[i];
+            state->derivative = g_pid_batch.filtered_derivative[i];
+            state->output = g_pid_batch.output[i];
+            state->in_deadband = (g_pid_batch.deadband_mask & (1UL << i)) != 0;
+            state->output_saturated = (g_pid_batch.saturated_mask & (1UL << i)) != 0;
+            state->first_run = false;
+            state->last_update_time = now;
+            state->cycle_count++;
+
+            // 更新统计信息 (平均误差取KPI窗口, 不随运行时间变钝; KPI按实测过程值, 不含预估校正)
+            if (abs_error > state->max_error) {
+                state->max_error = abs_error;
+            }
+            LoopKpi_Update(&g_loop_kpi[i], state->setpoint, loop->process_value,
+                           g_pid_batch.sample_time[i], state->output_saturated);
+            state->avg_error = LoopKpi_GetMeanAbsError(&g_loop_kpi[i]);
+        }
 
         // 更新回路统计
+#if CONTROL_DATA_DRIVEN
+        loop->total_run_time += (uint32_t)(g_pid_batch.sample_time[i] * 1000.0f + 0.5f);
+#else
         loop->total_run_time += CONTROL_TASK_PERIOD_MS;
-        loop->last_update_time = HAL_GetTick();
+#endif
+        loop->last_update_time = now;
     }
 }
 
@@ -786,22 +1081,40 @@ static void Control_ExecuteControlLoops(void)
  */
 static void Control_UpdateActuators(void)
 {
+    bool updated = false;
+
     for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
         control_loop_config_t *loop = &g_control_context.loops[i];
 
-        // 只更新使能且自动模式的回路
-        if (!loop->enabled || !loop->auto_mode) {
+        // 只更新使能且自动模式的回路 (串级外环的输出是内环设定值, 不直接驱动执行器)
+        if (!loop->enabled || !loop->auto_mode || Control_IsCascadeOuter(loop)) {
+            continue;
+        }
+
+#if CONTROL_DATA_DRIVEN
+        // 数据驱动: 只下发本次重新计算过的回路
+        if ((g_output_mask & (1UL << i)) == 0) {
             continue;
         }
+#endif
 
         // 设置执行器输出
         BaseType_t result = Control_SetActuatorOutput((control_loop_t)i, loop->output_value);
 
         if (result != pdTRUE) {
             g_control_stats.actuator_errors++;
+        } else {
+            updated = true;
         }
     }
 
+    // 本周期所有输出一次发布, 不占用执行器命令队列
+    if (updated) {
+        ActuatorTaskV3_PublishSetpoints(&g_actuator_setpoints);
+    }
+
+    g_output_mask = 0;
+
     // 更新执行器状态时间戳
     g_control_context.actuator_update_time = HAL_GetTick();
     g_control_context.actuator_states_valid = true;
@@ -861,11 +1174,6 @@ static void Control_UpdateQuality(void)
             float quality = Control_CalculateLoopQuality((control_loop_t)i);
             loop->control_quality = quality;
 
-            // 存储质量历史
-            uint8_t idx = g_quality_index[i];
-            g_quality_history[i][idx] = quality;
-            g_quality_index[i] = (idx + 1) % CONTROL_QUALITY_SAMPLES;
-
             total_quality += (uint32_t)quality;
             enabled_loops++;
             loop->quality_update_count++;
@@ -880,6 +1188,14 @@ static void Control_UpdateQuality(void)
     // 更新统计信息
     g_control_stats.avg_control_quality = (float)g_control_context.overall_quality;
 
+    // 刷新回路性能指标 (供CoE/远程整定审计读取)
+    if (xSemaphoreTake(xMutex_ControlContext, pdMS_TO_TICKS(5)) == pdTRUE) {
+        for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+            LoopKpi_GetSummary(&g_loop_kpi[i], &g_loop_kpi_summary[i]);
+        }
+        xSemaphoreGive(xMutex_ControlContext);
+    }
+
     // 设置质量更新事件
     xEventGroupSetBits(xEventGroup_Control, EVENT_CONTROL_QUALITY_UPDATE);
 }
@@ -898,11 +1214,6 @@ static void Control_CheckStability(void)
         if (loop->enabled && loop->auto_mode) {
             float stability = Control_CalculateLoopStability((control_loop_t)i);
 
-            // 存储稳定性历史
-            uint8_t idx = g_stability_index[i];
-            g_stability_buffer[i][idx] = stability;
-            g_stability_index[i] = (idx + 1) % STABILITY_CHECK_CYCLES;
-
             total_stability += stability;
             enabled_loops++;
         }
@@ -919,127 +1230,93 @@ static void Control_CheckStability(void)
  */
 static void Control_SendStatusMessage(void)
 {
-    control_msg_t status_msg;
+    control_msg_t *status_msg;
 
-    status_msg.type = MSG_CONTROL_STATUS;
-    status_msg.timestamp = HAL_GetTick();
-    status_msg.data_len = sizeof(control_context_t);
+    // 无订阅者时直接返回, 不加锁也不复制上下文
+    status_msg = (control_msg_t *)MsgBus_Alloc(MSG_BUS_TOPIC_CONTROL_STATUS);
+    if (status_msg == NULL) {
+        return;
+    }
 
-    // 获取互斥体并复制上下文
+    status_msg->type = MSG_CONTROL_STATUS;
+    status_msg->timestamp = HAL_GetTick();
+    status_msg->data_len = sizeof(control_context_t);
+
+    // 获取互斥体并直接复制到消息块
     if (xSemaphoreTake(xMutex_ControlContext, pdMS_TO_TICKS(5)) == pdTRUE) {
-        memcpy(&status_msg.data.context, &g_control_context, sizeof(control_context_t));
+        memcpy(&status_msg->data.context, &g_control_context, sizeof(control_context_t));
         xSemaphoreGive(xMutex_ControlContext);
 
-        // 发送消息到队列
-        xQueueSend(xQueue_ControlMsg, &status_msg, 0);
+        MsgBus_Publish(status_msg);
+    } else {
+        MsgBus_Discard(status_msg);
     }
 }
 
 /**
- * @brief PID控制器计算
- * @param loop_id 控制回路ID
- * @param setpoint 设定值
- * @param process_value 过程值
- * @return 控制输出
+ * @brief 处理主站下发的系统命令 (不阻塞, 只在字段变化通知到达时读取)
  */
-static float PID_Calculate(control_loop_t loop_id, float setpoint, float process_value)
+static void Control_ProcessMasterOutputs(void)
 {
-    if (loop_id >= CONTROL_LOOP_COUNT) {
-        return 0.0f;
-    }
-
-    control_loop_config_t *loop = &g_control_context.loops[loop_id];
-    pid_params_t *params = &loop->pid_params;
-    pid_state_t *state = &loop->pid_state;
-
-    if (!params->enabled) {
-        return 0.0f;
-    }
-
-    // 计算误差
-    float error = setpoint - process_value;
-    state->error = error;
+    uint32_t dirty_fields = 0;
+    OutputDataCache_t outputs;
 
-    // 死区处理
-    if (fabsf(error) < params->deadband) {
-        state->in_deadband = true;
-        error = 0.0f;
-    } else {
-        state->in_deadband = false;
+    if (xTaskNotifyWaitIndexed(OUTPUT_MONITOR_NOTIFY_INDEX, 0, OUTPUT_FIELD_ALL,
+                               &dirty_fields, 0) != pdTRUE) {
+        return;
     }
 
-    // 比例项
-    float p_term = params->kp * error;
-
-    // 积分项
-    float i_term = 0.0f;
-    if (params->integral_enabled && !state->in_deadband) {
-        state->integral += error * params->sample_time;
-
-        // 积分限幅
-        if (state->integral > params->integral_max) {
-            state->integral = params->integral_max;
-        }
-        if (state->integral < params->integral_min) {
-            state->integral = params->integral_min;
-        }
-
-        i_term = params->ki * state->integral;
+    if ((dirty_fields & OUTPUT_FIELD_BIT(OUTPUT_FIELD_SYSTEM_CMD)) == 0) {
+        return;
     }
 
-    // 微分项
-    float d_term = 0.0f;
-    if (params->derivative_enabled && !state->first_run) {
-        float derivative = (error - state->last_error) / params->sample_time;
+    // 命令在本周期的Control_ProcessCommands中执行
+    EtherCAT_OutputMonitor_GetOutputs(&outputs);
+    switch (outputs.system_control_cmd) {
+        case CONTROL_MASTER_CMD_RUN:
+            ControlTaskV3_Resume();
+            break;
 
-        // 微分滤波
-        state->filtered_derivative = params->derivative_filter * derivative +
-                                     (1.0f - params->derivative_filter) * state->filtered_derivative;
+        case CONTROL_MASTER_CMD_EMERGENCY_STOP:
+            ControlTaskV3_EmergencyStop();
+            break;
 
-        d_term = params->kd * state->filtered_derivative;
-        state->derivative = state->filtered_derivative;
+        default:
+            break;
     }
+}
 
-    // 计算总输出
-    float output = p_term + i_term + d_term;
+/**
+ * @brief 刷新TxPDO中由控制任务提供的应用数据 (0x6001.1, 0x6002, 0x6003, 0x6006)
+ * @note  报警/提示字的位号即control_loop_t; Pin/Pout分别对应压力回路1/2
+ */
+static void Control_PublishProcessImage(void)
+{
+    uint16_t alarm_bits = 0;
+    uint16_t warning_bits = 0;
+    uint16_t running_bits = 0;
 
-    // 输出限幅
-    if (output > params->output_max) {
-        output = params->output_max;
-        state->output_saturated = true;
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        const control_loop_config_t *loop = &g_control_context.loops[i];
 
-        // 抗积分饱和
-        if (params->anti_windup_enabled && params->integral_enabled) {
-            state->integral -= error * params->sample_time;
+        if (loop->alarm_status) {
+            alarm_bits |= (uint16_t)(1u << i);
         }
-    } else if (output < params->output_min) {
-        output = params->output_min;
-        state->output_saturated = true;
-
-        // 抗积分饱和
-        if (params->anti_windup_enabled && params->integral_enabled) {
-            state->integral -= error * params->sample_time;
+        if (loop->warning_status) {
+            warning_bits |= (uint16_t)(1u << i);
+        }
+        if (loop->state == CONTROL_STATE_RUNNING) {
+            running_bits |= (uint16_t)(1u << i);
         }
-    } else {
-        state->output_saturated = false;
-    }
-
-    // 更新状态
-    state->last_error = error;
-    state->output = output;
-    state->process_value = process_value;
-    state->setpoint = setpoint;
-    state->last_update_time = HAL_GetTick();
-    state->cycle_count++;
-    state->first_run = false;
-
-    // 更新统计信息
-    if (fabsf(error) > state->max_error) {
-        state->max_error = fabsf(error);
     }
-    state->avg_error = (state->avg_error * (state->cycle_count - 1) + fabsf(error)) / state->cycle_count;
 
-    return output;
+    ProcessImage_SetApplValue(PI_APPL_ALARM_1, (float)alarm_bits);
+    ProcessImage_SetApplValue(PI_APPL_INFO_1, (float)warning_bits);
+    ProcessImage_SetApplValue(PI_APPL_INFO_2, (float)running_bits);
+    ProcessImage_SetApplValue(PI_APPL_STATE_DISPLAY, (float)g_control_context.system_mode);
+    ProcessImage_SetApplValue(PI_APPL_STATE_CODE, (float)g_control_context.system_state);
+    ProcessImage_SetApplValue(PI_APPL_PIN_SETPOINT, g_control_context.loops[CONTROL_LOOP_PRESSURE_1].setpoint);
+    ProcessImage_SetApplValue(PI_APPL_POUT_SETPOINT, g_control_context.loops[CONTROL_LOOP_PRESSURE_2].setpoint);
 }
 
 /**
@@ -1066,6 +1343,9 @@ static void PID_Reset(control_loop_t loop_id)
     state->cycle_count = 0;
     state->max_error = 0.0f;
     state->avg_error = 0.0f;
+
+    PidBatch_Reset(&g_pid_batch, (uint8_t)loop_id);
+    LoopKpi_Reset(&g_loop_kpi[loop_id]);
 }
 
 /**
@@ -1080,6 +1360,7 @@ static void PID_SetParams(control_loop_t loop_id, const pid_params_t *params)
     }
 
     memcpy(&g_control_context.loops[loop_id].pid_params, params, sizeof(pid_params_t));
+    PidBatch_SetParams(&g_pid_batch, (uint8_t)loop_id, params);
 }
 
 /**
@@ -1108,6 +1389,435 @@ static float PID_AntiWindup(control_loop_t loop_id, float output)
     return output;
 }
 
+/**
+ * @brief 启动继电自整定
+ * @param loop_id 控制回路ID
+ * @return pdTRUE=成功, pdFALSE=回路未在自动运行或配置不合法
+ */
+static BaseType_t Control_StartAutoTune(control_loop_t loop_id)
+{
+    control_loop_config_t *loop = &g_control_context.loops[loop_id];
+    const pid_params_t *params = &loop->pid_params;
+    pid_autotune_config_t config;
+    float amplitude;
+
+    if (!loop->enabled || !loop->auto_mode || (g_autotune_mask & (1UL << loop_id))) {
+        return pdFALSE;
+    }
+
+    // 继电中心取当前输出, 保证 bias±d 不超出输出范围
+    amplitude = CONTROL_AUTO_TUNE_AMPLITUDE * (params->output_max - params->output_min);
+    config.bias = loop->output_value;
+    if (config.bias < params->output_min + amplitude) config.bias = params->output_min + amplitude;
+    if (config.bias > params->output_max - amplitude) config.bias = params->output_max - amplitude;
+
+    config.setpoint = loop->setpoint;
+    config.amplitude = amplitude;
+    config.hysteresis = params->deadband;
+    config.max_deviation = CONTROL_AUTO_TUNE_DEVIATION * (loop->setpoint_max - loop->setpoint_min);
+    config.sample_time = Control_GetInputPeriod(loop_id);
+    config.max_half_period = CONTROL_AUTO_TUNE_HALF_PERIOD_S;
+    config.max_switches = CONTROL_AUTO_TUNE_CYCLES;
+
+    if (!PidAutotune_Start(&g_autotune[loop_id], &config)) {
+        return pdFALSE;
+    }
+
+    g_autotune_mask |= (1UL << loop_id);
+    g_autotune_prev_state[loop_id] = loop->state;
+    g_autotune_prev_enabled[loop_id] = loop->enabled;
+    loop->state = CONTROL_STATE_TUNING;
+    xEventGroupSetBits(xEventGroup_Control, EVENT_CONTROL_TUNING);
+
+    printf("[ControlV3] 回路%d开始继电自整定: 输出%.1f±%.1f, 回差%.2f\r\n",
+           loop_id, config.bias, config.amplitude, config.hysteresis);
+
+    return pdTRUE;
+}
+
+/**
+ * @brief 中止继电自整定 (未在整定时无操作)
+ * @param loop_id 控制回路ID
+ */
+static void Control_StopAutoTune(control_loop_t loop_id)
+{
+    if (g_autotune_mask & (1UL << loop_id)) {
+        PidAutotune_Abort(&g_autotune[loop_id]);
+        Control_FinishAutoTune(loop_id);
+    }
+}
+
+/**
+ * @brief 自整定结束: 保存结果, 按规则写入PID参数, 恢复整定前状态
+ * @param loop_id 控制回路ID
+ * @note  整定前在运行且仍使能、仍为自动模式时无扰切回PID (输出取继电中心);
+ *        否则 (整定中被禁用/切手动/传感器失效等) 不改输出, 只恢复整定前状态
+ */
+static void Control_FinishAutoTune(control_loop_t loop_id)
+{
+    control_loop_config_t *loop = &g_control_context.loops[loop_id];
+    pid_autotune_t *tuner = &g_autotune[loop_id];
+    pid_params_t params = loop->pid_params;
+    bool tuned = false;
+    bool resume;
+
+    g_autotune_mask &= ~(1UL << loop_id);
+
+    if (tuner->state == PID_AUTOTUNE_DONE) {
+        tuned = PidAutotune_ComputeGains(&tuner->result, CONTROL_AUTO_TUNE_RULE,
+                                         &params.kp, &params.ki, &params.kd) ||
+                PidAutotune_ComputeGains(&tuner->result, PID_AUTOTUNE_RULE_ZN_PI,
+                                         &params.kp, &params.ki, &params.kd);
+    }
+
+    if (tuned) {
+        if (xSemaphoreTake(xMutex_ControlContext, pdMS_TO_TICKS(5)) == pdTRUE) {
+            g_autotune_result[loop_id] = tuner->result;
+            g_autotune_valid_mask |= (1UL << loop_id);
+            xSemaphoreGive(xMutex_ControlContext);
+        }
+
+        printf("[ControlV3] 回路%d自整定完成: Ku=%.3f Tu=%.2fs θ=%.2fs -> Kp=%.3f Ki=%.4f Kd=%.4f\r\n",
+               loop_id, tuner->result.ku, tuner->result.tu, tuner->result.dead_time,
+               params.kp, params.ki, params.kd);
+
+#if CONTROL_AUTO_TUNE_APPLY
+        params.integral_enabled = (params.ki > 0.0f);
+        params.derivative_enabled = (params.kd > 0.0f);
+        PID_SetParams(loop_id, &params);
+#endif
+    } else {
+        printf("[ControlV3] 回路%d自整定未完成, 错误=%d\r\n", loop_id, tuner->error);
+    }
+
+    resume = g_autotune_prev_enabled[loop_id] && loop->enabled && loop->auto_mode &&
+             g_autotune_prev_state[loop_id] == CONTROL_STATE_RUNNING;
+
+    // 继电期间的误差历史对PID无效
+    PID_Reset(loop_id);
+
+    if (resume) {
+        // 积分预置为继电中心输出, 切回PID时输出不跳变
+        Control_PresetIntegral(loop_id, tuner->config.bias);
+        loop->output_value = tuner->config.bias;
+        loop->state = CONTROL_STATE_RUNNING;
+    } else if (loop->state == CONTROL_STATE_TUNING) {
+        // 中止方已设置输出 (禁用/急停置0, 手动模式保持手动输出), 这里只恢复状态
+        loop->state = loop->enabled ? g_autotune_prev_state[loop_id] : CONTROL_STATE_IDLE;
+    }
+
+    xEventGroupSetBits(xEventGroup_Control, EVENT_CONTROL_TUNING);
+}
+
+/**
+ * @brief 按给定输出预置积分 (复位后调用, 用于无扰切换)
+ * @param loop_id 控制回路ID
+ * @param output 期望的切换时刻输出
+ */
+static void Control_PresetIntegral(control_loop_t loop_id, float output)
+{
+    control_loop_config_t *loop = &g_control_context.loops[loop_id];
+    const pid_params_t *params = &loop->pid_params;
+    float integral;
+
+    if (!params->integral_enabled || params->ki <= 0.0f) {
+        return;
+    }
+
+    integral = output / params->ki;
+    if (integral > params->integral_max) integral = params->integral_max;
+    if (integral < params->integral_min) integral = params->integral_min;
+
+    loop->pid_state.integral = integral;
+    g_pid_batch.integral[loop_id] = integral;
+}
+
+/**
+ * @brief 回路是否为生效中的串级外环
+ */
+static bool Control_IsCascadeOuter(const control_loop_config_t *loop)
+{
+    return loop->mode == CONTROL_MODE_CASCADE && loop->cascade.inner_loop < CONTROL_LOOP_COUNT;
+}
+
+/**
+ * @brief 配置串级
+ * @param outer_loop 外环
+ * @param config 串级配置 (inner_loop=CONTROL_LOOP_COUNT时取消)
+ * @return pdTRUE=成功, pdFALSE=配置不合法
+ */
+static BaseType_t Control_ConfigureCascade(control_loop_t outer_loop, const control_cascade_config_t *config)
+{
+    control_loop_config_t *outer = &g_control_context.loops[outer_loop];
+    control_loop_t inner_loop = config->inner_loop;
+    pid_params_t params;
+
+    if (inner_loop >= CONTROL_LOOP_COUNT) {
+        outer->cascade.inner_loop = CONTROL_LOOP_COUNT;
+        outer->cascade.rate_ratio = 1;
+        return pdTRUE;
+    }
+
+    if (inner_loop == outer_loop || config->rate_ratio == 0 ||
+        g_control_context.loops[inner_loop].cascade.inner_loop < CONTROL_LOOP_COUNT) {
+        return pdFALSE;
+    }
+
+    // 只支持单级串级: 外环不能是别的回路的内环, 内环只能有一个外环
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        control_loop_t other = g_control_context.loops[i].cascade.inner_loop;
+
+        if (i != outer_loop && (other == outer_loop || other == inner_loop)) {
+            return pdFALSE;
+        }
+    }
+
+    control_loop_config_t *inner = &g_control_context.loops[inner_loop];
+
+    outer->cascade = *config;
+
+    // 外环输出即内环设定值, 采样时间随分频加长
+    params = outer->pid_params;
+    params.output_min = inner->setpoint_min;
+    params.output_max = inner->setpoint_max;
+    params.sample_time = config->rate_ratio * (CONTROL_TASK_PERIOD_MS / 1000.0f);
+    PID_SetParams(outer_loop, &params);
+
+    // 从内环当前设定值无扰接入
+    PID_Reset(outer_loop);
+    Control_PresetIntegral(outer_loop, inner->setpoint);
+    g_cascade_countdown[outer_loop] = 0;
+
+    return pdTRUE;
+}
+
+/**
+ * @brief 串级外环输出写入内环设定值 (按内环设定值范围限幅)
+ * @param outer 外环
+ * @param output 外环输出
+ */
+static void Control_ApplyCascadeSetpoint(const control_loop_config_t *outer, float output)
+{
+    control_loop_t inner_loop = outer->cascade.inner_loop;
+    control_loop_config_t *inner = &g_control_context.loops[inner_loop];
+
+    if (output < inner->setpoint_min) output = inner->setpoint_min;
+    if (output > inner->setpoint_max) output = inner->setpoint_max;
+
+    inner->setpoint = output;
+    inner->pid_state.setpoint = output;
+    g_pid_batch.setpoint[inner_loop] = output;
+}
+
+/**
+ * @brief 计算前馈量 (超前滞后环节, 后向欧拉离散)
+ * @param loop_id 控制回路ID
+ * @return 前馈量 (扰动测量无效时为0)
+ * @note y = (T_lag·y' + (T_lead + h)·x - T_lead·x') / (T_lag + h), T_lead=T_lag=0时 y=x
+ */
+static float Control_UpdateFeedforward(control_loop_t loop_id)
+{
+    control_loop_config_t *loop = &g_control_context.loops[loop_id];
+    const control_feedforward_config_t *config = &loop->feedforward;
+    const float h = g_pid_batch.sample_time[loop_id];
+    const uint32_t bit = 1UL << loop_id;
+    float x;
+
+    if (config->sensor >= SENSOR_COUNT || !g_control_context.sensor_data_valid ||
+        !g_control_context.sensor_data.sensors[config->sensor].valid) {
+        g_ff_primed_mask &= ~bit;
+        return 0.0f;
+    }
+
+    x = g_control_context.sensor_data.sensors[config->sensor].calibrated_value - config->reference;
+
+    // 首次按稳态预置, 避免超前项在接入时产生尖峰
+    if ((g_ff_primed_mask & bit) == 0) {
+        g_ff_last_input[loop_id] = x;
+        g_ff_state[loop_id] = x;
+        g_ff_primed_mask |= bit;
+    }
+
+    g_ff_state[loop_id] = (config->lag_time * g_ff_state[loop_id] +
+                           (config->lead_time + h) * x - config->lead_time * g_ff_last_input[loop_id]) /
+                          (config->lag_time + h);
+    g_ff_last_input[loop_id] = x;
+
+    return config->gain * g_ff_state[loop_id];
+}
+
+/**
+ * @brief 配置纯滞后补偿模型
+ * @param loop_id 控制回路ID
+ * @param config 过程模型 (gain=0时取最近一次自整定结果)
+ * @return pdTRUE=成功, pdFALSE=模型无效或无自整定结果
+ */
+static BaseType_t Control_ConfigureSmith(control_loop_t loop_id, const control_smith_config_t *config)
+{
+    control_loop_config_t *loop = &g_control_context.loops[loop_id];
+    control_smith_config_t model = *config;
+    pid_params_t params;
+
+    if (model.gain == 0.0f) {
+        if ((g_autotune_valid_mask & (1UL << loop_id)) == 0) {
+            return pdFALSE;
+        }
+        model.gain = g_autotune_result[loop_id].gain;
+        model.time_constant = g_autotune_result[loop_id].time_constant;
+        model.dead_time = g_autotune_result[loop_id].dead_time;
+    }
+
+    // 只支持正作用过程 (PID误差为 设定值-过程值)
+    if (!(model.gain > 0.0f) || model.time_constant < 0.0f || model.dead_time < 0.0f ||
+        model.imc_lambda < 0.0f) {
+        return pdFALSE;
+    }
+
+    loop->smith = model;
+    loop->smith_correction = 0.0f;
+    FopdtModel_Init(&g_smith_model[loop_id], model.gain, model.time_constant, model.dead_time);
+    g_smith_primed_mask &= ~(1UL << loop_id);
+
+    // IMC整定: 预估器去掉滞后后按无滞后对象设计, 闭环近似 1/(λs + 1)
+    if (model.imc_lambda > 0.0f) {
+        params = loop->pid_params;
+        params.kp = (model.time_constant > 0.0f) ?
+                    model.time_constant / (model.gain * model.imc_lambda) : 0.0f;
+        params.ki = 1.0f / (model.gain * model.imc_lambda);
+        params.kd = 0.0f;
+        params.integral_enabled = true;
+        params.derivative_enabled = false;
+        params.integral_max = params.output_max / params.ki;
+        params.integral_min = params.output_min / params.ki;
+        PID_SetParams(loop_id, &params);
+        Control_PresetIntegral(loop_id, loop->output_value);
+    }
+
+    return pdTRUE;
+}
+
+/**
+ * @brief 计算纯滞后补偿校正量
+ * @param loop_id 控制回路ID
+ * @return 模型(无滞后) - 模型(滞后θ), 加到过程值上作为PID反馈 (模型未配置时为0)
+ * @note 模型在写回输出后以本周期输出推进, 每周期O(1)
+ */
+static float Control_UpdateSmithCorrection(control_loop_t loop_id)
+{
+    const control_loop_config_t *loop = &g_control_context.loops[loop_id];
+    fopdt_model_t *model = &g_smith_model[loop_id];
+    const uint32_t bit = 1UL << loop_id;
+
+    if (!(loop->smith.gain > 0.0f)) {
+        g_smith_primed_mask &= ~bit;
+        return 0.0f;
+    }
+
+    // 首次按当前输出的稳态预置, 接入时校正量为0, 反馈不跳变
+    if ((g_smith_primed_mask & bit) == 0) {
+        FopdtModel_Reset(model, loop->output_value);
+        g_smith_primed_mask |= bit;
+    }
+
+    return FopdtModel_GetOutput(model) - FopdtModel_GetDelayedOutput(model);
+}
+
+/**
+ * @brief 取回路输入的新样本 (数据驱动调度)
+ * @param loop_id 控制回路ID
+ * @return true=有未处理的新样本 (周期调度时总为true), false=输入未更新
+ */
+static bool Control_TakeFreshInput(control_loop_t loop_id)
+{
+#if CONTROL_DATA_DRIVEN
+    const control_loop_config_t *loop = &g_control_context.loops[loop_id];
+    uint32_t sequence = g_control_context.sensor_data.sensors[loop->sensor_type].sequence;
+
+    if (sequence == g_input_sequence[loop_id]) {
+        return false;
+    }
+
+    g_input_sequence[loop_id] = sequence;
+#else
+    (void)loop_id;
+#endif
+    return true;
+}
+
+/**
+ * @brief 按实际样本间隔设置回路采样时间 (数据驱动调度)
+ * @param loop_id 控制回路ID
+ * @note 回路中断计算后的第一次及时间戳异常时按通道名义输出周期计算
+ */
+static void Control_SetElapsed(control_loop_t loop_id)
+{
+#if CONTROL_DATA_DRIVEN
+    const uint32_t bit = 1UL << loop_id;
+    const control_loop_config_t *loop = &g_control_context.loops[loop_id];
+    uint32_t timestamp = g_control_context.sensor_data.sensors[loop->sensor_type].timestamp;
+    uint32_t elapsed_ms = timestamp - g_input_timestamp[loop_id];
+    float elapsed;
+
+    if ((g_input_primed_mask & bit) && elapsed_ms > 0 && elapsed_ms < 0x80000000UL) {
+        elapsed = elapsed_ms / 1000.0f;
+    } else {
+        elapsed = Control_GetInputPeriod(loop_id);
+    }
+
+    g_input_timestamp[loop_id] = timestamp;
+    g_input_primed_mask |= bit;
+    PidBatch_SetElapsed(&g_pid_batch, loop_id, elapsed);
+#else
+    (void)loop_id;
+#endif
+}
+
+/**
+ * @brief 回路中断计算 (停用/传感器无效/自整定), 下次按名义间隔重新开始
+ * @param loop_id 控制回路ID
+ * @note 纯滞后补偿模型同时作废, 恢复后按当时输出重新预置
+ */
+static void Control_RestartElapsed(control_loop_t loop_id)
+{
+    g_smith_primed_mask &= ~(1UL << loop_id);
+#if CONTROL_DATA_DRIVEN
+    g_input_primed_mask &= ~(1UL << loop_id);
+#endif
+}
+
+/**
+ * @brief 获取回路名义采样周期
+ * @param loop_id 控制回路ID
+ * @return 采样周期 (秒): 周期调度为任务周期, 数据驱动为输入通道的输出周期
+ */
+static float Control_GetInputPeriod(control_loop_t loop_id)
+{
+#if CONTROL_DATA_DRIVEN
+    return SensorTaskV3_GetOutputPeriod(g_control_context.loops[loop_id].sensor_type) / 1000.0f;
+#else
+    (void)loop_id;
+    return CONTROL_TASK_PERIOD_MS / 1000.0f;
+#endif
+}
+
+/**
+ * @brief 监视步骤是否到期
+ * @return true=执行报警/质量/稳定性检查 (周期调度时每周期执行)
+ */
+static bool Control_SupervisionDue(void)
+{
+#if CONTROL_DATA_DRIVEN
+    TickType_t now = xTaskGetTickCount();
+
+    if ((now - g_last_supervision_tick) < pdMS_TO_TICKS(CONTROL_TASK_PERIOD_MS)) {
+        return false;
+    }
+
+    g_last_supervision_tick = now;
+#endif
+    return true;
+}
+
 /**
  * @brief 获取传感器值
  * @param loop_id 控制回路ID
@@ -1127,6 +1837,13 @@ static float Control_GetSensorValue(control_loop_t loop_id)
         return 0.0f;
     }
 
+#if CONTROL_LEVEL_ESTIMATE
+    // 液位回路使用融合估计 (无滤波链延迟, 含净流量外推)
+    if (sensor_type == SENSOR_LEVEL_ANALOG && g_control_context.sensor_data.level_estimate.valid) {
+        return g_control_context.sensor_data.level_estimate.level;
+    }
+#endif
+
     return g_control_context.sensor_data.sensors[sensor_type].calibrated_value;
 }
 
@@ -1152,7 +1869,7 @@ static bool Control_IsSensorValid(control_loop_t loop_id)
 }
 
 /**
- * @brief 设置执行器输出
+ * @brief 设置执行器输出 (写入设定值向量, 由Control_UpdateActuators统一发布)
  * @param loop_id 控制回路ID
  * @param output 输出值
  * @return pdTRUE=成功, pdFALSE=失败
@@ -1166,8 +1883,18 @@ static BaseType_t Control_SetActuatorOutput(control_loop_t loop_id, float output
     control_loop_config_t *loop = &g_control_context.loops[loop_id];
     actuator_type_t actuator_type = loop->actuator_type;
 
-    // 调用执行器任务API设置输出
-    return ActuatorTaskV3_SetOutput(actuator_type, output);
+    if (actuator_type >= ACTUATOR_COUNT) {
+        return pdFALSE;
+    }
+
+    // 带输入样本标记写入, 版本加1 (跳过0, 0表示不由设定值向量控制)
+    g_actuator_setpoints.value[actuator_type] = output;
+    g_actuator_setpoints.trace[actuator_type] = g_loop_trace[loop_id];
+    if (++g_actuator_setpoints.revision[actuator_type] == 0) {
+        g_actuator_setpoints.revision[actuator_type] = 1;
+    }
+
+    return pdTRUE;
 }
 
 /**
@@ -1182,10 +1909,9 @@ static float Control_CalculateLoopQuality(control_loop_t loop_id)
     }
 
     control_loop_config_t *loop = &g_control_context.loops[loop_id];
-    pid_state_t *state = &loop->pid_state;
 
-    // 基于误差的质量评估
-    float error_ratio = fabsf(state->error) / (loop->setpoint_max - loop->setpoint_min);
+    // 基于窗口平均绝对误差的质量评估
+    float error_ratio = LoopKpi_GetMeanAbsError(&g_loop_kpi[loop_id]) / (loop->setpoint_max - loop->setpoint_min);
     float error_quality = (1.0f - error_ratio) * 100.0f;
 
     // 限制范围
@@ -1213,18 +1939,12 @@ static float Control_CalculateLoopStability(control_loop_t loop_id)
         return 0.0f;
     }
 
-    control_loop_config_t *loop = &g_control_context.loops[loop_id];
-    pid_state_t *state = &loop->pid_state;
-
-    // 基于误差变化率的稳定性评估
-    float error_change = fabsf(state->error - state->last_error);
-    float stability = 1.0f - (error_change / (loop->setpoint_max - loop->setpoint_min));
+    loop_kpi_summary_t summary;
 
-    // 限制范围
-    if (stability < 0.0f) stability = 0.0f;
-    if (stability > 1.0f) stability = 1.0f;
+    // 基于窗口振荡指数的稳定性评估 (无振荡为1, 窗口内每多一个振荡周期递减)
+    LoopKpi_GetSummary(&g_loop_kpi[loop_id], &summary);
 
-    return stability;
+    return 1.0f / (1.0f + summary.oscillation_index);
 }
 
 /**
@@ -1292,6 +2012,102 @@ BaseType_t ControlTaskV3_SetPIDParams(control_loop_t loop_id, const pid_params_t
     return ControlTaskV3_SendCommand(&command, 10);
 }
 
+/**
+ * @brief 配置串级控制
+ * @param outer_loop 外环
+ * @param inner_loop 内环 (CONTROL_LOOP_COUNT=取消串级)
+ * @param rate_ratio 内环/外环执行频率比 (>=1)
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ControlTaskV3_SetCascade(control_loop_t outer_loop, control_loop_t inner_loop, uint8_t rate_ratio)
+{
+    control_command_t command;
+
+    if (outer_loop >= CONTROL_LOOP_COUNT || inner_loop == outer_loop || rate_ratio == 0) {
+        return pdFALSE;
+    }
+
+    command.cmd_type = CONTROL_CMD_SET_CASCADE;
+    command.loop_id = outer_loop;
+    command.cascade.inner_loop = inner_loop;
+    command.cascade.rate_ratio = rate_ratio;
+    command.timestamp = HAL_GetTick();
+    command.urgent = false;
+
+    return ControlTaskV3_SendCommand(&command, 10);
+}
+
+/**
+ * @brief 配置前馈
+ * @param loop_id 控制回路ID
+ * @param config 前馈配置
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ControlTaskV3_SetFeedforward(control_loop_t loop_id, const control_feedforward_config_t *config)
+{
+    control_command_t command;
+
+    if (loop_id >= CONTROL_LOOP_COUNT || config == NULL) {
+        return pdFALSE;
+    }
+
+    command.cmd_type = CONTROL_CMD_SET_FEEDFORWARD;
+    command.loop_id = loop_id;
+    memcpy(&command.feedforward, config, sizeof(control_feedforward_config_t));
+    command.timestamp = HAL_GetTick();
+    command.urgent = false;
+
+    return ControlTaskV3_SendCommand(&command, 10);
+}
+
+/**
+ * @brief 配置纯滞后补偿
+ * @param loop_id 控制回路ID
+ * @param config 过程模型
+ * @return pdTRUE=成功, pdFALSE=失败
+ */
+BaseType_t ControlTaskV3_SetSmithPredictor(control_loop_t loop_id, const control_smith_config_t *config)
+{
+    control_command_t command;
+
+    if (loop_id >= CONTROL_LOOP_COUNT || config == NULL) {
+        return pdFALSE;
+    }
+
+    command.cmd_type = CONTROL_CMD_SET_SMITH;
+    command.loop_id = loop_id;
+    memcpy(&command.smith, config, sizeof(control_smith_config_t));
+    command.timestamp = HAL_GetTick();
+    command.urgent = false;
+
+    return ControlTaskV3_SendCommand(&command, 10);
+}
+
+/**
+ * @brief 获取纯滞后补偿当前模型
+ */
+BaseType_t ControlTaskV3_GetSmithPredictor(control_loop_t loop_id, control_smith_config_t *config,
+                                          float *correction, bool *active)
+{
+    if (loop_id >= CONTROL_LOOP_COUNT || config == NULL) {
+        return pdFALSE;
+    }
+
+    if (xSemaphoreTake(xMutex_ControlContext, pdMS_TO_TICKS(10)) == pdTRUE) {
+        memcpy(config, &g_control_context.loops[loop_id].smith, sizeof(control_smith_config_t));
+        if (correction != NULL) {
+            *correction = g_control_context.loops[loop_id].smith_correction;
+        }
+        if (active != NULL) {
+            *active = (g_control_context.loops[loop_id].mode == CONTROL_MODE_SMITH);
+        }
+        xSemaphoreGive(xMutex_ControlContext);
+        return pdTRUE;
+    }
+
+    return pdFALSE;
+}
+
 /**
  * @brief 启动PID自整定
  * @param loop_id 控制回路ID
@@ -1307,10 +2123,10 @@ BaseType_t ControlTaskV3_StartAutoTune(control_loop_t loop_id)
 
     command.cmd_type = CONTROL_CMD_TUNE_PID;
     command.loop_id = loop_id;
+    command.value = 1.0f;
     command.timestamp = HAL_GetTick();
     command.urgent = false;
 
-    // TODO: 实现自整定算法
     return ControlTaskV3_SendCommand(&command, 10);
 }
 
@@ -1321,12 +2137,66 @@ BaseType_t ControlTaskV3_StartAutoTune(control_loop_t loop_id)
  */
 BaseType_t ControlTaskV3_StopAutoTune(control_loop_t loop_id)
 {
+    control_command_t command;
+
     if (loop_id >= CONTROL_LOOP_COUNT) {
         return pdFALSE;
     }
 
-    // TODO: 实现停止自整定逻辑
-    return pdTRUE;
+    command.cmd_type = CONTROL_CMD_TUNE_PID;
+    command.loop_id = loop_id;
+    command.value = 0.0f;
+    command.timestamp = HAL_GetTick();
+    command.urgent = false;
+
+    return ControlTaskV3_SendCommand(&command, 10);
+}
+
+/**
+ * @brief 获取最近一次成功的自整定结果
+ */
+BaseType_t ControlTaskV3_GetAutoTuneResult(control_loop_t loop_id, pid_autotune_result_t *result)
+{
+    BaseType_t valid = pdFALSE;
+
+    if (loop_id >= CONTROL_LOOP_COUNT || result == NULL) {
+        return pdFALSE;
+    }
+
+    if (xSemaphoreTake(xMutex_ControlContext, pdMS_TO_TICKS(10)) == pdTRUE) {
+        if (g_autotune_valid_mask & (1UL << loop_id)) {
+            memcpy(result, &g_autotune_result[loop_id], sizeof(pid_autotune_result_t));
+            valid = pdTRUE;
+        }
+        xSemaphoreGive(xMutex_ControlContext);
+    }
+
+    return valid;
+}
+
+/**
+ * @brief 获取回路性能指标
+ * @param loop_id 控制回路ID
+ * @param summary 输出结果
+ * @return pdTRUE=有样本, pdFALSE=回路未运行过或获取失败
+ */
+BaseType_t ControlTaskV3_GetLoopKpi(control_loop_t loop_id, loop_kpi_summary_t *summary)
+{
+    BaseType_t valid = pdFALSE;
+
+    if (loop_id >= CONTROL_LOOP_COUNT || summary == NULL) {
+        return pdFALSE;
+    }
+
+    memset(summary, 0, sizeof(loop_kpi_summary_t));
+
+    if (xSemaphoreTake(xMutex_ControlContext, pdMS_TO_TICKS(10)) == pdTRUE) {
+        memcpy(summary, &g_loop_kpi_summary[loop_id], sizeof(loop_kpi_summary_t));
+        valid = (summary->samples > 0) ? pdTRUE : pdFALSE;
+        xSemaphoreGive(xMutex_ControlContext);
+    }
+
+    return valid;
 }
 
 /**
@@ -1411,42 +2281,32 @@ BaseType_t ControlTaskV3_GetPIDState(control_loop_t loop_id, pid_state_t *state)
 }
 
 /**
- * @brief 发送控制消息到队列
- * @param msg 消息结构指针
- * @param timeout_ms 超时时间
- * @return pdTRUE=成功, pdFALSE=失败
+ * @brief 订阅控制状态消息
+ * @param depth 订阅者队列深度
+ * @return 订阅者, NULL=失败
  */
-BaseType_t ControlTaskV3_SendMessage(const control_msg_t *msg, uint32_t timeout_ms)
+msg_bus_subscriber_t *ControlTaskV3_Subscribe(uint8_t depth)
 {
-    if (msg == NULL) {
-        return pdFALSE;
-    }
-
-    return xQueueSend(xQueue_ControlMsg, msg, pdMS_TO_TICKS(timeout_ms));
+    return MsgBus_Subscribe(MSG_BUS_TOPIC_CONTROL_STATUS, depth);
 }
 
 /**
- * @brief 从队列接收控制消息
- * @param msg 消息结构指针
- * @param timeout_ms 超时时间
- * @return pdTRUE=成功, pdFALSE=失败
+ * @brief 重置控制任务统计信息
  */
-BaseType_t ControlTaskV3_ReceiveMessage(control_msg_t *msg, uint32_t timeout_ms)
+void ControlTaskV3_ResetStatistics(void)
 {
-    if (msg == NULL) {
-        return pdFALSE;
-    }
-
-    return xQueueReceive(xQueue_ControlMsg, msg, pdMS_TO_TICKS(timeout_ms));
+    memset(&g_control_stats, 0, sizeof(control_task_stats_t));
+    Profiler_Reset(&g_control_profiler);
+    LatencyTrace_Reset();
+    printf("[ControlV3] 统计信息已重置\r\n");
 }
 
 /**
- * @brief 重置控制任务统计信息
+ * @brief 获取控制任务分阶段计时器
  */
-void ControlTaskV3_ResetStatistics(void)
+const profiler_t *ControlTaskV3_GetProfiler(void)
 {
-    memset(&g_control_stats, 0, sizeof(control_task_stats_t));
-    printf("[ControlV3] 统计信息已重置\r\n");
+    return &g_control_profiler;
 }
 
 /**
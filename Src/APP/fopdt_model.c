@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @file    fopdt_model.c
+ * @brief   一阶加纯滞后(FOPDT)过程模型实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "fopdt_model.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有宏定义 */
+/* ========================================================================== */
+
+#define FOPDT_MODEL_HISTORY_SIZE        (FOPDT_MODEL_DELAY_SLOTS + 1)
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化模型
+ */
+void FopdtModel_Init(fopdt_model_t *model, float gain, float time_constant, float dead_time)
+{
+    if (model == NULL) {
+        return;
+    }
+
+    memset(model, 0, sizeof(fopdt_model_t));
+    model->gain = gain;
+    model->time_constant = (time_constant > 0.0f) ? time_constant : 0.0f;
+    model->dead_time = (dead_time > 0.0f) ? dead_time : 0.0f;
+    model->slot_time = model->dead_time / (float)FOPDT_MODEL_DELAY_SLOTS;
+}
+
+/**
+ * @brief 按稳态预置
+ */
+void FopdtModel_Reset(fopdt_model_t *model, float input)
+{
+    if (model == NULL) {
+        return;
+    }
+
+    model->state = model->gain * input;
+    model->elapsed = 0.0f;
+    model->head = 0;
+
+    for (uint16_t i = 0; i < FOPDT_MODEL_HISTORY_SIZE; i++) {
+        model->history[i] = model->state;
+    }
+}
+
+/**
+ * @brief 推进一个采样间隔
+ */
+void FopdtModel_Update(fopdt_model_t *model, float input, float dt)
+{
+    float previous;
+    float a;
+
+    if (model == NULL || !(dt > 0.0f)) {
+        return;
+    }
+
+    // 一阶惯性 (零阶保持精确离散, 对任意dt稳定)
+    previous = model->state;
+    a = (model->time_constant > 0.0f) ? expf(-dt / model->time_constant) : 0.0f;
+    model->state = a * previous + (1.0f - a) * model->gain * input;
+
+    if (model->slot_time <= 0.0f) {
+        return;
+    }
+
+    // 写入本间隔内经过的格边界 (边界处按线性插值), 超过一圈时只写最近一圈 (全部N+1格)
+    model->elapsed += dt;
+    if (model->elapsed >= model->slot_time * (float)FOPDT_MODEL_HISTORY_SIZE) {
+        model->elapsed = fmodf(model->elapsed, model->slot_time) +
+                         model->slot_time * (float)FOPDT_MODEL_HISTORY_SIZE;
+    }
+
+    while (model->elapsed >= model->slot_time) {
+        model->elapsed -= model->slot_time;
+        model->head = (uint8_t)((model->head + 1) % FOPDT_MODEL_HISTORY_SIZE);
+        model->history[model->head] = model->state - (model->state - previous) * (model->elapsed / dt);
+    }
+}
+
+/**
+ * @brief 无滞后模型输出
+ */
+float FopdtModel_GetOutput(const fopdt_model_t *model)
+{
+    return (model != NULL) ? model->state : 0.0f;
+}
+
+/**
+ * @brief 滞后θ后的模型输出
+ * @note 最近一格写于 t-elapsed, 往前第k格写于 t-elapsed-k·h, 目标时刻 t-N·h
+ *       落在第N格与第N-1格之间, 权重 elapsed/h
+ */
+float FopdtModel_GetDelayedOutput(const fopdt_model_t *model)
+{
+    uint8_t oldest;
+    uint8_t next;
+    float weight;
+
+    if (model == NULL) {
+        return 0.0f;
+    }
+
+    if (model->slot_time <= 0.0f) {
+        return model->state;
+    }
+
+    oldest = (uint8_t)((model->head + 1) % FOPDT_MODEL_HISTORY_SIZE);
+    next = (uint8_t)((oldest + 1) % FOPDT_MODEL_HISTORY_SIZE);
+    weight = model->elapsed / model->slot_time;
+
+    return model->history[oldest] + (model->history[next] - model->history[oldest]) * weight;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
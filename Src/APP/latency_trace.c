@@ -0,0 +1,164 @@
+/**
+ ******************************************************************************
+ * @file    latency_trace.c
+ * @brief   采样到输出端到端延迟跟踪实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "latency_trace.h"
+#include <string.h>
+#include <stdio.h>
+
+#ifdef PROFILER_HOST_CLOCK
+#define LATENCY_ENTER_CRITICAL()
+#define LATENCY_EXIT_CRITICAL()
+#else
+#include "FreeRTOS.h"
+#include "task.h"
+#define LATENCY_ENTER_CRITICAL()        taskENTER_CRITICAL()
+#define LATENCY_EXIT_CRITICAL()         taskEXIT_CRITICAL()
+#endif
+
+/* ========================================================================== */
+/* 私有变量 */
+/* ========================================================================== */
+
+static const char *const g_latency_stage_names[LATENCY_STAGE_COUNT] = {
+    "control", "output"
+};
+
+// 各回路各阶段统计 (每个阶段只由一个任务更新)
+static profiler_stats_t g_latency_stats[LATENCY_TRACE_MAX_LOOPS][LATENCY_STAGE_COUNT];
+
+// 各回路各阶段最后记录的样本序号
+static uint32_t g_latency_last_sequence[LATENCY_TRACE_MAX_LOOPS][LATENCY_STAGE_COUNT];
+
+static uint32_t g_latency_cycles_per_us = 1;
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化延迟跟踪
+ */
+void LatencyTrace_Init(void)
+{
+#ifdef PROFILER_HOST_CLOCK
+    g_latency_cycles_per_us = 1000;
+#else
+    g_latency_cycles_per_us = SystemCoreClock / 1000000U;
+#endif
+
+    LatencyTrace_Reset();
+}
+
+/**
+ * @brief 清除统计
+ */
+void LatencyTrace_Reset(void)
+{
+    LATENCY_ENTER_CRITICAL();
+    memset(g_latency_stats, 0, sizeof(g_latency_stats));
+    memset(g_latency_last_sequence, 0, sizeof(g_latency_last_sequence));
+    for (uint8_t i = 0; i < LATENCY_TRACE_MAX_LOOPS; i++) {
+        for (uint8_t j = 0; j < LATENCY_STAGE_COUNT; j++) {
+            g_latency_stats[i][j].min_cycles = UINT32_MAX;
+        }
+    }
+    LATENCY_EXIT_CRITICAL();
+}
+
+/**
+ * @brief 清空样本标记
+ */
+void LatencyTrace_ClearStamp(latency_stamp_t *stamp)
+{
+    stamp->sequence = 0;
+    stamp->acquire_time = 0;
+    stamp->loop = LATENCY_TRACE_NO_LOOP;
+}
+
+/**
+ * @brief 记录样本到达某阶段的延迟
+ */
+bool LatencyTrace_Record(const latency_stamp_t *stamp, latency_stage_t stage)
+{
+    uint32_t now = Profiler_Now();
+
+    if (stamp == NULL || stamp->loop >= LATENCY_TRACE_MAX_LOOPS || stamp->sequence == 0 ||
+        stage >= LATENCY_STAGE_COUNT) {
+        return false;
+    }
+
+    if (g_latency_last_sequence[stamp->loop][stage] == stamp->sequence) {
+        return false;
+    }
+
+    g_latency_last_sequence[stamp->loop][stage] = stamp->sequence;
+    Profiler_Record(&g_latency_stats[stamp->loop][stage], now - stamp->acquire_time,
+                    g_latency_cycles_per_us);
+
+    return true;
+}
+
+/**
+ * @brief 获取统计结果
+ */
+bool LatencyTrace_GetSummary(uint8_t loop, latency_stage_t stage, profiler_summary_t *summary)
+{
+    profiler_stats_t stats;
+
+    if (loop >= LATENCY_TRACE_MAX_LOOPS || stage >= LATENCY_STAGE_COUNT || summary == NULL) {
+        return false;
+    }
+
+    LATENCY_ENTER_CRITICAL();
+    stats = g_latency_stats[loop][stage];
+    LATENCY_EXIT_CRITICAL();
+
+    memset(summary, 0, sizeof(profiler_summary_t));
+    summary->name = g_latency_stage_names[stage];
+    summary->count = stats.count;
+    memcpy(summary->hist, stats.hist, sizeof(summary->hist));
+
+    if (stats.count > 0) {
+        float scale = 1.0f / (float)g_latency_cycles_per_us;
+
+        summary->min_us = (float)stats.min_cycles * scale;
+        summary->max_us = (float)stats.max_cycles * scale;
+        summary->mean_us = (float)stats.total_cycles / (float)stats.count * scale;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 打印各回路延迟统计
+ */
+void LatencyTrace_PrintStats(void)
+{
+    profiler_summary_t summary;
+
+    printf("========== 采样->输出延迟统计 (us) ==========\r\n");
+    printf("回路 阶段         次数      最小      平均      最大\r\n");
+
+    for (uint8_t i = 0; i < LATENCY_TRACE_MAX_LOOPS; i++) {
+        for (uint8_t j = 0; j < LATENCY_STAGE_COUNT; j++) {
+            LatencyTrace_GetSummary(i, (latency_stage_t)j, &summary);
+            if (summary.count == 0) {
+                continue;
+            }
+
+            printf("%4u %-8s %9lu %9.0f %9.0f %9.0f\r\n", i, summary.name,
+                   (unsigned long)summary.count, summary.min_us, summary.mean_us, summary.max_us);
+        }
+    }
+
+    printf("==============================================\r\n");
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
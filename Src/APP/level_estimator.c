@@ -0,0 +1,284 @@
+/**
+ ******************************************************************************
+ * @file    level_estimator.c
+ * @brief   墨水液位卡尔曼估计器实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "level_estimator.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有宏定义 */
+/* ========================================================================== */
+
+#define LEVEL_ESTIMATOR_SWITCH_UNKNOWN  0xFF
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static void LevelEstimator_Seed(level_estimator_t *est, float level, float variance);
+static void LevelEstimator_Correct(level_estimator_t *est, float innovation, float s);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 获取默认配置
+ */
+void LevelEstimator_DefaultConfig(level_estimator_config_t *config)
+{
+    if (config == NULL) {
+        return;
+    }
+
+    memset(config, 0, sizeof(level_estimator_config_t));
+    config->level_noise = 1.0f;
+    config->flow_noise = 0.05f;
+    config->switch_height[0] = 15.0f;       // 低液位警告
+    config->switch_height[1] = 50.0f;       // 默认设定值
+    config->switch_height[2] = 80.0f;       // 高液位警告
+    config->switch_noise = 1.0f;
+}
+
+/**
+ * @brief 检查配置
+ */
+bool LevelEstimator_CheckConfig(const level_estimator_config_t *config)
+{
+    float last = -INFINITY;
+
+    if (config == NULL || !(config->level_noise > 0.0f) || !(config->flow_noise > 0.0f) ||
+        !(config->switch_noise > 0.0f)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < LEVEL_ESTIMATOR_SWITCH_COUNT; i++) {
+        if (config->switch_height[i] < 0.0f) {
+            continue;
+        }
+        if (!(config->switch_height[i] > last)) {
+            return false;
+        }
+        last = config->switch_height[i];
+    }
+
+    for (uint8_t i = 0; i < LEVEL_ESTIMATOR_PUMP_COUNT; i++) {
+        if (!isfinite(config->pump_gain[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 初始化估计器
+ */
+void LevelEstimator_Init(level_estimator_t *est, const level_estimator_config_t *config)
+{
+    if (est == NULL) {
+        return;
+    }
+
+    memset(est, 0, sizeof(level_estimator_t));
+
+    if (config != NULL) {
+        est->config = *config;
+    } else {
+        LevelEstimator_DefaultConfig(&est->config);
+    }
+
+    memset(est->switch_state, LEVEL_ESTIMATOR_SWITCH_UNKNOWN, sizeof(est->switch_state));
+}
+
+/**
+ * @brief 更换配置
+ */
+void LevelEstimator_SetConfig(level_estimator_t *est, const level_estimator_config_t *config)
+{
+    if (est == NULL || config == NULL) {
+        return;
+    }
+
+    est->config = *config;
+    memset(est->switch_state, LEVEL_ESTIMATOR_SWITCH_UNKNOWN, sizeof(est->switch_state));
+}
+
+/**
+ * @brief 时间更新
+ * @note F = [1 dt; 0 1], Q = q·[dt³/3 dt²/2; dt²/2 dt] (净流量为随机游走)
+ */
+void LevelEstimator_Predict(level_estimator_t *est, const float *pump, float dt)
+{
+    float q;
+    float inflow = 0.0f;
+
+    if (est == NULL || !(dt > 0.0f)) {
+        return;
+    }
+
+    if (pump != NULL) {
+        for (uint8_t i = 0; i < LEVEL_ESTIMATOR_PUMP_COUNT; i++) {
+            inflow += est->config.pump_gain[i] * pump[i] * 0.01f;
+        }
+    }
+    est->inflow = inflow;
+
+    if (!est->initialized) {
+        return;
+    }
+
+    q = est->config.flow_noise * est->config.flow_noise;
+
+    est->level += (inflow + est->bias) * dt;
+
+    est->p00 += dt * (2.0f * est->p01 + dt * est->p11) + q * dt * dt * dt / 3.0f;
+    est->p01 += dt * est->p11 + q * dt * dt * 0.5f;
+    est->p11 += q * dt;
+}
+
+/**
+ * @brief 模拟液位观测更新
+ */
+bool LevelEstimator_UpdateLevel(level_estimator_t *est, float level)
+{
+    float r;
+    float s;
+    float innovation;
+
+    if (est == NULL || !isfinite(level)) {
+        return false;
+    }
+
+    r = est->config.level_noise * est->config.level_noise;
+
+    if (!est->initialized) {
+        LevelEstimator_Seed(est, level, r);
+        return true;
+    }
+
+    innovation = level - est->level;
+    s = est->p00 + r;
+
+    // 门限剔除; 连续剔除说明估计已失配 (如补液未建模), 按测量值重新初始化
+    if (innovation * innovation > LEVEL_ESTIMATOR_GATE * LEVEL_ESTIMATOR_GATE * s) {
+        est->rejected_total++;
+        if (++est->rejects <= LEVEL_ESTIMATOR_MAX_REJECTS) {
+            return false;
+        }
+        LevelEstimator_Seed(est, level, r);
+        return true;
+    }
+
+    est->rejects = 0;
+    LevelEstimator_Correct(est, innovation, s);
+    return true;
+}
+
+/**
+ * @brief 浮球开关观测更新
+ * @note 开关只给出液位在其高度之上/之下: 翻转时液位就在开关高度;
+ *       未翻转但估计落在错误一侧时也按开关高度修正, 把估计拉回可行区间
+ */
+void LevelEstimator_UpdateSwitch(level_estimator_t *est, uint8_t index, bool active)
+{
+    float height;
+    float r;
+    bool edge;
+    bool conflict;
+
+    if (est == NULL || index >= LEVEL_ESTIMATOR_SWITCH_COUNT) {
+        return;
+    }
+
+    height = est->config.switch_height[index];
+    if (height < 0.0f) {
+        return;
+    }
+
+    edge = (est->switch_state[index] != LEVEL_ESTIMATOR_SWITCH_UNKNOWN) &&
+           (est->switch_state[index] != (uint8_t)active);
+    est->switch_state[index] = (uint8_t)active;
+    r = est->config.switch_noise * est->config.switch_noise;
+
+    if (!est->initialized) {
+        if (edge) {
+            LevelEstimator_Seed(est, height, r);
+        }
+        return;
+    }
+
+    conflict = active ? (est->level < height) : (est->level > height);
+    if (edge || conflict) {
+        LevelEstimator_Correct(est, height - est->level, est->p00 + r);
+    }
+}
+
+/**
+ * @brief 获取估计结果
+ */
+void LevelEstimator_GetEstimate(const level_estimator_t *est, level_estimate_t *estimate)
+{
+    if (estimate == NULL) {
+        return;
+    }
+
+    memset(estimate, 0, sizeof(level_estimate_t));
+
+    if (est == NULL || !est->initialized) {
+        return;
+    }
+
+    estimate->level = est->level;
+    estimate->flow = est->inflow + est->bias;
+    estimate->level_std = sqrtf(est->p00);
+    estimate->flow_std = sqrtf(est->p11);
+    estimate->valid = true;
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 按一次液位观测初始化 (净流量未知)
+ */
+static void LevelEstimator_Seed(level_estimator_t *est, float level, float variance)
+{
+    est->level = level;
+    est->bias = 0.0f;
+    est->p00 = variance;
+    est->p01 = 0.0f;
+    est->p11 = LEVEL_ESTIMATOR_INIT_FLOW_STD * LEVEL_ESTIMATOR_INIT_FLOW_STD;
+    est->rejects = 0;
+    est->initialized = true;
+}
+
+/**
+ * @brief 液位观测修正 (H = [1 0])
+ * @param est 估计器
+ * @param innovation 新息 z - h
+ * @param s 新息方差 p00 + r
+ * @note K = [p00 p01]/s, P' = P - K·[p00 p01]
+ */
+static void LevelEstimator_Correct(level_estimator_t *est, float innovation, float s)
+{
+    float k0 = est->p00 / s;
+    float k1 = est->p01 / s;
+
+    est->level += k0 * innovation;
+    est->bias += k1 * innovation;
+
+    est->p11 -= k1 * est->p01;
+    est->p01 -= k0 * est->p01;
+    est->p00 -= k0 * est->p00;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,302 @@
+/**
+ ******************************************************************************
+ * @file    loop_kpi.c
+ * @brief   控制回路性能指标(KPI)实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 移出最旧的桶时, 其余样本的时间坐标整体减去该桶时长D0:
+ *   ITAE' = ITAE - itae0 - D0·(IAE - iae0)
+ * 因此ITAE也能O(1)滑动, 不需要保存单个样本.
+ ******************************************************************************
+ */
+
+#include "loop_kpi.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static void LoopKpi_UpdateStep(loop_kpi_t *kpi, float setpoint, float error, float dt);
+static void LoopKpi_NextBucket(loop_kpi_t *kpi);
+static void LoopKpi_Resum(loop_kpi_t *kpi);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化KPI
+ */
+void LoopKpi_Init(loop_kpi_t *kpi, float range, float window_time)
+{
+    if (kpi == NULL) {
+        return;
+    }
+
+    if (range <= 0.0f) {
+        range = 1.0f;
+    }
+    if (window_time <= 0.0f) {
+        window_time = 1.0f;
+    }
+
+    memset(kpi, 0, sizeof(loop_kpi_t));
+    kpi->bucket_time = window_time / (float)LOOP_KPI_BUCKETS;
+    kpi->step_threshold = LOOP_KPI_STEP_THRESHOLD * range;
+    kpi->crossing_band = LOOP_KPI_CROSSING_BAND * range;
+    kpi->count = 1;
+}
+
+/**
+ * @brief 清空窗口和阶跃响应 (保留配置)
+ */
+void LoopKpi_Reset(loop_kpi_t *kpi)
+{
+    float bucket_time;
+    float step_threshold;
+    float crossing_band;
+
+    if (kpi == NULL) {
+        return;
+    }
+
+    bucket_time = kpi->bucket_time;
+    step_threshold = kpi->step_threshold;
+    crossing_band = kpi->crossing_band;
+
+    memset(kpi, 0, sizeof(loop_kpi_t));
+    kpi->bucket_time = bucket_time;
+    kpi->step_threshold = step_threshold;
+    kpi->crossing_band = crossing_band;
+    kpi->count = 1;
+}
+
+/**
+ * @brief 加入一个控制周期的样本
+ */
+void LoopKpi_Update(loop_kpi_t *kpi, float setpoint, float process_value, float dt, bool saturated)
+{
+    loop_kpi_bucket_t *bucket;
+    float error;
+    float weighted;
+    int8_t sign;
+
+    if (kpi == NULL || !(dt > 0.0f) || isnan(setpoint) || isnan(process_value)) {
+        return;
+    }
+
+    error = setpoint - process_value;
+
+    // 1. 阶跃响应
+    LoopKpi_UpdateStep(kpi, setpoint, error, dt);
+
+    // 2. 过零检测 (误差需越过回差才改变符号, 噪声不计入)
+    sign = (error > kpi->crossing_band) ? 1 : ((error < -kpi->crossing_band) ? -1 : 0);
+
+    bucket = &kpi->buckets[kpi->head];
+    if (sign != 0) {
+        if (kpi->error_sign != 0 && sign != kpi->error_sign) {
+            bucket->crossings++;
+            kpi->crossings++;
+        }
+        kpi->error_sign = sign;
+    }
+
+    // 3. 累加到当前桶和窗口合计 (样本时刻取本周期末)
+    weighted = fabsf(error) * dt;
+
+    bucket->duration += dt;
+    bucket->iae += weighted;
+    bucket->ise += error * error * dt;
+    bucket->itae += bucket->duration * weighted;
+    bucket->samples++;
+
+    kpi->window_time += dt;
+    kpi->iae += weighted;
+    kpi->ise += error * error * dt;
+    kpi->itae += kpi->window_time * weighted;
+    kpi->samples++;
+
+    if (saturated) {
+        bucket->saturated_time += dt;
+        kpi->saturated_time += dt;
+    }
+
+    // 4. 当前桶已满则开新桶
+    if (bucket->duration >= kpi->bucket_time) {
+        LoopKpi_NextBucket(kpi);
+    }
+}
+
+/**
+ * @brief 获取窗口平均绝对误差
+ */
+float LoopKpi_GetMeanAbsError(const loop_kpi_t *kpi)
+{
+    if (kpi == NULL || kpi->window_time <= 0.0f) {
+        return 0.0f;
+    }
+
+    return fmaxf(kpi->iae, 0.0f) / kpi->window_time;
+}
+
+/**
+ * @brief 获取KPI结果
+ */
+bool LoopKpi_GetSummary(const loop_kpi_t *kpi, loop_kpi_summary_t *summary)
+{
+    if (summary == NULL) {
+        return false;
+    }
+
+    memset(summary, 0, sizeof(loop_kpi_summary_t));
+    summary->settled = true;
+
+    if (kpi == NULL || kpi->samples == 0 || kpi->window_time <= 0.0f) {
+        return false;
+    }
+
+    // 加减后的微小负值按0处理
+    summary->samples = kpi->samples;
+    summary->window_time = kpi->window_time;
+    summary->iae = fmaxf(kpi->iae, 0.0f);
+    summary->ise = fmaxf(kpi->ise, 0.0f);
+    summary->itae = fmaxf(kpi->itae, 0.0f);
+    summary->mean_abs_error = summary->iae / kpi->window_time;
+    summary->oscillation_index = (float)kpi->crossings * 0.5f;
+    summary->saturation = fminf(fmaxf(kpi->saturated_time / kpi->window_time, 0.0f), 1.0f);
+    summary->step_count = kpi->step_count;
+
+    if (kpi->step_active) {
+        summary->overshoot = kpi->step_peak / kpi->step_size * 100.0f;
+        summary->settling_time = kpi->settling_time;
+        summary->settled = kpi->settled;
+    }
+
+    return true;
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 更新阶跃响应指标
+ * @param kpi KPI对象
+ * @param setpoint 设定值
+ * @param error 误差 (设定值-过程值)
+ * @param dt 采样时间 (秒)
+ */
+static void LoopKpi_UpdateStep(loop_kpi_t *kpi, float setpoint, float error, float dt)
+{
+    float abs_error = fabsf(error);
+    float excursion;
+
+    // 首个样本或设定值阶跃: 重新开始 (幅值不足时不评估响应指标)
+    if (!kpi->primed || fabsf(setpoint - kpi->last_setpoint) > kpi->step_threshold) {
+        kpi->primed = true;
+        kpi->step_active = (abs_error > kpi->step_threshold);
+        kpi->step_size = abs_error;
+        kpi->step_direction = (error >= 0.0f) ? 1.0f : -1.0f;
+        kpi->step_peak = 0.0f;
+        kpi->step_elapsed = 0.0f;
+        kpi->settling_time = 0.0f;
+        kpi->settled = !kpi->step_active;
+
+        if (kpi->step_active) {
+            kpi->step_count++;
+        }
+    }
+    kpi->last_setpoint = setpoint;
+
+    if (!kpi->step_active) {
+        return;
+    }
+
+    kpi->step_elapsed += dt;
+
+    // 过程值沿阶跃方向越过设定值的量
+    excursion = -kpi->step_direction * error;
+    if (excursion > kpi->step_peak) {
+        kpi->step_peak = excursion;
+    }
+
+    if (abs_error > LOOP_KPI_SETTLING_BAND * kpi->step_size) {
+        kpi->settling_time = kpi->step_elapsed;
+        kpi->settled = false;
+    } else {
+        kpi->settled = true;
+    }
+}
+
+/**
+ * @brief 开新桶, 桶环已满时先移出最旧的桶
+ */
+static void LoopKpi_NextBucket(loop_kpi_t *kpi)
+{
+    uint8_t next = (uint8_t)((kpi->head + 1) % LOOP_KPI_BUCKETS);
+
+    if (kpi->count == LOOP_KPI_BUCKETS) {
+        // 环满时下一个桶就是最旧的桶, 其余样本时间坐标前移其时长
+        const loop_kpi_bucket_t *oldest = &kpi->buckets[next];
+
+        kpi->itae -= oldest->itae + oldest->duration * (kpi->iae - oldest->iae);
+        kpi->iae -= oldest->iae;
+        kpi->ise -= oldest->ise;
+        kpi->window_time -= oldest->duration;
+        kpi->saturated_time -= oldest->saturated_time;
+        kpi->samples -= oldest->samples;
+        kpi->crossings -= oldest->crossings;
+    } else {
+        kpi->count++;
+    }
+
+    memset(&kpi->buckets[next], 0, sizeof(loop_kpi_bucket_t));
+    kpi->head = next;
+
+    // 每转一圈重新求和一次 (均摊O(1))
+    if (next == 0) {
+        LoopKpi_Resum(kpi);
+    }
+}
+
+/**
+ * @brief 由各桶重新计算窗口合计
+ */
+static void LoopKpi_Resum(loop_kpi_t *kpi)
+{
+    uint8_t index = (uint8_t)((kpi->head + LOOP_KPI_BUCKETS + 1 - kpi->count) % LOOP_KPI_BUCKETS);
+    float start = 0.0f;
+
+    kpi->window_time = 0.0f;
+    kpi->iae = 0.0f;
+    kpi->ise = 0.0f;
+    kpi->itae = 0.0f;
+    kpi->saturated_time = 0.0f;
+    kpi->samples = 0;
+    kpi->crossings = 0;
+
+    for (uint8_t i = 0; i < kpi->count; i++) {
+        const loop_kpi_bucket_t *bucket = &kpi->buckets[index];
+
+        kpi->itae += start * bucket->iae + bucket->itae;
+        start += bucket->duration;
+
+        kpi->window_time += bucket->duration;
+        kpi->iae += bucket->iae;
+        kpi->ise += bucket->ise;
+        kpi->saturated_time += bucket->saturated_time;
+        kpi->samples += bucket->samples;
+        kpi->crossings += bucket->crossings;
+
+        index = (uint8_t)((index + 1) % LOOP_KPI_BUCKETS);
+    }
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,436 @@
+/**
+ ******************************************************************************
+ * @file    msg_bus.c
+ * @brief   零拷贝发布/订阅消息总线实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 每个内存块由块头和消息体组成, 块头紧邻消息体之前, 由消息体指针
+ * 回退即可找到所属主题和引用计数. 引用计数在临界区内修改.
+ * 内存池在主题既已创建又有第一个订阅者时才分配, 无人订阅的主题不占用堆.
+ * 内存池在临界区外分配, 在临界区内检查并安装; 并发的创建/订阅各自分配时
+ * 只有一个安装成功, 其余的立即释放.
+ ******************************************************************************
+ */
+
+#include "msg_bus.h"
+#include "task.h"
+#include <string.h>
+
+/* ========================================================================== */
+/* 私有宏定义 */
+/* ========================================================================== */
+
+// 块头按8字节对齐, 保证消息体对齐
+#define MSG_BUS_ALIGN(size)             (((size) + 7U) & ~7U)
+#define MSG_BUS_HEADER_SIZE             MSG_BUS_ALIGN(sizeof(msg_bus_block_t))
+
+/* ========================================================================== */
+/* 私有类型 */
+/* ========================================================================== */
+
+// 块头
+typedef struct {
+    uint8_t topic;                  // 所属主题
+    uint8_t refcount;               // 引用计数 (0=空闲)
+    uint8_t allocated;              // 已被申请 (发布前refcount仍为0)
+    uint8_t reserved;
+} msg_bus_block_t;
+
+// 主题
+typedef struct {
+    uint8_t *pool;                  // 内存池
+    uint16_t block_stride;          // 块间距 (字节)
+    msg_bus_subscriber_t subscribers[MSG_BUS_MAX_SUBSCRIBERS];
+    msg_bus_topic_stats_t stats;
+} msg_bus_topic_ctx_t;
+
+/* ========================================================================== */
+/* 私有变量 */
+/* ========================================================================== */
+
+static msg_bus_topic_ctx_t g_topics[MSG_BUS_TOPIC_COUNT];
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static uint8_t *MsgBus_NewPool(const msg_bus_topic_ctx_t *ctx, msg_bus_topic_t topic);
+static bool MsgBus_InstallPool(msg_bus_topic_ctx_t *ctx, uint8_t *pool);
+static BaseType_t MsgBus_EnsurePool(msg_bus_topic_ctx_t *ctx, msg_bus_topic_t topic);
+static msg_bus_block_t *MsgBus_BlockOf(const void *payload);
+static void MsgBus_FreeBlock(msg_bus_block_t *block);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 创建主题并分配内存池
+ */
+BaseType_t MsgBus_CreateTopic(msg_bus_topic_t topic, uint16_t payload_size, uint8_t block_count)
+{
+    msg_bus_topic_ctx_t *ctx;
+    uint32_t stride;
+    bool has_subscribers;
+
+    if (topic >= MSG_BUS_TOPIC_COUNT || payload_size == 0 ||
+        block_count == 0 || block_count > MSG_BUS_MAX_BLOCKS) {
+        return pdFAIL;
+    }
+
+    stride = MSG_BUS_HEADER_SIZE + MSG_BUS_ALIGN((uint32_t)payload_size);
+    if (stride > 0xFFFFU) {
+        return pdFAIL;
+    }
+
+    ctx = &g_topics[topic];
+
+    // 与MsgBus_Subscribe互相可见: 两者都在临界区内先写自己的状态再读对方的
+    taskENTER_CRITICAL();
+    if (ctx->block_stride != 0) {
+        taskEXIT_CRITICAL();
+        return pdFAIL;
+    }
+    ctx->block_stride = (uint16_t)stride;
+    ctx->stats.payload_size = payload_size;
+    ctx->stats.block_count = block_count;
+    has_subscribers = (ctx->stats.subscriber_count > 0);
+    taskEXIT_CRITICAL();
+
+    // 已有订阅者时立即分配内存池
+    if (has_subscribers) {
+        return MsgBus_EnsurePool(ctx, topic);
+    }
+
+    return pdPASS;
+}
+
+/**
+ * @brief 订阅主题
+ */
+msg_bus_subscriber_t *MsgBus_Subscribe(msg_bus_topic_t topic, uint8_t depth)
+{
+    msg_bus_topic_ctx_t *ctx;
+    msg_bus_subscriber_t *sub;
+    QueueHandle_t queue;
+    uint8_t *pool = NULL;
+    bool need_pool;
+
+    if (topic >= MSG_BUS_TOPIC_COUNT || depth == 0) {
+        return NULL;
+    }
+
+    ctx = &g_topics[topic];
+    if (ctx->stats.subscriber_count >= MSG_BUS_MAX_SUBSCRIBERS) {
+        return NULL;
+    }
+
+    // 主题已创建: 先在临界区外备好内存池, 内存不足时不登记订阅者
+    if (ctx->block_stride != 0 && ctx->pool == NULL) {
+        pool = MsgBus_NewPool(ctx, topic);
+        if (pool == NULL) {
+            return NULL;
+        }
+    }
+
+    queue = xQueueCreate(depth, sizeof(void *));
+    if (queue == NULL) {
+        vPortFree(pool);
+        return NULL;
+    }
+
+    taskENTER_CRITICAL();
+    if (ctx->stats.subscriber_count >= MSG_BUS_MAX_SUBSCRIBERS) {
+        taskEXIT_CRITICAL();
+        vQueueDelete(queue);
+        vPortFree(pool);
+        return NULL;
+    }
+    sub = &ctx->subscribers[ctx->stats.subscriber_count];
+    sub->queue = queue;
+    sub->topic = topic;
+    sub->dropped = 0;
+    ctx->stats.subscriber_count++;
+    if (pool != NULL && MsgBus_InstallPool(ctx, pool)) {
+        pool = NULL;
+    }
+    // 检查之后主题才被创建, 且创建者看到的订阅者数为0
+    need_pool = (ctx->block_stride != 0 && ctx->pool == NULL);
+    taskEXIT_CRITICAL();
+
+    // 并发的订阅者或主题创建者已安装内存池
+    if (pool != NULL) {
+        vPortFree(pool);
+    }
+
+    if (need_pool) {
+        MsgBus_EnsurePool(ctx, topic);
+    }
+
+    return sub;
+}
+
+/**
+ * @brief 主题是否有订阅者
+ */
+bool MsgBus_HasSubscribers(msg_bus_topic_t topic)
+{
+    return (topic < MSG_BUS_TOPIC_COUNT) && (g_topics[topic].stats.subscriber_count > 0);
+}
+
+/**
+ * @brief 为发布申请一个消息块
+ */
+void *MsgBus_Alloc(msg_bus_topic_t topic)
+{
+    msg_bus_topic_ctx_t *ctx;
+    msg_bus_block_t *block = NULL;
+
+    if (topic >= MSG_BUS_TOPIC_COUNT) {
+        return NULL;
+    }
+
+    ctx = &g_topics[topic];
+
+    if (ctx->stats.subscriber_count == 0) {
+        ctx->stats.skipped++;
+        return NULL;
+    }
+
+    if (ctx->pool == NULL) {
+        return NULL;
+    }
+
+    taskENTER_CRITICAL();
+    for (uint8_t i = 0; i < ctx->stats.block_count; i++) {
+        msg_bus_block_t *candidate = (msg_bus_block_t *)(ctx->pool + i * ctx->block_stride);
+        if (!candidate->allocated) {
+            candidate->allocated = 1;
+            candidate->refcount = 0;
+            block = candidate;
+            ctx->stats.blocks_in_use++;
+            if (ctx->stats.blocks_in_use > ctx->stats.blocks_peak) {
+                ctx->stats.blocks_peak = ctx->stats.blocks_in_use;
+            }
+            break;
+        }
+    }
+    if (block == NULL) {
+        ctx->stats.alloc_failures++;
+    }
+    taskEXIT_CRITICAL();
+
+    return (block != NULL) ? ((uint8_t *)block + MSG_BUS_HEADER_SIZE) : NULL;
+}
+
+/**
+ * @brief 发布消息块
+ */
+void MsgBus_Publish(void *payload)
+{
+    msg_bus_block_t *block;
+    msg_bus_topic_ctx_t *ctx;
+    uint8_t count;
+
+    if (payload == NULL) {
+        return;
+    }
+
+    block = MsgBus_BlockOf(payload);
+    ctx = &g_topics[block->topic];
+
+    // 先按订阅者数设置引用计数, 投递失败的部分再逐个释放
+    taskENTER_CRITICAL();
+    count = ctx->stats.subscriber_count;
+    block->refcount = count;
+    taskEXIT_CRITICAL();
+
+    if (count == 0) {
+        MsgBus_FreeBlock(block);
+        return;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        msg_bus_subscriber_t *sub = &ctx->subscribers[i];
+
+        if (xQueueSend(sub->queue, &payload, 0) == pdPASS) {
+            ctx->stats.published++;
+        } else {
+            sub->dropped++;
+            ctx->stats.deliver_failures++;
+            MsgBus_Release(payload);
+        }
+    }
+}
+
+/**
+ * @brief 放弃未发布的消息块
+ */
+void MsgBus_Discard(void *payload)
+{
+    if (payload != NULL) {
+        MsgBus_FreeBlock(MsgBus_BlockOf(payload));
+    }
+}
+
+/**
+ * @brief 接收消息
+ */
+const void *MsgBus_Receive(msg_bus_subscriber_t *subscriber, uint32_t timeout_ms)
+{
+    void *payload = NULL;
+
+    if (subscriber == NULL || subscriber->queue == NULL) {
+        return NULL;
+    }
+
+    if (xQueueReceive(subscriber->queue, &payload, pdMS_TO_TICKS(timeout_ms)) != pdPASS) {
+        return NULL;
+    }
+
+    return payload;
+}
+
+/**
+ * @brief 释放接收到的消息
+ */
+void MsgBus_Release(const void *payload)
+{
+    msg_bus_block_t *block;
+    bool last = false;
+
+    if (payload == NULL) {
+        return;
+    }
+
+    block = MsgBus_BlockOf(payload);
+
+    taskENTER_CRITICAL();
+    if (block->refcount > 0) {
+        block->refcount--;
+        last = (block->refcount == 0);
+    }
+    taskEXIT_CRITICAL();
+
+    if (last) {
+        MsgBus_FreeBlock(block);
+    }
+}
+
+/**
+ * @brief 获取主题统计
+ */
+void MsgBus_GetTopicStats(msg_bus_topic_t topic, msg_bus_topic_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    if (topic >= MSG_BUS_TOPIC_COUNT) {
+        memset(stats, 0, sizeof(msg_bus_topic_stats_t));
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = g_topics[topic].stats;
+    taskEXIT_CRITICAL();
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 分配并初始化主题内存池 (临界区外调用, 尚未安装)
+ */
+static uint8_t *MsgBus_NewPool(const msg_bus_topic_ctx_t *ctx, msg_bus_topic_t topic)
+{
+    uint32_t pool_bytes = (uint32_t)ctx->block_stride * ctx->stats.block_count;
+    uint8_t *pool;
+
+    pool = (uint8_t *)pvPortMalloc(pool_bytes);
+    if (pool == NULL) {
+        return NULL;
+    }
+    memset(pool, 0, pool_bytes);
+
+    for (uint8_t i = 0; i < ctx->stats.block_count; i++) {
+        ((msg_bus_block_t *)(pool + i * ctx->block_stride))->topic = (uint8_t)topic;
+    }
+
+    return pool;
+}
+
+/**
+ * @brief 安装内存池 (临界区内调用)
+ * @return true=已安装, false=已有内存池, 调用者负责释放pool
+ */
+static bool MsgBus_InstallPool(msg_bus_topic_ctx_t *ctx, uint8_t *pool)
+{
+    if (ctx->pool != NULL) {
+        return false;
+    }
+
+    ctx->stats.pool_bytes = (uint32_t)ctx->block_stride * ctx->stats.block_count;
+    ctx->pool = pool;
+
+    return true;
+}
+
+/**
+ * @brief 确保主题已有内存池
+ */
+static BaseType_t MsgBus_EnsurePool(msg_bus_topic_ctx_t *ctx, msg_bus_topic_t topic)
+{
+    uint8_t *pool;
+    bool installed;
+
+    if (ctx->pool != NULL) {
+        return pdPASS;
+    }
+
+    pool = MsgBus_NewPool(ctx, topic);
+    if (pool == NULL) {
+        return pdFAIL;
+    }
+
+    taskENTER_CRITICAL();
+    installed = MsgBus_InstallPool(ctx, pool);
+    taskEXIT_CRITICAL();
+
+    if (!installed) {
+        vPortFree(pool);
+    }
+
+    return pdPASS;
+}
+
+/**
+ * @brief 由消息体指针取得块头
+ */
+static msg_bus_block_t *MsgBus_BlockOf(const void *payload)
+{
+    return (msg_bus_block_t *)((uint8_t *)payload - MSG_BUS_HEADER_SIZE);
+}
+
+/**
+ * @brief 归还内存块
+ */
+static void MsgBus_FreeBlock(msg_bus_block_t *block)
+{
+    msg_bus_topic_ctx_t *ctx = &g_topics[block->topic];
+
+    taskENTER_CRITICAL();
+    if (block->allocated) {
+        block->allocated = 0;
+        block->refcount = 0;
+        ctx->stats.blocks_in_use--;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
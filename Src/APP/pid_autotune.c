@@ -0,0 +1,353 @@
+/**
+ ******************************************************************************
+ * @file    pid_autotune.c
+ * @brief   继电反馈PID自整定实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * FOPDT过程 K·e^(-θs)/(τs+1) 在幅值d、回差ε的继电器下的精确极限环
+ * (偏差变量, 切换后θ内过程仍受原输出作用):
+ *   a    = Kd - (Kd - ε)·e^(-θ/τ)              (过程值振幅)
+ *   Tu/2 = θ + τ·ln((Kd + a) / (Kd - ε))       (半周期)
+ * θ直接由切换到极值的时间测得, 由第一式解出Kd(τ)代入第二式, 对τ二分
+ * 求解, 再得K. Ku/Tu由拟合模型在相位-π处求得 (ωθ + atan(ωτ) = π).
+ * 描述函数近似 Ku = 4d/(π·sqrt(a² - ε²)) 对滞后占优过程误差可达30%以上,
+ * 只在模型拟合失败时使用.
+ ******************************************************************************
+ */
+
+#include "pid_autotune.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有定义 */
+/* ========================================================================== */
+
+#define PID_AUTOTUNE_PI                 3.14159265f
+#define PID_AUTOTUNE_TAU_RATIO_MIN      0.01f       // τ/θ搜索下限
+#define PID_AUTOTUNE_TAU_RATIO_MAX      1000.0f     // τ/θ搜索上限
+#define PID_AUTOTUNE_BISECT_STEPS       40          // 二分次数
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static void PidAutotune_Switch(pid_autotune_t *tuner, float process_value, bool to_high);
+static bool PidAutotune_Converged(const pid_autotune_t *tuner);
+static void PidAutotune_Finish(pid_autotune_t *tuner);
+static void PidAutotune_Fail(pid_autotune_t *tuner, pid_autotune_error_t error);
+static float PidAutotune_HalfPeriod(float tau, float dead_time, float a, float eps, float *kd);
+static bool PidAutotune_FitModel(pid_autotune_result_t *result, float d, float eps);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 开始继电试验
+ */
+bool PidAutotune_Start(pid_autotune_t *tuner, const pid_autotune_config_t *config)
+{
+    if (tuner == NULL || config == NULL) {
+        return false;
+    }
+
+    if (config->amplitude <= 0.0f || config->hysteresis < 0.0f || config->sample_time <= 0.0f ||
+        config->max_deviation <= config->hysteresis || config->max_switches < 2 * (PID_AUTOTUNE_MIN_PERIODS + 1)) {
+        return false;
+    }
+
+    memset(tuner, 0, sizeof(pid_autotune_t));
+    tuner->config = *config;
+    tuner->state = PID_AUTOTUNE_RUNNING;
+
+    // 从高输出开始, 过程值先向设定值上方运动
+    tuner->relay_high = true;
+    tuner->pv_max = -INFINITY;
+    tuner->pv_min = INFINITY;
+
+    return true;
+}
+
+/**
+ * @brief 运行一拍
+ */
+float PidAutotune_Update(pid_autotune_t *tuner, float process_value)
+{
+    const pid_autotune_config_t *config;
+    float deviation;
+
+    if (tuner == NULL) {
+        return 0.0f;
+    }
+
+    config = &tuner->config;
+
+    if (tuner->state != PID_AUTOTUNE_RUNNING) {
+        return config->bias;
+    }
+
+    tuner->tick++;
+    deviation = process_value - config->setpoint;
+
+    if (fabsf(deviation) > config->max_deviation) {
+        PidAutotune_Fail(tuner, PID_AUTOTUNE_ERR_DEVIATION);
+        return config->bias;
+    }
+
+    // 振幅与纯滞后跟踪
+    if (process_value > tuner->pv_max) tuner->pv_max = process_value;
+    if (process_value < tuner->pv_min) tuner->pv_min = process_value;
+
+    if (tuner->relay_high ? (process_value < tuner->extreme) : (process_value > tuner->extreme)) {
+        tuner->extreme = process_value;
+        tuner->extreme_tick = tuner->tick;
+    }
+
+    // 带回差的继电器
+    if (tuner->relay_high && deviation > config->hysteresis) {
+        PidAutotune_Switch(tuner, process_value, false);
+    } else if (!tuner->relay_high && deviation < -config->hysteresis) {
+        PidAutotune_Switch(tuner, process_value, true);
+    } else if ((float)(tuner->tick - tuner->switch_tick) * config->sample_time > config->max_half_period) {
+        PidAutotune_Fail(tuner, PID_AUTOTUNE_ERR_NO_OSCILLATION);
+        return config->bias;
+    }
+
+    if (tuner->state != PID_AUTOTUNE_RUNNING) {
+        return config->bias;
+    }
+
+    return tuner->relay_high ? (config->bias + config->amplitude) : (config->bias - config->amplitude);
+}
+
+/**
+ * @brief 中止试验
+ */
+void PidAutotune_Abort(pid_autotune_t *tuner)
+{
+    if (tuner != NULL && tuner->state == PID_AUTOTUNE_RUNNING) {
+        PidAutotune_Fail(tuner, PID_AUTOTUNE_ERR_ABORTED);
+    }
+}
+
+/**
+ * @brief 按规则计算PID参数
+ */
+bool PidAutotune_ComputeGains(const pid_autotune_result_t *result, pid_autotune_rule_t rule,
+                              float *kp, float *ki, float *kd)
+{
+    float p, ti, td;
+
+    if (result == NULL || kp == NULL || ki == NULL || kd == NULL ||
+        result->ku <= 0.0f || result->tu <= 0.0f) {
+        return false;
+    }
+
+    switch (rule) {
+        case PID_AUTOTUNE_RULE_ZN_PID:
+            p = 0.6f * result->ku;
+            ti = 0.5f * result->tu;
+            td = 0.125f * result->tu;
+            break;
+
+        case PID_AUTOTUNE_RULE_ZN_PI:
+            p = 0.45f * result->ku;
+            ti = result->tu / 1.2f;
+            td = 0.0f;
+            break;
+
+        case PID_AUTOTUNE_RULE_SIMC_PI:
+            if (result->gain <= 0.0f || result->time_constant <= 0.0f || result->dead_time <= 0.0f) {
+                return false;
+            }
+            p = result->time_constant / (2.0f * result->gain * result->dead_time);
+            ti = fminf(result->time_constant, 8.0f * result->dead_time);
+            td = 0.0f;
+            break;
+
+        default:
+            return false;
+    }
+
+    *kp = p;
+    *ki = p / ti;
+    *kd = p * td;
+
+    return true;
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 继电器切换
+ * @param tuner 自整定器
+ * @param process_value 当前过程值
+ * @param to_high true=切换到高输出
+ */
+static void PidAutotune_Switch(pid_autotune_t *tuner, float process_value, bool to_high)
+{
+    const float dt = tuner->config.sample_time;
+
+    // 上半个周期的纯滞后 (跳过首个周期的过渡过程)
+    if (tuner->periods >= 1) {
+        tuner->dead_time_sum += (float)(tuner->extreme_tick - tuner->switch_tick) * dt;
+        tuner->dead_time_count++;
+    }
+
+    // 向上切换: 一个完整周期结束
+    if (to_high) {
+        if (tuner->rise_tick != 0) {
+            tuner->period[0] = tuner->period[1];
+            tuner->peak[0] = tuner->peak[1];
+            tuner->period[1] = (float)(tuner->tick - tuner->rise_tick) * dt;
+            tuner->peak[1] = 0.5f * (tuner->pv_max - tuner->pv_min);
+            tuner->periods++;
+        }
+        tuner->rise_tick = tuner->tick;
+        tuner->pv_max = process_value;
+        tuner->pv_min = process_value;
+    }
+
+    tuner->relay_high = to_high;
+    tuner->switch_tick = tuner->tick;
+    tuner->extreme = process_value;
+    tuner->extreme_tick = tuner->tick;
+    tuner->switches++;
+
+    if (to_high && PidAutotune_Converged(tuner)) {
+        PidAutotune_Finish(tuner);
+    } else if (tuner->switches >= tuner->config.max_switches) {
+        PidAutotune_Fail(tuner, PID_AUTOTUNE_ERR_TIMEOUT);
+    }
+}
+
+/**
+ * @brief 判断极限环是否稳定
+ */
+static bool PidAutotune_Converged(const pid_autotune_t *tuner)
+{
+    if (tuner->periods < PID_AUTOTUNE_MIN_PERIODS || tuner->dead_time_count == 0) {
+        return false;
+    }
+
+    return fabsf(tuner->period[1] - tuner->period[0]) <= PID_AUTOTUNE_TOLERANCE * tuner->period[1] &&
+           fabsf(tuner->peak[1] - tuner->peak[0]) <= PID_AUTOTUNE_TOLERANCE * tuner->peak[1];
+}
+
+/**
+ * @brief 由极限环辨识FOPDT模型并计算Ku/Tu
+ */
+static void PidAutotune_Finish(pid_autotune_t *tuner)
+{
+    pid_autotune_result_t *result = &tuner->result;
+    const float d = tuner->config.amplitude;
+    const float eps = tuner->config.hysteresis;
+    float a;
+
+    a = 0.5f * (tuner->peak[0] + tuner->peak[1]);
+    if (a <= eps) {
+        PidAutotune_Fail(tuner, PID_AUTOTUNE_ERR_AMPLITUDE);
+        return;
+    }
+
+    result->amplitude = a;
+    result->tu = 0.5f * (tuner->period[0] + tuner->period[1]);
+    result->dead_time = tuner->dead_time_sum / (float)tuner->dead_time_count;
+
+    if (!PidAutotune_FitModel(result, d, eps)) {
+        // 纯滞后测量不可信: 描述函数近似, 只给出Ku/Tu
+        result->ku = 4.0f * d / (PID_AUTOTUNE_PI * sqrtf(a * a - eps * eps));
+        result->gain = 0.0f;
+        result->time_constant = 0.0f;
+    }
+
+    tuner->state = PID_AUTOTUNE_DONE;
+}
+
+/**
+ * @brief FOPDT继电极限环的半周期
+ * @param tau 时间常数
+ * @param dead_time 纯滞后
+ * @param a 过程值振幅
+ * @param eps 回差
+ * @param kd 输出K·d
+ * @return 半周期 (秒)
+ */
+static float PidAutotune_HalfPeriod(float tau, float dead_time, float a, float eps, float *kd)
+{
+    const float x = expf(-dead_time / tau);
+
+    *kd = (a - eps * x) / (1.0f - x);
+    return dead_time + tau * logf((*kd + a) / (*kd - eps));
+}
+
+/**
+ * @brief 拟合FOPDT模型, 并在相位-π处求Ku/Tu
+ * @param result 输入a/tu/dead_time, 输出gain/time_constant/ku/tu
+ * @param d 继电幅值
+ * @param eps 回差
+ * @return true=成功
+ */
+static bool PidAutotune_FitModel(pid_autotune_result_t *result, float d, float eps)
+{
+    const float theta = result->dead_time;
+    const float half = 0.5f * result->tu;
+    float lo, hi, mid, kd, omega;
+
+    if (theta <= 0.0f || half <= theta) {
+        return false;
+    }
+
+    // 半周期随τ单调增加, 在对数尺度上二分
+    lo = PID_AUTOTUNE_TAU_RATIO_MIN * theta;
+    hi = PID_AUTOTUNE_TAU_RATIO_MAX * theta;
+    for (uint8_t i = 0; i < PID_AUTOTUNE_BISECT_STEPS; i++) {
+        mid = sqrtf(lo * hi);
+        if (PidAutotune_HalfPeriod(mid, theta, result->amplitude, eps, &kd) < half) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+
+    mid = sqrtf(lo * hi);
+    PidAutotune_HalfPeriod(mid, theta, result->amplitude, eps, &kd);
+    result->time_constant = mid;
+    result->gain = kd / d;
+
+    // 临界频率: ωθ + atan(ωτ) = π, ω∈(0, π/θ)
+    lo = 0.0f;
+    hi = PID_AUTOTUNE_PI / theta;
+    for (uint8_t i = 0; i < PID_AUTOTUNE_BISECT_STEPS; i++) {
+        omega = 0.5f * (lo + hi);
+        if (omega * theta + atanf(omega * mid) < PID_AUTOTUNE_PI) {
+            lo = omega;
+        } else {
+            hi = omega;
+        }
+    }
+
+    omega = 0.5f * (lo + hi);
+    result->tu = 2.0f * PID_AUTOTUNE_PI / omega;
+    result->ku = sqrtf(1.0f + omega * omega * mid * mid) / result->gain;
+
+    return true;
+}
+
+/**
+ * @brief 试验失败
+ */
+static void PidAutotune_Fail(pid_autotune_t *tuner, pid_autotune_error_t error)
+{
+    tuner->state = PID_AUTOTUNE_FAILED;
+    tuner->error = error;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,193 @@
+/**
+ ******************************************************************************
+ * @file    pid_batch.c
+ * @brief   批量PID计算引擎实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "pid_batch.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static void PidBatch_SetBit(uint32_t *mask, uint8_t index, bool value);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化批量PID
+ */
+void PidBatch_Init(pid_batch_t *batch)
+{
+    if (batch == NULL) {
+        return;
+    }
+
+    memset(batch, 0, sizeof(pid_batch_t));
+}
+
+/**
+ * @brief 设置单个回路参数
+ */
+void PidBatch_SetParams(pid_batch_t *batch, uint8_t index, const pid_params_t *params)
+{
+    if (batch == NULL || params == NULL || index >= PID_BATCH_MAX_LOOPS) {
+        return;
+    }
+
+    batch->kp[index] = params->kp;
+    batch->ki[index] = params->ki;
+    batch->kd[index] = params->kd;
+    batch->output_min[index] = params->output_min;
+    batch->output_max[index] = params->output_max;
+    batch->integral_min[index] = params->integral_min;
+    batch->integral_max[index] = params->integral_max;
+    batch->derivative_filter[index] = params->derivative_filter;
+    batch->deadband[index] = params->deadband;
+    batch->sample_time[index] = params->sample_time;
+    batch->inv_sample_time[index] = (params->sample_time > 0.0f) ? (1.0f / params->sample_time) : 0.0f;
+
+    PidBatch_SetBit(&batch->enabled_mask, index, params->enabled);
+    PidBatch_SetBit(&batch->integral_mask, index, params->integral_enabled);
+    PidBatch_SetBit(&batch->derivative_mask, index, params->derivative_enabled);
+    PidBatch_SetBit(&batch->anti_windup_mask, index, params->anti_windup_enabled);
+}
+
+/**
+ * @brief 复位单个回路状态
+ */
+void PidBatch_Reset(pid_batch_t *batch, uint8_t index)
+{
+    if (batch == NULL || index >= PID_BATCH_MAX_LOOPS) {
+        return;
+    }
+
+    batch->integral[index] = 0.0f;
+    batch->last_error[index] = 0.0f;
+    batch->filtered_derivative[index] = 0.0f;
+    batch->error[index] = 0.0f;
+    batch->output[index] = 0.0f;
+    PidBatch_SetBit(&batch->primed_mask, index, false);
+    PidBatch_SetBit(&batch->deadband_mask, index, false);
+    PidBatch_SetBit(&batch->saturated_mask, index, false);
+}
+
+/**
+ * @brief 设置单个回路本次计算的实际采样间隔
+ */
+void PidBatch_SetElapsed(pid_batch_t *batch, uint8_t index, float elapsed)
+{
+    if (batch == NULL || index >= PID_BATCH_MAX_LOOPS || elapsed <= 0.0f ||
+        elapsed == batch->sample_time[index]) {
+        return;
+    }
+
+    batch->sample_time[index] = elapsed;
+    batch->inv_sample_time[index] = 1.0f / elapsed;
+}
+
+/**
+ * @brief 计算一个控制周期
+ */
+void PidBatch_Execute(pid_batch_t *batch, uint32_t active_mask)
+{
+    uint32_t run_mask;
+    uint32_t deadband_mask = 0;
+    uint32_t saturated_mask = 0;
+
+    if (batch == NULL) {
+        return;
+    }
+
+    // 激活但PID未使能的回路: 输出0, 状态不变
+    run_mask = active_mask & batch->enabled_mask;
+    for (uint8_t i = 0; i < PID_BATCH_MAX_LOOPS; i++) {
+        if ((active_mask & ~run_mask) & (1UL << i)) {
+            batch->output[i] = 0.0f;
+        }
+    }
+
+    for (uint8_t i = 0; i < PID_BATCH_MAX_LOOPS; i++) {
+        const uint32_t bit = 1UL << i;
+
+        if ((run_mask & bit) == 0) {
+            continue;
+        }
+
+        const float raw_error = batch->setpoint[i] - batch->process_value[i];
+        const bool in_deadband = fabsf(raw_error) < batch->deadband[i];
+        const float error = in_deadband ? 0.0f : raw_error;
+        float output;
+
+        const bool use_integral = ((batch->integral_mask & bit) != 0) && !in_deadband;
+        const bool use_derivative = (batch->derivative_mask & batch->primed_mask & bit) != 0;
+        float integral = batch->integral[i];
+        float filtered = batch->filtered_derivative[i];
+
+        // 积分 (限幅顺序与原实现一致: 先上限后下限)
+        float integral_next = integral + error * batch->sample_time[i];
+        integral_next = (integral_next > batch->integral_max[i]) ? batch->integral_max[i] : integral_next;
+        integral_next = (integral_next < batch->integral_min[i]) ? batch->integral_min[i] : integral_next;
+        integral = use_integral ? integral_next : integral;
+
+        // 微分 (一阶低通)
+        const float alpha = batch->derivative_filter[i];
+        const float derivative = (error - batch->last_error[i]) * batch->inv_sample_time[i];
+        const float filtered_next = alpha * derivative + (1.0f - alpha) * filtered;
+        filtered = use_derivative ? filtered_next : filtered;
+
+        const float p_term = batch->kp[i] * error;
+        const float i_term = use_integral ? batch->ki[i] * integral : 0.0f;
+        const float d_term = use_derivative ? batch->kd[i] * filtered : 0.0f;
+
+        output = p_term + i_term + d_term + batch->feedforward[i];
+
+        // 输出限幅, 饱和时回退本周期积分
+        const bool sat_high = output > batch->output_max[i];
+        const bool sat_low = output < batch->output_min[i];
+        output = sat_high ? batch->output_max[i] : (sat_low ? batch->output_min[i] : output);
+
+        if ((sat_high || sat_low) && (batch->anti_windup_mask & batch->integral_mask & bit)) {
+            integral -= error * batch->sample_time[i];
+        }
+        saturated_mask |= (sat_high || sat_low) ? bit : 0;
+
+        batch->integral[i] = integral;
+        batch->filtered_derivative[i] = filtered;
+
+        deadband_mask |= in_deadband ? bit : 0;
+        batch->last_error[i] = error;
+        batch->error[i] = raw_error;
+        batch->output[i] = output;
+    }
+
+    batch->primed_mask |= run_mask;
+    batch->deadband_mask = (batch->deadband_mask & ~run_mask) | deadband_mask;
+    batch->saturated_mask = (batch->saturated_mask & ~run_mask) | saturated_mask;
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 设置/清除位图中的一位
+ */
+static void PidBatch_SetBit(uint32_t *mask, uint8_t index, bool value)
+{
+    if (value) {
+        *mask |= (1UL << index);
+    } else {
+        *mask &= ~(1UL << index);
+    }
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,176 @@
+/**
+ ******************************************************************************
+ * @file    sensor_calib.c
+ * @brief   传感器多点标定拟合实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "sensor_calib.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有宏定义 */
+/* ========================================================================== */
+
+#define CALIB_PIVOT_MIN                 1.0e-9  // 消元主元下限 (归一化后), 低于此视为奇异
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static bool SensorCalib_Solve(double a[SENSOR_CALIB_COEFF_COUNT][SENSOR_CALIB_COEFF_COUNT + 1], uint8_t n);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 拟合标定系数
+ */
+bool SensorCalib_Fit(const float *x, const float *y, uint8_t count, uint8_t order,
+                     float *coeffs, float *rms)
+{
+    double a[SENSOR_CALIB_COEFF_COUNT][SENSOR_CALIB_COEFF_COUNT + 1];
+    double x_min, x_max, center, half_span;
+    double c[SENSOR_CALIB_COEFF_COUNT] = {0.0, 0.0, 0.0};
+    double sum_sq = 0.0;
+    uint8_t n = (uint8_t)(order + 1);
+
+    if (x == NULL || y == NULL || coeffs == NULL || order > SENSOR_CALIB_MAX_ORDER ||
+        count < n || count > SENSOR_CALIB_MAX_POINTS) {
+        return false;
+    }
+
+    if (order == 0) {
+        // 零点修正: 保留高次项, c0取残差均值
+        double sum = 0.0;
+        for (uint8_t i = 0; i < count; i++) {
+            sum += (double)y[i] - ((double)coeffs[2] * x[i] + (double)coeffs[1]) * x[i];
+        }
+        c[0] = sum / count;
+        c[1] = coeffs[1];
+        c[2] = coeffs[2];
+    } else {
+        // 归一化 u = (x - center) / half_span
+        x_min = x_max = x[0];
+        for (uint8_t i = 1; i < count; i++) {
+            if (x[i] < x_min) x_min = x[i];
+            if (x[i] > x_max) x_max = x[i];
+        }
+        center = 0.5 * (x_max + x_min);
+        half_span = 0.5 * (x_max - x_min);
+        if (!(half_span > 0.0)) {
+            return false;
+        }
+
+        // 正规方程 (A^T A) c = A^T y
+        memset(a, 0, sizeof(a));
+        for (uint8_t i = 0; i < count; i++) {
+            double u = ((double)x[i] - center) / half_span;
+            double pw[SENSOR_CALIB_COEFF_COUNT];
+
+            pw[0] = 1.0;
+            for (uint8_t k = 1; k < n; k++) {
+                pw[k] = pw[k - 1] * u;
+            }
+            for (uint8_t r = 0; r < n; r++) {
+                for (uint8_t k = 0; k < n; k++) {
+                    a[r][k] += pw[r] * pw[k];
+                }
+                a[r][n] += pw[r] * y[i];
+            }
+        }
+
+        if (!SensorCalib_Solve(a, n)) {
+            return false;
+        }
+
+        // 换回原始x: d0 + d1*u + d2*u^2, u = (x - center) / half_span
+        {
+            double d0 = a[0][n];
+            double d1 = a[1][n] / half_span;
+            double d2 = (n > 2) ? (a[2][n] / (half_span * half_span)) : 0.0;
+
+            c[2] = d2;
+            c[1] = d1 - 2.0 * d2 * center;
+            c[0] = d0 - d1 * center + d2 * center * center;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        double e = (c[2] * x[i] + c[1]) * x[i] + c[0] - y[i];
+        sum_sq += e * e;
+    }
+
+    coeffs[0] = (float)c[0];
+    coeffs[1] = (float)c[1];
+    coeffs[2] = (float)c[2];
+
+    if (rms != NULL) {
+        *rms = (float)sqrt(sum_sq / count);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 计算标定值
+ */
+float SensorCalib_Apply(const float *coeffs, float x)
+{
+    return (coeffs[2] * x + coeffs[1]) * x + coeffs[0];
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 列主元高斯消元, 解存于增广矩阵最后一列
+ * @param a 增广矩阵 (n行n+1列)
+ * @param n 未知数个数
+ * @return true=成功, false=奇异
+ */
+static bool SensorCalib_Solve(double a[SENSOR_CALIB_COEFF_COUNT][SENSOR_CALIB_COEFF_COUNT + 1], uint8_t n)
+{
+    for (uint8_t col = 0; col < n; col++) {
+        uint8_t pivot = col;
+
+        for (uint8_t r = (uint8_t)(col + 1); r < n; r++) {
+            if (fabs(a[r][col]) > fabs(a[pivot][col])) {
+                pivot = r;
+            }
+        }
+        if (fabs(a[pivot][col]) < CALIB_PIVOT_MIN * fabs(a[0][0])) {
+            return false;
+        }
+        if (pivot != col) {
+            for (uint8_t k = 0; k <= n; k++) {
+                double t = a[col][k];
+                a[col][k] = a[pivot][k];
+                a[pivot][k] = t;
+            }
+        }
+
+        for (uint8_t r = 0; r < n; r++) {
+            if (r != col) {
+                double f = a[r][col] / a[col][col];
+                for (uint8_t k = col; k <= n; k++) {
+                    a[r][k] -= f * a[col][k];
+                }
+            }
+        }
+    }
+
+    for (uint8_t r = 0; r < n; r++) {
+        a[r][n] /= a[r][r];
+    }
+
+    return true;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,330 @@
+/**
+ ******************************************************************************
+ * @file    sensor_filter.c
+ * @brief   传感器滤波链实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "sensor_filter.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static void SensorFilter_PrimeStage(sensor_filter_stage_t *stage, float value);
+static float SensorFilter_ProcessStage(sensor_filter_stage_t *stage, float value);
+static float SensorFilter_BiquadDcGain(const float *coeffs);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 检查滤波链配置
+ */
+bool SensorFilter_CheckConfig(const sensor_filter_config_t *config)
+{
+    if (config == NULL || config->stage_count > SENSOR_FILTER_MAX_STAGES) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < config->stage_count; i++) {
+        const sensor_filter_stage_config_t *stage = &config->stages[i];
+
+        switch (stage->type) {
+            case SENSOR_FILTER_NONE:
+                break;
+
+            case SENSOR_FILTER_MOVING_AVERAGE:
+                if (stage->length < 1 || stage->length > SENSOR_FILTER_MA_MAX_LENGTH) {
+                    return false;
+                }
+                break;
+
+            case SENSOR_FILTER_EXPONENTIAL:
+                if (!(stage->alpha > 0.0f && stage->alpha <= 1.0f)) {
+                    return false;
+                }
+                break;
+
+            case SENSOR_FILTER_MEDIAN:
+                if (stage->length < 1 || stage->length > SENSOR_FILTER_MEDIAN_MAX_LENGTH ||
+                    (stage->length % 2) == 0) {
+                    return false;
+                }
+                break;
+
+            case SENSOR_FILTER_BIQUAD:
+                if (stage->length < 1 || stage->length > SENSOR_FILTER_BIQUAD_MAX_SECTIONS) {
+                    return false;
+                }
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 按配置初始化(复位)滤波链
+ */
+bool SensorFilter_Init(sensor_filter_t *filter, const sensor_filter_config_t *config)
+{
+    bool valid;
+
+    if (filter == NULL) {
+        return false;
+    }
+
+    memset(filter, 0, sizeof(sensor_filter_t));
+
+    valid = (config == NULL) || SensorFilter_CheckConfig(config);
+    if (config == NULL || !valid) {
+        return valid;
+    }
+
+    filter->stage_count = config->stage_count;
+
+    for (uint8_t i = 0; i < config->stage_count; i++) {
+        sensor_filter_stage_t *stage = &filter->stages[i];
+
+        stage->config = config->stages[i];
+
+        if (stage->config.type == SENSOR_FILTER_BIQUAD) {
+            // 系数保存在本级配置中, 实例直接引用
+            arm_biquad_cascade_df1_init_f32(&stage->s.biquad.instance, stage->config.length,
+                                            stage->config.coeffs, stage->s.biquad.state);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 处理一个样本
+ */
+float SensorFilter_Process(sensor_filter_t *filter, float value)
+{
+    if (filter == NULL) {
+        return value;
+    }
+
+    // 非有限样本不进入各级状态, 保持上一次输出
+    if (!isfinite(value)) {
+        filter->rejected++;
+        return filter->primed ? filter->output : value;
+    }
+
+    filter->samples++;
+
+    if (!filter->primed) {
+        filter->primed = true;
+        for (uint8_t i = 0; i < filter->stage_count; i++) {
+            SensorFilter_PrimeStage(&filter->stages[i], value);
+            if (filter->stages[i].config.type == SENSOR_FILTER_BIQUAD) {
+                value = filter->stages[i].s.biquad.state[4 * (filter->stages[i].config.length - 1) + 2];
+            }
+        }
+        filter->output = value;
+        return value;
+    }
+
+    for (uint8_t i = 0; i < filter->stage_count; i++) {
+        value = SensorFilter_ProcessStage(&filter->stages[i], value);
+    }
+
+    filter->output = value;
+    return value;
+}
+
+/**
+ * @brief 设置所有指数滤波级的系数
+ */
+void SensorFilter_SetExponentialAlpha(sensor_filter_t *filter, float alpha)
+{
+    if (filter == NULL || !(alpha > 0.0f && alpha <= 1.0f)) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < filter->stage_count; i++) {
+        if (filter->stages[i].config.type == SENSOR_FILTER_EXPONENTIAL) {
+            filter->stages[i].config.alpha = alpha;
+        }
+    }
+}
+
+/**
+ * @brief 计算二阶巴特沃斯低通双二阶系数
+ */
+bool SensorFilter_DesignLowpass(float cutoff_hz, float sample_hz, float *coeffs)
+{
+    float k, k2, norm;
+
+    if (coeffs == NULL || !(cutoff_hz > 0.0f) || !(cutoff_hz < sample_hz * 0.5f)) {
+        return false;
+    }
+
+    // 预畸变后的模拟截止频率, Q = 1/sqrt(2)
+    k = tanf(PI * cutoff_hz / sample_hz);
+    k2 = k * k;
+    norm = 1.0f / (1.0f + 1.41421356f * k + k2);
+
+    coeffs[0] = k2 * norm;
+    coeffs[1] = 2.0f * coeffs[0];
+    coeffs[2] = coeffs[0];
+    // CMSIS差分方程中反馈系数取正号
+    coeffs[3] = -2.0f * (k2 - 1.0f) * norm;
+    coeffs[4] = -(1.0f - 1.41421356f * k + k2) * norm;
+
+    return true;
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 用首个样本把一级滤波预置为稳态
+ * @note 双二阶级的稳态输出 = 输入 * 直流增益, 由调用者从状态中取出
+ */
+static void SensorFilter_PrimeStage(sensor_filter_stage_t *stage, float value)
+{
+    uint8_t length = stage->config.length;
+
+    switch (stage->config.type) {
+        case SENSOR_FILTER_MOVING_AVERAGE:
+            for (uint8_t i = 0; i < length; i++) {
+                stage->s.ma.buffer[i] = value;
+            }
+            stage->s.ma.sum = value * (float)length;
+            stage->s.ma.index = 0;
+            break;
+
+        case SENSOR_FILTER_EXPONENTIAL:
+            stage->s.ema.value = value;
+            break;
+
+        case SENSOR_FILTER_MEDIAN:
+            for (uint8_t i = 0; i < length; i++) {
+                stage->s.median.window[i] = value;
+                stage->s.median.sorted[i] = value;
+            }
+            stage->s.median.index = 0;
+            break;
+
+        case SENSOR_FILTER_BIQUAD:
+            // 逐节预置DF1状态 {x[n-1], x[n-2], y[n-1], y[n-2]}
+            for (uint8_t i = 0; i < length; i++) {
+                float *state = &stage->s.biquad.state[4 * i];
+                float output = value * SensorFilter_BiquadDcGain(&stage->config.coeffs[5 * i]);
+
+                state[0] = value;
+                state[1] = value;
+                state[2] = output;
+                state[3] = output;
+                value = output;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 一级滤波处理一个样本
+ */
+static float SensorFilter_ProcessStage(sensor_filter_stage_t *stage, float value)
+{
+    uint8_t length = stage->config.length;
+    float output = value;
+
+    switch (stage->config.type) {
+        case SENSOR_FILTER_MOVING_AVERAGE: {
+            uint8_t index = stage->s.ma.index;
+
+            stage->s.ma.sum += value - stage->s.ma.buffer[index];
+            stage->s.ma.buffer[index] = value;
+            index = (uint8_t)((index + 1) % length);
+            stage->s.ma.index = index;
+
+            // 每绕一圈重算累加和, 防止递推舍入误差累积
+            if (index == 0) {
+                float sum = 0.0f;
+                for (uint8_t i = 0; i < length; i++) {
+                    sum += stage->s.ma.buffer[i];
+                }
+                stage->s.ma.sum = sum;
+            }
+
+            output = stage->s.ma.sum / (float)length;
+            break;
+        }
+
+        case SENSOR_FILTER_EXPONENTIAL:
+            stage->s.ema.value += stage->config.alpha * (value - stage->s.ema.value);
+            output = stage->s.ema.value;
+            break;
+
+        case SENSOR_FILTER_MEDIAN: {
+            float *sorted = stage->s.median.sorted;
+            float oldest = stage->s.median.window[stage->s.median.index];
+            uint8_t pos = 0;
+
+            stage->s.median.window[stage->s.median.index] = value;
+            stage->s.median.index = (uint8_t)((stage->s.median.index + 1) % length);
+
+            // 在有序窗口中删除最旧样本
+            while (pos < length - 1 && sorted[pos] != oldest) {
+                pos++;
+            }
+            for (; pos < length - 1; pos++) {
+                sorted[pos] = sorted[pos + 1];
+            }
+
+            // 插入新样本
+            pos = length - 1;
+            while (pos > 0 && sorted[pos - 1] > value) {
+                sorted[pos] = sorted[pos - 1];
+                pos--;
+            }
+            sorted[pos] = value;
+
+            output = sorted[length / 2];
+            break;
+        }
+
+        case SENSOR_FILTER_BIQUAD:
+            arm_biquad_cascade_df1_f32(&stage->s.biquad.instance, &value, &output, 1);
+            break;
+
+        default:
+            break;
+    }
+
+    return output;
+}
+
+/**
+ * @brief 双二阶一节的直流增益
+ */
+static float SensorFilter_BiquadDcGain(const float *coeffs)
+{
+    float den = 1.0f - coeffs[3] - coeffs[4];
+
+    if (fabsf(den) < 1e-9f) {
+        return 1.0f;
+    }
+
+    return (coeffs[0] + coeffs[1] + coeffs[2]) / den;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
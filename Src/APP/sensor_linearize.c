@@ -0,0 +1,160 @@
+/**
+ ******************************************************************************
+ * @file    sensor_linearize.c
+ * @brief   温度传感器线性化查表实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "sensor_linearize.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有宏定义 */
+/* ========================================================================== */
+
+#define RTD_NEWTON_ITERATIONS           4       // 0°C以下牛顿迭代次数 (从二次解出发, 4次已收敛)
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 按函数均匀生成查找表
+ */
+bool SensorLut_Build(sensor_lut_t *lut, sensor_lut_func_t func, const void *params,
+                     float x_min, float x_max, uint16_t points, sensor_lut_interp_t interp)
+{
+    float step;
+
+    if (lut == NULL || func == NULL || !(x_max > x_min) ||
+        points < 2 || points > SENSOR_LUT_MAX_POINTS ||
+        (interp == SENSOR_LUT_QUADRATIC && points < 3)) {
+        return false;
+    }
+
+    memset(lut, 0, sizeof(sensor_lut_t));
+
+    step = (x_max - x_min) / (float)(points - 1);
+
+    lut->x_min = x_min;
+    lut->x_max = x_max;
+    lut->inv_step = 1.0f / step;
+    lut->points = points;
+    lut->interp = interp;
+
+    for (uint16_t i = 0; i < points; i++) {
+        lut->y[i] = func(x_min + step * (float)i, params);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 查表插值
+ */
+float SensorLut_Lookup(const sensor_lut_t *lut, float x)
+{
+    float pos;
+    float frac;
+    uint16_t i;
+
+    if (!(x > lut->x_min)) {
+        return lut->y[0];
+    }
+    if (!(x < lut->x_max)) {
+        return lut->y[lut->points - 1];
+    }
+
+    pos = (x - lut->x_min) * lut->inv_step;
+
+    if (lut->interp == SENSOR_LUT_QUADRATIC) {
+        // 以最近点为中心取三点, 端点处向内移一格
+        i = (uint16_t)(pos + 0.5f);
+        if (i < 1) {
+            i = 1;
+        } else if (i > lut->points - 2) {
+            i = (uint16_t)(lut->points - 2);
+        }
+        frac = pos - (float)i;
+
+        return lut->y[i] +
+               frac * 0.5f * (lut->y[i + 1] - lut->y[i - 1]) +
+               frac * frac * 0.5f * (lut->y[i + 1] - 2.0f * lut->y[i] + lut->y[i - 1]);
+    }
+
+    i = (uint16_t)pos;
+    if (i > lut->points - 2) {
+        i = (uint16_t)(lut->points - 2);
+    }
+    frac = pos - (float)i;
+
+    return lut->y[i] + frac * (lut->y[i + 1] - lut->y[i]);
+}
+
+/**
+ * @brief 热电阻电阻值 (CVD正向公式)
+ */
+float SensorLinearize_RtdResistance(float temperature, const sensor_rtd_params_t *params)
+{
+    float t = temperature;
+    float r = 1.0f + SENSOR_RTD_CVD_A * t + SENSOR_RTD_CVD_B * t * t;
+
+    if (t < 0.0f) {
+        r += SENSOR_RTD_CVD_C * (t - 100.0f) * t * t * t;
+    }
+
+    return params->r0 * r;
+}
+
+/**
+ * @brief 热电阻温度 (CVD反解)
+ */
+float SensorLinearize_RtdTemperature(float resistance, const void *params)
+{
+    const sensor_rtd_params_t *rtd = (const sensor_rtd_params_t *)params;
+    float ratio = resistance / rtd->r0;
+    float t;
+
+    // 0°C以上 C项为0, 二次方程闭式解
+    t = (-SENSOR_RTD_CVD_A +
+         sqrtf(SENSOR_RTD_CVD_A * SENSOR_RTD_CVD_A - 4.0f * SENSOR_RTD_CVD_B * (1.0f - ratio))) /
+        (2.0f * SENSOR_RTD_CVD_B);
+
+    if (ratio >= 1.0f) {
+        return t;
+    }
+
+    // 0°C以下 以二次解为初值做牛顿迭代
+    for (uint8_t n = 0; n < RTD_NEWTON_ITERATIONS; n++) {
+        float f = 1.0f + SENSOR_RTD_CVD_A * t + SENSOR_RTD_CVD_B * t * t +
+                  SENSOR_RTD_CVD_C * (t - 100.0f) * t * t * t - ratio;
+        float df = SENSOR_RTD_CVD_A + 2.0f * SENSOR_RTD_CVD_B * t +
+                   SENSOR_RTD_CVD_C * (4.0f * t - 300.0f) * t * t;
+        t -= f / df;
+    }
+
+    return t;
+}
+
+/**
+ * @brief 热敏电阻温度 (Steinhart-Hart)
+ */
+float SensorLinearize_NtcTemperature(float ratio, const void *params)
+{
+    const sensor_ntc_params_t *ntc = (const sensor_ntc_params_t *)params;
+    float ln_r;
+
+    if (!(ratio > 0.0f && ratio < 1.0f)) {
+        return NAN;
+    }
+
+    ln_r = logf(ntc->r_pullup * ratio / (1.0f - ratio));
+
+    return 1.0f / (ntc->a + ntc->b * ln_r + ntc->c * ln_r * ln_r * ln_r) - SENSOR_KELVIN_OFFSET;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,38 @@
+/**
+ ******************************************************************************
+ * @file    sensor_scale.c
+ * @brief   ADC通道批量工程量换算实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "sensor_scale.h"
+
+#if defined(ARM_MATH_CM4)
+#include "arm_math.h"
+#endif
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 按通道增益/偏置向量换算一帧
+ */
+void SensorScale_Apply(const float *voltage, const float *gain, const float *offset,
+                       float *value, uint32_t count)
+{
+#if defined(ARM_MATH_CM4)
+    arm_mult_f32((float32_t *)voltage, (float32_t *)gain, value, count);
+    arm_add_f32(value, (float32_t *)offset, value, count);
+#else
+    for (uint32_t ch = 0; ch < count; ch++) {
+        value[ch] = voltage[ch] * gain[ch];
+    }
+    for (uint32_t ch = 0; ch < count; ch++) {
+        value[ch] += offset[ch];
+    }
+#endif
+}
@@ -11,7 +11,8 @@
  * 本文件基于墨路控制系统详细设计文档V3实现，采用四层架构设计
  *
  * 主要功能:
- * 1. 周期性采集传感器数据 (50ms周期)
+ * 1. 周期性采集传感器数据 (10ms基础节拍, 各通道按配置的采样周期分频;
+ *    消息、事件标志、过程映像和健康检查仍按50ms任务周期)
  * 2. 数据滤波和质量检查
  * 3. 通过消息队列发送数据到控制任务和通信任务
  * 4. 支持传感器校准和配置
@@ -20,19 +21,36 @@
  */
 
 #include "sensor_task_v3.h"
+#include "ethercat_process_image.h"
 #include "ads8688/bsp_ads8688.h"
+#include "seqlock.h"
+#include "sensor_scale.h"
+#include "actuator_task_v3.h"
 #include <string.h>
 #include <stdio.h>
+#include <stddef.h>
 #include <math.h>
 
 /* ========================================================================== */
 /* 私有宏定义 */
 /* ========================================================================== */
 
-#define MAX_FILTER_SAMPLES      8       // 滤波缓冲区深度
+#define MAX_FILTER_SAMPLES      8       // 滤波预热样本数 (之前按比例降低质量分数)
 #define SENSOR_TIMEOUT_MS       100     // 传感器读取超时
-#define CALIBRATION_SAMPLES     10      // 校准采样次数
+#define CALIBRATION_SAMPLES     10      // 每个标定点采集的滤波样本数
 #define QUALITY_THRESHOLD       80      // 质量阈值
+#define SENSOR_ADC_CHANNELS     8       // ADS8688通道数
+#define SENSOR_LOG_INTERVAL_MS  5000    // 调试信息打印间隔
+#define SENSOR_PUBLISH_TICKS    (SENSOR_TASK_PERIOD_MS / SENSOR_BASE_TICK_MS)  // 每个任务周期的基础节拍数
+
+// 温度前端 (见sensor_temp_model_t)
+#define TEMP_CHANNELS           (SENSOR_TEMP_3 - SENSOR_TEMP_1 + 1)
+#define TEMP_PT100_OHM_PER_VOLT 100.0f  // Pt100: 1mA激励, 10倍放大
+#define TEMP_PT100_R_MIN        80.0f   // Pt100查找表范围 (Ω)
+#define TEMP_PT100_R_MAX        160.0f
+#define TEMP_NTC_REF_VOLTS      5.0f    // NTC分压基准
+#define TEMP_NTC_RATIO_MIN      0.05f   // NTC查找表范围 (分压比)
+#define TEMP_NTC_RATIO_MAX      0.80f
 
 /* ========================================================================== */
 /* 全局变量定义 */
@@ -41,12 +59,6 @@
 // 任务句柄
 TaskHandle_t xTaskHandle_SensorV3 = NULL;
 
-// 队列句柄
-QueueHandle_t xQueue_SensorMsg = NULL;
-
-// 互斥体
-SemaphoreHandle_t xMutex_SensorContext = NULL;
-
 // 事件组
 EventGroupHandle_t xEventGroup_Sensor = NULL;
 
@@ -54,28 +66,144 @@ EventGroupHandle_t xEventGroup_Sensor = NULL;
 /* 私有变量 */
 /* ========================================================================== */
 
-// 传感器上下文
+// 传感器上下文 (本任务的工作副本, 仅本任务读写)
 static sensor_context_t g_sensor_context = {0};
 
+// 已发布的上下文快照 (双缓冲顺序锁, 写者不阻塞, 读者冲突时重试)
+static sensor_context_t g_sensor_snapshots[2];
+static seqlock_t g_sensor_seqlock;
+
 // 传感器配置
 static sensor_config_t g_sensor_configs[SENSOR_COUNT] = {0};
 
 // 统计信息
 static sensor_task_stats_t g_sensor_stats = {0};
 
-// 滤波缓冲区
-static float g_filter_buffer[SENSOR_COUNT][MAX_FILTER_SAMPLES] = {0};
-static uint8_t g_filter_index[SENSOR_COUNT] = {0};
-static uint8_t g_filter_count[SENSOR_COUNT] = {0};
+// 各通道流式统计 (标定值, 仅本任务读写)
+static stream_stats_t g_channel_stats[SENSOR_COUNT];
+
+// 已发布的统计结果 (工作副本 + 双缓冲顺序锁, 其他任务无锁读取, 不阻塞本任务)
+static stream_stats_summary_t g_channel_summary[SENSOR_COUNT];
+static stream_stats_summary_t g_channel_summary_snapshots[2][SENSOR_COUNT];
+static seqlock_t g_channel_stats_seqlock;
+
+// 待复位的通道 (其他任务置位, 本任务在更新统计前取用)
+static volatile uint32_t g_channel_stats_reset_mask;
+
+// 本周期ADS8688采样快照 (每周期只扫描一次, 温度/压力/液位共用同一时刻的数据)
+static struct {
+    HAL_StatusTypeDef status;           // 扫描结果
+    uint32_t timestamp;                 // 扫描时刻 (ms)
+    uint32_t acquire_time;              // 扫描时刻 (Profiler_Now计数)
+    uint16_t raw[SENSOR_ADC_CHANNELS];  // 原始值
+    float voltage[SENSOR_ADC_CHANNELS]; // 电压值
+    float value[SENSOR_ADC_CHANNELS];   // 工程量 (未滤波)
+} g_adc_snapshot;
+
+// ADS8688各通道工程量换算向量: 工程量 = 电压 * gain + offset (按传感器配置生成)
+static float g_adc_unit_gain[SENSOR_ADC_CHANNELS];
+static float g_adc_unit_offset[SENSOR_ADC_CHANNELS];
+
+// 温度线性化查找表 (初始化时按解析公式生成, 同一模型的通道共用)
+static sensor_lut_t g_lut_pt100;
+static sensor_lut_t g_lut_ntc;
+static sensor_temp_model_t g_temp_models[TEMP_CHANNELS];
+
+// 待生效的温度前端模型 (其他任务写入, 本任务在采样前取用)
+static volatile sensor_temp_model_t g_temp_model_pending[TEMP_CHANNELS];
+static volatile bool g_temp_model_pending_flag[TEMP_CHANNELS];
+
+// 待生效的传感器配置 (其他任务写入, 本任务在调度前取用; 生效后重建分频和ADC换算向量)
+static sensor_config_t g_sensor_config_pending[SENSOR_COUNT];
+static volatile bool g_sensor_config_pending_flag[SENSOR_COUNT];
+
+static const sensor_rtd_params_t g_pt100_params = {100.0f};
+static const sensor_ntc_params_t g_ntc_params = {
+    1.009249522e-3f, 2.378405444e-4f, 2.019202697e-7f, 10000.0f     // 10k B3950
+};
+
+// 标定会话 (其他任务通过接口函数在临界区内发起请求, 本任务采集样本并在周期边界生效)
+static struct {
+    sensor_calib_state_t state;
+    sensor_type_t sensor_type;
+    uint8_t point_count;
+    float x[SENSOR_CALIB_MAX_POINTS];   // 各点滤波后值均值
+    float y[SENSOR_CALIB_MAX_POINTS];   // 各点参考值
+    float reference;                    // 正在采集的点的参考值
+    float sum;                          // 正在采集的点的样本和
+    uint16_t samples;                   // 正在采集的点的样本数
+    bool commit_requested;
+    uint8_t commit_order;
+    float coeffs[SENSOR_CALIB_COEFF_COUNT];
+    float rms;
+} g_calib;
+
+// 分阶段计时
+enum {
+    SENSOR_PHASE_ACQUIRE = 0,           // 调度 + ADS8688采样快照
+    SENSOR_PHASE_PROCESS,               // 换算/滤波/标定
+    SENSOR_PHASE_CONTEXT,               // 标定服务/上下文/健康检查
+    SENSOR_PHASE_PUBLISH,               // 过程映像/快照/消息发布
+    SENSOR_PHASE_COUNT
+};
+
+static const char *const g_sensor_phase_names[SENSOR_PHASE_COUNT] = {
+    "acquire", "process", "context", "publish"
+};
+static profiler_t g_sensor_profiler;
+
+// 多速率调度: 每个传感器按基础节拍分频采样, 输出再按抽取比更新 (仅本任务访问)
+typedef struct {
+    uint16_t divider;                   // 采样分频 (基础节拍数)
+    uint16_t countdown;                 // 距下次采样的节拍数
+    uint16_t decimation;                // 输出抽取比
+    uint16_t decim_count;               // 自上次输出以来的采样数
+} sensor_rate_t;
+
+static sensor_rate_t g_sensor_rates[SENSOR_COUNT];
+static uint16_t g_sensor_due_mask;      // 本节拍到期采样的传感器
+static uint16_t g_sensor_output_mask;   // 本节拍更新了输出的传感器
+static uint16_t g_publish_ticks;        // 自上次任务周期步骤以来的基础节拍数
+
+// 快照发布通知的接收任务 (其他任务写入, 本任务读取)
+static TaskHandle_t volatile g_publish_notify_task = NULL;
+
+// 滤波链 (仅本任务访问)
+static sensor_filter_t g_filters[SENSOR_COUNT];
+
+// 待生效的滤波链配置 (其他任务写入, 本任务在滤波前取用)
+static sensor_filter_config_t g_filter_pending[SENSOR_COUNT];
+static volatile bool g_filter_pending_flag[SENSOR_COUNT];
+
+// 液位估计器 (每个模拟液位采样更新一次, 仅本任务访问)
+static level_estimator_t g_level_estimator;
+static uint32_t g_level_estimator_time = 0;         // 上次更新所用的ADC扫描时刻 (ms, 0=尚未更新)
+static float g_level_pump[ACTUATOR_PUMP_OUTPUTS];   // 最近读到的泵驱动量 (%)
+
+// 待生效的液位估计器配置 (其他任务写入, 本任务在更新前取用)
+static level_estimator_config_t g_level_estimator_pending;
+static volatile bool g_level_estimator_pending_flag = false;
 
 /* ========================================================================== */
 /* 私有函数声明 */
 /* ========================================================================== */
 
 static void Sensor_InitializeConfigs(void);
+static void Sensor_InitializeRate(sensor_type_t sensor_type);
+static void Sensor_InitializeFilters(void);
+static void Sensor_InitializeLinearization(void);
+static void Sensor_InitializeAdcScaling(void);
+static void Sensor_SetTemperatureScaling(sensor_type_t sensor_type);
+static float Sensor_LinearizeTemperature(sensor_type_t sensor_type, float value);
 static void Sensor_InitializeHardware(void);
 static void Sensor_InitializeFloatSwitchGPIO(void);
+static void Sensor_RunCycle(void);
 static void Sensor_ReadAllSensors(void);
+static void Sensor_UpdateSchedule(void);
+static bool Sensor_IsDue(sensor_type_t sensor_type);
+static bool Sensor_AnyDue(sensor_type_t first, sensor_type_t last);
+static bool Sensor_OutputDue(sensor_type_t sensor_type);
+static void Sensor_AcquireAdcSnapshot(void);
 static void Sensor_ReadTemperatureSensors(void);
 static void Sensor_ReadPressureSensors(void);
 static void Sensor_ReadLevelSensors(void);
@@ -83,6 +211,9 @@ static void Sensor_ReadFlowSensor(void);
 static float Sensor_ApplyFilter(sensor_type_t sensor_type, float raw_value);
 static float Sensor_ApplyCalibration(sensor_type_t sensor_type, float filtered_value);
 static uint8_t Sensor_CalculateQuality(sensor_type_t sensor_type);
+static void Sensor_CalibrationSample(sensor_type_t sensor_type, float filtered_value);
+static void Sensor_UpdateLevelEstimate(bool analog_valid, float level);
+static void Sensor_ServiceCalibration(void);
 static void Sensor_UpdateContext(void);
 static void Sensor_CheckSystemHealth(void);
 
@@ -96,17 +227,9 @@ static void Sensor_CheckSystemHealth(void);
  */
 BaseType_t SensorTaskV3_Init(void)
 {
-    // 创建互斥体
-    xMutex_SensorContext = xSemaphoreCreateMutex();
-    if (xMutex_SensorContext == NULL) {
-        printf("[SensorV3] ERROR: Failed to create mutex\r\n");
-        return pdFAIL;
-    }
-
-    // 创建消息队列
-    xQueue_SensorMsg = xQueueCreate(SENSOR_MSG_QUEUE_SIZE, sizeof(sensor_msg_t));
-    if (xQueue_SensorMsg == NULL) {
-        printf("[SensorV3] ERROR: Failed to create message queue\r\n");
+    // 创建消息总线主题
+    if (MsgBus_CreateTopic(MSG_BUS_TOPIC_SENSOR_DATA, sizeof(sensor_msg_t), SENSOR_MSG_POOL_BLOCKS) != pdPASS) {
+        printf("[SensorV3] ERROR: Failed to create message topic\r\n");
         return pdFAIL;
     }
 
@@ -123,12 +246,48 @@ BaseType_t SensorTaskV3_Init(void)
     // 初始化传感器配置
     Sensor_InitializeConfigs();
 
+    // 初始化多速率调度 (滤波器设计依赖各通道采样率)
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        Sensor_InitializeRate((sensor_type_t)i);
+    }
+
+    // 初始化滤波链
+    Sensor_InitializeFilters();
+
+    // 生成温度线性化查找表
+    Sensor_InitializeLinearization();
+
+    // 初始化ADC工程量换算
+    Sensor_InitializeAdcScaling();
+
+    // 初始化液位估计器 (默认配置)
+    LevelEstimator_Init(&g_level_estimator, NULL);
+    g_level_estimator_time = 0;
+    memset(g_level_pump, 0, sizeof(g_level_pump));
+
     // 初始化上下文
     memset(&g_sensor_context, 0, sizeof(sensor_context_t));
+    g_publish_ticks = 0;
     g_sensor_context.system_ready = false;
 
+    memset(g_sensor_snapshots, 0, sizeof(g_sensor_snapshots));
+    Seqlock_Init(&g_sensor_seqlock, &g_sensor_snapshots[0], &g_sensor_snapshots[1],
+                 sizeof(sensor_context_t));
+
     // 初始化统计信息
     memset(&g_sensor_stats, 0, sizeof(sensor_task_stats_t));
+    Profiler_Init(&g_sensor_profiler, g_sensor_phase_names, SENSOR_PHASE_COUNT);
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        StreamStats_Init(&g_channel_stats[i]);
+    }
+    memset(g_channel_summary, 0, sizeof(g_channel_summary));
+    g_channel_stats_reset_mask = 0;
+    Seqlock_Init(&g_channel_stats_seqlock, &g_channel_summary_snapshots[0], &g_channel_summary_snapshots[1],
+                 sizeof(g_channel_summary));
+    Seqlock_Publish(&g_channel_stats_seqlock, g_channel_summary);     // 无样本时读到全零
+
+    // 初始化TxPDO过程映像
+    ProcessImage_Init();
 
     printf("[SensorV3] Initialization SUCCESS\r\n");
     return pdPASS;
@@ -167,80 +326,21 @@ BaseType_t SensorTaskV3_Create(void)
 void Task_SensorV3(void *pvParameters)
 {
     TickType_t xLastWakeTime;
-    uint32_t cycle_start_time, cycle_end_time;
-    sensor_msg_t sensor_msg;
 
     // 初始化延时基准时间
     xLastWakeTime = xTaskGetTickCount();
 
-    printf("[SensorV3] Task Started - Period: %d ms\r\n", SENSOR_TASK_PERIOD_MS);
+    printf("[SensorV3] Task Started - Period: %d ms, Base Tick: %d ms\r\n", SENSOR_TASK_PERIOD_MS, SENSOR_BASE_TICK_MS);
 
     // 等待系统初始化完成
     vTaskDelay(pdMS_TO_TICKS(100));
 
     for (;;)
     {
-        // 记录周期开始时间
-        cycle_start_time = HAL_GetTick();
-
-        // 1. 读取所有传感器数据
-        Sensor_ReadAllSensors();
-
-        // 2. 更新上下文数据
-        Sensor_UpdateContext();
-
-        // 3. 检查系统健康状态
-        Sensor_CheckSystemHealth();
-
-        // 4. 准备消息并发送到队列
-        if (g_sensor_context.system_ready) {
-            sensor_msg.type = MSG_SENSOR_DATA;
-            sensor_msg.timestamp = HAL_GetTick();
-            sensor_msg.data_len = sizeof(sensor_context_t);
-
-            // 获取互斥体并复制上下文
-            if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-                memcpy(&sensor_msg.context, &g_sensor_context, sizeof(sensor_context_t));
-                xSemaphoreGive(xMutex_SensorContext);
-
-                // 发送消息到队列
-                if (xQueueSend(xQueue_SensorMsg, &sensor_msg, 0) != pdPASS) {
-                    g_sensor_stats.queue_full_count++;
-                }
-
-                // 设置事件标志
-                xEventGroupSetBits(xEventGroup_Sensor, EVENT_SENSOR_DATA_READY);
-            }
-        }
-
-        // 5. 更新统计信息
-        cycle_end_time = HAL_GetTick();
-        uint32_t cycle_time_us = (cycle_end_time - cycle_start_time) * 1000;
-
-        g_sensor_stats.total_cycles++;
-        if (cycle_time_us > g_sensor_stats.max_cycle_time_us) {
-            g_sensor_stats.max_cycle_time_us = (uint16_t)cycle_time_us;
-        }
+        Sensor_RunCycle();
 
-        // 计算平均循环时间
-        g_sensor_stats.avg_cycle_time_us = (uint16_t)(
-            (g_sensor_stats.avg_cycle_time_us * (g_sensor_stats.total_cycles - 1) + cycle_time_us) /
-            g_sensor_stats.total_cycles
-        );
-
-        // 6. 定期打印调试信息
-        if ((g_sensor_context.cycle_count % 100) == 0) {
-            printf("[SensorV3] Cycle=%lu, Quality=%d%%, Temp1=%.1f°C, Press1=%.1fkPa, Float1=%.0f, AnalogLevel=%.1fmm\r\n",
-                   g_sensor_context.cycle_count,
-                   g_sensor_context.overall_quality,
-                   g_sensor_context.temp_values[0],
-                   g_sensor_context.pressure_values[0],
-                   g_sensor_context.level_values[0],  // 浮球开关1
-                   g_sensor_context.level_values[3]); // 模拟液位
-        }
-
-        // 7. 按照固定周期执行
-        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(SENSOR_TASK_PERIOD_MS));
+        // 7. 按照基础节拍执行
+        vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(SENSOR_BASE_TICK_MS));
     }
 }
 
@@ -255,13 +355,7 @@ BaseType_t SensorTaskV3_GetContext(sensor_context_t *context)
         return pdFALSE;
     }
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        memcpy(context, &g_sensor_context, sizeof(sensor_context_t));
-        xSemaphoreGive(xMutex_SensorContext);
-        return pdTRUE;
-    }
-
-    return pdFALSE;
+    return Seqlock_Read(&g_sensor_seqlock, 0, context, sizeof(sensor_context_t), NULL) ? pdTRUE : pdFALSE;
 }
 
 /**
@@ -269,6 +363,7 @@ BaseType_t SensorTaskV3_GetContext(sensor_context_t *context)
  * @param sensor_type 传感器类型
  * @param config 配置结构指针
  * @return pdTRUE=成功, pdFALSE=失败
+ * @note 在传感器任务下一个节拍调度前生效 (分频/抽取比和ADC换算向量随之重建)
  */
 BaseType_t SensorTaskV3_ConfigureSensor(sensor_type_t sensor_type, const sensor_config_t *config)
 {
@@ -276,7 +371,10 @@ BaseType_t SensorTaskV3_ConfigureSensor(sensor_type_t sensor_type, const sensor_
         return pdFALSE;
     }
 
-    memcpy(&g_sensor_configs[sensor_type], config, sizeof(sensor_config_t));
+    taskENTER_CRITICAL();
+    g_sensor_config_pending[sensor_type] = *config;
+    g_sensor_config_pending_flag[sensor_type] = true;
+    taskEXIT_CRITICAL();
 
     printf("[SensorV3] Sensor %d configured: scale=%.3f, offset=%.3f\r\n",
            sensor_type, config->scale_factor, config->offset);
@@ -296,13 +394,33 @@ BaseType_t SensorTaskV3_GetSensorData(sensor_type_t sensor_type, sensor_data_t *
         return pdFALSE;
     }
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        memcpy(data, &g_sensor_context.sensors[sensor_type], sizeof(sensor_data_t));
-        xSemaphoreGive(xMutex_SensorContext);
-        return pdTRUE;
+    return Seqlock_Read(&g_sensor_seqlock,
+                        (uint16_t)(offsetof(sensor_context_t, sensors) + sensor_type * sizeof(sensor_data_t)),
+                        data, sizeof(sensor_data_t), NULL) ? pdTRUE : pdFALSE;
+}
+
+/**
+ * @brief 获取通道输出周期 (采样周期 × 输出抽取比)
+ * @param sensor_type 传感器类型
+ * @return 输出周期 (ms), 参数错误时为0
+ */
+uint32_t SensorTaskV3_GetOutputPeriod(sensor_type_t sensor_type)
+{
+    if (sensor_type >= SENSOR_COUNT) {
+        return 0;
     }
 
-    return pdFALSE;
+    return (uint32_t)g_sensor_rates[sensor_type].divider * g_sensor_rates[sensor_type].decimation *
+           SENSOR_BASE_TICK_MS;
+}
+
+/**
+ * @brief 注册快照发布通知
+ * @param task 接收通知的任务 (NULL=取消)
+ */
+void SensorTaskV3_SetPublishNotify(TaskHandle_t task)
+{
+    g_publish_notify_task = task;
 }
 
 /**
@@ -313,29 +431,110 @@ BaseType_t SensorTaskV3_GetSensorData(sensor_type_t sensor_type, sensor_data_t *
  */
 BaseType_t SensorTaskV3_CalibrateSensor(sensor_type_t sensor_type, float reference_value)
 {
-    if (sensor_type >= SENSOR_COUNT) {
+    BaseType_t result = pdFALSE;
+
+    // 两步在同一临界区内完成, 其他任务不会插入到点与提交之间
+    taskENTER_CRITICAL();
+    if (SensorTaskV3_CalibrationAddPoint(sensor_type, reference_value) == pdTRUE) {
+        result = SensorTaskV3_CalibrationCommit(sensor_type, 0);
+    }
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+/**
+ * @brief 采集一个标定点
+ * @param sensor_type 传感器类型
+ * @param reference_value 参考值
+ * @return pdTRUE=请求已接受, pdFALSE=参数错误或服务忙
+ */
+BaseType_t SensorTaskV3_CalibrationAddPoint(sensor_type_t sensor_type, float reference_value)
+{
+    BaseType_t result = pdFALSE;
+
+    // 浮球开关不经过滤波, 无法采集
+    if (sensor_type >= SENSOR_COUNT ||
+        (sensor_type >= SENSOR_LEVEL_FLOAT_1 && sensor_type <= SENSOR_LEVEL_FLOAT_3)) {
         return pdFALSE;
     }
 
-    // 采集多个样本计算平均值
-    float sum = 0.0f;
-    for (uint8_t i = 0; i < CALIBRATION_SAMPLES; i++) {
-        sum += g_sensor_context.sensors[sensor_type].filtered_value;
-        vTaskDelay(pdMS_TO_TICKS(10));
+    taskENTER_CRITICAL();
+    if (g_calib.state != SENSOR_CALIB_COLLECTING && !g_calib.commit_requested) {
+        // 空闲或上一会话已结束时开始新会话
+        if (g_calib.state != SENSOR_CALIB_READY) {
+            g_calib.sensor_type = sensor_type;
+            g_calib.point_count = 0;
+        }
+
+        if (g_calib.sensor_type == sensor_type && g_calib.point_count < SENSOR_CALIB_MAX_POINTS) {
+            g_calib.reference = reference_value;
+            g_calib.sum = 0.0f;
+            g_calib.samples = 0;
+            g_calib.state = SENSOR_CALIB_COLLECTING;
+            result = pdTRUE;
+        }
     }
-    float average = sum / CALIBRATION_SAMPLES;
+    taskEXIT_CRITICAL();
 
-    // 计算新的偏移量
-    g_sensor_configs[sensor_type].offset = reference_value -
-        (average * g_sensor_configs[sensor_type].scale_factor);
+    return result;
+}
 
-    printf("[SensorV3] Sensor %d calibrated: reference=%.3f, offset=%.3f\r\n",
-           sensor_type, reference_value, g_sensor_configs[sensor_type].offset);
+/**
+ * @brief 提交标定
+ * @param sensor_type 传感器类型
+ * @param order 拟合阶数
+ * @return pdTRUE=请求已接受, pdFALSE=无会话或参数错误
+ */
+BaseType_t SensorTaskV3_CalibrationCommit(sensor_type_t sensor_type, uint8_t order)
+{
+    BaseType_t result = pdFALSE;
 
-    // 设置事件标志
-    xEventGroupSetBits(xEventGroup_Sensor, EVENT_SENSOR_CALIBRATE);
+    if (order > SENSOR_CALIB_MAX_ORDER) {
+        return pdFALSE;
+    }
 
-    return pdTRUE;
+    taskENTER_CRITICAL();
+    if ((g_calib.state == SENSOR_CALIB_COLLECTING || g_calib.state == SENSOR_CALIB_READY) &&
+        g_calib.sensor_type == sensor_type && !g_calib.commit_requested) {
+        g_calib.commit_order = order;
+        g_calib.commit_requested = true;
+        result = pdTRUE;
+    }
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+/**
+ * @brief 取消当前标定会话
+ */
+void SensorTaskV3_CalibrationCancel(void)
+{
+    taskENTER_CRITICAL();
+    g_calib.state = SENSOR_CALIB_IDLE;
+    g_calib.point_count = 0;
+    g_calib.commit_requested = false;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 查询标定服务状态
+ * @param status 状态输出
+ */
+void SensorTaskV3_GetCalibrationStatus(sensor_calib_status_t *status)
+{
+    if (status == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    status->state = g_calib.state;
+    status->sensor_type = g_calib.sensor_type;
+    status->point_count = g_calib.point_count;
+    memcpy(status->coeffs, g_calib.coeffs, sizeof(status->coeffs));
+    status->rms = g_calib.rms;
+    taskEXIT_CRITICAL();
 }
 
 /**
@@ -355,37 +554,122 @@ void SensorTaskV3_GetStatistics(sensor_task_stats_t *stats)
 void SensorTaskV3_ResetStatistics(void)
 {
     memset(&g_sensor_stats, 0, sizeof(sensor_task_stats_t));
+    Profiler_Reset(&g_sensor_profiler);
     printf("[SensorV3] Statistics Reset\r\n");
 }
 
 /**
- * @brief 发送传感器消息到队列
- * @param msg 消息结构指针
- * @param timeout_ms 超时时间
- * @return pdTRUE=成功, pdFALSE=失败
+ * @brief 获取传感器任务分阶段计时器
  */
-BaseType_t SensorTaskV3_SendMessage(const sensor_msg_t *msg, uint32_t timeout_ms)
+const profiler_t *SensorTaskV3_GetProfiler(void)
 {
-    if (msg == NULL) {
+    return &g_sensor_profiler;
+}
+
+/**
+ * @brief 获取传感器通道流式统计
+ * @param sensor_type 传感器类型
+ * @param summary 统计结果输出
+ * @return pdTRUE=成功 (无样本时summary全零), pdFALSE=参数错误或快照读取失败
+ * @note 读取传感器任务发布的统计快照, 不与传感器任务争用锁 (SDO上传路径调用)
+ */
+BaseType_t SensorTaskV3_GetChannelStats(sensor_type_t sensor_type, stream_stats_summary_t *summary)
+{
+    if (sensor_type >= SENSOR_COUNT || summary == NULL) {
         return pdFALSE;
     }
 
-    return xQueueSend(xQueue_SensorMsg, msg, pdMS_TO_TICKS(timeout_ms));
+    return Seqlock_Read(&g_channel_stats_seqlock, (uint16_t)(sensor_type * sizeof(stream_stats_summary_t)),
+                        summary, sizeof(stream_stats_summary_t), NULL) ? pdTRUE : pdFALSE;
 }
 
 /**
- * @brief 从队列接收传感器消息
- * @param msg 消息结构指针
- * @param timeout_ms 超时时间
- * @return pdTRUE=成功, pdFALSE=失败
+ * @brief 复位传感器通道流式统计
+ * @param sensor_type 传感器类型
+ * @return pdTRUE=成功, pdFALSE=参数错误
+ * @note 在传感器任务下一个节拍更新统计前生效
  */
-BaseType_t SensorTaskV3_ReceiveMessage(sensor_msg_t *msg, uint32_t timeout_ms)
+BaseType_t SensorTaskV3_ResetChannelStats(sensor_type_t sensor_type)
 {
-    if (msg == NULL) {
+    if (sensor_type >= SENSOR_COUNT) {
         return pdFALSE;
     }
 
-    return xQueueReceive(xQueue_SensorMsg, msg, pdMS_TO_TICKS(timeout_ms));
+    taskENTER_CRITICAL();
+    g_channel_stats_reset_mask |= (1UL << sensor_type);
+    taskEXIT_CRITICAL();
+
+    return pdTRUE;
+}
+
+/**
+ * @brief 订阅传感器数据消息
+ * @param depth 订阅者队列深度
+ * @return 订阅者, NULL=失败
+ */
+msg_bus_subscriber_t *SensorTaskV3_Subscribe(uint8_t depth)
+{
+    return MsgBus_Subscribe(MSG_BUS_TOPIC_SENSOR_DATA, depth);
+}
+
+/**
+ * @brief 设置传感器滤波链
+ * @param sensor_type 传感器类型
+ * @param config 滤波链配置
+ * @return pdTRUE=成功, pdFALSE=参数错误
+ */
+BaseType_t SensorTaskV3_SetFilterChain(sensor_type_t sensor_type, const sensor_filter_config_t *config)
+{
+    if (sensor_type >= SENSOR_COUNT || !SensorFilter_CheckConfig(config)) {
+        return pdFALSE;
+    }
+
+    taskENTER_CRITICAL();
+    g_filter_pending[sensor_type] = *config;
+    g_filter_pending_flag[sensor_type] = true;
+    taskEXIT_CRITICAL();
+
+    return pdTRUE;
+}
+
+/**
+ * @brief 设置温度传感器前端模型
+ * @param sensor_type 温度传感器
+ * @param model 前端模型
+ * @return pdTRUE=成功, pdFALSE=参数错误
+ */
+BaseType_t SensorTaskV3_SetTemperatureModel(sensor_type_t sensor_type, sensor_temp_model_t model)
+{
+    if (sensor_type < SENSOR_TEMP_1 || sensor_type > SENSOR_TEMP_3 ||
+        model > SENSOR_TEMP_MODEL_NTC) {
+        return pdFALSE;
+    }
+
+    taskENTER_CRITICAL();
+    g_temp_model_pending[sensor_type - SENSOR_TEMP_1] = model;
+    g_temp_model_pending_flag[sensor_type - SENSOR_TEMP_1] = true;
+    taskEXIT_CRITICAL();
+
+    return pdTRUE;
+}
+
+/**
+ * @brief 设置液位估计器配置
+ * @param config 配置
+ * @return pdTRUE=成功, pdFALSE=参数错误
+ */
+BaseType_t SensorTaskV3_SetLevelEstimator(const level_estimator_config_t *config)
+{
+    if (!LevelEstimator_CheckConfig(config)) {
+        return pdFALSE;
+    }
+
+    taskENTER_CRITICAL();
+    g_level_estimator_pending = *config;
+    g_level_estimator_pending_flag = true;
+    taskEXIT_CRITICAL();
+
+    return pdTRUE;
 }
 
 /**
@@ -399,13 +683,8 @@ BaseType_t SensorTaskV3_GetTemperatures(float *temp_array)
         return pdFALSE;
     }
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        memcpy(temp_array, g_sensor_context.temp_values, sizeof(float) * 3);
-        xSemaphoreGive(xMutex_SensorContext);
-        return pdTRUE;
-    }
-
-    return pdFALSE;
+    return Seqlock_Read(&g_sensor_seqlock, offsetof(sensor_context_t, temp_values),
+                        temp_array, sizeof(float) * 3, NULL) ? pdTRUE : pdFALSE;
 }
 
 /**
@@ -419,13 +698,8 @@ BaseType_t SensorTaskV3_GetPressures(float *pressure_array)
         return pdFALSE;
     }
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        memcpy(pressure_array, g_sensor_context.pressure_values, sizeof(float) * 4);
-        xSemaphoreGive(xMutex_SensorContext);
-        return pdTRUE;
-    }
-
-    return pdFALSE;
+    return Seqlock_Read(&g_sensor_seqlock, offsetof(sensor_context_t, pressure_values),
+                        pressure_array, sizeof(float) * 4, NULL) ? pdTRUE : pdFALSE;
 }
 
 /**
@@ -438,14 +712,9 @@ BaseType_t SensorTaskV3_GetLevels(float *level_array)
         return pdFALSE;
     }
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        // 返回4个液位值：前3个浮球开关状态，第4个模拟液位
-        memcpy(level_array, g_sensor_context.level_values, sizeof(float) * 4);
-        xSemaphoreGive(xMutex_SensorContext);
-        return pdTRUE;
-    }
-
-    return pdFALSE;
+    // 返回4个液位值：前3个浮球开关状态，第4个模拟液位
+    return Seqlock_Read(&g_sensor_seqlock, offsetof(sensor_context_t, level_values),
+                        level_array, sizeof(float) * 4, NULL) ? pdTRUE : pdFALSE;
 }
 
 /**
@@ -456,10 +725,8 @@ float SensorTaskV3_GetFlowRate(void)
 {
     float flow_value = 0.0f;
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        flow_value = g_sensor_context.flow_value;
-        xSemaphoreGive(xMutex_SensorContext);
-    }
+    Seqlock_Read(&g_sensor_seqlock, offsetof(sensor_context_t, flow_value),
+                 &flow_value, sizeof(float), NULL);
 
     return flow_value;
 }
@@ -472,10 +739,8 @@ uint8_t SensorTaskV3_CheckHealth(void)
 {
     uint8_t quality = 0;
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        quality = g_sensor_context.overall_quality;
-        xSemaphoreGive(xMutex_SensorContext);
-    }
+    Seqlock_Read(&g_sensor_seqlock, offsetof(sensor_context_t, overall_quality),
+                 &quality, sizeof(uint8_t), NULL);
 
     return quality;
 }
@@ -495,7 +760,8 @@ static void Sensor_InitializeConfigs(void)
         g_sensor_configs[i].scale_factor = 0.1f;      // 0.1°C per unit
         g_sensor_configs[i].offset = 0.0f;
         g_sensor_configs[i].filter_coefficient = 0.8f;
-        g_sensor_configs[i].sample_count = 10;
+        g_sensor_configs[i].sample_count = 10;             // 10点平均后每秒输出一次
+        g_sensor_configs[i].sample_period_ms = 100;        // 温度变化慢, 10Hz采样
         g_sensor_configs[i].enabled = true;
     }
 
@@ -505,7 +771,8 @@ static void Sensor_InitializeConfigs(void)
         g_sensor_configs[i].scale_factor = 0.01f;     // 0.01kPa per unit
         g_sensor_configs[i].offset = 0.0f;
         g_sensor_configs[i].filter_coefficient = 0.7f;
-        g_sensor_configs[i].sample_count = 5;
+        g_sensor_configs[i].sample_count = 1;
+        g_sensor_configs[i].sample_period_ms = SENSOR_BASE_TICK_MS;   // 供墨压力闭环, 按基础节拍采样
         g_sensor_configs[i].enabled = true;
     }
 
@@ -516,6 +783,7 @@ static void Sensor_InitializeConfigs(void)
         g_sensor_configs[i].offset = 0.0f;
         g_sensor_configs[i].filter_coefficient = 1.0f; // 开关量不需要滤波
         g_sensor_configs[i].sample_count = 1;
+        g_sensor_configs[i].sample_period_ms = 50;
         g_sensor_configs[i].enabled = true;
     }
 
@@ -524,7 +792,8 @@ static void Sensor_InitializeConfigs(void)
     g_sensor_configs[SENSOR_LEVEL_ANALOG].scale_factor = 1.0f;      // 1mm per unit
     g_sensor_configs[SENSOR_LEVEL_ANALOG].offset = 0.0f;
     g_sensor_configs[SENSOR_LEVEL_ANALOG].filter_coefficient = 0.9f;
-    g_sensor_configs[SENSOR_LEVEL_ANALOG].sample_count = 8;
+    g_sensor_configs[SENSOR_LEVEL_ANALOG].sample_count = 1;
+    g_sensor_configs[SENSOR_LEVEL_ANALOG].sample_period_ms = 50;
     g_sensor_configs[SENSOR_LEVEL_ANALOG].enabled = true;
 
     // 流量传感器配置 (I2C)
@@ -532,7 +801,8 @@ static void Sensor_InitializeConfigs(void)
     g_sensor_configs[SENSOR_FLOW].scale_factor = 0.01f;  // 0.01 L/min per unit
     g_sensor_configs[SENSOR_FLOW].offset = 0.0f;
     g_sensor_configs[SENSOR_FLOW].filter_coefficient = 0.85f;
-    g_sensor_configs[SENSOR_FLOW].sample_count = 5;
+    g_sensor_configs[SENSOR_FLOW].sample_count = 1;
+    g_sensor_configs[SENSOR_FLOW].sample_period_ms = 100;
     g_sensor_configs[SENSOR_FLOW].enabled = true;
 
     printf("[SensorV3] Sensor configurations initialized (Total: %d sensors)\r\n", SENSOR_COUNT);
@@ -542,11 +812,318 @@ static void Sensor_InitializeConfigs(void)
     printf("  CH7:   Analog level sensor\r\n");
 }
 
+/**
+ * @brief 按传感器配置计算采样分频和输出抽取比
+ * @param sensor_type 传感器类型
+ */
+static void Sensor_InitializeRate(sensor_type_t sensor_type)
+{
+    sensor_rate_t *rate = &g_sensor_rates[sensor_type];
+    uint16_t divider = g_sensor_configs[sensor_type].sample_period_ms / SENSOR_BASE_TICK_MS;
+
+    rate->divider = (divider > 0) ? divider : 1;
+    rate->decimation = (g_sensor_configs[sensor_type].sample_count > 0) ? g_sensor_configs[sensor_type].sample_count : 1;
+    rate->decim_count = 0;
+
+    // 首次采样错开到不同节拍, 避免慢速通道集中在同一节拍
+    rate->countdown = (uint16_t)(sensor_type % rate->divider) + 1;
+}
+
+/**
+ * @brief 初始化各传感器的默认滤波链
+ */
+static void Sensor_InitializeFilters(void)
+{
+    sensor_filter_config_t config;
+    float sample_hz;
+
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        memset(&config, 0, sizeof(config));
+        sample_hz = 1000.0f / (float)(g_sensor_rates[i].divider * SENSOR_BASE_TICK_MS);
+
+        switch ((sensor_type_t)i) {
+            case SENSOR_TEMP_1:
+            case SENSOR_TEMP_2:
+            case SENSOR_TEMP_3:
+                // 温度变化慢: 中值去尖峰 + 移动平均 (窗口取sample_count)
+                config.stage_count = 2;
+                config.stages[0].type = SENSOR_FILTER_MEDIAN;
+                config.stages[0].length = 3;
+                config.stages[1].type = SENSOR_FILTER_MOVING_AVERAGE;
+                config.stages[1].length = (uint8_t)((g_sensor_configs[i].sample_count > SENSOR_FILTER_MA_MAX_LENGTH) ?
+                                                    SENSOR_FILTER_MA_MAX_LENGTH : g_sensor_configs[i].sample_count);
+                break;
+
+            case SENSOR_PRESSURE_1:
+            case SENSOR_PRESSURE_2:
+            case SENSOR_PRESSURE_3:
+            case SENSOR_PRESSURE_4:
+                // 压力需要较快响应: 中值去尖峰 + 指数滤波
+                config.stage_count = 2;
+                config.stages[0].type = SENSOR_FILTER_MEDIAN;
+                config.stages[0].length = 3;
+                config.stages[1].type = SENSOR_FILTER_EXPONENTIAL;
+                config.stages[1].alpha = g_sensor_configs[i].filter_coefficient;
+                break;
+
+            case SENSOR_LEVEL_ANALOG:
+                // 液面晃动: 中值去尖峰 + 1Hz二阶低通
+                config.stage_count = 2;
+                config.stages[0].type = SENSOR_FILTER_MEDIAN;
+                config.stages[0].length = 5;
+                config.stages[1].type = SENSOR_FILTER_BIQUAD;
+                config.stages[1].length = 1;
+                SensorFilter_DesignLowpass(1.0f, sample_hz, config.stages[1].coeffs);
+                break;
+
+            case SENSOR_FLOW:
+                config.stage_count = 1;
+                config.stages[0].type = SENSOR_FILTER_EXPONENTIAL;
+                config.stages[0].alpha = g_sensor_configs[i].filter_coefficient;
+                break;
+
+            default:
+                // 开关量不滤波
+                break;
+        }
+
+        SensorFilter_Init(&g_filters[i], &config);
+        g_filter_pending_flag[i] = false;
+    }
+}
+
+/**
+ * @brief 按传感器配置生成ADS8688各通道的工程量换算向量
+ */
+static void Sensor_InitializeAdcScaling(void)
+{
+    uint8_t channel;
+
+    // 未接传感器的通道输出电压值
+    for (uint8_t ch = 0; ch < SENSOR_ADC_CHANNELS; ch++) {
+        g_adc_unit_gain[ch] = 1.0f;
+        g_adc_unit_offset[ch] = 0.0f;
+    }
+
+    // 温度: 按前端模型
+    for (uint8_t i = SENSOR_TEMP_1; i <= SENSOR_TEMP_3; i++) {
+        Sensor_SetTemperatureScaling((sensor_type_t)i);
+    }
+
+    // 压力 (HP10MY): 假设0-10V对应0-1000kPa, V * 1000kPa/10V = V * 100
+    for (uint8_t i = SENSOR_PRESSURE_1; i <= SENSOR_PRESSURE_4; i++) {
+        channel = g_sensor_configs[i].channel;
+        g_adc_unit_gain[channel] = 100.0f;
+        g_adc_unit_offset[channel] = 0.0f;
+    }
+
+    // 模拟液位 (FRD-8061): 假设0-5V对应0-100mm, mm = V/0.05 = V*20
+    channel = g_sensor_configs[SENSOR_LEVEL_ANALOG].channel;
+    g_adc_unit_gain[channel] = 20.0f;
+    g_adc_unit_offset[channel] = 0.0f;
+}
+
+/**
+ * @brief 生成温度线性化查找表
+ */
+static void Sensor_InitializeLinearization(void)
+{
+    // Pt100曲率小, 线性插值误差约0.001°C; NTC两端较陡, 用二次插值
+    SensorLut_Build(&g_lut_pt100, SensorLinearize_RtdTemperature, &g_pt100_params,
+                    TEMP_PT100_R_MIN, TEMP_PT100_R_MAX, SENSOR_LUT_MAX_POINTS, SENSOR_LUT_LINEAR);
+    SensorLut_Build(&g_lut_ntc, SensorLinearize_NtcTemperature, &g_ntc_params,
+                    TEMP_NTC_RATIO_MIN, TEMP_NTC_RATIO_MAX, SENSOR_LUT_MAX_POINTS, SENSOR_LUT_QUADRATIC);
+}
+
+/**
+ * @brief 按温度前端模型设置通道换算向量 (换算到查表输入或直接到温度)
+ * @param sensor_type 温度传感器
+ */
+static void Sensor_SetTemperatureScaling(sensor_type_t sensor_type)
+{
+    uint8_t channel = g_sensor_configs[sensor_type].channel;
+
+    switch (g_temp_models[sensor_type - SENSOR_TEMP_1]) {
+        case SENSOR_TEMP_MODEL_PT100:
+            // 电阻 (Ω)
+            g_adc_unit_gain[channel] = TEMP_PT100_OHM_PER_VOLT;
+            g_adc_unit_offset[channel] = 0.0f;
+            break;
+
+        case SENSOR_TEMP_MODEL_NTC:
+            // 分压比
+            g_adc_unit_gain[channel] = 1.0f / TEMP_NTC_REF_VOLTS;
+            g_adc_unit_offset[channel] = 0.0f;
+            break;
+
+        default:
+            // 变送器 (FTT518): 假设0-5V对应-50°C到+150°C, (V*200°C/5V) - 50°C
+            g_adc_unit_gain[channel] = 40.0f;
+            g_adc_unit_offset[channel] = -50.0f;
+            break;
+    }
+}
+
+/**
+ * @brief 温度线性化
+ * @param sensor_type 温度传感器
+ * @param value 工程量换算结果 (电阻/分压比/温度)
+ * @return 温度 (°C)
+ */
+static float Sensor_LinearizeTemperature(sensor_type_t sensor_type, float value)
+{
+    switch (g_temp_models[sensor_type - SENSOR_TEMP_1]) {
+        case SENSOR_TEMP_MODEL_PT100:
+            return SensorLut_Lookup(&g_lut_pt100, value);
+
+        case SENSOR_TEMP_MODEL_NTC:
+            return SensorLut_Lookup(&g_lut_ntc, value);
+
+        default:
+            return value;
+    }
+}
+
+/**
+ * @brief 执行一个基础节拍 (采样->标定/上下文->发布->统计)
+ */
+static void Sensor_RunCycle(void)
+{
+    sensor_msg_t *sensor_msg;
+    bool publish_tick;
+
+    // 记录周期开始时间
+    Profiler_CycleBegin(&g_sensor_profiler);
+    Profiler_Phase(&g_sensor_profiler, SENSOR_PHASE_ACQUIRE);
+
+    // 1. 读取所有传感器数据
+    Sensor_ReadAllSensors();
+
+    // 标定: 完成采集的点入库, 已提交的会话拟合并替换系数
+    Profiler_Phase(&g_sensor_profiler, SENSOR_PHASE_CONTEXT);
+    Sensor_ServiceCalibration();
+
+    // 2. 更新上下文数据
+    Sensor_UpdateContext();
+
+    // 以下标注"任务周期"的步骤每SENSOR_TASK_PERIOD_MS执行一次, 消息和事件的消费者频率不随基础节拍变化
+    publish_tick = (++g_publish_ticks >= SENSOR_PUBLISH_TICKS);
+    if (publish_tick) {
+        g_publish_ticks = 0;
+
+        // 3. 检查系统健康状态 (任务周期)
+        Sensor_CheckSystemHealth();
+    }
+
+    // 发布上下文快照, 供其他任务无锁读取 (每个基础节拍, 快速通道的新样本不等任务周期)
+    Profiler_Phase(&g_sensor_profiler, SENSOR_PHASE_PUBLISH);
+    g_sensor_context.sequence = Seqlock_GetSequence(&g_sensor_seqlock) + 1;
+    Seqlock_Publish(&g_sensor_seqlock, &g_sensor_context);
+
+    // 有新输出时通知数据驱动的消费者 (无新输出的节拍不唤醒)
+    TaskHandle_t notify_task = g_publish_notify_task;
+    if (notify_task != NULL && g_sensor_output_mask != 0) {
+        xTaskNotifyGive(notify_task);
+    }
+
+    if (publish_tick) {
+        // 刷新TxPDO过程映像 (任务周期; 本任务是g_sensor_context唯一写者, 无需加锁)
+        {
+            // 0x6000.1 输入状态: 位0-2=浮球开关1-3
+            uint16_t input_bits = 0;
+            for (uint8_t i = 0; i < 3; i++) {
+                if (g_sensor_context.level_values[i] > 0.5f) {
+                    input_bits |= (uint16_t)(1u << i);
+                }
+            }
+            ProcessImage_SetApplValue(PI_APPL_INPUT_STATUS, (float)input_bits);
+        }
+        ProcessImage_UpdateFromSensors(&g_sensor_context);
+
+        // 4. 发布消息 (任务周期; 无订阅者时不申请内存块, 也不复制上下文)
+        if (g_sensor_context.system_ready) {
+            sensor_msg = (sensor_msg_t *)MsgBus_Alloc(MSG_BUS_TOPIC_SENSOR_DATA);
+            if (sensor_msg != NULL) {
+                sensor_msg->type = MSG_SENSOR_DATA;
+                sensor_msg->timestamp = HAL_GetTick();
+                sensor_msg->data_len = sizeof(sensor_context_t);
+                memcpy(&sensor_msg->context, &g_sensor_context, sizeof(sensor_context_t));
+                MsgBus_Publish(sensor_msg);
+            } else if (MsgBus_HasSubscribers(MSG_BUS_TOPIC_SENSOR_DATA)) {
+                g_sensor_stats.queue_full_count++;
+            }
+
+            // 设置事件标志
+            xEventGroupSetBits(xEventGroup_Sensor, EVENT_SENSOR_DATA_READY);
+        }
+    }
+
+    // 5. 更新统计信息
+    Profiler_CycleEnd(&g_sensor_profiler);
+
+    g_sensor_stats.total_cycles++;
+    Profiler_GetCycleTimes(&g_sensor_profiler, &g_sensor_stats.max_cycle_time_us,
+                           &g_sensor_stats.avg_cycle_time_us);
+
+    // 6. 定期打印调试信息
+    if ((g_sensor_context.cycle_count % (SENSOR_LOG_INTERVAL_MS / SENSOR_BASE_TICK_MS)) == 0) {
+        printf("[SensorV3] Cycle=%lu, Quality=%d%%, Temp1=%.1f°C, Press1=%.1fkPa, Float1=%.0f, AnalogLevel=%.1fmm\r\n",
+               g_sensor_context.cycle_count,
+               g_sensor_context.overall_quality,
+               g_sensor_context.temp_values[0],
+               g_sensor_context.pressure_values[0],
+               g_sensor_context.level_values[0],  // 浮球开关1
+               g_sensor_context.level_values[3]); // 模拟液位
+    }
+}
+
 /**
  * @brief 读取所有传感器数据
  */
 static void Sensor_ReadAllSensors(void)
 {
+    bool config_changed = false;
+
+    // 切换到新的传感器配置 (在调度之前, 分频/抽取比和到期掩码不会在节拍中途变化)
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        if (g_sensor_config_pending_flag[i]) {
+            taskENTER_CRITICAL();
+            g_sensor_configs[i] = g_sensor_config_pending[i];
+            g_sensor_config_pending_flag[i] = false;
+            taskEXIT_CRITICAL();
+
+            Sensor_InitializeRate((sensor_type_t)i);
+            config_changed = true;
+        }
+    }
+
+    // 确定本节拍到期的传感器
+    Sensor_UpdateSchedule();
+
+    // 切换温度前端模型 (在ADC换算之前, 同一样本不会混用两种换算)
+    for (uint8_t ch = 0; ch < TEMP_CHANNELS; ch++) {
+        if (g_temp_model_pending_flag[ch]) {
+            taskENTER_CRITICAL();
+            g_temp_models[ch] = g_temp_model_pending[ch];
+            g_temp_model_pending_flag[ch] = false;
+            taskEXIT_CRITICAL();
+
+            Sensor_SetTemperatureScaling((sensor_type_t)(SENSOR_TEMP_1 + ch));
+        }
+    }
+
+    // 传感器配置变更: 按新的通道映射重建全部换算向量 (旧通道恢复为电压输出)
+    if (config_changed) {
+        Sensor_InitializeAdcScaling();
+    }
+
+    // 有ADC通道到期时扫描ADS8688全通道一次, 以下各组传感器共用
+    if (Sensor_AnyDue(SENSOR_TEMP_1, SENSOR_PRESSURE_4) || Sensor_IsDue(SENSOR_LEVEL_ANALOG)) {
+        Sensor_AcquireAdcSnapshot();
+    }
+
+    Profiler_Phase(&g_sensor_profiler, SENSOR_PHASE_PROCESS);
+
     // 读取温度传感器
     Sensor_ReadTemperatureSensors();
 
@@ -565,35 +1142,120 @@ static void Sensor_ReadAllSensors(void)
 }
 
 /**
- * @brief 读取温度传感器 (FTT518 Pt100) - 通过ADS8688 CH0-2
+ * @brief 推进多速率调度一个基础节拍, 生成本节拍到期掩码
  */
-static void Sensor_ReadTemperatureSensors(void)
+static void Sensor_UpdateSchedule(void)
+{
+    g_sensor_due_mask = 0;
+    g_sensor_output_mask = 0;
+
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        sensor_rate_t *rate = &g_sensor_rates[i];
+
+        if (!g_sensor_configs[i].enabled) {
+            continue;
+        }
+
+        if (--rate->countdown == 0) {
+            rate->countdown = rate->divider;
+            g_sensor_due_mask |= (uint16_t)(1U << i);
+        } else {
+            g_sensor_stats.deferred_samples++;
+        }
+    }
+}
+
+/**
+ * @brief 传感器本节拍是否到期采样
+ */
+static bool Sensor_IsDue(sensor_type_t sensor_type)
 {
-    uint16_t raw_adc_data[8] = {0};
-    float voltage_data[8] = {0.0f};
+    return (g_sensor_due_mask & (1U << sensor_type)) != 0;
+}
 
-    // 读取ADS8688所有8个通道
-    HAL_StatusTypeDef status = BSP_ADS8688_ReadAllChannels(raw_adc_data);
+/**
+ * @brief [first, last]范围内是否有传感器本节拍到期
+ */
+static bool Sensor_AnyDue(sensor_type_t first, sensor_type_t last)
+{
+    uint16_t mask = (uint16_t)(((1U << (last + 1)) - 1U) & ~((1U << first) - 1U));
+
+    return (g_sensor_due_mask & mask) != 0;
+}
 
-    if (status == HAL_OK) {
-        // 转换为电压值
-        BSP_ADS8688_ConvertToVoltage(raw_adc_data, voltage_data, 8);
+/**
+ * @brief 记录一次采样, 判断是否达到输出抽取比
+ * @return true=本次更新输出, false=仅更新滤波器状态
+ */
+static bool Sensor_OutputDue(sensor_type_t sensor_type)
+{
+    sensor_rate_t *rate = &g_sensor_rates[sensor_type];
 
+    g_sensor_stats.total_samples++;
+
+    if (++rate->decim_count < rate->decimation) {
+        return false;
+    }
+
+    rate->decim_count = 0;
+    g_sensor_output_mask |= (uint16_t)(1U << sensor_type);
+    return true;
+}
+
+/**
+ * @brief 获取ADS8688全部8个通道(后台采集最新帧或阻塞扫描), 保存为本周期采样快照
+ * @note  两种来源都是16位码, 经BSP_ADS8688_ConvertToVoltage换算为伏特后
+ *        再乘g_adc_unit_gain (单位/V), 换算系数与采集方式无关
+ */
+static void Sensor_AcquireAdcSnapshot(void)
+{
+    g_adc_snapshot.status = BSP_ADS8688_ReadAllChannels(g_adc_snapshot.raw);
+    g_adc_snapshot.timestamp = HAL_GetTick();
+    g_adc_snapshot.acquire_time = Profiler_Now();
+
+    if (g_adc_snapshot.status == HAL_OK) {
+        BSP_ADS8688_ConvertToVoltage(g_adc_snapshot.raw, g_adc_snapshot.voltage, SENSOR_ADC_CHANNELS);
+
+        // 8通道一次换算为工程量 (先乘后加, 与逐通道 V*k+b 的舍入顺序相同)
+        SensorScale_Apply(g_adc_snapshot.voltage, g_adc_unit_gain, g_adc_unit_offset,
+                          g_adc_snapshot.value, SENSOR_ADC_CHANNELS);
+    } else {
+        memset(g_adc_snapshot.voltage, 0, sizeof(g_adc_snapshot.voltage));
+        memset(g_adc_snapshot.value, 0, sizeof(g_adc_snapshot.value));
+    }
+
+    g_sensor_stats.adc_scans++;
+}
+
+/**
+ * @brief 读取温度传感器 (FTT518 Pt100) - 通过ADS8688 CH0-2
+ */
+static void Sensor_ReadTemperatureSensors(void)
+{
+    if (!Sensor_AnyDue(SENSOR_TEMP_1, SENSOR_TEMP_3)) {
+        return;
+    }
+
+    if (g_adc_snapshot.status == HAL_OK) {
         // 处理温度传感器 (ADS8688 CH0-2)
         for (uint8_t i = SENSOR_TEMP_1; i <= SENSOR_TEMP_3; i++) {
-            if (!g_sensor_configs[i].enabled) {
+            if (!Sensor_IsDue(i)) {
                 continue;
             }
 
             uint8_t adc_channel = g_sensor_configs[i].channel; // CH0-2
 
-            // 将电压值转换为温度值 (根据FTT518 Pt100特性)
-            // 假设: 0-5V对应-50°C到+150°C 的线性关系
-            float raw_temp = (voltage_data[adc_channel] * 40.0f) - 50.0f; // (V*200°C/5V) - 50°C
+            // 温度值 (按前端模型换算并查表线性化, 见Sensor_SetTemperatureScaling)
+            float raw_temp = Sensor_LinearizeTemperature(i, g_adc_snapshot.value[adc_channel]);
 
             // 应用滤波
             float filtered_value = Sensor_ApplyFilter(i, raw_temp);
 
+            // 输出抽取 (滤波器每次采样都运行)
+            if (!Sensor_OutputDue(i)) {
+                continue;
+            }
+
             // 应用标定
             float calibrated_value = Sensor_ApplyCalibration(i, filtered_value);
 
@@ -604,14 +1266,13 @@ static void Sensor_ReadTemperatureSensors(void)
             g_sensor_context.sensors[i].raw_value = raw_temp;
             g_sensor_context.sensors[i].filtered_value = filtered_value;
             g_sensor_context.sensors[i].calibrated_value = calibrated_value;
-            g_sensor_context.sensors[i].timestamp = HAL_GetTick();
+            g_sensor_context.sensors[i].timestamp = g_adc_snapshot.timestamp;
+            g_sensor_context.sensors[i].acquire_time = g_adc_snapshot.acquire_time;
             g_sensor_context.sensors[i].valid = true;
             g_sensor_context.sensors[i].quality = quality;
 
             // 更新分类数据
             g_sensor_context.temp_values[i - SENSOR_TEMP_1] = calibrated_value;
-
-            g_sensor_stats.total_samples++;
         }
     } else {
         // ADS8688读取失败，标记温度传感器为无效
@@ -629,31 +1290,30 @@ static void Sensor_ReadTemperatureSensors(void)
  */
 static void Sensor_ReadPressureSensors(void)
 {
-    uint16_t raw_adc_data[8] = {0};
-    float voltage_data[8] = {0.0f};
-
-    // 读取ADS8688所有8个通道
-    HAL_StatusTypeDef status = BSP_ADS8688_ReadAllChannels(raw_adc_data);
-
-    if (status == HAL_OK) {
-        // 转换为电压值
-        BSP_ADS8688_ConvertToVoltage(raw_adc_data, voltage_data, 8);
+    if (!Sensor_AnyDue(SENSOR_PRESSURE_1, SENSOR_PRESSURE_4)) {
+        return;
+    }
 
+    if (g_adc_snapshot.status == HAL_OK) {
         // 处理压力传感器 (ADS8688 CH3-6)
         for (uint8_t i = SENSOR_PRESSURE_1; i <= SENSOR_PRESSURE_4; i++) {
-            if (!g_sensor_configs[i].enabled) {
+            if (!Sensor_IsDue(i)) {
                 continue;
             }
 
             uint8_t adc_channel = g_sensor_configs[i].channel; // CH3-6
 
-            // 将电压值转换为压力值 (根据HP10MY特性)
-            // 假设: 0-10V对应0-1000kPa 的线性关系
-            float raw_pressure = voltage_data[adc_channel] * 100.0f; // V * 1000kPa/10V = V * 100
+            // 压力值 (已按HP10MY特性换算, 见Sensor_InitializeAdcScaling)
+            float raw_pressure = g_adc_snapshot.value[adc_channel];
 
             // 应用滤波
             float filtered_value = Sensor_ApplyFilter(i, raw_pressure);
 
+            // 输出抽取 (滤波器每次采样都运行)
+            if (!Sensor_OutputDue(i)) {
+                continue;
+            }
+
             // 应用标定
             float calibrated_value = Sensor_ApplyCalibration(i, filtered_value);
 
@@ -664,14 +1324,13 @@ static void Sensor_ReadPressureSensors(void)
             g_sensor_context.sensors[i].raw_value = raw_pressure;
             g_sensor_context.sensors[i].filtered_value = filtered_value;
             g_sensor_context.sensors[i].calibrated_value = calibrated_value;
-            g_sensor_context.sensors[i].timestamp = HAL_GetTick();
+            g_sensor_context.sensors[i].timestamp = g_adc_snapshot.timestamp;
+            g_sensor_context.sensors[i].acquire_time = g_adc_snapshot.acquire_time;
             g_sensor_context.sensors[i].valid = true;
             g_sensor_context.sensors[i].quality = quality;
 
             // 更新分类数据
             g_sensor_context.pressure_values[i - SENSOR_PRESSURE_1] = calibrated_value;
-
-            g_sensor_stats.total_samples++;
         }
     } else {
         // ADS8688读取失败，标记压力传感器为无效
@@ -691,7 +1350,7 @@ static void Sensor_ReadLevelSensors(void)
 {
     // 1. 读取浮球液位开关 (GPIO)
     for (uint8_t i = SENSOR_LEVEL_FLOAT_1; i <= SENSOR_LEVEL_FLOAT_3; i++) {
-        if (!g_sensor_configs[i].enabled) {
+        if (!Sensor_IsDue(i) || !Sensor_OutputDue(i)) {
             continue;
         }
 
@@ -720,36 +1379,33 @@ static void Sensor_ReadLevelSensors(void)
         g_sensor_context.sensors[i].filtered_value = switch_value;
         g_sensor_context.sensors[i].calibrated_value = switch_value;
         g_sensor_context.sensors[i].timestamp = HAL_GetTick();
+        g_sensor_context.sensors[i].acquire_time = Profiler_Now();
         g_sensor_context.sensors[i].valid = true;
         g_sensor_context.sensors[i].quality = 100; // 开关量质量固定为100%
 
         // 更新分类数据 (level_values[0-2])
         g_sensor_context.level_values[i - SENSOR_LEVEL_FLOAT_1] = switch_value;
-
-        g_sensor_stats.total_samples++;
     }
 
     // 2. 读取模拟液位传感器 (ADS8688 CH7)
-    if (g_sensor_configs[SENSOR_LEVEL_ANALOG].enabled) {
-        uint16_t raw_adc_data[8] = {0};
-        float voltage_data[8] = {0.0f};
-
-        // 读取ADS8688所有8个通道
-        HAL_StatusTypeDef status = BSP_ADS8688_ReadAllChannels(raw_adc_data);
-
-        if (status == HAL_OK) {
-            // 转换为电压值
-            BSP_ADS8688_ConvertToVoltage(raw_adc_data, voltage_data, 8);
-
+    if (Sensor_IsDue(SENSOR_LEVEL_ANALOG)) {
+        if (g_adc_snapshot.status == HAL_OK) {
             uint8_t adc_channel = g_sensor_configs[SENSOR_LEVEL_ANALOG].channel; // CH7
 
-            // 将电压值转换为液位值 (根据FRD-8061传感器特性)
-            // 假设: 0-5V对应0-100mm液位
-            float raw_level = voltage_data[adc_channel] * 20.0f; // 5V/100mm = 0.05V/mm => mm = V/0.05 = V*20
+            // 液位值 (已按FRD-8061特性换算, 见Sensor_InitializeAdcScaling)
+            float raw_level = g_adc_snapshot.value[adc_channel];
+
+            // 液位估计取未滤波的标定值 (滤波链的延迟由估计器的过程模型代替)
+            Sensor_UpdateLevelEstimate(true, Sensor_ApplyCalibration(SENSOR_LEVEL_ANALOG, raw_level));
 
             // 应用滤波
             float filtered_value = Sensor_ApplyFilter(SENSOR_LEVEL_ANALOG, raw_level);
 
+            // 输出抽取 (滤波器每次采样都运行)
+            if (!Sensor_OutputDue(SENSOR_LEVEL_ANALOG)) {
+                return;
+            }
+
             // 应用标定
             float calibrated_value = Sensor_ApplyCalibration(SENSOR_LEVEL_ANALOG, filtered_value);
 
@@ -760,24 +1416,74 @@ static void Sensor_ReadLevelSensors(void)
             g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].raw_value = raw_level;
             g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].filtered_value = filtered_value;
             g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].calibrated_value = calibrated_value;
-            g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].timestamp = HAL_GetTick();
+            g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].timestamp = g_adc_snapshot.timestamp;
+            g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].acquire_time = g_adc_snapshot.acquire_time;
             g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].valid = true;
             g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].quality = quality;
 
             // 更新分类数据 (level_values[3])
             g_sensor_context.level_values[3] = calibrated_value;
-
-            g_sensor_stats.total_samples++;
         } else {
             // ADS8688读取失败，标记模拟液位传感器为无效
             g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].valid = false;
             g_sensor_context.sensors[SENSOR_LEVEL_ANALOG].quality = 0;
             g_sensor_context.level_values[3] = 0.0f;
             g_sensor_stats.data_errors++;
+
+            // 估计器按泵驱动量和浮球开关继续外推
+            Sensor_UpdateLevelEstimate(false, 0.0f);
         }
     }
 }
 
+/**
+ * @brief 更新液位融合估计 (每个模拟液位采样调用一次)
+ * @param analog_valid 模拟液位本次是否有效
+ * @param level 标定后的模拟液位 (mm, 未滤波)
+ */
+static void Sensor_UpdateLevelEstimate(bool analog_valid, float level)
+{
+    // 取用待生效的配置
+    if (g_level_estimator_pending_flag) {
+        level_estimator_config_t config;
+
+        taskENTER_CRITICAL();
+        config = g_level_estimator_pending;
+        g_level_estimator_pending_flag = false;
+        taskEXIT_CRITICAL();
+
+        LevelEstimator_SetConfig(&g_level_estimator, &config);
+    }
+
+    // 泵驱动量 (读取失败时沿用上次的值)
+    float pump[ACTUATOR_PUMP_OUTPUTS];
+    if (ActuatorTaskV3_ReadPumpOutputs(pump) == pdTRUE) {
+        memcpy(g_level_pump, pump, sizeof(g_level_pump));
+    }
+
+    // 按ADC扫描时刻计算步长, 首次或时刻未变化时按标称采样周期
+    uint32_t elapsed = g_adc_snapshot.timestamp - g_level_estimator_time;
+    if (g_level_estimator_time == 0 || elapsed == 0) {
+        elapsed = (uint32_t)g_sensor_rates[SENSOR_LEVEL_ANALOG].divider * SENSOR_BASE_TICK_MS;
+    }
+    g_level_estimator_time = g_adc_snapshot.timestamp;
+
+    LevelEstimator_Predict(&g_level_estimator, g_level_pump, (float)elapsed * 0.001f);
+
+    // 浮球开关 (level_values[0-2]为最近一次读取的状态)
+    for (uint8_t i = 0; i < LEVEL_ESTIMATOR_SWITCH_COUNT; i++) {
+        if (g_sensor_context.sensors[SENSOR_LEVEL_FLOAT_1 + i].valid) {
+            LevelEstimator_UpdateSwitch(&g_level_estimator, i, g_sensor_context.level_values[i] > 0.5f);
+        }
+    }
+
+    if (analog_valid) {
+        LevelEstimator_UpdateLevel(&g_level_estimator, level);
+    }
+
+    LevelEstimator_GetEstimate(&g_level_estimator, &g_sensor_context.level_estimate);
+}
+
 /**
  * @brief 读取流量传感器 (I2C)
  */
@@ -785,7 +1491,7 @@ static void Sensor_ReadFlowSensor(void)
 {
     sensor_type_t i = SENSOR_FLOW;
 
-    if (!g_sensor_configs[i].enabled) {
+    if (!Sensor_IsDue(i)) {
         return;
     }
 
@@ -796,6 +1502,11 @@ static void Sensor_ReadFlowSensor(void)
     // 应用滤波
     float filtered_value = Sensor_ApplyFilter(i, raw_value);
 
+    // 输出抽取 (滤波器每次采样都运行)
+    if (!Sensor_OutputDue(i)) {
+        return;
+    }
+
     // 应用标定
     float calibrated_value = Sensor_ApplyCalibration(i, filtered_value);
 
@@ -807,17 +1518,16 @@ static void Sensor_ReadFlowSensor(void)
     g_sensor_context.sensors[i].filtered_value = filtered_value;
     g_sensor_context.sensors[i].calibrated_value = calibrated_value;
     g_sensor_context.sensors[i].timestamp = HAL_GetTick();
+    g_sensor_context.sensors[i].acquire_time = Profiler_Now();
     g_sensor_context.sensors[i].valid = true;
     g_sensor_context.sensors[i].quality = quality;
 
     // 更新分类数据
     g_sensor_context.flow_value = calibrated_value;
-
-    g_sensor_stats.total_samples++;
 }
 
 /**
- * @brief 应用滤波算法 (移动平均滤波)
+ * @brief 应用滤波链
  * @param sensor_type 传感器类型
  * @param raw_value 原始值
  * @return 滤波后的值
@@ -828,26 +1538,121 @@ static float Sensor_ApplyFilter(sensor_type_t sensor_type, float raw_value)
         return raw_value;
     }
 
-    // 存储到滤波缓冲区
-    uint8_t index = g_filter_index[sensor_type];
-    g_filter_buffer[sensor_type][index] = raw_value;
+    // 切换到新配置的滤波链
+    if (g_filter_pending_flag[sensor_type]) {
+        sensor_filter_config_t config;
+
+        taskENTER_CRITICAL();
+        config = g_filter_pending[sensor_type];
+        g_filter_pending_flag[sensor_type] = false;
+        taskEXIT_CRITICAL();
+
+        SensorFilter_Init(&g_filters[sensor_type], &config);
+    }
+
+    // 指数滤波系数跟随传感器配置
+    SensorFilter_SetExponentialAlpha(&g_filters[sensor_type], g_sensor_configs[sensor_type].filter_coefficient);
+
+    float filtered_value = SensorFilter_Process(&g_filters[sensor_type], raw_value);
+
+    // 每个滤波样本 (不受输出抽取影响) 都送入正在进行的标定采集
+    Sensor_CalibrationSample(sensor_type, filtered_value);
+
+    return filtered_value;
+}
+
+/**
+ * @brief 标定样本采集
+ * @param sensor_type 传感器类型
+ * @param filtered_value 滤波后值
+ */
+static void Sensor_CalibrationSample(sensor_type_t sensor_type, float filtered_value)
+{
+    if (g_calib.state != SENSOR_CALIB_COLLECTING || g_calib.sensor_type != sensor_type) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    if (g_calib.state == SENSOR_CALIB_COLLECTING && g_calib.samples < CALIBRATION_SAMPLES) {
+        g_calib.sum += filtered_value;
+        g_calib.samples++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 标定服务 (每周期在采样之后调用)
+ */
+static void Sensor_ServiceCalibration(void)
+{
+    float x[SENSOR_CALIB_MAX_POINTS];
+    float y[SENSOR_CALIB_MAX_POINTS];
+    float coeffs[SENSOR_CALIB_COEFF_COUNT];
+    float rms = 0.0f;
+    sensor_type_t sensor_type;
+    uint8_t count;
+    uint8_t order;
+    bool point_done = false;
+    bool fit = false;
+    bool ok;
+
+    taskENTER_CRITICAL();
+    if (g_calib.state == SENSOR_CALIB_COLLECTING && g_calib.samples >= CALIBRATION_SAMPLES) {
+        g_calib.x[g_calib.point_count] = g_calib.sum / (float)g_calib.samples;
+        g_calib.y[g_calib.point_count] = g_calib.reference;
+        g_calib.point_count++;
+        g_calib.state = SENSOR_CALIB_READY;
+        point_done = true;
+    }
+    if (g_calib.state == SENSOR_CALIB_READY && g_calib.commit_requested) {
+        sensor_type = g_calib.sensor_type;
+        count = g_calib.point_count;
+        order = g_calib.commit_order;
+        memcpy(x, g_calib.x, sizeof(float) * count);
+        memcpy(y, g_calib.y, sizeof(float) * count);
+        fit = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (point_done) {
+        xEventGroupSetBits(xEventGroup_Sensor, EVENT_SENSOR_CALIB_POINT);
+    }
 
-    // 更新索引
-    g_filter_index[sensor_type] = (index + 1) % MAX_FILTER_SAMPLES;
+    if (!fit) {
+        return;
+    }
 
-    // 更新计数
-    if (g_filter_count[sensor_type] < MAX_FILTER_SAMPLES) {
-        g_filter_count[sensor_type]++;
+    // 拟合在临界区外进行, 输入为当前系数 (0阶时保留增益和二次项)
+    coeffs[0] = g_sensor_configs[sensor_type].offset;
+    coeffs[1] = g_sensor_configs[sensor_type].scale_factor;
+    coeffs[2] = g_sensor_configs[sensor_type].quadratic_factor;
+
+    ok = SensorCalib_Fit(x, y, count, order, coeffs, &rms);
+
+    // 三个系数一起替换, 本任务下一周期起使用新系数
+    taskENTER_CRITICAL();
+    if (ok) {
+        g_sensor_configs[sensor_type].offset = coeffs[0];
+        g_sensor_configs[sensor_type].scale_factor = coeffs[1];
+        g_sensor_configs[sensor_type].quadratic_factor = coeffs[2];
+        memcpy(g_calib.coeffs, coeffs, sizeof(coeffs));
+        g_calib.rms = rms;
     }
+    g_calib.state = ok ? SENSOR_CALIB_DONE : SENSOR_CALIB_FAILED;
+    g_calib.commit_requested = false;
+    taskEXIT_CRITICAL();
+
+    if (ok) {
+        printf("[SensorV3] Sensor %d calibrated: %d points, order %d, offset=%.4f, scale=%.6f, quad=%.3e, rms=%.4f\r\n",
+               sensor_type, count, order, coeffs[0], coeffs[1], coeffs[2], rms);
 
-    // 计算移动平均值
-    float sum = 0.0f;
-    uint8_t count = g_filter_count[sensor_type];
-    for (uint8_t i = 0; i < count; i++) {
-        sum += g_filter_buffer[sensor_type][i];
+        // 标定前的统计不再有参考意义
+        SensorTaskV3_ResetChannelStats(sensor_type);
+    } else {
+        printf("[SensorV3] Sensor %d calibration FAILED: %d points, order %d\r\n", sensor_type, count, order);
     }
 
-    return sum / count;
+    xEventGroupSetBits(xEventGroup_Sensor, EVENT_SENSOR_CALIBRATE);
 }
 
 /**
@@ -863,7 +1668,7 @@ static float Sensor_ApplyCalibration(sensor_type_t sensor_type, float filtered_v
     }
 
     sensor_config_t *config = &g_sensor_configs[sensor_type];
-    return (filtered_value * config->scale_factor) + config->offset;
+    return (config->quadratic_factor * filtered_value + config->scale_factor) * filtered_value + config->offset;
 }
 
 /**
@@ -878,7 +1683,8 @@ static uint8_t Sensor_CalculateQuality(sensor_type_t sensor_type)
     }
 
     // 基于滤波样本数量和变化率计算质量
-    uint8_t sample_quality = (g_filter_count[sensor_type] * 100) / MAX_FILTER_SAMPLES;
+    uint32_t samples = g_filters[sensor_type].samples;
+    uint8_t sample_quality = (uint8_t)(((samples < MAX_FILTER_SAMPLES) ? samples : MAX_FILTER_SAMPLES) * 100 / MAX_FILTER_SAMPLES);
 
     // TODO: 可以添加更多的质量检查逻辑
     // 例如: 检查值的变化率、范围检查等
@@ -891,12 +1697,40 @@ static uint8_t Sensor_CalculateQuality(sensor_type_t sensor_type)
  */
 static void Sensor_UpdateContext(void)
 {
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        // 上下文数据已经在读取传感器时更新
-        // 这里只需要设置系统就绪标志
-        g_sensor_context.system_ready = true;
+    // 本节拍产生新输出的通道序号加1, 消费者据此判断是否为新样本
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        if ((g_sensor_output_mask & (1U << i)) != 0) {
+            g_sensor_context.sensors[i].sequence++;
+        }
+    }
+
+    // 上下文数据已经在读取传感器时更新, 这里只需要设置系统就绪标志
+    g_sensor_context.system_ready = true;
+
+    // 取用待复位的通道
+    taskENTER_CRITICAL();
+    uint32_t reset_mask = g_channel_stats_reset_mask;
+    g_channel_stats_reset_mask = 0;
+    taskEXIT_CRITICAL();
 
-        xSemaphoreGive(xMutex_SensorContext);
+    // 更新各通道流式统计 (仅本节拍复位或更新了输出的通道), 有变化时发布统计快照
+    uint32_t changed = reset_mask;
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        if ((reset_mask & (1UL << i)) != 0) {
+            StreamStats_Init(&g_channel_stats[i]);
+        }
+        if ((g_sensor_output_mask & (1U << i)) != 0 && g_sensor_context.sensors[i].valid) {
+            StreamStats_Update(&g_channel_stats[i], g_sensor_context.sensors[i].calibrated_value);
+            changed |= (1UL << i);
+        }
+        if ((changed & (1UL << i)) != 0) {
+            // 无样本时StreamStats_GetSummary清零结果
+            (void)StreamStats_GetSummary(&g_channel_stats[i], &g_channel_summary[i]);
+        }
+    }
+
+    if (changed != 0) {
+        Seqlock_Publish(&g_channel_stats_seqlock, g_channel_summary);
     }
 }
 
@@ -944,6 +1778,11 @@ static void Sensor_InitializeHardware(void)
     // 初始化ADS8688 ADC
     BSP_ADS8688_Init();
 
+    // 启动后台采集, 之后每周期读取最新帧不再阻塞; 启动失败时退回阻塞扫描
+    if (BSP_ADS8688_StartAcquisition(ADS8688_ACQ_PERIOD_US_DEFAULT) != HAL_OK) {
+        printf("[SensorV3] ADS8688 background acquisition unavailable, using blocking scan\r\n");
+    }
+
     printf("[SensorV3] Hardware initialization completed\r\n");
 }
 
@@ -990,12 +1829,14 @@ BaseType_t SensorTaskV3_GetFloatSwitchStates(bool *switch_states)
         return pdFALSE;
     }
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
+    float level_values[3];
+
+    if (Seqlock_Read(&g_sensor_seqlock, offsetof(sensor_context_t, level_values),
+                     level_values, sizeof(level_values), NULL)) {
         // 从level_values[0-2]获取浮球开关状态，转换float为bool
         for (uint8_t i = 0; i < 3; i++) {
-            switch_states[i] = (g_sensor_context.level_values[i] > 0.5f);
+            switch_states[i] = (level_values[i] > 0.5f);
         }
-        xSemaphoreGive(xMutex_SensorContext);
         return pdTRUE;
     }
 
@@ -1009,13 +1850,28 @@ float SensorTaskV3_GetAnalogLevel(void)
 {
     float level_value = 0.0f;
 
-    if (xSemaphoreTake(xMutex_SensorContext, pdMS_TO_TICKS(10)) == pdTRUE) {
-        // 从level_values[3]获取模拟液位值
-        level_value = g_sensor_context.level_values[3];
-        xSemaphoreGive(xMutex_SensorContext);
-    }
+    // 从level_values[3]获取模拟液位值
+    Seqlock_Read(&g_sensor_seqlock, offsetof(sensor_context_t, level_values[3]),
+                 &level_value, sizeof(float), NULL);
 
     return level_value;
 }
 
+/**
+ * @brief 获取液位融合估计
+ */
+BaseType_t SensorTaskV3_GetLevelEstimate(level_estimate_t *estimate)
+{
+    if (estimate == NULL) {
+        return pdFALSE;
+    }
+
+    if (!Seqlock_Read(&g_sensor_seqlock, offsetof(sensor_context_t, level_estimate),
+                      estimate, sizeof(level_estimate_t), NULL)) {
+        return pdFALSE;
+    }
+
+    return estimate->valid ? pdTRUE : pdFALSE;
+}
+
 /************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,105 @@
+/**
+ ******************************************************************************
+ * @file    seqlock.c
+ * @brief   双缓冲顺序锁(seqlock)快照发布实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 第n次发布写入buffers[n & 1]. 写入第n+1次时sequence = 2n+1, 写的是另一个
+ * 缓冲区, 读者仍可读取第n次的数据; 直到第n+2次开始(sequence = 2n+3)才会覆盖.
+ * 因此读者以读前sequence向下取偶为基准, 读后sequence超过基准+2即重试.
+ ******************************************************************************
+ */
+
+#include "seqlock.h"
+#include "stm32f4xx_hal.h"
+#include <string.h>
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化顺序锁
+ */
+void Seqlock_Init(seqlock_t *lock, void *buffer0, void *buffer1, uint16_t size)
+{
+    if (lock == NULL) {
+        return;
+    }
+
+    lock->sequence = 0;
+    lock->buffers[0] = buffer0;
+    lock->buffers[1] = buffer1;
+    lock->size = size;
+}
+
+/**
+ * @brief 发布一份快照
+ */
+void Seqlock_Publish(seqlock_t *lock, const void *data)
+{
+    uint32_t next;
+
+    if (lock == NULL || data == NULL) {
+        return;
+    }
+
+    next = (lock->sequence >> 1) + 1;
+
+    lock->sequence++;
+    __DMB();
+
+    memcpy(lock->buffers[next & 1], data, lock->size);
+
+    __DMB();
+    lock->sequence++;
+}
+
+/**
+ * @brief 读取最近一次发布的快照的一部分
+ */
+bool Seqlock_Read(const seqlock_t *lock, uint16_t offset, void *dst, uint16_t size, uint32_t *sequence)
+{
+    uint32_t start;
+    uint32_t end;
+
+    if (lock == NULL || dst == NULL || (uint32_t)offset + size > lock->size) {
+        return false;
+    }
+
+    for (uint8_t retry = 0; retry < SEQLOCK_READ_RETRIES; retry++) {
+        start = lock->sequence & ~1UL;
+        if (start == 0) {
+            return false;
+        }
+        __DMB();
+
+        memcpy(dst, (const uint8_t *)lock->buffers[(start >> 1) & 1] + offset, size);
+
+        __DMB();
+        end = lock->sequence;
+
+        if ((end - start) <= 2) {
+            if (sequence != NULL) {
+                *sequence = start >> 1;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief 获取已发布次数
+ */
+uint32_t Seqlock_GetSequence(const seqlock_t *lock)
+{
+    return (lock != NULL) ? (lock->sequence >> 1) : 0;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,285 @@
+/**
+ ******************************************************************************
+ * @file    stream_stats.c
+ * @brief   流式统计引擎实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * P²算法参考 Jain & Chlamtac, "The P² Algorithm for Dynamic Calculation
+ * of Quantiles and Histograms Without Storing Observations", 1985.
+ ******************************************************************************
+ */
+
+#include "stream_stats.h"
+#include <string.h>
+#include <math.h>
+
+/* ========================================================================== */
+/* 私有变量 */
+/* ========================================================================== */
+
+static const float g_quantile_targets[STREAM_STATS_QUANTILE_COUNT] = {0.50f, 0.95f, 0.99f};
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static void StreamStats_DequePush(stream_stats_deque_t *dq, float value, uint32_t seq, bool keep_min);
+static void StreamStats_P2Init(stream_stats_p2_t *p2, float p);
+static void StreamStats_P2Update(stream_stats_p2_t *p2, float value, uint32_t count);
+static float StreamStats_P2Estimate(const stream_stats_p2_t *p2, uint32_t count);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化(复位)统计
+ */
+void StreamStats_Init(stream_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    memset(stats, 0, sizeof(stream_stats_t));
+
+    for (uint8_t i = 0; i < STREAM_STATS_QUANTILE_COUNT; i++) {
+        StreamStats_P2Init(&stats->quantiles[i], g_quantile_targets[i]);
+    }
+}
+
+/**
+ * @brief 加入一个样本
+ */
+void StreamStats_Update(stream_stats_t *stats, float value)
+{
+    double delta;
+
+    if (stats == NULL || !isfinite(value)) {
+        return;
+    }
+
+    stats->count++;
+
+    // Welford均值/方差
+    delta = (double)value - stats->mean;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * ((double)value - stats->mean);
+
+    // 累计极值
+    if (stats->count == 1) {
+        stats->min = value;
+        stats->max = value;
+    } else {
+        if (value < stats->min) stats->min = value;
+        if (value > stats->max) stats->max = value;
+    }
+
+    // 窗口极值 (序号即样本计数)
+    StreamStats_DequePush(&stats->win_min, value, stats->count, true);
+    StreamStats_DequePush(&stats->win_max, value, stats->count, false);
+
+    // 分位数
+    for (uint8_t i = 0; i < STREAM_STATS_QUANTILE_COUNT; i++) {
+        StreamStats_P2Update(&stats->quantiles[i], value, stats->count);
+    }
+}
+
+/**
+ * @brief 获取统计结果
+ */
+bool StreamStats_GetSummary(const stream_stats_t *stats, stream_stats_summary_t *summary)
+{
+    if (summary == NULL) {
+        return false;
+    }
+
+    memset(summary, 0, sizeof(stream_stats_summary_t));
+
+    if (stats == NULL || stats->count == 0) {
+        return false;
+    }
+
+    summary->count = stats->count;
+    summary->mean = (float)stats->mean;
+    summary->variance = (stats->count > 1) ? (float)(stats->m2 / (double)(stats->count - 1)) : 0.0f;
+    summary->stddev = sqrtf(summary->variance);
+    summary->min = stats->min;
+    summary->max = stats->max;
+    summary->window_min = stats->win_min.value[stats->win_min.head];
+    summary->window_max = stats->win_max.value[stats->win_max.head];
+
+    for (uint8_t i = 0; i < STREAM_STATS_QUANTILE_COUNT; i++) {
+        summary->quantiles[i] = StreamStats_P2Estimate(&stats->quantiles[i], stats->count);
+    }
+
+    return true;
+}
+
+/**
+ * @brief 获取单个分位数估计
+ */
+float StreamStats_GetQuantile(const stream_stats_t *stats, stream_stats_quantile_t quantile)
+{
+    if (stats == NULL || quantile >= STREAM_STATS_QUANTILE_COUNT || stats->count == 0) {
+        return 0.0f;
+    }
+
+    return StreamStats_P2Estimate(&stats->quantiles[quantile], stats->count);
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 单调队列入队
+ * @param dq 队列
+ * @param value 样本值
+ * @param seq 样本序号
+ * @param keep_min true=维护最小值(队列递增), false=维护最大值(队列递减)
+ */
+static void StreamStats_DequePush(stream_stats_deque_t *dq, float value, uint32_t seq, bool keep_min)
+{
+    uint8_t tail;
+
+    // 弹出队尾被新样本支配的候选
+    while (dq->size > 0) {
+        tail = (uint8_t)((dq->head + dq->size - 1) % STREAM_STATS_WINDOW_SIZE);
+        if (keep_min ? (dq->value[tail] >= value) : (dq->value[tail] <= value)) {
+            dq->size--;
+        } else {
+            break;
+        }
+    }
+
+    // 弹出队首已移出窗口的样本
+    if (dq->size > 0 && (seq - dq->seq[dq->head]) >= STREAM_STATS_WINDOW_SIZE) {
+        dq->head = (uint8_t)((dq->head + 1) % STREAM_STATS_WINDOW_SIZE);
+        dq->size--;
+    }
+
+    tail = (uint8_t)((dq->head + dq->size) % STREAM_STATS_WINDOW_SIZE);
+    dq->value[tail] = value;
+    dq->seq[tail] = seq;
+    dq->size++;
+}
+
+/**
+ * @brief 初始化P²估计器
+ */
+static void StreamStats_P2Init(stream_stats_p2_t *p2, float p)
+{
+    p2->p = p;
+
+    for (uint8_t i = 0; i < 5; i++) {
+        p2->q[i] = 0.0f;
+        p2->n[i] = i;
+    }
+
+    p2->np[0] = 0.0;
+    p2->np[1] = 2.0 * p;
+    p2->np[2] = 4.0 * p;
+    p2->np[3] = 2.0 + 2.0 * p;
+    p2->np[4] = 4.0;
+
+    p2->dn[0] = 0.0;
+    p2->dn[1] = p / 2.0;
+    p2->dn[2] = p;
+    p2->dn[3] = (1.0 + p) / 2.0;
+    p2->dn[4] = 1.0;
+}
+
+/**
+ * @brief P²估计器加入样本
+ * @param p2 估计器
+ * @param value 样本值
+ * @param count 含本样本在内的样本总数
+ */
+static void StreamStats_P2Update(stream_stats_p2_t *p2, float value, uint32_t count)
+{
+    int8_t k;
+
+    // 前5个样本: 插入排序作为初始标记点
+    if (count <= 5) {
+        k = (int8_t)(count - 1);
+        while (k > 0 && p2->q[k - 1] > value) {
+            p2->q[k] = p2->q[k - 1];
+            k--;
+        }
+        p2->q[k] = value;
+        return;
+    }
+
+    // 定位样本所在区间, 必要时扩展端点
+    if (value < p2->q[0]) {
+        p2->q[0] = value;
+        k = 0;
+    } else if (value >= p2->q[4]) {
+        p2->q[4] = value;
+        k = 3;
+    } else {
+        k = 0;
+        while (k < 3 && value >= p2->q[k + 1]) {
+            k++;
+        }
+    }
+
+    for (uint8_t i = (uint8_t)(k + 1); i < 5; i++) {
+        p2->n[i]++;
+    }
+    for (uint8_t i = 0; i < 5; i++) {
+        p2->np[i] += p2->dn[i];
+    }
+
+    // 调整中间3个标记点
+    for (uint8_t i = 1; i < 4; i++) {
+        double d = p2->np[i] - (double)p2->n[i];
+
+        if ((d >= 1.0 && (p2->n[i + 1] - p2->n[i]) > 1) ||
+            (d <= -1.0 && (p2->n[i - 1] - p2->n[i]) < -1)) {
+            int32_t ds = (d >= 0.0) ? 1 : -1;
+            // 位置差为小整数, 按float计算插值不损失精度
+            float n_prev = (float)(p2->n[i - 1] - p2->n[i]);
+            float n_next = (float)(p2->n[i + 1] - p2->n[i]);
+            float qp;
+
+            // 抛物线(P²)插值 (以当前标记点位置为原点)
+            qp = p2->q[i] + (float)ds / (n_next - n_prev) *
+                 ((-n_prev + (float)ds) * (p2->q[i + 1] - p2->q[i]) / n_next +
+                  (n_next - (float)ds) * (p2->q[i] - p2->q[i - 1]) / (-n_prev));
+
+            if (p2->q[i - 1] < qp && qp < p2->q[i + 1]) {
+                p2->q[i] = qp;
+            } else {
+                // 抛物线越界时退化为线性插值
+                p2->q[i] += (float)ds * (p2->q[i + ds] - p2->q[i]) /
+                            (float)(p2->n[i + ds] - p2->n[i]);
+            }
+
+            p2->n[i] += ds;
+        }
+    }
+}
+
+/**
+ * @brief P²估计器输出
+ */
+static float StreamStats_P2Estimate(const stream_stats_p2_t *p2, uint32_t count)
+{
+    uint32_t index;
+
+    if (count > 5) {
+        return p2->q[2];
+    }
+
+    // 样本不足5个时直接取排序后的最近秩
+    index = (uint32_t)(p2->p * (float)(count - 1) + 0.5f);
+    return p2->q[index];
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
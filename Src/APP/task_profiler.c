@@ -0,0 +1,243 @@
+/**
+ ******************************************************************************
+ * @file    task_profiler.c
+ * @brief   任务分阶段周期计时实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#include "task_profiler.h"
+#include <string.h>
+
+#ifdef PROFILER_HOST_CLOCK
+#define PROFILER_ENTER_CRITICAL()
+#define PROFILER_EXIT_CRITICAL()
+#else
+#include "FreeRTOS.h"
+#include "task.h"
+#define PROFILER_ENTER_CRITICAL()       taskENTER_CRITICAL()
+#define PROFILER_EXIT_CRITICAL()        taskEXIT_CRITICAL()
+#endif
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static void Profiler_ResetStats(profiler_stats_t *stats);
+static void Profiler_EnableCounter(void);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化计时器
+ */
+void Profiler_Init(profiler_t *profiler, const char *const *phase_names, uint8_t phase_count)
+{
+    if (profiler == NULL) {
+        return;
+    }
+
+    Profiler_EnableCounter();
+
+    memset(profiler, 0, sizeof(profiler_t));
+    profiler->phase_names = phase_names;
+    profiler->phase_count = (phase_count > PROFILER_MAX_PHASES) ? PROFILER_MAX_PHASES : phase_count;
+    profiler->current = PROFILER_PHASE_NONE;
+
+#ifdef PROFILER_HOST_CLOCK
+    profiler->cycles_per_us = 1000;
+#else
+    profiler->cycles_per_us = SystemCoreClock / 1000000U;
+#endif
+
+    Profiler_Reset(profiler);
+}
+
+/**
+ * @brief 清除统计
+ */
+void Profiler_Reset(profiler_t *profiler)
+{
+    if (profiler == NULL) {
+        return;
+    }
+
+    PROFILER_ENTER_CRITICAL();
+    for (uint8_t i = 0; i < PROFILER_MAX_PHASES; i++) {
+        Profiler_ResetStats(&profiler->phases[i]);
+    }
+    Profiler_ResetStats(&profiler->cycle);
+    PROFILER_EXIT_CRITICAL();
+}
+
+/**
+ * @brief 周期开始
+ */
+void Profiler_CycleBegin(profiler_t *profiler)
+{
+    uint32_t now = Profiler_Now();
+
+    profiler->cycle_start = now;
+    profiler->phase_start = now;
+    profiler->current = PROFILER_PHASE_NONE;
+}
+
+/**
+ * @brief 进入阶段
+ */
+void Profiler_Phase(profiler_t *profiler, uint8_t phase)
+{
+    uint32_t now = Profiler_Now();
+
+    if (profiler->current < profiler->phase_count) {
+        Profiler_Record(&profiler->phases[profiler->current], now - profiler->phase_start,
+                        profiler->cycles_per_us);
+    }
+
+    profiler->current = (phase < profiler->phase_count) ? phase : PROFILER_PHASE_NONE;
+    profiler->phase_start = now;
+}
+
+/**
+ * @brief 周期结束
+ */
+uint32_t Profiler_CycleEnd(profiler_t *profiler)
+{
+    uint32_t now = Profiler_Now();
+    uint32_t cycles = now - profiler->cycle_start;
+
+    if (profiler->current < profiler->phase_count) {
+        Profiler_Record(&profiler->phases[profiler->current], now - profiler->phase_start,
+                        profiler->cycles_per_us);
+    }
+    profiler->current = PROFILER_PHASE_NONE;
+
+    Profiler_Record(&profiler->cycle, cycles, profiler->cycles_per_us);
+
+    return cycles / profiler->cycles_per_us;
+}
+
+/**
+ * @brief 记录一次耗时
+ */
+void Profiler_Record(profiler_stats_t *stats, uint32_t cycles, uint32_t cycles_per_us)
+{
+    // 不加锁: 读者在临界区内复制, 所属任务更新期间不会被读者打断
+    stats->count++;
+    stats->total_cycles += cycles;
+    if (cycles < stats->min_cycles) {
+        stats->min_cycles = cycles;
+    }
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    stats->hist[Profiler_HistBin(cycles / cycles_per_us)]++;
+}
+
+/**
+ * @brief 耗时对应的直方图档
+ */
+uint8_t Profiler_HistBin(uint32_t us)
+{
+    uint8_t bin;
+
+    if (us == 0) {
+        return 0;
+    }
+
+    // 档号 = 最高有效位位置 + 1
+#ifdef PROFILER_HOST_CLOCK
+    bin = 0;
+    while (us != 0) {
+        us >>= 1;
+        bin++;
+    }
+#else
+    bin = (uint8_t)(32U - __CLZ(us));
+#endif
+
+    return (bin < PROFILER_HIST_BINS) ? bin : (uint8_t)(PROFILER_HIST_BINS - 1);
+}
+
+/**
+ * @brief 整个周期的最大/平均耗时
+ */
+void Profiler_GetCycleTimes(const profiler_t *profiler, uint32_t *max_us, uint32_t *mean_us)
+{
+    const profiler_stats_t *cycle = &profiler->cycle;
+
+    if (cycle->count == 0) {
+        *max_us = 0;
+        *mean_us = 0;
+        return;
+    }
+
+    *max_us = cycle->max_cycles / profiler->cycles_per_us;
+    *mean_us = (uint32_t)(cycle->total_cycles / cycle->count / profiler->cycles_per_us);
+}
+
+/**
+ * @brief 获取统计结果
+ */
+bool Profiler_GetSummary(const profiler_t *profiler, uint8_t phase, profiler_summary_t *summary)
+{
+    profiler_stats_t stats;
+
+    if (profiler == NULL || summary == NULL ||
+        (phase != PROFILER_PHASE_NONE && phase >= profiler->phase_count)) {
+        return false;
+    }
+
+    PROFILER_ENTER_CRITICAL();
+    stats = (phase == PROFILER_PHASE_NONE) ? profiler->cycle : profiler->phases[phase];
+    PROFILER_EXIT_CRITICAL();
+
+    memset(summary, 0, sizeof(profiler_summary_t));
+    summary->name = (phase == PROFILER_PHASE_NONE || profiler->phase_names == NULL) ?
+                    NULL : profiler->phase_names[phase];
+    summary->count = stats.count;
+    memcpy(summary->hist, stats.hist, sizeof(summary->hist));
+
+    if (stats.count > 0) {
+        float scale = 1.0f / (float)profiler->cycles_per_us;
+
+        summary->min_us = (float)stats.min_cycles * scale;
+        summary->max_us = (float)stats.max_cycles * scale;
+        summary->mean_us = (float)stats.total_cycles / (float)stats.count * scale;
+    }
+
+    return true;
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 清除单项统计
+ */
+static void Profiler_ResetStats(profiler_stats_t *stats)
+{
+    memset(stats, 0, sizeof(profiler_stats_t));
+    stats->min_cycles = UINT32_MAX;
+}
+
+/**
+ * @brief 启用DWT周期计数器 (已启用时不复位, 多个任务共用)
+ */
+static void Profiler_EnableCounter(void)
+{
+#ifndef PROFILER_HOST_CLOCK
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -0,0 +1,214 @@
+/**
+ ******************************************************************************
+ * @file    time_proportion.c
+ * @brief   继电器时间比例输出实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 每拍按当前需求重新计算本窗口导通时长, 窗口内需求变化即时生效.
+ * 每个窗口的需求积分与实际导通时间之差记入carry_ms, 在后续窗口补偿
+ * (一阶Σ-Δ), 因此取整/最小导通/关断限制不影响平均功率, 低占空比表现
+ * 为间隔若干窗口的最小导通脉冲.
+ ******************************************************************************
+ */
+
+#include "time_proportion.h"
+#include <string.h>
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static uint32_t TimeProportion_Plan(const time_proportion_t *tp, float wanted, uint32_t elapsed_ms);
+static void TimeProportion_SetOutput(time_proportion_t *tp, bool output);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 检查配置是否合法
+ */
+bool TimeProportion_CheckConfig(const time_proportion_config_t *config)
+{
+    if (config == NULL || config->window_ms == 0) {
+        return false;
+    }
+
+    return (config->min_on_ms + config->min_off_ms) <= config->window_ms;
+}
+
+/**
+ * @brief 初始化通道
+ */
+bool TimeProportion_Init(time_proportion_t *tp, const time_proportion_config_t *config,
+                         uint32_t phase_offset_ms)
+{
+    if (tp == NULL || !TimeProportion_CheckConfig(config)) {
+        return false;
+    }
+
+    memset(tp, 0, sizeof(time_proportion_t));
+    tp->config = *config;
+    tp->phase_ms = phase_offset_ms % config->window_ms;
+    tp->window_start = (tp->phase_ms == 0);
+
+    // 首个窗口开始前保持关断, 不完整窗口的需求不计入累积量
+    tp->window_done = true;
+    tp->state_time_ms = config->min_off_ms;
+
+    return true;
+}
+
+/**
+ * @brief 运行一拍
+ */
+bool TimeProportion_Update(time_proportion_t *tp, float demand, uint32_t elapsed_ms)
+{
+    float window;
+    bool output;
+
+    if (tp == NULL || elapsed_ms == 0) {
+        return false;
+    }
+
+    window = (float)tp->config.window_ms;
+
+    if (demand < 0.0f) demand = 0.0f;
+    if (demand > 100.0f) demand = 100.0f;
+
+    tp->state_time_ms += elapsed_ms;
+
+    // 窗口开始: 上一窗口的需求与实际导通之差记入累积量
+    if (tp->window_start) {
+        tp->window_start = false;
+        tp->carry_ms += tp->demand_ms - tp->delivered_ms;
+        if (tp->carry_ms > window) tp->carry_ms = window;
+        if (tp->carry_ms < -window) tp->carry_ms = -window;
+        tp->demand_ms = 0.0f;
+        tp->delivered_ms = 0.0f;
+        tp->window_done = false;
+        tp->synced = true;
+    }
+
+    // 需求撤销: 不再欠补偿, 提前结束本窗口导通段
+    if (demand <= 0.0f) {
+        tp->carry_ms = 0.0f;
+        tp->demand_ms = 0.0f;
+        tp->delivered_ms = 0.0f;
+        tp->on_time_ms = 0;
+    } else {
+        if (tp->synced) {
+            tp->demand_ms += demand * 0.01f * (float)elapsed_ms;
+        }
+        tp->on_time_ms = TimeProportion_Plan(tp, demand * 0.01f * window + tp->carry_ms, elapsed_ms);
+    }
+
+    // 窗口前段导通, 本窗口关断后不再重新导通
+    output = !tp->window_done && (tp->phase_ms < tp->on_time_ms);
+
+    // 最小导通/关断时间兜底 (需求突变/复位后等跨窗口情况)
+    if (output != tp->output) {
+        uint32_t min_ms = tp->output ? tp->config.min_on_ms : tp->config.min_off_ms;
+
+        if (tp->state_time_ms < min_ms) {
+            output = tp->output;
+        }
+    }
+
+    if (tp->output && !output) {
+        tp->window_done = true;
+    }
+    TimeProportion_SetOutput(tp, output);
+    if (output) {
+        tp->delivered_ms += (float)elapsed_ms;
+    }
+
+    // 减去窗口长度, 保留越过窗口终点的部分: 调用周期不整除窗口时窗口长度和相位错开不漂移
+    tp->phase_ms += elapsed_ms;
+    if (tp->phase_ms >= tp->config.window_ms) {
+        tp->phase_ms = (tp->phase_ms - tp->config.window_ms) % tp->config.window_ms;
+        tp->window_start = true;
+    }
+
+    return tp->output;
+}
+
+/**
+ * @brief 立即关断并清除累积量
+ */
+void TimeProportion_Reset(time_proportion_t *tp)
+{
+    if (tp == NULL) {
+        return;
+    }
+
+    // 保留相位, 多路通道之间的错开关系不变
+    tp->on_time_ms = 0;
+    tp->carry_ms = 0.0f;
+    tp->demand_ms = 0.0f;
+    tp->delivered_ms = 0.0f;
+    tp->window_done = true;
+    tp->synced = false;
+    if (tp->output) {
+        tp->output = false;
+        tp->state_time_ms = 0;
+        tp->switch_count++;
+    }
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 计算本窗口导通时长
+ * @param tp 通道
+ * @param wanted 期望导通时长 (ms, 含累积量)
+ * @param elapsed_ms 调用周期 (ms), 导通时长按此取整
+ * @return 导通时长 (ms)
+ */
+static uint32_t TimeProportion_Plan(const time_proportion_t *tp, float wanted, uint32_t elapsed_ms)
+{
+    const time_proportion_config_t *config = &tp->config;
+    uint32_t on_ms;
+
+    // 按调用周期四舍五入
+    if (wanted <= 0.0f) {
+        on_ms = 0;
+    } else if (wanted >= (float)config->window_ms) {
+        on_ms = config->window_ms;
+    } else {
+        on_ms = ((uint32_t)(wanted + 0.5f * (float)elapsed_ms) / elapsed_ms) * elapsed_ms;
+    }
+
+    // 导通段过短: 取最小导通时间或不导通 (已在导通中则由最小导通时间兜底)
+    if (on_ms < config->min_on_ms && !tp->output) {
+        on_ms = (wanted >= 0.5f * (float)config->min_on_ms) ? config->min_on_ms : 0;
+    }
+
+    // 关断段过短: 整窗导通或留出最小关断时间
+    if (on_ms < config->window_ms && (config->window_ms - on_ms) < config->min_off_ms) {
+        on_ms = ((float)config->window_ms - wanted < 0.5f * (float)config->min_off_ms) ?
+                config->window_ms : config->window_ms - config->min_off_ms;
+    }
+
+    return on_ms;
+}
+
+/**
+ * @brief 设置输出并统计开关次数
+ */
+static void TimeProportion_SetOutput(time_proportion_t *tp, bool output)
+{
+    if (output != tp->output) {
+        tp->output = output;
+        tp->state_time_ms = 0;
+        tp->switch_count++;
+    }
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
@@ -23,24 +23,476 @@
 #define _SSC_INKCONTROL_ 1
 #include "SSC-Ink-control.h"
 #undef _SSC_INKCONTROL_
+
+#include "ethercat_process_image.h"
+#include "ethercat_oversampling.h"
+#include "latency_trace.h"
+#include "control_task_v3.h"
+#include "sensor_simulator.h"
+#include "ethercat_sensor_bridge.h"
+#include "ethercat_output_monitor.h"
 /*--------------------------------------------------------------------------------------
 ------
 ------    local types and defines
 ------
 --------------------------------------------------------------------------------------*/
 
+/* 0x7010 carries one 16 bit entry per output monitor field */
+typedef char _master_outputs_layout_check[(sizeof(TOBJ7010) == (1 + OUTPUT_FIELD_COUNT) * sizeof(UINT16)) ? 1 : -1];
+
+/* Register 0x0990: system time of the next SYNC0 pulse (lower 32 bit) */
+#define ESC_DC_NEXT_SYNC0_OFFSET        0x0990
+
 /*-----------------------------------------------------------------------------------------
 ------
 ------    local variables and constants
 ------
 -----------------------------------------------------------------------------------------*/
 
+/* SYNC0 cycle time the oversampling was started with (ns) */
+static UINT32 u32OversamplingCycleTime = 0;
+
+/* length of the 0x1A01 process data (words), valid while the input handler is running */
+static UINT16 u16OversamplingPdoWords = 0;
+
 /*-----------------------------------------------------------------------------------------
 ------
 ------    application specific functions
 ------
 -----------------------------------------------------------------------------------------*/
 
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+ \param     index               index of the requested object.
+ \param     subindex            subindex of the requested object.
+ \param     dataSize            received data size of the SDO Upload
+ \param     pData               Pointer to the buffer where the data shall be copied to
+ \param     bCompleteAccess     Indicates if a complete read of all subindices of the
+                                object shall be done or not
+
+ \return    result of the read operation (0 (success) or an abort code (ABORTIDX_.... defined in
+            sdosrv.h))
+
+ \brief     Read function of object 0x2000. The entries are refreshed from the streaming
+            statistics of the channel selected in subindex 1 before they are copied.
+*////////////////////////////////////////////////////////////////////////////////////////
+UINT8 Read0x2000( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess )
+{
+    stream_stats_summary_t summary;
+    UINT16 wordOffset;
+
+    if (SensorStatistics0x2000.ChannelSelect >= SENSOR_COUNT)
+    {
+        return ABORTIDX_VALUE_EXCEEDED;
+    }
+
+    /* an empty channel reads as all zero, a failed snapshot read aborts the upload */
+    if (SensorTaskV3_GetChannelStats((sensor_type_t)SensorStatistics0x2000.ChannelSelect, &summary) != pdTRUE)
+    {
+        return ABORTIDX_DATA_CANNOT_BE_ACCESSED_BECAUSE_OF_LOCAL_CONTROL;
+    }
+
+    SensorStatistics0x2000.SampleCount = summary.count;
+    SensorStatistics0x2000.Mean = summary.mean;
+    SensorStatistics0x2000.StandardDeviation = summary.stddev;
+    SensorStatistics0x2000.Minimum = summary.min;
+    SensorStatistics0x2000.Maximum = summary.max;
+    SensorStatistics0x2000.WindowMinimum = summary.window_min;
+    SensorStatistics0x2000.WindowMaximum = summary.window_max;
+    SensorStatistics0x2000.Percentile50 = summary.quantiles[STREAM_STATS_P50];
+    SensorStatistics0x2000.Percentile95 = summary.quantiles[STREAM_STATS_P95];
+    SensorStatistics0x2000.Percentile99 = summary.quantiles[STREAM_STATS_P99];
+
+    /* word offset of the first requested entry (subindex 0 and 1 are 16 bit, all others 32 bit) */
+    if (subindex <= 1)
+    {
+        wordOffset = subindex;
+    }
+    else if (bCompleteAccess)
+    {
+        /* complete access is only supported starting with subindex 0 or 1 */
+        return ABORTIDX_UNSUPPORTED_ACCESS;
+    }
+    else
+    {
+        wordOffset = 2 + ((subindex - 2) << 1);
+    }
+
+    MEMCPY(pData, ((UINT16 *) &SensorStatistics0x2000) + wordOffset, dataSize);
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+ \param     index               index of the requested object.
+ \param     subindex            subindex of the requested object.
+ \param     dataSize            received data size of the SDO Upload
+ \param     pData               Pointer to the buffer where the data shall be copied to
+ \param     bCompleteAccess     Indicates if a complete read of all subindices of the
+                                object shall be done or not
+
+ \return    result of the read operation (0 (success) or an abort code (ABORTIDX_.... defined in
+            sdosrv.h))
+
+ \brief     Read function of object 0x2001. The entries are refreshed from the sample-to-output
+            latency trace of the control loop selected in subindex 1 before they are copied.
+*////////////////////////////////////////////////////////////////////////////////////////
+UINT8 Read0x2001( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess )
+{
+    profiler_summary_t control;
+    profiler_summary_t output;
+    UINT16 wordOffset;
+
+    if (LoopLatency0x2001.LoopSelect >= LATENCY_TRACE_MAX_LOOPS)
+    {
+        return ABORTIDX_VALUE_EXCEEDED;
+    }
+
+    /* a loop without traced samples reads as all zero */
+    LatencyTrace_GetSummary((UINT8) LoopLatency0x2001.LoopSelect, LATENCY_STAGE_CONTROL, &control);
+    LatencyTrace_GetSummary((UINT8) LoopLatency0x2001.LoopSelect, LATENCY_STAGE_OUTPUT, &output);
+
+    LoopLatency0x2001.ControlSampleCount = control.count;
+    LoopLatency0x2001.ControlMinimum = control.min_us;
+    LoopLatency0x2001.ControlMean = control.mean_us;
+    LoopLatency0x2001.ControlMaximum = control.max_us;
+    LoopLatency0x2001.OutputSampleCount = output.count;
+    LoopLatency0x2001.OutputMinimum = output.min_us;
+    LoopLatency0x2001.OutputMean = output.mean_us;
+    LoopLatency0x2001.OutputMaximum = output.max_us;
+
+    /* the histogram entries are consecutive 32 bit words, one per PROFILER_HIST_BINS */
+    MEMCPY(&LoopLatency0x2001.OutputHistogram0, output.hist, sizeof(output.hist));
+
+    /* word offset of the first requested entry (subindex 0 and 1 are 16 bit, all others 32 bit) */
+    if (subindex <= 1)
+    {
+        wordOffset = subindex;
+    }
+    else if (bCompleteAccess)
+    {
+        /* complete access is only supported starting with subindex 0 or 1 */
+        return ABORTIDX_UNSUPPORTED_ACCESS;
+    }
+    else
+    {
+        wordOffset = 2 + ((subindex - 2) << 1);
+    }
+
+    MEMCPY(pData, ((UINT16 *) &LoopLatency0x2001) + wordOffset, dataSize);
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+ \param     index               index of the requested object.
+ \param     subindex            subindex of the requested object.
+ \param     dataSize            received data size of the SDO Upload
+ \param     pData               Pointer to the buffer where the data shall be copied to
+ \param     bCompleteAccess     Indicates if a complete read of all subindices of the
+                                object shall be done or not
+
+ \return    result of the read operation (0 (success) or an abort code (ABORTIDX_.... defined in
+            sdosrv.h))
+
+ \brief     Read function of object 0x2002. The entries are refreshed from the performance
+            indicators of the control loop selected in subindex 1 before they are copied.
+*////////////////////////////////////////////////////////////////////////////////////////
+UINT8 Read0x2002( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess )
+{
+    loop_kpi_summary_t summary;
+    UINT16 wordOffset;
+
+    if (LoopKpi0x2002.LoopSelect >= CONTROL_LOOP_COUNT)
+    {
+        return ABORTIDX_VALUE_EXCEEDED;
+    }
+
+    /* a loop that has not run yet reads as all zero */
+    ControlTaskV3_GetLoopKpi((control_loop_t) LoopKpi0x2002.LoopSelect, &summary);
+
+    LoopKpi0x2002.SampleCount = summary.samples;
+    LoopKpi0x2002.WindowTime = summary.window_time;
+    LoopKpi0x2002.IAE = summary.iae;
+    LoopKpi0x2002.ISE = summary.ise;
+    LoopKpi0x2002.ITAE = summary.itae;
+    LoopKpi0x2002.Overshoot = summary.overshoot;
+    LoopKpi0x2002.SettlingTime = summary.settling_time;
+    LoopKpi0x2002.Settled = summary.settled ? 1 : 0;
+    LoopKpi0x2002.OscillationIndex = summary.oscillation_index;
+    LoopKpi0x2002.Saturation = summary.saturation;
+    LoopKpi0x2002.StepCount = summary.step_count;
+
+    /* word offset of the first requested entry (subindex 0 and 1 are 16 bit, all others 32 bit) */
+    if (subindex <= 1)
+    {
+        wordOffset = subindex;
+    }
+    else if (bCompleteAccess)
+    {
+        /* complete access is only supported starting with subindex 0 or 1 */
+        return ABORTIDX_UNSUPPORTED_ACCESS;
+    }
+    else
+    {
+        wordOffset = 2 + ((subindex - 2) << 1);
+    }
+
+    MEMCPY(pData, ((UINT16 *) &LoopKpi0x2002) + wordOffset, dataSize);
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+ \param     index               index of the requested object.
+ \param     subindex            subindex of the requested object.
+ \param     dataSize            received data size of the SDO Upload
+ \param     pData               Pointer to the buffer where the data shall be copied to
+ \param     bCompleteAccess     Indicates if a complete read of all subindices of the
+                                object shall be done or not
+
+ \return    result of the read operation (0 (success) or an abort code (ABORTIDX_.... defined in
+            sdosrv.h))
+
+ \brief     Read function of object 0x2003. Active and Prediction are refreshed from the control
+            loop selected in subindex 1, the model entries read back as staged.
+*////////////////////////////////////////////////////////////////////////////////////////
+UINT8 Read0x2003( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess )
+{
+    control_smith_config_t model;
+    float correction = 0.0f;
+    bool active = false;
+    UINT16 wordOffset;
+
+    if (DeadTimeCompensation0x2003.LoopSelect >= CONTROL_LOOP_COUNT)
+    {
+        return ABORTIDX_VALUE_EXCEEDED;
+    }
+
+    ControlTaskV3_GetSmithPredictor((control_loop_t) DeadTimeCompensation0x2003.LoopSelect, &model, &correction, &active);
+    DeadTimeCompensation0x2003.Active = active ? 1 : 0;
+    DeadTimeCompensation0x2003.Prediction = correction;
+
+    /* word offset of the first requested entry (subindex 0 and 1 are 16 bit, all others 32 bit) */
+    if (subindex <= 1)
+    {
+        wordOffset = subindex;
+    }
+    else if (bCompleteAccess)
+    {
+        /* complete access is only supported starting with subindex 0 or 1 */
+        return ABORTIDX_UNSUPPORTED_ACCESS;
+    }
+    else
+    {
+        wordOffset = 2 + ((subindex - 2) << 1);
+    }
+
+    MEMCPY(pData, ((UINT16 *) &DeadTimeCompensation0x2003) + wordOffset, dataSize);
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+ \param     index               index of the requested object.
+ \param     subindex            subindex of the requested object.
+ \param     dataSize            received data size of the SDO Download
+ \param     pData               Pointer to the buffer where the written data can be copied from
+ \param     bCompleteAccess     Indicates if a complete write of all subindices of the
+                                object shall be done or not
+
+ \return    result of the write operation (0 (success) or an abort code (ABORTIDX_.... defined in
+            sdosrv.h))
+
+ \brief     Write function of object 0x2003. Writing the loop select loads the model of that
+            loop, the model entries are staged and only handed to the control task when Active
+            is written, so that a complete model is applied in one step.
+*////////////////////////////////////////////////////////////////////////////////////////
+UINT8 Write0x2003( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess )
+{
+    control_smith_config_t model;
+    pid_autotune_result_t tuned;
+    control_loop_t loop = (control_loop_t) DeadTimeCompensation0x2003.LoopSelect;
+    bool active = false;
+    UINT32 u32Value;
+    float fValue;
+
+    /* each entry has side effects, a complete write would apply a half written model */
+    if (bCompleteAccess)
+    {
+        return ABORTIDX_UNSUPPORTED_ACCESS;
+    }
+
+    if (subindex == 0 || subindex == 7)
+    {
+        return ABORTIDX_READ_ONLY_ENTRY;
+    }
+
+    if (subindex == 1)
+    {
+        if (SWAPWORD(pData[0]) >= CONTROL_LOOP_COUNT)
+        {
+            return ABORTIDX_VALUE_EXCEEDED;
+        }
+        loop = (control_loop_t) SWAPWORD(pData[0]);
+        if (ControlTaskV3_GetSmithPredictor(loop, &model, NULL, &active) != pdTRUE)
+        {
+            return ABORTIDX_IN_THIS_STATE_DATA_CANNOT_BE_READ_OR_STORED;
+        }
+        DeadTimeCompensation0x2003.LoopSelect = (UINT16) loop;
+        DeadTimeCompensation0x2003.Gain = model.gain;
+        DeadTimeCompensation0x2003.TimeConstant = model.time_constant;
+        DeadTimeCompensation0x2003.DeadTime = model.dead_time;
+        DeadTimeCompensation0x2003.ImcLambda = model.imc_lambda;
+        DeadTimeCompensation0x2003.Active = active ? 1 : 0;
+        return 0;
+    }
+
+    if (dataSize > 4)
+    {
+        return ABORTIDX_PARAM_LENGTH_TOO_LONG;
+    }
+
+    if (subindex == 6)
+    {
+        MEMCPY(&u32Value, pData, 4);
+        if (u32Value > 1)
+        {
+            return ABORTIDX_VALUE_EXCEEDED;
+        }
+
+        if (u32Value == 1)
+        {
+            model.gain = DeadTimeCompensation0x2003.Gain;
+            model.time_constant = DeadTimeCompensation0x2003.TimeConstant;
+            model.dead_time = DeadTimeCompensation0x2003.DeadTime;
+            model.imc_lambda = DeadTimeCompensation0x2003.ImcLambda;
+
+            /* gain 0 takes the model of the last auto tuning, reject it here if there is none */
+            if (model.gain == 0.0f && ControlTaskV3_GetAutoTuneResult(loop, &tuned) != pdTRUE)
+            {
+                return ABORTIDX_VALUE_EXCEEDED;
+            }
+            if (ControlTaskV3_SetSmithPredictor(loop, &model) != pdTRUE
+                || ControlTaskV3_SetMode(loop, CONTROL_MODE_SMITH) != pdTRUE)
+            {
+                return ABORTIDX_IN_THIS_STATE_DATA_CANNOT_BE_READ_OR_STORED;
+            }
+        }
+        else if (ControlTaskV3_SetMode(loop, CONTROL_MODE_AUTO) != pdTRUE)
+        {
+            return ABORTIDX_IN_THIS_STATE_DATA_CANNOT_BE_READ_OR_STORED;
+        }
+
+        DeadTimeCompensation0x2003.Active = u32Value;
+        return 0;
+    }
+
+    /* model entries (subindex 2-5, REAL32) are only staged */
+    MEMCPY(&fValue, pData, 4);
+    if (!(fValue >= 0.0f))
+    {
+        return ABORTIDX_VALUE_EXCEEDED;
+    }
+    ((float *) &DeadTimeCompensation0x2003.Gain)[subindex - 2] = fValue;
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+ \param     index               index of the requested object.
+ \param     subindex            subindex of the requested object.
+ \param     dataSize            received data size of the SDO Download
+ \param     pData               Pointer to the buffer where the written data can be copied from
+ \param     bCompleteAccess     Indicates if a complete write of all subindices of the
+                                object shall be done or not
+
+ \return    result of the write operation (0 (success) or an abort code (ABORTIDX_.... defined in
+            sdosrv.h))
+
+ \brief     Write function of object 0x8010. The new settings are only taken over if they are
+            valid as a whole, in that case the mapping of 0x1A01 is rebuilt so that the master
+            reads the matching PDO layout before it requests SAFEOP.
+*////////////////////////////////////////////////////////////////////////////////////////
+UINT8 Write0x8010( UINT16 index, UINT8 subindex, UINT32 dataSize, UINT16 MBXMEM * pData, UINT8 bCompleteAccess )
+{
+    TOBJ8010 newSettings = OversamplingSettings0x8010;
+    oversampling_config_t config;
+    uint32_t aMapping[OVERSAMPLING_MAX_PDO_ENTRIES];
+    UINT16 mappingCnt;
+    UINT16 i;
+
+    /* complete access is not checked against the entry access rights by the SSC */
+    if (Oversampling_IsRunning())
+    {
+        return ABORTIDX_IN_THIS_STATE_DATA_CANNOT_BE_READ_OR_STORED;
+    }
+
+    if (bCompleteAccess)
+    {
+        if (subindex > 1)
+        {
+            return ABORTIDX_UNSUPPORTED_ACCESS;
+        }
+        if (dataSize > (SIZEOF(TOBJ8010) - (subindex * SIZEOF(UINT16))))
+        {
+            return ABORTIDX_PARAM_LENGTH_TOO_LONG;
+        }
+        MEMCPY(((UINT16 *) &newSettings) + subindex, pData, dataSize);
+        newSettings.u16SubIndex0 = OversamplingSettings0x8010.u16SubIndex0;
+    }
+    else
+    {
+        if (subindex == 0)
+        {
+            return ABORTIDX_READ_ONLY_ENTRY;
+        }
+        ((UINT16 *) &newSettings)[subindex] = SWAPWORD(pData[0]);
+    }
+
+    config.factor = (UINT8) newSettings.Factor;
+    config.channels[0] = (UINT8) newSettings.ChannelA;
+    config.channels[1] = (UINT8) newSettings.ChannelB;
+    config.channel_count = (newSettings.ChannelB == OVERSAMPLING_CHANNEL_NONE) ? 1 : 2;
+
+    if ((newSettings.Factor > OVERSAMPLING_MAX_FACTOR) || (newSettings.ChannelA > 0xFF) || (newSettings.ChannelB > 0xFF)
+        || (Oversampling_SetConfig(&config) != pdPASS))
+    {
+        return ABORTIDX_VALUE_EXCEEDED;
+    }
+
+    OversamplingSettings0x8010 = newSettings;
+
+    /* rebuild the oversampling PDO */
+    mappingCnt = Oversampling_BuildMapping(&config, aMapping);
+    OversamplingInputMapping0x1A01.u16SubIndex0 = mappingCnt;
+    for (i = 0; i < OVERSAMPLING_MAX_PDO_ENTRIES; i++)
+    {
+        OversamplingInputMapping0x1A01.aEntries[i] = (i < mappingCnt) ? aMapping[i] : 0;
+    }
+
+    return 0;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+/**
+ \brief    SYNC0 indication (called from Sync0_Isr while the input handler is running).
+           The DC time of the SYNC0 event is derived from the next SYNC0 pulse register,
+           the oversampling module starts the first sample from its own timer interrupt.
+*////////////////////////////////////////////////////////////////////////////////////////
+static void APPL_Sync0Ind(void)
+{
+    UINT32 nextSync0;
+
+    HW_EscReadDWordIsr(nextSync0, ESC_DC_NEXT_SYNC0_OFFSET);
+    Oversampling_OnSync0(SWAPDWORD(nextSync0) - u32OversamplingCycleTime);
+}
+
 /*-----------------------------------------------------------------------------------------
 ------
 ------    generic functions
@@ -111,6 +563,59 @@ UINT16 APPL_StopMailboxHandler(void)
 
 UINT16 APPL_StartInputHandler(UINT16 *pIntMask)
 {
+    uint32_t aMapping[PROCESS_IMAGE_TXPDO_WORDS];
+    oversampling_config_t config;
+    UINT16 dcControl;
+    UINT32 cycleTime;
+    BOOL bOversampling = FALSE;
+    UINT16 i;
+
+    for (i = 0; i < sTxPDOassign.u16SubIndex0; i++)
+    {
+        if (sTxPDOassign.aEntries[i] == 0x1A01)
+        {
+            bOversampling = TRUE;
+        }
+    }
+
+    /* APPL_InputMapping copies the process image as is, so the 0x1A00 entries have to
+       match the process image schema entry by entry */
+    if (InputMapping00x1A00.u16SubIndex0 != PROCESS_IMAGE_TXPDO_WORDS)
+    {
+        return ALSTATUSCODE_INVALIDINPUTMAPPING;
+    }
+
+    MEMCPY(aMapping, &InputMapping00x1A00.SI1, SIZEOF(aMapping));
+    if (!ProcessImage_MatchesMapping(aMapping, PROCESS_IMAGE_TXPDO_WORDS))
+    {
+        return ALSTATUSCODE_INVALIDINPUTMAPPING;
+    }
+
+    if (bOversampling)
+    {
+        /* the samples are paced by SYNC0, free run and SM synchronous operation are not supported */
+        HW_EscReadWord(dcControl, ESC_DC_UNIT_CONTROL_OFFSET);
+        dcControl = SWAPWORD(dcControl);
+        if ((dcControl & ESC_DC_SYNC0_ACTIVE_MASK) == 0)
+        {
+            return ALSTATUSCODE_DCINVALIDSYNCCFG;
+        }
+
+        HW_EscReadDWord(cycleTime, ESC_DC_SYNC0_CYCLETIME_OFFSET);
+        cycleTime = SWAPDWORD(cycleTime);
+
+        /* locks the settings of 0x8010 until the input handler is stopped */
+        if (Oversampling_Start(cycleTime) != pdPASS)
+        {
+            return ALSTATUSCODE_DCSYNC0CYCLETIME;
+        }
+
+        Oversampling_GetConfig(&config);
+        u32OversamplingCycleTime = cycleTime;
+        u16OversamplingPdoWords = Oversampling_GetPdoWords(&config);
+        pAPPL_Sync0Ind = APPL_Sync0Ind;
+    }
+
     return ALSTATUSCODE_NOERROR;
 }
 
@@ -127,6 +632,10 @@ UINT16 APPL_StartInputHandler(UINT16 *pIntMask)
 
 UINT16 APPL_StopInputHandler(void)
 {
+    pAPPL_Sync0Ind = NULL;
+    Oversampling_Stop();
+    u16OversamplingPdoWords = 0;
+
     return ALSTATUSCODE_NOERROR;
 }
 
@@ -260,11 +769,29 @@ UINT16 APPL_GenerateMapping(UINT16 *pInputSize,UINT16 *pOutputSize)
 *////////////////////////////////////////////////////////////////////////////////////////
 void APPL_InputMapping(UINT16* pData)
 {
-#if _WIN32
-   #pragma message ("Warning: Implement input (Slave -> Master) mapping")
-#else
-    #warning "Implement input (Slave -> Master) mapping"
-#endif
+    UINT16 i;
+
+    for (i = 0; i < sTxPDOassign.u16SubIndex0; i++)
+    {
+        switch (sTxPDOassign.aEntries[i])
+        {
+        case 0x1A00:
+            /* the sensor task converts 0x6000-0x6007 in one pass and publishes a complete image,
+               only a copy is done here (ISR context) */
+            MEMCPY(pData, ProcessImage_GetTxPdo(), PROCESS_IMAGE_TXPDO_WORDS * SIZEOF(UINT16));
+            pData += PROCESS_IMAGE_TXPDO_WORDS;
+            break;
+
+        case 0x1A01:
+            /* last complete oversampling frame */
+            Oversampling_CopyPdo(pData);
+            pData += u16OversamplingPdoWords;
+            break;
+
+        default:
+            break;
+        }
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -276,11 +803,42 @@ void APPL_InputMapping(UINT16* pData)
 *////////////////////////////////////////////////////////////////////////////////////////
 void APPL_OutputMapping(UINT16* pData)
 {
-#if _WIN32
-   #pragma message ("Warning: Implement output (Master -> Slave) mapping")
-#else
-    #warning "Implement output (Master -> Slave) mapping"
-#endif
+    UINT16 j = 0;
+    UINT16 i = 0;
+    UINT16 *pTmpData = (UINT16 *)pData;
+    BOOL bMasterOutputs = FALSE;
+
+    /* we go through all entries of the RxPDO Assign object to get the assigned RxPDOs */
+    for (j = 0; j < sRxPDOassign.u16SubIndex0; j++)
+    {
+        switch (sRxPDOassign.aEntries[j])
+        {
+        /* RxPDO 1: manual operation 0x7000.1/.2 */
+        case 0x1600:
+            ((UINT16 *) &NumberOfEntries0x7000)[1] = SWAPWORD(*pTmpData++);
+            ((UINT16 *) &NumberOfEntries0x7000)[2] = SWAPWORD(*pTmpData++);
+            break;
+
+        /* RxPDO 2: master outputs 0x7010, one word per OutputField_t */
+        case 0x1601:
+            for (i = 1; i <= OUTPUT_FIELD_COUNT; i++)
+            {
+                ((UINT16 *) &MasterOutputs0x7010)[i] = SWAPWORD(*pTmpData++);
+            }
+            bMasterOutputs = TRUE;
+            break;
+        }
+    }
+
+    if (bMasterOutputs)
+    {
+        /* latch the complete frame, change detection runs in APPL_Application */
+        OutputDataCache_t outputs;
+
+        MEMCPY(&outputs, ((UINT16 *) &MasterOutputs0x7010) + 1, OUTPUT_FIELD_COUNT * SIZEOF(UINT16));
+        outputs.reserved = 0;
+        EtherCAT_OutputMonitor_Latch(&outputs);
+    }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -290,11 +848,20 @@ void APPL_OutputMapping(UINT16* pData)
 *////////////////////////////////////////////////////////////////////////////////////////
 void APPL_Application(void)
 {
-#if _WIN32
-   #pragma message ("Warning: Implement the slave application")
-#else
-    #warning "Implement the slave application"
-#endif
+    OutputDataCache_t outputs;
+
+    /* wake the tasks subscribed to the changed master output fields */
+    EtherCAT_OutputMonitor_CheckChanges();
+
+    /* LED1/LED2 follow digital outputs bit 0/1 */
+    EtherCAT_OutputMonitor_GetOutputs(&outputs);
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_11, (outputs.digital_outputs & 0x0001) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(GPIOB, GPIO_PIN_12, (outputs.digital_outputs & 0x0002) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+
+    /* sensor simulator and EtherCAT sensor bridge */
+    SensorSimulator_Update();
+    EtherCAT_SensorBridge_UpdateInputs();
+    EtherCAT_SensorBridge_ProcessOutputs();
 }
 
 #if EXPLICIT_DEVICE_ID
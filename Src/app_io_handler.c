@@ -21,7 +21,6 @@
 
 #include "app_io_handler.h"
 #include "main.h"
-#include "SSC-Device.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -117,7 +116,6 @@ static analog_output_config_t analog_output_config[MAX_ANALOG_OUTPUTS] = {
 // ====================================================================
 // 私有函数声明
 // ====================================================================
-static void update_compatibility_objects(void);
 static int16_t adc_to_standard_value(uint32_t adc_value, const analog_input_config_t* config);
 static uint32_t standard_value_to_dac(int16_t value, const analog_output_config_t* config);
 static uint32_t standard_value_to_pwm(int16_t value, const analog_output_config_t* config);
@@ -192,9 +190,6 @@ void App_Digital_Input_Process(void)
     if(current_input_state != previous_state) {
         io_stats.digital_input_changes++;
     }
-
-    // 更新兼容性对象
-    update_compatibility_objects();
 }
 
 /**
@@ -221,9 +216,6 @@ void App_Digital_Output_Process(void)
             pin_state
         );
     }
-
-    // 更新兼容性对象
-    update_compatibility_objects();
 }
 
 /**
@@ -496,10 +488,6 @@ void App_IO_Debug_Print(void)
         }
         printf("\r\n");
 
-        // 兼容性对象状态
-        printf("Legacy Objects: Switch1=%d, Switch2=%d, Led1=%d, Led2=%d\r\n",
-               Obj0x6000.Switch1, Obj0x6000.Switch2, Obj0x7010.Led1, Obj0x7010.Led2);
-
         // 统计信息
         printf("Statistics: DI_Changes=%lu, AI_Samples=%lu, Errors=%lu\r\n",
                io_stats.digital_input_changes, io_stats.analog_input_samples,
@@ -535,19 +523,6 @@ void App_IO_Set_Debug_Period(uint32_t period_ms)
 // 私有函数实现
 // ====================================================================
 
-/**
- * @brief 更新兼容性对象
- */
-static void update_compatibility_objects(void)
-{
-    // 保持原有对象的兼容性
-    Obj0x6000.Switch1 = (Obj0x6001.digital_inputs & 0x01) ? 1 : 0;  // DI0
-    Obj0x6000.Switch2 = (Obj0x6001.digital_inputs & 0x02) ? 1 : 0;  // DI1
-
-    Obj0x7010.Led1 = (Obj0x7011.digital_outputs & 0x01) ? 1 : 0;    // DO0
-    Obj0x7010.Led2 = (Obj0x7011.digital_outputs & 0x02) ? 1 : 0;    // DO1
-}
-
 /**
  * @brief ADC值转换为标准化值
  */
@@ -1,5 +1,17 @@
 #include "ads8688/ADS8688.h"
 
+// one frame, tx = [hi][lo][0...], rx holds ADS_FRAME_BYTES bytes
+static HAL_StatusTypeDef ADS_Transfer(ADS8688 *ads, uint8_t hi, uint8_t lo, uint8_t *rxbuf) {
+	HAL_StatusTypeDef ret;
+	uint8_t txbuf[ADS_FRAME_BYTES] = {hi, lo};
+
+	HAL_GPIO_WritePin(ads->csPinBank, ads->csPin, GPIO_PIN_RESET);
+	ret = HAL_SPI_TransmitReceive(ads->spiHandle, txbuf, rxbuf, ADS_FRAME_BYTES, 10);
+	HAL_GPIO_WritePin(ads->csPinBank, ads->csPin, GPIO_PIN_SET);
+
+	return ret;
+}
+
 /*
  * INITIALISATION
  */
@@ -64,14 +76,11 @@ uint8_t ADS8688_Init(ADS8688 *ads, SPI_HandleTypeDef *spiHandle, GPIO_TypeDef *c
 // after the read, data contains the data from the addressed register
 HAL_StatusTypeDef ADS_Prog_Read(ADS8688 *ads, uint8_t addr, uint8_t *data) {
 	HAL_StatusTypeDef ret;
-	uint8_t txbuf[2] = {0x00, (addr<<1 & 0xfe)}; // [15:9]->address, [8]->0, [7:0]->don't care (0x00) (stm32 uses little endian so reverse it)
-	uint8_t rxbuf[4];
+	uint8_t rxbuf[ADS_FRAME_BYTES];
 
-	HAL_GPIO_WritePin(ads->csPinBank, ads->csPin, GPIO_PIN_RESET);
-	ret = HAL_SPI_TransmitReceive(ads->spiHandle, txbuf, rxbuf, 2, 10);
-	HAL_GPIO_WritePin(ads->csPinBank, ads->csPin, GPIO_PIN_SET);
+	ret = ADS_Transfer(ads, (addr<<1 & 0xfe), 0x00, rxbuf); // [15:9]->address, [8]->0, [7:0]->don't care (0x00)
 
-	data[0] = rxbuf[2];
+	data[0] = rxbuf[2]; // register value in [15:8] of the next word
 	data[1] = rxbuf[3];
 	return ret;
 }
@@ -79,38 +88,51 @@ HAL_StatusTypeDef ADS_Prog_Read(ADS8688 *ads, uint8_t addr, uint8_t *data) {
 // after the write, data should contain the data (byte) written to the addressed register (check equality for evaluation)
 HAL_StatusTypeDef ADS_Prog_Write(ADS8688 *ads, uint8_t addr, uint8_t *data) {
 	HAL_StatusTypeDef ret;
-	uint8_t txbuf[2] = {data[0], (addr << 1 | 0x01)}; // [15:9]->address[6:0], [8]->1, [7:0]->data[7:0] (stm32 uses little endian so reverse it)
-	uint8_t rxbuf[4];
+	uint8_t rxbuf[ADS_FRAME_BYTES];
 
-	HAL_GPIO_WritePin(ads->csPinBank, ads->csPin, GPIO_PIN_RESET);
-	ret = HAL_SPI_TransmitReceive(ads->spiHandle, txbuf, rxbuf, 2, 10);
-	HAL_GPIO_WritePin(ads->csPinBank, ads->csPin, GPIO_PIN_SET);
+	ret = ADS_Transfer(ads, (addr << 1 | 0x01), data[0], rxbuf); // [15:9]->address[6:0], [8]->1, [7:0]->data[7:0]
 
-	data[0] = rxbuf[3];
+	data[0] = rxbuf[2]; // written value echoed in [15:8] of the next word
 	data[1] = 0x00;
 	return ret;
 }
 
 HAL_StatusTypeDef ADS_Cmd_Write(ADS8688 *ads, uint8_t cmd, uint8_t *data) {
 	HAL_StatusTypeDef ret;
-	uint8_t txbuf[2] = {0x00,cmd}; // [15:9]->address[6:0], [8]->1, [7:0]->data[7:0] (stm32 uses little endian so reverse it)
-	uint8_t rxbuf[4];
+	uint8_t rxbuf[ADS_FRAME_BYTES];
 
-	HAL_GPIO_WritePin(ads->csPinBank, ads->csPin, GPIO_PIN_RESET);
-	ret = HAL_SPI_TransmitReceive(ads->spiHandle, txbuf, rxbuf, 2, 10);
-	HAL_GPIO_WritePin(ads->csPinBank, ads->csPin, GPIO_PIN_SET);
+	ret = ADS_Transfer(ads, cmd, 0x00, rxbuf); // [15:8]->command, [7:0]->0x00
 
 	data[0] = rxbuf[2];
 	data[1] = rxbuf[3];
 	return ret;
 }
 
+// sends a command, returns the 16 bit result of the previous conversion and its channel address
+HAL_StatusTypeDef ADS_Cmd_Read(ADS8688 *ads, uint8_t cmd, uint16_t *code, uint8_t *channel) {
+	HAL_StatusTypeDef ret;
+	uint8_t rxbuf[ADS_FRAME_BYTES];
+
+	ret = ADS_Transfer(ads, cmd, 0x00, rxbuf);
+
+	*code = ADS_FRAME_CODE(rxbuf);
+	*channel = ADS_FRAME_CHANNEL(rxbuf);
+	return ret;
+}
+
+// AUTO_RST restarts the sequence at channel 0 (its own frame returns the previous conversion),
+// the following CONT frames return channels 0..CHNS_NUM_READ-1. HAL_ERROR if a channel is out of order
 HAL_StatusTypeDef ADS_Read_All_Raw(ADS8688 *ads, uint16_t *data) {
 	HAL_StatusTypeDef ret;
-	uint8_t ads_raw[2];
-	for(int i=0; i<CHNS_NUM_READ; i++) {
-	  ret = ADS_Cmd_Write(ads, CONT, ads_raw);
-	  data[i] = (int)((uint16_t)(ads_raw[1]<<8 | ads_raw[0]) >> 4);
+	uint16_t code;
+	uint8_t channel;
+
+	ret = ADS_Cmd_Read(ads, AUTO_RST, &code, &channel);
+	for(int i=0; i<CHNS_NUM_READ && ret == HAL_OK; i++) {
+	  ret = ADS_Cmd_Read(ads, CONT, &data[i], &channel);
+	  if (ret == HAL_OK && channel != i) {
+	    ret = HAL_ERROR;
+	  }
 	}
 	return ret;
 }
@@ -1,17 +1,62 @@
 /* 包含头文件 ----------------------------------------------------------------*/
 #include "ads8688/bsp_ads8688.h"
 #include "usart/bsp_debug_usart.h"
+#include <string.h>
 
 /* 私有类型定义 --------------------------------------------------------------*/
 /* 私有宏定义 ----------------------------------------------------------------*/
+#define ADS8688_MAN_CMD(ch)             ((uint8_t)(MAN_0 + ((ch) << 2)))
+
+/* 一帧的传输次数: AUTO_RST(返回上一次转换, 丢弃) + 8次CONT */
+#define ADS8688_ACQ_STEPS               (ADS8688_ACQ_CHANNELS + 1)
+
+#define ADS8688_CS_LOW()                HAL_GPIO_WritePin(ADS8688_SPI_CS_PORT, ADS8688_SPI_CS_PIN, GPIO_PIN_RESET)
+#define ADS8688_CS_HIGH()               HAL_GPIO_WritePin(ADS8688_SPI_CS_PORT, ADS8688_SPI_CS_PIN, GPIO_PIN_SET)
+
 /* 私有变量 ------------------------------------------------------------------*/
 SPI_HandleTypeDef hads8688_spi;
+DMA_HandleTypeDef hads8688_dma_rx;
+DMA_HandleTypeDef hads8688_dma_tx;
 ADS8688 ads8688_device;
 
+/* 各通道1LSB对应的电压 (V) */
+static const float ads8688_lsb_volts[ADS8688_ACQ_CHANNELS] = ADS8688_LSB_VOLTS_TABLE;
+
+/* 总线被占用(任务阻塞扫描或后台采集帧进行中), 此时中断采样不得插入 */
+static volatile uint8_t ads8688_scan_active = 0;
+
+/* 后台采集 */
+static TIM_HandleTypeDef ads8688_acq_tim;
+static uint8_t ads8688_acq_configured = 0;
+static volatile uint8_t ads8688_acq_running = 0;
+static uint32_t ads8688_acq_period_us = ADS8688_ACQ_PERIOD_US_DEFAULT;
+static volatile uint8_t ads8688_acq_step = 0;       // 0=空闲, 1..ADS8688_ACQ_STEPS=正在进行的传输
+static volatile uint8_t ads8688_acq_order_ok = 1;
+static volatile uint32_t ads8688_acq_published = 0; // 已发布帧数, 最新帧位于(published-1)%RING_SIZE
+static ads8688_frame_t ads8688_acq_ring[ADS8688_ACQ_RING_SIZE];
+static ads8688_acq_stats_t ads8688_acq_stats;
+static uint8_t ads8688_acq_tx[ADS8688_ACQ_SPI_BYTES];
+static uint8_t ads8688_acq_rx[ADS8688_ACQ_SPI_BYTES];
+
+/* 中断采样 (手动通道序列), 与后台采集共用DMA缓冲, 由ads8688_scan_active互斥 */
+static volatile uint8_t ads8688_man_step = 0;       // 0=空闲, 1..count+1=正在进行的传输
+static uint8_t ads8688_man_count = 0;
+static uint8_t ads8688_man_channels[ADS8688_ISR_MAX_CHANNELS];
+static uint16_t ads8688_man_data[ADS8688_ISR_MAX_CHANNELS];
+static HAL_StatusTypeDef ads8688_man_status = HAL_OK;
+static ads8688_read_done_t ads8688_man_done = NULL;
+
 /* 扩展变量 ------------------------------------------------------------------*/
 /* 私有函数原型 --------------------------------------------------------------*/
 static void ADS8688_SPI_GPIO_Config(void);
 static void ADS8688_SPI_Config(void);
+static void ADS8688_Acq_Config(void);
+static HAL_StatusTypeDef ADS8688_Dma_Transfer(uint8_t cmd);
+static void ADS8688_Acq_Transfer(uint8_t cmd);
+static void ADS8688_Acq_EndFrame(void);
+static void ADS8688_Man_Step(void);
+static void ADS8688_Man_End(HAL_StatusTypeDef status);
+static uint8_t ADS8688_Bus_TryAcquire(void);
 
 /* 函数体 --------------------------------------------------------------------*/
 
@@ -123,17 +168,81 @@ void BSP_ADS8688_Init(void)
     } else {
         printf("ADS8688 initialization failed with status: %d\r\n", init_status);
     }
+
+    /* DMA和节拍定时器, 中断采样和后台采集共用 */
+    ADS8688_Acq_Config();
 }
 
 /**
   * 函数功能: 读取ADS8688所有通道数据
   * 输入参数: data - 存储读取数据的数组指针
-  * 返 回 值: HAL状态
-  * 说    明: 读取8个通道的16位ADC值
+  * 返 回 值: HAL状态, HAL_BUSY=中断采样进行中 (本次不扫描)
+  * 说    明: 后台采集运行时不阻塞, 直接返回最新一帧;
+  *          否则在任务上下文阻塞扫描8个通道. 两种方式的帧格式和
+  *          16位解码相同(ADS_FRAME_CODE), 换算不区分来源
 */
 HAL_StatusTypeDef BSP_ADS8688_ReadAllChannels(uint16_t *data)
 {
-    return ADS_Read_All_Raw(&ads8688_device, data);
+    HAL_StatusTypeDef ret;
+    ads8688_frame_t frame;
+
+    if (ads8688_acq_running) {
+        ret = BSP_ADS8688_GetLatestFrame(&frame);
+        if (ret == HAL_OK) {
+            memcpy(data, frame.raw, sizeof(frame.raw));
+        }
+        return ret;
+    }
+
+    if (!ADS8688_Bus_TryAcquire()) {
+        return HAL_BUSY;
+    }
+
+    ret = ADS_Read_All_Raw(&ads8688_device, data);
+    ads8688_scan_active = 0;
+
+    return ret;
+}
+
+/**
+  * 函数功能: 在中断中启动指定通道的读取 (手动通道模式)
+  * 输入参数: channels - 通道号数组 (0-7)
+  *          count - 通道数量 (1-ADS8688_ISR_MAX_CHANNELS)
+  *          done - 完成回调, 在DMA中断中以通道顺序的转换结果调用
+  * 返 回 值: HAL_OK=已启动, HAL_BUSY=任务扫描或后台采集帧进行中 (本次不采样),
+  *          HAL_ERROR=未初始化, 参数错误或DMA无法启动 (均不调用回调)
+  * 说    明: 不等待传输, 由DMA完成回调逐帧推进. 先预选第1个通道, 之后每帧
+  *          返回上一帧所选通道的转换结果, 共count+1帧; 最后一帧发送AUTO_RST,
+  *          交还自动序列(从通道0开始), 任务的下一次全通道扫描不受影响.
+  *          帧格式和16位解码与其他读取路径相同(ADS_FRAME_CODE), 通道地址
+  *          与请求不符时以HAL_ERROR回调. 调用者须在ADS8688_ACQ_IRQ_PRIORITY
+  *          优先级的中断中调用, 与后台采集的节拍和DMA中断不嵌套
+*/
+HAL_StatusTypeDef BSP_ADS8688_StartChannelsIsr(const uint8_t *channels, uint8_t count, ads8688_read_done_t done)
+{
+    if (!ads8688_acq_configured || channels == NULL || count == 0 ||
+        count > ADS8688_ISR_MAX_CHANNELS || done == NULL) {
+        return HAL_ERROR;
+    }
+
+    if (ads8688_scan_active) {
+        return HAL_BUSY;
+    }
+
+    ads8688_scan_active = 1;
+    memcpy(ads8688_man_channels, channels, count);
+    ads8688_man_count = count;
+    ads8688_man_status = HAL_OK;
+    ads8688_man_done = done;
+    ads8688_man_step = 1;
+
+    if (ADS8688_Dma_Transfer(ADS8688_MAN_CMD(channels[0])) != HAL_OK) {
+        ads8688_man_step = 0;
+        ads8688_scan_active = 0;
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
 }
 
 /**
@@ -142,20 +251,492 @@ HAL_StatusTypeDef BSP_ADS8688_ReadAllChannels(uint16_t *data)
   *          voltage_data - 转换后的电压值数组
   *          channel_count - 通道数量
   * 返 回 值: 无
-  * 说    明: 根据配置的量程转换为实际电压值
+  * 说    明: 按通道LSB表一次乘法完成, 无量程分支和除法. 除以65536是2的幂次
+  *          缩放, 不产生舍入, 结果与"原始值/65536*量程"逐位一致
 */
 void BSP_ADS8688_ConvertToVoltage(uint16_t *raw_data, float *voltage_data, uint8_t channel_count)
 {
-    for (uint8_t i = 0; i < channel_count && i < 8; i++) {
-        /* 根据ADS8688配置的量程计算电压值 */
-        /* Channel 0,1,6,7: 0-5V range (0x06) */
-        /* Channel 2,3,4,5: 0-10V range (0x05) */
-        if (i == 0 || i == 1 || i == 6 || i == 7) {
-            // 0-5V range: raw_data / 65536 * 5.0V
-            voltage_data[i] = ((float)raw_data[i] / 65536.0f) * 5.0f;
-        } else {
-            // 0-10V range: raw_data / 65536 * 10.0V
-            voltage_data[i] = ((float)raw_data[i] / 65536.0f) * 10.0f;
+    if (channel_count > ADS8688_ACQ_CHANNELS) {
+        channel_count = ADS8688_ACQ_CHANNELS;
+    }
+
+    for (uint8_t i = 0; i < channel_count; i++) {
+        voltage_data[i] = (float)raw_data[i] * ads8688_lsb_volts[i];
+    }
+}
+
+/**
+  * 函数功能: 启动后台采集
+  * 输入参数: period_us - 帧周期 (us, 不小于ADS8688_ACQ_PERIOD_US_MIN)
+  * 返 回 值: HAL状态
+  * 说    明: 节拍定时器每个周期触发一帧8通道自动序列, 由SPI3 DMA逐次完成,
+  *          CPU只在每次传输结束时处理一次中断. 帧写入环形缓冲后发布,
+  *          使用者通过BSP_ADS8688_GetLatestFrame/GetFrames无阻塞读取
+*/
+HAL_StatusTypeDef BSP_ADS8688_StartAcquisition(uint32_t period_us)
+{
+    if (period_us < ADS8688_ACQ_PERIOD_US_MIN || period_us > 0xFFFFFFFFUL / 2) {
+        return HAL_ERROR;
+    }
+
+    if (ads8688_acq_running) {
+        return HAL_BUSY;
+    }
+
+    if (!ads8688_acq_configured) {
+        ADS8688_Acq_Config();
+    }
+
+    ads8688_acq_period_us = period_us;
+    ads8688_acq_step = 0;
+    ads8688_acq_published = 0;
+    memset(ads8688_acq_ring, 0, sizeof(ads8688_acq_ring));
+    memset(&ads8688_acq_stats, 0, sizeof(ads8688_acq_stats));
+
+    __HAL_TIM_SET_AUTORELOAD(&ads8688_acq_tim, period_us - 1);
+    __HAL_TIM_SET_COUNTER(&ads8688_acq_tim, 0);
+    __HAL_TIM_CLEAR_FLAG(&ads8688_acq_tim, TIM_FLAG_UPDATE);
+
+    ads8688_acq_running = 1;
+    if (HAL_TIM_Base_Start_IT(&ads8688_acq_tim) != HAL_OK) {
+        ads8688_acq_running = 0;
+        return HAL_ERROR;
+    }
+
+    printf("ADS8688 acquisition started, period %lu us\r\n", (unsigned long)period_us);
+    return HAL_OK;
+}
+
+/**
+  * 函数功能: 停止后台采集
+  * 输入参数: 无
+  * 返 回 值: 无
+  * 说    明: 等待进行中的帧结束(最多约一个帧周期), 超时则中止DMA
+*/
+void BSP_ADS8688_StopAcquisition(void)
+{
+    uint32_t start;
+
+    if (!ads8688_acq_running) {
+        return;
+    }
+
+    HAL_TIM_Base_Stop_IT(&ads8688_acq_tim);
+    ads8688_acq_running = 0;
+
+    start = HAL_GetTick();
+    while (ads8688_acq_step != 0 && (HAL_GetTick() - start) < 2) {
+    }
+
+    if (ads8688_acq_step != 0) {
+        HAL_SPI_Abort(&hads8688_spi);
+        ADS8688_CS_HIGH();
+        ads8688_acq_step = 0;
+        ads8688_scan_active = 0;
+    }
+}
+
+/**
+  * 函数功能: 后台采集是否运行
+  * 输入参数: 无
+  * 返 回 值: 1=运行, 0=停止
+  * 说    明: 无
+*/
+uint8_t BSP_ADS8688_IsAcquiring(void)
+{
+    return ads8688_acq_running;
+}
+
+/**
+  * 函数功能: 读取最新一帧
+  * 输入参数: frame - 输出帧
+  * 返 回 值: HAL_OK=成功, HAL_ERROR=未运行或尚无数据,
+  *          HAL_TIMEOUT=最新帧已过期, HAL_BUSY=连续被写入覆盖
+  * 说    明: 无锁读取, 复制后检查写入位置是否已追上所读的槽位
+*/
+HAL_StatusTypeDef BSP_ADS8688_GetLatestFrame(ads8688_frame_t *frame)
+{
+    if (BSP_ADS8688_GetFrames(frame, 1) != 1) {
+        return (ads8688_acq_running && ads8688_acq_published > 0) ? HAL_BUSY : HAL_ERROR;
+    }
+
+    if ((ads8688_acq_stats.ticks - frame->tick) > ADS8688_ACQ_STALE_TICKS) {
+        return HAL_TIMEOUT;
+    }
+
+    return HAL_OK;
+}
+
+/**
+  * 函数功能: 读取最近的多帧
+  * 输入参数: frames - 输出帧数组 (按时间先后排列, 最后一个为最新帧)
+  *          count - 请求帧数 (不超过ADS8688_ACQ_RING_SIZE-1)
+  * 返 回 值: 实际读取的帧数, 已发布帧不足时按实际数量返回
+  * 说    明: 无锁读取, 被写入覆盖时重试
+*/
+uint8_t BSP_ADS8688_GetFrames(ads8688_frame_t *frames, uint8_t count)
+{
+    uint32_t published;
+    uint32_t first;
+
+    if (frames == NULL || count == 0) {
+        return 0;
+    }
+
+    if (count > ADS8688_ACQ_RING_SIZE - 1) {
+        count = ADS8688_ACQ_RING_SIZE - 1;
+    }
+
+    for (uint8_t retry = 0; retry < 3; retry++) {
+        published = ads8688_acq_published;
+        if (published == 0) {
+            return 0;
+        }
+        if (count > published) {
+            count = (uint8_t)published;
+        }
+
+        first = published - count;
+        __DMB();
+        for (uint8_t i = 0; i < count; i++) {
+            frames[i] = ads8688_acq_ring[(first + i) % ADS8688_ACQ_RING_SIZE];
         }
+        __DMB();
+
+        /* 正在写入的槽位为published%RING_SIZE, 追上first所在槽位前数据有效 */
+        if ((ads8688_acq_published - first) < ADS8688_ACQ_RING_SIZE) {
+            return count;
+        }
+    }
+
+    return 0;
+}
+
+/**
+  * 函数功能: 获取后台采集统计
+  * 输入参数: stats - 输出统计
+  * 返 回 值: 无
+  * 说    明: 无
+*/
+void BSP_ADS8688_GetAcqStats(ads8688_acq_stats_t *stats)
+{
+    if (stats != NULL) {
+        *stats = ads8688_acq_stats;
+        stats->frames = ads8688_acq_published;
+    }
+}
+
+/**
+  * 函数功能: 采集节拍定时器中断处理
+  * 输入参数: 无
+  * 返 回 值: 无
+  * 说    明: 启动一帧: CS拉低并发出AUTO_RST, 后续由DMA完成回调推进
+*/
+void BSP_ADS8688_AcqTimerIsr(void)
+{
+    ads8688_frame_t *slot;
+
+    if (__HAL_TIM_GET_FLAG(&ads8688_acq_tim, TIM_FLAG_UPDATE) == RESET) {
+        return;
+    }
+    __HAL_TIM_CLEAR_FLAG(&ads8688_acq_tim, TIM_FLAG_UPDATE);
+
+    ads8688_acq_stats.ticks++;
+
+    if (!ads8688_acq_running) {
+        return;
+    }
+
+    if (ads8688_acq_step != 0) {
+        ads8688_acq_stats.overruns++;
+        return;
     }
-}
\ No newline at end of file
+
+    if (ads8688_scan_active) {
+        ads8688_acq_stats.bus_busy++;
+        return;
+    }
+
+    ads8688_scan_active = 1;
+    ads8688_acq_order_ok = 1;
+
+    slot = &ads8688_acq_ring[ads8688_acq_published % ADS8688_ACQ_RING_SIZE];
+    slot->tick = ads8688_acq_stats.ticks;
+    slot->timestamp_us = ads8688_acq_stats.ticks * ads8688_acq_period_us +
+                         __HAL_TIM_GET_COUNTER(&ads8688_acq_tim);
+
+    ads8688_acq_step = 1;
+    ADS8688_Acq_Transfer(AUTO_RST);
+}
+
+/**
+  * 函数功能: SPI收发完成回调
+  * 输入参数: hspi - SPI句柄
+  * 返 回 值: 无
+  * 说    明: 中断采样进行中时推进手动通道序列; 否则为后台采集帧:
+  *          第1次传输(AUTO_RST)返回的是上一次转换, 丢弃;
+  *          第2..9次传输依次返回通道0..7
+*/
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    ads8688_frame_t *slot;
+    uint8_t channel;
+
+    if (hspi != &hads8688_spi) {
+        return;
+    }
+
+    if (ads8688_man_step != 0) {
+        ADS8688_Man_Step();
+        return;
+    }
+
+    if (ads8688_acq_step == 0) {
+        return;
+    }
+
+    ADS8688_CS_HIGH();
+
+    if (ads8688_acq_step > 1) {
+        channel = ads8688_acq_step - 2;
+        slot = &ads8688_acq_ring[ads8688_acq_published % ADS8688_ACQ_RING_SIZE];
+        slot->raw[channel] = ADS_FRAME_CODE(ads8688_acq_rx);
+#if ADS8688_ACQ_CHECK_ORDER
+        if (ADS_FRAME_CHANNEL(ads8688_acq_rx) != channel) {
+            ads8688_acq_order_ok = 0;
+        }
+#endif
+    }
+
+    if (ads8688_acq_step < ADS8688_ACQ_STEPS && ads8688_acq_running) {
+        ads8688_acq_step++;
+        ADS8688_Acq_Transfer(CONT);
+    } else {
+        ADS8688_Acq_EndFrame();
+    }
+}
+
+/**
+  * 函数功能: SPI错误回调
+  * 输入参数: hspi - SPI句柄
+  * 返 回 值: 无
+  * 说    明: 放弃当前帧, 下一个节拍重新开始; 中断采样以HAL_ERROR回调
+*/
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi != &hads8688_spi) {
+        return;
+    }
+
+    if (ads8688_man_step != 0) {
+        ADS8688_CS_HIGH();
+        ADS8688_Man_End(HAL_ERROR);
+        return;
+    }
+
+    if (ads8688_acq_step == 0) {
+        return;
+    }
+
+    ADS8688_CS_HIGH();
+    ads8688_acq_stats.spi_errors++;
+    ads8688_acq_order_ok = 0;
+    ADS8688_Acq_EndFrame();
+}
+
+/**
+  * 函数功能: 后台采集硬件配置
+  * 输入参数: 无
+  * 返 回 值: 无
+  * 说    明: 配置SPI3收发DMA和节拍定时器, 初始化时调用
+*/
+static void ADS8688_Acq_Config(void)
+{
+    ADS8688_SPI_DMA_CLK_ENABLE();
+
+    hads8688_dma_rx.Instance = ADS8688_SPI_RX_DMA_STREAM;
+    hads8688_dma_rx.Init.Channel = ADS8688_SPI_RX_DMA_CHANNEL;
+    hads8688_dma_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hads8688_dma_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hads8688_dma_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hads8688_dma_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hads8688_dma_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hads8688_dma_rx.Init.Mode = DMA_NORMAL;
+    hads8688_dma_rx.Init.Priority = DMA_PRIORITY_HIGH;
+    hads8688_dma_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(&hads8688_dma_rx);
+    __HAL_LINKDMA(&hads8688_spi, hdmarx, hads8688_dma_rx);
+
+    hads8688_dma_tx.Instance = ADS8688_SPI_TX_DMA_STREAM;
+    hads8688_dma_tx.Init.Channel = ADS8688_SPI_TX_DMA_CHANNEL;
+    hads8688_dma_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hads8688_dma_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hads8688_dma_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hads8688_dma_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hads8688_dma_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hads8688_dma_tx.Init.Mode = DMA_NORMAL;
+    hads8688_dma_tx.Init.Priority = DMA_PRIORITY_MEDIUM;
+    hads8688_dma_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(&hads8688_dma_tx);
+    __HAL_LINKDMA(&hads8688_spi, hdmatx, hads8688_dma_tx);
+
+    HAL_NVIC_SetPriority(ADS8688_SPI_RX_DMA_IRQ, ADS8688_ACQ_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(ADS8688_SPI_RX_DMA_IRQ);
+    HAL_NVIC_SetPriority(ADS8688_SPI_TX_DMA_IRQ, ADS8688_ACQ_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(ADS8688_SPI_TX_DMA_IRQ);
+
+    /* 节拍定时器, 周期在BSP_ADS8688_StartAcquisition中设置 */
+    ADS8688_ACQ_TIM_RCC_CLK_ENABLE();
+
+    ads8688_acq_tim.Instance = ADS8688_ACQ_TIMx;
+    ads8688_acq_tim.Init.Prescaler = ADS8688_ACQ_TIM_PRESCALER;
+    ads8688_acq_tim.Init.CounterMode = TIM_COUNTERMODE_UP;
+    ads8688_acq_tim.Init.Period = ADS8688_ACQ_PERIOD_US_DEFAULT - 1;
+    ads8688_acq_tim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    ads8688_acq_tim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    HAL_TIM_Base_Init(&ads8688_acq_tim);
+
+    HAL_NVIC_SetPriority(ADS8688_ACQ_TIM_IRQ, ADS8688_ACQ_IRQ_PRIORITY, 1);
+    HAL_NVIC_EnableIRQ(ADS8688_ACQ_TIM_IRQ);
+
+    ads8688_acq_configured = 1;
+}
+
+/**
+  * 函数功能: 发起一次DMA传输
+  * 输入参数: cmd - ADS8688命令
+  * 返 回 值: HAL状态, 失败时CS已释放
+  * 说    明: 与阻塞读取相同的帧格式(见ADS8688.h): [命令][0x00], 结果在第3,4字节,
+  *          通道地址在第5字节高4位
+*/
+static HAL_StatusTypeDef ADS8688_Dma_Transfer(uint8_t cmd)
+{
+    memset(ads8688_acq_tx, 0, sizeof(ads8688_acq_tx));
+    ads8688_acq_tx[0] = cmd;
+
+    ADS8688_CS_LOW();
+    if (HAL_SPI_TransmitReceive_DMA(&hads8688_spi, ads8688_acq_tx, ads8688_acq_rx,
+                                    ADS8688_ACQ_SPI_BYTES) != HAL_OK) {
+        ADS8688_CS_HIGH();
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/**
+  * 函数功能: 发起后台采集帧的一次传输
+  * 输入参数: cmd - ADS8688命令
+  * 返 回 值: 无
+  * 说    明: 启动失败时放弃当前帧
+*/
+static void ADS8688_Acq_Transfer(uint8_t cmd)
+{
+    if (ADS8688_Dma_Transfer(cmd) != HAL_OK) {
+        ads8688_acq_stats.spi_errors++;
+        ads8688_acq_order_ok = 0;
+        ADS8688_Acq_EndFrame();
+    }
+}
+
+/**
+  * 函数功能: 结束当前帧
+  * 输入参数: 无
+  * 返 回 值: 无
+  * 说    明: 完整且顺序正确的帧写入序号后发布, 否则丢弃
+*/
+static void ADS8688_Acq_EndFrame(void)
+{
+    ads8688_frame_t *slot = &ads8688_acq_ring[ads8688_acq_published % ADS8688_ACQ_RING_SIZE];
+
+    if (ads8688_acq_step == ADS8688_ACQ_STEPS && ads8688_acq_order_ok) {
+        slot->seq = ads8688_acq_published + 1;
+        __DMB();
+        ads8688_acq_published++;
+    } else if (ads8688_acq_step == ADS8688_ACQ_STEPS) {
+        ads8688_acq_stats.order_errors++;
+    }
+
+    ads8688_acq_step = 0;
+    ads8688_scan_active = 0;
+}
+
+/**
+  * 函数功能: 在任务上下文占用总线
+  * 输入参数: 无
+  * 返 回 值: 1=已占用, 0=中断采样或后台采集帧进行中
+  * 说    明: 节拍定时器, SPI DMA和过采样中断的优先级高于
+  *          configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, taskENTER_CRITICAL
+  *          屏蔽不了, 检查并置位ads8688_scan_active期间用BASEPRI屏蔽
+  *          ADS8688_ACQ_IRQ_PRIORITY及以下的中断
+*/
+static uint8_t ADS8688_Bus_TryAcquire(void)
+{
+    uint32_t basepri = __get_BASEPRI();
+    uint8_t acquired = 0;
+
+    __set_BASEPRI_MAX(ADS8688_ACQ_IRQ_PRIORITY << (8U - __NVIC_PRIO_BITS));
+    __ISB();
+
+    if (!ads8688_scan_active) {
+        ads8688_scan_active = 1;
+        acquired = 1;
+    }
+
+    __set_BASEPRI(basepri);
+
+    return acquired;
+}
+
+/**
+  * 函数功能: 推进中断采样序列
+  * 输入参数: 无
+  * 返 回 值: 无
+  * 说    明: 第k次传输(k>=2)返回第k-1个请求通道; 第count+1次传输
+  *          发送AUTO_RST, 完成后回调
+*/
+static void ADS8688_Man_Step(void)
+{
+    uint8_t index;
+    uint8_t cmd;
+
+    ADS8688_CS_HIGH();
+
+    if (ads8688_man_step > 1) {
+        index = ads8688_man_step - 2;
+        ads8688_man_data[index] = ADS_FRAME_CODE(ads8688_acq_rx);
+        if (ADS_FRAME_CHANNEL(ads8688_acq_rx) != ads8688_man_channels[index]) {
+            ads8688_man_status = HAL_ERROR;
+        }
+    }
+
+    if (ads8688_man_step > ads8688_man_count) {
+        ADS8688_Man_End(ads8688_man_status);
+        return;
+    }
+
+    cmd = (ads8688_man_step < ads8688_man_count) ? ADS8688_MAN_CMD(ads8688_man_channels[ads8688_man_step]) : AUTO_RST;
+    ads8688_man_step++;
+
+    if (ADS8688_Dma_Transfer(cmd) != HAL_OK) {
+        ADS8688_Man_End(HAL_ERROR);
+    }
+}
+
+/**
+  * 函数功能: 结束中断采样序列
+  * 输入参数: status - 结果
+  * 返 回 值: 无
+  * 说    明: 先释放总线再回调, 回调中可以立即启动下一次读取
+*/
+static void ADS8688_Man_End(HAL_StatusTypeDef status)
+{
+    ads8688_read_done_t done = ads8688_man_done;
+
+    ads8688_man_step = 0;
+    ads8688_scan_active = 0;
+
+    if (done != NULL) {
+        done(status, ads8688_man_data);
+    }
+}
@@ -7,16 +7,56 @@
  */
 
 #include "ethercat_output_monitor.h"
-#include "SSC-Device.h"
-#include "SSC-DeviceObjects.h"
 #include <string.h>
 #include <stdio.h>
 
+/* ========================================================================== */
+/* 私有宏定义 */
+/* ========================================================================== */
+
+#define OUTPUT_CACHE_WORDS      (sizeof(OutputDataCache_t) / sizeof(uint32_t))
+
+/* 缓存必须是每字段一个16位字且补齐到32位字 */
+typedef char _output_cache_layout_check[(sizeof(OutputDataCache_t) ==
+                                         ((OUTPUT_FIELD_COUNT + 1) / 2) * sizeof(uint32_t)) ? 1 : -1];
+
+#define OUTPUT_FIELDS_DIGITAL   (OUTPUT_FIELD_BIT(OUTPUT_FIELD_DIGITAL_OUTPUTS) | \
+                                 OUTPUT_FIELD_BIT(OUTPUT_FIELD_DIGITAL_MASK))
+#define OUTPUT_FIELDS_ANALOG    (OUTPUT_FIELD_BIT(OUTPUT_FIELD_ANALOG_0) | \
+                                 OUTPUT_FIELD_BIT(OUTPUT_FIELD_ANALOG_1) | \
+                                 OUTPUT_FIELD_BIT(OUTPUT_FIELD_ANALOG_2) | \
+                                 OUTPUT_FIELD_BIT(OUTPUT_FIELD_ANALOG_3) | \
+                                 OUTPUT_FIELD_BIT(OUTPUT_FIELD_ANALOG_MASK))
+#define OUTPUT_FIELDS_COMMAND   (OUTPUT_FIELD_BIT(OUTPUT_FIELD_SENSOR_CMD) | \
+                                 OUTPUT_FIELD_BIT(OUTPUT_FIELD_SYSTEM_CMD))
+#define OUTPUT_FIELDS_CONFIG    (OUTPUT_FIELD_BIT(OUTPUT_FIELD_SAMPLING_RATE) | \
+                                 OUTPUT_FIELD_BIT(OUTPUT_FIELD_FILTER_ENABLE))
+
+/**
+ * @brief 缓存的字/字段视图
+ */
+typedef union {
+    OutputDataCache_t data;
+    uint32_t words[OUTPUT_CACHE_WORDS];
+    uint16_t fields[OUTPUT_CACHE_WORDS * 2];
+} OutputCacheImage_t;
+
+/**
+ * @brief 字段订阅
+ */
+typedef struct {
+    TaskHandle_t task;                  /**< 订阅任务 */
+    uint32_t field_mask;                /**< 关注的字段 */
+} OutputSubscriber_t;
+
 /* ========================================================================== */
 /* 私有变量 */
 /* ========================================================================== */
 
-static OutputDataCache_t g_output_cache;        /**< 输出数据缓存 */
+static OutputCacheImage_t g_output_latched;     /**< 最新锁存的输出数据 */
+static OutputCacheImage_t g_output_cache;       /**< 已通知过的输出数据缓存 */
+static volatile uint32_t g_dirty_fields = 0;    /**< 最近一次检测到的字段脏位 */
+static OutputSubscriber_t g_subscribers[OUTPUT_MONITOR_MAX_SUBSCRIBERS]; /**< 订阅表 */
 static OutputMonitorStats_t g_monitor_stats;    /**< 监控统计信息 */
 static uint16_t g_analog_threshold = 10;        /**< 模拟量变化阈值（千分比，默认1%） */
 static bool g_monitor_initialized = false;      /**< 初始化标志 */
@@ -25,6 +65,8 @@ static bool g_monitor_initialized = false;      /**< 初始化标志 */
 /* 私有函数声明 */
 /* ========================================================================== */
 
+static uint32_t _diff_fields(const OutputCacheImage_t *current, const OutputCacheImage_t *previous);
+static void _notify_subscribers(uint32_t dirty_fields);
 static bool _is_analog_changed(int16_t current, int16_t previous);
 static uint32_t _get_timestamp(void);
 static void _update_change_rate(void);
@@ -38,98 +80,86 @@ static void _update_change_rate(void);
  */
 void EtherCAT_OutputMonitor_Init(void)
 {
-    /* 清零数据缓存 */
+    /* 清零数据缓存，锁存值与缓存一致即视为无变化 */
+    memset(&g_output_latched, 0, sizeof(g_output_latched));
     memset(&g_output_cache, 0, sizeof(g_output_cache));
+    memset(g_subscribers, 0, sizeof(g_subscribers));
+    g_dirty_fields = 0;
 
     /* 清零统计信息 */
     memset(&g_monitor_stats, 0, sizeof(g_monitor_stats));
 
-    /* 初始化缓存为当前输出状态 */
-    // g_output_cache.digital_outputs_prev = Obj0x7011.digital_outputs;
-    // g_output_cache.digital_output_mask_prev = Obj0x7011.digital_output_mask;
-
-    // for (int i = 0; i < 4; i++) {
-    //     g_output_cache.analog_outputs_prev[i] = Obj0x7012.channel[i];
-    // }
-    // g_output_cache.analog_output_mask_prev = Obj0x7012.analog_output_mask;
-
-    // g_output_cache.sensor_config_cmd_prev = Obj0x7020.sensor_config_cmd;
-    // g_output_cache.system_control_cmd_prev = Obj0x7020.system_control_cmd;
-    // g_output_cache.sampling_rate_prev = Obj0x7030.sampling_rate;
-    // g_output_cache.filter_enable_prev = Obj0x7030.filter_enable;
-
     g_monitor_stats.last_change_timestamp = _get_timestamp();
     g_monitor_initialized = true;
 
     printf("[OUTPUT_MONITOR] 输出监控模块初始化完成\r\n");
 }
 
+/**
+ * @brief 锁存主站最新下发的数据
+ * @param outputs 最新输出数据
+ */
+void EtherCAT_OutputMonitor_Latch(const OutputDataCache_t *outputs)
+{
+    UBaseType_t saved_mask;
+
+    if (outputs == NULL || !g_monitor_initialized) {
+        return;
+    }
+
+    saved_mask = taskENTER_CRITICAL_FROM_ISR();
+    memcpy(&g_output_latched.data, outputs, sizeof(OutputDataCache_t));
+    g_output_latched.data.reserved = 0;
+    taskEXIT_CRITICAL_FROM_ISR(saved_mask);
+}
+
 /**
  * @brief 检测主站下发数据是否有变化
  * @return 变化类型掩码，参见 OutputChangeType_t
  */
 uint8_t EtherCAT_OutputMonitor_CheckChanges(void)
 {
+    UBaseType_t saved_mask;
+    uint32_t dirty;
+    uint8_t changes;
+
     if (!g_monitor_initialized) {
         return OUTPUT_CHANGE_NONE;
     }
 
-    uint8_t changes = OUTPUT_CHANGE_NONE;
+    saved_mask = taskENTER_CRITICAL_FROM_ISR();
 
-    // /* 检查数字输出变化 */
-    // if ((Obj0x7011.digital_outputs != g_output_cache.digital_outputs_prev) ||
-    //     (Obj0x7011.digital_output_mask != g_output_cache.digital_output_mask_prev)) {
-    //     changes |= OUTPUT_CHANGE_DIGITAL;
-    //     g_monitor_stats.digital_changes++;
-
-    //     printf("[OUTPUT_MONITOR] 数字输出变化: 0x%04X -> 0x%04X (掩码: 0x%04X -> 0x%04X)\r\n",
-    //            g_output_cache.digital_outputs_prev, Obj0x7011.digital_outputs,
-    //            g_output_cache.digital_output_mask_prev, Obj0x7011.digital_output_mask);
-    // }
-
-    // /* 检查模拟输出变化 */
-    // for (int i = 0; i < 4; i++) {
-    //     if (_is_analog_changed(Obj0x7012.channel[i], g_output_cache.analog_outputs_prev[i])) {
-    //         changes |= OUTPUT_CHANGE_ANALOG;
-    //         break;
-    //     }
-    // }
-
-    // if (Obj0x7012.analog_output_mask != g_output_cache.analog_output_mask_prev) {
-    //     changes |= OUTPUT_CHANGE_ANALOG;
-    // }
-
-    // if (changes & OUTPUT_CHANGE_ANALOG) {
-    //     g_monitor_stats.analog_changes++;
-    //     printf("[OUTPUT_MONITOR] 模拟输出变化检测到\r\n");
-    // }
-
-    // /* 检查控制命令变化 */
-    // if ((Obj0x7020.sensor_config_cmd != g_output_cache.sensor_config_cmd_prev) ||
-    //     (Obj0x7020.system_control_cmd != g_output_cache.system_control_cmd_prev)) {
-    //     changes |= OUTPUT_CHANGE_COMMAND;
-    //     g_monitor_stats.command_changes++;
-
-    //     printf("[OUTPUT_MONITOR] 控制命令变化: 传感器cmd %d->%d, 系统cmd %d->%d\r\n",
-    //            g_output_cache.sensor_config_cmd_prev, Obj0x7020.sensor_config_cmd,
-    //            g_output_cache.system_control_cmd_prev, Obj0x7020.system_control_cmd);
-    // }
-
-    // /* 检查配置参数变化 */
-    // if ((Obj0x7030.sampling_rate != g_output_cache.sampling_rate_prev) ||
-    //     (Obj0x7030.filter_enable != g_output_cache.filter_enable_prev)) {
-    //     changes |= OUTPUT_CHANGE_CONFIG;
-
-    //     printf("[OUTPUT_MONITOR] 配置参数变化: 采样率 %d->%d, 滤波 %d->%d\r\n",
-    //            g_output_cache.sampling_rate_prev, Obj0x7030.sampling_rate,
-    //            g_output_cache.filter_enable_prev, Obj0x7030.filter_enable);
-    // }
+    dirty = _diff_fields(&g_output_latched, &g_output_cache);
+
+    /* 只提交已报告的字段，低于阈值的模拟量变化继续相对旧值累积 */
+    for (uint8_t i = 0; i < OUTPUT_FIELD_COUNT; i++) {
+        if (dirty & OUTPUT_FIELD_BIT(i)) {
+            g_output_cache.fields[i] = g_output_latched.fields[i];
+        }
+    }
+
+    g_dirty_fields = dirty;
+
+    taskEXIT_CRITICAL_FROM_ISR(saved_mask);
+
+    changes = EtherCAT_OutputMonitor_FieldsToChangeType(dirty);
 
     /* 更新统计信息 */
     g_monitor_stats.total_updates++;
 
+    if (changes & OUTPUT_CHANGE_DIGITAL) {
+        g_monitor_stats.digital_changes++;
+    }
+    if (changes & OUTPUT_CHANGE_ANALOG) {
+        g_monitor_stats.analog_changes++;
+    }
+    if (changes & OUTPUT_CHANGE_COMMAND) {
+        g_monitor_stats.command_changes++;
+    }
+
     if (changes != OUTPUT_CHANGE_NONE) {
         g_monitor_stats.last_change_timestamp = _get_timestamp();
+        _notify_subscribers(dirty);
     } else {
         g_monitor_stats.skipped_updates++;
     }
@@ -139,33 +169,109 @@ uint8_t EtherCAT_OutputMonitor_CheckChanges(void)
     return changes;
 }
 
+/**
+ * @brief 获取最近一次检测到的字段脏位
+ */
+uint32_t EtherCAT_OutputMonitor_GetDirtyFields(void)
+{
+    return g_dirty_fields;
+}
+
+/**
+ * @brief 字段脏位转换为变化类型
+ */
+uint8_t EtherCAT_OutputMonitor_FieldsToChangeType(uint32_t field_mask)
+{
+    uint8_t changes = OUTPUT_CHANGE_NONE;
+
+    if (field_mask & OUTPUT_FIELDS_DIGITAL) {
+        changes |= OUTPUT_CHANGE_DIGITAL;
+    }
+    if (field_mask & OUTPUT_FIELDS_ANALOG) {
+        changes |= OUTPUT_CHANGE_ANALOG;
+    }
+    if (field_mask & OUTPUT_FIELDS_COMMAND) {
+        changes |= OUTPUT_CHANGE_COMMAND;
+    }
+    if (field_mask & OUTPUT_FIELDS_CONFIG) {
+        changes |= OUTPUT_CHANGE_CONFIG;
+    }
+
+    return changes;
+}
+
+/**
+ * @brief 订阅字段变化
+ */
+bool EtherCAT_OutputMonitor_Subscribe(TaskHandle_t task, uint32_t field_mask)
+{
+    bool result = false;
+
+    if (task == NULL || (field_mask & OUTPUT_FIELD_ALL) == 0) {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    for (uint8_t i = 0; i < OUTPUT_MONITOR_MAX_SUBSCRIBERS; i++) {
+        if (g_subscribers[i].task == task || g_subscribers[i].task == NULL) {
+            g_subscribers[i].task = task;
+            g_subscribers[i].field_mask = field_mask & OUTPUT_FIELD_ALL;
+            result = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return result;
+}
+
+/**
+ * @brief 取消订阅
+ */
+void EtherCAT_OutputMonitor_Unsubscribe(TaskHandle_t task)
+{
+    taskENTER_CRITICAL();
+    for (uint8_t i = 0; i < OUTPUT_MONITOR_MAX_SUBSCRIBERS; i++) {
+        if (g_subscribers[i].task == task) {
+            g_subscribers[i].task = NULL;
+            g_subscribers[i].field_mask = 0;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 获取当前锁存的输出数据
+ */
+void EtherCAT_OutputMonitor_GetOutputs(OutputDataCache_t *outputs)
+{
+    UBaseType_t saved_mask;
+
+    if (outputs == NULL) {
+        return;
+    }
+
+    saved_mask = taskENTER_CRITICAL_FROM_ISR();
+    memcpy(outputs, &g_output_latched.data, sizeof(OutputDataCache_t));
+    taskEXIT_CRITICAL_FROM_ISR(saved_mask);
+}
+
 /**
  * @brief 更新输出数据缓存
  * @param force_update 强制更新（用于心跳或周期性检查）
  */
 void EtherCAT_OutputMonitor_UpdateCache(bool force_update)
 {
+    UBaseType_t saved_mask;
+
     if (!g_monitor_initialized) {
         return;
     }
 
-    /* 更新数字输出缓存 */
-    // g_output_cache.digital_outputs_prev = Obj0x7011.digital_outputs;
-    // g_output_cache.digital_output_mask_prev = Obj0x7011.digital_output_mask;
-
-    // /* 更新模拟输出缓存 */
-    // for (int i = 0; i < 4; i++) {
-    //     g_output_cache.analog_outputs_prev[i] = Obj0x7012.channel[i];
-    // }
-    // g_output_cache.analog_output_mask_prev = Obj0x7012.analog_output_mask;
-
-    // /* 更新控制命令缓存 */
-    // g_output_cache.sensor_config_cmd_prev = Obj0x7020.sensor_config_cmd;
-    // g_output_cache.system_control_cmd_prev = Obj0x7020.system_control_cmd;
-
-    // /* 更新配置参数缓存 */
-    // g_output_cache.sampling_rate_prev = Obj0x7030.sampling_rate;
-    // g_output_cache.filter_enable_prev = Obj0x7030.filter_enable;
+    /* 缓存整体与锁存值同步，包括低于阈值未报告的模拟量 */
+    saved_mask = taskENTER_CRITICAL_FROM_ISR();
+    memcpy(&g_output_cache, &g_output_latched, sizeof(g_output_cache));
+    taskEXIT_CRITICAL_FROM_ISR(saved_mask);
 
     if (force_update) {
         printf("[OUTPUT_MONITOR] 强制更新缓存完成\r\n");
@@ -248,6 +354,74 @@ void EtherCAT_OutputMonitor_PrintStats(void)
 /* 私有函数实现 */
 /* ========================================================================== */
 
+/**
+ * @brief 逐字异或比较，得到字段脏位
+ * @param current 当前数据
+ * @param previous 缓存数据
+ * @return 字段脏位掩码
+ */
+static uint32_t _diff_fields(const OutputCacheImage_t *current, const OutputCacheImage_t *previous)
+{
+    uint32_t dirty = 0;
+
+    for (uint8_t w = 0; w < OUTPUT_CACHE_WORDS; w++) {
+        uint32_t diff = current->words[w] ^ previous->words[w];
+
+        if (diff == 0) {
+            continue;
+        }
+
+        /* 小端: 低半字为偶数字段，高半字为奇数字段 */
+        if (diff & 0x0000FFFFu) {
+            dirty |= OUTPUT_FIELD_BIT(w * 2);
+        }
+        if (diff & 0xFFFF0000u) {
+            dirty |= OUTPUT_FIELD_BIT(w * 2 + 1);
+        }
+    }
+
+    dirty &= OUTPUT_FIELD_ALL;
+
+    /* 模拟量只有超过阈值才算变化 */
+    for (uint8_t i = OUTPUT_FIELD_ANALOG_0; i <= OUTPUT_FIELD_ANALOG_3; i++) {
+        if ((dirty & OUTPUT_FIELD_BIT(i)) &&
+            !_is_analog_changed((int16_t)current->fields[i], (int16_t)previous->fields[i])) {
+            dirty &= ~OUTPUT_FIELD_BIT(i);
+        }
+    }
+
+    return dirty;
+}
+
+/**
+ * @brief 通知订阅了变化字段的任务
+ * @param dirty_fields 字段脏位掩码
+ */
+static void _notify_subscribers(uint32_t dirty_fields)
+{
+    BaseType_t in_isr = xPortIsInsideInterrupt();
+    BaseType_t higher_priority_woken = pdFALSE;
+
+    for (uint8_t i = 0; i < OUTPUT_MONITOR_MAX_SUBSCRIBERS; i++) {
+        TaskHandle_t task = g_subscribers[i].task;
+        uint32_t fields = dirty_fields & g_subscribers[i].field_mask;
+
+        if (task == NULL || fields == 0) {
+            continue;
+        }
+
+        if (in_isr) {
+            xTaskNotifyIndexedFromISR(task, OUTPUT_MONITOR_NOTIFY_INDEX, fields, eSetBits, &higher_priority_woken);
+        } else {
+            xTaskNotifyIndexed(task, OUTPUT_MONITOR_NOTIFY_INDEX, fields, eSetBits);
+        }
+    }
+
+    if (in_isr) {
+        portYIELD_FROM_ISR(higher_priority_woken);
+    }
+}
+
 /**
  * @brief 检查模拟量是否发生显著变化
  * @param current 当前值
@@ -0,0 +1,511 @@
+/**
+ ******************************************************************************
+ * @file    ethercat_oversampling.c
+ * @brief   模拟通道过采样输入PDO模块实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 采样时序 (以N=4为例, T为SYNC0周期):
+ *
+ *   SYNC0 ──┬──────────┬──────────┬──────────┬──────── SYNC0
+ *           s0         s1         s2         s3
+ *           |<- T/4 -->|
+ *
+ * SYNC0中断只记录时间戳并挂起定时器中断, s0在定时器中断中启动, 同时以
+ * T/N为周期启动定时器, s1..s(N-1)在后续定时器中断中启动. 每个采样点由
+ * SPI DMA完成, 结果在DMA完成回调中写入; 最后一个采样点完成后发布采样帧.
+ * 定时器和DMA中断同为ADS8688_ACQ_IRQ_PRIORITY, 互不嵌套, 采样状态只在
+ * 这两个中断中修改.
+ * 采样帧双缓冲: 中断写后备帧, 完成后切换发布索引, APPL_InputMapping
+ * 只读取已发布的完整帧. 中断只写未发布的帧, 复制期间若再次发布, 下一帧
+ * 会立即写入正在复制的帧 (上一帧补齐发布后BeginFrame写新时间戳), 因此
+ * 复制前后比较发布计数, 变化则重新复制.
+ *
+ * ADC总线被任务扫描, 后台采集帧或上一个未完成的采样点占用时, 该采样点记为
+ * OVERSAMPLING_SAMPLE_INVALID并计入丢失计数; 下一个SYNC0到来时仍未完成的
+ * 采样帧同样补齐后发布, 仍在传输的采样点结果被丢弃.
+ ******************************************************************************
+ */
+
+#include "ethercat_oversampling.h"
+#include "ads8688/bsp_ads8688.h"
+#include <string.h>
+#include <stdio.h>
+
+/* ========================================================================== */
+/* 私有宏定义 */
+/* ========================================================================== */
+
+#define OS_PDO_ENTRY(index, sub, bits)  (((uint32_t)(index) << 16) | ((uint32_t)(sub) << 8) | (uint32_t)(bits))
+
+#define OS_INDEX_STATUS                 0x6010      // 时间戳/丢失计数
+#define OS_INDEX_CHANNEL_A              0x6011      // 通道A采样
+#define OS_INDEX_HEADER_WORDS           3           // 时间戳(2字) + 丢失计数(1字)
+
+/* ========================================================================== */
+/* 私有变量 */
+/* ========================================================================== */
+
+static TIM_HandleTypeDef g_oversampling_tim;
+
+static oversampling_config_t g_config = {1, 1, {0, OVERSAMPLING_CHANNEL_NONE}};
+static volatile bool g_running = false;
+
+// 双缓冲采样帧, g_published_index指向最新的完整帧
+static oversampling_frame_t g_frames[2];
+static volatile uint8_t g_published_index = 0;
+static volatile uint32_t g_publish_count = 0;       // 每次发布加1
+
+// 采样进度 (仅定时器和DMA中断中修改)
+static uint8_t g_capture_index = 0;
+static uint8_t g_sample_index = 0;                  // 下一个要启动的采样点
+static bool g_capturing = false;
+static uint16_t g_missed = 0;
+static uint8_t g_read_slot = 0;                     // 正在传输的采样点
+static bool g_read_pending = false;                 // 采样点传输中
+static bool g_read_discard = false;                 // 传输中的结果已作废 (帧已补齐发布或已停止)
+
+// SYNC0中断交给定时器中断的事件
+static volatile bool g_sync_pending = false;
+static volatile uint32_t g_sync_timestamp = 0;
+
+/* ========================================================================== */
+/* 私有函数声明 */
+/* ========================================================================== */
+
+static void Oversampling_BeginFrame(void);
+static void Oversampling_TakeSample(void);
+static void Oversampling_OnSample(HAL_StatusTypeDef status, const uint16_t *data);
+static void Oversampling_Publish(void);
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化过采样模块
+ */
+void Oversampling_Init(void)
+{
+    Oversampling_Stop();
+
+    g_config.factor = 1;
+    g_config.channel_count = 1;
+    g_config.channels[0] = 0;
+    g_config.channels[1] = OVERSAMPLING_CHANNEL_NONE;
+
+    memset(g_frames, 0, sizeof(g_frames));
+    g_published_index = 0;
+    g_missed = 0;
+
+    // 采样间隔定时器, 周期在Oversampling_Start中按SYNC0周期设置
+    OVERSAMPLING_TIM_RCC_CLK_ENABLE();
+
+    g_oversampling_tim.Instance = OVERSAMPLING_TIMx;
+    g_oversampling_tim.Init.Prescaler = OVERSAMPLING_TIM_PRESCALER;
+    g_oversampling_tim.Init.CounterMode = TIM_COUNTERMODE_UP;
+    g_oversampling_tim.Init.Period = 0xFFFF;
+    g_oversampling_tim.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    g_oversampling_tim.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    HAL_TIM_Base_Init(&g_oversampling_tim);
+
+    // 与ADS8688 DMA中断同级, 采样启动和完成回调互不嵌套; 不调用RTOS接口
+    HAL_NVIC_SetPriority(OVERSAMPLING_TIM_IRQ, ADS8688_ACQ_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(OVERSAMPLING_TIM_IRQ);
+
+    printf("[Oversampling] Initialized\r\n");
+}
+
+/**
+ * @brief 检查配置是否合法
+ */
+bool Oversampling_CheckConfig(const oversampling_config_t *config)
+{
+    if (config == NULL) {
+        return false;
+    }
+
+    if (config->factor < 1 || config->factor > OVERSAMPLING_MAX_FACTOR) {
+        return false;
+    }
+
+    if (config->channel_count < 1 || config->channel_count > OVERSAMPLING_MAX_CHANNELS) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < config->channel_count; i++) {
+        if (config->channels[i] >= OVERSAMPLING_ADC_CHANNELS) {
+            return false;
+        }
+        if (i > 0 && config->channels[i] == config->channels[0]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief 设置配置
+ */
+BaseType_t Oversampling_SetConfig(const oversampling_config_t *config)
+{
+    if (g_running || !Oversampling_CheckConfig(config)) {
+        return pdFAIL;
+    }
+
+    g_config = *config;
+    for (uint8_t i = config->channel_count; i < OVERSAMPLING_MAX_CHANNELS; i++) {
+        g_config.channels[i] = OVERSAMPLING_CHANNEL_NONE;
+    }
+
+    return pdPASS;
+}
+
+/**
+ * @brief 获取当前配置
+ */
+void Oversampling_GetConfig(oversampling_config_t *config)
+{
+    if (config != NULL) {
+        *config = g_config;
+    }
+}
+
+/**
+ * @brief 计算采样间隔
+ */
+uint32_t Oversampling_GetSpacingUs(uint32_t cycle_time_ns, uint8_t factor)
+{
+    if (factor == 0) {
+        return 0;
+    }
+
+    return (cycle_time_ns / factor) / 1000UL;
+}
+
+/**
+ * @brief 检查配置在给定SYNC0周期下能否完成采样
+ */
+bool Oversampling_CheckTiming(const oversampling_config_t *config, uint32_t cycle_time_ns)
+{
+    uint32_t spacing_ns;
+    uint32_t sample_ns;
+
+    if (!Oversampling_CheckConfig(config) || cycle_time_ns < OVERSAMPLING_MIN_CYCLE_NS) {
+        return false;
+    }
+
+    // 每个采样点需要 通道数+1 个SPI帧, 必须在下一个采样点之前完成,
+    // 否则下一个采样点因总线占用而丢失
+    spacing_ns = Oversampling_GetSpacingUs(cycle_time_ns, config->factor) * 1000UL;
+    sample_ns = (uint32_t)(config->channel_count + 1) * OVERSAMPLING_SPI_FRAME_NS;
+
+    return (spacing_ns >= sample_ns) && (spacing_ns / 1000UL <= 0x10000UL);
+}
+
+/**
+ * @brief 生成TxPDO 0x1A01映射条目
+ */
+uint16_t Oversampling_BuildMapping(const oversampling_config_t *config, uint32_t *entries)
+{
+    uint16_t count = 0;
+
+    if (!Oversampling_CheckConfig(config) || entries == NULL) {
+        return 0;
+    }
+
+    entries[count++] = OS_PDO_ENTRY(OS_INDEX_STATUS, 1, 0x20);
+    entries[count++] = OS_PDO_ENTRY(OS_INDEX_STATUS, 2, 0x10);
+
+    for (uint8_t ch = 0; ch < config->channel_count; ch++) {
+        for (uint8_t k = 0; k < config->factor; k++) {
+            entries[count++] = OS_PDO_ENTRY(OS_INDEX_CHANNEL_A + ch, k + 1, 0x10);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief 获取TxPDO 0x1A01长度
+ */
+uint16_t Oversampling_GetPdoWords(const oversampling_config_t *config)
+{
+    if (!Oversampling_CheckConfig(config)) {
+        return 0;
+    }
+
+    return (uint16_t)(OS_INDEX_HEADER_WORDS + config->factor * config->channel_count);
+}
+
+/**
+ * @brief 按0x1A01布局打包采样帧
+ */
+void Oversampling_PackFrame(const oversampling_config_t *config, const oversampling_frame_t *frame,
+                            uint16_t *pdo)
+{
+    uint16_t pos = 0;
+
+    pdo[pos++] = (uint16_t)(frame->timestamp & 0xFFFFu);
+    pdo[pos++] = (uint16_t)(frame->timestamp >> 16);
+    pdo[pos++] = frame->missed;
+
+    for (uint8_t ch = 0; ch < config->channel_count; ch++) {
+        memcpy(&pdo[pos], frame->samples[ch], config->factor * sizeof(uint16_t));
+        pos += config->factor;
+    }
+}
+
+/**
+ * @brief 锁定配置并开始同步采样
+ */
+BaseType_t Oversampling_Start(uint32_t cycle_time_ns)
+{
+    uint32_t spacing_us;
+
+    if (!Oversampling_CheckTiming(&g_config, cycle_time_ns)) {
+        return pdFAIL;
+    }
+
+    spacing_us = Oversampling_GetSpacingUs(cycle_time_ns, g_config.factor);
+
+    HAL_TIM_Base_Stop_IT(&g_oversampling_tim);
+    __HAL_TIM_SET_AUTORELOAD(&g_oversampling_tim, spacing_us - 1);
+    __HAL_TIM_SET_COUNTER(&g_oversampling_tim, 0);
+
+    memset(g_frames, 0, sizeof(g_frames));
+    g_published_index = 0;
+    g_capturing = false;
+    g_missed = 0;
+    g_sync_pending = false;
+    g_running = true;
+
+    printf("[Oversampling] Started: %d x %d channel(s), spacing %lu us\r\n",
+           g_config.factor, g_config.channel_count, (unsigned long)spacing_us);
+
+    return pdPASS;
+}
+
+/**
+ * @brief 停止同步采样并解锁配置
+ */
+void Oversampling_Stop(void)
+{
+    g_running = false;
+
+    if (g_oversampling_tim.Instance == NULL) {
+        return;
+    }
+
+    // 定时器中断关闭后采样状态只剩DMA完成回调会修改
+    HAL_NVIC_DisableIRQ(OVERSAMPLING_TIM_IRQ);
+    HAL_TIM_Base_Stop_IT(&g_oversampling_tim);
+    HAL_NVIC_DisableIRQ(ADS8688_SPI_RX_DMA_IRQ);
+    HAL_NVIC_DisableIRQ(ADS8688_SPI_TX_DMA_IRQ);
+
+    if (g_read_pending) {
+        g_read_discard = true;
+        g_read_pending = false;
+    }
+    g_capturing = false;
+    g_sync_pending = false;
+
+    HAL_NVIC_EnableIRQ(ADS8688_SPI_TX_DMA_IRQ);
+    HAL_NVIC_EnableIRQ(ADS8688_SPI_RX_DMA_IRQ);
+    HAL_NVIC_ClearPendingIRQ(OVERSAMPLING_TIM_IRQ);
+    HAL_NVIC_EnableIRQ(OVERSAMPLING_TIM_IRQ);
+}
+
+/**
+ * @brief 是否正在同步采样
+ */
+bool Oversampling_IsRunning(void)
+{
+    return g_running;
+}
+
+/**
+ * @brief SYNC0事件处理
+ */
+void Oversampling_OnSync0(uint32_t dc_time)
+{
+    if (!g_running) {
+        return;
+    }
+
+    // 定时器中断优先级更高, 挂起后立即开始新帧
+    g_sync_timestamp = dc_time;
+    g_sync_pending = true;
+    HAL_NVIC_SetPendingIRQ(OVERSAMPLING_TIM_IRQ);
+}
+
+/**
+ * @brief 采样间隔定时器中断处理
+ */
+void Oversampling_TimerIsr(void)
+{
+    if (g_sync_pending) {
+        g_sync_pending = false;
+        if (g_running) {
+            Oversampling_BeginFrame();
+        }
+        return;
+    }
+
+    if (__HAL_TIM_GET_FLAG(&g_oversampling_tim, TIM_FLAG_UPDATE) == RESET) {
+        return;
+    }
+    __HAL_TIM_CLEAR_FLAG(&g_oversampling_tim, TIM_FLAG_UPDATE);
+
+    if (!g_running || !g_capturing) {
+        HAL_TIM_Base_Stop_IT(&g_oversampling_tim);
+        return;
+    }
+
+    Oversampling_TakeSample();
+}
+
+/**
+ * @brief 复制最新的完整采样帧
+ */
+void Oversampling_CopyPdo(uint16_t *pdo)
+{
+    uint32_t count;
+
+    // 采样中断优先级高于调用者, 复制被其抢占并发布时重新复制
+    do {
+        count = g_publish_count;
+        __DMB();
+        Oversampling_PackFrame(&g_config, &g_frames[g_published_index], pdo);
+        __DMB();
+    } while (count != g_publish_count);
+}
+
+/* ========================================================================== */
+/* 私有函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 开始一个同步周期的采样帧 (SYNC0挂起的定时器中断中调用)
+ */
+static void Oversampling_BeginFrame(void)
+{
+    oversampling_frame_t *frame;
+
+    HAL_TIM_Base_Stop_IT(&g_oversampling_tim);
+
+    // 上一周期未采完: 传输中和未启动的点记为丢失, 补齐后发布
+    if (g_capturing) {
+        frame = &g_frames[g_capture_index];
+        if (g_read_pending) {
+            for (uint8_t ch = 0; ch < g_config.channel_count; ch++) {
+                frame->samples[ch][g_read_slot] = OVERSAMPLING_SAMPLE_INVALID;
+            }
+            g_missed++;
+            g_read_pending = false;
+            g_read_discard = true;
+        }
+        while (g_sample_index < g_config.factor) {
+            for (uint8_t ch = 0; ch < g_config.channel_count; ch++) {
+                frame->samples[ch][g_sample_index] = OVERSAMPLING_SAMPLE_INVALID;
+            }
+            g_missed++;
+            g_sample_index++;
+        }
+        Oversampling_Publish();
+    }
+
+    g_capture_index = g_published_index ^ 1u;
+    g_frames[g_capture_index].timestamp = g_sync_timestamp;
+    g_sample_index = 0;
+    g_capturing = true;
+
+    // 先启动定时器, 后续采样点以SYNC0为基准等间隔
+    if (g_config.factor > 1) {
+        __HAL_TIM_SET_COUNTER(&g_oversampling_tim, 0);
+        __HAL_TIM_CLEAR_FLAG(&g_oversampling_tim, TIM_FLAG_UPDATE);
+        HAL_TIM_Base_Start_IT(&g_oversampling_tim);
+    }
+
+    Oversampling_TakeSample();
+}
+
+/**
+ * @brief 启动一个采样点的读取, 总线被占用时记为丢失
+ */
+static void Oversampling_TakeSample(void)
+{
+    oversampling_frame_t *frame = &g_frames[g_capture_index];
+    uint8_t slot = g_sample_index++;
+
+    if (g_sample_index >= g_config.factor) {
+        HAL_TIM_Base_Stop_IT(&g_oversampling_tim);
+    }
+
+    if (BSP_ADS8688_StartChannelsIsr(g_config.channels, g_config.channel_count, Oversampling_OnSample) == HAL_OK) {
+        g_read_slot = slot;
+        g_read_pending = true;
+        return;
+    }
+
+    for (uint8_t ch = 0; ch < g_config.channel_count; ch++) {
+        frame->samples[ch][slot] = OVERSAMPLING_SAMPLE_INVALID;
+    }
+    g_missed++;
+
+    // 最后一个点: 前一个点仍在传输时由其完成回调发布
+    if (g_sample_index >= g_config.factor && !g_read_pending) {
+        Oversampling_Publish();
+    }
+}
+
+/**
+ * @brief 采样点读取完成 (ADS8688 DMA中断中调用)
+ */
+static void Oversampling_OnSample(HAL_StatusTypeDef status, const uint16_t *data)
+{
+    oversampling_frame_t *frame = &g_frames[g_capture_index];
+
+    if (g_read_discard) {
+        g_read_discard = false;
+        return;
+    }
+
+    if (!g_read_pending) {
+        return;
+    }
+    g_read_pending = false;
+
+    for (uint8_t ch = 0; ch < g_config.channel_count; ch++) {
+        if (status == HAL_OK) {
+            frame->samples[ch][g_read_slot] = (data[ch] < OVERSAMPLING_SAMPLE_INVALID) ? data[ch] : OVERSAMPLING_SAMPLE_MAX;
+        } else {
+            frame->samples[ch][g_read_slot] = OVERSAMPLING_SAMPLE_INVALID;
+        }
+    }
+    if (status != HAL_OK) {
+        g_missed++;
+    }
+
+    if (g_capturing && g_sample_index >= g_config.factor) {
+        Oversampling_Publish();
+    }
+}
+
+/**
+ * @brief 发布当前采样帧
+ */
+static void Oversampling_Publish(void)
+{
+    g_frames[g_capture_index].missed = g_missed;
+    __DMB();
+    g_published_index = g_capture_index;
+    g_publish_count++;
+    g_capturing = false;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
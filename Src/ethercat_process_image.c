@@ -0,0 +1,192 @@
+/**
+ ******************************************************************************
+ * @file    ethercat_process_image.c
+ * @brief   墨路控制TxPDO过程映像转换模块实现
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 映像表按TxPDO 0x1A00的映射顺序排列, 转换函数一次遍历即生成
+ * 完整的INT16映像. Cortex-M4没有浮点SIMD, 单次查表循环即为
+ * 开销最小的实现; 换算参数全部集中在映像表中, 不再分散在各处.
+ ******************************************************************************
+ */
+
+#include "ethercat_process_image.h"
+#include <string.h>
+#include <stdio.h>
+
+/* ========================================================================== */
+/* 私有宏定义 */
+/* ========================================================================== */
+
+#define PI_SENSOR(field)                PI_SOURCE_SENSOR, (uint16_t)offsetof(sensor_context_t, field)
+#define PI_APPL(id)                     PI_SOURCE_APPL, (uint16_t)(id)
+
+#define PI_INT16_MIN                    (-32768)
+#define PI_INT16_MAX                    32767
+
+#define PI_PDO_ENTRY(index, sub)        (((uint32_t)(index) << 16) | ((uint32_t)(sub) << 8) | 0x10u)
+
+/* ========================================================================== */
+/* 私有变量 */
+/* ========================================================================== */
+
+// TxPDO 0x1A00映像表 (顺序与0x1A00子索引1-25一致)
+static const process_image_channel_t g_txpdo_schema[PROCESS_IMAGE_TXPDO_WORDS] = {
+    /* 0x6000 输入/输出状态 */
+    {0x6000, 0x01, PI_APPL(PI_APPL_INPUT_STATUS),           0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6000, 0x02, PI_APPL(PI_APPL_OUTPUT_STATUS),          0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    /* 0x6001 报警信息 */
+    {0x6001, 0x01, PI_APPL(PI_APPL_ALARM_1),                0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6001, 0x02, PI_APPL(PI_APPL_ALARM_2),                0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    /* 0x6002 提示信息 */
+    {0x6002, 0x01, PI_APPL(PI_APPL_INFO_1),                 0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6002, 0x02, PI_APPL(PI_APPL_INFO_2),                 0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    /* 0x6003 状态显示/状态码 */
+    {0x6003, 0x01, PI_APPL(PI_APPL_STATE_DISPLAY),          0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6003, 0x02, PI_APPL(PI_APPL_STATE_CODE),             0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    /* 0x6004 墨盒温度(0.1°C)/阻尼器温度(0.1°C)/墨盒液位(0.1mm) */
+    {0x6004, 0x01, PI_SENSOR(temp_values[0]),               0.0f, 10.0f, PI_INT16_MIN, PI_INT16_MAX},
+    {0x6004, 0x02, PI_SENSOR(temp_values[1]),               0.0f, 10.0f, PI_INT16_MIN, PI_INT16_MAX},
+    {0x6004, 0x03, PI_SENSOR(level_values[3]),              0.0f, 10.0f, 0,            PI_INT16_MAX},
+    /* 0x6005 供墨泵/回墨泵流量(0.1%) */
+    {0x6005, 0x01, PI_APPL(PI_APPL_SUPPLY_PUMP_PERCENT),    0.0f, 10.0f, 0,            1000},
+    {0x6005, 0x02, PI_APPL(PI_APPL_RETURN_PUMP_PERCENT),    0.0f, 10.0f, 0,            1000},
+    /* 0x6006 Pin/Pout目标值(0.1kPa) */
+    {0x6006, 0x01, PI_APPL(PI_APPL_PIN_SETPOINT),           0.0f, 10.0f, PI_INT16_MIN, PI_INT16_MAX},
+    {0x6006, 0x02, PI_APPL(PI_APPL_POUT_SETPOINT),          0.0f, 10.0f, PI_INT16_MIN, PI_INT16_MAX},
+    /* 0x6007 Pin/Pout/Pm/DP实际值(0.1kPa) */
+    {0x6007, 0x01, PI_SENSOR(pressure_values[0]),           0.0f, 10.0f, PI_INT16_MIN, PI_INT16_MAX},
+    {0x6007, 0x02, PI_SENSOR(pressure_values[1]),           0.0f, 10.0f, PI_INT16_MIN, PI_INT16_MAX},
+    {0x6007, 0x03, PI_SENSOR(pressure_values[2]),           0.0f, 10.0f, PI_INT16_MIN, PI_INT16_MAX},
+    {0x6007, 0x04, PI_SENSOR(pressure_values[3]),           0.0f, 10.0f, PI_INT16_MIN, PI_INT16_MAX},
+    /* 0x6007 泵阀动画状态 */
+    {0x6007, 0x05, PI_APPL(PI_APPL_FILL_PUMP_ANIM),         0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6007, 0x06, PI_APPL(PI_APPL_SUPPLY_PUMP_ANIM),       0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6007, 0x07, PI_APPL(PI_APPL_RETURN_PUMP_ANIM),       0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6007, 0x08, PI_APPL(PI_APPL_REFILL_PUMP_ANIM),       0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6007, 0x09, PI_APPL(PI_APPL_COLLECT_VALVE_ANIM),     0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+    {0x6007, 0x0A, PI_APPL(PI_APPL_DRUM_RETURN_VALVE_ANIM), 0.0f, 1.0f,  PI_INT16_MIN, PI_INT16_MAX},
+};
+
+// 应用数据 (任务上下文写入, 映像刷新时读取)
+static volatile float g_appl_values[PI_APPL_COUNT] = {0};
+
+// 双缓冲映像, g_published_index指向最新的完整映像
+static int16_t g_txpdo_image[2][PROCESS_IMAGE_TXPDO_WORDS] = {0};
+static volatile uint8_t g_published_index = 0;
+
+/* ========================================================================== */
+/* 公共函数实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 初始化过程映像
+ */
+void ProcessImage_Init(void)
+{
+    memset((void *)g_appl_values, 0, sizeof(g_appl_values));
+    memset(g_txpdo_image, 0, sizeof(g_txpdo_image));
+    g_published_index = 0;
+
+    printf("[ProcessImage] Initialized, %d TxPDO entries\r\n", PROCESS_IMAGE_TXPDO_WORDS);
+}
+
+/**
+ * @brief 获取TxPDO映像表
+ */
+const process_image_channel_t *ProcessImage_GetSchema(uint16_t *count)
+{
+    if (count != NULL) {
+        *count = PROCESS_IMAGE_TXPDO_WORDS;
+    }
+    return g_txpdo_schema;
+}
+
+/**
+ * @brief 按映像表一次性转换所有通道
+ */
+void ProcessImage_Convert(const process_image_channel_t *schema, uint16_t count,
+                          const sensor_context_t *snapshot, const float *appl_values,
+                          int16_t *image)
+{
+    const uint8_t *base = (const uint8_t *)snapshot;
+    uint16_t i;
+
+    for (i = 0; i < count; i++) {
+        const process_image_channel_t *ch = &schema[i];
+        float value;
+
+        if (ch->source == PI_SOURCE_SENSOR) {
+            memcpy(&value, base + ch->source_offset, sizeof(float));
+        } else {
+            value = appl_values[ch->source_offset];
+        }
+
+        image[i] = ProcessImage_ScaleToInt16(value, ch->offset, ch->scale, ch->min, ch->max);
+    }
+}
+
+/**
+ * @brief 用传感器快照刷新TxPDO映像
+ */
+void ProcessImage_UpdateFromSensors(const sensor_context_t *snapshot)
+{
+    float appl_values[PI_APPL_COUNT];
+    uint8_t back_index;
+
+    if (snapshot == NULL) {
+        return;
+    }
+
+    memcpy(appl_values, (const void *)g_appl_values, sizeof(appl_values));
+
+    // 写后备缓冲, 完成后再切换发布索引
+    back_index = g_published_index ^ 1u;
+    ProcessImage_Convert(g_txpdo_schema, PROCESS_IMAGE_TXPDO_WORDS,
+                         snapshot, appl_values, g_txpdo_image[back_index]);
+    g_published_index = back_index;
+}
+
+/**
+ * @brief 设置应用数据通道
+ */
+void ProcessImage_SetApplValue(pi_appl_value_t id, float value)
+{
+    if (id < PI_APPL_COUNT) {
+        g_appl_values[id] = value;
+    }
+}
+
+/**
+ * @brief 获取最新的完整TxPDO映像
+ */
+const int16_t *ProcessImage_GetTxPdo(void)
+{
+    return g_txpdo_image[g_published_index];
+}
+
+/**
+ * @brief 检查PDO映射条目是否与映像表一致
+ */
+bool ProcessImage_MatchesMapping(const uint32_t *entries, uint16_t count)
+{
+    uint16_t i;
+
+    if (entries == NULL || count != PROCESS_IMAGE_TXPDO_WORDS) {
+        return false;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (entries[i] != PI_PDO_ENTRY(g_txpdo_schema[i].index, g_txpdo_schema[i].subindex)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/************************ (C) COPYRIGHT Ink Supply Control System *****END OF FILE****/
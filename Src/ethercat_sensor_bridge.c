@@ -7,6 +7,8 @@
  */
 
 #include "ethercat_sensor_bridge.h"
+#include "ethercat_process_image.h"
+#include "ethercat_output_monitor.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -23,14 +25,7 @@ static uint32_t g_update_counter = 0;                /**< 更新计数器 */
 static uint32_t g_last_update_time = 0;              /**< 上次更新时间 */
 
 /* 传感器统计数据 */
-typedef struct {
-    float min_value;
-    float max_value;
-    float sum_value;
-    uint32_t sample_count;
-} SensorStats_t;
-
-static SensorStats_t g_sensor_stats[7];              /**< 7个模拟传感器的统计数据 */
+static stream_stats_t g_sensor_stats[7];             /**< 7个模拟传感器的流式统计 */
 
 /* ========================================================================== */
 /* 私有函数声明 */
@@ -57,7 +52,6 @@ int EtherCAT_SensorBridge_Init(const EtherCATBridgeConfig_t *config)
     memset(&g_bridge_config, 0, sizeof(EtherCATBridgeConfig_t));
     memset(&g_sensor_inputs, 0, sizeof(EtherCAT_SensorInputs_t));
     memset(&g_sensor_outputs, 0, sizeof(EtherCAT_SensorOutputs_t));
-    memset(g_sensor_stats, 0, sizeof(g_sensor_stats));
 
     /* 设置配置参数 */
     if (config == NULL) {
@@ -74,10 +68,7 @@ int EtherCAT_SensorBridge_Init(const EtherCATBridgeConfig_t *config)
 
     /* 初始化传感器统计数据 */
     for (int i = 0; i < 7; i++) {
-        g_sensor_stats[i].min_value = 999999.0f;
-        g_sensor_stats[i].max_value = -999999.0f;
-        g_sensor_stats[i].sum_value = 0.0f;
-        g_sensor_stats[i].sample_count = 0;
+        StreamStats_Init(&g_sensor_stats[i]);
     }
 
     return 0;
@@ -145,12 +136,6 @@ void EtherCAT_SensorBridge_UpdateInputs(void)
     /* 更新统计数据 */
     _update_sensor_statistics();
 
-    /* 映射到原有的EtherCAT对象 */
-    if (g_bridge_config.enable_digital_io) {
-        Obj0x6000.Switch1 = g_sensor_inputs.switch_1;
-        Obj0x6000.Switch2 = g_sensor_inputs.switch_2;
-    }
-
     g_update_counter++;
     g_bridge_status = BRIDGE_STATUS_OK;
 }
@@ -160,13 +145,19 @@ void EtherCAT_SensorBridge_UpdateInputs(void)
  */
 void EtherCAT_SensorBridge_ProcessOutputs(void)
 {
+    OutputDataCache_t outputs;
+
     if (!g_bridge_enabled) {
         return;
     }
 
-    /* 读取原有的EtherCAT输出对象 */
-    g_sensor_outputs.led_1 = Obj0x7010.Led1;
-    g_sensor_outputs.led_2 = Obj0x7010.Led2;
+    /* 读取主站下发的数字输出 (位0/1=LED1/LED2) 和传感器配置命令 */
+    EtherCAT_OutputMonitor_GetOutputs(&outputs);
+    if (g_bridge_config.enable_digital_io) {
+        g_sensor_outputs.led_1 = (outputs.digital_outputs & 0x0001) ? 1 : 0;
+        g_sensor_outputs.led_2 = (outputs.digital_outputs & 0x0002) ? 1 : 0;
+    }
+    g_sensor_outputs.sensor_config_cmd = (uint8_t)outputs.sensor_config_cmd;
 
     /* 处理控制命令 */
     _process_control_commands();
@@ -212,10 +203,7 @@ void EtherCAT_SensorBridge_Reset(void)
 
     /* 重置统计数据 */
     for (int i = 0; i < 7; i++) {
-        g_sensor_stats[i].min_value = 999999.0f;
-        g_sensor_stats[i].max_value = -999999.0f;
-        g_sensor_stats[i].sum_value = 0.0f;
-        g_sensor_stats[i].sample_count = 0;
+        StreamStats_Init(&g_sensor_stats[i]);
     }
 
     /* 重置传感器模拟器 */
@@ -293,10 +281,7 @@ int EtherCAT_SensorBridge_CalibrateSensor(uint8_t sensor_id)
     }
 
     /* 重置该传感器的统计数据 */
-    g_sensor_stats[sensor_id].min_value = 999999.0f;
-    g_sensor_stats[sensor_id].max_value = -999999.0f;
-    g_sensor_stats[sensor_id].sum_value = 0.0f;
-    g_sensor_stats[sensor_id].sample_count = 0;
+    StreamStats_Init(&g_sensor_stats[sensor_id]);
 
     return 0;
 }
@@ -328,15 +313,27 @@ int EtherCAT_SensorBridge_GetSensorStats(uint8_t sensor_id,
         return -1;
     }
 
-    *min_value = g_sensor_stats[sensor_id].min_value;
-    *max_value = g_sensor_stats[sensor_id].max_value;
+    stream_stats_summary_t summary;
 
-    if (g_sensor_stats[sensor_id].sample_count > 0) {
-        *avg_value = g_sensor_stats[sensor_id].sum_value / g_sensor_stats[sensor_id].sample_count;
-    } else {
-        *avg_value = 0.0f;
+    StreamStats_GetSummary(&g_sensor_stats[sensor_id], &summary);
+    *min_value = summary.min;
+    *max_value = summary.max;
+    *avg_value = summary.mean;
+
+    return 0;
+}
+
+/**
+ * @brief 获取传感器完整统计信息
+ */
+int EtherCAT_SensorBridge_GetSensorStatsSummary(uint8_t sensor_id, stream_stats_summary_t *summary)
+{
+    if (sensor_id >= 7 || summary == NULL) {
+        return -1;
     }
 
+    StreamStats_GetSummary(&g_sensor_stats[sensor_id], summary);
+
     return 0;
 }
 
@@ -391,22 +388,9 @@ static void _update_sensor_statistics(void)
     values[5] = sensor_data->acceleration_z;
     values[6] = sensor_data->light_intensity;
 
-    /* 更新统计数据 */
+    /* 更新统计数据 (Welford均值方差, 窗口极值, 分位数) */
     for (i = 0; i < 7; i++) {
-        if (values[i] < g_sensor_stats[i].min_value) {
-            g_sensor_stats[i].min_value = values[i];
-        }
-        if (values[i] > g_sensor_stats[i].max_value) {
-            g_sensor_stats[i].max_value = values[i];
-        }
-        g_sensor_stats[i].sum_value += values[i];
-        g_sensor_stats[i].sample_count++;
-
-        /* 防止计数器溢出 */
-        if (g_sensor_stats[i].sample_count > 1000000) {
-            g_sensor_stats[i].sum_value /= 2.0f;
-            g_sensor_stats[i].sample_count /= 2;
-        }
+        StreamStats_Update(&g_sensor_stats[i], values[i]);
     }
 }
 
@@ -527,15 +511,7 @@ static void _process_control_commands(void)
  */
 static int16_t _float_to_int16_scaled(float value, float scale)
 {
-    float scaled_value = value * scale;
-
-    if (scaled_value > 32767.0f) {
-        return 32767;
-    } else if (scaled_value < -32768.0f) {
-        return -32768;
-    } else {
-        return (int16_t)scaled_value;
-    }
+    return ProcessImage_ScaleToInt16(value, 0.0f, scale, -32768, 32767);
 }
 
 /**
@@ -543,15 +519,7 @@ static int16_t _float_to_int16_scaled(float value, float scale)
  */
 static uint16_t _float_to_uint16_scaled(float value, float scale)
 {
-    float scaled_value = value * scale;
-
-    if (scaled_value > 65535.0f) {
-        return 65535;
-    } else if (scaled_value < 0.0f) {
-        return 0;
-    } else {
-        return (uint16_t)scaled_value;
-    }
+    return ProcessImage_ScaleToUInt16(value, 0.0f, scale);
 }
 
 /**
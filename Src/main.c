@@ -18,10 +18,13 @@
 #include "ecat_def.h"
 #include "applInterface.h"
 #include "ecatslv.h"
+#include "gpio/bsp_gpio.h"
 
 /* 传感器模拟和桥接模块 */
 #include "sensor_simulator.h"
 #include "ethercat_sensor_bridge.h"
+#include "ethercat_output_monitor.h"
+#include "ethercat_oversampling.h"
 #include "sensor_tasks.h"
 
 
@@ -31,6 +34,7 @@ void Task_LEDBlink(void *pvParameters);
 void Task_SystemMonitor(void *pvParameters);
 void Task_EtherCATApplication(void *pvParameters);
 void Task_EtherCATMainLoop(void *pvParameters);
+static void EtherCAT_MbxEventInd(void);
 
 /* FreeRTOS任务句柄 */
 TaskHandle_t xTaskHandle_LEDBlink = NULL;
@@ -74,6 +78,24 @@ int main(void)
     /* 初始化EtherCAT主程序 */
     MainInit();
 
+    /* 邮箱事件由ESC中断通知MainLoop任务处理 */
+    pAPPL_MbxEventInd = EtherCAT_MbxEventInd;
+
+    /* ESC IRQ (PC0/EXTI0): PDI_Isr调用FreeRTOS FromISR接口, 优先级不得高于configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+       未接线时ECAT_CheckTimer每MBX_EVENT_POLL_MS锁存一次邮箱事件, ECAT_Main仍能处理邮箱 */
+    EXTI0_Configuration();
+    HAL_NVIC_SetPriority(EXTI0_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+
+    /* SYNC0 (PC3/EXTI3), SYNC1 (PC1/EXTI1): Sync0_Isr同样运行ECAT_Application并访问ESC,
+       与ESC IRQ同一优先级, 互不嵌套. 仅在DC同步激活时ESC才输出脉冲 */
+    EXTI3_Configuration();
+    HAL_NVIC_SetPriority(EXTI3_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+    EXTI1_Configuration();
+    HAL_NVIC_SetPriority(EXTI1_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(EXTI1_IRQn);
+
     /* 初始化传感器模拟器 */
     if (SensorSimulator_Init(NULL) != 0) {
         //printf("ERROR: Failed to initialize sensor simulator!\r\n");
@@ -84,6 +106,12 @@ int main(void)
         //printf("ERROR: Failed to initialize EtherCAT sensor bridge!\r\n");
     }
 
+    /* 初始化主站下发数据变化监控 */
+    EtherCAT_OutputMonitor_Init();
+
+    /* 初始化过采样输入PDO (PREOP->SAFEOP时按SYNC0周期启动) */
+    Oversampling_Init();
+
     /* 启动传感器模拟器 */
     SensorSimulator_Enable(true);
 
@@ -271,11 +299,29 @@ void Task_EtherCATMainLoop(void *pvParameters)
             printf("EtherCAT MainLoop: %lu cycles\r\n", loop_counter);
         }
 
-        /* 任务延时1ms - 高频率EtherCAT处理 */
-        vTaskDelay(pdMS_TO_TICKS(1));
+        /* 等待邮箱事件通知, 最长1ms - 邮箱请求立即处理, 其余仍按1ms周期轮询 */
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1));
     }
 }
 
+/**
+  * 函数功能: 邮箱事件通知 (由PDI_Isr在中断上下文调用)
+  * 输入参数: 无
+  * 返 回 值: 无
+  * 说    明: 唤醒EtherCAT主循环任务, 邮箱在ECAT_Main中处理
+  */
+static void EtherCAT_MbxEventInd(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    if (xTaskHandle_EtherCATMainLoop == NULL) {
+        return;
+    }
+
+    vTaskNotifyGiveFromISR(xTaskHandle_EtherCATMainLoop, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
   
 
 /**
@@ -12,13 +12,16 @@ void Task_MasterSignalReceiver_Optimized(void *pvParameters)
 
     printf("Task_MasterSignalReceiver_Optimized: Started with change detection\r\n");
 
-    // 初始化输出监控模块
-    EtherCAT_OutputMonitor_Init();
+    // 订阅所有字段: 变化检测在EtherCAT应用周期中完成, 通知值即变化字段的脏位
+    EtherCAT_OutputMonitor_Subscribe(xTaskGetCurrentTaskHandle(), OUTPUT_FIELD_ALL);
 
     for (;;)
     {
-        // 1. 检查主站下发数据是否有变化
-        uint8_t changes = EtherCAT_OutputMonitor_CheckChanges();
+        uint32_t dirty_fields = 0;
+
+        // 1. 等待字段变化通知, 超时用于心跳检查和命令队列轮询
+        xTaskNotifyWaitIndexed(OUTPUT_MONITOR_NOTIFY_INDEX, 0, OUTPUT_FIELD_ALL, &dirty_fields, pdMS_TO_TICKS(10));
+        uint8_t changes = EtherCAT_OutputMonitor_FieldsToChangeType(dirty_fields);
 
         // 2. 检查是否需要强制更新（心跳机制）
         bool force_update = EtherCAT_OutputMonitor_NeedForceUpdate(FORCE_UPDATE_INTERVAL);
@@ -77,7 +80,7 @@ void Task_MasterSignalReceiver_Optimized(void *pvParameters)
         }
 
         // 8. 从队列检查是否有新命令（非阻塞）
-        if (xQueueReceive(xQueue_MasterCommands, &master_command, pdMS_TO_TICKS(10)) == pdPASS)
+        if (xQueueReceive(xQueue_MasterCommands, &master_command, 0) == pdPASS)
         {
             task_stats.commands_received++;
 
@@ -100,9 +103,6 @@ void Task_MasterSignalReceiver_Optimized(void *pvParameters)
         if ((cycle_counter % 1000) == 0 && cycle_counter > 0) {
             EtherCAT_OutputMonitor_PrintStats();
         }
-
-        // 10. 任务延时 - 根据系统负载调整
-        vTaskDelay(pdMS_TO_TICKS(changes != OUTPUT_CHANGE_NONE ? 5 : 20));
     }
 }
 
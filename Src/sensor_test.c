@@ -7,6 +7,7 @@
  */
 
 #include "sensor_test.h"
+#include "ethercat_process_image.h"
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -217,6 +218,17 @@ int SensorTest_UnitTest_Bridge(TestResults_t *results)
     test_passed = (outputs != NULL);
     _record_test_result(results, test_passed, "桥接输出处理失败");
 
+    /* 测试6: 统计数据一致性 */
+    stream_stats_summary_t summary;
+    test_passed = (EtherCAT_SensorBridge_GetSensorStatsSummary(0, &summary) == 0);
+    if (test_passed && summary.count > 0) {
+        test_passed = (summary.min <= summary.window_min && summary.window_max <= summary.max &&
+                       summary.min <= summary.quantiles[STREAM_STATS_P50] &&
+                       summary.quantiles[STREAM_STATS_P50] <= summary.max &&
+                       summary.variance >= 0.0f);
+    }
+    _record_test_result(results, test_passed, "桥接统计数据不一致");
+
     results->execution_time_ms = _get_time_ms() - g_test_start_time;
     printf("EtherCAT桥接单元测试完成: %lu/%lu 通过\r\n",
            results->tests_passed, results->tests_total);
@@ -474,6 +486,17 @@ int SensorTest_BoundaryValueTest(TestResults_t *results)
         _record_test_result(results, true, "极端值测试通过");
     }
 
+    /* PDO饱和转换边界 */
+    test_passed = (ProcessImage_ScaleToInt16(3300.0f, 0.0f, 10.0f, -32768, 32767) == 32767 &&
+                   ProcessImage_ScaleToInt16(5000.0f, 0.0f, 10.0f, -32768, 32767) == 32767 &&
+                   ProcessImage_ScaleToInt16(-5000.0f, 0.0f, 10.0f, -32768, 32767) == -32768 &&
+                   ProcessImage_ScaleToInt16(-12.34f, 0.0f, 10.0f, -32768, 32767) == -123 &&
+                   ProcessImage_ScaleToInt16(150.0f, 0.0f, 10.0f, 0, 1000) == 1000 &&
+                   ProcessImage_ScaleToInt16(-1.0f, 0.0f, 10.0f, 0, 1000) == 0 &&
+                   ProcessImage_ScaleToUInt16(7000.0f, 0.0f, 10.0f) == 65535 &&
+                   ProcessImage_ScaleToUInt16(-1.0f, 0.0f, 10.0f) == 0);
+    _record_test_result(results, test_passed, test_passed ? "PDO饱和转换测试通过" : "PDO饱和转换结果错误");
+
     /* 恢复默认配置 */
     SensorSimulator_Init(NULL);
 
@@ -23,6 +23,9 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "ethercat_oversampling.h"
+#include "ads8688/bsp_ads8688.h"
+#include "ecatappl.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -247,4 +250,56 @@ void EXTI3_IRQHandler(void)
   /* USER CODE BEGIN EXTI3_IRQn 1 */
 
   /* USER CODE END EXTI3_IRQn 1 */
+}
+
+/**
+  * @brief EXTI line callback: dispatches the ESC IRQ (PC0), SYNC0 (PC3) and SYNC1 (PC1)
+  *        to the EtherCAT slave stack.
+  */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (GPIO_Pin == GPIO_PIN_0)
+  {
+    PDI_Isr();
+  }
+  else if (GPIO_Pin == GPIO_PIN_3)
+  {
+    Sync0_Isr();
+  }
+  else if (GPIO_Pin == GPIO_PIN_1)
+  {
+    Sync1_Isr();
+  }
+}
+
+/**
+  * @brief This function handles the oversampling spacing timer interrupt.
+  */
+void OVERSAMPLING_TIM_INT_FUN(void)
+{
+  Oversampling_TimerIsr();
+}
+
+/**
+  * @brief This function handles the ADS8688 acquisition tick timer interrupt.
+  */
+void ADS8688_ACQ_TIM_INT_FUN(void)
+{
+  BSP_ADS8688_AcqTimerIsr();
+}
+
+/**
+  * @brief This function handles the ADS8688 SPI RX DMA stream interrupt.
+  */
+void ADS8688_SPI_RX_DMA_INT_FUN(void)
+{
+  HAL_DMA_IRQHandler(&hads8688_dma_rx);
+}
+
+/**
+  * @brief This function handles the ADS8688 SPI TX DMA stream interrupt.
+  */
+void ADS8688_SPI_TX_DMA_INT_FUN(void)
+{
+  HAL_DMA_IRQHandler(&hads8688_dma_tx);
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @file    control_harness.h
+ * @brief   控制任务主机测试框架
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 直接包含control_task_v3.c, 测试可访问私有状态并逐周期调用Control_RunCycle
+ * (与Task_ControlV3每次唤醒执行的步骤相同). 传感器快照/执行器设定值向量经
+ * stub/app_stub.h交换, stub_tick为毫秒时基. 每个测试程序只能包含一次.
+ ******************************************************************************
+ */
+
+#ifndef __CONTROL_HARNESS_H
+#define __CONTROL_HARNESS_H
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "app_stub.h"
+
+// 控制任务的调试打印在主机测试中关闭
+static inline int Harness_Quiet(const char *format, ...)
+{
+    (void)format;
+    return 0;
+}
+
+#define printf Harness_Quiet
+#include "../Src/APP/control_task_v3.c"
+#undef printf
+
+/**
+ * @brief 恢复到ControlTaskV3_Init之后的状态 (首次调用时执行初始化), 系统置为运行
+ * @return pdPASS=成功
+ */
+static BaseType_t Harness_Reset(void)
+{
+    static bool initialized = false;
+    control_command_t command;
+
+    if (!initialized) {
+        if (ControlTaskV3_Init() != pdPASS) {
+            return pdFAIL;
+        }
+        initialized = true;
+    }
+
+    while (xQueueReceive(xQueue_ControlCmd, &command, 0) == pdPASS) {
+    }
+
+    memset(&g_control_context, 0, sizeof(control_context_t));
+    memset(&g_control_stats, 0, sizeof(control_task_stats_t));
+    Control_InitializeLoops();
+    LatencyTrace_Reset();
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        LoopKpi_Reset(&g_loop_kpi[i]);
+        LatencyTrace_ClearStamp(&g_loop_trace[i]);
+    }
+
+    g_autotune_mask = 0;
+    g_autotune_valid_mask = 0;
+    memset(g_cascade_countdown, 0, sizeof(g_cascade_countdown));
+    g_ff_primed_mask = 0;
+    g_smith_primed_mask = 0;
+#if CONTROL_DATA_DRIVEN
+    memset(g_input_sequence, 0, sizeof(g_input_sequence));
+    memset(g_input_timestamp, 0, sizeof(g_input_timestamp));
+    g_input_primed_mask = 0;
+    g_last_supervision_tick = 0;
+#endif
+    g_output_mask = 0;
+    memset(&g_actuator_setpoints, 0, sizeof(g_actuator_setpoints));
+
+    g_control_context.system_enabled = true;
+    g_control_context.system_state = CONTROL_STATE_RUNNING;
+
+    memset(&stub_sensor_context, 0, sizeof(stub_sensor_context));
+    memset(&stub_actuator_setpoints, 0, sizeof(stub_actuator_setpoints));
+    stub_sensor_context_result = pdTRUE;
+    stub_actuator_publish_count = 0;
+    stub_notify_count = 0;
+    stub_notify_value = 0;
+    stub_tick = 0;
+    return pdPASS;
+}
+
+/**
+ * @brief 传感器任务发布一个新样本 (序号加1, 时间戳取当前stub_tick, 采集时刻取Profiler_Now)
+ */
+static void Harness_SetSensor(sensor_type_t sensor, float value)
+{
+    sensor_data_t *data = &stub_sensor_context.sensors[sensor];
+
+    data->calibrated_value = value;
+    data->filtered_value = value;
+    data->valid = true;
+    data->timestamp = stub_tick;
+    data->acquire_time = Profiler_Now();
+    data->sequence++;
+    stub_sensor_context.sequence++;
+}
+
+/**
+ * @brief 回路投入自动: 使能, 设定模式/设定值/PI参数 (无死区, 无微分, 积分限幅放宽)
+ * @note 命令在下一次Control_RunCycle开始时执行
+ */
+static void Harness_ConfigureLoop(control_loop_t loop_id, control_mode_t mode, float setpoint,
+                                  float kp, float ki, float output_min, float output_max)
+{
+    pid_params_t params = g_control_context.loops[loop_id].pid_params;
+
+    params.kp = kp;
+    params.ki = ki;
+    params.kd = 0.0f;
+    params.deadband = 0.0f;
+    params.output_min = output_min;
+    params.output_max = output_max;
+    params.integral_min = -1.0e4f;
+    params.integral_max = 1.0e4f;
+    params.derivative_enabled = false;
+
+    ControlTaskV3_SetPIDParams(loop_id, &params);
+    ControlTaskV3_SetSetpoint(loop_id, setpoint);
+    ControlTaskV3_SetMode(loop_id, mode);
+    ControlTaskV3_EnableLoop(loop_id);
+}
+
+#endif /* __CONTROL_HARNESS_H */
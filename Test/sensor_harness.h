@@ -0,0 +1,183 @@
+/**
+ ******************************************************************************
+ * @file    sensor_harness.h
+ * @brief   传感器任务主机测试框架
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 直接包含sensor_task_v3.c, 测试可访问私有状态并逐节拍调用Sensor_RunCycle
+ * (与Task_SensorV3每次唤醒执行的步骤相同). ADS8688经真实BSP驱动访问本文件
+ * 的SPI器件模型: 阻塞传输逐帧计数, 各通道转换码由harness_adc_code给出
+ * (测试在节拍之间修改, 同一节拍内的多次扫描读到相同的值). 后台采集在
+ * 初始化后停止, 任务按阻塞扫描读取. 每个测试程序只能包含一次.
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_HARNESS_H
+#define __SENSOR_HARNESS_H
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// 传感器任务和BSP的调试打印在主机测试中关闭
+static inline int Harness_Quiet(const char *format, ...)
+{
+    (void)format;
+    return 0;
+}
+
+#define printf Harness_Quiet
+#include "../Src/APP/sensor_task_v3.c"
+#undef printf
+
+/* 测试辅助 */
+static uint16_t harness_adc_code[SENSOR_ADC_CHANNELS];  // 各通道转换码
+static uint8_t harness_adc_fault;                       // 非0: 转换结果的通道地址错位 (扫描返回HAL_ERROR)
+static uint32_t harness_spi_frames;                     // 阻塞SPI传输帧数
+static float harness_pump[ACTUATOR_PUMP_OUTPUTS];       // ActuatorTaskV3_ReadPumpOutputs返回的泵驱动量
+
+/* ADS8688器件模型: 自动序列 + 程序寄存器, SDO格式3 */
+static struct {
+    uint8_t regs[0x40];
+    uint8_t next_channel;
+} g_harness_adc;
+
+static void Harness_AdcFrame(const uint8_t *tx, uint8_t *rx)
+{
+    uint8_t cmd = tx[0];
+    uint8_t channel;
+
+    memset(rx, 0, ADS_FRAME_BYTES);
+
+    // 程序寄存器访问: [地址6:0 | 读写][数据], 结果在下一个16位
+    if (cmd != CONT && (cmd & 0x80) == 0) {
+        uint8_t addr = cmd >> 1;
+
+        if (cmd & 0x01) {
+            g_harness_adc.regs[addr] = tx[1];
+        }
+        rx[2] = g_harness_adc.regs[addr];
+        return;
+    }
+
+    if (cmd == RST) {
+        memset(&g_harness_adc, 0, sizeof(g_harness_adc));
+        return;
+    }
+
+    // 转换上一帧所选的通道
+    channel = g_harness_adc.next_channel;
+    rx[2] = (uint8_t)(harness_adc_code[channel] >> 8);
+    rx[3] = (uint8_t)harness_adc_code[channel];
+    rx[4] = (uint8_t)((((channel + harness_adc_fault) & 0x07) << 4) |
+                      (g_harness_adc.regs[CHN_0_RANGE + channel] & 0x0F));
+
+    if (cmd == AUTO_RST) {
+        g_harness_adc.next_channel = 0;
+    } else if (cmd == CONT) {
+        g_harness_adc.next_channel = (uint8_t)((channel + 1) % SENSOR_ADC_CHANNELS);
+    }
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size, uint32_t timeout)
+{
+    (void)hspi;
+    (void)timeout;
+
+    if (size != ADS_FRAME_BYTES) {
+        return HAL_ERROR;
+    }
+    harness_spi_frames++;
+    Harness_AdcFrame(tx, rx);
+    return HAL_OK;
+}
+
+// 后台采集不运行 (节拍定时器中断不投递), DMA传输不会被调用
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+    (void)hspi;
+    (void)tx;
+    (void)rx;
+    (void)size;
+    return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+    return HAL_OK;
+}
+
+BaseType_t ActuatorTaskV3_ReadPumpOutputs(float *pump)
+{
+    memcpy(pump, harness_pump, sizeof(harness_pump));
+    return pdTRUE;
+}
+
+/**
+ * @brief 恢复到SensorTaskV3_Init之后的状态 (首次调用时执行初始化), 时基清零
+ * @return pdPASS=成功
+ */
+static BaseType_t Harness_Reset(void)
+{
+    static bool initialized = false;
+
+    if (!initialized) {
+        if (SensorTaskV3_Init() != pdPASS) {
+            return pdFAIL;
+        }
+        BSP_ADS8688_StopAcquisition();
+        initialized = true;
+    }
+
+    stub_tick = 0;
+    harness_adc_fault = 0;
+    harness_spi_frames = 0;
+    memset(harness_adc_code, 0, sizeof(harness_adc_code));
+    memset(harness_pump, 0, sizeof(harness_pump));
+
+    Sensor_InitializeConfigs();
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        Sensor_InitializeRate((sensor_type_t)i);
+    }
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        g_sensor_config_pending_flag[i] = false;
+    }
+    for (uint8_t ch = 0; ch < TEMP_CHANNELS; ch++) {
+        g_temp_model_pending_flag[ch] = false;
+    }
+    Sensor_InitializeFilters();
+    Sensor_InitializeAdcScaling();
+    memset(&g_adc_snapshot, 0, sizeof(g_adc_snapshot));
+
+    LevelEstimator_Init(&g_level_estimator, NULL);
+    g_level_estimator_time = 0;
+    memset(g_level_pump, 0, sizeof(g_level_pump));
+    g_level_estimator_pending_flag = false;
+
+    memset(&g_calib, 0, sizeof(g_calib));
+    memset(&g_sensor_context, 0, sizeof(sensor_context_t));
+    memset(&g_sensor_stats, 0, sizeof(sensor_task_stats_t));
+    g_publish_ticks = 0;
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        StreamStats_Init(&g_channel_stats[i]);
+    }
+    g_channel_stats_reset_mask = 0;
+
+    return pdPASS;
+}
+
+/**
+ * @brief 运行一个基础节拍, 时基前进SENSOR_BASE_TICK_MS
+ */
+static void Harness_Tick(void)
+{
+    Sensor_RunCycle();
+    stub_tick += SENSOR_BASE_TICK_MS;
+}
+
+#endif /* __SENSOR_HARNESS_H */
@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ * @file    FreeRTOS.h
+ * @brief   主机测试用FreeRTOS桩 (单线程, 不调度)
+ ******************************************************************************
+ * @attention
+ *
+ * 队列为非阻塞的环形缓冲, 与FreeRTOS相同按值复制条目; 临界区为空操作.
+ * 堆分配计数和分配钩子供测试检查内存池的分配/释放和模拟抢占.
+ ******************************************************************************
+ */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                 ((BaseType_t)0)
+#define pdTRUE                  ((BaseType_t)1)
+#define pdPASS                  pdTRUE
+#define pdFAIL                  pdFALSE
+#define portMAX_DELAY           ((TickType_t)0xFFFFFFFFUL)
+#define configTICK_RATE_HZ      1000
+#define portTICK_PERIOD_MS      1
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+
+void *pvPortMalloc(size_t size);
+void vPortFree(void *pv);
+
+/* 中断上下文由stub_in_isr模拟 */
+BaseType_t xPortIsInsideInterrupt(void);
+#define portYIELD_FROM_ISR(woken)   ((void)(woken))
+
+/* 测试辅助 */
+extern uint32_t stub_malloc_count;              // pvPortMalloc成功次数
+extern uint32_t stub_free_count;                // vPortFree次数 (不含NULL)
+extern void (*stub_malloc_hook)(size_t size);   // 分配前调用, 可在其中模拟被抢占
+extern TickType_t stub_tick;                    // xTaskGetTickCount返回值
+extern BaseType_t stub_in_isr;                  // xPortIsInsideInterrupt返回值
+
+#endif /* INC_FREERTOS_H */
@@ -0,0 +1,61 @@
+/**
+ ******************************************************************************
+ * @file    app_stub.c
+ * @brief   主机测试用应用模块桩实现
+ ******************************************************************************
+ */
+
+#include "app_stub.h"
+#include "ethercat_process_image.h"
+#include <string.h>
+
+sensor_context_t stub_sensor_context;
+BaseType_t stub_sensor_context_result = pdTRUE;
+uint32_t stub_sensor_output_period_ms[SENSOR_COUNT];
+TaskHandle_t stub_sensor_publish_notify = NULL;
+actuator_setpoint_vector_t stub_actuator_setpoints;
+uint32_t stub_actuator_publish_count = 0;
+OutputDataCache_t stub_master_outputs;
+
+BaseType_t SensorTaskV3_GetContext(sensor_context_t *context)
+{
+    if (stub_sensor_context_result == pdTRUE) {
+        memcpy(context, &stub_sensor_context, sizeof(sensor_context_t));
+    }
+    return stub_sensor_context_result;
+}
+
+uint32_t SensorTaskV3_GetOutputPeriod(sensor_type_t sensor_type)
+{
+    return (sensor_type < SENSOR_COUNT) ? stub_sensor_output_period_ms[sensor_type] : 0;
+}
+
+void SensorTaskV3_SetPublishNotify(TaskHandle_t task)
+{
+    stub_sensor_publish_notify = task;
+}
+
+BaseType_t ActuatorTaskV3_PublishSetpoints(const actuator_setpoint_vector_t *setpoints)
+{
+    memcpy(&stub_actuator_setpoints, setpoints, sizeof(actuator_setpoint_vector_t));
+    stub_actuator_publish_count++;
+    return pdTRUE;
+}
+
+bool EtherCAT_OutputMonitor_Subscribe(TaskHandle_t task, uint32_t field_mask)
+{
+    (void)task;
+    (void)field_mask;
+    return true;
+}
+
+void EtherCAT_OutputMonitor_GetOutputs(OutputDataCache_t *outputs)
+{
+    memcpy(outputs, &stub_master_outputs, sizeof(OutputDataCache_t));
+}
+
+void ProcessImage_SetApplValue(pi_appl_value_t id, float value)
+{
+    (void)id;
+    (void)value;
+}
@@ -0,0 +1,29 @@
+/**
+ ******************************************************************************
+ * @file    app_stub.h
+ * @brief   主机测试用应用模块桩: 传感器/执行器任务, EtherCAT输出监控和过程映像
+ ******************************************************************************
+ * @attention
+ *
+ * 控制任务在主机上以Control_RunCycle逐周期运行: 测试填写stub_sensor_context
+ * 作为传感器快照, 从stub_actuator_setpoints读取发布的执行器设定值.
+ ******************************************************************************
+ */
+
+#ifndef APP_STUB_H
+#define APP_STUB_H
+
+#include "sensor_task_v3.h"
+#include "actuator_task_v3.h"
+#include "ethercat_output_monitor.h"
+
+/* 测试辅助 */
+extern sensor_context_t stub_sensor_context;                    // SensorTaskV3_GetContext返回的快照
+extern BaseType_t stub_sensor_context_result;                   // SensorTaskV3_GetContext返回值
+extern uint32_t stub_sensor_output_period_ms[SENSOR_COUNT];     // SensorTaskV3_GetOutputPeriod返回值
+extern TaskHandle_t stub_sensor_publish_notify;                 // SensorTaskV3_SetPublishNotify登记的任务
+extern actuator_setpoint_vector_t stub_actuator_setpoints;      // 最近一次发布的设定值向量
+extern uint32_t stub_actuator_publish_count;                    // ActuatorTaskV3_PublishSetpoints次数
+extern OutputDataCache_t stub_master_outputs;                   // EtherCAT_OutputMonitor_GetOutputs返回值
+
+#endif /* APP_STUB_H */
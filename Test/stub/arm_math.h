@@ -0,0 +1,31 @@
+/**
+ ******************************************************************************
+ * @file    arm_math.h
+ * @brief   主机测试用CMSIS-DSP包装: 使用真实的arm_math.h和DSP源文件
+ ******************************************************************************
+ * @attention
+ *
+ * core_cm4.h中的__DMB/__DSB/__ISB是ARM汇编, 包含期间改名, 之后换回主机内存屏障.
+ ******************************************************************************
+ */
+
+#ifndef __HOST_ARM_MATH_H
+#define __HOST_ARM_MATH_H
+
+#undef __DMB
+#undef __DSB
+#undef __ISB
+#define __DMB   cmsis_dmb
+#define __DSB   cmsis_dsb
+#define __ISB   cmsis_isb
+
+#include_next "arm_math.h"
+
+#undef __DMB
+#undef __DSB
+#undef __ISB
+#define __DMB() __sync_synchronize()
+#define __DSB() __sync_synchronize()
+#define __ISB() __sync_synchronize()
+
+#endif /* __HOST_ARM_MATH_H */
@@ -0,0 +1,19 @@
+/**
+ ******************************************************************************
+ * @file    event_groups.h
+ * @brief   主机测试用FreeRTOS事件组类型桩
+ ******************************************************************************
+ */
+
+#ifndef EVENT_GROUPS_H
+#define EVENT_GROUPS_H
+
+#include "FreeRTOS.h"
+
+typedef void *EventGroupHandle_t;
+typedef TickType_t EventBits_t;
+
+EventGroupHandle_t xEventGroupCreate(void);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits);
+
+#endif /* EVENT_GROUPS_H */
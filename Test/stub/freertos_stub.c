@@ -0,0 +1,391 @@
+/**
+ ******************************************************************************
+ * @file    freertos_stub.c
+ * @brief   主机测试用FreeRTOS桩实现
+ ******************************************************************************
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "stm32f4xx_hal.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct stub_queue {
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+    uint8_t *storage;
+};
+
+uint32_t stub_malloc_count = 0;
+uint32_t stub_free_count = 0;
+void (*stub_malloc_hook)(size_t size) = NULL;
+TickType_t stub_tick = 0;
+uint64_t stub_queue_bytes_copied = 0;
+uint32_t stub_notify_count = 0;
+uint32_t stub_notify_value = 0;
+BaseType_t stub_in_isr = pdFALSE;
+
+static EventBits_t stub_event_bits;
+static uint8_t stub_task_handle;
+
+void *pvPortMalloc(size_t size)
+{
+    void *pv;
+
+    if (stub_malloc_hook != NULL) {
+        stub_malloc_hook(size);
+    }
+
+    pv = malloc(size);
+    if (pv != NULL) {
+        stub_malloc_count++;
+    }
+    return pv;
+}
+
+void vPortFree(void *pv)
+{
+    if (pv != NULL) {
+        stub_free_count++;
+        free(pv);
+    }
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return stub_tick;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return stub_tick;
+}
+
+BaseType_t xPortIsInsideInterrupt(void)
+{
+    return stub_in_isr;
+}
+
+GPIO_TypeDef stub_gpioa;
+GPIO_TypeDef stub_gpiob;
+GPIO_TypeDef stub_gpioc;
+GPIO_TypeDef stub_gpioe;
+GPIO_TypeDef stub_gpiof;
+GPIO_TypeDef stub_gpiog;
+TIM_TypeDef stub_tim1;
+TIM_TypeDef stub_tim2;
+TIM_TypeDef stub_tim4;
+TIM_TypeDef stub_tim5;
+TIM_TypeDef stub_tim14;
+SPI_TypeDef stub_spi3;
+DMA_Stream_TypeDef stub_dma1_stream0;
+DMA_Stream_TypeDef stub_dma1_stream5;
+uint64_t stub_nvic_enabled = 0;
+uint64_t stub_nvic_pending = 0;
+uint32_t stub_nvic_priority[64];
+void (*stub_nvic_enable_hook)(IRQn_Type irqn) = NULL;
+uint32_t stub_basepri = 0;
+void (*stub_basepri_hook)(uint32_t basepri) = NULL;
+
+void NVIC_EnableIRQ(IRQn_Type irqn)
+{
+    stub_nvic_enabled |= 1ULL << irqn;
+    if (stub_nvic_enable_hook != NULL) {
+        stub_nvic_enable_hook(irqn);
+    }
+}
+
+void NVIC_DisableIRQ(IRQn_Type irqn)
+{
+    stub_nvic_enabled &= ~(1ULL << irqn);
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type irqn, uint32_t preempt_priority, uint32_t sub_priority)
+{
+    (void)sub_priority;
+    stub_nvic_priority[irqn] = preempt_priority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irqn)
+{
+    NVIC_EnableIRQ(irqn);
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type irqn)
+{
+    NVIC_DisableIRQ(irqn);
+}
+
+void HAL_NVIC_SetPendingIRQ(IRQn_Type irqn)
+{
+    stub_nvic_pending |= 1ULL << irqn;
+}
+
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type irqn)
+{
+    stub_nvic_pending &= ~(1ULL << irqn);
+}
+
+uint32_t __get_BASEPRI(void)
+{
+    return stub_basepri;
+}
+
+void __set_BASEPRI(uint32_t basepri)
+{
+    stub_basepri = basepri & 0xFFU;
+    if (stub_basepri_hook != NULL) {
+        stub_basepri_hook(stub_basepri);
+    }
+}
+
+// 只提高屏蔽级别 (数值变小), 0表示不屏蔽
+void __set_BASEPRI_MAX(uint32_t basepri)
+{
+    basepri &= 0xFFU;
+    if (basepri != 0 && (stub_basepri == 0 || basepri < stub_basepri)) {
+        stub_basepri = basepri;
+    }
+    if (stub_basepri_hook != NULL) {
+        stub_basepri_hook(stub_basepri);
+    }
+}
+
+void HAL_Delay(uint32_t delay)
+{
+    stub_tick += delay;
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->ARR = htim->Init.Period;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->CR1 |= TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->CR1 &= ~TIM_CR1_CEN;
+    return HAL_OK;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init)
+{
+    (void)port;
+    (void)init;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+    if (state == GPIO_PIN_SET) {
+        port->ODR |= pin;
+    } else {
+        port->ODR &= ~(uint32_t)pin;
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin)
+{
+    return ((port->IDR & pin) != 0) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->ARR = htim->Init.Period;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *config, uint32_t channel)
+{
+    htim->Instance->CCR[channel >> 2U] = config->Pulse;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t channel)
+{
+    (void)htim;
+    (void)channel;
+    return HAL_OK;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint16_t stack_depth,
+                       void *parameters, UBaseType_t priority, TaskHandle_t *handle)
+{
+    (void)function;
+    (void)name;
+    (void)stack_depth;
+    (void)parameters;
+    (void)priority;
+    if (handle != NULL) {
+        *handle = &stub_task_handle;
+    }
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return &stub_task_handle;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    stub_tick += ticks;
+}
+
+void vTaskDelayUntil(TickType_t *previous_wake, TickType_t increment)
+{
+    *previous_wake += increment;
+    if ((TickType_t)(*previous_wake - stub_tick) < 0x80000000UL) {
+        stub_tick = *previous_wake;
+    }
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    (void)task;
+    stub_notify_count++;
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t wait)
+{
+    uint32_t count = stub_notify_count;
+
+    (void)wait;
+    if (clear_on_exit) {
+        stub_notify_count = 0;
+    } else if (stub_notify_count > 0) {
+        stub_notify_count--;
+    }
+    return count;
+}
+
+BaseType_t xTaskNotifyWaitIndexed(UBaseType_t index, uint32_t clear_on_entry, uint32_t clear_on_exit,
+                                  uint32_t *value, TickType_t wait)
+{
+    (void)index;
+    (void)clear_on_entry;
+    (void)wait;
+    if (stub_notify_value == 0) {
+        return pdFALSE;
+    }
+    if (value != NULL) {
+        *value = stub_notify_value;
+    }
+    stub_notify_value &= ~clear_on_exit;
+    return pdTRUE;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    return xQueueCreate(1, 1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t wait)
+{
+    (void)semaphore;
+    (void)wait;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    (void)semaphore;
+    return pdTRUE;
+}
+
+EventGroupHandle_t xEventGroupCreate(void)
+{
+    return &stub_event_bits;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+    *(EventBits_t *)group |= bits;
+    return *(EventBits_t *)group;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    QueueHandle_t queue = (QueueHandle_t)calloc(1, sizeof(struct stub_queue));
+
+    if (queue == NULL) {
+        return NULL;
+    }
+
+    queue->storage = (uint8_t *)malloc(length * item_size);
+    if (queue->storage == NULL) {
+        free(queue);
+        return NULL;
+    }
+
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    if (queue != NULL) {
+        free(queue->storage);
+        free(queue);
+    }
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t wait)
+{
+    UBaseType_t tail;
+
+    (void)wait;
+    if (queue->count >= queue->length) {
+        return pdFAIL;
+    }
+
+    tail = (queue->head + queue->count) % queue->length;
+    memcpy(queue->storage + tail * queue->item_size, item, queue->item_size);
+    queue->count++;
+    stub_queue_bytes_copied += queue->item_size;
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait)
+{
+    (void)wait;
+    if (queue->count == 0) {
+        return pdFAIL;
+    }
+
+    memcpy(item, queue->storage + queue->head * queue->item_size, queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    stub_queue_bytes_copied += queue->item_size;
+    return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    return queue->count;
+}
@@ -0,0 +1,24 @@
+/**
+ ******************************************************************************
+ * @file    queue.h
+ * @brief   主机测试用FreeRTOS队列桩 (非阻塞, 按值复制)
+ ******************************************************************************
+ */
+
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "FreeRTOS.h"
+
+typedef struct stub_queue *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t wait);
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+/* 测试辅助: 入队和出队复制的字节数 */
+extern uint64_t stub_queue_bytes_copied;
+
+#endif /* QUEUE_H */
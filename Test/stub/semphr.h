@@ -0,0 +1,20 @@
+/**
+ ******************************************************************************
+ * @file    semphr.h
+ * @brief   主机测试用FreeRTOS信号量类型桩
+ ******************************************************************************
+ */
+
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+#include "queue.h"
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+/* 单线程下互斥体总能立即获取 */
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+
+#endif /* SEMAPHORE_H */
@@ -0,0 +1,15 @@
+/**
+ ******************************************************************************
+ * @file    stm32f4xx.h
+ * @brief   主机测试用设备头文件桩
+ ******************************************************************************
+ */
+
+#ifndef __STM32F4xx_H
+#define __STM32F4xx_H
+
+#include "stm32f4xx_hal.h"
+
+#define __FPU_PRESENT   1       // arm_math.h (ARM_MATH_CM4) 需要
+
+#endif /* __STM32F4xx_H */
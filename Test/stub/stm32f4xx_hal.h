@@ -0,0 +1,293 @@
+/**
+ ******************************************************************************
+ * @file    stm32f4xx_hal.h
+ * @brief   主机测试用HAL桩: 只提供被测模块及其头文件用到的类型, 毫秒计数和内存屏障
+ ******************************************************************************
+ */
+
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum {
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+/* SPI/DMA: 句柄只保存配置, HAL_SPI_TransmitReceive(_DMA)/HAL_SPI_Abort由使用它们的测试实现 */
+typedef struct { uint32_t unused; } SPI_TypeDef;
+typedef struct { uint32_t unused; } DMA_Stream_TypeDef;
+
+typedef struct {
+    uint32_t Channel;
+    uint32_t Direction;
+    uint32_t PeriphInc;
+    uint32_t MemInc;
+    uint32_t PeriphDataAlignment;
+    uint32_t MemDataAlignment;
+    uint32_t Mode;
+    uint32_t Priority;
+    uint32_t FIFOMode;
+} DMA_InitTypeDef;
+
+typedef struct {
+    DMA_Stream_TypeDef *Instance;
+    DMA_InitTypeDef Init;
+    void *Parent;
+} DMA_HandleTypeDef;
+
+typedef struct {
+    uint32_t Mode;
+    uint32_t Direction;
+    uint32_t DataSize;
+    uint32_t CLKPolarity;
+    uint32_t CLKPhase;
+    uint32_t NSS;
+    uint32_t BaudRatePrescaler;
+    uint32_t FirstBit;
+    uint32_t TIMode;
+    uint32_t CRCCalculation;
+    uint32_t CRCPolynomial;
+} SPI_InitTypeDef;
+
+typedef struct {
+    SPI_TypeDef *Instance;
+    SPI_InitTypeDef Init;
+    DMA_HandleTypeDef *hdmatx;
+    DMA_HandleTypeDef *hdmarx;
+} SPI_HandleTypeDef;
+
+#define __HAL_LINKDMA(h, field, dma)    do { (h)->field = &(dma); (dma).Parent = (h); } while (0)
+
+#define SPI_MODE_MASTER             0x00000104U
+#define SPI_DIRECTION_2LINES        0x00000000U
+#define SPI_DATASIZE_8BIT           0x00000000U
+#define SPI_POLARITY_LOW            0x00000000U
+#define SPI_PHASE_2EDGE             0x00000001U
+#define SPI_NSS_SOFT                0x00000200U
+#define SPI_BAUDRATEPRESCALER_32    0x00000020U
+#define SPI_FIRSTBIT_MSB            0x00000000U
+#define SPI_TIMODE_DISABLE          0x00000000U
+#define SPI_CRCCALCULATION_DISABLE  0x00000000U
+#define DMA_CHANNEL_0               0x00000000U
+#define DMA_PERIPH_TO_MEMORY        0x00000000U
+#define DMA_MEMORY_TO_PERIPH        0x00000040U
+#define DMA_PINC_DISABLE            0x00000000U
+#define DMA_MINC_ENABLE             0x00000400U
+#define DMA_PDATAALIGN_BYTE         0x00000000U
+#define DMA_MDATAALIGN_BYTE         0x00000000U
+#define DMA_NORMAL                  0x00000000U
+#define DMA_PRIORITY_MEDIUM         0x00010000U
+#define DMA_PRIORITY_HIGH           0x00020000U
+#define DMA_FIFOMODE_DISABLE        0x00000000U
+
+extern SPI_TypeDef stub_spi3;
+extern DMA_Stream_TypeDef stub_dma1_stream0;
+extern DMA_Stream_TypeDef stub_dma1_stream5;
+#define SPI3                        (&stub_spi3)
+#define DMA1_Stream0                (&stub_dma1_stream0)
+#define DMA1_Stream5                (&stub_dma1_stream5)
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+
+/* GPIO: 端口只保存输入/输出数据寄存器, 输入电平由测试写IDR */
+typedef struct { uint32_t IDR; uint32_t ODR; } GPIO_TypeDef;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef enum {
+    RESET = 0,
+    SET = !RESET
+} FlagStatus;
+
+#define GPIO_PIN_2                  ((uint16_t)0x0004U)
+#define GPIO_PIN_3                  ((uint16_t)0x0008U)
+#define GPIO_PIN_4                  ((uint16_t)0x0010U)
+#define GPIO_PIN_5                  ((uint16_t)0x0020U)
+#define GPIO_PIN_6                  ((uint16_t)0x0040U)
+#define GPIO_PIN_7                  ((uint16_t)0x0080U)
+#define GPIO_PIN_9                  ((uint16_t)0x0200U)
+#define GPIO_PIN_8                  ((uint16_t)0x0100U)
+#define GPIO_PIN_10                 ((uint16_t)0x0400U)
+#define GPIO_PIN_11                 ((uint16_t)0x0800U)
+#define GPIO_PIN_12                 ((uint16_t)0x1000U)
+#define GPIO_PIN_15                 ((uint16_t)0x8000U)
+#define GPIO_MODE_INPUT             0x00000000U
+#define GPIO_MODE_OUTPUT_PP         0x00000001U
+#define GPIO_MODE_AF_PP             0x00000002U
+#define GPIO_NOPULL                 0x00000000U
+#define GPIO_PULLUP                 0x00000001U
+#define GPIO_SPEED_FREQ_LOW         0x00000000U
+#define GPIO_SPEED_FREQ_HIGH        0x00000002U
+#define GPIO_SPEED_FREQ_VERY_HIGH   0x00000003U
+#define GPIO_AF1_TIM1               ((uint8_t)0x01U)
+#define GPIO_AF6_SPI3               ((uint8_t)0x06U)
+#define GPIO_AF9_TIM14              ((uint8_t)0x09U)
+
+extern GPIO_TypeDef stub_gpioa;
+extern GPIO_TypeDef stub_gpiob;
+extern GPIO_TypeDef stub_gpioc;
+extern GPIO_TypeDef stub_gpioe;
+extern GPIO_TypeDef stub_gpiof;
+extern GPIO_TypeDef stub_gpiog;
+#define GPIOA                       (&stub_gpioa)
+#define GPIOB                       (&stub_gpiob)
+#define GPIOC                       (&stub_gpioc)
+#define GPIOE                       (&stub_gpioe)
+#define GPIOF                       (&stub_gpiof)
+#define GPIOG                       (&stub_gpiog)
+
+void HAL_GPIO_Init(GPIO_TypeDef *port, GPIO_InitTypeDef *init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *port, uint16_t pin);
+
+/* 定时器: 只保存控制(CEN), 状态(更新标志), 计数器, 自动重装值和比较寄存器, PWM函数总是成功 */
+typedef struct {
+    uint32_t CR1;
+    uint32_t SR;
+    uint32_t CNT;
+    uint32_t ARR;
+    uint32_t CCR[4];
+} TIM_TypeDef;
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+typedef struct {
+    uint32_t OCMode;
+    uint32_t Pulse;
+    uint32_t OCPolarity;
+    uint32_t OCNPolarity;
+    uint32_t OCFastMode;
+    uint32_t OCIdleState;
+    uint32_t OCNIdleState;
+} TIM_OC_InitTypeDef;
+
+#define TIM_CHANNEL_1               0x00000000U
+#define TIM_CHANNEL_3               0x00000008U
+#define TIM_COUNTERMODE_UP          0x00000000U
+#define TIM_CLOCKDIVISION_DIV1      0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE 0x00000000U
+#define TIM_OCMODE_PWM1             0x00000060U
+#define TIM_OCPOLARITY_HIGH         0x00000000U
+#define TIM_OCNPOLARITY_HIGH        0x00000000U
+#define TIM_OCFAST_DISABLE          0x00000000U
+#define TIM_OCIDLESTATE_RESET       0x00000000U
+#define TIM_OCNIDLESTATE_RESET      0x00000000U
+#define TIM_CR1_CEN                 0x00000001U
+#define TIM_FLAG_UPDATE             0x00000001U
+
+extern TIM_TypeDef stub_tim1;
+extern TIM_TypeDef stub_tim2;
+extern TIM_TypeDef stub_tim4;
+extern TIM_TypeDef stub_tim5;
+extern TIM_TypeDef stub_tim14;
+#define TIM1                        (&stub_tim1)
+#define TIM2                        (&stub_tim2)
+#define TIM4                        (&stub_tim4)
+#define TIM5                        (&stub_tim5)
+#define TIM14                       (&stub_tim14)
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *config, uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t channel);
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+
+#define __HAL_TIM_SET_COMPARE(h, ch, v)     ((h)->Instance->CCR[(ch) >> 2U] = (v))
+#define __HAL_TIM_GET_AUTORELOAD(h)         ((h)->Instance->ARR)
+#define __HAL_TIM_SET_AUTORELOAD(h, v)      do { (h)->Instance->ARR = (v); (h)->Init.Period = (v); } while (0)
+#define __HAL_TIM_GET_COUNTER(h)            ((h)->Instance->CNT)
+#define __HAL_TIM_SET_COUNTER(h, v)         ((h)->Instance->CNT = (v))
+#define __HAL_TIM_GET_FLAG(h, f)            ((((h)->Instance->SR & (f)) == (f)) ? SET : RESET)
+#define __HAL_TIM_CLEAR_FLAG(h, f)          ((h)->Instance->SR &= ~(uint32_t)(f))
+
+#define __HAL_RCC_GPIOA_CLK_ENABLE()        ((void)0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()        ((void)0)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()        ((void)0)
+#define __HAL_RCC_GPIOE_CLK_ENABLE()        ((void)0)
+#define __HAL_RCC_GPIOF_CLK_ENABLE()        ((void)0)
+#define __HAL_RCC_GPIOG_CLK_ENABLE()        ((void)0)
+#define __HAL_RCC_SPI3_CLK_ENABLE()         ((void)0)
+#define __HAL_RCC_DMA1_CLK_ENABLE()         ((void)0)
+#define __HAL_RCC_TIM1_CLK_ENABLE()         ((void)0)
+#define __HAL_RCC_TIM4_CLK_ENABLE()         ((void)0)
+#define __HAL_RCC_TIM5_CLK_ENABLE()         ((void)0)
+#define __HAL_RCC_TIM14_CLK_ENABLE()        ((void)0)
+
+/* NVIC: 记录各中断的使能/挂起状态与优先级, 使能时调用stub_nvic_enable_hook (测试在其中投递挂起的中断) */
+typedef enum {
+    EXTI0_IRQn = 6,
+    DMA1_Stream0_IRQn = 11,
+    DMA1_Stream5_IRQn = 16,
+    TIM4_IRQn = 30,
+    TIM5_IRQn = 50
+} IRQn_Type;
+
+extern uint64_t stub_nvic_enabled;
+extern uint64_t stub_nvic_pending;
+extern uint32_t stub_nvic_priority[64];
+extern void (*stub_nvic_enable_hook)(IRQn_Type irqn);
+
+void NVIC_EnableIRQ(IRQn_Type irqn);
+void NVIC_DisableIRQ(IRQn_Type irqn);
+void HAL_NVIC_SetPriority(IRQn_Type irqn, uint32_t preempt_priority, uint32_t sub_priority);
+void HAL_NVIC_EnableIRQ(IRQn_Type irqn);
+void HAL_NVIC_DisableIRQ(IRQn_Type irqn);
+void HAL_NVIC_SetPendingIRQ(IRQn_Type irqn);
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type irqn);
+
+/* BASEPRI: 非0时屏蔽优先级数值不小于它的中断, 写入后调用stub_basepri_hook
+ * (测试在其中投递被屏蔽期间挂起的中断) */
+#define __NVIC_PRIO_BITS            4U
+
+extern uint32_t stub_basepri;
+extern void (*stub_basepri_hook)(uint32_t basepri);
+
+uint32_t __get_BASEPRI(void);
+void __set_BASEPRI(uint32_t basepri);
+void __set_BASEPRI_MAX(uint32_t basepri);
+
+/* 毫秒计数与FreeRTOS桩的stub_tick相同, HAL_Delay使其前进 */
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t delay);
+
+#ifndef __DMB
+#define __DMB()     __sync_synchronize()
+#define __DSB()     __sync_synchronize()
+#define __ISB()     __sync_synchronize()
+#endif
+
+#endif /* __STM32F4xx_HAL_H */
@@ -0,0 +1,53 @@
+/**
+ ******************************************************************************
+ * @file    task.h
+ * @brief   主机测试用FreeRTOS任务接口桩
+ ******************************************************************************
+ */
+
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *pvParameters);
+
+#define taskENTER_CRITICAL()    do { } while (0)
+#define taskEXIT_CRITICAL()     do { } while (0)
+#define taskENTER_CRITICAL_FROM_ISR()       ((UBaseType_t)0)
+#define taskEXIT_CRITICAL_FROM_ISR(saved)   ((void)(saved))
+
+TickType_t xTaskGetTickCount(void);
+
+/* 任务创建只记录句柄, 不运行任务函数; 延时推进stub_tick */
+BaseType_t xTaskCreate(TaskFunction_t function, const char *name, uint16_t stack_depth,
+                       void *parameters, UBaseType_t priority, TaskHandle_t *handle);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t *previous_wake, TickType_t increment);
+
+/* 任务通知: 单一计数值, 下标通知值由stub_notify_value提供 */
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t wait);
+BaseType_t xTaskNotifyWaitIndexed(UBaseType_t index, uint32_t clear_on_entry, uint32_t clear_on_exit,
+                                  uint32_t *value, TickType_t wait);
+
+/* 下标任务通知: 由测试实现 (按任务记录通知值) */
+typedef enum {
+    eNoAction = 0,
+    eSetBits,
+    eIncrement,
+    eSetValueWithOverwrite,
+    eSetValueWithoutOverwrite
+} eNotifyAction;
+
+BaseType_t xTaskNotifyIndexed(TaskHandle_t task, UBaseType_t index, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyIndexedFromISR(TaskHandle_t task, UBaseType_t index, uint32_t value, eNotifyAction action,
+                                     BaseType_t *higher_priority_woken);
+
+/* 测试辅助 */
+extern uint32_t stub_notify_count;              // xTaskNotifyGive累计, ulTaskNotifyTake取走
+extern uint32_t stub_notify_value;              // xTaskNotifyWaitIndexed返回的通知值 (0=无通知)
+
+#endif /* INC_TASK_H */
@@ -0,0 +1,13 @@
+/**
+ ******************************************************************************
+ * @file    bsp_debug_usart.h
+ * @brief   主机测试用调试串口桩: printf直接输出到标准输出
+ ******************************************************************************
+ */
+
+#ifndef __BSP_DEBUG_USART_H__
+#define __BSP_DEBUG_USART_H__
+
+#include <stdio.h>
+
+#endif /* __BSP_DEBUG_USART_H__ */
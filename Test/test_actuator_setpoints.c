@@ -0,0 +1,420 @@
+/**
+ ******************************************************************************
+ * @file    test_actuator_setpoints.c
+ * @brief   控制->执行器设定值向量交接主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 直接包含actuator_task_v3.c, 以Actuator_RunCycle逐节拍运行执行器任务:
+ * - 应用规则: 未发布不应用, 只应用版本变化的执行器 (限幅, 携带样本标记),
+ *   序号不变不重读, 错过的中间版本取最新, 版本0的执行器保留命令队列的设定
+ * - 并发: 写线程连续发布, 主线程应用, 每次应用的值/标记/版本同属一次发布且不回退
+ *   (每次发布/应用后让出处理器, 单核主机上读写也交错进行)
+ * - 基准: 12回路20ms控制周期 + 每500ms一组操作命令, 对比逐回路经命令队列下发
+ *   和设定值向量: 队列操作数, 复制字节数, 控制输出延迟, 丢弃的控制输出/操作命令
+ ******************************************************************************
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+// 执行器任务的调试打印在主机测试中关闭
+static inline int Test_Quiet(const char *format, ...)
+{
+    (void)format;
+    return 0;
+}
+
+#define printf Test_Quiet
+#include "../Src/APP/actuator_task_v3.c"
+#undef printf
+
+#include "test_common.h"
+
+#define SIM_MS                  10000
+#define CONTROL_PERIOD_MS       20
+#define CONTROL_PHASE_MS        7       // 控制任务唤醒相位 (与执行器节拍不同步)
+#define OPERATOR_PERIOD_MS      500
+#define OPERATOR_PHASE_MS       9       // 操作命令在控制周期之后, 执行器节拍之前到达
+#define OPERATOR_BURST          8
+#define LOOP_COUNT              12
+#define PUBLISH_COUNT           200000UL
+
+// 控制回路默认执行器 (见Control_InitializeLoops): 温度->加热器, 压力/流量->调速泵, 液位->电磁阀
+static const actuator_type_t g_loop_actuator[LOOP_COUNT] = {
+    ACTUATOR_HEATER_1, ACTUATOR_HEATER_2, ACTUATOR_HEATER_3,
+    ACTUATOR_PUMP_SPEED_1, ACTUATOR_PUMP_SPEED_2, ACTUATOR_PUMP_SPEED_1, ACTUATOR_PUMP_SPEED_2,
+    ACTUATOR_VALVE_1, ACTUATOR_VALVE_2, ACTUATOR_VALVE_1, ACTUATOR_VALVE_2,
+    ACTUATOR_PUMP_SPEED_1,
+};
+
+// 过程映像由EtherCAT任务发布, 测试只需接收
+void ProcessImage_SetApplValue(pi_appl_value_t id, float value)
+{
+    (void)id;
+    (void)value;
+}
+
+/* ========================================================================== */
+/* 辅助 */
+/* ========================================================================== */
+
+// 恢复到ActuatorTaskV3_Init之后的状态 (首次调用时执行初始化)
+static void Reset(void)
+{
+    static bool initialized = false;
+    actuator_command_t command;
+    actuator_msg_t msg;
+
+    if (!initialized) {
+        TEST_CHECK(ActuatorTaskV3_Init() == pdPASS);
+        initialized = true;
+    }
+
+    while (xQueueReceive(xQueue_ActuatorCmd, &command, 0) == pdPASS) {
+    }
+    while (xQueueReceive(xQueue_ActuatorMsg, &msg, 0) == pdPASS) {
+    }
+
+    stub_tick = 0;
+    LatencyTrace_Init();
+    Actuator_InitializeConfigs();
+    memset(&g_actuator_context, 0, sizeof(actuator_context_t));
+    memset(&g_actuator_stats, 0, sizeof(actuator_task_stats_t));
+    for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+        LatencyTrace_ClearStamp(&g_output_trace[i]);
+    }
+    memset(g_setpoint_snapshots, 0, sizeof(g_setpoint_snapshots));
+    Seqlock_Init(&g_setpoint_seqlock, &g_setpoint_snapshots[0], &g_setpoint_snapshots[1],
+                 sizeof(actuator_setpoint_vector_t));
+    g_setpoint_sequence = 0;
+    memset(g_setpoint_applied, 0, sizeof(g_setpoint_applied));
+    g_actuator_context.system_ready = true;
+}
+
+// 执行器任务一个节拍 (状态消息队列由测试清空)
+static void ActuatorTick(void)
+{
+    actuator_msg_t msg;
+
+    Actuator_RunCycle();
+    while (xQueueReceive(xQueue_ActuatorMsg, &msg, 0) == pdPASS) {
+    }
+}
+
+// 同Control_SetActuatorOutput: 写入值和标记, 版本加1 (跳过0)
+static void WriteSetpoint(actuator_setpoint_vector_t *vector, actuator_type_t actuator, float value,
+                          uint8_t loop, uint32_t sequence)
+{
+    vector->value[actuator] = value;
+    vector->trace[actuator].loop = loop;
+    vector->trace[actuator].sequence = sequence;
+    vector->trace[actuator].acquire_time = Profiler_Now();
+    if (++vector->revision[actuator] == 0) {
+        vector->revision[actuator] = 1;
+    }
+}
+
+/* ========================================================================== */
+/* 应用规则 */
+/* ========================================================================== */
+
+static void Test_ApplyRules(void)
+{
+    actuator_setpoint_vector_t vector;
+    profiler_summary_t summary;
+
+    Reset();
+    memset(&vector, 0, sizeof(vector));
+
+    // 尚未发布: 不应用, 不计读取冲突
+    ActuatorTick();
+    TEST_CHECK(g_actuator_stats.setpoint_updates == 0);
+    TEST_CHECK(g_actuator_stats.setpoint_read_retries == 0);
+    TEST_CHECK(!ActuatorTaskV3_PublishSetpoints(NULL));
+
+    // 只应用有版本的执行器, 按配置限幅并携带样本标记; 命令队列设定的直流泵不受影响
+    TEST_CHECK(ActuatorTaskV3_SetOutput(ACTUATOR_PUMP_DC_1, 40.0f) == pdTRUE);
+    WriteSetpoint(&vector, ACTUATOR_VALVE_1, 30.0f, 7, 101);
+    WriteSetpoint(&vector, ACTUATOR_PUMP_SPEED_1, 150.0f, 3, 55);
+    TEST_CHECK(ActuatorTaskV3_PublishSetpoints(&vector) == pdTRUE);
+    stub_tick = 10;
+    ActuatorTick();
+    TEST_CHECK(g_actuator_configs[ACTUATOR_VALVE_1].target_output == 30.0f);
+    TEST_CHECK(g_actuator_configs[ACTUATOR_VALVE_1].last_update == 10);
+    TEST_CHECK(g_actuator_configs[ACTUATOR_PUMP_SPEED_1].target_output == 100.0f);
+    TEST_CHECK(g_actuator_configs[ACTUATOR_PUMP_DC_1].target_output == 40.0f);
+    TEST_CHECK(g_actuator_stats.setpoint_updates == 2);
+    TEST_CHECK(g_actuator_stats.command_count == 1);
+
+    // 序号不变不重读: 之后的手动命令保留到控制任务再次写入该执行器
+    TEST_CHECK(ActuatorTaskV3_SetOutput(ACTUATOR_VALVE_1, 55.0f) == pdTRUE);
+    ActuatorTick();
+    TEST_CHECK(g_actuator_configs[ACTUATOR_VALVE_1].target_output == 55.0f);
+    TEST_CHECK(g_actuator_stats.setpoint_updates == 2);
+
+    WriteSetpoint(&vector, ACTUATOR_PUMP_SPEED_1, 20.0f, 3, 56);
+    ActuatorTaskV3_PublishSetpoints(&vector);
+    ActuatorTick();
+    TEST_CHECK(g_actuator_configs[ACTUATOR_VALVE_1].target_output == 55.0f);
+    TEST_CHECK(g_actuator_configs[ACTUATOR_PUMP_SPEED_1].target_output == 20.0f);
+    TEST_CHECK(g_actuator_stats.setpoint_updates == 3);
+
+    // 一个节拍内多次发布: 只应用最新版本一次, 写入硬件时记录该样本的采样->输出延迟
+    for (uint32_t n = 0; n < 3; n++) {
+        WriteSetpoint(&vector, ACTUATOR_VALVE_1, 10.0f * (n + 1), 7, 102 + n);
+        ActuatorTaskV3_PublishSetpoints(&vector);
+    }
+    ActuatorTick();
+    TEST_CHECK(g_actuator_configs[ACTUATOR_VALVE_1].target_output == 30.0f);
+    TEST_CHECK(g_actuator_stats.setpoint_updates == 4);
+    TEST_CHECK(LatencyTrace_GetSummary(7, LATENCY_STAGE_OUTPUT, &summary));
+    TEST_CHECK(summary.count == 2);     // 样本101和104
+    TEST_CHECK(g_output_trace[ACTUATOR_VALVE_1].loop == LATENCY_TRACE_NO_LOOP);
+    TEST_CHECK(g_actuator_stats.setpoint_read_retries == 0);
+
+    // 版本回绕跳过0: 仍视为变化
+    vector.revision[ACTUATOR_HEATER_1] = UINT32_MAX;
+    ActuatorTaskV3_PublishSetpoints(&vector);
+    ActuatorTick();
+    WriteSetpoint(&vector, ACTUATOR_HEATER_1, 65.0f, 0, 9);
+    TEST_CHECK(vector.revision[ACTUATOR_HEATER_1] == 1);
+    ActuatorTaskV3_PublishSetpoints(&vector);
+    ActuatorTick();
+    TEST_CHECK(g_actuator_configs[ACTUATOR_HEATER_1].target_output == 65.0f);
+    TEST_CHECK(g_setpoint_applied[ACTUATOR_HEATER_1] == 1);
+}
+
+/* ========================================================================== */
+/* 并发 */
+/* ========================================================================== */
+
+static volatile bool g_writer_done;
+
+// 第k次发布: 所有执行器版本为k, 值为k%100, 标记序号为k
+static void *Writer(void *arg)
+{
+    actuator_setpoint_vector_t vector;
+
+    (void)arg;
+    memset(&vector, 0, sizeof(vector));
+    for (uint32_t k = 1; k <= PUBLISH_COUNT; k++) {
+        for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+            vector.value[i] = (float)(k % 100);
+            vector.trace[i].loop = i;
+            vector.trace[i].sequence = k;
+            vector.revision[i] = k;
+        }
+        ActuatorTaskV3_PublishSetpoints(&vector);
+        sched_yield();
+    }
+    __atomic_store_n(&g_writer_done, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void Test_Concurrent(void)
+{
+    pthread_t writer;
+    uint32_t applies = 0;
+    uint32_t torn = 0;
+    uint32_t regressed = 0;
+    uint32_t last = 0;
+    bool done;
+
+    Reset();
+    g_writer_done = false;
+    pthread_create(&writer, NULL, Writer, NULL);
+
+    do {
+        done = __atomic_load_n(&g_writer_done, __ATOMIC_ACQUIRE);
+        uint32_t updates = g_actuator_stats.setpoint_updates;
+
+        Actuator_ApplySetpoints();
+        sched_yield();
+        if (g_actuator_stats.setpoint_updates == updates) {
+            continue;
+        }
+        applies++;
+
+        uint32_t k = g_setpoint_applied[0];
+        for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+            if (g_setpoint_applied[i] != k ||
+                g_actuator_configs[i].target_output != (float)(k % 100) ||
+                g_output_trace[i].sequence != k) {
+                torn++;
+                break;
+            }
+        }
+        regressed += (k < last) ? 1 : 0;
+        last = k;
+    } while (!done);
+
+    pthread_join(writer, NULL);
+
+    printf("concurrent: %lu publishes, %lu applied, %lu read retries, %lu torn, %lu regressed\n",
+           PUBLISH_COUNT, (unsigned long)applies, (unsigned long)g_actuator_stats.setpoint_read_retries,
+           (unsigned long)torn, (unsigned long)regressed);
+    TEST_CHECK(applies > 0);
+    TEST_CHECK(torn == 0);
+    TEST_CHECK(regressed == 0);
+    TEST_CHECK(last == PUBLISH_COUNT);
+    TEST_CHECK(g_actuator_stats.setpoint_updates == applies * ACTUATOR_COUNT);
+}
+
+/* ========================================================================== */
+/* 基准: 命令队列 vs 设定值向量 */
+/* ========================================================================== */
+
+typedef struct {
+    uint32_t queue_ops;             // 入队 (含失败) + 出队
+    uint64_t bytes_copied;          // 命令入队/出队或向量发布/读取复制的字节数
+    uint32_t control_dropped;       // 队列满未送达的控制输出
+    uint32_t operator_sent;
+    uint32_t operator_dropped;      // 队列满被拒的操作命令
+    uint32_t latency_count;         // 控制输出从写入到执行器应用 (ms)
+    uint32_t latency_sum_ms;
+    uint32_t latency_max_ms;
+    uint32_t stale;                 // 节拍后执行器目标与控制最新输出不符的次数
+} handoff_result_t;
+
+static void RunHandoff(bool vector_path, handoff_result_t *result)
+{
+    actuator_setpoint_vector_t vector;
+    float expected[ACTUATOR_COUNT];
+    uint32_t written_ms[ACTUATOR_COUNT];
+    bool pending[ACTUATOR_COUNT] = {false};
+    bool driven[ACTUATOR_COUNT] = {false};
+    uint32_t cycle = 0;
+    uint32_t reads = 0;
+
+    Reset();
+    memset(result, 0, sizeof(handoff_result_t));
+    memset(&vector, 0, sizeof(vector));
+    stub_queue_bytes_copied = 0;
+
+    for (uint32_t t = 0; t < SIM_MS; t++) {
+        stub_tick = t;
+
+        // 控制周期: 12个回路各输出一次 (同一执行器以最后写入为准)
+        if ((t % CONTROL_PERIOD_MS) == CONTROL_PHASE_MS) {
+            cycle++;
+            for (uint8_t loop = 0; loop < LOOP_COUNT; loop++) {
+                actuator_type_t actuator = g_loop_actuator[loop];
+                float value = (float)((cycle * 7 + loop * 13) % 90 + 5);
+
+                if (vector_path) {
+                    WriteSetpoint(&vector, actuator, value, loop, cycle);
+                } else {
+                    latency_stamp_t trace = { loop, cycle, Profiler_Now() };
+
+                    result->queue_ops++;
+                    if (ActuatorTaskV3_SetOutputTraced(actuator, value, &trace) != pdTRUE) {
+                        result->control_dropped++;
+                        continue;
+                    }
+                }
+                expected[actuator] = value;
+                written_ms[actuator] = t;
+                pending[actuator] = true;
+                driven[actuator] = true;
+            }
+            if (vector_path) {
+                ActuatorTaskV3_PublishSetpoints(&vector);
+                result->bytes_copied += sizeof(vector);
+            }
+        }
+
+        // 操作命令: 直流泵开关和输出值, 与控制输出共用命令队列
+        if ((t % OPERATOR_PERIOD_MS) == OPERATOR_PHASE_MS) {
+            for (uint8_t n = 0; n < OPERATOR_BURST; n++) {
+                actuator_type_t pump = (n & 1) ? ACTUATOR_PUMP_DC_2 : ACTUATOR_PUMP_DC_1;
+                BaseType_t ok = (n & 2) ? ActuatorTaskV3_SetOutput(pump, 100.0f) : ActuatorTaskV3_Enable(pump);
+
+                result->queue_ops++;
+                result->operator_sent++;
+                result->operator_dropped += (ok == pdTRUE) ? 0 : 1;
+            }
+        }
+
+        // 执行器节拍
+        if ((t % ACTUATOR_TASK_PERIOD_MS) == 0) {
+            uint32_t received = uxQueueMessagesWaiting(xQueue_ActuatorCmd);
+
+            result->queue_ops += received;
+            ActuatorTick();
+            reads++;
+
+            for (uint8_t i = 0; i < ACTUATOR_COUNT; i++) {
+                if (!driven[i]) {
+                    continue;
+                }
+                if (g_actuator_configs[i].target_output != expected[i]) {
+                    result->stale++;
+                    continue;
+                }
+                if (pending[i]) {
+                    uint32_t latency = t - written_ms[i];
+
+                    pending[i] = false;
+                    result->latency_sum_ms += latency;
+                    result->latency_count++;
+                    if (latency > result->latency_max_ms) result->latency_max_ms = latency;
+                }
+            }
+        }
+    }
+
+    // 命令队列桩统计所有入队/出队复制; 向量每节拍读取一次
+    result->bytes_copied += vector_path ? (uint64_t)reads * sizeof(vector) : 0;
+    result->bytes_copied += stub_queue_bytes_copied;
+}
+
+static void PrintHandoff(const char *name, const handoff_result_t *r)
+{
+    printf("%s: %lu queue ops, %llu bytes copied, control dropped %lu, operator dropped %lu/%lu, "
+           "latency mean %.2f max %lu ms, stale %lu\n", name,
+           (unsigned long)r->queue_ops, (unsigned long long)r->bytes_copied,
+           (unsigned long)r->control_dropped, (unsigned long)r->operator_dropped,
+           (unsigned long)r->operator_sent, (double)r->latency_sum_ms / r->latency_count,
+           (unsigned long)r->latency_max_ms, (unsigned long)r->stale);
+}
+
+static void Test_HandoffBenchmark(void)
+{
+    handoff_result_t queue;
+    handoff_result_t vector;
+    uint32_t cycles = SIM_MS / CONTROL_PERIOD_MS;
+
+    RunHandoff(false, &queue);
+    RunHandoff(true, &vector);
+    PrintHandoff("command queue", &queue);
+    PrintHandoff("setpoint vector", &vector);
+
+    // 逐回路下发: 每周期12次入队+12次出队; 操作命令与控制输出挤在同一节拍时队列溢出
+    TEST_CHECK(queue.queue_ops >= cycles * LOOP_COUNT * 2);
+    TEST_CHECK(queue.operator_dropped > 0);
+
+    // 设定值向量: 队列只承载操作命令, 不丢命令, 每个控制输出都在下一个节拍应用
+    TEST_CHECK(vector.queue_ops == 2 * vector.operator_sent);
+    TEST_CHECK(vector.control_dropped == 0);
+    TEST_CHECK(vector.operator_dropped == 0);
+    TEST_CHECK(vector.stale == 0);
+    TEST_CHECK(vector.latency_max_ms < ACTUATOR_TASK_PERIOD_MS);
+    TEST_CHECK(vector.latency_count == cycles * 7);    // 7个执行器由控制回路驱动
+    TEST_CHECK(vector.bytes_copied < queue.bytes_copied);
+}
+
+int main(void)
+{
+    Test_ApplyRules();
+    Test_Concurrent();
+    Test_HandoffBenchmark();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,557 @@
+/**
+ ******************************************************************************
+ * @file    test_bsp_ads8688.c
+ * @brief   ADS8688 BSP主机测试 (模拟SPI/DMA后端)
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 器件模型: SDO格式3, 每帧在CS下降沿转换上一帧命令所选的通道
+ *   (AUTO_RST/CONT自动序列, MAN_n手动), 转换码为递增序号, 记录每个
+ *   转换的通道和时刻; 程序寄存器读写
+ * - 时间以ns推进: 每帧48位@1.3125MHz, DMA完成, TIM5节拍和中断采样请求
+ *   在ADS8688_ACQ_IRQ_PRIORITY下按时间顺序投递, BASEPRI屏蔽期间挂起;
+ *   阻塞传输期间到期的中断抢占任务
+ * - 检查帧内通道顺序, 帧序号/时间戳, 采样间隔与帧率/中断采样率,
+ *   AUTO_RST交还自动序列, 以及任务阻塞扫描与中断采样互斥: 总线冲突
+ *   (两次传输重叠)必须为0, 被占用时任务扫描返回HAL_BUSY
+ ******************************************************************************
+ */
+
+#include "ads8688/bsp_ads8688.h"
+#include "test_common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FRAME_NS            36571ULL    // 48位 @ 42MHz/32
+#define NO_EVENT            UINT64_MAX
+#define IRQ_MASK_LEVEL      (ADS8688_ACQ_IRQ_PRIORITY << (8U - __NVIC_PRIO_BITS))
+#define CONV_LOG_SIZE       65536
+
+/* 器件模型 */
+typedef struct {
+    uint8_t regs[0x40];
+    uint8_t next_channel;
+    uint8_t auto_mode;
+    uint16_t conversions;
+} adc_model_t;
+
+static adc_model_t g_adc;
+static uint64_t g_conv_time_ns[CONV_LOG_SIZE];
+static uint8_t g_conv_channel[CONV_LOG_SIZE];
+
+/* 时间与总线 */
+static uint64_t g_now_ns;
+static uint64_t g_dma_done_ns = NO_EVENT;
+static uint64_t g_tim_next_ns = NO_EVENT;
+static uint8_t *g_dma_rx;
+static const uint8_t *g_dma_tx;
+static uint8_t g_blocking_active;
+static uint8_t g_in_isr;
+static uint32_t g_collisions;
+static uint32_t g_cs_errors;
+static uint32_t g_blocking_frames;
+static uint32_t g_dma_frames;
+
+/* 中断采样请求 (模拟过采样定时器) */
+static uint64_t g_req_next_ns = NO_EVENT;
+static uint64_t g_req_spacing_ns;
+static uint8_t g_req_channels[ADS8688_ISR_MAX_CHANNELS];
+static uint8_t g_req_count;
+static uint32_t g_req_started;
+static uint32_t g_req_busy;
+static uint32_t g_req_done;
+static uint32_t g_req_errors;
+static uint32_t g_req_order_errors;
+static uint64_t g_req_first_ch0_ns;
+static uint64_t g_req_last_ch0_ns;
+static uint8_t g_req_inject_on_mask;
+static uint8_t g_req_injected_masked;
+
+/* ========================================================================== */
+/* ADS8688器件模型 */
+/* ========================================================================== */
+
+static void AdcReset(void)
+{
+    memset(&g_adc, 0, sizeof(g_adc));
+    g_adc.auto_mode = 1;
+}
+
+static uint8_t AdcNextAutoChannel(uint8_t channel)
+{
+    for (uint8_t i = 1; i <= 8; i++) {
+        uint8_t next = (channel + i) % 8;
+
+        if (g_adc.regs[AUTO_SEQ_EN] & (1U << next)) {
+            return next;
+        }
+    }
+    return channel;
+}
+
+static void AdcFrame(const uint8_t *tx, uint8_t *rx)
+{
+    uint8_t cmd = tx[0];
+    uint8_t channel;
+    uint16_t code;
+
+    if ((ADS8688_SPI_CS_PORT->ODR & ADS8688_SPI_CS_PIN) != 0) {
+        g_cs_errors++;
+    }
+
+    memset(rx, 0, ADS_FRAME_BYTES);
+
+    // 程序寄存器访问: [地址6:0 | 读写][数据], 结果在下一个16位
+    if (cmd != CONT && (cmd & 0x80) == 0) {
+        uint8_t addr = cmd >> 1;
+
+        if (cmd & 0x01) {
+            g_adc.regs[addr] = tx[1];
+        }
+        rx[2] = g_adc.regs[addr];
+        return;
+    }
+
+    if (cmd == RST) {
+        AdcReset();
+        return;
+    }
+
+    // CS下降沿转换上一帧所选的通道
+    channel = g_adc.next_channel;
+    code = g_adc.conversions++;
+    g_conv_time_ns[code] = g_now_ns;
+    g_conv_channel[code] = channel;
+    rx[2] = (uint8_t)(code >> 8);
+    rx[3] = (uint8_t)code;
+    rx[4] = (uint8_t)((channel << 4) | (g_adc.regs[CHN_0_RANGE + channel] & 0x0F));
+
+    if (cmd == AUTO_RST) {
+        g_adc.auto_mode = 1;
+        g_adc.next_channel = (g_adc.regs[AUTO_SEQ_EN] & 0x01) ? 0 : AdcNextAutoChannel(0);
+    } else if (cmd >= MAN_0 && cmd <= MAN_7 && ((cmd - MAN_0) & 0x03) == 0) {
+        g_adc.auto_mode = 0;
+        g_adc.next_channel = (cmd - MAN_0) >> 2;
+    } else if (cmd == CONT && g_adc.auto_mode) {
+        g_adc.next_channel = AdcNextAutoChannel(channel);
+    }
+}
+
+/* ========================================================================== */
+/* 中断与时间 */
+/* ========================================================================== */
+
+static uint8_t IrqMasked(void)
+{
+    return (stub_basepri != 0) && (stub_basepri <= IRQ_MASK_LEVEL);
+}
+
+static void RequestIsr(void)
+{
+    HAL_StatusTypeDef ret = BSP_ADS8688_StartChannelsIsr(g_req_channels, g_req_count, NULL);
+
+    (void)ret;
+}
+
+static void RequestDone(HAL_StatusTypeDef status, const uint16_t *data)
+{
+    if (status != HAL_OK) {
+        g_req_errors++;
+        return;
+    }
+
+    g_req_done++;
+    for (uint8_t i = 0; i < g_req_count; i++) {
+        if (g_conv_channel[data[i]] != g_req_channels[i]) {
+            g_req_order_errors++;
+        }
+    }
+    if (g_req_first_ch0_ns == NO_EVENT) {
+        g_req_first_ch0_ns = g_conv_time_ns[data[0]];
+    }
+    g_req_last_ch0_ns = g_conv_time_ns[data[0]];
+}
+
+static void StartRequest(void)
+{
+    HAL_StatusTypeDef ret = BSP_ADS8688_StartChannelsIsr(g_req_channels, g_req_count, RequestDone);
+
+    if (ret == HAL_OK) {
+        g_req_started++;
+    } else if (ret == HAL_BUSY) {
+        g_req_busy++;
+    } else {
+        g_req_errors++;
+    }
+}
+
+// 按时间顺序投递到期的同优先级中断 (互不嵌套, 被BASEPRI屏蔽时挂起)
+static void DeliverIrqs(void)
+{
+    while (!g_in_isr && !IrqMasked()) {
+        uint64_t next = g_dma_done_ns;
+
+        if (g_tim_next_ns < next) {
+            next = g_tim_next_ns;
+        }
+        if (g_req_next_ns < next) {
+            next = g_req_next_ns;
+        }
+        if (next > g_now_ns) {
+            return;
+        }
+
+        g_in_isr = 1;
+        if (next == g_dma_done_ns) {
+            g_dma_done_ns = NO_EVENT;
+            HAL_SPI_TxRxCpltCallback(&hads8688_spi);
+        } else if (next == g_tim_next_ns) {
+            g_tim_next_ns += (uint64_t)(TIM5->ARR + 1) * 1000ULL;
+            TIM5->SR |= TIM_FLAG_UPDATE;
+            TIM5->CNT = 0;
+            BSP_ADS8688_AcqTimerIsr();
+        } else {
+            g_req_next_ns += g_req_spacing_ns;
+            StartRequest();
+        }
+        g_in_isr = 0;
+    }
+}
+
+// 时间前进到until_ns, 途中到期的中断按各自时刻投递
+static void AdvanceTo(uint64_t until_ns)
+{
+    for (;;) {
+        uint64_t next = g_dma_done_ns;
+
+        if (TIM5->CR1 & TIM_CR1_CEN) {
+            if (g_tim_next_ns == NO_EVENT) {
+                g_tim_next_ns = g_now_ns + (uint64_t)(TIM5->ARR + 1) * 1000ULL;
+            }
+        } else {
+            g_tim_next_ns = NO_EVENT;
+        }
+        if (g_tim_next_ns < next) {
+            next = g_tim_next_ns;
+        }
+        if (g_req_next_ns < next) {
+            next = g_req_next_ns;
+        }
+        if (next > until_ns || g_in_isr || IrqMasked()) {
+            break;
+        }
+        if (next > g_now_ns) {
+            g_now_ns = next;
+        }
+        DeliverIrqs();
+    }
+    if (until_ns > g_now_ns) {
+        g_now_ns = until_ns;
+    }
+}
+
+static void BasepriHook(uint32_t basepri)
+{
+    // 检查并置位期间到达的中断采样请求: 屏蔽期间只能挂起
+    if (basepri != 0 && g_req_inject_on_mask) {
+        g_req_inject_on_mask = 0;
+        g_req_next_ns = g_now_ns;
+        DeliverIrqs();
+        g_req_injected_masked = (g_req_started == 0 && g_req_busy == 0);
+    }
+    if (basepri == 0) {
+        DeliverIrqs();
+    }
+}
+
+/* ========================================================================== */
+/* HAL SPI后端 */
+/* ========================================================================== */
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size, uint32_t timeout)
+{
+    (void)hspi;
+    (void)timeout;
+
+    if (g_dma_done_ns != NO_EVENT || g_blocking_active || size != ADS_FRAME_BYTES) {
+        g_collisions++;
+        return HAL_BUSY;
+    }
+
+    // 任务上下文: 传输期间到期的中断抢占任务
+    g_blocking_active = 1;
+    g_blocking_frames++;
+    AdcFrame(tx, rx);
+    AdvanceTo(g_now_ns + FRAME_NS);
+    g_blocking_active = 0;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+    (void)hspi;
+
+    if (g_dma_done_ns != NO_EVENT || g_blocking_active || size != ADS_FRAME_BYTES) {
+        g_collisions++;
+        return HAL_BUSY;
+    }
+
+    g_dma_tx = tx;
+    g_dma_rx = rx;
+    g_dma_frames++;
+    AdcFrame(g_dma_tx, g_dma_rx);
+    g_dma_done_ns = g_now_ns + FRAME_NS;
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi)
+{
+    (void)hspi;
+    g_dma_done_ns = NO_EVENT;
+    return HAL_OK;
+}
+
+/* ========================================================================== */
+/* 测试 */
+/* ========================================================================== */
+
+static void ResetCounters(void)
+{
+    g_collisions = 0;
+    g_cs_errors = 0;
+    g_blocking_frames = 0;
+    g_dma_frames = 0;
+    g_req_started = 0;
+    g_req_busy = 0;
+    g_req_done = 0;
+    g_req_errors = 0;
+    g_req_order_errors = 0;
+    g_req_first_ch0_ns = NO_EVENT;
+    g_req_last_ch0_ns = 0;
+}
+
+static void SetRequests(const uint8_t *channels, uint8_t count, uint64_t spacing_ns)
+{
+    memcpy(g_req_channels, channels, count);
+    g_req_count = count;
+    g_req_spacing_ns = spacing_ns;
+    g_req_next_ns = (spacing_ns != 0) ? g_now_ns + spacing_ns : NO_EVENT;
+}
+
+static void CheckScan(const uint16_t *data)
+{
+    for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+        TEST_CHECK(g_conv_channel[data[ch]] == ch);
+        if (ch > 0) {
+            TEST_CHECK(g_conv_time_ns[data[ch]] > g_conv_time_ns[data[ch - 1]]);
+        }
+    }
+}
+
+static void Test_Init(void)
+{
+    AdcReset();
+    stub_basepri_hook = BasepriHook;
+    BSP_ADS8688_Init();
+
+    TEST_CHECK(g_adc.regs[AUTO_SEQ_EN] == 0xFF);
+    TEST_CHECK(g_adc.regs[FEATURE_SELECT] == 0x03);
+    TEST_CHECK(g_adc.regs[CHN_0_RANGE] == 0x06 && g_adc.regs[CHN_2_RANGE] == 0x05);
+    TEST_CHECK(g_adc.regs[CHN_5_RANGE] == 0x05 && g_adc.regs[CHN_7_RANGE] == 0x06);
+
+    // 节拍定时器与SPI DMA同一抢占优先级
+    TEST_CHECK(stub_nvic_priority[DMA1_Stream0_IRQn] == ADS8688_ACQ_IRQ_PRIORITY);
+    TEST_CHECK(stub_nvic_priority[DMA1_Stream5_IRQn] == ADS8688_ACQ_IRQ_PRIORITY);
+    TEST_CHECK(stub_nvic_priority[TIM5_IRQn] == ADS8688_ACQ_IRQ_PRIORITY);
+    TEST_CHECK(g_collisions == 0 && g_cs_errors == 0);
+}
+
+static void Test_BlockingScan(void)
+{
+    uint16_t data[ADS8688_ACQ_CHANNELS];
+    uint64_t start;
+
+    ResetCounters();
+    start = g_now_ns;
+    TEST_CHECK(BSP_ADS8688_ReadAllChannels(data) == HAL_OK);
+    CheckScan(data);
+    TEST_CHECK(g_blocking_frames == ADS8688_ACQ_CHANNELS + 1);
+    TEST_CHECK(g_now_ns - start == (ADS8688_ACQ_CHANNELS + 1) * FRAME_NS);
+    TEST_CHECK(stub_basepri == 0);
+}
+
+static void Test_Acquisition(uint32_t period_us)
+{
+    ads8688_frame_t frames[ADS8688_ACQ_RING_SIZE - 1];
+    ads8688_acq_stats_t stats;
+    uint16_t data[ADS8688_ACQ_CHANNELS];
+    uint32_t blocking_frames;
+    uint8_t count;
+    double mean_ns;
+
+    ResetCounters();
+    TEST_CHECK(BSP_ADS8688_StartAcquisition(ADS8688_ACQ_PERIOD_US_MIN - 1) == HAL_ERROR);
+    TEST_CHECK(BSP_ADS8688_StartAcquisition(period_us) == HAL_OK);
+    TEST_CHECK(BSP_ADS8688_StartAcquisition(period_us) == HAL_BUSY);
+
+    // 停在两帧之间 (最后一帧已完成)
+    AdvanceTo(g_now_ns + 1000000000ULL + 900ULL * period_us);
+
+    BSP_ADS8688_GetAcqStats(&stats);
+    TEST_CHECK(stats.ticks == 1000000UL / period_us);
+    TEST_CHECK(stats.frames == stats.ticks);
+    TEST_CHECK(stats.overruns == 0 && stats.bus_busy == 0);
+    TEST_CHECK(stats.order_errors == 0 && stats.spi_errors == 0);
+    TEST_CHECK(g_dma_frames == stats.frames * (ADS8688_ACQ_CHANNELS + 1));
+
+    // 最近15帧: 序号连续, 时间戳间隔为周期, 通道0的采样间隔为周期
+    count = BSP_ADS8688_GetFrames(frames, ADS8688_ACQ_RING_SIZE - 1);
+    TEST_CHECK(count == ADS8688_ACQ_RING_SIZE - 1);
+    for (uint8_t i = 0; i < count; i++) {
+        CheckScan(frames[i].raw);
+        if (i > 0) {
+            TEST_CHECK(frames[i].seq == frames[i - 1].seq + 1);
+            TEST_CHECK(frames[i].timestamp_us - frames[i - 1].timestamp_us == period_us);
+            TEST_CHECK(g_conv_time_ns[frames[i].raw[0]] - g_conv_time_ns[frames[i - 1].raw[0]]
+                       == 1000ULL * period_us);
+        }
+    }
+    TEST_CHECK(frames[count - 1].seq == stats.frames);
+    mean_ns = (double)(g_conv_time_ns[frames[count - 1].raw[0]] - g_conv_time_ns[frames[0].raw[0]]) / (count - 1);
+    printf("acquisition %lu us: %lu frames in 1 s, frame rate %.3f Hz (nominal %.3f Hz)\n",
+           (unsigned long)period_us, (unsigned long)stats.frames, 1e9 / mean_ns, 1e6 / period_us);
+    TEST_CHECK_NEAR(1e9 / mean_ns, 1e6 / period_us, 1e-6);
+
+    // 采集运行时任务读取不占用总线
+    blocking_frames = g_blocking_frames;
+    TEST_CHECK(BSP_ADS8688_ReadAllChannels(data) == HAL_OK);
+    TEST_CHECK(memcmp(data, frames[count - 1].raw, sizeof(data)) == 0);
+    TEST_CHECK(g_blocking_frames == blocking_frames);
+
+    BSP_ADS8688_StopAcquisition();
+    AdvanceTo(g_now_ns + 2000000ULL);
+    TEST_CHECK(!BSP_ADS8688_IsAcquiring());
+    TEST_CHECK(g_dma_done_ns == NO_EVENT);
+    TEST_CHECK(g_collisions == 0 && g_cs_errors == 0);
+}
+
+static void Test_IsrChannels(void)
+{
+    const uint8_t channels[] = { 5, 2, 7 };
+    const uint8_t pair[] = { 0, 1 };
+    uint16_t data[ADS8688_ACQ_CHANNELS];
+    double spacing_ns;
+
+    // 单次: 手动序列按请求顺序返回, 之后的阻塞扫描仍从通道0开始
+    ResetCounters();
+    SetRequests(channels, sizeof(channels), 0);
+    StartRequest();
+    TEST_CHECK(g_req_started == 1);
+    AdvanceTo(g_now_ns + 10 * FRAME_NS);
+    TEST_CHECK(g_req_done == 1 && g_req_errors == 0 && g_req_order_errors == 0);
+    TEST_CHECK(g_dma_frames == sizeof(channels) + 1);
+    TEST_CHECK(BSP_ADS8688_ReadAllChannels(data) == HAL_OK);
+    CheckScan(data);
+
+    TEST_CHECK(BSP_ADS8688_StartChannelsIsr(channels, 0, RequestDone) == HAL_ERROR);
+    TEST_CHECK(BSP_ADS8688_StartChannelsIsr(channels, ADS8688_ISR_MAX_CHANNELS + 1, RequestDone) == HAL_ERROR);
+    TEST_CHECK(BSP_ADS8688_StartChannelsIsr(channels, 1, NULL) == HAL_ERROR);
+
+    // 过采样: 每125us采样通道0,1 (3帧约110us), 100ms
+    ResetCounters();
+    SetRequests(pair, sizeof(pair), 125000ULL);
+    AdvanceTo(g_now_ns + 100000000ULL);
+    SetRequests(pair, sizeof(pair), 0);
+    AdvanceTo(g_now_ns + 1000000ULL);
+
+    spacing_ns = (double)(g_req_last_ch0_ns - g_req_first_ch0_ns) / (g_req_done - 1);
+    printf("isr sampling 125 us: %lu reads, %lu busy, sample spacing %.3f us\n",
+           (unsigned long)g_req_done, (unsigned long)g_req_busy, spacing_ns / 1000.0);
+    TEST_CHECK(g_req_done == 800 && g_req_busy == 0);
+    TEST_CHECK(g_req_errors == 0 && g_req_order_errors == 0);
+    TEST_CHECK_NEAR(spacing_ns, 125000.0, 1e-6);
+    TEST_CHECK(g_collisions == 0 && g_cs_errors == 0);
+}
+
+static void Test_BusContention(void)
+{
+    const uint8_t channels[] = { 3, 4, 6, 1 };
+    const uint8_t pair[] = { 2, 3 };
+    uint16_t data[ADS8688_ACQ_CHANNELS];
+    uint32_t scans_ok = 0;
+    uint32_t scans_busy = 0;
+
+    // 中断采样进行中 (DMA未完成): 任务扫描返回HAL_BUSY, 不发起传输
+    ResetCounters();
+    SetRequests(channels, sizeof(channels), 0);
+    StartRequest();
+    AdvanceTo(g_now_ns + FRAME_NS / 2);
+    TEST_CHECK(BSP_ADS8688_ReadAllChannels(data) == HAL_BUSY);
+    TEST_CHECK(g_blocking_frames == 0);
+    TEST_CHECK(stub_basepri == 0);
+    AdvanceTo(g_now_ns + 10 * FRAME_NS);
+    TEST_CHECK(g_req_done == 1 && g_req_order_errors == 0);
+    TEST_CHECK(BSP_ADS8688_ReadAllChannels(data) == HAL_OK);
+    CheckScan(data);
+
+    // 请求恰在检查并置位时到达: 屏蔽期间挂起, 恢复BASEPRI后投递并返回HAL_BUSY,
+    // 任务扫描完成后请求恢复
+    ResetCounters();
+    SetRequests(channels, sizeof(channels), 0);
+    g_req_spacing_ns = 1000000ULL;
+    g_req_inject_on_mask = 1;
+    TEST_CHECK(BSP_ADS8688_ReadAllChannels(data) == HAL_OK);
+    CheckScan(data);
+    TEST_CHECK(g_req_injected_masked);
+    TEST_CHECK(g_req_busy == 1 && g_req_started == 0);
+    TEST_CHECK(g_blocking_frames == ADS8688_ACQ_CHANNELS + 1);
+    AdvanceTo(g_now_ns + 2000000ULL);
+    TEST_CHECK(g_req_started >= 1 && g_req_done == g_req_started && g_req_order_errors == 0);
+    SetRequests(channels, sizeof(channels), 0);
+    AdvanceTo(g_now_ns + 1000000ULL);
+
+    // 任务每1.1ms阻塞扫描, 中断每125us采样, 随机相位1000次
+    ResetCounters();
+    srand(11);
+    SetRequests(pair, sizeof(pair), 125000ULL);
+    for (uint32_t i = 0; i < 1000; i++) {
+        HAL_StatusTypeDef ret;
+
+        AdvanceTo(g_now_ns + 1000000ULL + (uint64_t)(rand() % 200000));
+        ret = BSP_ADS8688_ReadAllChannels(data);
+        if (ret == HAL_OK) {
+            scans_ok++;
+            CheckScan(data);
+        } else {
+            TEST_CHECK(ret == HAL_BUSY);
+            scans_busy++;
+        }
+    }
+    SetRequests(pair, sizeof(pair), 0);
+    AdvanceTo(g_now_ns + 1000000ULL);
+
+    printf("contention: %lu task scans ok, %lu busy; %lu isr reads, %lu busy; %lu bus collisions\n",
+           (unsigned long)scans_ok, (unsigned long)scans_busy, (unsigned long)g_req_done,
+           (unsigned long)g_req_busy, (unsigned long)g_collisions);
+    TEST_CHECK(g_collisions == 0 && g_cs_errors == 0);
+    TEST_CHECK(scans_ok > 0 && scans_busy > 0 && g_req_busy > 0);
+    TEST_CHECK(g_req_done == g_req_started && g_req_errors == 0 && g_req_order_errors == 0);
+    TEST_CHECK(stub_basepri == 0);
+}
+
+int main(void)
+{
+    Test_Init();
+    Test_BlockingScan();
+    Test_Acquisition(ADS8688_ACQ_PERIOD_US_DEFAULT);
+    Test_Acquisition(ADS8688_ACQ_PERIOD_US_MIN);
+    Test_IsrChannels();
+    Test_BusContention();
+
+    return TEST_RESULT();
+}
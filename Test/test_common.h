@@ -0,0 +1,49 @@
+/**
+ ******************************************************************************
+ * @file    test_common.h
+ * @brief   主机单元测试公共宏
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 每个test_*.c编译为独立的可执行文件, 失败的检查打印位置后继续,
+ * main以TEST_RESULT()返回非0表示失败.
+ ******************************************************************************
+ */
+
+#ifndef __TEST_COMMON_H
+#define __TEST_COMMON_H
+
+#include <stdio.h>
+#include <math.h>
+
+static int test_checks = 0;
+static int test_failures = 0;
+
+#define TEST_CHECK(cond)                                                        \
+    do {                                                                        \
+        test_checks++;                                                          \
+        if (!(cond)) {                                                          \
+            test_failures++;                                                    \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);              \
+        }                                                                       \
+    } while (0)
+
+#define TEST_CHECK_NEAR(a, b, tol)                                              \
+    do {                                                                        \
+        double test_a_ = (double)(a), test_b_ = (double)(b);                    \
+        test_checks++;                                                          \
+        if (!(fabs(test_a_ - test_b_) <= (double)(tol))) {                      \
+            test_failures++;                                                    \
+            printf("FAIL %s:%d: %s = %g, %s = %g (tol %g)\n", __FILE__,         \
+                   __LINE__, #a, test_a_, #b, test_b_, (double)(tol));          \
+        }                                                                       \
+    } while (0)
+
+#define TEST_RESULT()                                                           \
+    (printf("%d checks, %d failed\n", test_checks, test_failures),              \
+     test_failures != 0)
+
+#endif /* __TEST_COMMON_H */
@@ -0,0 +1,360 @@
+/**
+ ******************************************************************************
+ * @file    test_control_cascade.c
+ * @brief   串级/前馈控制主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 通过control_harness.h逐周期运行控制任务:
+ * - 串级: 外环按频率比分频, 外环输出按内环设定值范围限幅, 接入无扰,
+ *   外环不直接驱动执行器, 非法配置被拒绝, 取消后恢复单回路
+ * - 前馈: 超前滞后环节与双精度参考逐拍一致, 静态前馈, 扰动测量无效时为0
+ * - 闭环对比 (打印IAE): 泵->流量->压力过程的供液扰动, 单回路压力PI与
+ *   压力/流量串级; 出口流量扰动, 无前馈/静态前馈/超前滞后前馈
+ ******************************************************************************
+ */
+
+#include "control_harness.h"
+#include "test_common.h"
+#include <math.h>
+
+#define CYCLE_S             (CONTROL_TASK_PERIOD_MS / 1000.0)
+#define PLANT_SUBSTEPS      20
+#define PUMP_RATE_RATIO     5
+
+/* ========================================================================== */
+/* 过程模型 */
+/* ========================================================================== */
+
+// 泵->流量->压力: tau_f·F' = -F + 0.1·u - d, tau_p·P' = -P + 20·F (d为供液损失, L/min)
+typedef struct {
+    double flow;
+    double pressure;
+    double supply_loss;
+} pump_plant_t;
+
+static void PumpPlant_Step(pump_plant_t *plant, double u)
+{
+    const double h = CYCLE_S / PLANT_SUBSTEPS;
+
+    for (int k = 0; k < PLANT_SUBSTEPS; k++) {
+        plant->flow += h * (-plant->flow + 0.1 * u - plant->supply_loss) / 0.3;
+        plant->pressure += h * (-plant->pressure + 20.0 * plant->flow) / 3.0;
+    }
+}
+
+// 执行机构滞后 + 压力: tau_a·A' = -A + u, tau_p·P' = -P + 2.5·A - 25·w (w为出口流量, 可测)
+typedef struct {
+    double actuator;
+    double pressure;
+    double draw;
+} draw_plant_t;
+
+static void DrawPlant_Step(draw_plant_t *plant, double u)
+{
+    const double h = CYCLE_S / PLANT_SUBSTEPS;
+
+    for (int k = 0; k < PLANT_SUBSTEPS; k++) {
+        plant->actuator += h * (-plant->actuator + u) / 1.0;
+        plant->pressure += h * (-plant->pressure + 2.5 * plant->actuator - 25.0 * plant->draw) / 3.0;
+    }
+}
+
+/* ========================================================================== */
+/* 辅助函数 */
+/* ========================================================================== */
+
+static void Cycle(void)
+{
+    Control_RunCycle();
+    stub_tick += CONTROL_TASK_PERIOD_MS;
+}
+
+// 压力1外环 -> 流量内环 (泵1), 过程在P=100kPa, F=5L/min, u=50%稳态
+static void SetupPumpCascade(uint8_t rate_ratio)
+{
+    Harness_ConfigureLoop(CONTROL_LOOP_FLOW, CONTROL_MODE_AUTO, 5.0f, 10.0f, 33.3f, 0.0f, 100.0f);
+    Harness_ConfigureLoop(CONTROL_LOOP_PRESSURE_1, CONTROL_MODE_CASCADE, 100.0f, 0.15f, 0.05f, 0.0f, 100.0f);
+    ControlTaskV3_SetCascade(CONTROL_LOOP_PRESSURE_1, CONTROL_LOOP_FLOW, rate_ratio);
+    Control_ProcessCommands();
+    Control_PresetIntegral(CONTROL_LOOP_FLOW, 50.0f);
+}
+
+/* ========================================================================== */
+/* 串级 */
+/* ========================================================================== */
+
+static void Test_CascadeScheduling(void)
+{
+    control_loop_config_t *outer = &g_control_context.loops[CONTROL_LOOP_PRESSURE_1];
+    control_loop_config_t *inner = &g_control_context.loops[CONTROL_LOOP_FLOW];
+    uint32_t outer_runs;
+    uint32_t inner_runs;
+    uint32_t setpoint_changes = 0;
+    bool in_range = true;
+    float last_setpoint;
+
+    TEST_CHECK(Harness_Reset() == pdPASS);
+    SetupPumpCascade(4);
+    TEST_CHECK(g_control_stats.command_errors == 0);
+
+    // 外环输出即内环设定值: 限幅取内环设定值范围, 采样时间随分频加长
+    TEST_CHECK(outer->pid_params.output_min == inner->setpoint_min);
+    TEST_CHECK(outer->pid_params.output_max == inner->setpoint_max);
+    TEST_CHECK_NEAR(outer->pid_params.sample_time, 4 * CYCLE_S, 1e-6);
+
+    // 无扰接入: 外环无偏差时内环设定值不变
+    Harness_SetSensor(SENSOR_PRESSURE_1, 100.0f);
+    Harness_SetSensor(SENSOR_FLOW, 5.0f);
+    Cycle();
+    TEST_CHECK_NEAR(inner->setpoint, 5.0f, 1e-4);
+    TEST_CHECK_NEAR(inner->output_value, 50.0f, 1e-3);
+
+    // 外环不驱动执行器, 泵1由内环输出
+    TEST_CHECK(stub_actuator_publish_count > 0);
+    TEST_CHECK(stub_actuator_setpoints.value[ACTUATOR_PUMP_SPEED_1] == inner->output_value);
+
+    // 分频: 40个周期外环算10次, 内环每周期计算; 设定值只在外环计算时改变
+    outer_runs = outer->pid_state.cycle_count;
+    inner_runs = inner->pid_state.cycle_count;
+    last_setpoint = inner->setpoint;
+    for (int n = 0; n < 40; n++) {
+        Harness_SetSensor(SENSOR_PRESSURE_1, 100.0f - (float)n);
+        Harness_SetSensor(SENSOR_FLOW, 5.0f);
+        Cycle();
+        if (inner->setpoint != last_setpoint) {
+            setpoint_changes++;
+            last_setpoint = inner->setpoint;
+        }
+    }
+    TEST_CHECK(outer->pid_state.cycle_count - outer_runs == 10);
+    TEST_CHECK(inner->pid_state.cycle_count - inner_runs == 40);
+    TEST_CHECK(setpoint_changes > 0 && setpoint_changes <= 10);
+
+    // 外环大偏差: 内环设定值限于设定值范围
+    for (int n = 0; n < 400; n++) {
+        Harness_SetSensor(SENSOR_PRESSURE_1, 0.0f);
+        Harness_SetSensor(SENSOR_FLOW, 5.0f);
+        Cycle();
+        if (inner->setpoint < inner->setpoint_min || inner->setpoint > inner->setpoint_max) {
+            in_range = false;
+        }
+    }
+    TEST_CHECK(in_range);
+    TEST_CHECK(inner->setpoint == inner->setpoint_max);
+    for (int n = 0; n < 400; n++) {
+        Harness_SetSensor(SENSOR_PRESSURE_1, 250.0f);
+        Harness_SetSensor(SENSOR_FLOW, 5.0f);
+        Cycle();
+    }
+    TEST_CHECK(inner->setpoint == inner->setpoint_min);
+
+    // 非法配置: 内环已是外环, 外环已是别的回路的内环, 自身, 频率比0
+    ControlTaskV3_SetCascade(CONTROL_LOOP_PRESSURE_2, CONTROL_LOOP_PRESSURE_1, 2);
+    ControlTaskV3_SetCascade(CONTROL_LOOP_FLOW, CONTROL_LOOP_LEVEL_4, 2);
+    Cycle();
+    TEST_CHECK(g_control_stats.command_errors == 2);
+    TEST_CHECK(g_control_context.loops[CONTROL_LOOP_PRESSURE_2].cascade.inner_loop == CONTROL_LOOP_COUNT);
+    TEST_CHECK(inner->cascade.inner_loop == CONTROL_LOOP_COUNT);
+    TEST_CHECK(ControlTaskV3_SetCascade(CONTROL_LOOP_PRESSURE_1, CONTROL_LOOP_PRESSURE_1, 2) == pdFALSE);
+    TEST_CHECK(ControlTaskV3_SetCascade(CONTROL_LOOP_PRESSURE_1, CONTROL_LOOP_FLOW, 0) == pdFALSE);
+
+    // 取消串级: 压力1按单回路计算并驱动泵1
+    ControlTaskV3_SetCascade(CONTROL_LOOP_PRESSURE_1, CONTROL_LOOP_COUNT, 1);
+    ControlTaskV3_DisableLoop(CONTROL_LOOP_FLOW);
+    outer_runs = outer->pid_state.cycle_count;
+    for (int n = 0; n < 4; n++) {
+        Harness_SetSensor(SENSOR_PRESSURE_1, 100.0f);
+        Cycle();
+    }
+    TEST_CHECK(!Control_IsCascadeOuter(outer));
+    TEST_CHECK(outer->pid_state.cycle_count - outer_runs == 4);
+    TEST_CHECK(stub_actuator_setpoints.value[ACTUATOR_PUMP_SPEED_1] == outer->output_value);
+}
+
+/* ========================================================================== */
+/* 前馈 */
+/* ========================================================================== */
+
+static float DrawProfile(int n)
+{
+    if (n < 10) return 1.0f;
+    if (n < 30) return 3.0f;
+    return 3.0f - 0.05f * (float)(n - 30);
+}
+
+static void Test_FeedforwardFilter(void)
+{
+    const control_loop_config_t *loop = &g_control_context.loops[CONTROL_LOOP_PRESSURE_1];
+    control_feedforward_config_t config = {
+        .sensor = SENSOR_FLOW, .reference = 1.0f, .gain = 2.0f, .lead_time = 0.5f, .lag_time = 0.2f
+    };
+    double y = 0.0;
+    double x_last = 0.0;
+    double max_error = 0.0;
+
+    // 超前滞后 (后向欧拉): 首拍按稳态预置
+    TEST_CHECK(Harness_Reset() == pdPASS);
+    Harness_ConfigureLoop(CONTROL_LOOP_PRESSURE_1, CONTROL_MODE_FEEDFORWARD, 100.0f, 1.0f, 0.3f, -100.0f, 200.0f);
+    ControlTaskV3_SetFeedforward(CONTROL_LOOP_PRESSURE_1, &config);
+    for (int n = 0; n < 80; n++) {
+        double x = (double)DrawProfile(n) - config.reference;
+
+        if (n == 0) {
+            y = x;
+            x_last = x;
+        }
+        y = (config.lag_time * y + (config.lead_time + CYCLE_S) * x - config.lead_time * x_last) /
+            (config.lag_time + CYCLE_S);
+        x_last = x;
+
+        Harness_SetSensor(SENSOR_PRESSURE_1, 100.0f);
+        Harness_SetSensor(SENSOR_FLOW, DrawProfile(n));
+        Cycle();
+        max_error = fmax(max_error, fabs(loop->feedforward_output - config.gain * y));
+    }
+    TEST_CHECK(max_error < 1e-4);
+    TEST_CHECK(g_control_stats.command_errors == 0);
+
+    // 扰动测量无效: 前馈为0, 回路照常计算
+    stub_sensor_context.sensors[SENSOR_FLOW].valid = false;
+    Harness_SetSensor(SENSOR_PRESSURE_1, 100.0f);
+    Cycle();
+    TEST_CHECK(loop->feedforward_output == 0.0f);
+    TEST_CHECK(loop->state == CONTROL_STATE_RUNNING);
+
+    // 静态前馈: T_lead=T_lag=0时为gain·(d - reference)
+    config.lead_time = 0.0f;
+    config.lag_time = 0.0f;
+    ControlTaskV3_SetFeedforward(CONTROL_LOOP_PRESSURE_1, &config);
+    for (int n = 0; n < 40; n++) {
+        Harness_SetSensor(SENSOR_PRESSURE_1, 100.0f);
+        Harness_SetSensor(SENSOR_FLOW, DrawProfile(n));
+        Cycle();
+        TEST_CHECK_NEAR(loop->feedforward_output, config.gain * (DrawProfile(n) - config.reference), 1e-5);
+    }
+
+    // 非法配置被拒绝, 原配置保留
+    config.lag_time = -1.0f;
+    ControlTaskV3_SetFeedforward(CONTROL_LOOP_PRESSURE_1, &config);
+    Cycle();
+    TEST_CHECK(g_control_stats.command_errors == 1);
+    TEST_CHECK(loop->feedforward.lag_time == 0.0f);
+}
+
+/* ========================================================================== */
+/* 闭环扰动抑制 */
+/* ========================================================================== */
+
+#define BENCH_SETTLE_CYCLES     500     // 10 s
+#define BENCH_RUN_CYCLES        1500    // 扰动后30 s
+
+// 供液损失2L/min阶跃下的压力IAE (kPa·s): 单回路压力PI直接驱动泵, 或压力/流量串级
+static double Run_SupplyDisturbance(bool cascade, double *max_deviation)
+{
+    pump_plant_t plant = { .flow = 5.0, .pressure = 100.0, .supply_loss = 0.0 };
+    double iae = 0.0;
+
+    Harness_Reset();
+    if (cascade) {
+        SetupPumpCascade(PUMP_RATE_RATIO);
+    } else {
+        // 外环增益与串级外环相同 (开环增益 0.15·20 = 1.5·2)
+        Harness_ConfigureLoop(CONTROL_LOOP_PRESSURE_1, CONTROL_MODE_AUTO, 100.0f, 1.5f, 0.5f, 0.0f, 100.0f);
+        Control_ProcessCommands();
+        Control_PresetIntegral(CONTROL_LOOP_PRESSURE_1, 50.0f);
+    }
+
+    *max_deviation = 0.0;
+    for (int n = 0; n < BENCH_SETTLE_CYCLES + BENCH_RUN_CYCLES; n++) {
+        if (n == BENCH_SETTLE_CYCLES) {
+            plant.supply_loss = 2.0;
+        }
+
+        Harness_SetSensor(SENSOR_PRESSURE_1, (float)plant.pressure);
+        Harness_SetSensor(SENSOR_FLOW, (float)plant.flow);
+        Cycle();
+        PumpPlant_Step(&plant, stub_actuator_setpoints.value[ACTUATOR_PUMP_SPEED_1]);
+
+        if (n >= BENCH_SETTLE_CYCLES) {
+            iae += fabs(plant.pressure - 100.0) * CYCLE_S;
+            *max_deviation = fmax(*max_deviation, fabs(plant.pressure - 100.0));
+        }
+    }
+    return iae;
+}
+
+// 出口流量1->2L/min阶跃下的压力IAE (kPa·s); config=NULL为无前馈
+static double Run_DrawDisturbance(const control_feedforward_config_t *config, double *max_deviation)
+{
+    draw_plant_t plant = { .actuator = 50.0, .pressure = 100.0, .draw = 1.0 };
+    double iae = 0.0;
+
+    Harness_Reset();
+    Harness_ConfigureLoop(CONTROL_LOOP_PRESSURE_1,
+                          (config != NULL) ? CONTROL_MODE_FEEDFORWARD : CONTROL_MODE_AUTO,
+                          100.0f, 1.0f, 0.333f, 0.0f, 100.0f);
+    if (config != NULL) {
+        ControlTaskV3_SetFeedforward(CONTROL_LOOP_PRESSURE_1, config);
+    }
+    Control_ProcessCommands();
+    Control_PresetIntegral(CONTROL_LOOP_PRESSURE_1, 50.0f);
+
+    *max_deviation = 0.0;
+    for (int n = 0; n < BENCH_SETTLE_CYCLES + BENCH_RUN_CYCLES; n++) {
+        if (n == BENCH_SETTLE_CYCLES) {
+            plant.draw = 2.0;
+        }
+
+        Harness_SetSensor(SENSOR_PRESSURE_1, (float)plant.pressure);
+        Harness_SetSensor(SENSOR_FLOW, (float)plant.draw);
+        Cycle();
+        DrawPlant_Step(&plant, stub_actuator_setpoints.value[ACTUATOR_PUMP_SPEED_1]);
+
+        if (n >= BENCH_SETTLE_CYCLES) {
+            iae += fabs(plant.pressure - 100.0) * CYCLE_S;
+            *max_deviation = fmax(*max_deviation, fabs(plant.pressure - 100.0));
+        }
+    }
+    return iae;
+}
+
+static void Test_DisturbanceRejection(void)
+{
+    // 静态增益 25/2.5, 超前抵消执行机构滞后 (1 s)
+    const control_feedforward_config_t ff_static = {
+        .sensor = SENSOR_FLOW, .reference = 1.0f, .gain = 10.0f, .lead_time = 0.0f, .lag_time = 0.0f
+    };
+    const control_feedforward_config_t ff_dynamic = {
+        .sensor = SENSOR_FLOW, .reference = 1.0f, .gain = 10.0f, .lead_time = 1.0f, .lag_time = 0.25f
+    };
+    double single_iae, cascade_iae, none_iae, static_iae, dynamic_iae;
+    double single_dev, cascade_dev, none_dev, static_dev, dynamic_dev;
+
+    single_iae = Run_SupplyDisturbance(false, &single_dev);
+    cascade_iae = Run_SupplyDisturbance(true, &cascade_dev);
+    printf("supply loss: single-loop IAE %.2f kPa*s (peak %.2f), cascade 1:%d IAE %.2f kPa*s (peak %.2f)\n",
+           single_iae, single_dev, PUMP_RATE_RATIO, cascade_iae, cascade_dev);
+    TEST_CHECK(cascade_iae < 0.5 * single_iae);
+    TEST_CHECK(cascade_dev < 0.5 * single_dev);
+
+    none_iae = Run_DrawDisturbance(NULL, &none_dev);
+    static_iae = Run_DrawDisturbance(&ff_static, &static_dev);
+    dynamic_iae = Run_DrawDisturbance(&ff_dynamic, &dynamic_dev);
+    printf("outlet draw: feedback IAE %.2f (peak %.2f), static ff %.2f (peak %.2f), lead-lag ff %.2f (peak %.2f)\n",
+           none_iae, none_dev, static_iae, static_dev, dynamic_iae, dynamic_dev);
+    TEST_CHECK(static_iae < 0.5 * none_iae);
+    TEST_CHECK(dynamic_iae < 0.5 * static_iae);
+}
+
+int main(void)
+{
+    Test_CascadeScheduling();
+    Test_FeedforwardFilter();
+    Test_DisturbanceRejection();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,254 @@
+/**
+ ******************************************************************************
+ * @file    test_control_schedule.c
+ * @brief   控制任务调度方式主机测试 (周期调度 / 数据驱动)
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 以1ms时基模拟传感器任务 (10ms基础节拍, 各通道按默认输出周期产生新样本,
+ * 有新输出时通知控制任务) 和控制任务唤醒 (周期调度: 与传感器不同相的20ms;
+ * 数据驱动: 收到通知或等待超时20ms), 12个回路全部投入自动.
+ * 本文件按CONTROL_DATA_DRIVEN的当前取值编译, test_control_schedule_dd.c以
+ * CONTROL_DATA_DRIVEN=1包含本文件, 两个程序打印同一组指标:
+ * 唤醒次数, PID计算次数, 样本使用率, 采样->输出延迟, 主机每周期耗时.
+ * 最后200ms传感器停发, 检查命令/监视仍按20ms进行.
+ ******************************************************************************
+ */
+
+#include "control_harness.h"
+#include "test_common.h"
+#include <math.h>
+
+#define SIM_MS                  10000
+#define STALL_MS                200
+#define SENSOR_TICK_MS          10
+#define CONTROL_PHASE_MS        7       // 周期调度的唤醒相位 (与传感器节拍不同步)
+
+#if CONTROL_DATA_DRIVEN
+#define SCHEDULE_NAME           "data-driven"
+#else
+#define SCHEDULE_NAME           "periodic"
+#endif
+
+// 传感器默认输出周期 (采样周期 × 抽取比, 见Sensor_InitializeConfigs)
+static const uint32_t g_output_period_ms[SENSOR_COUNT] = {
+    [SENSOR_TEMP_1] = 1000, [SENSOR_TEMP_2] = 1000, [SENSOR_TEMP_3] = 1000,
+    [SENSOR_PRESSURE_1] = 10, [SENSOR_PRESSURE_2] = 10, [SENSOR_PRESSURE_3] = 10, [SENSOR_PRESSURE_4] = 10,
+    [SENSOR_LEVEL_FLOAT_1] = 50, [SENSOR_LEVEL_FLOAT_2] = 50, [SENSOR_LEVEL_FLOAT_3] = 50,
+    [SENSOR_LEVEL_ANALOG] = 50, [SENSOR_FLOW] = 100,
+};
+
+typedef struct {
+    uint32_t wakes;
+    uint32_t produced[SENSOR_COUNT];
+    uint32_t consumed[CONTROL_LOOP_COUNT];
+    uint32_t last_sequence[CONTROL_LOOP_COUNT];
+    uint32_t latency_count;
+    uint64_t latency_sum_ms;
+    uint32_t latency_max_ms;
+    uint64_t host_ns;
+} schedule_stats_t;
+
+static schedule_stats_t g_stats;
+static uint32_t g_last_wake_ms;
+
+/* ========================================================================== */
+/* 模拟 */
+/* ========================================================================== */
+
+static void Setup(void)
+{
+    TEST_CHECK(Harness_Reset() == pdPASS);
+    memset(&g_stats, 0, sizeof(g_stats));
+    memcpy(stub_sensor_output_period_ms, g_output_period_ms, sizeof(g_output_period_ms));
+
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        ControlTaskV3_SetMode((control_loop_t)i, CONTROL_MODE_AUTO);
+        ControlTaskV3_EnableLoop((control_loop_t)i);
+        Control_ProcessCommands();
+    }
+
+#if CONTROL_DATA_DRIVEN
+    // 同Task_ControlV3启动时的登记
+    SensorTaskV3_SetPublishNotify(xTaskGetCurrentTaskHandle());
+#endif
+    g_last_wake_ms = 0;
+}
+
+// 传感器节拍: 到期通道产生新样本 (围绕回路设定值缓慢变化, 各回路输入通道互不相同), 有新输出时通知
+static void SensorTick(uint32_t t)
+{
+    bool output = false;
+
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        const control_loop_config_t *loop = &g_control_context.loops[i];
+        sensor_type_t sensor = loop->sensor_type;
+
+        if ((t % g_output_period_ms[sensor]) != 0) {
+            continue;
+        }
+        Harness_SetSensor(sensor, loop->setpoint + 0.5f * sinf(6.2832f * (float)t / 3000.0f));
+        g_stats.produced[sensor]++;
+        output = true;
+    }
+
+    if (output && stub_sensor_publish_notify != NULL) {
+        xTaskNotifyGive(stub_sensor_publish_notify);
+    }
+}
+
+static bool ControlWakeDue(uint32_t t)
+{
+#if CONTROL_DATA_DRIVEN
+    // ulTaskNotifyTake(pdTRUE, CONTROL_TASK_PERIOD_MS): 有通知立即返回, 否则超时
+    if (stub_notify_count > 0 || (t - g_last_wake_ms) >= CONTROL_TASK_PERIOD_MS) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONTROL_TASK_PERIOD_MS));
+        return true;
+    }
+    return false;
+#else
+    return (t % CONTROL_TASK_PERIOD_MS) == CONTROL_PHASE_MS;
+#endif
+}
+
+static void ControlWake(uint32_t t)
+{
+    uint32_t start = Profiler_Now();
+
+    Control_RunCycle();
+    g_stats.host_ns += (uint32_t)(Profiler_Now() - start);
+    g_stats.wakes++;
+    g_last_wake_ms = t;
+
+    // 新样本首次被回路使用: 计入样本使用数和采样->输出延迟
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        const sensor_data_t *data = &stub_sensor_context.sensors[g_control_context.loops[i].sensor_type];
+        uint32_t sequence = g_loop_trace[i].sequence;
+
+        if (sequence == 0 || sequence == g_stats.last_sequence[i]) {
+            continue;
+        }
+        g_stats.last_sequence[i] = sequence;
+        g_stats.consumed[i]++;
+        if (sequence == data->sequence) {
+            uint32_t latency = t - data->timestamp;
+
+            g_stats.latency_sum_ms += latency;
+            g_stats.latency_count++;
+            if (latency > g_stats.latency_max_ms) g_stats.latency_max_ms = latency;
+        }
+    }
+}
+
+static void Run(uint32_t from_ms, uint32_t to_ms, bool sensor_running)
+{
+    for (uint32_t t = from_ms; t < to_ms; t++) {
+        stub_tick = t;
+        if (sensor_running && (t % SENSOR_TICK_MS) == 0) {
+            SensorTick(t);
+        }
+        if (ControlWakeDue(t)) {
+            ControlWake(t);
+        }
+    }
+    stub_tick = to_ms;
+}
+
+static uint32_t PidRuns(void)
+{
+    uint32_t runs = 0;
+
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        runs += g_control_context.loops[i].pid_state.cycle_count;
+    }
+    return runs;
+}
+
+/* ========================================================================== */
+/* 测试 */
+/* ========================================================================== */
+
+static void Test_Schedule(void)
+{
+    uint32_t produced = 0;
+    uint32_t consumed = 0;
+    uint32_t runs;
+    uint32_t supervision;
+    uint32_t wakes;
+
+    Setup();
+    Run(0, SIM_MS, true);
+
+    runs = PidRuns();
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        produced += g_stats.produced[g_control_context.loops[i].sensor_type];
+        consumed += g_stats.consumed[i];
+        TEST_CHECK(g_control_context.loops[i].state == CONTROL_STATE_RUNNING);
+    }
+
+    printf("%s: wakes %.1f/s, PID runs %.0f/s, samples used %u/%u, latency mean %.2f max %u ms, "
+           "host %.0f ns/wake\n", SCHEDULE_NAME,
+           g_stats.wakes * 1000.0 / SIM_MS, runs * 1000.0 / SIM_MS, consumed, produced,
+           (double)g_stats.latency_sum_ms / g_stats.latency_count, g_stats.latency_max_ms,
+           (double)g_stats.host_ns / g_stats.wakes);
+
+    // 每个样本首次计算时记录一次"采样->控制"延迟
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        profiler_summary_t summary;
+
+        LatencyTrace_GetSummary(i, LATENCY_STAGE_CONTROL, &summary);
+        TEST_CHECK(summary.count == g_stats.consumed[i]);
+    }
+
+    // 监视步骤两种方式都按20ms执行
+    TEST_CHECK_NEAR(g_control_context.cycle_count, SIM_MS / CONTROL_TASK_PERIOD_MS, 1);
+
+#if CONTROL_DATA_DRIVEN
+    // 每个传感器节拍都有压力新输出: 每节拍唤醒一次, 每个样本恰好计算一次, 同节拍输出
+    TEST_CHECK(g_stats.wakes == SIM_MS / SENSOR_TICK_MS);
+    for (uint8_t i = 0; i < CONTROL_LOOP_COUNT; i++) {
+        uint32_t samples = g_stats.produced[g_control_context.loops[i].sensor_type];
+
+        TEST_CHECK(g_stats.consumed[i] == samples);
+        TEST_CHECK(g_control_context.loops[i].pid_state.cycle_count == samples);
+    }
+    TEST_CHECK(g_stats.latency_max_ms == 0);
+
+    // 积分/微分按样本实际间隔
+    TEST_CHECK_NEAR(g_pid_batch.sample_time[CONTROL_LOOP_TEMP_1], 1.0f, 1e-6);
+    TEST_CHECK_NEAR(g_pid_batch.sample_time[CONTROL_LOOP_PRESSURE_1], 0.01f, 1e-6);
+    TEST_CHECK_NEAR(g_pid_batch.sample_time[CONTROL_LOOP_LEVEL_4], 0.05f, 1e-6);
+#else
+    // 固定20ms: 每次唤醒全部回路重新计算; 100Hz压力样本约一半未被使用, 延迟最长一个周期
+    TEST_CHECK(g_stats.wakes == SIM_MS / CONTROL_TASK_PERIOD_MS);
+    TEST_CHECK(runs == g_stats.wakes * CONTROL_LOOP_COUNT);
+    TEST_CHECK(g_stats.consumed[CONTROL_LOOP_PRESSURE_1] * 2 == g_stats.produced[SENSOR_PRESSURE_1]);
+    TEST_CHECK(g_stats.latency_max_ms < CONTROL_TASK_PERIOD_MS);
+    TEST_CHECK_NEAR(g_pid_batch.sample_time[CONTROL_LOOP_TEMP_1], CONTROL_TASK_PERIOD_MS / 1000.0f, 1e-6);
+#endif
+
+    // 传感器停发: 仍每20ms唤醒, 命令和监视照常
+    wakes = g_stats.wakes;
+    supervision = g_control_context.cycle_count;
+    ControlTaskV3_SetSetpoint(CONTROL_LOOP_PRESSURE_1, 120.0f);
+    Run(SIM_MS, SIM_MS + STALL_MS, false);
+    TEST_CHECK(g_stats.wakes - wakes == STALL_MS / CONTROL_TASK_PERIOD_MS);
+    TEST_CHECK(g_control_context.cycle_count - supervision == STALL_MS / CONTROL_TASK_PERIOD_MS);
+    TEST_CHECK(g_control_context.loops[CONTROL_LOOP_PRESSURE_1].setpoint == 120.0f);
+#if CONTROL_DATA_DRIVEN
+    // 没有新样本不重新计算
+    TEST_CHECK(PidRuns() == runs);
+#else
+    TEST_CHECK(PidRuns() == runs + (STALL_MS / CONTROL_TASK_PERIOD_MS) * CONTROL_LOOP_COUNT);
+#endif
+}
+
+int main(void)
+{
+    Test_Schedule();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,12 @@
+/**
+ ******************************************************************************
+ * @file    test_control_schedule_dd.c
+ * @brief   控制任务调度方式主机测试: 数据驱动调度 (CONTROL_DATA_DRIVEN=1)
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ */
+
+#define CONTROL_DATA_DRIVEN     1
+#include "test_control_schedule.c"
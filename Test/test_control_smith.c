@@ -0,0 +1,354 @@
+/**
+ ******************************************************************************
+ * @file    test_control_smith.c
+ * @brief   FOPDT模型与纯滞后补偿(Smith预估器)主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - FOPDT模型: 阶跃响应与解析解 K·(1-e^(-(t-θ)/τ)) 一致 (采样间隔整除/不整除
+ *   每格时长, 抖动, 大于θ), 稳态预置, 每次更新最多写入一格 (每周期O(1))
+ * - 配置: 非法模型被拒绝, 无自整定结果时gain=0被拒绝, IMC整定参数, 接入无扰
+ * - 闭环对比 (通过control_harness.h): 加热块 K=0.5°C/%, τ=60s, θ=15s,
+ *   40->45°C设定值阶跃 (两种整定输出都不饱和) 的2%调节时间, 超调量和IAE:
+ *   按纯滞后整定的PI, Smith+IMC(λ=10s), 同样增益不加预估器,
+ *   以及模型K/τ/θ各偏差±20%时的Smith (IAE仍优于PI, τ偏小时有按τ衰减的拖尾)
+ ******************************************************************************
+ */
+
+#include "control_harness.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define CYCLE_S             (CONTROL_TASK_PERIOD_MS / 1000.0)
+
+#define PLANT_GAIN          0.5     // °C/%
+#define PLANT_TAU           60.0    // s
+#define PLANT_DEAD_TIME_MS  15000
+#define PLANT_DEAD_TIME     (PLANT_DEAD_TIME_MS / 1000.0)
+#define PLANT_AMBIENT       25.0    // °C
+#define PLANT_DELAY_CYCLES  (PLANT_DEAD_TIME_MS / CONTROL_TASK_PERIOD_MS)
+
+#define SETPOINT_START      40.0f
+#define SETPOINT_STEP       45.0f
+#define SWITCH_CYCLES       3000    // 60 s稳态后切换模式
+#define STEP_CYCLES         4000    // 80 s时设定值阶跃
+#define RUN_CYCLES          34000   // 阶跃后600 s
+
+/* ========================================================================== */
+/* FOPDT模型 */
+/* ========================================================================== */
+
+static double FopdtStep(double t, double gain, double tau, double theta)
+{
+    return (t <= theta) ? 0.0 : gain * (1.0 - exp(-(t - theta) / tau));
+}
+
+// 输入0->1阶跃, 按给定采样间隔推进, 返回滞后输出与解析解的最大偏差
+static double FopdtModel_MaxError(float gain, float tau, float theta, float dt, float jitter)
+{
+    fopdt_model_t model;
+    double t = 0.0;
+    double max_error = 0.0;
+
+    srand(1);
+    FopdtModel_Init(&model, gain, tau, theta);
+    FopdtModel_Reset(&model, 0.0f);
+
+    while (t < theta + 5.0 * tau) {
+        float step = dt * (1.0f + jitter * (2.0f * (float)rand() / RAND_MAX - 1.0f));
+        uint8_t head = model.head;
+
+        FopdtModel_Update(&model, 1.0f, step);
+        t += step;
+
+        // 采样间隔不超过每格时长时最多写入一格
+        if (theta > 0.0f && step <= theta / FOPDT_MODEL_DELAY_SLOTS) {
+            TEST_CHECK(model.head == head || model.head == (head + 1) % (FOPDT_MODEL_DELAY_SLOTS + 1));
+        }
+        TEST_CHECK_NEAR(FopdtModel_GetOutput(&model), FopdtStep(t, gain, tau, 0.0), 1e-4 * gain);
+        max_error = fmax(max_error, fabs(FopdtModel_GetDelayedOutput(&model) - FopdtStep(t, gain, tau, theta)));
+    }
+    return max_error;
+}
+
+static void Test_FopdtModel(void)
+{
+    fopdt_model_t model;
+    double error;
+
+    // 参数限幅, 空指针和非正采样间隔
+    FopdtModel_Init(&model, 2.0f, -1.0f, -3.0f);
+    TEST_CHECK(model.time_constant == 0.0f && model.dead_time == 0.0f && model.slot_time == 0.0f);
+    FopdtModel_Init(NULL, 1.0f, 1.0f, 1.0f);
+    FopdtModel_Update(NULL, 1.0f, 0.02f);
+    TEST_CHECK(FopdtModel_GetOutput(NULL) == 0.0f && FopdtModel_GetDelayedOutput(NULL) == 0.0f);
+
+    // 无惯性无滞后: 输出即 K·u
+    FopdtModel_Update(&model, 3.0f, 0.02f);
+    TEST_CHECK_NEAR(FopdtModel_GetOutput(&model), 6.0, 1e-6);
+    TEST_CHECK_NEAR(FopdtModel_GetDelayedOutput(&model), 6.0, 1e-6);
+    FopdtModel_Update(&model, 5.0f, 0.0f);
+    TEST_CHECK_NEAR(FopdtModel_GetOutput(&model), 6.0, 1e-6);
+
+    // 稳态预置: 两个输出相等, 校正量为0
+    FopdtModel_Init(&model, 0.5f, 60.0f, 15.0f);
+    FopdtModel_Reset(&model, 30.0f);
+    TEST_CHECK_NEAR(FopdtModel_GetOutput(&model), 15.0, 1e-6);
+    TEST_CHECK_NEAR(FopdtModel_GetDelayedOutput(&model), 15.0, 1e-6);
+    for (int n = 0; n < 1000; n++) {
+        FopdtModel_Update(&model, 30.0f, 0.02f);
+    }
+    TEST_CHECK_NEAR(FopdtModel_GetOutput(&model) - FopdtModel_GetDelayedOutput(&model), 0.0, 1e-5);
+
+    // 阶跃响应: 采样间隔整除每格 (15/64 s), 不整除, 抖动±50%, 大于θ
+    error = FopdtModel_MaxError(0.5f, 60.0f, 15.0f, 15.0f / 64.0f, 0.0f);
+    TEST_CHECK(error < 1e-4);
+    error = FopdtModel_MaxError(0.5f, 60.0f, 15.0f, 0.02f, 0.0f);
+    printf("fopdt: 20 ms max delayed-output error %.2e (K=0.5)\n", error);
+    TEST_CHECK(error < 1e-4);
+    error = FopdtModel_MaxError(0.5f, 60.0f, 15.0f, 0.02f, 0.5f);
+    TEST_CHECK(error < 1e-4);
+    error = FopdtModel_MaxError(1.0f, 5.0f, 2.0f, 0.07f, 0.3f);
+    TEST_CHECK(error < 2e-3);
+    error = FopdtModel_MaxError(1.0f, 30.0f, 2.0f, 3.0f, 0.0f);
+    TEST_CHECK(error < 2e-3);
+}
+
+/* ========================================================================== */
+/* 配置 */
+/* ========================================================================== */
+
+static void Test_SmithConfig(void)
+{
+    const control_smith_config_t invalid[] = {
+        { -0.5f, 60.0f, 15.0f, 0.0f },
+        { 0.5f, -1.0f, 15.0f, 0.0f },
+        { 0.5f, 60.0f, -1.0f, 0.0f },
+        { 0.5f, 60.0f, 15.0f, -1.0f },
+        { 0.0f, 0.0f, 0.0f, 0.0f },     // 无自整定结果
+    };
+    const control_smith_config_t model = { 0.5f, 60.0f, 15.0f, 10.0f };
+    control_smith_config_t readback;
+    pid_params_t params;
+    float correction;
+    bool active;
+
+    TEST_CHECK(Harness_Reset() == pdPASS);
+    TEST_CHECK(ControlTaskV3_SetSmithPredictor(CONTROL_LOOP_COUNT, &model) == pdFALSE);
+    TEST_CHECK(ControlTaskV3_SetSmithPredictor(CONTROL_LOOP_TEMP_1, NULL) == pdFALSE);
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        TEST_CHECK(Control_ConfigureSmith(CONTROL_LOOP_TEMP_1, &invalid[i]) == pdFALSE);
+    }
+    ControlTaskV3_GetSmithPredictor(CONTROL_LOOP_TEMP_1, &readback, NULL, NULL);
+    TEST_CHECK(readback.gain == 0.0f);
+
+    // IMC整定: Kp=τ/(K·λ), Ki=1/(K·λ), 无微分, 积分限幅对应输出范围
+    TEST_CHECK(ControlTaskV3_SetSmithPredictor(CONTROL_LOOP_TEMP_1, &model) == pdTRUE);
+    Control_ProcessCommands();
+    ControlTaskV3_GetSmithPredictor(CONTROL_LOOP_TEMP_1, &readback, &correction, &active);
+    TEST_CHECK(memcmp(&readback, &model, sizeof(model)) == 0);
+    TEST_CHECK(correction == 0.0f && !active);
+    params = g_control_context.loops[CONTROL_LOOP_TEMP_1].pid_params;
+    TEST_CHECK_NEAR(params.kp, 12.0, 1e-4);
+    TEST_CHECK_NEAR(params.ki, 0.2, 1e-6);
+    TEST_CHECK(params.kd == 0.0f && !params.derivative_enabled);
+    TEST_CHECK_NEAR(params.integral_max, 500.0, 1e-3);
+
+    // 接入: 按当前输出稳态预置, 第一个周期校正量为0
+    Harness_ConfigureLoop(CONTROL_LOOP_TEMP_1, CONTROL_MODE_SMITH, SETPOINT_START, 12.0f, 0.2f, 0.0f, 100.0f);
+    Control_ProcessCommands();
+    Harness_SetSensor(SENSOR_TEMP_1, SETPOINT_START);
+    Control_RunCycle();
+    ControlTaskV3_GetSmithPredictor(CONTROL_LOOP_TEMP_1, &readback, &correction, &active);
+    TEST_CHECK(active);
+    TEST_CHECK(correction == 0.0f);
+    TEST_CHECK(g_smith_primed_mask & (1UL << CONTROL_LOOP_TEMP_1));
+
+    // 重新配置模型后重新预置
+    TEST_CHECK(Control_ConfigureSmith(CONTROL_LOOP_TEMP_1, &model) == pdTRUE);
+    TEST_CHECK((g_smith_primed_mask & (1UL << CONTROL_LOOP_TEMP_1)) == 0);
+}
+
+/* ========================================================================== */
+/* 闭环对比 */
+/* ========================================================================== */
+
+// 加热块: τ·T' = -(T - Ta) + K·u(t-θ), 一阶部分按零阶保持精确离散
+typedef struct {
+    double temperature;
+    float inputs[PLANT_DELAY_CYCLES];
+    int head;
+} heater_plant_t;
+
+static void HeaterPlant_Init(heater_plant_t *plant, double u)
+{
+    plant->temperature = PLANT_AMBIENT + PLANT_GAIN * u;
+    for (int i = 0; i < PLANT_DELAY_CYCLES; i++) {
+        plant->inputs[i] = (float)u;
+    }
+    plant->head = 0;
+}
+
+static void HeaterPlant_Step(heater_plant_t *plant, float u)
+{
+    const double a = exp(-CYCLE_S / PLANT_TAU);
+    double delayed = plant->inputs[plant->head];
+
+    plant->inputs[plant->head] = u;
+    plant->head = (plant->head + 1) % PLANT_DELAY_CYCLES;
+    plant->temperature = a * plant->temperature + (1.0 - a) * (PLANT_AMBIENT + PLANT_GAIN * delayed);
+}
+
+typedef struct {
+    double settling_time;       // 2%误差带 (s), 未稳定时为负
+    double overshoot;           // %
+    double iae;                 // °C·s
+    double switch_bump;         // 切换模式到阶跃前的最大偏差 (°C)
+} step_result_t;
+
+// 40°C稳态 (PI, u=30%) -> 切换到被测配置 -> 45°C阶跃; model=NULL时不加预估器
+static void Run_Step(const control_smith_config_t *model, float kp, float ki, step_result_t *result)
+{
+    const double band = 0.02 * (SETPOINT_STEP - SETPOINT_START);
+    const double u0 = (SETPOINT_START - PLANT_AMBIENT) / PLANT_GAIN;
+    heater_plant_t plant;
+    pid_params_t params;
+    double peak = 0.0;
+    double last_out = 0.0;
+
+    HeaterPlant_Init(&plant, u0);
+    memset(result, 0, sizeof(step_result_t));
+
+    Harness_Reset();
+    Harness_ConfigureLoop(CONTROL_LOOP_TEMP_1, CONTROL_MODE_AUTO, SETPOINT_START, 4.0f, 0.0667f, 0.0f, 100.0f);
+    Control_ProcessCommands();
+    Control_PresetIntegral(CONTROL_LOOP_TEMP_1, (float)u0);
+    g_control_context.loops[CONTROL_LOOP_TEMP_1].output_value = (float)u0;
+
+    for (int n = 0; n < STEP_CYCLES + RUN_CYCLES; n++) {
+        double t;
+
+        if (n == SWITCH_CYCLES) {
+            if (model != NULL) {
+                ControlTaskV3_SetSmithPredictor(CONTROL_LOOP_TEMP_1, model);
+                ControlTaskV3_SetMode(CONTROL_LOOP_TEMP_1, CONTROL_MODE_SMITH);
+            } else {
+                params = g_control_context.loops[CONTROL_LOOP_TEMP_1].pid_params;
+                params.kp = kp;
+                params.ki = ki;
+                params.integral_max = params.output_max / ki;
+                params.integral_min = params.output_min / ki;
+                ControlTaskV3_SetPIDParams(CONTROL_LOOP_TEMP_1, &params);
+            }
+            Control_ProcessCommands();
+            Control_PresetIntegral(CONTROL_LOOP_TEMP_1, g_control_context.loops[CONTROL_LOOP_TEMP_1].output_value);
+        }
+        if (n == STEP_CYCLES) {
+            ControlTaskV3_SetSetpoint(CONTROL_LOOP_TEMP_1, SETPOINT_STEP);
+        }
+
+        Harness_SetSensor(SENSOR_TEMP_1, (float)plant.temperature);
+        Control_RunCycle();
+        stub_tick += CONTROL_TASK_PERIOD_MS;
+        HeaterPlant_Step(&plant, stub_actuator_setpoints.value[ACTUATOR_HEATER_1]);
+
+        if (n >= SWITCH_CYCLES && n < STEP_CYCLES) {
+            result->switch_bump = fmax(result->switch_bump, fabs(plant.temperature - SETPOINT_START));
+        }
+        if (n < STEP_CYCLES) {
+            continue;
+        }
+
+        t = (n + 1 - STEP_CYCLES) * CYCLE_S;
+        peak = fmax(peak, plant.temperature - SETPOINT_STEP);
+        result->iae += fabs(plant.temperature - SETPOINT_STEP) * CYCLE_S;
+        if (fabs(plant.temperature - SETPOINT_STEP) > band) {
+            last_out = t;
+        }
+    }
+
+    result->overshoot = 100.0 * peak / (SETPOINT_STEP - SETPOINT_START);
+    result->settling_time = (last_out < RUN_CYCLES * CYCLE_S - 60.0) ? last_out : -1.0;
+}
+
+static void PrintStep(const char *name, const step_result_t *r)
+{
+    if (r->settling_time >= 0.0) {
+        printf("%-28s settling %6.1f s, overshoot %5.1f %%, IAE %6.1f C*s\n",
+               name, r->settling_time, r->overshoot, r->iae);
+    } else {
+        printf("%-28s not settled,      overshoot %5.1f %%, IAE %6.1f C*s\n", name, r->overshoot, r->iae);
+    }
+}
+
+static void Test_ClosedLoop(void)
+{
+    const control_smith_config_t exact = { PLANT_GAIN, PLANT_TAU, PLANT_DEAD_TIME, 10.0f };
+    const float scales[] = { 0.8f, 1.2f };
+    step_result_t pi;
+    step_result_t smith;
+    step_result_t aggressive;
+    step_result_t detuned;
+    double worst_settling = 0.0;
+    double worst_overshoot = 0.0;
+
+    // 按纯滞后整定的PI (SIMC, τc=θ): Kp=τ/(K·2θ)=4, Ti=τ
+    Run_Step(NULL, 4.0f, 0.0667f, &pi);
+    PrintStep("PI (SIMC, tau_c=theta)", &pi);
+
+    Run_Step(&exact, 0.0f, 0.0f, &smith);
+    PrintStep("Smith + IMC (lambda=10 s)", &smith);
+
+    // 与Smith相同的PI参数, 不加预估器
+    Run_Step(NULL, 12.0f, 0.2f, &aggressive);
+    PrintStep("PI with IMC gains, no Smith", &aggressive);
+
+    TEST_CHECK(pi.settling_time > 0.0);
+    TEST_CHECK(smith.settling_time > 0.0);
+    TEST_CHECK(smith.settling_time < 0.6 * pi.settling_time);
+    TEST_CHECK(smith.iae < pi.iae);
+    TEST_CHECK(smith.overshoot < 2.0);
+    TEST_CHECK(smith.switch_bump < 0.01);
+    TEST_CHECK(aggressive.settling_time < 0.0 || aggressive.overshoot > 30.0);
+
+    // 模型偏差: K, τ, θ分别±20%
+    for (int p = 0; p < 3; p++) {
+        for (size_t s = 0; s < sizeof(scales) / sizeof(scales[0]); s++) {
+            control_smith_config_t model = exact;
+            char name[40];
+
+            if (p == 0) model.gain *= scales[s];
+            if (p == 1) model.time_constant *= scales[s];
+            if (p == 2) model.dead_time *= scales[s];
+
+            Run_Step(&model, 0.0f, 0.0f, &detuned);
+            snprintf(name, sizeof(name), "Smith, %s x%.1f", (p == 0) ? "K" : ((p == 1) ? "tau" : "theta"),
+                     scales[s]);
+            PrintStep(name, &detuned);
+
+            TEST_CHECK(detuned.settling_time > 0.0);
+            TEST_CHECK(detuned.switch_bump < 0.01);
+            TEST_CHECK(detuned.iae < pi.iae);
+            worst_settling = fmax(worst_settling, detuned.settling_time);
+            worst_overshoot = fmax(worst_overshoot, detuned.overshoot);
+        }
+    }
+
+    printf("model error +-20%%: worst settling %.1f s, worst overshoot %.1f %%\n", worst_settling, worst_overshoot);
+    TEST_CHECK(worst_settling < 2.0 * pi.settling_time);
+    TEST_CHECK(worst_overshoot < 10.0);
+}
+
+int main(void)
+{
+    Test_FopdtModel();
+    Test_SmithConfig();
+    Test_ClosedLoop();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,135 @@
+/**
+ ******************************************************************************
+ * @file    test_latency_trace.c
+ * @brief   采样到输出延迟跟踪主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 主机时钟下1个计数=1ns. 采集时刻取当前计数减去已知延迟, 检查:
+ * - 无效标记/阶段不记录
+ * - 同一样本每阶段只记录首次 (周期调度下重复下发), 阶段和回路互不影响
+ * - 最小/平均/最大和直方图档, 复位后重新计数
+ ******************************************************************************
+ */
+
+#include "latency_trace.h"
+#include "test_common.h"
+#include <string.h>
+
+#define NS_PER_US           1000U
+
+static latency_stamp_t MakeStamp(uint8_t loop, uint32_t sequence, uint32_t age_us)
+{
+    latency_stamp_t stamp;
+
+    stamp.loop = loop;
+    stamp.sequence = sequence;
+    stamp.acquire_time = Profiler_Now() - age_us * NS_PER_US;
+    return stamp;
+}
+
+static void Test_Invalid(void)
+{
+    latency_stamp_t stamp;
+    profiler_summary_t summary;
+
+    LatencyTrace_Init();
+
+    LatencyTrace_ClearStamp(&stamp);
+    TEST_CHECK(stamp.loop == LATENCY_TRACE_NO_LOOP && stamp.sequence == 0);
+    TEST_CHECK(!LatencyTrace_Record(&stamp, LATENCY_STAGE_CONTROL));
+    TEST_CHECK(!LatencyTrace_Record(NULL, LATENCY_STAGE_CONTROL));
+
+    stamp = MakeStamp(0, 0, 100);
+    TEST_CHECK(!LatencyTrace_Record(&stamp, LATENCY_STAGE_CONTROL));
+    stamp = MakeStamp(LATENCY_TRACE_MAX_LOOPS, 1, 100);
+    TEST_CHECK(!LatencyTrace_Record(&stamp, LATENCY_STAGE_CONTROL));
+    stamp = MakeStamp(0, 1, 100);
+    TEST_CHECK(!LatencyTrace_Record(&stamp, LATENCY_STAGE_COUNT));
+
+    TEST_CHECK(!LatencyTrace_GetSummary(LATENCY_TRACE_MAX_LOOPS, LATENCY_STAGE_CONTROL, &summary));
+    TEST_CHECK(!LatencyTrace_GetSummary(0, LATENCY_STAGE_COUNT, &summary));
+    TEST_CHECK(!LatencyTrace_GetSummary(0, LATENCY_STAGE_CONTROL, NULL));
+    TEST_CHECK(LatencyTrace_GetSummary(0, LATENCY_STAGE_CONTROL, &summary));
+    TEST_CHECK(summary.count == 0 && summary.min_us == 0.0f && summary.max_us == 0.0f);
+    TEST_CHECK(strcmp(summary.name, "control") == 0);
+}
+
+static void Test_FirstArrivalOnly(void)
+{
+    latency_stamp_t stamp;
+    profiler_summary_t summary;
+    uint32_t recorded = 0;
+
+    LatencyTrace_Init();
+
+    // 周期调度: 同一样本被计算和下发10次, 每阶段只记录一次
+    stamp = MakeStamp(3, 41, 2000);
+    for (int n = 0; n < 10; n++) {
+        recorded += LatencyTrace_Record(&stamp, LATENCY_STAGE_CONTROL) ? 1 : 0;
+    }
+    TEST_CHECK(recorded == 1);
+    TEST_CHECK(LatencyTrace_Record(&stamp, LATENCY_STAGE_OUTPUT));
+    TEST_CHECK(!LatencyTrace_Record(&stamp, LATENCY_STAGE_OUTPUT));
+
+    // 其他回路相同序号独立记录; 新样本再次记录
+    stamp.loop = 4;
+    TEST_CHECK(LatencyTrace_Record(&stamp, LATENCY_STAGE_CONTROL));
+    stamp = MakeStamp(3, 42, 2000);
+    TEST_CHECK(LatencyTrace_Record(&stamp, LATENCY_STAGE_CONTROL));
+
+    LatencyTrace_GetSummary(3, LATENCY_STAGE_CONTROL, &summary);
+    TEST_CHECK(summary.count == 2);
+    LatencyTrace_GetSummary(3, LATENCY_STAGE_OUTPUT, &summary);
+    TEST_CHECK(summary.count == 1);
+    TEST_CHECK(strcmp(summary.name, "output") == 0);
+    LatencyTrace_GetSummary(4, LATENCY_STAGE_CONTROL, &summary);
+    TEST_CHECK(summary.count == 1);
+
+    // 复位后同一样本重新计数
+    LatencyTrace_Reset();
+    LatencyTrace_GetSummary(3, LATENCY_STAGE_CONTROL, &summary);
+    TEST_CHECK(summary.count == 0);
+    TEST_CHECK(LatencyTrace_Record(&stamp, LATENCY_STAGE_CONTROL));
+}
+
+static void Test_Statistics(void)
+{
+    const uint32_t ages_us[] = { 800, 5000, 12000, 3000 };
+    latency_stamp_t stamp;
+    profiler_summary_t summary;
+    uint32_t hist_total = 0;
+
+    LatencyTrace_Init();
+
+    for (uint32_t n = 0; n < sizeof(ages_us) / sizeof(ages_us[0]); n++) {
+        stamp = MakeStamp(7, n + 1, ages_us[n]);
+        TEST_CHECK(LatencyTrace_Record(&stamp, LATENCY_STAGE_OUTPUT));
+    }
+
+    // 记录发生在标记生成之后, 延迟只会偏大且偏差远小于1ms
+    LatencyTrace_GetSummary(7, LATENCY_STAGE_OUTPUT, &summary);
+    TEST_CHECK(summary.count == 4);
+    TEST_CHECK(summary.min_us >= 800.0f && summary.min_us < 1800.0f);
+    TEST_CHECK(summary.max_us >= 12000.0f && summary.max_us < 13000.0f);
+    TEST_CHECK(summary.mean_us >= 5200.0f && summary.mean_us < 6200.0f);
+
+    for (uint8_t i = 0; i < PROFILER_HIST_BINS; i++) {
+        hist_total += summary.hist[i];
+    }
+    TEST_CHECK(hist_total == 4);
+    TEST_CHECK(summary.hist[Profiler_HistBin(12000)] >= 1);
+    TEST_CHECK(summary.hist[Profiler_HistBin(5000)] >= 1);
+}
+
+int main(void)
+{
+    Test_Invalid();
+    Test_FirstArrivalOnly();
+    Test_Statistics();
+
+    return TEST_RESULT();
+}
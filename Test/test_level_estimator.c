@@ -0,0 +1,514 @@
+/**
+ ******************************************************************************
+ * @file    test_level_estimator.c
+ * @brief   墨水液位卡尔曼估计器主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 配置检查, 未初始化状态, 由模拟液位/开关翻转初始化
+ * - 手工展开的预测/更新与双精度矩阵形式 (P=F·P·F'+Q, K=P·H'/S, P=(I-K·H)·P)
+ *   逐步比较, 覆盖随机步长和泵驱动量
+ * - 新息门限剔除, 连续剔除后按测量值重新初始化, 开关翻转/矛盾时拉回开关高度
+ * - 误差方差对比: 模拟墨盒 (泵增益偏差10%, 未建模供墨消耗及其阶跃,
+ *   液面晃动噪声σ=2mm和1%气泡尖峰, 开关在动作高度附近抖动),
+ *   比较原始值, 现有滤波链 (中值5 + 1Hz二阶低通), 只用模拟液位的估计器,
+ *   融合泵和开关的估计器的液位/流量误差
+ ******************************************************************************
+ */
+
+#include "level_estimator.h"
+#include "sensor_filter.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_S            0.05    // 模拟液位采样周期 (20Hz)
+#define LEVEL_NOISE         2.0     // 液面晃动噪声σ (mm)
+#define SPIKE_RATE          0.01    // 气泡尖峰比例
+#define SPIKE_HEIGHT        25.0    // 气泡尖峰幅值 (mm)
+#define SWITCH_JITTER       0.3     // 开关动作高度抖动σ (mm)
+#define WARMUP_S            10.0    // 误差统计前的收敛时间
+#define FLOW_DIFF_SAMPLES   20      // 滤波链流量: 1s差分
+
+static float RandomUniform(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+// Box-Muller
+static double RandomGauss(double sigma)
+{
+    double u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+    double u2 = (double)rand() / (double)RAND_MAX;
+
+    return sigma * sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+/* ========================================================================== */
+/* 配置与初始化 */
+/* ========================================================================== */
+
+static void Test_Config(void)
+{
+    level_estimator_config_t config;
+    level_estimator_config_t bad;
+    level_estimator_t est;
+    level_estimate_t estimate;
+    const float pump[LEVEL_ESTIMATOR_PUMP_COUNT] = { 50.0f, 0.0f, 100.0f, 0.0f };
+
+    LevelEstimator_DefaultConfig(&config);
+    TEST_CHECK(LevelEstimator_CheckConfig(&config));
+    TEST_CHECK(!LevelEstimator_CheckConfig(NULL));
+
+    bad = config;
+    bad.level_noise = 0.0f;
+    TEST_CHECK(!LevelEstimator_CheckConfig(&bad));
+    bad = config;
+    bad.flow_noise = NAN;
+    TEST_CHECK(!LevelEstimator_CheckConfig(&bad));
+    bad = config;
+    bad.switch_noise = -1.0f;
+    TEST_CHECK(!LevelEstimator_CheckConfig(&bad));
+    bad = config;
+    bad.switch_height[1] = bad.switch_height[0];
+    TEST_CHECK(!LevelEstimator_CheckConfig(&bad));
+    bad = config;
+    bad.pump_gain[3] = INFINITY;
+    TEST_CHECK(!LevelEstimator_CheckConfig(&bad));
+
+    // 不参与的开关不影响递增检查
+    bad = config;
+    bad.switch_height[1] = -1.0f;
+    bad.switch_height[2] = 20.0f;
+    TEST_CHECK(LevelEstimator_CheckConfig(&bad));
+
+    // 未初始化: 预测只记录泵流量, 结果无效
+    config.pump_gain[0] = 0.4f;
+    config.pump_gain[2] = -0.3f;
+    LevelEstimator_Init(&est, &config);
+    LevelEstimator_Predict(&est, pump, 0.05f);
+    TEST_CHECK_NEAR(est.inflow, 0.4 * 0.5 - 0.3, 1e-6);
+    LevelEstimator_GetEstimate(&est, &estimate);
+    TEST_CHECK(!estimate.valid && estimate.level == 0.0f);
+
+    // 开关首次读取只记录状态, 翻转时按开关高度初始化
+    LevelEstimator_UpdateSwitch(&est, 1, true);
+    TEST_CHECK(!est.initialized);
+    LevelEstimator_UpdateSwitch(&est, 1, false);
+    LevelEstimator_GetEstimate(&est, &estimate);
+    TEST_CHECK(estimate.valid);
+    TEST_CHECK_NEAR(estimate.level, 50.0, 1e-6);
+    TEST_CHECK_NEAR(estimate.level_std, config.switch_noise, 1e-6);
+    TEST_CHECK_NEAR(estimate.flow_std, LEVEL_ESTIMATOR_INIT_FLOW_STD, 1e-6);
+    TEST_CHECK_NEAR(estimate.flow, est.inflow, 1e-6);
+
+    // 第一个模拟液位样本初始化; 非有限值不采用
+    LevelEstimator_Init(&est, NULL);
+    TEST_CHECK(!LevelEstimator_UpdateLevel(&est, NAN));
+    TEST_CHECK(!est.initialized);
+    TEST_CHECK(LevelEstimator_UpdateLevel(&est, 42.0f));
+    LevelEstimator_GetEstimate(&est, &estimate);
+    TEST_CHECK(estimate.valid);
+    TEST_CHECK_NEAR(estimate.level, 42.0, 1e-6);
+    TEST_CHECK_NEAR(estimate.level_std, est.config.level_noise, 1e-6);
+
+    // 空指针, 非正步长, 越界开关
+    LevelEstimator_Init(NULL, NULL);
+    LevelEstimator_Predict(NULL, pump, 0.05f);
+    LevelEstimator_Predict(&est, pump, 0.0f);
+    LevelEstimator_Predict(&est, pump, -1.0f);
+    TEST_CHECK_NEAR(est.level, 42.0, 1e-6);
+    TEST_CHECK(!LevelEstimator_UpdateLevel(NULL, 1.0f));
+    LevelEstimator_UpdateSwitch(&est, LEVEL_ESTIMATOR_SWITCH_COUNT, true);
+    LevelEstimator_GetEstimate(NULL, &estimate);
+    TEST_CHECK(!estimate.valid);
+}
+
+/* ========================================================================== */
+/* 与矩阵形式对照 */
+/* ========================================================================== */
+
+typedef struct {
+    double x[2];
+    double p[2][2];
+} kalman_ref_t;
+
+static void Ref_Predict(kalman_ref_t *ref, double inflow, double dt, double q)
+{
+    const double f[2][2] = { { 1.0, dt }, { 0.0, 1.0 } };
+    const double qm[2][2] = { { q * dt * dt * dt / 3.0, q * dt * dt / 2.0 }, { q * dt * dt / 2.0, q * dt } };
+    double fp[2][2];
+
+    ref->x[0] += (inflow + ref->x[1]) * dt;
+
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            fp[i][j] = f[i][0] * ref->p[0][j] + f[i][1] * ref->p[1][j];
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            ref->p[i][j] = fp[i][0] * f[j][0] + fp[i][1] * f[j][1] + qm[i][j];
+        }
+    }
+}
+
+static void Ref_Update(kalman_ref_t *ref, double z, double r)
+{
+    double s = ref->p[0][0] + r;
+    double k[2] = { ref->p[0][0] / s, ref->p[1][0] / s };
+    double innovation = z - ref->x[0];
+    double p[2][2];
+
+    ref->x[0] += k[0] * innovation;
+    ref->x[1] += k[1] * innovation;
+
+    // (I - K·H)·P
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 2; j++) {
+            p[i][j] = ref->p[i][j] - k[i] * ref->p[0][j];
+        }
+    }
+    memcpy(ref->p, p, sizeof(p));
+}
+
+static void Test_MatrixReference(void)
+{
+    level_estimator_config_t config;
+    level_estimator_t est;
+    kalman_ref_t ref;
+    double level = 40.0;
+    double max_level = 0.0;
+    double max_std = 0.0;
+
+    srand(7);
+    LevelEstimator_DefaultConfig(&config);
+    config.level_noise = 2.0f;
+    config.flow_noise = 0.02f;
+    config.pump_gain[0] = 0.5f;
+    config.pump_gain[1] = 0.25f;
+    config.pump_gain[2] = -0.3f;
+    for (uint8_t i = 0; i < LEVEL_ESTIMATOR_SWITCH_COUNT; i++) {
+        config.switch_height[i] = -1.0f;
+    }
+
+    LevelEstimator_Init(&est, &config);
+    TEST_CHECK(LevelEstimator_UpdateLevel(&est, (float)level));
+    memset(&ref, 0, sizeof(ref));
+    ref.x[0] = level;
+    ref.p[0][0] = config.level_noise * config.level_noise;
+    ref.p[1][1] = LEVEL_ESTIMATOR_INIT_FLOW_STD * LEVEL_ESTIMATOR_INIT_FLOW_STD;
+
+    for (int n = 0; n < 5000; n++) {
+        float pump[LEVEL_ESTIMATOR_PUMP_COUNT];
+        float dt = RandomUniform(0.02f, 0.2f);
+        double inflow = 0.0;
+        level_estimate_t estimate;
+        float z;
+
+        for (uint8_t i = 0; i < LEVEL_ESTIMATOR_PUMP_COUNT; i++) {
+            pump[i] = RandomUniform(0.0f, 100.0f);
+            inflow += (double)config.pump_gain[i] * pump[i] * 0.01;
+        }
+        level += (inflow - 0.05) * dt;
+        z = (float)(level + RandomGauss(config.level_noise));
+
+        LevelEstimator_Predict(&est, pump, dt);
+        Ref_Predict(&ref, inflow, dt, (double)config.flow_noise * config.flow_noise);
+        TEST_CHECK(LevelEstimator_UpdateLevel(&est, z));
+        Ref_Update(&ref, z, (double)config.level_noise * config.level_noise);
+
+        LevelEstimator_GetEstimate(&est, &estimate);
+        TEST_CHECK_NEAR(estimate.level, ref.x[0], 1e-3);
+        TEST_CHECK_NEAR(estimate.flow, inflow + ref.x[1], 1e-4);
+        TEST_CHECK_NEAR(estimate.level_std, sqrt(ref.p[0][0]), 1e-4 * sqrt(ref.p[0][0]));
+        TEST_CHECK_NEAR(estimate.flow_std, sqrt(ref.p[1][1]), 1e-3 * sqrt(ref.p[1][1]));
+        TEST_CHECK_NEAR(est.p01, ref.p[0][1], 1e-3 * fabs(ref.p[0][1]) + 1e-9);
+        max_level = fmax(max_level, fabs(estimate.level - ref.x[0]));
+        max_std = fmax(max_std, fabs(estimate.level_std - sqrt(ref.p[0][0])) / sqrt(ref.p[0][0]));
+    }
+
+    printf("matrix reference: max level error %.2e mm, max level std rel error %.2e\n", max_level, max_std);
+    TEST_CHECK(est.rejected_total == 0);
+}
+
+/* ========================================================================== */
+/* 门限剔除与开关修正 */
+/* ========================================================================== */
+
+static void Test_GateAndSwitches(void)
+{
+    level_estimator_t est;
+    level_estimate_t estimate;
+    float level_std;
+
+    LevelEstimator_Init(&est, NULL);
+    LevelEstimator_UpdateLevel(&est, 40.0f);
+    for (int n = 0; n < 200; n++) {
+        LevelEstimator_Predict(&est, NULL, 0.05f);
+        TEST_CHECK(LevelEstimator_UpdateLevel(&est, 40.0f));
+    }
+    LevelEstimator_GetEstimate(&est, &estimate);
+    TEST_CHECK(estimate.level_std < est.config.level_noise);
+
+    // 单个尖峰被剔除, 状态不变; 随后的正常样本清零连续计数
+    level_std = estimate.level_std;
+    LevelEstimator_Predict(&est, NULL, 0.05f);
+    TEST_CHECK(!LevelEstimator_UpdateLevel(&est, 70.0f));
+    TEST_CHECK(est.rejects == 1 && est.rejected_total == 1);
+    TEST_CHECK_NEAR(est.level, 40.0, 1e-3);
+    TEST_CHECK(LevelEstimator_UpdateLevel(&est, 40.0f));
+    TEST_CHECK(est.rejects == 0 && est.rejected_total == 1);
+
+    // 持续失配 (未建模补液): 剔除MAX_REJECTS次后按测量值重新初始化
+    for (int n = 0; n < LEVEL_ESTIMATOR_MAX_REJECTS; n++) {
+        LevelEstimator_Predict(&est, NULL, 0.05f);
+        TEST_CHECK(!LevelEstimator_UpdateLevel(&est, 70.0f));
+    }
+    TEST_CHECK_NEAR(est.level, 40.0, 0.1);
+    LevelEstimator_Predict(&est, NULL, 0.05f);
+    TEST_CHECK(LevelEstimator_UpdateLevel(&est, 70.0f));
+    LevelEstimator_GetEstimate(&est, &estimate);
+    TEST_CHECK_NEAR(estimate.level, 70.0, 1e-6);
+    TEST_CHECK_NEAR(estimate.level_std, est.config.level_noise, 1e-6);
+    TEST_CHECK(est.rejects == 0 && est.rejected_total == 1 + LEVEL_ESTIMATOR_MAX_REJECTS + 1);
+    TEST_CHECK(level_std < estimate.level_std);
+
+    // 开关状态与估计一致: 不修正
+    LevelEstimator_Init(&est, NULL);
+    LevelEstimator_UpdateLevel(&est, 60.0f);
+    LevelEstimator_UpdateSwitch(&est, 1, true);
+    LevelEstimator_UpdateSwitch(&est, 2, false);
+    TEST_CHECK_NEAR(est.level, 60.0, 1e-6);
+
+    // 估计落在开关错误一侧 (50mm开关未动作但估计60mm): 按开关高度修正
+    LevelEstimator_UpdateSwitch(&est, 1, false);
+    TEST_CHECK(est.level < 60.0f && est.level > 50.0f);
+    TEST_CHECK_NEAR(est.level, 60.0 - 10.0 * 1.0 / (1.0 + 1.0), 1e-4);
+    for (int n = 0; n < 50; n++) {
+        LevelEstimator_UpdateSwitch(&est, 1, false);
+    }
+    TEST_CHECK(est.level > 50.0f && est.level < 50.5f);
+
+    // 翻转: 即使估计在正确一侧也拉到开关高度
+    LevelEstimator_Init(&est, NULL);
+    LevelEstimator_UpdateLevel(&est, 48.0f);
+    LevelEstimator_UpdateSwitch(&est, 1, false);
+    TEST_CHECK_NEAR(est.level, 48.0, 1e-6);
+    LevelEstimator_UpdateSwitch(&est, 1, true);
+    TEST_CHECK_NEAR(est.level, 48.0 + 2.0 * 1.0 / (1.0 + 1.0), 1e-4);
+
+    // 更换配置清除边沿记录, 不参与的开关被忽略
+    LevelEstimator_SetConfig(&est, &est.config);
+    TEST_CHECK(est.switch_state[1] == 0xFF);
+    est.config.switch_height[0] = -1.0f;
+    LevelEstimator_UpdateSwitch(&est, 0, false);
+    LevelEstimator_UpdateSwitch(&est, 0, true);
+    TEST_CHECK(est.switch_state[0] == 0xFF);
+}
+
+/* ========================================================================== */
+/* 误差方差对比 */
+/* ========================================================================== */
+
+// 运行阶段: 持续时间, 泵驱动量 (调速泵1补墨, 直流泵1回抽), 未建模供墨消耗
+typedef struct {
+    double duration;
+    float fill;
+    float drain;
+    double consumption;
+} tank_phase_t;
+
+static const tank_phase_t g_phases[] = {
+    { 120.0, 80.0f, 0.0f, 0.10 },
+    { 180.0, 20.0f, 0.0f, 0.10 },
+    { 150.0, 0.0f, 100.0f, 0.10 },
+    { 150.0, 40.0f, 0.0f, 0.20 },      // 消耗阶跃
+    { 200.0, 100.0f, 0.0f, 0.20 },
+    { 200.0, 0.0f, 60.0f, 0.20 },
+    { 200.0, 50.0f, 0.0f, 0.20 },
+};
+
+#define PUMP_FILL_GAIN      0.5f        // 配置的补墨泵增益 (mm/s @100%)
+#define PUMP_DRAIN_GAIN     -0.3f       // 配置的回抽泵增益
+#define PUMP_GAIN_ERROR     1.1         // 实际增益偏大10%
+
+typedef struct {
+    double sum;
+    double sum_sq;
+    uint32_t count;
+} error_stats_t;
+
+static void Stats_Add(error_stats_t *stats, double error)
+{
+    stats->sum += error;
+    stats->sum_sq += error * error;
+    stats->count++;
+}
+
+static double Stats_Rms(const error_stats_t *stats)
+{
+    return sqrt(stats->sum_sq / stats->count);
+}
+
+static double Stats_Variance(const error_stats_t *stats)
+{
+    double mean = stats->sum / stats->count;
+
+    return stats->sum_sq / stats->count - mean * mean;
+}
+
+typedef struct {
+    error_stats_t raw;
+    error_stats_t chain;
+    error_stats_t chain_flow;
+    error_stats_t analog;
+    error_stats_t analog_flow;
+    error_stats_t fused;
+    error_stats_t fused_flow;
+    double nees;                // 融合估计器 (误差/level_std)² 的均值
+    uint32_t rejected;
+    uint32_t spikes;
+} tank_result_t;
+
+static void Run_Tank(tank_result_t *result)
+{
+    level_estimator_config_t config;
+    level_estimator_t analog;
+    level_estimator_t fused;
+    sensor_filter_config_t chain_config;
+    sensor_filter_t chain;
+    float history[FLOW_DIFF_SAMPLES];
+    double level = 30.0;
+    double t = 0.0;
+    double nees_sum = 0.0;
+    uint32_t n = 0;
+
+    srand(11);
+    memset(result, 0, sizeof(tank_result_t));
+
+    // 现有滤波链: 中值5 + 1Hz二阶低通 (Sensor_InitializeFilters中的液位配置)
+    memset(&chain_config, 0, sizeof(chain_config));
+    chain_config.stage_count = 2;
+    chain_config.stages[0].type = SENSOR_FILTER_MEDIAN;
+    chain_config.stages[0].length = 5;
+    chain_config.stages[1].type = SENSOR_FILTER_BIQUAD;
+    chain_config.stages[1].length = 1;
+    TEST_CHECK(SensorFilter_DesignLowpass(1.0f, (float)(1.0 / SAMPLE_S), chain_config.stages[1].coeffs));
+    TEST_CHECK(SensorFilter_Init(&chain, &chain_config));
+
+    // 只用模拟液位: 泵增益为0, 开关不参与
+    LevelEstimator_DefaultConfig(&config);
+    config.level_noise = (float)LEVEL_NOISE;
+    for (uint8_t i = 0; i < LEVEL_ESTIMATOR_SWITCH_COUNT; i++) {
+        config.switch_height[i] = -1.0f;
+    }
+    LevelEstimator_Init(&analog, &config);
+
+    // 融合: 标称泵增益 + 默认开关高度 (15/50/80mm)
+    LevelEstimator_DefaultConfig(&config);
+    config.level_noise = (float)LEVEL_NOISE;
+    config.pump_gain[0] = PUMP_FILL_GAIN;
+    config.pump_gain[2] = PUMP_DRAIN_GAIN;
+    TEST_CHECK(LevelEstimator_CheckConfig(&config));
+    LevelEstimator_Init(&fused, &config);
+
+    for (size_t p = 0; p < sizeof(g_phases) / sizeof(g_phases[0]); p++) {
+        const tank_phase_t *phase = &g_phases[p];
+        const float pump[LEVEL_ESTIMATOR_PUMP_COUNT] = { phase->fill, 0.0f, phase->drain, 0.0f };
+        double flow = PUMP_GAIN_ERROR * (PUMP_FILL_GAIN * phase->fill + PUMP_DRAIN_GAIN * phase->drain) * 0.01 -
+                      phase->consumption;
+        double end = t + phase->duration;
+
+        for (; t < end - 1e-9; t += SAMPLE_S, n++) {
+            level_estimate_t estimate;
+            float measured;
+            float filtered;
+            double error;
+
+            level += flow * SAMPLE_S;
+
+            measured = (float)(level + RandomGauss(LEVEL_NOISE));
+            if ((double)rand() / RAND_MAX < SPIKE_RATE) {
+                measured += (float)SPIKE_HEIGHT;
+                result->spikes++;
+            }
+            filtered = SensorFilter_Process(&chain, measured);
+
+            LevelEstimator_Predict(&analog, NULL, (float)SAMPLE_S);
+            LevelEstimator_UpdateLevel(&analog, measured);
+
+            // 同Sensor_UpdateLevelEstimate: 预测, 开关, 模拟液位
+            LevelEstimator_Predict(&fused, pump, (float)SAMPLE_S);
+            for (uint8_t i = 0; i < LEVEL_ESTIMATOR_SWITCH_COUNT; i++) {
+                LevelEstimator_UpdateSwitch(&fused, i,
+                                            level + RandomGauss(SWITCH_JITTER) > config.switch_height[i]);
+            }
+            LevelEstimator_UpdateLevel(&fused, measured);
+
+            if (t < WARMUP_S) {
+                history[n % FLOW_DIFF_SAMPLES] = filtered;
+                continue;
+            }
+
+            Stats_Add(&result->raw, measured - level);
+            Stats_Add(&result->chain, filtered - level);
+            Stats_Add(&result->chain_flow,
+                      (filtered - history[n % FLOW_DIFF_SAMPLES]) / (FLOW_DIFF_SAMPLES * SAMPLE_S) - flow);
+            history[n % FLOW_DIFF_SAMPLES] = filtered;
+
+            LevelEstimator_GetEstimate(&analog, &estimate);
+            Stats_Add(&result->analog, estimate.level - level);
+            Stats_Add(&result->analog_flow, estimate.flow - flow);
+
+            LevelEstimator_GetEstimate(&fused, &estimate);
+            TEST_CHECK(estimate.valid);
+            error = estimate.level - level;
+            Stats_Add(&result->fused, error);
+            Stats_Add(&result->fused_flow, estimate.flow - flow);
+            nees_sum += (error * error) / ((double)estimate.level_std * estimate.level_std);
+        }
+    }
+
+    result->nees = nees_sum / result->fused.count;
+    result->rejected = fused.rejected_total;
+}
+
+static void Test_ErrorVariance(void)
+{
+    tank_result_t r;
+
+    Run_Tank(&r);
+
+    printf("level error (mm):    raw rms %.3f, median+1Hz lowpass rms %.3f (var %.4f), "
+           "kalman analog rms %.3f (var %.4f), kalman fused rms %.3f (var %.4f)\n",
+           Stats_Rms(&r.raw), Stats_Rms(&r.chain), Stats_Variance(&r.chain),
+           Stats_Rms(&r.analog), Stats_Variance(&r.analog), Stats_Rms(&r.fused), Stats_Variance(&r.fused));
+    printf("flow error (mm/s):   lowpass 1 s difference rms %.3f, kalman analog rms %.4f, kalman fused rms %.4f\n",
+           Stats_Rms(&r.chain_flow), Stats_Rms(&r.analog_flow), Stats_Rms(&r.fused_flow));
+    printf("fused: normalized error %.2f, rejected %u of %u spikes\n", r.nees, r.rejected, r.spikes);
+
+    // 融合估计器: 液位误差方差不到现有滤波链的1/5, 流量误差低一个数量级以上
+    TEST_CHECK(Stats_Variance(&r.fused) < 0.2 * Stats_Variance(&r.chain));
+    TEST_CHECK(Stats_Rms(&r.fused) < Stats_Rms(&r.analog));
+    TEST_CHECK(Stats_Rms(&r.fused_flow) < 0.1 * Stats_Rms(&r.chain_flow));
+    TEST_CHECK(Stats_Rms(&r.fused_flow) < Stats_Rms(&r.analog_flow));
+
+    // 估计的标准差与实际误差相符, 尖峰基本全部剔除
+    TEST_CHECK(r.nees > 0.3 && r.nees < 3.0);
+    TEST_CHECK(r.rejected >= r.spikes * 9 / 10);
+}
+
+int main(void)
+{
+    Test_Config();
+    Test_MatrixReference();
+    Test_GateAndSwitches();
+    Test_ErrorVariance();
+
+    return TEST_RESULT();
+}
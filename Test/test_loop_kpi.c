@@ -0,0 +1,341 @@
+/**
+ ******************************************************************************
+ * @file    test_loop_kpi.c
+ * @brief   控制回路性能指标(KPI)主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 每个样本同时保存在测试中, 以双精度离线重算窗口内(最近summary.samples个样本)
+ * 的IAE/ISE/ITAE/饱和比例/过零次数和最近一次阶跃的超调量/调节时间, 检查:
+ * - 参数检查, 无样本时的结果
+ * - 抖动采样周期下的二阶过程 (周期性设定值阶跃, 饱和, 噪声) 与离线结果一致
+ * - 欠阻尼二阶阶跃响应的超调量与解析值一致, 小于阈值的设定值变化不重新开始
+ * - 振荡指数: 正弦误差按周期计数, 回差内的噪声不计
+ * - 24h运行后窗口指标仍跟随误差变化 (累计平均已不再响应)
+ ******************************************************************************
+ */
+
+#include "loop_kpi.h"
+#include "test_common.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RANGE               100.0f
+#define WINDOW_S            60.0f
+#define MAX_SAMPLES         40000
+
+typedef struct {
+    float setpoint;
+    float error;
+    float dt;
+    bool saturated;
+} sample_t;
+
+static sample_t g_samples[MAX_SAMPLES];
+static uint32_t g_count;
+
+// 同时送入KPI和样本记录
+static void Feed(loop_kpi_t *kpi, float setpoint, float process_value, float dt, bool saturated)
+{
+    if (g_count < MAX_SAMPLES) {
+        g_samples[g_count].setpoint = setpoint;
+        g_samples[g_count].error = setpoint - process_value;
+        g_samples[g_count].dt = dt;
+        g_samples[g_count].saturated = saturated;
+        g_count++;
+    }
+    LoopKpi_Update(kpi, setpoint, process_value, dt, saturated);
+}
+
+/* ========================================================================== */
+/* 离线参考 */
+/* ========================================================================== */
+
+typedef struct {
+    double window_time;
+    double iae;
+    double ise;
+    double itae;
+    double saturated_time;
+    uint32_t crossings;
+    double overshoot;
+    double settling_time;
+    bool step_active;
+} reference_t;
+
+// 窗口为最近window_samples个样本, 过零状态和阶跃从全部历史重放
+static void Reference(uint32_t window_samples, reference_t *ref)
+{
+    const double band = LOOP_KPI_CROSSING_BAND * RANGE;
+    const double threshold = LOOP_KPI_STEP_THRESHOLD * RANGE;
+    uint32_t first = g_count - window_samples;
+    double t = 0.0;
+    double step_size = 0.0, direction = 1.0, peak = 0.0, elapsed = 0.0;
+    int sign_state = 0;
+
+    memset(ref, 0, sizeof(reference_t));
+
+    for (uint32_t k = 0; k < g_count; k++) {
+        const sample_t *s = &g_samples[k];
+        double e = s->error;
+        int sign = (e > band) ? 1 : ((e < -band) ? -1 : 0);
+
+        if (k == 0 || fabs(s->setpoint - g_samples[k - 1].setpoint) > threshold) {
+            ref->step_active = fabs(e) > threshold;
+            step_size = fabs(e);
+            direction = (e >= 0.0) ? 1.0 : -1.0;
+            peak = 0.0;
+            elapsed = 0.0;
+            ref->settling_time = 0.0;
+        }
+        if (ref->step_active) {
+            elapsed += s->dt;
+            peak = fmax(peak, -direction * e);
+            if (fabs(e) > LOOP_KPI_SETTLING_BAND * step_size) {
+                ref->settling_time = elapsed;
+            }
+            ref->overshoot = peak / step_size * 100.0;
+        }
+
+        if (sign != 0) {
+            if (sign_state != 0 && sign != sign_state && k >= first) {
+                ref->crossings++;
+            }
+            sign_state = sign;
+        }
+
+        if (k >= first) {
+            t += s->dt;
+            ref->window_time += s->dt;
+            ref->iae += fabs(e) * s->dt;
+            ref->ise += e * e * s->dt;
+            ref->itae += t * fabs(e) * s->dt;
+            ref->saturated_time += s->saturated ? s->dt : 0.0;
+        }
+    }
+}
+
+/* ========================================================================== */
+/* 测试 */
+/* ========================================================================== */
+
+static void Test_Params(void)
+{
+    loop_kpi_t kpi;
+    loop_kpi_summary_t summary;
+
+    LoopKpi_Init(NULL, RANGE, WINDOW_S);
+    LoopKpi_Update(NULL, 1.0f, 0.0f, 0.02f, false);
+    TEST_CHECK(!LoopKpi_GetSummary(NULL, &summary));
+    TEST_CHECK(!LoopKpi_GetSummary(&kpi, NULL));
+    TEST_CHECK(LoopKpi_GetMeanAbsError(NULL) == 0.0f);
+
+    // 量程/窗口非正时取1
+    LoopKpi_Init(&kpi, -5.0f, 0.0f);
+    TEST_CHECK_NEAR(kpi.bucket_time, 1.0f / LOOP_KPI_BUCKETS, 1e-9);
+    TEST_CHECK_NEAR(kpi.step_threshold, LOOP_KPI_STEP_THRESHOLD, 1e-9);
+
+    // 无样本: 返回false, 结果清零且视为已稳定
+    LoopKpi_Init(&kpi, RANGE, WINDOW_S);
+    TEST_CHECK(!LoopKpi_GetSummary(&kpi, &summary));
+    TEST_CHECK(summary.samples == 0 && summary.iae == 0.0f && summary.settled);
+
+    // 非正采样时间和NaN不计入
+    LoopKpi_Update(&kpi, 50.0f, 40.0f, 0.0f, false);
+    LoopKpi_Update(&kpi, 50.0f, 40.0f, -0.02f, false);
+    LoopKpi_Update(&kpi, NAN, 40.0f, 0.02f, false);
+    LoopKpi_Update(&kpi, 50.0f, NAN, 0.02f, false);
+    TEST_CHECK(!LoopKpi_GetSummary(&kpi, &summary));
+
+    LoopKpi_Update(&kpi, 50.0f, 40.0f, 0.5f, true);
+    TEST_CHECK(LoopKpi_GetSummary(&kpi, &summary));
+    TEST_CHECK(summary.samples == 1);
+    TEST_CHECK_NEAR(summary.iae, 5.0, 1e-6);
+    TEST_CHECK_NEAR(summary.ise, 50.0, 1e-5);
+    TEST_CHECK_NEAR(summary.itae, 2.5, 1e-6);
+    TEST_CHECK_NEAR(summary.mean_abs_error, 10.0, 1e-5);
+    TEST_CHECK_NEAR(summary.saturation, 1.0, 1e-6);
+    TEST_CHECK(summary.step_count == 1 && !summary.settled);
+
+    // 复位保留配置
+    LoopKpi_Reset(&kpi);
+    TEST_CHECK(!LoopKpi_GetSummary(&kpi, &summary));
+    TEST_CHECK_NEAR(kpi.bucket_time, WINDOW_S / LOOP_KPI_BUCKETS, 1e-6);
+}
+
+// 二阶过程 (wn=1.5 rad/s, zeta=0.35) 跟随设定值, 40 s交替阶跃50/60,
+// 采样周期20ms±5ms, 测量噪声±0.05, |e|>3时输出饱和
+static void Test_OfflineReference(void)
+{
+    loop_kpi_t kpi;
+    loop_kpi_summary_t summary;
+    reference_t ref;
+    double x = 50.0, v = 0.0, time = 0.0;
+    double max_rel = 0.0;
+    uint32_t checks = 0;
+
+    srand(5);
+    g_count = 0;
+    LoopKpi_Init(&kpi, RANGE, WINDOW_S);
+
+    while (g_count < MAX_SAMPLES) {
+        float dt = 0.02f + 0.005f * (2.0f * (float)rand() / RAND_MAX - 1.0f);
+        float setpoint = (((uint32_t)(time / 40.0)) & 1) ? 60.0f : 50.0f;
+        float noise = 0.05f * (2.0f * (float)rand() / RAND_MAX - 1.0f);
+        float pv;
+
+        // 半隐式欧拉: x'' = wn²(sp - x) - 2·zeta·wn·x'
+        v += dt * (1.5 * 1.5 * (setpoint - x) - 2.0 * 0.35 * 1.5 * v);
+        x += dt * v;
+        time += dt;
+        pv = (float)x + noise;
+
+        Feed(&kpi, setpoint, pv, dt, fabsf(setpoint - pv) > 3.0f);
+
+        if ((g_count % 250) != 0) {
+            continue;
+        }
+
+        LoopKpi_GetSummary(&kpi, &summary);
+        Reference(summary.samples, &ref);
+        checks++;
+
+        // 窗口为整桶: (N-1)/N到1倍窗口时长, 每桶另可多出不到一个采样周期
+        TEST_CHECK(summary.window_time >= WINDOW_S * (LOOP_KPI_BUCKETS - 1) / LOOP_KPI_BUCKETS ||
+                   time < WINDOW_S);
+        TEST_CHECK(summary.window_time <= WINDOW_S + LOOP_KPI_BUCKETS * 0.025f);
+
+        TEST_CHECK_NEAR(summary.window_time, ref.window_time, 1e-4 * ref.window_time + 1e-4);
+        TEST_CHECK_NEAR(summary.iae, ref.iae, 1e-3 * ref.iae + 1e-4);
+        TEST_CHECK_NEAR(summary.ise, ref.ise, 1e-3 * ref.ise + 1e-4);
+        TEST_CHECK_NEAR(summary.itae, ref.itae, 1e-3 * ref.itae + 1e-3);
+        TEST_CHECK_NEAR(summary.saturation, ref.saturated_time / ref.window_time, 1e-4);
+        TEST_CHECK(summary.oscillation_index == ref.crossings * 0.5f);
+        TEST_CHECK(kpi.step_active == ref.step_active);
+        TEST_CHECK_NEAR(summary.overshoot, ref.overshoot, 1e-3);
+        TEST_CHECK_NEAR(summary.settling_time, ref.settling_time, 1e-3);
+
+        max_rel = fmax(max_rel, fabs(summary.itae - ref.itae) / ref.itae);
+    }
+
+    printf("offline: %lu windows checked, ITAE max rel error %.2e, last overshoot %.1f %%, settling %.2f s\n",
+           (unsigned long)checks, max_rel, summary.overshoot, summary.settling_time);
+    TEST_CHECK(summary.step_count == (uint32_t)(time / 40.0));
+    TEST_CHECK(summary.saturation > 0.0f && summary.saturation < 0.5f);
+    TEST_CHECK(summary.oscillation_index > 0.0f);
+}
+
+// 无噪声欠阻尼阶跃: 超调量接近解析值 exp(-π·zeta/√(1-zeta²))
+static void Test_StepResponse(void)
+{
+    const double zeta = 0.3, wn = 2.0;
+    const double analytic = 100.0 * exp(-M_PI * zeta / sqrt(1.0 - zeta * zeta));
+    loop_kpi_t kpi;
+    loop_kpi_summary_t summary;
+    double x = 20.0, v = 0.0;
+
+    LoopKpi_Init(&kpi, RANGE, WINDOW_S);
+    g_count = 0;
+
+    // 稳态, 阶跃前无有效阶跃
+    for (int n = 0; n < 100; n++) {
+        Feed(&kpi, 20.0f, 20.0f, 0.001f, false);
+    }
+    LoopKpi_GetSummary(&kpi, &summary);
+    TEST_CHECK(summary.step_count == 0 && summary.overshoot == 0.0f && summary.settled);
+
+    // 阶跃到40 (1 ms积分步长, 10 s)
+    for (int n = 0; n < 10000; n++) {
+        v += 0.001 * (wn * wn * (40.0 - x) - 2.0 * zeta * wn * v);
+        x += 0.001 * v;
+        Feed(&kpi, 40.0f, (float)x, 0.001f, false);
+    }
+    LoopKpi_GetSummary(&kpi, &summary);
+    printf("step: overshoot %.2f %% (analytic %.2f %%), settling %.3f s (4/(zeta*wn) %.3f s)\n",
+           summary.overshoot, analytic, summary.settling_time, 4.0 / (zeta * wn));
+    TEST_CHECK(summary.step_count == 1);
+    TEST_CHECK_NEAR(summary.overshoot, analytic, 0.5);
+    TEST_CHECK(summary.settled);
+    TEST_CHECK(summary.settling_time > 0.5 * 4.0 / (zeta * wn) && summary.settling_time < 1.2 * 4.0 / (zeta * wn));
+
+    // 小于阈值的设定值变化 (0.5 < 1.0) 不重新开始阶跃评估
+    Feed(&kpi, 40.5f, (float)x, 0.001f, false);
+    LoopKpi_GetSummary(&kpi, &summary);
+    TEST_CHECK(summary.step_count == 1);
+    TEST_CHECK_NEAR(summary.overshoot, analytic, 0.5);
+
+    // 设定值阶跃但过程值已接近 (|e|不大于阈值): 不评估响应
+    Feed(&kpi, 43.0f, 42.5f, 0.001f, false);
+    LoopKpi_GetSummary(&kpi, &summary);
+    TEST_CHECK(summary.step_count == 1);
+    TEST_CHECK(summary.overshoot == 0.0f && summary.settling_time == 0.0f && summary.settled);
+}
+
+// 正弦误差: 幅值超过回差时每周期2次过零; 回差内的噪声不计
+static void Test_Oscillation(void)
+{
+    loop_kpi_t kpi;
+    loop_kpi_summary_t summary;
+
+    LoopKpi_Init(&kpi, RANGE, WINDOW_S);
+    for (int n = 0; n < 20000; n++) {
+        float t = n * 0.02f;
+        LoopKpi_Update(&kpi, 50.0f, 50.0f + 2.0f * sinf(6.2831853f * 0.25f * t + 0.3f), 0.02f, false);
+    }
+    LoopKpi_GetSummary(&kpi, &summary);
+    // 0.25 Hz: 窗口内约0.25×窗口时长个周期
+    TEST_CHECK_NEAR(summary.oscillation_index, 0.25f * summary.window_time, 1.0);
+
+    LoopKpi_Init(&kpi, RANGE, WINDOW_S);
+    srand(3);
+    for (int n = 0; n < 20000; n++) {
+        float noise = 0.4f * (2.0f * (float)rand() / RAND_MAX - 1.0f);
+        LoopKpi_Update(&kpi, 50.0f, 50.0f + noise, 0.02f, false);
+    }
+    LoopKpi_GetSummary(&kpi, &summary);
+    TEST_CHECK(summary.oscillation_index == 0.0f);
+}
+
+// 24 h @ 20 ms: 误差由1.0变为0.5, 窗口平均绝对误差一个窗口内跟随, 累计平均仍接近1.0
+static void Test_LongRun(void)
+{
+    const uint32_t day = 24U * 3600U * 50U;
+    const uint32_t window = (uint32_t)(WINDOW_S * 50.0f);
+    loop_kpi_t kpi;
+    loop_kpi_summary_t summary;
+    double cumulative = 0.0;
+    uint32_t n;
+
+    LoopKpi_Init(&kpi, RANGE, WINDOW_S);
+    for (n = 0; n < day; n++) {
+        LoopKpi_Update(&kpi, 50.0f, 49.0f, 0.02f, false);
+        cumulative += 1.0;
+    }
+    TEST_CHECK_NEAR(LoopKpi_GetMeanAbsError(&kpi), 1.0, 1e-4);
+
+    for (; n < day + window; n++) {
+        LoopKpi_Update(&kpi, 50.0f, 49.5f, 0.02f, false);
+        cumulative += 0.5;
+    }
+    LoopKpi_GetSummary(&kpi, &summary);
+    printf("24 h: window mean |e| %.5f, cumulative mean %.5f, window %.2f s\n",
+           summary.mean_abs_error, cumulative / n, summary.window_time);
+    TEST_CHECK_NEAR(summary.mean_abs_error, 0.5, 1e-3);
+    TEST_CHECK_NEAR(summary.iae, 0.5 * summary.window_time, 1e-2);
+    TEST_CHECK_NEAR(summary.itae, 0.5 * summary.window_time * summary.window_time / 2.0, 0.5);
+    TEST_CHECK(cumulative / n > 0.99);
+}
+
+int main(void)
+{
+    Test_Params();
+    Test_OfflineReference();
+    Test_StepResponse();
+    Test_Oscillation();
+    Test_LongRun();
+
+    return TEST_RESULT();
+}
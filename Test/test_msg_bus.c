@@ -0,0 +1,270 @@
+/**
+ ******************************************************************************
+ * @file    test_msg_bus.c
+ * @brief   零拷贝消息总线主机测试和RAM/复制量对比
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 订阅/创建主题并发时只安装一个内存池: 在pvPortMalloc钩子中嵌套调用
+ *   MsgBus_Subscribe, 模拟分配期间被另一个任务抢占
+ * - 发布/接收/释放的引用计数, 队列满和无订阅者的统计
+ * - 与原按值队列(各16个sensor_msg_t/control_msg_t)对比RAM和每条消息的复制量
+ ******************************************************************************
+ */
+
+#include "msg_bus.h"
+#include "control_task_v3.h"
+#include "test_common.h"
+#include <string.h>
+#include <time.h>
+
+#define LEGACY_QUEUE_DEPTH      16          // 原xQueue_SensorMsg/xQueue_ControlMsg深度
+#define BENCH_MESSAGES          100000UL
+
+static msg_bus_topic_t g_nested_topic;
+static msg_bus_subscriber_t *g_nested_sub = NULL;
+static msg_bus_subscriber_t *g_sensor_subs[2];
+static msg_bus_subscriber_t *g_control_subs[2];
+
+// 第一次分配时让"另一个任务"订阅同一主题, 之后不再嵌套
+static void NestedSubscribeHook(size_t size)
+{
+    (void)size;
+    stub_malloc_hook = NULL;
+    g_nested_sub = MsgBus_Subscribe(g_nested_topic, 4);
+}
+
+static uint32_t LivePools(void)
+{
+    return stub_malloc_count - stub_free_count;
+}
+
+static double NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief 主题已创建, 两个订阅者同时分配内存池
+ */
+static void Test_SubscribeRace(void)
+{
+    msg_bus_topic_stats_t stats;
+
+    TEST_CHECK(MsgBus_CreateTopic(MSG_BUS_TOPIC_SENSOR_DATA, sizeof(sensor_msg_t), SENSOR_MSG_POOL_BLOCKS) == pdPASS);
+    TEST_CHECK(MsgBus_CreateTopic(MSG_BUS_TOPIC_SENSOR_DATA, sizeof(sensor_msg_t), SENSOR_MSG_POOL_BLOCKS) == pdFAIL);
+    TEST_CHECK(LivePools() == 0);
+
+    // 无订阅者: 不分配, 不复制
+    TEST_CHECK(MsgBus_Alloc(MSG_BUS_TOPIC_SENSOR_DATA) == NULL);
+
+    g_nested_topic = MSG_BUS_TOPIC_SENSOR_DATA;
+    g_nested_sub = NULL;
+    stub_malloc_hook = NestedSubscribeHook;
+    g_sensor_subs[0] = MsgBus_Subscribe(MSG_BUS_TOPIC_SENSOR_DATA, 4);
+    g_sensor_subs[1] = g_nested_sub;
+
+    TEST_CHECK(g_sensor_subs[0] != NULL && g_sensor_subs[1] != NULL && g_sensor_subs[0] != g_sensor_subs[1]);
+    TEST_CHECK(stub_malloc_count == 2);
+    TEST_CHECK(LivePools() == 1);
+
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_SENSOR_DATA, &stats);
+    TEST_CHECK(stats.subscriber_count == 2);
+    TEST_CHECK(stats.skipped == 1);
+    TEST_CHECK(stats.pool_bytes >= (uint32_t)sizeof(sensor_msg_t) * SENSOR_MSG_POOL_BLOCKS);
+}
+
+/**
+ * @brief 已有订阅者时创建主题, 创建者与新订阅者同时分配内存池
+ */
+static void Test_CreateRace(void)
+{
+    msg_bus_topic_stats_t stats;
+    uint32_t base = LivePools();
+
+    // 主题未创建时订阅不分配内存池
+    g_control_subs[0] = MsgBus_Subscribe(MSG_BUS_TOPIC_CONTROL_STATUS, 2);
+    TEST_CHECK(g_control_subs[0] != NULL);
+    TEST_CHECK(LivePools() == base);
+
+    g_nested_topic = MSG_BUS_TOPIC_CONTROL_STATUS;
+    g_nested_sub = NULL;
+    stub_malloc_hook = NestedSubscribeHook;
+    TEST_CHECK(MsgBus_CreateTopic(MSG_BUS_TOPIC_CONTROL_STATUS, sizeof(control_msg_t), CONTROL_MSG_POOL_BLOCKS) == pdPASS);
+    g_control_subs[1] = g_nested_sub;
+
+    TEST_CHECK(g_control_subs[1] != NULL);
+    TEST_CHECK(LivePools() == base + 1);
+
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_CONTROL_STATUS, &stats);
+    TEST_CHECK(stats.subscriber_count == 2);
+    TEST_CHECK(stats.pool_bytes >= (uint32_t)sizeof(control_msg_t) * CONTROL_MSG_POOL_BLOCKS);
+}
+
+/**
+ * @brief 引用计数: 每个订阅者收到同一个块, 最后一个释放者归还; 队列满时丢弃
+ */
+static void Test_PublishReceive(void)
+{
+    msg_bus_topic_stats_t stats;
+    sensor_msg_t *msg;
+    const sensor_msg_t *rx[2];
+    void *held[SENSOR_MSG_POOL_BLOCKS];
+
+    msg = (sensor_msg_t *)MsgBus_Alloc(MSG_BUS_TOPIC_SENSOR_DATA);
+    TEST_CHECK(msg != NULL);
+    if (msg == NULL) {
+        return;
+    }
+    msg->type = MSG_SENSOR_DATA;
+    msg->timestamp = 1234;
+    MsgBus_Publish(msg);
+
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_SENSOR_DATA, &stats);
+    TEST_CHECK(stats.published == 2 && stats.blocks_in_use == 1);
+
+    // 零拷贝: 两个订阅者拿到的是同一个块
+    rx[0] = (const sensor_msg_t *)MsgBus_Receive(g_sensor_subs[0], 0);
+    rx[1] = (const sensor_msg_t *)MsgBus_Receive(g_sensor_subs[1], 0);
+    TEST_CHECK(rx[0] == msg && rx[1] == msg && rx[0]->timestamp == 1234);
+
+    MsgBus_Release(rx[0]);
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_SENSOR_DATA, &stats);
+    TEST_CHECK(stats.blocks_in_use == 1);
+    MsgBus_Release(rx[1]);
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_SENSOR_DATA, &stats);
+    TEST_CHECK(stats.blocks_in_use == 0);
+
+    // 内存块耗尽
+    for (int i = 0; i < SENSOR_MSG_POOL_BLOCKS; i++) {
+        held[i] = MsgBus_Alloc(MSG_BUS_TOPIC_SENSOR_DATA);
+        TEST_CHECK(held[i] != NULL);
+    }
+    TEST_CHECK(MsgBus_Alloc(MSG_BUS_TOPIC_SENSOR_DATA) == NULL);
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_SENSOR_DATA, &stats);
+    TEST_CHECK(stats.alloc_failures == 1 && stats.blocks_peak == SENSOR_MSG_POOL_BLOCKS);
+    for (int i = 0; i < SENSOR_MSG_POOL_BLOCKS; i++) {
+        MsgBus_Discard(held[i]);
+    }
+
+    // 订阅者队列满: 控制主题订阅者0深度2且不取, 订阅者1及时取走并释放
+    for (uint32_t n = 0; n < 3; n++) {
+        control_msg_t *cmsg = (control_msg_t *)MsgBus_Alloc(MSG_BUS_TOPIC_CONTROL_STATUS);
+        TEST_CHECK(cmsg != NULL);
+        if (cmsg == NULL) {
+            return;
+        }
+        cmsg->timestamp = n;
+        MsgBus_Publish(cmsg);
+        MsgBus_Release(MsgBus_Receive(g_control_subs[1], 0));
+    }
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_CONTROL_STATUS, &stats);
+    TEST_CHECK(stats.deliver_failures == 1 && g_control_subs[0]->dropped == 1);
+    TEST_CHECK(stats.blocks_in_use == 2);
+
+    for (uint32_t n = 0; n < 2; n++) {
+        const control_msg_t *crx = (const control_msg_t *)MsgBus_Receive(g_control_subs[0], 0);
+        TEST_CHECK(crx != NULL && crx->timestamp == n);
+        MsgBus_Release(crx);
+    }
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_CONTROL_STATUS, &stats);
+    TEST_CHECK(stats.blocks_in_use == 0);
+    TEST_CHECK(LivePools() == 2);
+}
+
+/**
+ * @brief 与原按值队列对比: RAM和每条消息的队列复制量, 主机上的耗时仅供参考
+ */
+static void Bench_LegacyVsBus(void)
+{
+    static sensor_msg_t local;
+    static sensor_msg_t rx;
+    static sensor_context_t context;
+    QueueHandle_t legacy[2];
+    msg_bus_topic_stats_t sensor_stats;
+    msg_bus_topic_stats_t control_stats;
+    uint64_t legacy_bytes;
+    uint64_t bus_bytes;
+    uint32_t legacy_ram;
+    uint32_t bus_ram;
+    double t0;
+    double legacy_ns;
+    double bus_ns;
+
+    memset(&context, 0x5A, sizeof(context));
+
+    // 原实现: 发布者把上下文复制进局部消息再按值入队, 订阅者按值出队
+    legacy[0] = xQueueCreate(LEGACY_QUEUE_DEPTH, sizeof(sensor_msg_t));
+    legacy[1] = xQueueCreate(LEGACY_QUEUE_DEPTH, sizeof(sensor_msg_t));
+    stub_queue_bytes_copied = 0;
+    t0 = NowNs();
+    for (uint32_t n = 0; n < BENCH_MESSAGES; n++) {
+        local.type = MSG_SENSOR_DATA;
+        local.timestamp = n;
+        memcpy(&local.context, &context, sizeof(context));
+        xQueueSend(legacy[0], &local, 0);
+        xQueueSend(legacy[1], &local, 0);
+        xQueueReceive(legacy[0], &rx, 0);
+        xQueueReceive(legacy[1], &rx, 0);
+        TEST_CHECK(rx.timestamp == n);
+    }
+    legacy_ns = (NowNs() - t0) / BENCH_MESSAGES;
+    legacy_bytes = stub_queue_bytes_copied / BENCH_MESSAGES;
+    vQueueDelete(legacy[0]);
+    vQueueDelete(legacy[1]);
+
+    // 消息总线: 在块内填写, 队列只传指针
+    stub_queue_bytes_copied = 0;
+    t0 = NowNs();
+    for (uint32_t n = 0; n < BENCH_MESSAGES; n++) {
+        sensor_msg_t *msg = (sensor_msg_t *)MsgBus_Alloc(MSG_BUS_TOPIC_SENSOR_DATA);
+        const sensor_msg_t *a;
+        const sensor_msg_t *b;
+
+        msg->type = MSG_SENSOR_DATA;
+        msg->timestamp = n;
+        memcpy(&msg->context, &context, sizeof(context));
+        MsgBus_Publish(msg);
+        a = (const sensor_msg_t *)MsgBus_Receive(g_sensor_subs[0], 0);
+        b = (const sensor_msg_t *)MsgBus_Receive(g_sensor_subs[1], 0);
+        TEST_CHECK(a == msg && b == msg && a->timestamp == n);
+        MsgBus_Release(a);
+        MsgBus_Release(b);
+    }
+    bus_ns = (NowNs() - t0) / BENCH_MESSAGES;
+    bus_bytes = stub_queue_bytes_copied / BENCH_MESSAGES;
+
+    TEST_CHECK(legacy_bytes == 4 * sizeof(sensor_msg_t));
+    TEST_CHECK(bus_bytes == 4 * sizeof(void *));
+
+    // 静态RAM: 原实现两个16深按值队列; 总线为两个主题的内存池加订阅者指针队列
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_SENSOR_DATA, &sensor_stats);
+    MsgBus_GetTopicStats(MSG_BUS_TOPIC_CONTROL_STATUS, &control_stats);
+    legacy_ram = LEGACY_QUEUE_DEPTH * (uint32_t)(sizeof(sensor_msg_t) + sizeof(control_msg_t));
+    bus_ram = sensor_stats.pool_bytes + control_stats.pool_bytes + (4 + 4 + 2 + 4) * (uint32_t)sizeof(void *);
+    TEST_CHECK(bus_ram < legacy_ram);
+
+    printf("sizeof(sensor_msg_t) = %u, sizeof(control_msg_t) = %u\n",
+           (unsigned)sizeof(sensor_msg_t), (unsigned)sizeof(control_msg_t));
+    printf("RAM: by-value queues %u B, bus pools + pointer queues %u B\n",
+           (unsigned)legacy_ram, (unsigned)bus_ram);
+    printf("queue copies per sensor message (2 subscribers): by-value %u B, bus %u B\n",
+           (unsigned)legacy_bytes, (unsigned)bus_bytes);
+    printf("host time per message: by-value %.0f ns, bus %.0f ns\n", legacy_ns, bus_ns);
+}
+
+int main(void)
+{
+    Test_SubscribeRace();
+    Test_CreateRace();
+    Test_PublishReceive();
+    Bench_LegacyVsBus();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,413 @@
+/**
+ ******************************************************************************
+ * @file    test_output_monitor.c
+ * @brief   EtherCAT主站下发数据变化监控主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 直接包含ethercat_output_monitor.c, 下标任务通知由本测试按任务记录:
+ * - 逐个修改OutputField_t的每个字段 (低字节/高字节/符号位, 模拟量阈值为0), 只置该字段的
+ *   脏位, 返回对应的变化类型, 只通知订阅了该字段的任务 (通知值只含该字段);
+ *   中断上下文使用FromISR接口
+ * - 无变化: 返回OUTPUT_CHANGE_NONE, 脏位为0, 不通知, 计入跳过次数;
+ *   保留字不参与比较
+ * - 模拟量阈值: 低于阈值的变化不报告, 相对已报告的值累积到阈值后报告
+ * - 随机数据: 逐字异或结果与逐字段比较 (含模拟量阈值) 逐位一致
+ * - 主机每次比较耗时: 逐字异或与逐字段比较, 无变化和单字段变化;
+ *   完整的CheckChanges调用
+ ******************************************************************************
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// 监控模块的调试打印在主机测试中关闭
+static inline int Test_Quiet(const char *format, ...)
+{
+    (void)format;
+    return 0;
+}
+
+#define printf Test_Quiet
+#include "../Src/ethercat_output_monitor.c"
+#undef printf
+
+#include "test_common.h"
+
+#define SUBSCRIBER_COUNT    OUTPUT_MONITOR_MAX_SUBSCRIBERS
+#define RANDOM_TRIALS       200000
+#define BENCH_CALLS         2000000UL
+#define ANALOG_BASE         1000
+
+/* 通知记录 (每个订阅任务一项) */
+static int g_tasks[SUBSCRIBER_COUNT];
+static uint32_t g_notify_value[SUBSCRIBER_COUNT];
+static uint32_t g_notify_calls[SUBSCRIBER_COUNT];
+static uint32_t g_notify_isr_calls;
+static uint32_t g_notify_errors;
+
+// 订阅: 按字段号模3分给前三个任务, 第四个任务订阅全部字段
+static uint32_t SubscriberMask(uint8_t s)
+{
+    uint32_t mask = 0;
+
+    if (s == SUBSCRIBER_COUNT - 1) {
+        return OUTPUT_FIELD_ALL;
+    }
+    for (uint8_t i = 0; i < OUTPUT_FIELD_COUNT; i++) {
+        if (i % 3 == s) {
+            mask |= OUTPUT_FIELD_BIT(i);
+        }
+    }
+    return mask;
+}
+
+static int TaskIndex(TaskHandle_t task)
+{
+    for (int s = 0; s < SUBSCRIBER_COUNT; s++) {
+        if (task == &g_tasks[s]) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+BaseType_t xTaskNotifyIndexed(TaskHandle_t task, UBaseType_t index, uint32_t value, eNotifyAction action)
+{
+    int s = TaskIndex(task);
+
+    if (s < 0 || index != OUTPUT_MONITOR_NOTIFY_INDEX || action != eSetBits || stub_in_isr) {
+        g_notify_errors++;
+        return pdFAIL;
+    }
+    g_notify_value[s] |= value;
+    g_notify_calls[s]++;
+    return pdPASS;
+}
+
+BaseType_t xTaskNotifyIndexedFromISR(TaskHandle_t task, UBaseType_t index, uint32_t value, eNotifyAction action,
+                                     BaseType_t *higher_priority_woken)
+{
+    int s = TaskIndex(task);
+
+    if (s < 0 || index != OUTPUT_MONITOR_NOTIFY_INDEX || action != eSetBits || !stub_in_isr ||
+        higher_priority_woken == NULL) {
+        g_notify_errors++;
+        return pdFAIL;
+    }
+    g_notify_value[s] |= value;
+    g_notify_calls[s]++;
+    g_notify_isr_calls++;
+    return pdPASS;
+}
+
+static double NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void ClearNotifications(void)
+{
+    memset(g_notify_value, 0, sizeof(g_notify_value));
+    memset(g_notify_calls, 0, sizeof(g_notify_calls));
+    g_notify_isr_calls = 0;
+}
+
+static uint32_t NotifyCalls(void)
+{
+    uint32_t calls = 0;
+
+    for (int s = 0; s < SUBSCRIBER_COUNT; s++) {
+        calls += g_notify_calls[s];
+    }
+    return calls;
+}
+
+// 基准数据: 模拟量非零, 其余字段各不相同
+static void BaseImage(OutputCacheImage_t *image)
+{
+    memset(image, 0, sizeof(*image));
+    for (uint8_t i = 0; i < OUTPUT_FIELD_COUNT; i++) {
+        image->fields[i] = (uint16_t)(0x1111U * (i + 1));
+    }
+    for (uint8_t i = OUTPUT_FIELD_ANALOG_0; i <= OUTPUT_FIELD_ANALOG_3; i++) {
+        image->fields[i] = (uint16_t)(ANALOG_BASE * (i - OUTPUT_FIELD_ANALOG_0 + 1));
+    }
+}
+
+// 锁存并同步缓存 (不通知)
+static void Settle(const OutputCacheImage_t *image)
+{
+    EtherCAT_OutputMonitor_Latch(&image->data);
+    EtherCAT_OutputMonitor_UpdateCache(false);
+}
+
+// 对照: 逐字段比较, 模拟量按相对已报告值的千分比阈值
+static uint32_t ReferenceDiff(const OutputCacheImage_t *current, const OutputCacheImage_t *previous)
+{
+    uint32_t dirty = 0;
+
+    for (uint8_t i = 0; i < OUTPUT_FIELD_COUNT; i++) {
+        int32_t now = (int16_t)current->fields[i];
+        int32_t before = (int16_t)previous->fields[i];
+
+        if (current->fields[i] == previous->fields[i]) {
+            continue;
+        }
+        if (i >= OUTPUT_FIELD_ANALOG_0 && i <= OUTPUT_FIELD_ANALOG_3 && before != 0 &&
+            (uint32_t)(abs(now - before) * 1000) / (uint32_t)abs(before) < g_analog_threshold) {
+            continue;
+        }
+        dirty |= OUTPUT_FIELD_BIT(i);
+    }
+    return dirty;
+}
+
+/* ========================================================================== */
+/* 逐字段修改 */
+/* ========================================================================== */
+
+static void CheckSingleField(const OutputCacheImage_t *base, uint8_t field, uint16_t value)
+{
+    OutputCacheImage_t image = *base;
+    uint32_t bit = OUTPUT_FIELD_BIT(field);
+    uint8_t changes;
+
+    Settle(base);
+    ClearNotifications();
+
+    image.fields[field] = value;
+    EtherCAT_OutputMonitor_Latch(&image.data);
+    changes = EtherCAT_OutputMonitor_CheckChanges();
+
+    TEST_CHECK(EtherCAT_OutputMonitor_GetDirtyFields() == bit);
+    TEST_CHECK(changes == EtherCAT_OutputMonitor_FieldsToChangeType(bit));
+    TEST_CHECK(changes != OUTPUT_CHANGE_NONE && (changes & (changes - 1)) == 0);
+
+    // 只有订阅了该字段的任务被通知, 通知值只含该字段
+    for (uint8_t s = 0; s < SUBSCRIBER_COUNT; s++) {
+        bool subscribed = (SubscriberMask(s) & bit) != 0;
+
+        TEST_CHECK(g_notify_calls[s] == (subscribed ? 1U : 0U));
+        TEST_CHECK(g_notify_value[s] == (subscribed ? bit : 0U));
+    }
+    TEST_CHECK(g_notify_isr_calls == (stub_in_isr ? 2U : 0U));
+
+    // 再次检查: 已提交, 无变化
+    ClearNotifications();
+    TEST_CHECK(EtherCAT_OutputMonitor_CheckChanges() == OUTPUT_CHANGE_NONE);
+    TEST_CHECK(EtherCAT_OutputMonitor_GetDirtyFields() == 0);
+    TEST_CHECK(NotifyCalls() == 0);
+}
+
+static void Test_Fields(void)
+{
+    OutputCacheImage_t base;
+    static const uint8_t expected_type[OUTPUT_FIELD_COUNT] = {
+        OUTPUT_CHANGE_DIGITAL, OUTPUT_CHANGE_DIGITAL,
+        OUTPUT_CHANGE_ANALOG, OUTPUT_CHANGE_ANALOG, OUTPUT_CHANGE_ANALOG, OUTPUT_CHANGE_ANALOG, OUTPUT_CHANGE_ANALOG,
+        OUTPUT_CHANGE_COMMAND, OUTPUT_CHANGE_COMMAND,
+        OUTPUT_CHANGE_CONFIG, OUTPUT_CHANGE_CONFIG,
+    };
+
+    // 阈值0: 模拟量的任何变化都报告 (阈值见Test_AnalogThreshold)
+    EtherCAT_OutputMonitor_SetAnalogThreshold(0);
+    BaseImage(&base);
+    for (uint8_t isr = 0; isr < 2; isr++) {
+        stub_in_isr = isr ? pdTRUE : pdFALSE;
+        for (uint8_t i = 0; i < OUTPUT_FIELD_COUNT; i++) {
+            uint16_t v = base.fields[i];
+
+            TEST_CHECK(EtherCAT_OutputMonitor_FieldsToChangeType(OUTPUT_FIELD_BIT(i)) == expected_type[i]);
+
+            // 低字节, 高字节和符号位 (偶数字段在字的低半字, 奇数字段在高半字)
+            CheckSingleField(&base, i, (uint16_t)(v ^ 0x0001U));
+            CheckSingleField(&base, i, (uint16_t)(v ^ 0x0100U));
+            CheckSingleField(&base, i, (uint16_t)(v ^ 0x8000U));
+        }
+    }
+    stub_in_isr = pdFALSE;
+    EtherCAT_OutputMonitor_SetAnalogThreshold(10);
+    TEST_CHECK(g_notify_errors == 0);
+}
+
+/* ========================================================================== */
+/* 无变化, 保留字, 模拟量阈值 */
+/* ========================================================================== */
+
+static void Test_NoChange(void)
+{
+    OutputCacheImage_t image;
+    OutputMonitorStats_t stats = {0};
+
+    BaseImage(&image);
+    Settle(&image);
+    EtherCAT_OutputMonitor_ResetStats();
+    ClearNotifications();
+
+    for (int n = 0; n < 10; n++) {
+        EtherCAT_OutputMonitor_Latch(&image.data);
+        TEST_CHECK(EtherCAT_OutputMonitor_CheckChanges() == OUTPUT_CHANGE_NONE);
+        TEST_CHECK(EtherCAT_OutputMonitor_GetDirtyFields() == 0);
+    }
+
+    // 保留字不参与比较
+    image.data.reserved = 0xBEEF;
+    EtherCAT_OutputMonitor_Latch(&image.data);
+    TEST_CHECK(EtherCAT_OutputMonitor_CheckChanges() == OUTPUT_CHANGE_NONE);
+
+    EtherCAT_OutputMonitor_GetStats(&stats);
+    TEST_CHECK(stats.total_updates == 11 && stats.skipped_updates == 11);
+    TEST_CHECK(stats.change_rate_percent == 0);
+    TEST_CHECK(NotifyCalls() == 0);
+}
+
+static void Test_AnalogThreshold(void)
+{
+    OutputCacheImage_t image;
+    uint8_t field = OUTPUT_FIELD_ANALOG_1;
+
+    BaseImage(&image);
+    Settle(&image);
+    ClearNotifications();
+
+    // 默认阈值1%: 2000 -> 2010 (0.5%) 不报告, -> 2020 (相对已报告值1%) 报告
+    image.fields[field] = 2010;
+    EtherCAT_OutputMonitor_Latch(&image.data);
+    TEST_CHECK(EtherCAT_OutputMonitor_CheckChanges() == OUTPUT_CHANGE_NONE);
+    image.fields[field] = 2020;
+    EtherCAT_OutputMonitor_Latch(&image.data);
+    TEST_CHECK(EtherCAT_OutputMonitor_CheckChanges() == OUTPUT_CHANGE_ANALOG);
+    TEST_CHECK(EtherCAT_OutputMonitor_GetDirtyFields() == OUTPUT_FIELD_BIT(field));
+    TEST_CHECK(g_notify_value[field % 3] == OUTPUT_FIELD_BIT(field));
+
+    // 上次为0时任何非零值都报告
+    image.fields[field] = 0;
+    EtherCAT_OutputMonitor_Latch(&image.data);
+    TEST_CHECK(EtherCAT_OutputMonitor_CheckChanges() == OUTPUT_CHANGE_ANALOG);
+    image.fields[field] = 1;
+    EtherCAT_OutputMonitor_Latch(&image.data);
+    TEST_CHECK(EtherCAT_OutputMonitor_CheckChanges() == OUTPUT_CHANGE_ANALOG);
+
+    // 阈值0: 任何变化都报告
+    EtherCAT_OutputMonitor_SetAnalogThreshold(0);
+    image.fields[field] = 2;
+    EtherCAT_OutputMonitor_Latch(&image.data);
+    TEST_CHECK(EtherCAT_OutputMonitor_CheckChanges() == OUTPUT_CHANGE_ANALOG);
+    EtherCAT_OutputMonitor_SetAnalogThreshold(10);
+}
+
+/* ========================================================================== */
+/* 随机数据对照 */
+/* ========================================================================== */
+
+static void Test_Random(void)
+{
+    OutputCacheImage_t previous;
+    OutputCacheImage_t current;
+    uint32_t mismatches = 0;
+
+    srand(29);
+    for (uint32_t n = 0; n < RANDOM_TRIALS; n++) {
+        uint32_t expected;
+
+        for (uint8_t i = 0; i < OUTPUT_FIELD_COUNT; i++) {
+            previous.fields[i] = (uint16_t)rand();
+        }
+        previous.data.reserved = 0;
+        current = previous;
+
+        // 随机修改若干字段: 任意值或模拟量的小幅变化 (阈值附近)
+        for (int k = rand() % 4; k > 0; k--) {
+            uint8_t i = (uint8_t)(rand() % OUTPUT_FIELD_COUNT);
+
+            if ((rand() & 1) && i >= OUTPUT_FIELD_ANALOG_0 && i <= OUTPUT_FIELD_ANALOG_3) {
+                int32_t before = (int16_t)previous.fields[i];
+
+                current.fields[i] = (uint16_t)(int16_t)(before + (before / 100) * ((rand() % 5) - 2) / 2);
+            } else {
+                current.fields[i] = (uint16_t)rand();
+            }
+        }
+
+        Settle(&previous);
+        EtherCAT_OutputMonitor_Latch(&current.data);
+        EtherCAT_OutputMonitor_CheckChanges();
+        expected = ReferenceDiff(&current, &previous);
+        if (EtherCAT_OutputMonitor_GetDirtyFields() != expected) {
+            mismatches++;
+        }
+    }
+    TEST_CHECK(mismatches == 0);
+}
+
+/* ========================================================================== */
+/* 比较耗时 */
+/* ========================================================================== */
+
+static void Test_Benchmark(void)
+{
+    OutputCacheImage_t images[2];
+    volatile uint32_t sink = 0;
+    double ns[2][2];
+
+    BaseImage(&images[0]);
+    images[1] = images[0];
+
+    // [0]=无变化, [1]=单字段 (系统命令) 变化
+    for (int changed = 0; changed < 2; changed++) {
+        images[1].fields[OUTPUT_FIELD_SYSTEM_CMD] = (uint16_t)(images[0].fields[OUTPUT_FIELD_SYSTEM_CMD] ^ changed);
+
+        double t0 = NowNs();
+        for (uint32_t n = 0; n < BENCH_CALLS; n++) {
+            sink += _diff_fields(&images[1], &images[n & 1 ? 1 : 0]);
+        }
+        double t1 = NowNs();
+        for (uint32_t n = 0; n < BENCH_CALLS; n++) {
+            sink += ReferenceDiff(&images[1], &images[n & 1 ? 1 : 0]);
+        }
+        double t2 = NowNs();
+
+        ns[changed][0] = (t1 - t0) / BENCH_CALLS;
+        ns[changed][1] = (t2 - t1) / BENCH_CALLS;
+    }
+    (void)sink;
+
+    // 完整的检测调用 (临界区, 提交, 统计), 无变化
+    Settle(&images[0]);
+    double t0 = NowNs();
+    for (uint32_t n = 0; n < BENCH_CALLS; n++) {
+        sink += EtherCAT_OutputMonitor_CheckChanges();
+    }
+    double check_ns = (NowNs() - t0) / BENCH_CALLS;
+
+    printf("host diff time: word XOR %.1f ns (no change) / %.1f ns (one field), "
+           "per-field compare %.1f ns / %.1f ns; CheckChanges %.1f ns\n",
+           ns[0][0], ns[1][0], ns[0][1], ns[1][1], check_ns);
+}
+
+int main(void)
+{
+    EtherCAT_OutputMonitor_Init();
+    for (uint8_t s = 0; s < SUBSCRIBER_COUNT; s++) {
+        TEST_CHECK(EtherCAT_OutputMonitor_Subscribe(&g_tasks[s], SubscriberMask(s)));
+    }
+    TEST_CHECK(!EtherCAT_OutputMonitor_Subscribe((TaskHandle_t)&g_notify_errors, OUTPUT_FIELD_ALL));
+
+    Test_Fields();
+    Test_NoChange();
+    Test_AnalogThreshold();
+    Test_Random();
+    Test_Benchmark();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,565 @@
+/**
+ ******************************************************************************
+ * @file    test_oversampling.c
+ * @brief   过采样输入PDO模块主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - Oversampling_GetSpacingUs/_CheckTiming/_BuildMapping/_PackFrame
+ * - SYNC0/定时器/DMA状态机: 测试实现BSP_ADS8688_StartChannelsIsr,
+ *   按模拟时间(us)投递SYNC0, TIM4更新中断和DMA完成回调; 采样值编码请求
+ *   序号, 检查每个采样点的启动时刻 (SYNC0 + k·间隔), 通道和帧时间戳
+ * - 迟到采样: 下一个SYNC0时仍在传输和未启动的采样点补为无效并发布,
+ *   迟到的完成回调被丢弃; 总线占用, 传输错误, 满量程码饱和, 停止
+ * - Oversampling_CopyPdo与采样中断并发 (线程): 复制结果不得混合两帧
+ ******************************************************************************
+ */
+
+#include "ethercat_oversampling.h"
+#include "ads8688/bsp_ads8688.h"
+#include "test_common.h"
+#include <pthread.h>
+#include <string.h>
+
+#define NONE                UINT32_MAX
+#define SPI_FRAME_US        37
+#define REQUEST_LOG         65536
+#define CONCURRENT_FRAMES   2000000UL
+
+/* ADS8688中断读取请求记录 (序号从1开始) */
+typedef struct {
+    uint32_t start_us;
+    uint8_t count;
+    uint8_t channels[OVERSAMPLING_MAX_CHANNELS];
+} request_t;
+
+static request_t g_requests[REQUEST_LOG];
+static uint32_t g_request_count;
+
+/* 模拟时间与中断源 */
+static uint32_t g_now_us;
+static uint32_t g_cycle_us;
+static uint32_t g_sync_next_us = NONE;
+static uint32_t g_tim_next_us = NONE;
+static bool g_dma_busy;
+static uint32_t g_dma_done_us;
+static uint32_t g_dma_request;
+static ads8688_read_done_t g_dma_done;
+
+/* 故障注入 (按请求序号) */
+static uint32_t g_busy_request = NONE;
+static uint32_t g_error_request = NONE;
+static uint32_t g_fullscale_request = NONE;
+static uint32_t g_slow_request = NONE;
+static uint32_t g_slow_us;
+
+/* 并发测试: 采样值为帧号, 完成回调由写线程直接调用 */
+static volatile bool g_concurrent;
+static uint16_t g_frame_value;
+
+/* ========================================================================== */
+/* ADS8688与中断模拟 */
+/* ========================================================================== */
+
+HAL_StatusTypeDef BSP_ADS8688_StartChannelsIsr(const uint8_t *channels, uint8_t count, ads8688_read_done_t done)
+{
+    uint32_t id;
+
+    if (g_dma_busy || g_request_count + 1 == g_busy_request) {
+        if (!g_dma_busy) {
+            g_request_count++;
+        }
+        return HAL_BUSY;
+    }
+
+    id = ++g_request_count % REQUEST_LOG;
+    g_requests[id].start_us = g_now_us;
+    g_requests[id].count = count;
+    memcpy(g_requests[id].channels, channels, count);
+
+    g_dma_busy = true;
+    g_dma_request = g_request_count;
+    g_dma_done = done;
+    g_dma_done_us = g_now_us + (count + 1) * SPI_FRAME_US;
+    if (g_request_count == g_slow_request) {
+        g_dma_done_us = g_now_us + g_slow_us;
+    }
+    return HAL_OK;
+}
+
+static void CompleteDma(void)
+{
+    uint16_t data[OVERSAMPLING_MAX_CHANNELS];
+    HAL_StatusTypeDef status = HAL_OK;
+
+    for (uint8_t ch = 0; ch < OVERSAMPLING_MAX_CHANNELS; ch++) {
+        data[ch] = g_concurrent ? g_frame_value : (uint16_t)((g_dma_request << 1) | ch);
+    }
+    if (g_dma_request == g_error_request) {
+        status = HAL_ERROR;
+    } else if (g_dma_request == g_fullscale_request) {
+        data[0] = 0xFFFF;
+    }
+
+    g_dma_busy = false;
+    g_dma_done(status, data);
+}
+
+static void DeliverSync0(void)
+{
+    Oversampling_OnSync0(g_now_us * 1000UL);
+
+    // SYNC0挂起的定时器中断优先级更高, 立即执行
+    if (stub_nvic_pending & (1ULL << OVERSAMPLING_TIM_IRQ)) {
+        HAL_NVIC_ClearPendingIRQ(OVERSAMPLING_TIM_IRQ);
+        Oversampling_TimerIsr();
+        if (OVERSAMPLING_TIMx->CR1 & TIM_CR1_CEN) {
+            g_tim_next_us = g_now_us + OVERSAMPLING_TIMx->ARR + 1;
+        }
+    }
+}
+
+// 时间前进到until_us, 同一时刻按 DMA完成 -> 定时器 -> SYNC0 的顺序投递
+static void RunUntil(uint32_t until_us)
+{
+    for (;;) {
+        bool tim_running = (OVERSAMPLING_TIMx->CR1 & TIM_CR1_CEN) != 0;
+        uint32_t next = g_dma_busy ? g_dma_done_us : NONE;
+
+        if (tim_running && g_tim_next_us < next) {
+            next = g_tim_next_us;
+        }
+        if (g_sync_next_us < next) {
+            next = g_sync_next_us;
+        }
+        if (next > until_us) {
+            break;
+        }
+
+        g_now_us = next;
+        if (g_dma_busy && next == g_dma_done_us) {
+            CompleteDma();
+        } else if (tim_running && next == g_tim_next_us) {
+            g_tim_next_us += OVERSAMPLING_TIMx->ARR + 1;
+            OVERSAMPLING_TIMx->SR |= TIM_FLAG_UPDATE;
+            Oversampling_TimerIsr();
+        } else {
+            g_sync_next_us += g_cycle_us;
+            DeliverSync0();
+        }
+    }
+    g_now_us = until_us;
+}
+
+static void StartRun(const oversampling_config_t *config, uint32_t cycle_us)
+{
+    Oversampling_Stop();
+    RunUntil(g_now_us + 2000);
+    TEST_CHECK(Oversampling_SetConfig(config) == pdPASS);
+    TEST_CHECK(Oversampling_Start(cycle_us * 1000UL) == pdPASS);
+    g_cycle_us = cycle_us;
+    g_sync_next_us = g_now_us + cycle_us;
+}
+
+/* ========================================================================== */
+/* 帧检查 */
+/* ========================================================================== */
+
+// invalid_mask: 无效的采样点 (位k = 第k个采样点)
+static void CheckFrame(uint32_t sync_us, uint16_t invalid_mask, uint16_t missed)
+{
+    oversampling_config_t config;
+    uint16_t pdo[OVERSAMPLING_MAX_PDO_ENTRIES + 1];
+    uint32_t spacing_us;
+    uint32_t errors = 0;
+
+    Oversampling_GetConfig(&config);
+    spacing_us = Oversampling_GetSpacingUs(g_cycle_us * 1000UL, config.factor);
+    Oversampling_CopyPdo(pdo);
+
+    TEST_CHECK(((uint32_t)pdo[0] | ((uint32_t)pdo[1] << 16)) == sync_us * 1000UL);
+    TEST_CHECK(pdo[2] == missed);
+
+    for (uint8_t ch = 0; ch < config.channel_count; ch++) {
+        for (uint8_t k = 0; k < config.factor; k++) {
+            uint16_t value = pdo[3 + ch * config.factor + k];
+            const request_t *request = &g_requests[(value >> 1) % REQUEST_LOG];
+
+            if (invalid_mask & (1U << k)) {
+                errors += (value != OVERSAMPLING_SAMPLE_INVALID);
+            } else {
+                errors += (value == OVERSAMPLING_SAMPLE_INVALID);
+                errors += ((value & 1U) != ch);
+                errors += (request->count != config.channel_count);
+                errors += (request->channels[ch] != config.channels[ch]);
+                errors += (request->start_us != sync_us + k * spacing_us);
+            }
+        }
+    }
+    TEST_CHECK(errors == 0);
+}
+
+/* ========================================================================== */
+/* 纯函数 */
+/* ========================================================================== */
+
+static void Test_Timing(void)
+{
+    oversampling_config_t one = {10, 1, {2, OVERSAMPLING_CHANNEL_NONE}};
+    oversampling_config_t two = {4, 2, {3, 6}};
+    oversampling_config_t bad;
+
+    TEST_CHECK(Oversampling_GetSpacingUs(1000000UL, 4) == 250);
+    TEST_CHECK(Oversampling_GetSpacingUs(1000000UL, 3) == 333);     // 向下取整
+    TEST_CHECK(Oversampling_GetSpacingUs(500000UL, 10) == 50);
+    TEST_CHECK(Oversampling_GetSpacingUs(1000999UL, 1) == 1000);
+    TEST_CHECK(Oversampling_GetSpacingUs(1000000UL, 0) == 0);
+
+    // 采样间隔须容纳 通道数+1 个SPI帧: 1通道10倍@1ms为100us >= 80us
+    TEST_CHECK(Oversampling_CheckTiming(&one, 1000000UL));
+    TEST_CHECK(!Oversampling_CheckTiming(&one, 790000UL));
+    TEST_CHECK(Oversampling_CheckTiming(&one, 800000UL));
+    TEST_CHECK(Oversampling_CheckTiming(&two, 1000000UL));
+    two.factor = 10;                                                // 100us < 120us
+    TEST_CHECK(!Oversampling_CheckTiming(&two, 1000000UL));
+    TEST_CHECK(Oversampling_CheckTiming(&two, 1200000UL));
+    two.factor = 4;
+
+    // 周期下限与定时器16位上限
+    one.factor = 1;
+    TEST_CHECK(!Oversampling_CheckTiming(&one, OVERSAMPLING_MIN_CYCLE_NS - 1));
+    TEST_CHECK(Oversampling_CheckTiming(&one, OVERSAMPLING_MIN_CYCLE_NS));
+    TEST_CHECK(Oversampling_CheckTiming(&one, 65536000UL));
+    TEST_CHECK(!Oversampling_CheckTiming(&one, 65537000UL));
+
+    // 非法配置
+    bad = two;
+    bad.factor = 0;
+    TEST_CHECK(!Oversampling_CheckTiming(&bad, 1000000UL));
+    bad.factor = OVERSAMPLING_MAX_FACTOR + 1;
+    TEST_CHECK(!Oversampling_CheckConfig(&bad));
+    bad = two;
+    bad.channels[1] = 3;
+    TEST_CHECK(!Oversampling_CheckConfig(&bad));
+    bad.channels[1] = OVERSAMPLING_ADC_CHANNELS;
+    TEST_CHECK(!Oversampling_CheckConfig(&bad));
+    bad = two;
+    bad.channel_count = 0;
+    TEST_CHECK(!Oversampling_CheckConfig(&bad));
+    TEST_CHECK(!Oversampling_CheckConfig(NULL));
+}
+
+static void Test_Mapping(void)
+{
+    oversampling_config_t config = {3, 2, {3, 6}};
+    oversampling_frame_t frame;
+    uint32_t entries[OVERSAMPLING_MAX_PDO_ENTRIES];
+    uint16_t pdo[OVERSAMPLING_MAX_PDO_ENTRIES + 2];
+    uint16_t count;
+
+    count = Oversampling_BuildMapping(&config, entries);
+    TEST_CHECK(count == 2 + 3 * 2);
+    TEST_CHECK(count == Oversampling_GetPdoWords(&config) - 1);     // 时间戳占2字
+    TEST_CHECK(entries[0] == 0x60100120);
+    TEST_CHECK(entries[1] == 0x60100210);
+    TEST_CHECK(entries[2] == 0x60110110 && entries[4] == 0x60110310);
+    TEST_CHECK(entries[5] == 0x60120110 && entries[7] == 0x60120310);
+
+    config.factor = OVERSAMPLING_MAX_FACTOR;
+    TEST_CHECK(Oversampling_BuildMapping(&config, entries) == OVERSAMPLING_MAX_PDO_ENTRIES);
+    TEST_CHECK(entries[OVERSAMPLING_MAX_PDO_ENTRIES - 1] == 0x60120A10);
+    config.factor = 0;
+    TEST_CHECK(Oversampling_BuildMapping(&config, entries) == 0);
+    TEST_CHECK(Oversampling_GetPdoWords(&config) == 0);
+    config.factor = 3;
+    TEST_CHECK(Oversampling_BuildMapping(&config, NULL) == 0);
+
+    // 布局: 时间戳低字, 高字, 丢失计数, 通道A的N个采样, 通道B的N个采样
+    memset(&frame, 0, sizeof(frame));
+    frame.timestamp = 0x12345678;
+    frame.missed = 7;
+    for (uint8_t k = 0; k < 3; k++) {
+        frame.samples[0][k] = 0x100 + k;
+        frame.samples[1][k] = 0x200 + k;
+    }
+    memset(pdo, 0xAA, sizeof(pdo));
+    Oversampling_PackFrame(&config, &frame, pdo);
+    TEST_CHECK(pdo[0] == 0x5678 && pdo[1] == 0x1234 && pdo[2] == 7);
+    TEST_CHECK(pdo[3] == 0x100 && pdo[5] == 0x102 && pdo[6] == 0x200 && pdo[8] == 0x202);
+    TEST_CHECK(pdo[9] == 0xAAAA);
+
+    config.channel_count = 1;
+    memset(pdo, 0xAA, sizeof(pdo));
+    Oversampling_PackFrame(&config, &frame, pdo);
+    TEST_CHECK(pdo[5] == 0x102 && pdo[6] == 0xAAAA);
+}
+
+/* ========================================================================== */
+/* 状态机 */
+/* ========================================================================== */
+
+static void Test_Capture(void)
+{
+    const oversampling_config_t configs[] = {
+        {4, 2, {3, 6}},
+        {1, 1, {5, OVERSAMPLING_CHANNEL_NONE}},
+        {10, 1, {0, OVERSAMPLING_CHANNEL_NONE}},
+        {3, 2, {7, 1}},
+    };
+    const uint32_t cycles_us[] = { 1000, 500, 1000, 1000 };
+
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        uint32_t first_request;
+        uint32_t spacing_us = Oversampling_GetSpacingUs(cycles_us[c] * 1000UL, configs[c].factor);
+        uint32_t requests;
+
+        StartRun(&configs[c], cycles_us[c]);
+        TEST_CHECK(Oversampling_IsRunning());
+        TEST_CHECK(Oversampling_SetConfig(&configs[0]) == pdFAIL);  // 运行中锁定
+        TEST_CHECK(OVERSAMPLING_TIMx->ARR == spacing_us - 1);
+
+        first_request = g_request_count + 1;
+        for (uint32_t n = 0; n < 200; n++) {
+            uint32_t sync_us = g_sync_next_us;
+
+            RunUntil(sync_us + g_cycle_us - 1);
+            CheckFrame(sync_us, 0, 0);
+        }
+
+        // 采样率: 200个周期共启动200·N个采样点, 最后一个点相对首个点的时间
+        requests = g_request_count + 1 - first_request;
+        printf("factor %u x %u channel(s) @ %lu us: %lu reads, spacing %lu us, sample rate %.1f Hz\n",
+               configs[c].factor, configs[c].channel_count, (unsigned long)cycles_us[c],
+               (unsigned long)requests, (unsigned long)spacing_us,
+               1e6 * (requests - 1) / (g_requests[g_request_count % REQUEST_LOG].start_us -
+                                       g_requests[first_request % REQUEST_LOG].start_us));
+        TEST_CHECK(requests == 200UL * configs[c].factor);
+    }
+
+    // 周期不满足要求时不启动
+    Oversampling_Stop();
+    TEST_CHECK(!Oversampling_IsRunning());
+    TEST_CHECK(Oversampling_Start(OVERSAMPLING_MIN_CYCLE_NS - 1000) == pdFAIL);
+    TEST_CHECK(!Oversampling_IsRunning());
+}
+
+static void Test_LateSample(void)
+{
+    const oversampling_config_t config = {4, 2, {3, 6}};
+    uint32_t sync_us;
+
+    StartRun(&config, 1000);
+    for (uint8_t n = 0; n < 3; n++) {
+        sync_us = g_sync_next_us;
+        RunUntil(sync_us + 999);
+        CheckFrame(sync_us, 0, 0);
+    }
+
+    // 第4个采样点传输400us, 跨过下一个SYNC0: 该点补为无效, 帧按时发布;
+    // 下一帧的第1个点因总线仍被占用而丢失, 迟到的完成回调被丢弃
+    sync_us = g_sync_next_us;
+    g_slow_request = g_request_count + 4;
+    g_slow_us = 400;
+    RunUntil(sync_us + 999);
+    TEST_CHECK(g_dma_busy);
+    RunUntil(sync_us + 1000);
+    CheckFrame(sync_us, 0x8, 1);
+    RunUntil(sync_us + 1999);
+    TEST_CHECK(!g_dma_busy);
+    CheckFrame(sync_us + 1000, 0x1, 2);
+    sync_us += 2000;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0, 2);
+    g_slow_request = NONE;
+
+    // SYNC0提前到600us: 第3个点(500us启动)仍在传输, 第4个点未启动,
+    // 两点均补为无效后发布; 新帧从提前的SYNC0开始
+    sync_us = g_sync_next_us;
+    RunUntil(sync_us + 600);
+    TEST_CHECK(g_dma_busy);
+    g_sync_next_us = g_now_us;
+    RunUntil(sync_us + 600);
+    CheckFrame(sync_us, 0xC, 4);
+    sync_us += 600;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0x1, 5);                // 第1个点与被丢弃的传输重叠
+    sync_us += 1000;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0, 5);
+
+    // SYNC0丢失一个周期: 定时器在最后一个点后停止, 帧不重复发布
+    g_sync_next_us += 1000;
+    RunUntil(sync_us + 1999);
+    CheckFrame(sync_us, 0, 5);
+    TEST_CHECK(!(OVERSAMPLING_TIMx->CR1 & TIM_CR1_CEN));
+    sync_us = g_sync_next_us;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0, 5);
+}
+
+static void Test_BusyAndError(void)
+{
+    const oversampling_config_t config = {4, 2, {3, 6}};
+    uint16_t pdo[OVERSAMPLING_MAX_PDO_ENTRIES + 1];
+    uint32_t sync_us;
+
+    StartRun(&config, 1000);
+
+    // 总线被占用: 该点无效, 计入丢失; 最后一个点被占用时直接发布
+    sync_us = g_sync_next_us;
+    g_busy_request = g_request_count + 2;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0x2, 1);
+    sync_us = g_sync_next_us;
+    g_busy_request = g_request_count + 4;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0x8, 2);
+    g_busy_request = NONE;
+
+    // 传输错误
+    sync_us = g_sync_next_us;
+    g_error_request = g_request_count + 3;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0x4, 3);
+    g_error_request = NONE;
+
+    // 满量程码0xFFFF饱和为OVERSAMPLING_SAMPLE_MAX, 与丢失标记区分
+    sync_us = g_sync_next_us;
+    g_fullscale_request = g_request_count + 1;
+    RunUntil(sync_us + 999);
+    Oversampling_CopyPdo(pdo);
+    TEST_CHECK(pdo[3] == OVERSAMPLING_SAMPLE_MAX);
+    TEST_CHECK(pdo[2] == 3);
+    g_fullscale_request = NONE;
+}
+
+static void Test_Stop(void)
+{
+    const oversampling_config_t config = {4, 1, {2, OVERSAMPLING_CHANNEL_NONE}};
+    uint16_t before[OVERSAMPLING_MAX_PDO_ENTRIES + 1];
+    uint16_t after[OVERSAMPLING_MAX_PDO_ENTRIES + 1];
+    uint32_t sync_us;
+    uint32_t requests;
+
+    StartRun(&config, 1000);
+    sync_us = g_sync_next_us;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0, 0);
+
+    // 传输中停止: 完成回调被丢弃, 已发布帧不变, SYNC0被忽略
+    RunUntil(sync_us + 1010);
+    TEST_CHECK(g_dma_busy);
+    Oversampling_CopyPdo(before);
+    Oversampling_Stop();
+    TEST_CHECK(!Oversampling_IsRunning());
+    requests = g_request_count;
+    RunUntil(sync_us + 5000);
+    TEST_CHECK(!g_dma_busy);
+    TEST_CHECK(g_request_count == requests);
+    Oversampling_CopyPdo(after);
+    TEST_CHECK(memcmp(before, after, 3 * sizeof(uint16_t) + config.factor * sizeof(uint16_t)) == 0);
+    TEST_CHECK(!(OVERSAMPLING_TIMx->CR1 & TIM_CR1_CEN));
+
+    // 重新启动后从新帧开始
+    g_sync_next_us = NONE;
+    StartRun(&config, 1000);
+    sync_us = g_sync_next_us;
+    RunUntil(sync_us + 999);
+    CheckFrame(sync_us, 0, 0);
+    Oversampling_Stop();
+    g_sync_next_us = NONE;
+}
+
+/* ========================================================================== */
+/* 复制与采样中断并发 */
+/* ========================================================================== */
+
+static volatile bool g_writer_done;
+
+// 采样中断: 每帧的采样值等于帧号, 每3帧最后一个点迟到 (下一个SYNC0补齐发布并立即写新帧,
+// 新帧第1个点因总线占用丢失)
+static void *Writer(void *arg)
+{
+    (void)arg;
+
+    for (uint32_t n = 1; n <= CONCURRENT_FRAMES; n++) {
+        g_frame_value = (uint16_t)(n & 0x7FFF);
+        Oversampling_OnSync0(n * 1000UL);
+        Oversampling_TimerIsr();
+        for (uint8_t k = 0; k < 4; k++) {
+            if (k > 0) {
+                OVERSAMPLING_TIMx->SR |= TIM_FLAG_UPDATE;
+                Oversampling_TimerIsr();
+            }
+            if (k == 3 && n % 3 == 0) {
+                break;
+            }
+            if (g_dma_busy) {
+                CompleteDma();
+            }
+        }
+    }
+    g_writer_done = true;
+    return NULL;
+}
+
+static void Test_ConcurrentCopy(void)
+{
+    const oversampling_config_t config = {4, 2, {3, 6}};
+    uint16_t pdo[OVERSAMPLING_MAX_PDO_ENTRIES + 1];
+    pthread_t writer;
+    uint32_t copies = 0;
+    uint32_t torn = 0;
+
+    StartRun(&config, 1000);
+    g_sync_next_us = NONE;
+    g_concurrent = true;
+    g_writer_done = false;
+
+    pthread_create(&writer, NULL, Writer, NULL);
+    while (!g_writer_done) {
+        uint32_t timestamp;
+        uint16_t value;
+
+        Oversampling_CopyPdo(pdo);
+        timestamp = (uint32_t)pdo[0] | ((uint32_t)pdo[1] << 16);
+        value = (uint16_t)((timestamp / 1000UL) & 0x7FFF);
+        for (uint8_t i = 0; i < 2 * config.factor; i++) {
+            // 迟到帧的最后一点和其后一帧的第1个点为无效, 其余须属于时间戳所在的帧
+            if (pdo[3 + i] != value && pdo[3 + i] != OVERSAMPLING_SAMPLE_INVALID) {
+                torn++;
+                break;
+            }
+        }
+        copies++;
+    }
+    pthread_join(writer, NULL);
+    g_concurrent = false;
+    if (g_dma_busy) {
+        g_dma_busy = false;
+    }
+    Oversampling_Stop();
+
+    printf("concurrent copy: %lu copies, %lu torn\n", (unsigned long)copies, (unsigned long)torn);
+    TEST_CHECK(copies > 0);
+    TEST_CHECK(torn == 0);
+}
+
+int main(void)
+{
+    Oversampling_Init();
+    TEST_CHECK(stub_nvic_priority[OVERSAMPLING_TIM_IRQ] == ADS8688_ACQ_IRQ_PRIORITY);
+
+    Test_Timing();
+    Test_Mapping();
+    Test_Capture();
+    Test_LateSample();
+    Test_BusyAndError();
+    Test_Stop();
+    Test_ConcurrentCopy();
+
+    return TEST_RESULT();
+}
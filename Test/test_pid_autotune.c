@@ -0,0 +1,343 @@
+/**
+ ******************************************************************************
+ * @file    test_pid_autotune.c
+ * @brief   继电反馈PID自整定主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 直接包含pid_autotune.c, 被控对象为一阶加纯滞后 K·e^(-θs)/(τs+1)
+ * (零阶保持精确离散化, θ为采样周期的整数倍):
+ * - 模型拟合: 由解析极限环 (振幅a, 半周期) 和θ调用PidAutotune_FitModel,
+ *   K/τ和Ku/Tu与解析值比较 (Ku/Tu: ωθ + atan(ωτ) = π 的double解)
+ * - 继电试验: θ/τ = 0.1/0.3/1/3/10 (滞后占优到纯滞后占优), 辨识的K/τ/θ,
+ *   Ku/Tu和ZN PID/ZN PI/SIMC PI参数与解析值比较; 同时打印描述函数近似
+ *   4d/(πa) 的Ku误差作为对照
+ * - 失败路径: 无振荡 (半周期超时), 偏离超限, 切换次数用完 (周期性负载
+ *   扰动使相邻周期不一致), 外部中止, 不合法的配置; 失败后输出为bias
+ ******************************************************************************
+ */
+
+#include "../Src/APP/pid_autotune.c"
+#include "test_common.h"
+#include <stdlib.h>
+
+#define PLANT_DELAY_MAX     4096
+#define SIM_MAX_TICKS       2000000UL
+#define FIT_TOLERANCE       1e-3        // 解析极限环的拟合相对误差
+#define RELAY_TOLERANCE     0.02        // 继电试验的辨识相对误差 (采样量化)
+#define MODEL_TOLERANCE     0.05        // 继电试验K/τ的相对误差: 滞后占优时e^(-θ/τ)接近1,
+                                        // 半周期的采样量化误差被放大约10倍
+
+/* 一阶加纯滞后对象 (偏差变量, 零阶保持精确离散化) */
+typedef struct {
+    double gain;
+    double tau;
+    double theta;
+    double dt;
+    double y;
+    double a;                           // e^(-dt/τ)
+    double u[PLANT_DELAY_MAX];          // 输出延迟线
+    uint32_t delay;                     // θ/dt
+    uint32_t head;
+} plant_t;
+
+static void Plant_Init(plant_t *plant, double gain, double tau, double theta, double dt)
+{
+    memset(plant, 0, sizeof(plant_t));
+    plant->gain = gain;
+    plant->tau = tau;
+    plant->theta = theta;
+    plant->dt = dt;
+    plant->a = exp(-dt / tau);
+    plant->delay = (uint32_t)(theta / dt + 0.5);
+}
+
+// 本拍输出u作用θ后到达对象, 返回下一拍的过程值
+static double Plant_Step(plant_t *plant, double u, double disturbance)
+{
+    double delayed = plant->u[plant->head];
+
+    plant->u[plant->head] = u;
+    plant->head = (plant->head + 1) % plant->delay;
+    plant->y = plant->a * plant->y + (1.0 - plant->a) * (plant->gain * delayed + disturbance);
+    return plant->y;
+}
+
+/* 解析值 */
+typedef struct {
+    double ku;
+    double tu;
+    double amplitude;                   // 继电极限环振幅
+    double half_period;
+} analytic_t;
+
+static void Analytic(double gain, double tau, double theta, double d, double eps, analytic_t *out)
+{
+    double kd = gain * d;
+    double lo = 0.0;
+    double hi = 3.141592653589793 / theta;
+    double omega;
+
+    for (int i = 0; i < 200; i++) {
+        omega = 0.5 * (lo + hi);
+        if (omega * theta + atan(omega * tau) < 3.141592653589793) {
+            lo = omega;
+        } else {
+            hi = omega;
+        }
+    }
+    omega = 0.5 * (lo + hi);
+
+    out->tu = 2.0 * 3.141592653589793 / omega;
+    out->ku = sqrt(1.0 + omega * omega * tau * tau) / gain;
+    out->amplitude = kd - (kd - eps) * exp(-theta / tau);
+    out->half_period = theta + tau * log((kd + out->amplitude) / (kd - eps));
+}
+
+static void CheckGains(const pid_autotune_result_t *result, double gain, double tau, double theta,
+                       const analytic_t *ref, double tol)
+{
+    float kp = 0.0f, ki = 0.0f, kd = 0.0f;
+
+    TEST_CHECK(PidAutotune_ComputeGains(result, PID_AUTOTUNE_RULE_ZN_PID, &kp, &ki, &kd));
+    TEST_CHECK_NEAR(kp, 0.6 * ref->ku, tol * 0.6 * ref->ku);
+    TEST_CHECK_NEAR(ki, 0.6 * ref->ku / (0.5 * ref->tu), 2.0 * tol * 0.6 * ref->ku / (0.5 * ref->tu));
+    TEST_CHECK_NEAR(kd, 0.6 * ref->ku * 0.125 * ref->tu, 2.0 * tol * 0.6 * ref->ku * 0.125 * ref->tu);
+
+    TEST_CHECK(PidAutotune_ComputeGains(result, PID_AUTOTUNE_RULE_ZN_PI, &kp, &ki, &kd));
+    TEST_CHECK_NEAR(kp, 0.45 * ref->ku, tol * 0.45 * ref->ku);
+    TEST_CHECK_NEAR(ki, 0.45 * ref->ku * 1.2 / ref->tu, 2.0 * tol * 0.45 * ref->ku * 1.2 / ref->tu);
+    TEST_CHECK(kd == 0.0f);
+
+    TEST_CHECK(PidAutotune_ComputeGains(result, PID_AUTOTUNE_RULE_SIMC_PI, &kp, &ki, &kd));
+    double simc_kp = tau / (2.0 * gain * theta);
+    double simc_ti = fmin(tau, 8.0 * theta);
+    TEST_CHECK_NEAR(kp, simc_kp, 3.0 * tol * simc_kp);
+    TEST_CHECK_NEAR(ki, simc_kp / simc_ti, 4.0 * tol * simc_kp / simc_ti);
+    TEST_CHECK(kd == 0.0f);
+}
+
+/* ========================================================================== */
+/* 模型拟合 */
+/* ========================================================================== */
+
+static void Test_FitModel(void)
+{
+    static const double ratios[] = { 0.01, 0.1, 0.3, 1.0, 3.0, 10.0, 50.0 };   // θ/τ
+    static const double eps_ratio[] = { 0.0, 0.02, 0.1 };                      // ε/(Kd)
+    const double gain = 2.5;
+    const double d = 4.0;
+
+    for (size_t r = 0; r < sizeof(ratios) / sizeof(ratios[0]); r++) {
+        for (size_t e = 0; e < sizeof(eps_ratio) / sizeof(eps_ratio[0]); e++) {
+            double tau = 10.0;
+            double theta = ratios[r] * tau;
+            double eps = eps_ratio[e] * gain * d;
+            pid_autotune_result_t result;
+            analytic_t ref;
+
+            Analytic(gain, tau, theta, d, eps, &ref);
+
+            memset(&result, 0, sizeof(result));
+            result.amplitude = (float)ref.amplitude;
+            result.tu = (float)(2.0 * ref.half_period);
+            result.dead_time = (float)theta;
+
+            TEST_CHECK(PidAutotune_FitModel(&result, (float)d, (float)eps));
+            TEST_CHECK_NEAR(result.gain, gain, FIT_TOLERANCE * gain);
+            TEST_CHECK_NEAR(result.time_constant, tau, FIT_TOLERANCE * tau);
+            TEST_CHECK_NEAR(result.ku, ref.ku, FIT_TOLERANCE * ref.ku);
+            TEST_CHECK_NEAR(result.tu, ref.tu, FIT_TOLERANCE * ref.tu);
+            CheckGains(&result, gain, tau, theta, &ref, FIT_TOLERANCE);
+        }
+    }
+
+    // 纯滞后不可信 (θ=0或半周期不大于θ) 时拟合失败
+    {
+        pid_autotune_result_t result = { 0 };
+
+        result.amplitude = 1.0f;
+        result.tu = 4.0f;
+        result.dead_time = 0.0f;
+        TEST_CHECK(!PidAutotune_FitModel(&result, 1.0f, 0.0f));
+        result.dead_time = 2.0f;
+        TEST_CHECK(!PidAutotune_FitModel(&result, 1.0f, 0.0f));
+    }
+}
+
+/* ========================================================================== */
+/* 继电试验 */
+/* ========================================================================== */
+
+typedef struct {
+    double disturbance;                 // 周期性负载扰动幅值 (输出单位)
+    double disturbance_period;          // 扰动周期 (秒)
+} run_options_t;
+
+// 运行到结束, 返回拍数
+static uint32_t RunRelay(pid_autotune_t *tuner, plant_t *plant, const pid_autotune_config_t *config,
+                         const run_options_t *options)
+{
+    double pv = config->setpoint;
+    uint32_t n;
+
+    TEST_CHECK(PidAutotune_Start(tuner, config));
+    for (n = 0; n < SIM_MAX_TICKS && tuner->state == PID_AUTOTUNE_RUNNING; n++) {
+        double u = PidAutotune_Update(tuner, (float)pv) - config->bias;
+        double w = 0.0;
+
+        if (options != NULL && options->disturbance != 0.0) {
+            w = options->disturbance * sin(6.283185307179586 * n * config->sample_time / options->disturbance_period);
+        }
+        pv = config->setpoint + Plant_Step(plant, u, w);
+    }
+
+    // 结束或失败后输出为bias
+    TEST_CHECK(PidAutotune_Update(tuner, (float)pv) == config->bias);
+    return n;
+}
+
+static void DefaultConfig(pid_autotune_config_t *config, double gain, double d, double eps, double dt)
+{
+    memset(config, 0, sizeof(pid_autotune_config_t));
+    config->setpoint = 50.0f;
+    config->bias = 30.0f;
+    config->amplitude = (float)d;
+    config->hysteresis = (float)eps;
+    config->max_deviation = (float)(1.5 * gain * d);
+    config->sample_time = (float)dt;
+    config->max_half_period = 1000.0f;
+    config->max_switches = 60;
+}
+
+static void Test_Relay(void)
+{
+    static const double ratios[] = { 0.1, 0.3, 1.0, 3.0, 10.0 };     // θ/τ
+    const double gain = 1.8;
+    const double d = 5.0;
+
+    for (size_t r = 0; r < sizeof(ratios) / sizeof(ratios[0]); r++) {
+        double theta = (ratios[r] <= 1.0) ? 2.0 : 2.0 * ratios[r];
+        double tau = theta / ratios[r];
+        double dt = fmin(theta, tau) / 200.0;
+        double eps = 0.02 * gain * d * (1.0 - exp(-theta / tau));
+        pid_autotune_config_t config;
+        pid_autotune_t tuner;
+        plant_t plant;
+        analytic_t ref;
+        uint32_t ticks;
+
+        // θ取采样周期的整数倍
+        dt = theta / ceil(theta / dt);
+        Plant_Init(&plant, gain, tau, theta, dt);
+        Analytic(gain, tau, theta, d, eps, &ref);
+        DefaultConfig(&config, gain, d, eps, dt);
+
+        ticks = RunRelay(&tuner, &plant, &config, NULL);
+
+        TEST_CHECK(tuner.state == PID_AUTOTUNE_DONE && tuner.error == PID_AUTOTUNE_ERR_NONE);
+        if (tuner.state != PID_AUTOTUNE_DONE) {
+            printf("theta/tau %.1f: state %d error %d\n", ratios[r], tuner.state, tuner.error);
+            continue;
+        }
+
+        double df_ku = 4.0 * d / (3.141592653589793 * sqrt(ref.amplitude * ref.amplitude - eps * eps));
+        printf("theta/tau %4.1f: %u switches %6.0f s, K %.4f tau %.3f theta %.3f, Ku %.4f (exact %.4f, "
+               "describing function %+.1f %%) Tu %.3f (exact %.3f)\n",
+               ratios[r], tuner.switches, ticks * dt, tuner.result.gain, tuner.result.time_constant,
+               tuner.result.dead_time, tuner.result.ku, ref.ku, 100.0 * (df_ku / ref.ku - 1.0),
+               tuner.result.tu, ref.tu);
+
+        TEST_CHECK_NEAR(tuner.result.amplitude, ref.amplitude, RELAY_TOLERANCE * ref.amplitude);
+        TEST_CHECK_NEAR(tuner.result.dead_time, theta, RELAY_TOLERANCE * theta);
+        TEST_CHECK_NEAR(tuner.result.gain, gain, MODEL_TOLERANCE * gain);
+        TEST_CHECK_NEAR(tuner.result.time_constant, tau, MODEL_TOLERANCE * tau);
+        TEST_CHECK_NEAR(tuner.result.ku, ref.ku, RELAY_TOLERANCE * ref.ku);
+        TEST_CHECK_NEAR(tuner.result.tu, ref.tu, RELAY_TOLERANCE * ref.tu);
+        CheckGains(&tuner.result, gain, tau, theta, &ref, RELAY_TOLERANCE);
+    }
+}
+
+/* ========================================================================== */
+/* 失败路径 */
+/* ========================================================================== */
+
+static void Test_Failures(void)
+{
+    const double gain = 1.8;
+    const double tau = 10.0;
+    const double theta = 2.0;
+    const double d = 5.0;
+    const double dt = 0.02;
+    const double eps = 0.02 * gain * d * (1.0 - exp(-theta / tau));
+    pid_autotune_config_t config;
+    pid_autotune_t tuner;
+    plant_t plant;
+    analytic_t ref;
+    run_options_t options;
+    float kp = 0.0f, ki = 0.0f, kd = 0.0f;
+
+    Analytic(gain, tau, theta, d, eps, &ref);
+
+    // 无振荡: 对象增益过小, 过程值到不了回差, 半周期超时
+    Plant_Init(&plant, gain * 1e-4, tau, theta, dt);
+    DefaultConfig(&config, gain, d, eps, dt);
+    config.max_half_period = 200.0f;
+    RunRelay(&tuner, &plant, &config, NULL);
+    TEST_CHECK(tuner.state == PID_AUTOTUNE_FAILED && tuner.error == PID_AUTOTUNE_ERR_NO_OSCILLATION);
+    TEST_CHECK(tuner.switches == 0);
+    TEST_CHECK_NEAR(tuner.tick * dt, config.max_half_period, 2.0 * dt);
+
+    // 偏离超限: 允许偏离小于极限环振幅
+    Plant_Init(&plant, gain, tau, theta, dt);
+    DefaultConfig(&config, gain, d, eps, dt);
+    config.max_deviation = (float)(0.5 * ref.amplitude);
+    RunRelay(&tuner, &plant, &config, NULL);
+    TEST_CHECK(tuner.state == PID_AUTOTUNE_FAILED && tuner.error == PID_AUTOTUNE_ERR_DEVIATION);
+
+    // 切换次数用完: 周期性负载扰动使相邻周期的周期/振幅相差超过5%
+    Plant_Init(&plant, gain, tau, theta, dt);
+    DefaultConfig(&config, gain, d, eps, dt);
+    config.max_switches = 40;
+    options.disturbance = 0.6 * d;
+    options.disturbance_period = 2.7 * ref.tu;
+    RunRelay(&tuner, &plant, &config, &options);
+    TEST_CHECK(tuner.state == PID_AUTOTUNE_FAILED && tuner.error == PID_AUTOTUNE_ERR_TIMEOUT);
+    TEST_CHECK(tuner.switches == config.max_switches);
+    TEST_CHECK(!PidAutotune_ComputeGains(&tuner.result, PID_AUTOTUNE_RULE_ZN_PID, &kp, &ki, &kd));
+
+    // 外部中止
+    Plant_Init(&plant, gain, tau, theta, dt);
+    DefaultConfig(&config, gain, d, eps, dt);
+    TEST_CHECK(PidAutotune_Start(&tuner, &config));
+    for (int n = 0; n < 100; n++) {
+        TEST_CHECK(PidAutotune_Update(&tuner, config.setpoint) == config.bias + config.amplitude);
+    }
+    PidAutotune_Abort(&tuner);
+    TEST_CHECK(tuner.state == PID_AUTOTUNE_FAILED && tuner.error == PID_AUTOTUNE_ERR_ABORTED);
+    TEST_CHECK(PidAutotune_Update(&tuner, config.setpoint) == config.bias);
+
+    // 不合法的配置
+    DefaultConfig(&config, gain, d, eps, dt);
+    config.amplitude = 0.0f;
+    TEST_CHECK(!PidAutotune_Start(&tuner, &config));
+    DefaultConfig(&config, gain, d, eps, dt);
+    config.max_deviation = config.hysteresis;
+    TEST_CHECK(!PidAutotune_Start(&tuner, &config));
+    DefaultConfig(&config, gain, d, eps, dt);
+    config.max_switches = 2 * (PID_AUTOTUNE_MIN_PERIODS + 1) - 1;
+    TEST_CHECK(!PidAutotune_Start(&tuner, &config));
+    TEST_CHECK(!PidAutotune_Start(&tuner, NULL));
+}
+
+int main(void)
+{
+    Test_FitModel();
+    Test_Relay();
+    Test_Failures();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,270 @@
+/**
+ ******************************************************************************
+ * @file    test_pid_batch.c
+ * @brief   批量PID计算引擎主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 与原逐回路PID_Calculate (下方参考实现, 去掉时间戳和统计字段) 比较:
+ * 随机增益/限幅/死区/使能位/激活掩码/复位/实际采样间隔, 逐周期比较输出、
+ * 积分、滤波微分和死区/饱和标志. 另检查前馈在限幅前叠加并参与抗饱和.
+ ******************************************************************************
+ */
+
+#include "pid_batch.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUN_CYCLES          200000
+
+/* ========================================================================== */
+/* 参考实现: 原PID_Calculate/PID_Reset */
+/* ========================================================================== */
+
+static float RefPid_Calculate(const pid_params_t *params, pid_state_t *state, float setpoint, float process_value)
+{
+    if (!params->enabled) {
+        return 0.0f;
+    }
+
+    float error = setpoint - process_value;
+    state->error = error;
+
+    if (fabsf(error) < params->deadband) {
+        state->in_deadband = true;
+        error = 0.0f;
+    } else {
+        state->in_deadband = false;
+    }
+
+    float p_term = params->kp * error;
+
+    float i_term = 0.0f;
+    if (params->integral_enabled && !state->in_deadband) {
+        state->integral += error * params->sample_time;
+        if (state->integral > params->integral_max) {
+            state->integral = params->integral_max;
+        }
+        if (state->integral < params->integral_min) {
+            state->integral = params->integral_min;
+        }
+        i_term = params->ki * state->integral;
+    }
+
+    float d_term = 0.0f;
+    if (params->derivative_enabled && !state->first_run) {
+        float derivative = (error - state->last_error) / params->sample_time;
+        state->filtered_derivative = params->derivative_filter * derivative +
+                                     (1.0f - params->derivative_filter) * state->filtered_derivative;
+        d_term = params->kd * state->filtered_derivative;
+    }
+
+    float output = p_term + i_term + d_term;
+
+    if (output > params->output_max) {
+        output = params->output_max;
+        state->output_saturated = true;
+        if (params->anti_windup_enabled && params->integral_enabled) {
+            state->integral -= error * params->sample_time;
+        }
+    } else if (output < params->output_min) {
+        output = params->output_min;
+        state->output_saturated = true;
+        if (params->anti_windup_enabled && params->integral_enabled) {
+            state->integral -= error * params->sample_time;
+        }
+    } else {
+        state->output_saturated = false;
+    }
+
+    state->last_error = error;
+    state->output = output;
+    state->first_run = false;
+
+    return output;
+}
+
+static void RefPid_Reset(pid_state_t *state)
+{
+    memset(state, 0, sizeof(pid_state_t));
+    state->first_run = true;
+}
+
+/* ========================================================================== */
+/* 测试 */
+/* ========================================================================== */
+
+static float RandomUniform(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+static void RandomParams(pid_params_t *params)
+{
+    memset(params, 0, sizeof(pid_params_t));
+    params->kp = RandomUniform(0.0f, 5.0f);
+    params->ki = RandomUniform(0.0f, 2.0f);
+    params->kd = RandomUniform(0.0f, 0.5f);
+    params->output_min = RandomUniform(-100.0f, 0.0f);
+    params->output_max = RandomUniform(1.0f, 100.0f);
+    params->integral_max = RandomUniform(1.0f, 50.0f);
+    params->integral_min = -params->integral_max;
+    params->derivative_filter = RandomUniform(0.05f, 1.0f);
+    params->deadband = (rand() % 3 == 0) ? RandomUniform(0.0f, 2.0f) : 0.0f;
+    params->sample_time = RandomUniform(0.005f, 0.2f);
+    params->enabled = (rand() % 8) != 0;
+    params->integral_enabled = (rand() % 4) != 0;
+    params->derivative_enabled = (rand() % 2) != 0;
+    params->anti_windup_enabled = (rand() % 4) != 0;
+}
+
+static bool Close(float a, float b)
+{
+    return fabsf(a - b) <= 1e-4f * (1.0f + fabsf(b));
+}
+
+/**
+ * @brief 随机序列与参考实现逐周期比较
+ */
+static void Test_Equivalence(void)
+{
+    static pid_batch_t batch;
+    pid_params_t params[PID_BATCH_MAX_LOOPS];
+    pid_state_t state[PID_BATCH_MAX_LOOPS];
+    float setpoint[PID_BATCH_MAX_LOOPS];
+    uint32_t value_mismatch = 0;
+    uint32_t flag_mismatch = 0;
+    uint32_t compared = 0;
+
+    PidBatch_Init(&batch);
+    for (uint8_t i = 0; i < PID_BATCH_MAX_LOOPS; i++) {
+        RandomParams(&params[i]);
+        PidBatch_SetParams(&batch, i, &params[i]);
+        PidBatch_Reset(&batch, i);
+        RefPid_Reset(&state[i]);
+        setpoint[i] = RandomUniform(-20.0f, 20.0f);
+    }
+
+    for (uint32_t cycle = 0; cycle < RUN_CYCLES; cycle++) {
+        uint32_t active_mask = (uint32_t)rand() & ((1UL << PID_BATCH_MAX_LOOPS) - 1);
+
+        for (uint8_t i = 0; i < PID_BATCH_MAX_LOOPS; i++) {
+            int event = rand() % 1000;
+
+            if (event == 0) {
+                RandomParams(&params[i]);
+                PidBatch_SetParams(&batch, i, &params[i]);
+            } else if (event == 1) {
+                PidBatch_Reset(&batch, i);
+                RefPid_Reset(&state[i]);
+            } else if (event < 20) {
+                // 非周期调度: 本次按实际间隔计算
+                float elapsed = RandomUniform(0.005f, 0.2f);
+                PidBatch_SetElapsed(&batch, i, elapsed);
+                params[i].sample_time = elapsed;
+            } else if (event < 40) {
+                setpoint[i] = RandomUniform(-20.0f, 20.0f);
+            }
+
+            batch.setpoint[i] = setpoint[i];
+            batch.process_value[i] = setpoint[i] + RandomUniform(-10.0f, 10.0f);
+            batch.feedforward[i] = 0.0f;
+        }
+
+        PidBatch_Execute(&batch, active_mask);
+
+        for (uint8_t i = 0; i < PID_BATCH_MAX_LOOPS; i++) {
+            const uint32_t bit = 1UL << i;
+
+            if ((active_mask & bit) == 0) {
+                continue;
+            }
+
+            float ref = RefPid_Calculate(&params[i], &state[i], batch.setpoint[i], batch.process_value[i]);
+            compared++;
+
+            if (!Close(batch.output[i], ref)) {
+                value_mismatch++;
+            }
+            if (!params[i].enabled) {
+                continue;
+            }
+            if (!Close(batch.integral[i], state[i].integral) ||
+                !Close(batch.filtered_derivative[i], state[i].filtered_derivative) ||
+                !Close(batch.last_error[i], state[i].last_error)) {
+                value_mismatch++;
+            }
+            if (((batch.deadband_mask & bit) != 0) != state[i].in_deadband ||
+                ((batch.saturated_mask & bit) != 0) != state[i].output_saturated) {
+                flag_mismatch++;
+            }
+        }
+    }
+
+    printf("equivalence: %u loop updates, %u value and %u flag mismatches\n",
+           (unsigned)compared, (unsigned)value_mismatch, (unsigned)flag_mismatch);
+    TEST_CHECK(compared > RUN_CYCLES);
+    TEST_CHECK(value_mismatch == 0);
+    TEST_CHECK(flag_mismatch == 0);
+}
+
+/**
+ * @brief 前馈在限幅前叠加, 饱和时回退积分
+ */
+static void Test_Feedforward(void)
+{
+    static pid_batch_t batch;
+    pid_params_t params;
+
+    memset(&params, 0, sizeof(params));
+    params.kp = 1.0f;
+    params.ki = 1.0f;
+    params.output_min = 0.0f;
+    params.output_max = 10.0f;
+    params.integral_min = -100.0f;
+    params.integral_max = 100.0f;
+    params.sample_time = 0.1f;
+    params.enabled = true;
+    params.integral_enabled = true;
+    params.anti_windup_enabled = true;
+
+    PidBatch_Init(&batch);
+    PidBatch_SetParams(&batch, 0, &params);
+
+    // 未饱和: 输出 = Kp*e + Ki*I + ff
+    batch.setpoint[0] = 2.0f;
+    batch.process_value[0] = 1.0f;
+    batch.feedforward[0] = 3.0f;
+    PidBatch_Execute(&batch, 1);
+    TEST_CHECK_NEAR(batch.output[0], 1.0 + 0.1 + 3.0, 1e-6);
+    TEST_CHECK((batch.saturated_mask & 1) == 0);
+
+    // 前馈推到上限: 输出钳位, 本周期积分回退
+    batch.feedforward[0] = 9.5f;
+    PidBatch_Execute(&batch, 1);
+    TEST_CHECK(batch.output[0] == 10.0f);
+    TEST_CHECK((batch.saturated_mask & 1) != 0);
+    TEST_CHECK_NEAR(batch.integral[0], 0.1, 1e-6);
+
+    // 激活但未使能: 输出0, 状态不变
+    params.enabled = false;
+    PidBatch_SetParams(&batch, 0, &params);
+    PidBatch_Execute(&batch, 1);
+    TEST_CHECK(batch.output[0] == 0.0f);
+    TEST_CHECK_NEAR(batch.integral[0], 0.1, 1e-6);
+}
+
+int main(void)
+{
+    srand(7);
+
+    Test_Equivalence();
+    Test_Feedforward();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,313 @@
+/**
+ ******************************************************************************
+ * @file    test_process_image.c
+ * @brief   TxPDO过程映像转换主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 参考实现为原ethercat_sensor_bridge.c的_float_to_int16_scaled (逐字复制),
+ *   窄量程通道 (液位/泵流量%) 再按表中上下限钳位
+ * - 0x6000-0x6007每个条目逐一扫描: 饱和边界及其相邻ulp, 截断边界,
+ *   ±0/±Inf/±FLT_MAX/NaN和随机值, 映像须与参考逐位一致且其他条目不变
+ * - 双缓冲发布: 应用数据和传感器快照经ProcessImage_UpdateFromSensors
+ *   到达ProcessImage_GetTxPdo, 映射检查
+ * - 主机基准: 查表转换与逐字段调用原函数的每映像耗时
+ ******************************************************************************
+ */
+
+#include "ethercat_process_image.h"
+#include "test_common.h"
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RANDOM_VALUES       100000
+#define BENCH_IMAGES        1000000UL
+
+static double NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* ========================================================================== */
+/* 参考实现 */
+/* ========================================================================== */
+
+/**
+ * @brief 浮点数转有符号16位整数（带缩放）
+ */
+static int16_t _float_to_int16_scaled(float value, float scale)
+{
+    float scaled_value = value * scale;
+
+    if (scaled_value > 32767.0f) {
+        return 32767;
+    } else if (scaled_value < -32768.0f) {
+        return -32768;
+    } else {
+        return (int16_t)scaled_value;
+    }
+}
+
+static int16_t ReferenceConvert(const process_image_channel_t *ch, float value)
+{
+    int16_t result;
+
+    // 原函数对NaN做(int16_t)转换 (C未定义), Cortex-M4 VCVT结果为0
+    if (isnan(value)) {
+        return 0;
+    }
+
+    result = _float_to_int16_scaled(value + ch->offset, ch->scale);
+    if (result > ch->max) {
+        result = ch->max;
+    } else if (result < ch->min) {
+        result = ch->min;
+    }
+    return result;
+}
+
+// 逐字段转换 (原桥接模块的写法), 基准对照
+static void LegacyConvert(const sensor_context_t *s, const float *appl, int16_t *image)
+{
+    for (uint8_t i = 0; i < 8; i++) {
+        image[i] = _float_to_int16_scaled(appl[PI_APPL_INPUT_STATUS + i], 1.0f);
+    }
+    image[8] = _float_to_int16_scaled(s->temp_values[0], 10.0f);
+    image[9] = _float_to_int16_scaled(s->temp_values[1], 10.0f);
+    image[10] = _float_to_int16_scaled(s->level_values[3], 10.0f);
+    if (image[10] < 0) {
+        image[10] = 0;
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        int16_t percent = _float_to_int16_scaled(appl[PI_APPL_SUPPLY_PUMP_PERCENT + i], 10.0f);
+
+        image[11 + i] = (percent < 0) ? 0 : (percent > 1000) ? 1000 : percent;
+    }
+    image[13] = _float_to_int16_scaled(appl[PI_APPL_PIN_SETPOINT], 10.0f);
+    image[14] = _float_to_int16_scaled(appl[PI_APPL_POUT_SETPOINT], 10.0f);
+    for (uint8_t i = 0; i < 4; i++) {
+        image[15 + i] = _float_to_int16_scaled(s->pressure_values[i], 10.0f);
+    }
+    for (uint8_t i = 0; i < 6; i++) {
+        image[19 + i] = _float_to_int16_scaled(appl[PI_APPL_FILL_PUMP_ANIM + i], 1.0f);
+    }
+}
+
+/* ========================================================================== */
+/* 逐条目扫描 */
+/* ========================================================================== */
+
+static void SetSource(const process_image_channel_t *ch, sensor_context_t *snapshot, float *appl, float value)
+{
+    if (ch->source == PI_SOURCE_SENSOR) {
+        memcpy((uint8_t *)snapshot + ch->source_offset, &value, sizeof(float));
+    } else {
+        appl[ch->source_offset] = value;
+    }
+}
+
+// 转换一次并与参考比较, 其他条目必须保持0
+static uint32_t CheckValue(const process_image_channel_t *schema, uint16_t count, uint16_t entry, float value)
+{
+    static sensor_context_t snapshot;
+    float appl[PI_APPL_COUNT] = {0};
+    int16_t image[PROCESS_IMAGE_TXPDO_WORDS];
+    int16_t expected = ReferenceConvert(&schema[entry], value);
+    uint32_t mismatches = 0;
+
+    memset(&snapshot, 0, sizeof(snapshot));
+    SetSource(&schema[entry], &snapshot, appl, value);
+    ProcessImage_Convert(schema, count, &snapshot, appl, image);
+
+    for (uint16_t i = 0; i < count; i++) {
+        int16_t want = (i == entry) ? expected : 0;
+
+        if (image[i] != want) {
+            if (mismatches == 0) {
+                printf("0x%04X.%u value %.9g: image %d, reference %d\n", schema[entry].index,
+                       schema[entry].subindex, (double)value, image[i], want);
+            }
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static void Test_SweepEntries(void)
+{
+    uint16_t count;
+    const process_image_channel_t *schema = ProcessImage_GetSchema(&count);
+    const float specials[] = { 0.0f, -0.0f, INFINITY, -INFINITY, NAN, -NAN,
+                               FLT_MAX, -FLT_MAX, FLT_MIN, -FLT_MIN, 0.5f, -0.5f, 0.999999f };
+    uint32_t values_checked = 0;
+
+    TEST_CHECK(count == PROCESS_IMAGE_TXPDO_WORDS);
+    srand(27);
+
+    for (uint16_t entry = 0; entry < count; entry++) {
+        const process_image_channel_t *ch = &schema[entry];
+        const float edges[] = { (float)ch->min, (float)ch->max, (float)ch->min - 1.0f, (float)ch->max + 1.0f,
+                                -32768.0f, 32767.0f, -32769.0f, 32768.0f, 0.0f, 1.0f, -1.0f };
+        uint32_t mismatches = 0;
+
+        TEST_CHECK(ch->index >= 0x6000 && ch->index <= 0x6007);
+        TEST_CHECK(ch->min < ch->max && ch->scale > 0.0f);
+
+        for (size_t i = 0; i < sizeof(specials) / sizeof(specials[0]); i++) {
+            mismatches += CheckValue(schema, count, entry, specials[i]);
+            values_checked++;
+        }
+
+        // 饱和/截断边界: 工程值及其两侧各8个ulp
+        for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+            float up = edges[i] / ch->scale - ch->offset;
+            float down = up;
+
+            mismatches += CheckValue(schema, count, entry, up);
+            for (uint8_t k = 0; k < 8; k++) {
+                up = nextafterf(up, INFINITY);
+                down = nextafterf(down, -INFINITY);
+                mismatches += CheckValue(schema, count, entry, up);
+                mismatches += CheckValue(schema, count, entry, down);
+            }
+            values_checked += 17;
+        }
+
+        // 随机值覆盖两倍INT16量程
+        for (uint32_t n = 0; n < RANDOM_VALUES; n++) {
+            float value = (float)(((double)rand() / RAND_MAX * 2.0 - 1.0) * 65536.0 / ch->scale);
+
+            mismatches += CheckValue(schema, count, entry, value);
+        }
+        values_checked += RANDOM_VALUES;
+
+        TEST_CHECK(mismatches == 0);
+    }
+
+    printf("sweep: %u entries, %lu values, bit-exact against _float_to_int16_scaled\n",
+           count, (unsigned long)values_checked);
+}
+
+/* ========================================================================== */
+/* 发布路径 */
+/* ========================================================================== */
+
+static void Test_Publish(void)
+{
+    sensor_context_t snapshot;
+    uint32_t mapping[PROCESS_IMAGE_TXPDO_WORDS];
+    uint16_t count;
+    const process_image_channel_t *schema = ProcessImage_GetSchema(&count);
+    const int16_t *image;
+    const int16_t *previous;
+
+    ProcessImage_Init();
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.temp_values[0] = 25.37f;
+    snapshot.temp_values[1] = -3.21f;
+    snapshot.level_values[3] = -4.0f;
+    snapshot.pressure_values[2] = 123.45f;
+    ProcessImage_SetApplValue(PI_APPL_ALARM_2, 4660.0f);
+    ProcessImage_SetApplValue(PI_APPL_SUPPLY_PUMP_PERCENT, 150.0f);
+    ProcessImage_SetApplValue(PI_APPL_RETURN_PUMP_PERCENT, 37.55f);
+    ProcessImage_SetApplValue(PI_APPL_DRUM_RETURN_VALVE_ANIM, 1.0f);
+    ProcessImage_SetApplValue(PI_APPL_COUNT, 99.0f);
+
+    // 写入后备缓冲, 刷新前发布的映像不变
+    previous = ProcessImage_GetTxPdo();
+    TEST_CHECK(previous[3] == 0);
+    ProcessImage_UpdateFromSensors(&snapshot);
+    image = ProcessImage_GetTxPdo();
+    TEST_CHECK(image != previous);
+
+    TEST_CHECK(image[3] == 4660);           // 0x6001.2
+    TEST_CHECK(image[8] == 253);            // 0x6004.1 0.1°C
+    TEST_CHECK(image[9] == -32);            // 0x6004.2 向零截断
+    TEST_CHECK(image[10] == 0);             // 0x6004.3 液位不为负
+    TEST_CHECK(image[11] == 1000);          // 0x6005.1 饱和到100.0%
+    TEST_CHECK(image[12] == 375);           // 0x6005.2
+    TEST_CHECK(image[17] == 1234);          // 0x6007.3
+    TEST_CHECK(image[24] == 1);             // 0x6007.10
+
+    ProcessImage_UpdateFromSensors(NULL);
+    TEST_CHECK(ProcessImage_GetTxPdo() == image);
+
+    // 0x1A00映射与映像表一致
+    for (uint16_t i = 0; i < count; i++) {
+        mapping[i] = ((uint32_t)schema[i].index << 16) | ((uint32_t)schema[i].subindex << 8) | 0x10u;
+    }
+    TEST_CHECK(ProcessImage_MatchesMapping(mapping, count));
+    TEST_CHECK(!ProcessImage_MatchesMapping(mapping, count - 1));
+    mapping[5] ^= 0x0100u;
+    TEST_CHECK(!ProcessImage_MatchesMapping(mapping, count));
+    TEST_CHECK(!ProcessImage_MatchesMapping(NULL, count));
+}
+
+/* ========================================================================== */
+/* 基准 */
+/* ========================================================================== */
+
+static void Test_Benchmark(void)
+{
+    static sensor_context_t snapshot;
+    float appl[PI_APPL_COUNT];
+    int16_t image[PROCESS_IMAGE_TXPDO_WORDS];
+    int16_t legacy[PROCESS_IMAGE_TXPDO_WORDS];
+    uint16_t count;
+    const process_image_channel_t *schema = ProcessImage_GetSchema(&count);
+    volatile int32_t sink = 0;
+    double table_ns;
+    double legacy_ns;
+
+    memset(&snapshot, 0, sizeof(snapshot));
+    for (uint8_t i = 0; i < PI_APPL_COUNT; i++) {
+        appl[i] = 3.7f * i;
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        snapshot.pressure_values[i] = 50.0f + i;
+    }
+    snapshot.temp_values[0] = 25.0f;
+    snapshot.level_values[3] = 40.0f;
+
+    ProcessImage_Convert(schema, count, &snapshot, appl, image);
+    LegacyConvert(&snapshot, appl, legacy);
+    TEST_CHECK(memcmp(image, legacy, sizeof(image)) == 0);
+
+    table_ns = NowNs();
+    for (uint32_t n = 0; n < BENCH_IMAGES; n++) {
+        snapshot.pressure_values[n & 3] += 0.01f;
+        ProcessImage_Convert(schema, count, &snapshot, appl, image);
+        sink += image[15];
+    }
+    table_ns = NowNs() - table_ns;
+
+    legacy_ns = NowNs();
+    for (uint32_t n = 0; n < BENCH_IMAGES; n++) {
+        snapshot.pressure_values[n & 3] -= 0.01f;
+        LegacyConvert(&snapshot, appl, legacy);
+        sink += legacy[15];
+    }
+    legacy_ns = NowNs() - legacy_ns;
+
+    printf("host time per %u-entry image: table %.1f ns, per-field %.1f ns\n",
+           count, table_ns / BENCH_IMAGES, legacy_ns / BENCH_IMAGES);
+    (void)sink;
+}
+
+int main(void)
+{
+    Test_SweepEntries();
+    Test_Publish();
+    Test_Benchmark();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,174 @@
+/**
+ ******************************************************************************
+ * @file    test_sensor_calib.c
+ * @brief   传感器多点标定拟合主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 无噪声数据: 0/1/2阶拟合精确恢复系数, 残差为0
+ * - 带噪声数据: 1阶拟合与双精度闭式最小二乘一致
+ * - 大偏置量程 (x在10000附近): 归一化后二次拟合仍然准确
+ * - 点数不足/测量值重合/参数越界时返回失败且不改写系数
+ ******************************************************************************
+ */
+
+#include "sensor_calib.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdlib.h>
+
+static float Noise(float amplitude)
+{
+    return amplitude * (2.0f * (float)rand() / (float)RAND_MAX - 1.0f);
+}
+
+/**
+ * @brief 无噪声数据精确恢复
+ */
+static void Test_Exact(void)
+{
+    float x[SENSOR_CALIB_MAX_POINTS];
+    float y[SENSOR_CALIB_MAX_POINTS];
+    float coeffs[SENSOR_CALIB_COEFF_COUNT];
+    float rms = -1.0f;
+
+    // 2阶: y = 0.002x^2 + 1.5x - 3
+    for (uint8_t i = 0; i < 5; i++) {
+        x[i] = -20.0f + 15.0f * i;
+        y[i] = 0.002f * x[i] * x[i] + 1.5f * x[i] - 3.0f;
+    }
+    TEST_CHECK(SensorCalib_Fit(x, y, 5, 2, coeffs, &rms));
+    TEST_CHECK_NEAR(coeffs[0], -3.0, 1e-4);
+    TEST_CHECK_NEAR(coeffs[1], 1.5, 1e-5);
+    TEST_CHECK_NEAR(coeffs[2], 0.002, 1e-7);
+    TEST_CHECK(rms < 1e-4f);
+
+    // 1阶两点: 即两点标定, c2清零
+    x[0] = 1.0f; y[0] = 10.0f;
+    x[1] = 3.0f; y[1] = 14.0f;
+    coeffs[2] = 0.5f;
+    TEST_CHECK(SensorCalib_Fit(x, y, 2, 1, coeffs, &rms));
+    TEST_CHECK_NEAR(coeffs[0], 8.0, 1e-5);
+    TEST_CHECK_NEAR(coeffs[1], 2.0, 1e-6);
+    TEST_CHECK(coeffs[2] == 0.0f);
+    TEST_CHECK_NEAR(SensorCalib_Apply(coeffs, 2.0f), 12.0, 1e-5);
+
+    // 0阶: 保留c1/c2, 零点取残差均值
+    coeffs[0] = 0.0f;
+    coeffs[1] = 2.0f;
+    coeffs[2] = 0.01f;
+    x[0] = 5.0f; y[0] = 2.0f * 5.0f + 0.01f * 25.0f + 0.7f;
+    x[1] = 7.0f; y[1] = 2.0f * 7.0f + 0.01f * 49.0f + 0.9f;
+    TEST_CHECK(SensorCalib_Fit(x, y, 2, 0, coeffs, &rms));
+    TEST_CHECK_NEAR(coeffs[0], 0.8, 1e-5);
+    TEST_CHECK(coeffs[1] == 2.0f && coeffs[2] == 0.01f);
+    TEST_CHECK_NEAR(rms, 0.1, 1e-5);
+}
+
+/**
+ * @brief 带噪声数据与闭式最小二乘比较
+ */
+static void Test_Noisy(void)
+{
+    float x[SENSOR_CALIB_MAX_POINTS];
+    float y[SENSOR_CALIB_MAX_POINTS];
+    float coeffs[SENSOR_CALIB_COEFF_COUNT];
+    float rms;
+
+    for (int trial = 0; trial < 200; trial++) {
+        double sx = 0, sy = 0, sxx = 0, sxy = 0, slope, icpt, sum_sq = 0;
+        const uint8_t n = SENSOR_CALIB_MAX_POINTS;
+
+        for (uint8_t i = 0; i < n; i++) {
+            x[i] = 100.0f * i + Noise(5.0f);
+            y[i] = 0.25f * x[i] + 12.0f + Noise(0.5f);
+            sx += x[i];
+            sy += y[i];
+            sxx += (double)x[i] * x[i];
+            sxy += (double)x[i] * y[i];
+        }
+        slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+        icpt = (sy - slope * sx) / n;
+        for (uint8_t i = 0; i < n; i++) {
+            double e = slope * x[i] + icpt - y[i];
+            sum_sq += e * e;
+        }
+
+        TEST_CHECK(SensorCalib_Fit(x, y, n, 1, coeffs, &rms));
+        TEST_CHECK_NEAR(coeffs[1], slope, 1e-6);
+        TEST_CHECK_NEAR(coeffs[0], icpt, 1e-4);
+        TEST_CHECK_NEAR(rms, sqrt(sum_sq / n), 1e-5);
+    }
+}
+
+/**
+ * @brief 大偏置量程的二次拟合
+ */
+static void Test_Conditioning(void)
+{
+    float x[SENSOR_CALIB_MAX_POINTS];
+    float y[SENSOR_CALIB_MAX_POINTS];
+    float coeffs[SENSOR_CALIB_COEFF_COUNT];
+    float rms;
+    float max_err = 0.0f;
+
+    // x在10000附近, 直接解原始正规方程时x^4约1e16, 单精度/双精度都会失去有效位
+    for (uint8_t i = 0; i < 6; i++) {
+        double u = 10000.0 + 20.0 * i;
+        x[i] = (float)u;
+        y[i] = (float)(0.001 * (u - 10050.0) * (u - 10050.0) + 3.0 * (u - 10050.0) + 40.0);
+    }
+    TEST_CHECK(SensorCalib_Fit(x, y, 6, 2, coeffs, &rms));
+
+    // 系数以原始x存储, 在标定点上以双精度展开检查 (单精度Apply在此量程下自身有抵消误差)
+    for (uint8_t i = 0; i < 6; i++) {
+        double fit = ((double)coeffs[2] * x[i] + coeffs[1]) * x[i] + coeffs[0];
+        if (fabs(fit - y[i]) > max_err) {
+            max_err = (float)fabs(fit - y[i]);
+        }
+    }
+    printf("conditioning: max residual %.3g at x ~ 1e4\n", max_err);
+    TEST_CHECK(max_err < 0.01f);
+    TEST_CHECK_NEAR(coeffs[2], 0.001, 1e-6);
+}
+
+/**
+ * @brief 失败情形
+ */
+static void Test_Rejects(void)
+{
+    float x[3] = {1.0f, 1.0f, 1.0f};
+    float y[3] = {1.0f, 2.0f, 3.0f};
+    float coeffs[SENSOR_CALIB_COEFF_COUNT] = {7.0f, 8.0f, 9.0f};
+
+    // 测量值全部相同
+    TEST_CHECK(!SensorCalib_Fit(x, y, 3, 1, coeffs, NULL));
+
+    // 两点重合, 二次方程奇异
+    x[2] = 2.0f;
+    TEST_CHECK(!SensorCalib_Fit(x, y, 3, 2, coeffs, NULL));
+
+    // 点数不足 / 阶数越界 / 点数越界
+    TEST_CHECK(!SensorCalib_Fit(x, y, 2, 2, coeffs, NULL));
+    TEST_CHECK(!SensorCalib_Fit(x, y, 3, SENSOR_CALIB_MAX_ORDER + 1, coeffs, NULL));
+    TEST_CHECK(!SensorCalib_Fit(x, y, SENSOR_CALIB_MAX_POINTS + 1, 1, coeffs, NULL));
+    TEST_CHECK(!SensorCalib_Fit(x, y, 0, 0, coeffs, NULL));
+
+    // 失败时不改写系数
+    TEST_CHECK(coeffs[0] == 7.0f && coeffs[1] == 8.0f && coeffs[2] == 9.0f);
+}
+
+int main(void)
+{
+    srand(3);
+
+    Test_Exact();
+    Test_Noisy();
+    Test_Conditioning();
+    Test_Rejects();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,253 @@
+/**
+ ******************************************************************************
+ * @file    test_sensor_filter.c
+ * @brief   传感器滤波链主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 双二阶 (CMSIS-DSP arm_biquad_cascade_df1_f32): 与双精度差分方程参考
+ *   响应逐点比较, 检查巴特沃斯设计的直流增益和截止频率处-3dB
+ * - 移动平均/指数/中值: 与逐点暴力计算比较, 覆盖多次绕圈
+ * - 首样本预置为稳态; NaN/Inf不进入状态, 输出保持
+ ******************************************************************************
+ */
+
+#include "sensor_filter.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUN_SAMPLES         20000
+
+static float RandomUniform(float lo, float hi)
+{
+    return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+static sensor_filter_config_t OneStage(sensor_filter_type_t type, uint8_t length, float alpha)
+{
+    sensor_filter_config_t config;
+
+    memset(&config, 0, sizeof(config));
+    config.stage_count = 1;
+    config.stages[0].type = type;
+    config.stages[0].length = length;
+    config.stages[0].alpha = alpha;
+    return config;
+}
+
+static int CompareFloat(const void *a, const void *b)
+{
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief 双二阶参考响应: 双精度DF1, 与CMSIS同一差分方程
+ */
+static void Test_BiquadReference(void)
+{
+    sensor_filter_config_t config = OneStage(SENSOR_FILTER_BIQUAD, 2, 0.0f);
+    sensor_filter_t filter;
+    double x1[2] = {0}, x2[2] = {0}, y1[2] = {0}, y2[2] = {0};
+    double max_err = 0.0;
+    double peak = 0.0;
+    const float fs = 100.0f;
+    const float fc = 5.0f;
+
+    // 两节相同的二阶巴特沃斯 (4阶, 截止处-6dB)
+    TEST_CHECK(!SensorFilter_DesignLowpass(fs * 0.5f, fs, &config.stages[0].coeffs[0]));
+    TEST_CHECK(SensorFilter_DesignLowpass(fc, fs, &config.stages[0].coeffs[0]));
+    TEST_CHECK(SensorFilter_DesignLowpass(fc, fs, &config.stages[0].coeffs[5]));
+    TEST_CHECK(SensorFilter_Init(&filter, &config));
+
+    // 首样本0预置为零状态, 与参考一致
+    SensorFilter_Process(&filter, 0.0f);
+
+    for (int n = 0; n < RUN_SAMPLES; n++) {
+        // 阶跃 + 截止频率正弦 + 噪声
+        float x = ((n >= 100) ? 1.0f : 0.0f) + 0.5f * sinf(2.0f * (float)M_PI * fc * (float)n / fs) +
+                  RandomUniform(-0.05f, 0.05f);
+        double v = x;
+        float y = SensorFilter_Process(&filter, x);
+
+        for (int s = 0; s < 2; s++) {
+            const float *c = &config.stages[0].coeffs[5 * s];
+            double out = c[0] * v + c[1] * x1[s] + c[2] * x2[s] + c[3] * y1[s] + c[4] * y2[s];
+            x2[s] = x1[s];
+            x1[s] = v;
+            y2[s] = y1[s];
+            y1[s] = out;
+            v = out;
+        }
+
+        if (fabs(y - v) > max_err) {
+            max_err = fabs(y - v);
+        }
+    }
+    printf("biquad: max |cmsis - reference| = %.3g\n", max_err);
+    TEST_CHECK(max_err < 1e-4);
+
+    // 单节: 直流增益1, 截止频率处幅值1/sqrt(2)
+    config = OneStage(SENSOR_FILTER_BIQUAD, 1, 0.0f);
+    SensorFilter_DesignLowpass(fc, fs, config.stages[0].coeffs);
+    SensorFilter_Init(&filter, &config);
+    SensorFilter_Process(&filter, 0.0f);
+    for (int n = 0; n < 2000; n++) {
+        float y = SensorFilter_Process(&filter, sinf(2.0f * (float)M_PI * fc * (float)n / fs));
+        if (n >= 1000 && fabsf(y) > peak) {
+            peak = fabsf(y);
+        }
+    }
+    TEST_CHECK_NEAR(peak, 0.70710678, 0.01);
+
+    SensorFilter_Init(&filter, &config);
+    SensorFilter_Process(&filter, 0.0f);
+    for (int n = 0; n < 500; n++) {
+        peak = SensorFilter_Process(&filter, 2.5f);
+    }
+    TEST_CHECK_NEAR(peak, 2.5, 1e-4);
+}
+
+/**
+ * @brief 移动平均/指数/中值与暴力计算比较
+ */
+static void Test_WindowStages(void)
+{
+    static float history[RUN_SAMPLES];
+    sensor_filter_config_t config;
+    sensor_filter_t filter;
+    float window[SENSOR_FILTER_MEDIAN_MAX_LENGTH];
+    double ma_err = 0.0;
+    double ema_err = 0.0;
+    int median_mismatch = 0;
+    float ema = 0.0f;
+
+    for (int n = 0; n < RUN_SAMPLES; n++) {
+        history[n] = 50.0f + RandomUniform(-1.0f, 1.0f) + ((rand() % 50 == 0) ? 40.0f : 0.0f);
+    }
+
+    // 移动平均, 窗口10 (首样本预置为稳态, 窗口以首样本补齐)
+    config = OneStage(SENSOR_FILTER_MOVING_AVERAGE, 10, 0.0f);
+    TEST_CHECK(SensorFilter_Init(&filter, &config));
+    for (int n = 0; n < RUN_SAMPLES; n++) {
+        float y = SensorFilter_Process(&filter, history[n]);
+        double sum = 0.0;
+        for (int k = 0; k < 10; k++) {
+            sum += (n - k >= 0) ? history[n - k] : history[0];
+        }
+        if (fabs(y - sum / 10.0) > ma_err) {
+            ma_err = fabs(y - sum / 10.0);
+        }
+    }
+    TEST_CHECK(ma_err < 1e-3);
+
+    // 指数滤波
+    config = OneStage(SENSOR_FILTER_EXPONENTIAL, 0, 0.2f);
+    TEST_CHECK(SensorFilter_Init(&filter, &config));
+    for (int n = 0; n < RUN_SAMPLES; n++) {
+        float y = SensorFilter_Process(&filter, history[n]);
+        ema = (n == 0) ? history[0] : ema + 0.2f * (history[n] - ema);
+        if (fabs(y - ema) > ema_err) {
+            ema_err = fabs(y - ema);
+        }
+    }
+    TEST_CHECK(ema_err < 1e-4);
+
+    // 中值滤波, 窗口5
+    config = OneStage(SENSOR_FILTER_MEDIAN, 5, 0.0f);
+    TEST_CHECK(SensorFilter_Init(&filter, &config));
+    for (int n = 0; n < RUN_SAMPLES; n++) {
+        float y = SensorFilter_Process(&filter, history[n]);
+        for (int k = 0; k < 5; k++) {
+            window[k] = (n - k >= 0) ? history[n - k] : history[0];
+        }
+        qsort(window, 5, sizeof(float), CompareFloat);
+        if (y != window[2]) {
+            median_mismatch++;
+        }
+    }
+    TEST_CHECK(median_mismatch == 0);
+
+    // 非法配置
+    config = OneStage(SENSOR_FILTER_MEDIAN, 4, 0.0f);
+    TEST_CHECK(!SensorFilter_CheckConfig(&config));
+    config = OneStage(SENSOR_FILTER_EXPONENTIAL, 0, 0.0f);
+    TEST_CHECK(!SensorFilter_CheckConfig(&config));
+}
+
+/**
+ * @brief 非有限样本被丢弃, 输出保持, 之后的结果与只含有限样本的序列相同
+ */
+static void Test_NonFinite(void)
+{
+    sensor_filter_config_t config;
+    sensor_filter_t filter;
+    sensor_filter_t clean;
+    float y;
+    float ref;
+    int mismatch = 0;
+
+    memset(&config, 0, sizeof(config));
+    config.stage_count = 4;
+    config.stages[0].type = SENSOR_FILTER_MEDIAN;
+    config.stages[0].length = 5;
+    config.stages[1].type = SENSOR_FILTER_MOVING_AVERAGE;
+    config.stages[1].length = 8;
+    config.stages[2].type = SENSOR_FILTER_EXPONENTIAL;
+    config.stages[2].alpha = 0.3f;
+    config.stages[3].type = SENSOR_FILTER_BIQUAD;
+    config.stages[3].length = 1;
+    SensorFilter_DesignLowpass(2.0f, 50.0f, config.stages[3].coeffs);
+
+    TEST_CHECK(SensorFilter_Init(&filter, &config));
+    TEST_CHECK(SensorFilter_Init(&clean, &config));
+
+    // 尚未预置时非有限样本原样返回, 不预置
+    y = SensorFilter_Process(&filter, NAN);
+    TEST_CHECK(isnan(y) && !filter.primed && filter.rejected == 1);
+
+    // 首样本预置为稳态
+    y = SensorFilter_Process(&filter, 3.0f);
+    SensorFilter_Process(&clean, 3.0f);
+    TEST_CHECK_NEAR(y, 3.0, 1e-5);
+
+    for (int n = 0; n < 5000; n++) {
+        float x = 3.0f + RandomUniform(-0.5f, 0.5f);
+
+        if (n % 97 == 0) {
+            float held = filter.output;
+            y = SensorFilter_Process(&filter, (n % 2) ? INFINITY : NAN);
+            TEST_CHECK(y == held);
+            y = SensorFilter_Process(&filter, -INFINITY);
+            TEST_CHECK(y == held);
+        }
+
+        y = SensorFilter_Process(&filter, x);
+        ref = SensorFilter_Process(&clean, x);
+        if (!isfinite(y) || y != ref) {
+            mismatch++;
+        }
+    }
+
+    TEST_CHECK(mismatch == 0);
+    TEST_CHECK(filter.samples == clean.samples);
+    TEST_CHECK(filter.rejected == 1 + 2 * ((5000 + 96) / 97));
+}
+
+int main(void)
+{
+    srand(1);
+
+    Test_BiquadReference();
+    Test_WindowStages();
+    Test_NonFinite();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,160 @@
+/**
+ ******************************************************************************
+ * @file    test_sensor_linearize.c
+ * @brief   温度线性化查表主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - CVD正向公式与IEC 60751 Pt100分度表比较, 反解与正向公式往返
+ * - Steinhart-Hart与双精度计算比较
+ * - 查找表 (传感器任务使用的范围/点数/插值方式) 与双精度解析公式的最大误差
+ * - 超出范围钳位, 参数校验
+ ******************************************************************************
+ */
+
+#include "sensor_linearize.h"
+#include "test_common.h"
+#include <math.h>
+
+// 与sensor_task_v3.c一致
+#define PT100_R_MIN         80.0f
+#define PT100_R_MAX         160.0f
+#define NTC_RATIO_MIN       0.05f
+#define NTC_RATIO_MAX       0.80f
+
+static const sensor_rtd_params_t g_pt100 = {100.0f};
+static const sensor_ntc_params_t g_ntc = {
+    1.009249522e-3f, 2.378405444e-4f, 2.019202697e-7f, 10000.0f
+};
+
+// 双精度CVD反解 (二分法)
+static double RtdTemperatureRef(double resistance)
+{
+    double lo = -200.0, hi = 850.0;
+
+    for (int n = 0; n < 100; n++) {
+        double t = 0.5 * (lo + hi);
+        double r = 1.0 + 3.9083e-3 * t - 5.775e-7 * t * t;
+        if (t < 0.0) {
+            r += -4.183e-12 * (t - 100.0) * t * t * t;
+        }
+        if (100.0 * r < resistance) {
+            lo = t;
+        } else {
+            hi = t;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+// 双精度Steinhart-Hart
+static double NtcTemperatureRef(double ratio)
+{
+    double ln_r = log(10000.0 * ratio / (1.0 - ratio));
+
+    return 1.0 / (1.009249522e-3 + 2.378405444e-4 * ln_r + 2.019202697e-7 * ln_r * ln_r * ln_r) - 273.15;
+}
+
+/**
+ * @brief 解析公式
+ */
+static void Test_Formulas(void)
+{
+    // IEC 60751 Pt100分度表 (Ω)
+    static const float table[][2] = {
+        {-50.0f, 80.31f}, {-20.0f, 92.16f}, {0.0f, 100.00f}, {25.0f, 109.73f},
+        {50.0f, 119.40f}, {100.0f, 138.51f}, {150.0f, 157.33f}
+    };
+    float max_round_trip = 0.0f;
+
+    for (unsigned i = 0; i < sizeof(table) / sizeof(table[0]); i++) {
+        TEST_CHECK_NEAR(SensorLinearize_RtdResistance(table[i][0], &g_pt100), table[i][1], 0.006);
+        TEST_CHECK_NEAR(SensorLinearize_RtdTemperature(table[i][1], &g_pt100), table[i][0], 0.02);
+    }
+
+    // 往返 (0°C两侧分别走闭式解和牛顿迭代)
+    for (float t = -60.0f; t <= 160.0f; t += 0.25f) {
+        float back = SensorLinearize_RtdTemperature(SensorLinearize_RtdResistance(t, &g_pt100), &g_pt100);
+        if (fabsf(back - t) > max_round_trip) {
+            max_round_trip = fabsf(back - t);
+        }
+    }
+    printf("rtd: max round-trip error %.2g C\n", max_round_trip);
+    TEST_CHECK(max_round_trip < 2e-3f);
+
+    // 分压比0.5即10kΩ: 这组通用10k系数在10kΩ处约24.7°C (标称25°C)
+    TEST_CHECK_NEAR(SensorLinearize_NtcTemperature(0.5f, &g_ntc), 25.0, 0.5);
+    for (float ratio = 0.02f; ratio < 0.98f; ratio += 0.01f) {
+        TEST_CHECK_NEAR(SensorLinearize_NtcTemperature(ratio, &g_ntc), NtcTemperatureRef(ratio), 0.01);
+    }
+    TEST_CHECK(isnan(SensorLinearize_NtcTemperature(0.0f, &g_ntc)));
+    TEST_CHECK(isnan(SensorLinearize_NtcTemperature(1.0f, &g_ntc)));
+}
+
+/**
+ * @brief 查找表误差
+ */
+static void Test_Lookup(void)
+{
+    sensor_lut_t pt100;
+    sensor_lut_t ntc;
+    double max_pt100 = 0.0;
+    double max_ntc = 0.0;
+    const int steps = 20000;
+
+    TEST_CHECK(SensorLut_Build(&pt100, SensorLinearize_RtdTemperature, &g_pt100,
+                               PT100_R_MIN, PT100_R_MAX, SENSOR_LUT_MAX_POINTS, SENSOR_LUT_LINEAR));
+    TEST_CHECK(SensorLut_Build(&ntc, SensorLinearize_NtcTemperature, &g_ntc,
+                               NTC_RATIO_MIN, NTC_RATIO_MAX, SENSOR_LUT_MAX_POINTS, SENSOR_LUT_QUADRATIC));
+
+    for (int n = 0; n <= steps; n++) {
+        double r = PT100_R_MIN + (PT100_R_MAX - PT100_R_MIN) * n / steps;
+        double ratio = NTC_RATIO_MIN + (NTC_RATIO_MAX - NTC_RATIO_MIN) * n / steps;
+        double e1 = fabs(SensorLut_Lookup(&pt100, (float)r) - RtdTemperatureRef((float)r));
+        double e2 = fabs(SensorLut_Lookup(&ntc, (float)ratio) - NtcTemperatureRef((float)ratio));
+
+        if (e1 > max_pt100) {
+            max_pt100 = e1;
+        }
+        if (e2 > max_ntc) {
+            max_ntc = e2;
+        }
+    }
+    printf("lut: pt100 linear max error %.2g C, ntc quadratic max error %.2g C\n", max_pt100, max_ntc);
+    TEST_CHECK(max_pt100 < 0.002);
+    TEST_CHECK(max_ntc < 0.06);
+
+    // 端点与钳位
+    TEST_CHECK(SensorLut_Lookup(&pt100, PT100_R_MIN) == pt100.y[0]);
+    TEST_CHECK(SensorLut_Lookup(&pt100, 10.0f) == pt100.y[0]);
+    TEST_CHECK(SensorLut_Lookup(&pt100, 1000.0f) == pt100.y[pt100.points - 1]);
+    TEST_CHECK(SensorLut_Lookup(&pt100, NAN) == pt100.y[0]);
+    TEST_CHECK(SensorLut_Lookup(&ntc, 0.99f) == ntc.y[ntc.points - 1]);
+
+    // 表点处精确
+    for (uint16_t i = 0; i < pt100.points; i++) {
+        float x = PT100_R_MIN + (PT100_R_MAX - PT100_R_MIN) * i / (pt100.points - 1);
+        TEST_CHECK_NEAR(SensorLut_Lookup(&pt100, x), pt100.y[i], 1e-4);
+    }
+
+    // 参数校验
+    TEST_CHECK(!SensorLut_Build(&pt100, SensorLinearize_RtdTemperature, &g_pt100,
+                                PT100_R_MAX, PT100_R_MIN, 10, SENSOR_LUT_LINEAR));
+    TEST_CHECK(!SensorLut_Build(&pt100, SensorLinearize_RtdTemperature, &g_pt100,
+                                PT100_R_MIN, PT100_R_MAX, SENSOR_LUT_MAX_POINTS + 1, SENSOR_LUT_LINEAR));
+    TEST_CHECK(!SensorLut_Build(&pt100, SensorLinearize_RtdTemperature, &g_pt100,
+                                PT100_R_MIN, PT100_R_MAX, 2, SENSOR_LUT_QUADRATIC));
+    TEST_CHECK(!SensorLut_Build(&pt100, NULL, &g_pt100,
+                                PT100_R_MIN, PT100_R_MAX, 10, SENSOR_LUT_LINEAR));
+}
+
+int main(void)
+{
+    Test_Formulas();
+    Test_Lookup();
+
+    return TEST_RESULT();
+}
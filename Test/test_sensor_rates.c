@@ -0,0 +1,211 @@
+/**
+ ******************************************************************************
+ * @file    test_sensor_rates.c
+ * @brief   传感器任务多速率调度主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 以sensor_harness.h逐节拍运行传感器任务, 统计各通道的到期/输出掩码:
+ * - 默认配置下各通道的实际采样率 = 1000/sample_period_ms Hz, 输出率 = 采样率/sample_count,
+ *   与SensorTaskV3_GetOutputPeriod一致
+ * - 与全部通道按基础节拍(10ms)采样对比: 采样次数 (每次采样换算并运行滤波链),
+ *   ADS8688扫描次数和每节拍主机耗时; 打印节省的比例
+ * - SensorTaskV3_ConfigureSensor只登记待生效配置: 调用后分频/配置不变,
+ *   下一个节拍调度前生效, 之后按新的分频采样, 通道映射变化时重建ADC换算向量
+ ******************************************************************************
+ */
+
+#include <time.h>
+
+#include "sensor_harness.h"
+#include "test_common.h"
+
+#define SIM_TICKS               6000    // 60s, 各默认分频的公倍数
+#define BENCH_ROUNDS            5
+
+typedef struct {
+    uint32_t samples[SENSOR_COUNT];     // 到期采样次数
+    uint32_t outputs[SENSOR_COUNT];     // 输出更新次数
+    uint32_t total_samples;
+    uint32_t adc_scans;
+    double ns_per_tick;
+} rate_result_t;
+
+static double NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void SetCodes(uint32_t tick)
+{
+    for (uint8_t ch = 0; ch < SENSOR_ADC_CHANNELS; ch++) {
+        harness_adc_code[ch] = (uint16_t)(20000U + ch * 4000U + (tick * (ch + 3U)) % 3000U);
+    }
+}
+
+// 全部通道按基础节拍采样, 每次采样都输出 (经ConfigureSensor, 一个节拍后生效)
+static void ConfigureAllFast(void)
+{
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        sensor_config_t config = g_sensor_configs[i];
+
+        config.sample_period_ms = SENSOR_BASE_TICK_MS;
+        config.sample_count = 1;
+        TEST_CHECK(SensorTaskV3_ConfigureSensor((sensor_type_t)i, &config) == pdTRUE);
+    }
+    Harness_Tick();
+
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        TEST_CHECK(SensorTaskV3_GetOutputPeriod((sensor_type_t)i) == SENSOR_BASE_TICK_MS);
+    }
+}
+
+static void Run(rate_result_t *result, bool all_fast)
+{
+    double best = 0.0;
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; round++) {
+        TEST_CHECK(Harness_Reset() == pdPASS);
+        if (all_fast) {
+            ConfigureAllFast();
+        }
+        memset(result, 0, sizeof(*result));
+
+        uint32_t samples = g_sensor_stats.total_samples;
+        uint32_t scans = g_sensor_stats.adc_scans;
+        double elapsed = 0.0;
+
+        for (uint32_t n = 0; n < SIM_TICKS; n++) {
+            SetCodes(n);
+
+            double t0 = NowNs();
+            Harness_Tick();
+            elapsed += NowNs() - t0;
+
+            for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+                result->samples[i] += (g_sensor_due_mask >> i) & 1U;
+                result->outputs[i] += (g_sensor_output_mask >> i) & 1U;
+            }
+        }
+
+        result->total_samples = g_sensor_stats.total_samples - samples;
+        result->adc_scans = g_sensor_stats.adc_scans - scans;
+        if (round == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    result->ns_per_tick = best / SIM_TICKS;
+}
+
+static void Test_EffectiveRates(void)
+{
+    static rate_result_t multi;
+    static rate_result_t fast;
+    uint32_t expected_total = 0;
+
+    Run(&multi, false);
+
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        uint32_t period_ms = g_sensor_configs[i].sample_period_ms;
+        uint32_t decimation = g_sensor_configs[i].sample_count;
+        double sample_hz = multi.samples[i] * 1000.0 / (SIM_TICKS * SENSOR_BASE_TICK_MS);
+        double output_hz = multi.outputs[i] * 1000.0 / (SIM_TICKS * SENSOR_BASE_TICK_MS);
+
+        printf("sensor %2u: period %3u ms x %2u, sample %6.2f Hz, output %6.2f Hz\n",
+               i, period_ms, decimation, sample_hz, output_hz);
+
+        TEST_CHECK(multi.samples[i] == SIM_TICKS * SENSOR_BASE_TICK_MS / period_ms);
+        TEST_CHECK(multi.outputs[i] == multi.samples[i] / decimation);
+        TEST_CHECK(SensorTaskV3_GetOutputPeriod((sensor_type_t)i) == period_ms * decimation);
+        expected_total += multi.samples[i];
+    }
+    // 每次到期采样计入total_samples一次
+    TEST_CHECK(multi.total_samples == expected_total);
+
+    Run(&fast, true);
+
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        TEST_CHECK(fast.samples[i] == SIM_TICKS);
+        TEST_CHECK(fast.outputs[i] == SIM_TICKS);
+    }
+
+    printf("%u ticks: multi-rate %u samples / %u ADC scans / %.0f ns per tick, "
+           "all at %u ms %u samples / %u ADC scans / %.0f ns per tick (samples -%.1f %%, time -%.1f %%)\n",
+           SIM_TICKS, multi.total_samples, multi.adc_scans, multi.ns_per_tick,
+           SENSOR_BASE_TICK_MS, fast.total_samples, fast.adc_scans, fast.ns_per_tick,
+           100.0 * (1.0 - (double)multi.total_samples / fast.total_samples),
+           100.0 * (1.0 - multi.ns_per_tick / fast.ns_per_tick));
+
+    TEST_CHECK(fast.total_samples == SIM_TICKS * SENSOR_COUNT);
+    TEST_CHECK(multi.total_samples < fast.total_samples);
+    // 压力按基础节拍采样, 每个节拍都有ADC通道到期, 扫描次数相同
+    TEST_CHECK(multi.adc_scans == SIM_TICKS);
+    TEST_CHECK(fast.adc_scans == SIM_TICKS);
+}
+
+static void Test_DeferredReconfigure(void)
+{
+    sensor_config_t config;
+
+    TEST_CHECK(Harness_Reset() == pdPASS);
+    for (uint32_t n = 0; n < 20; n++) {
+        SetCodes(n);
+        Harness_Tick();
+    }
+
+    // 调用后分频和配置不变
+    config = g_sensor_configs[SENSOR_PRESSURE_1];
+    config.sample_period_ms = 40;
+    config.sample_count = 2;
+    config.channel = 7;                 // 改接CH7, 换算向量随之重建
+    TEST_CHECK(SensorTaskV3_ConfigureSensor(SENSOR_PRESSURE_1, &config) == pdTRUE);
+    TEST_CHECK(SensorTaskV3_ConfigureSensor(SENSOR_COUNT, &config) == pdFALSE);
+    TEST_CHECK(SensorTaskV3_ConfigureSensor(SENSOR_PRESSURE_1, NULL) == pdFALSE);
+    TEST_CHECK(g_sensor_rates[SENSOR_PRESSURE_1].divider == 1);
+    TEST_CHECK(g_sensor_configs[SENSOR_PRESSURE_1].channel == 3);
+    TEST_CHECK(SensorTaskV3_GetOutputPeriod(SENSOR_PRESSURE_1) == SENSOR_BASE_TICK_MS);
+
+    // 下一个节拍调度前生效: 首次采样按新分频错开 (countdown = 3 % 4 + 1)
+    uint32_t samples = 0;
+    uint32_t outputs = 0;
+    uint32_t first_due = 0;
+
+    for (uint32_t n = 0; n < 400; n++) {
+        SetCodes(n);
+        Harness_Tick();
+        if (n == 0) {
+            TEST_CHECK(g_sensor_rates[SENSOR_PRESSURE_1].divider == 4);
+            TEST_CHECK(g_sensor_rates[SENSOR_PRESSURE_1].decimation == 2);
+            TEST_CHECK(g_sensor_configs[SENSOR_PRESSURE_1].channel == 7);
+            TEST_CHECK(g_adc_unit_gain[3] == 1.0f && g_adc_unit_offset[3] == 0.0f);
+        }
+        if (Sensor_IsDue(SENSOR_PRESSURE_1)) {
+            if (samples++ == 0) {
+                first_due = n;
+            }
+        }
+        outputs += (g_sensor_output_mask >> SENSOR_PRESSURE_1) & 1U;
+    }
+
+    TEST_CHECK(first_due == 3);
+    TEST_CHECK(samples == 100);
+    TEST_CHECK(outputs == 50);
+    TEST_CHECK(SensorTaskV3_GetOutputPeriod(SENSOR_PRESSURE_1) == 80);
+    // 改接后压力1与模拟液位读同一通道, 换算相同
+    TEST_CHECK(g_sensor_context.sensors[SENSOR_PRESSURE_1].raw_value ==
+               g_adc_snapshot.value[7]);
+}
+
+int main(void)
+{
+    Test_EffectiveRates();
+    Test_DeferredReconfigure();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,149 @@
+/**
+ ******************************************************************************
+ * @file    test_sensor_scale.c
+ * @brief   ADC批量工程量换算主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 逐位一致: 全部65536个码 x 8通道, 批量路径 (LSB表乘法 + SensorScale_Apply)
+ *   与原标量路径 ((raw/65536)*量程, 再 V*k+b) 的结果逐位比较,
+ *   覆盖传感器任务使用的全部增益/偏置
+ * - 每帧耗时: 批量路径与逐通道标量路径 (主机ns, 仅作相对比较)
+ ******************************************************************************
+ */
+
+#include "sensor_scale.h"
+#include "ads8688/bsp_ads8688.h"
+#include "task_profiler.h"
+#include "test_common.h"
+#include <string.h>
+
+#define BENCH_FRAMES        200000
+
+static const float g_lsb_volts[ADS8688_ACQ_CHANNELS] = ADS8688_LSB_VOLTS_TABLE;
+
+// 原标量路径的量程
+static float ScalarRange(uint8_t ch)
+{
+    return (ch == 0 || ch == 1 || ch == 6 || ch == 7) ? 5.0f : 10.0f;
+}
+
+// 原标量路径 (逐通道, 量程分支 + 除法)
+static float ScalarValue(uint16_t raw, uint8_t ch, float k, float b)
+{
+    volatile float voltage = ((float)raw / 65536.0f) * ScalarRange(ch);
+    volatile float scaled = voltage * k;
+
+    return scaled + b;
+}
+
+// 批量路径: 与BSP_ADS8688_ConvertToVoltage相同的LSB表乘法, 再整帧换算
+static void BatchFrame(const uint16_t *raw, const float *gain, const float *offset, float *value)
+{
+    float voltage[ADS8688_ACQ_CHANNELS];
+
+    for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+        voltage[ch] = (float)raw[ch] * g_lsb_volts[ch];
+    }
+    SensorScale_Apply(voltage, gain, offset, value, ADS8688_ACQ_CHANNELS);
+}
+
+/**
+ * @brief 全码逐位比较
+ */
+static void Test_BitExact(void)
+{
+    // 传感器任务使用的增益/偏置: 变送器温度, Pt100电阻, NTC分压比, 压力, 液位, 未接 (电压)
+    static const float gains[][2] = {
+        {40.0f, -50.0f}, {1.0f / 0.00125f, 0.0f}, {1.0f / 3.3f, 0.0f},
+        {100.0f, 0.0f}, {20.0f, 0.0f}, {1.0f, 0.0f}, {0.37f, 1.25f}
+    };
+    float gain[ADS8688_ACQ_CHANNELS];
+    float offset[ADS8688_ACQ_CHANNELS];
+    uint16_t raw[ADS8688_ACQ_CHANNELS];
+    float value[ADS8688_ACQ_CHANNELS];
+    uint32_t mismatch = 0;
+    uint32_t compared = 0;
+
+    for (uint32_t g = 0; g < sizeof(gains) / sizeof(gains[0]); g++) {
+        for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+            gain[ch] = gains[g][0];
+            offset[ch] = gains[g][1];
+        }
+
+        for (uint32_t code = 0; code < 65536; code++) {
+            for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+                raw[ch] = (uint16_t)(code + ch * 8191U);
+            }
+            BatchFrame(raw, gain, offset, value);
+
+            for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+                float ref = ScalarValue(raw[ch], ch, gain[ch], offset[ch]);
+                if (memcmp(&ref, &value[ch], sizeof(float)) != 0) {
+                    mismatch++;
+                }
+                compared++;
+            }
+        }
+    }
+
+    printf("bit-exact: %u of %u values differ\n", (unsigned)mismatch, (unsigned)compared);
+    TEST_CHECK(mismatch == 0);
+
+    // 原地换算 (value与voltage相同)
+    for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+        value[ch] = (float)ch;
+        gain[ch] = 2.0f;
+        offset[ch] = 0.5f;
+    }
+    SensorScale_Apply(value, gain, offset, value, ADS8688_ACQ_CHANNELS);
+    for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+        TEST_CHECK(value[ch] == 2.0f * ch + 0.5f);
+    }
+}
+
+/**
+ * @brief 每帧耗时
+ */
+static void Bench_Frame(void)
+{
+    float gain[ADS8688_ACQ_CHANNELS] = {40, 40, 40, 100, 100, 100, 100, 20};
+    float offset[ADS8688_ACQ_CHANNELS] = {-50, -50, -50, 0, 0, 0, 0, 0};
+    uint16_t raw[ADS8688_ACQ_CHANNELS];
+    float value[ADS8688_ACQ_CHANNELS];
+    volatile float sink = 0.0f;
+    uint32_t t0, t1, t2;
+
+    t0 = Profiler_Now();
+    for (uint32_t n = 0; n < BENCH_FRAMES; n++) {
+        for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+            raw[ch] = (uint16_t)(n * 7U + ch);
+            value[ch] = ScalarValue(raw[ch], ch, gain[ch], offset[ch]);
+        }
+        sink += value[n & 7];
+    }
+    t1 = Profiler_Now();
+    for (uint32_t n = 0; n < BENCH_FRAMES; n++) {
+        for (uint8_t ch = 0; ch < ADS8688_ACQ_CHANNELS; ch++) {
+            raw[ch] = (uint16_t)(n * 7U + ch);
+        }
+        BatchFrame(raw, gain, offset, value);
+        sink += value[n & 7];
+    }
+    t2 = Profiler_Now();
+
+    printf("host time per 8-channel frame: scalar %.1f ns, batch %.1f ns\n",
+           (double)(uint32_t)(t1 - t0) / BENCH_FRAMES, (double)(uint32_t)(t2 - t1) / BENCH_FRAMES);
+    (void)sink;
+}
+
+int main(void)
+{
+    Test_BitExact();
+    Bench_Frame();
+
+    return TEST_RESULT();
+}
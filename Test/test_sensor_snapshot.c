@@ -0,0 +1,194 @@
+/**
+ ******************************************************************************
+ * @file    test_sensor_snapshot.c
+ * @brief   传感器任务ADS8688采样快照主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 以sensor_harness.h逐节拍运行传感器任务, ADS8688经真实BSP驱动访问SPI器件模型:
+ * - 共用快照: 有ADC通道到期的节拍扫描一次 (9帧, 通道地址错位时2帧后停止),
+ *   扫描次数等于有ADC通道到期的节拍数
+ * - 对照: 温度/压力/模拟液位各组到期时分别扫描 (原实现的三次扫描),
+ *   同一组转换码下两种方式的原始值/滤波值/标定值/质量/时间戳, 液位估计
+ *   和数据错误计数逐位一致; 扫描失败的节拍两种方式都将各组标为无效
+ * - 打印两种方式的SPI帧数和扫描次数
+ ******************************************************************************
+ */
+
+#include "sensor_harness.h"
+#include "test_common.h"
+
+#define SIM_TICKS               3000
+#define FAULT_PERIOD_TICKS      97      // 每97个节拍有一次扫描失败 (通道地址错位)
+#define FRAMES_PER_SCAN         (1 + SENSOR_ADC_CHANNELS)   // AUTO_RST + 8个CONT
+
+typedef struct {
+    sensor_context_t context[SIM_TICKS];
+    sensor_task_stats_t stats;
+    uint32_t spi_frames;
+    uint32_t adc_ticks;                 // 有ADC通道到期的节拍数
+    uint32_t fault_scans;               // 失败的扫描次数 (第1个CONT帧通道错位后停止, 共2帧)
+} run_result_t;
+
+static run_result_t g_shared;
+static run_result_t g_separate;
+
+// 节拍n的转换码: 各通道不同的斜坡 + 伪随机扰动, 同一节拍内不变
+static void SetCodes(uint32_t tick)
+{
+    for (uint8_t ch = 0; ch < SENSOR_ADC_CHANNELS; ch++) {
+        uint32_t noise = (tick * 2654435761UL + ch * 40503UL) >> 24;
+
+        harness_adc_code[ch] = (uint16_t)(20000U + ch * 4000U + (tick * (ch + 3U)) % 3000U + noise);
+    }
+    harness_adc_fault = ((tick % FAULT_PERIOD_TICKS) == FAULT_PERIOD_TICKS - 1) ? 1 : 0;
+}
+
+// 原实现的采样步骤: 温度/压力/模拟液位各组在读取前分别扫描ADS8688
+static void SeparateScansReadAllSensors(void)
+{
+    Sensor_UpdateSchedule();
+
+    if (Sensor_AnyDue(SENSOR_TEMP_1, SENSOR_TEMP_3)) {
+        Sensor_AcquireAdcSnapshot();
+    }
+    Sensor_ReadTemperatureSensors();
+
+    if (Sensor_AnyDue(SENSOR_PRESSURE_1, SENSOR_PRESSURE_4)) {
+        Sensor_AcquireAdcSnapshot();
+    }
+    Sensor_ReadPressureSensors();
+
+    if (Sensor_IsDue(SENSOR_LEVEL_ANALOG)) {
+        Sensor_AcquireAdcSnapshot();
+    }
+    Sensor_ReadLevelSensors();
+
+    Sensor_ReadFlowSensor();
+
+    g_sensor_context.cycle_count++;
+    g_sensor_context.last_update_time = HAL_GetTick();
+}
+
+static void Run(run_result_t *result, bool separate)
+{
+    TEST_CHECK(Harness_Reset() == pdPASS);
+
+    result->adc_ticks = 0;
+    result->fault_scans = 0;
+    for (uint32_t n = 0; n < SIM_TICKS; n++) {
+        uint32_t scans = g_sensor_stats.adc_scans;
+
+        SetCodes(n);
+
+        if (separate) {
+            // Sensor_RunCycle的其余步骤与共用快照相同
+            Profiler_CycleBegin(&g_sensor_profiler);
+            SeparateScansReadAllSensors();
+            Sensor_ServiceCalibration();
+            Sensor_UpdateContext();
+            if (++g_publish_ticks >= SENSOR_PUBLISH_TICKS) {
+                g_publish_ticks = 0;
+                Sensor_CheckSystemHealth();
+            }
+            Profiler_CycleEnd(&g_sensor_profiler);
+            stub_tick += SENSOR_BASE_TICK_MS;
+        } else {
+            Harness_Tick();
+        }
+
+        if (Sensor_AnyDue(SENSOR_TEMP_1, SENSOR_PRESSURE_4) || Sensor_IsDue(SENSOR_LEVEL_ANALOG)) {
+            result->adc_ticks++;
+        }
+        if (harness_adc_fault) {
+            result->fault_scans += g_sensor_stats.adc_scans - scans;
+        }
+        result->context[n] = g_sensor_context;
+    }
+    result->stats = g_sensor_stats;
+    result->spi_frames = harness_spi_frames;
+}
+
+static bool SameFloat(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// 采集时刻(Profiler_Now)和发布相关字段不参与比较
+static bool SameContext(const sensor_context_t *a, const sensor_context_t *b)
+{
+    for (uint8_t i = 0; i < SENSOR_COUNT; i++) {
+        const sensor_data_t *x = &a->sensors[i];
+        const sensor_data_t *y = &b->sensors[i];
+
+        if (!SameFloat(x->raw_value, y->raw_value) || !SameFloat(x->filtered_value, y->filtered_value) ||
+            !SameFloat(x->calibrated_value, y->calibrated_value) || x->timestamp != y->timestamp ||
+            x->valid != y->valid || x->quality != y->quality) {
+            return false;
+        }
+    }
+    return memcmp(a->temp_values, b->temp_values, sizeof(a->temp_values)) == 0 &&
+           memcmp(a->pressure_values, b->pressure_values, sizeof(a->pressure_values)) == 0 &&
+           memcmp(a->level_values, b->level_values, sizeof(a->level_values)) == 0 &&
+           SameFloat(a->level_estimate.level, b->level_estimate.level) &&
+           SameFloat(a->level_estimate.flow, b->level_estimate.flow) &&
+           SameFloat(a->level_estimate.level_std, b->level_estimate.level_std) &&
+           a->level_estimate.valid == b->level_estimate.valid &&
+           SameFloat(a->flow_value, b->flow_value) &&
+           a->overall_quality == b->overall_quality;
+}
+
+static void Test_SharedSnapshot(void)
+{
+    uint32_t mismatches = 0;
+    uint32_t invalid_ticks = 0;
+
+    Run(&g_shared, false);
+    Run(&g_separate, true);
+
+    for (uint32_t n = 0; n < SIM_TICKS; n++) {
+        if (!SameContext(&g_shared.context[n], &g_separate.context[n])) {
+            if (mismatches == 0) {
+                printf("first mismatch at tick %u\n", n);
+            }
+            mismatches++;
+        }
+        if (!g_shared.context[n].sensors[SENSOR_PRESSURE_1].valid) {
+            invalid_ticks++;
+        }
+    }
+
+    printf("%u ticks: shared snapshot %u scans / %u SPI frames, separate scans %u scans / %u SPI frames\n",
+           SIM_TICKS, g_shared.stats.adc_scans, g_shared.spi_frames,
+           g_separate.stats.adc_scans, g_separate.spi_frames);
+
+    TEST_CHECK(mismatches == 0);
+    TEST_CHECK(g_shared.stats.data_errors == g_separate.stats.data_errors);
+    TEST_CHECK(g_shared.stats.total_samples == g_separate.stats.total_samples);
+
+    // 有ADC通道到期的节拍各扫描一次, 每次9帧
+    TEST_CHECK(g_shared.adc_ticks == g_separate.adc_ticks);
+    TEST_CHECK(g_shared.stats.adc_scans == g_shared.adc_ticks);
+    TEST_CHECK(g_shared.fault_scans > 0);
+    TEST_CHECK(g_shared.spi_frames ==
+               (g_shared.stats.adc_scans - g_shared.fault_scans) * FRAMES_PER_SCAN + g_shared.fault_scans * 2);
+    TEST_CHECK(g_separate.spi_frames ==
+               (g_separate.stats.adc_scans - g_separate.fault_scans) * FRAMES_PER_SCAN + g_separate.fault_scans * 2);
+    TEST_CHECK(g_separate.stats.adc_scans > g_shared.stats.adc_scans);
+
+    // 数据确实来自ADC换算, 且失败的扫描使各组无效
+    TEST_CHECK(g_shared.context[SIM_TICKS - 1].pressure_values[0] > 0.0f);
+    TEST_CHECK(g_shared.context[SIM_TICKS - 1].level_values[3] > 0.0f);
+    TEST_CHECK(g_shared.stats.data_errors > 0);
+    TEST_CHECK(invalid_ticks > 0);
+}
+
+int main(void)
+{
+    Test_SharedSnapshot();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,211 @@
+/**
+ ******************************************************************************
+ * @file    test_seqlock.c
+ * @brief   seqlock快照发布主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 1个写者线程发布快照, 3个读者线程并发读取, 检查:
+ * - 读到的快照内容一致 (所有字等于快照自带的序号, 无撕裂)
+ * - Seqlock_Read返回的序号与快照内容相符, 且每个读者看到的序号不回退
+ * - 写者连续发布 (撕裂压力) 和发布之间间隔GAP_NS (仍远短于目标板的任务周期)
+ *   两种情况; 首次发布之前的读取单独计数, 不算作重试耗尽
+ * - 有间隔时重试耗尽的比例不超过MAX_FAILURE_RATE: 读者只有在一次复制期间
+ *   被抢占到写者开始两次新的发布才会重试, 连续SEQLOCK_READ_RETRIES次都如此的概率很小
+ ******************************************************************************
+ */
+
+#include "seqlock.h"
+#include "test_common.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define SNAPSHOT_WORDS      32
+#define PUBLISH_COUNT       1000000UL
+#define PACED_PUBLISH_COUNT 200000UL
+#define GAP_NS              2000U       // 有间隔时两次发布之间的时间
+#define MAX_FAILURE_RATE    1e-3        // 有间隔时重试耗尽占读取次数的上限
+#define READER_COUNT        3
+
+typedef struct {
+    uint32_t seq;
+    uint32_t words[SNAPSHOT_WORDS];
+} snapshot_t;
+
+typedef struct {
+    uint32_t reads;
+    uint32_t unpublished;               // 首次发布之前的读取
+    uint32_t failed;                    // 重试耗尽
+    uint32_t torn;
+    uint32_t mismatched;
+    uint32_t regressed;
+} reader_result_t;
+
+static snapshot_t g_buffers[2];
+static seqlock_t g_lock;
+static volatile bool g_done = false;
+static uint32_t g_publish_count;
+static uint32_t g_gap_ns;
+
+static uint64_t NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void *Writer(void *arg)
+{
+    snapshot_t snap;
+
+    (void)arg;
+    for (uint32_t n = 1; n <= g_publish_count; n++) {
+        snap.seq = n;
+        for (uint32_t i = 0; i < SNAPSHOT_WORDS; i++) {
+            snap.words[i] = n;
+        }
+        Seqlock_Publish(&g_lock, &snap);
+
+        if (g_gap_ns > 0) {
+            uint64_t start = NowNs();
+
+            while (NowNs() - start < g_gap_ns) {
+            }
+        }
+    }
+
+    g_done = true;
+    return NULL;
+}
+
+static void *Reader(void *arg)
+{
+    reader_result_t *result = (reader_result_t *)arg;
+    snapshot_t snap;
+    uint32_t sequence;
+    uint32_t last = 0;
+
+    while (!g_done) {
+        bool published = (Seqlock_GetSequence(&g_lock) > 0);
+
+        if (!Seqlock_Read(&g_lock, 0, &snap, sizeof(snap), &sequence)) {
+            if (published) {
+                result->failed++;
+            } else {
+                result->unpublished++;
+            }
+            continue;
+        }
+        result->reads++;
+
+        for (uint32_t i = 0; i < SNAPSHOT_WORDS; i++) {
+            if (snap.words[i] != snap.seq) {
+                result->torn++;
+                break;
+            }
+        }
+        if (sequence != snap.seq) {
+            result->mismatched++;
+        }
+        if (sequence < last) {
+            result->regressed++;
+        }
+        last = sequence;
+    }
+
+    return NULL;
+}
+
+static void Test_SingleThread(void)
+{
+    snapshot_t snap;
+    snapshot_t out;
+    uint32_t word;
+    uint32_t sequence = 0;
+
+    Seqlock_Init(&g_lock, &g_buffers[0], &g_buffers[1], sizeof(snapshot_t));
+
+    // 尚未发布
+    TEST_CHECK(!Seqlock_Read(&g_lock, 0, &out, sizeof(out), NULL));
+    TEST_CHECK(Seqlock_GetSequence(&g_lock) == 0);
+
+    for (uint32_t n = 1; n <= 5; n++) {
+        memset(&snap, 0, sizeof(snap));
+        snap.seq = n;
+        snap.words[SNAPSHOT_WORDS - 1] = n * 10;
+        Seqlock_Publish(&g_lock, &snap);
+
+        TEST_CHECK(Seqlock_Read(&g_lock, 0, &out, sizeof(out), &sequence));
+        TEST_CHECK(sequence == n && out.seq == n);
+        TEST_CHECK(Seqlock_GetSequence(&g_lock) == n);
+
+        // 部分读取
+        TEST_CHECK(Seqlock_Read(&g_lock, (uint16_t)(sizeof(snap) - sizeof(word)), &word, sizeof(word), NULL));
+        TEST_CHECK(word == n * 10);
+    }
+
+    // 越界读取被拒绝
+    TEST_CHECK(!Seqlock_Read(&g_lock, 1, &out, sizeof(out), NULL));
+}
+
+/**
+ * @param publish_count 发布次数
+ * @param gap_ns 两次发布之间的时间 (0=连续发布)
+ * @param max_failure_rate 重试耗尽占读取次数的上限 (<0不检查)
+ */
+static void Test_Concurrent(uint32_t publish_count, uint32_t gap_ns, double max_failure_rate)
+{
+    pthread_t writer;
+    pthread_t readers[READER_COUNT];
+    reader_result_t results[READER_COUNT];
+    uint32_t total = 0;
+    uint32_t failed = 0;
+
+    memset(results, 0, sizeof(results));
+    Seqlock_Init(&g_lock, &g_buffers[0], &g_buffers[1], sizeof(snapshot_t));
+    g_publish_count = publish_count;
+    g_gap_ns = gap_ns;
+    g_done = false;
+
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_create(&readers[i], NULL, Reader, &results[i]);
+    }
+    pthread_create(&writer, NULL, Writer, NULL);
+
+    pthread_join(writer, NULL);
+    for (int i = 0; i < READER_COUNT; i++) {
+        pthread_join(readers[i], NULL);
+    }
+
+    for (int i = 0; i < READER_COUNT; i++) {
+        TEST_CHECK(results[i].torn == 0);
+        TEST_CHECK(results[i].mismatched == 0);
+        TEST_CHECK(results[i].regressed == 0);
+        total += results[i].reads;
+        failed += results[i].failed;
+        printf("gap %u ns, reader %d: %u reads, %u retries exhausted, %u before first publish\n", gap_ns, i,
+               (unsigned)results[i].reads, (unsigned)results[i].failed, (unsigned)results[i].unpublished);
+    }
+
+    TEST_CHECK(total > 0);
+    TEST_CHECK(Seqlock_GetSequence(&g_lock) == publish_count);
+    if (max_failure_rate >= 0.0) {
+        TEST_CHECK((double)failed <= max_failure_rate * (double)(total + failed));
+    }
+}
+
+int main(void)
+{
+    Test_SingleThread();
+    Test_Concurrent(PUBLISH_COUNT, 0, -1.0);
+    Test_Concurrent(PACED_PUBLISH_COUNT, GAP_NS, MAX_FAILURE_RATE);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,264 @@
+/**
+ ******************************************************************************
+ * @file    test_stream_stats.c
+ * @brief   流式统计引擎主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 窗口最小/最大值: 每个样本与最近WINDOW_SIZE个样本的逐点扫描比较
+ *   (大量重复值, 单调递增/递减序列)
+ * - 样本不足5个时的分位数取最近秩, NaN/±Inf不计入
+ * - 长时间运行 (2^24 + 10^6个样本, 均值500 σ=10): 均值/方差与long double
+ *   两遍计算比较, P50/P95/P99与排序后的精确秩比较; 同时打印float Welford
+ *   的误差作为对照
+ * - 主机每样本耗时
+ ******************************************************************************
+ */
+
+#include "stream_stats.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define WINDOW_SAMPLES      100000
+#define LONG_RUN_SAMPLES    ((1UL << 24) + 1000000UL)
+#define BENCH_SAMPLES       1000000UL
+
+static const float g_targets[STREAM_STATS_QUANTILE_COUNT] = { 0.50f, 0.95f, 0.99f };
+
+static double NowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Box-Muller
+static double RandomGauss(double sigma)
+{
+    double u1 = ((double)rand() + 1.0) / ((double)RAND_MAX + 2.0);
+    double u2 = (double)rand() / (double)RAND_MAX;
+
+    return sigma * sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+static int CompareFloat(const void *a, const void *b)
+{
+    float x = *(const float *)a;
+    float y = *(const float *)b;
+
+    return (x > y) - (x < y);
+}
+
+// 不大于value的样本比例 (sorted为升序)
+static double RankOf(const float *sorted, size_t count, float value)
+{
+    size_t lo = 0;
+    size_t hi = count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (sorted[mid] <= value) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (double)lo / (double)count;
+}
+
+/* ========================================================================== */
+/* 窗口极值 */
+/* ========================================================================== */
+
+static void CheckWindow(const float *values, uint32_t count, const stream_stats_summary_t *summary)
+{
+    uint32_t first = (count > STREAM_STATS_WINDOW_SIZE) ? (count - STREAM_STATS_WINDOW_SIZE) : 0;
+    float lo = values[first];
+    float hi = values[first];
+
+    for (uint32_t i = first + 1; i < count; i++) {
+        lo = fminf(lo, values[i]);
+        hi = fmaxf(hi, values[i]);
+    }
+    TEST_CHECK(summary->window_min == lo);
+    TEST_CHECK(summary->window_max == hi);
+}
+
+static void Test_Window(void)
+{
+    static float values[WINDOW_SAMPLES];
+    stream_stats_t stats;
+    stream_stats_summary_t summary;
+    int failures = test_failures;
+
+    // 随机序列, 取值只有10种 (大量相等值)
+    srand(3);
+    StreamStats_Init(&stats);
+    for (uint32_t n = 0; n < WINDOW_SAMPLES; n++) {
+        values[n] = (float)(rand() % 10);
+        StreamStats_Update(&stats, values[n]);
+        StreamStats_GetSummary(&stats, &summary);
+        CheckWindow(values, n + 1, &summary);
+        if (test_failures != failures) {
+            break;
+        }
+    }
+
+    // 单调递增: 最小值为窗口最早的样本; 单调递减: 最大值为窗口最早的样本
+    StreamStats_Init(&stats);
+    for (uint32_t n = 0; n < 3 * STREAM_STATS_WINDOW_SIZE; n++) {
+        values[n] = (float)n;
+        StreamStats_Update(&stats, values[n]);
+        StreamStats_GetSummary(&stats, &summary);
+        CheckWindow(values, n + 1, &summary);
+    }
+    StreamStats_Init(&stats);
+    for (uint32_t n = 0; n < 3 * STREAM_STATS_WINDOW_SIZE; n++) {
+        values[n] = -(float)n;
+        StreamStats_Update(&stats, values[n]);
+        StreamStats_GetSummary(&stats, &summary);
+        CheckWindow(values, n + 1, &summary);
+    }
+}
+
+/* ========================================================================== */
+/* 少量样本与非有限值 */
+/* ========================================================================== */
+
+static void Test_SmallAndNonFinite(void)
+{
+    const float values[] = { 4.0f, 1.0f, 3.0f, 2.0f };
+    stream_stats_t stats;
+    stream_stats_summary_t summary;
+
+    StreamStats_Init(&stats);
+    TEST_CHECK(!StreamStats_GetSummary(&stats, &summary));
+    TEST_CHECK(summary.count == 0 && summary.mean == 0.0f);
+    TEST_CHECK(StreamStats_GetQuantile(&stats, STREAM_STATS_P50) == 0.0f);
+
+    // NaN/±Inf不计入任何统计
+    StreamStats_Update(&stats, NAN);
+    StreamStats_Update(&stats, INFINITY);
+    StreamStats_Update(&stats, -INFINITY);
+    TEST_CHECK(stats.count == 0);
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        StreamStats_Update(&stats, values[i]);
+        StreamStats_Update(&stats, INFINITY);
+    }
+    StreamStats_Update(&stats, -INFINITY);
+    TEST_CHECK(StreamStats_GetSummary(&stats, &summary));
+    TEST_CHECK(summary.count == 4);
+    TEST_CHECK_NEAR(summary.mean, 2.5, 1e-6);
+    TEST_CHECK_NEAR(summary.variance, 5.0 / 3.0, 1e-6);
+    TEST_CHECK(summary.min == 1.0f && summary.max == 4.0f);
+    TEST_CHECK(summary.window_min == 1.0f && summary.window_max == 4.0f);
+
+    // 最近秩: round(p·(n-1)) -> 排序后 [1 2 3 4] 的第2/3/3个
+    TEST_CHECK(summary.quantiles[STREAM_STATS_P50] == 3.0f);
+    TEST_CHECK(summary.quantiles[STREAM_STATS_P95] == 4.0f);
+    TEST_CHECK(summary.quantiles[STREAM_STATS_P99] == 4.0f);
+    TEST_CHECK(StreamStats_GetQuantile(&stats, STREAM_STATS_QUANTILE_COUNT) == 0.0f);
+}
+
+/* ========================================================================== */
+/* 长时间运行 */
+/* ========================================================================== */
+
+static void Test_LongRun(void)
+{
+    float *values = malloc(LONG_RUN_SAMPLES * sizeof(float));
+    stream_stats_t stats;
+    stream_stats_summary_t summary;
+    long double sum = 0.0L;
+    long double sum_sq = 0.0L;
+    long double mean;
+    long double variance;
+    float float_mean = 0.0f;
+    float float_m2 = 0.0f;
+    double ns;
+
+    TEST_CHECK(values != NULL);
+    if (values == NULL) {
+        return;
+    }
+
+    srand(5);
+    StreamStats_Init(&stats);
+    for (uint32_t n = 0; n < LONG_RUN_SAMPLES; n++) {
+        float delta;
+
+        values[n] = (float)(500.0 + RandomGauss(10.0));
+        StreamStats_Update(&stats, values[n]);
+
+        // 对照: 原float累加量
+        delta = values[n] - float_mean;
+        float_mean += delta / (float)(n + 1);
+        float_m2 += delta * (values[n] - float_mean);
+    }
+
+    // 精确值: long double两遍计算
+    for (uint32_t n = 0; n < LONG_RUN_SAMPLES; n++) {
+        sum += values[n];
+    }
+    mean = sum / LONG_RUN_SAMPLES;
+    for (uint32_t n = 0; n < LONG_RUN_SAMPLES; n++) {
+        sum_sq += (values[n] - mean) * (values[n] - mean);
+    }
+    variance = sum_sq / (LONG_RUN_SAMPLES - 1);
+
+    TEST_CHECK(StreamStats_GetSummary(&stats, &summary));
+    TEST_CHECK(summary.count == LONG_RUN_SAMPLES);
+    printf("long run %lu samples: mean error %.2e (float Welford %.2e), variance rel error %.2e "
+           "(float Welford %.2e)\n", LONG_RUN_SAMPLES,
+           fabs(summary.mean - (double)mean), fabs(float_mean - (double)mean),
+           fabs(summary.variance - (double)variance) / (double)variance,
+           fabs(float_m2 / (LONG_RUN_SAMPLES - 1) - (double)variance) / (double)variance);
+    TEST_CHECK_NEAR(summary.mean, (double)mean, 1e-4);
+    TEST_CHECK_NEAR(summary.variance, (double)variance, 1e-5 * (double)variance);
+    TEST_CHECK_NEAR(summary.stddev, sqrt((double)variance), 1e-5 * sqrt((double)variance));
+
+    // 分位数: 估计值在全部样本中的秩与目标分位相差不超过0.2%
+    qsort(values, LONG_RUN_SAMPLES, sizeof(float), CompareFloat);
+    TEST_CHECK(summary.min == values[0] && summary.max == values[LONG_RUN_SAMPLES - 1]);
+    for (uint8_t i = 0; i < STREAM_STATS_QUANTILE_COUNT; i++) {
+        double rank = RankOf(values, LONG_RUN_SAMPLES, summary.quantiles[i]);
+        float exact = values[(size_t)(g_targets[i] * (LONG_RUN_SAMPLES - 1) + 0.5f)];
+
+        printf("P%.0f: estimate %.4f, exact %.4f, rank %.5f\n",
+               100.0 * g_targets[i], summary.quantiles[i], exact, rank);
+        TEST_CHECK_NEAR(rank, g_targets[i], 0.002);
+        // 标记点的期望位置与实际位置在2^24之后仍一致
+        TEST_CHECK(stats.quantiles[i].n[4] == (int32_t)LONG_RUN_SAMPLES - 1);
+        TEST_CHECK_NEAR(stats.quantiles[i].np[2], g_targets[i] * (LONG_RUN_SAMPLES - 1.0), 1e-3);
+        TEST_CHECK(fabs(stats.quantiles[i].np[2] - stats.quantiles[i].n[2]) < 1.0);
+    }
+
+    // 每样本耗时
+    StreamStats_Init(&stats);
+    ns = NowNs();
+    for (uint32_t n = 0; n < BENCH_SAMPLES; n++) {
+        StreamStats_Update(&stats, values[(n * 7919UL) % LONG_RUN_SAMPLES]);
+    }
+    ns = NowNs() - ns;
+    printf("host time per sample: %.1f ns\n", ns / BENCH_SAMPLES);
+
+    free(values);
+}
+
+int main(void)
+{
+    Test_Window();
+    Test_SmallAndNonFinite();
+    Test_LongRun();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,226 @@
+/**
+ ******************************************************************************
+ * @file    test_task_profiler.c
+ * @brief   任务分阶段周期计时主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * 主机时钟下1个计数=1ns:
+ * - 直方图档边界: 0, 1, 2^k-1, 2^k, 超出范围归入最后一档; 与目标板
+ *   32-CLZ(us) 的档号逐个比较
+ * - Profiler_Record的最小/最大/平均值, Profiler_GetSummary/GetCycleTimes换算为微秒
+ * - Profiler_Phase结束上一阶段 (忙等已知时长), 无效阶段号关闭当前阶段,
+ *   Profiler_CycleEnd结束打开的阶段; 复位后统计清零
+ * - 连续调用Profiler_Phase测量单个标记的开销 (见task_profiler.h), 打印主机结果
+ ******************************************************************************
+ */
+
+#include "task_profiler.h"
+#include "test_common.h"
+#include <string.h>
+
+#define NS_PER_US           1000U
+#define OVERHEAD_MARKERS    100000U
+
+static const char *const g_phase_names[] = {"read", "compute", "write"};
+
+static void BusyWaitUs(uint32_t us)
+{
+    uint32_t start = Profiler_Now();
+
+    while (Profiler_Now() - start < us * NS_PER_US) {
+    }
+}
+
+static void Test_HistBin(void)
+{
+    TEST_CHECK(Profiler_HistBin(0) == 0);
+    TEST_CHECK(Profiler_HistBin(1) == 1);
+    TEST_CHECK(Profiler_HistBin(2) == 2);
+    TEST_CHECK(Profiler_HistBin(3) == 2);
+
+    // 第k档 [2^(k-1), 2^k)us
+    for (uint8_t k = 1; k < PROFILER_HIST_BINS - 1; k++) {
+        TEST_CHECK(Profiler_HistBin((1UL << k) - 1) == k);
+        TEST_CHECK(Profiler_HistBin(1UL << k) == k + 1);
+    }
+
+    // 最后一档收纳 >= 2^(PROFILER_HIST_BINS-2) us的所有耗时
+    TEST_CHECK(Profiler_HistBin(1UL << (PROFILER_HIST_BINS - 2)) == PROFILER_HIST_BINS - 1);
+    TEST_CHECK(Profiler_HistBin(1UL << (PROFILER_HIST_BINS - 1)) == PROFILER_HIST_BINS - 1);
+    TEST_CHECK(Profiler_HistBin(1UL << 31) == PROFILER_HIST_BINS - 1);
+    TEST_CHECK(Profiler_HistBin(UINT32_MAX) == PROFILER_HIST_BINS - 1);
+
+    // 与目标板的CLZ实现一致
+    uint32_t mismatches = 0;
+
+    for (uint32_t us = 1; us < (1UL << 22); us++) {
+        uint32_t bin = 32U - (uint32_t)__builtin_clz(us);
+
+        if (bin > PROFILER_HIST_BINS - 1) {
+            bin = PROFILER_HIST_BINS - 1;
+        }
+        mismatches += (Profiler_HistBin(us) != bin);
+    }
+    TEST_CHECK(mismatches == 0);
+}
+
+static void Test_Record(void)
+{
+    profiler_t profiler;
+    profiler_summary_t summary;
+    uint32_t max_us;
+    uint32_t mean_us;
+
+    Profiler_Init(&profiler, g_phase_names, 3);
+
+    // 未测量时全零
+    TEST_CHECK(Profiler_GetSummary(&profiler, 0, &summary));
+    TEST_CHECK(summary.count == 0 && summary.min_us == 0.0f && summary.max_us == 0.0f && summary.mean_us == 0.0f);
+    Profiler_GetCycleTimes(&profiler, &max_us, &mean_us);
+    TEST_CHECK(max_us == 0 && mean_us == 0);
+
+    // 0.5us, 3us, 1000us, 10.5us
+    Profiler_Record(&profiler.phases[1], 500, profiler.cycles_per_us);
+    Profiler_Record(&profiler.phases[1], 3000, profiler.cycles_per_us);
+    Profiler_Record(&profiler.phases[1], 1000000, profiler.cycles_per_us);
+    Profiler_Record(&profiler.phases[1], 10500, profiler.cycles_per_us);
+
+    TEST_CHECK(profiler.phases[1].min_cycles == 500);
+    TEST_CHECK(profiler.phases[1].max_cycles == 1000000);
+    TEST_CHECK(profiler.phases[1].total_cycles == 1014000);
+
+    TEST_CHECK(Profiler_GetSummary(&profiler, 1, &summary));
+    TEST_CHECK(strcmp(summary.name, "compute") == 0);
+    TEST_CHECK(summary.count == 4);
+    TEST_CHECK_NEAR(summary.min_us, 0.5f, 1e-6f);
+    TEST_CHECK_NEAR(summary.max_us, 1000.0f, 1e-3f);
+    TEST_CHECK_NEAR(summary.mean_us, 253.5f, 1e-3f);
+    TEST_CHECK(summary.hist[0] == 1);                       // 0.5us -> 0us
+    TEST_CHECK(summary.hist[2] == 1);                       // 3us
+    TEST_CHECK(summary.hist[4] == 1);                       // 10us
+    TEST_CHECK(summary.hist[10] == 1);                      // 1000us
+
+    // 其他阶段和整个周期不受影响
+    TEST_CHECK(Profiler_GetSummary(&profiler, 0, &summary) && summary.count == 0);
+    TEST_CHECK(Profiler_GetSummary(&profiler, PROFILER_PHASE_NONE, &summary));
+    TEST_CHECK(summary.name == NULL && summary.count == 0);
+    TEST_CHECK(!Profiler_GetSummary(&profiler, 3, &summary));
+    TEST_CHECK(!Profiler_GetSummary(&profiler, 0, NULL));
+
+    // 整个周期的最大/平均值 (整微秒截断)
+    Profiler_Record(&profiler.cycle, 2500, profiler.cycles_per_us);
+    Profiler_Record(&profiler.cycle, 7999, profiler.cycles_per_us);
+    Profiler_GetCycleTimes(&profiler, &max_us, &mean_us);
+    TEST_CHECK(max_us == 7);
+    TEST_CHECK(mean_us == 5);
+}
+
+static void Test_Phases(void)
+{
+    profiler_t profiler;
+    profiler_summary_t summary;
+    profiler_summary_t phase_summary[3];
+    uint32_t cycle_us;
+
+    Profiler_Init(&profiler, g_phase_names, 3);
+
+    for (uint32_t n = 0; n < 5; n++) {
+        Profiler_CycleBegin(&profiler);
+        Profiler_Phase(&profiler, 0);
+        BusyWaitUs(200);
+        TEST_CHECK(profiler.phases[0].count == n);          // 阶段打开期间未记录
+
+        Profiler_Phase(&profiler, 1);                       // 结束阶段0
+        TEST_CHECK(profiler.phases[0].count == n + 1);
+        TEST_CHECK(profiler.phases[1].count == n);
+        BusyWaitUs(500);
+
+        Profiler_Phase(&profiler, PROFILER_PHASE_NONE);     // 结束阶段1, 不打开新阶段
+        TEST_CHECK(profiler.phases[1].count == n + 1);
+        TEST_CHECK(profiler.current == PROFILER_PHASE_NONE);
+        BusyWaitUs(100);                                    // 不计入任何阶段
+
+        Profiler_Phase(&profiler, 2);
+        BusyWaitUs(300);
+        cycle_us = Profiler_CycleEnd(&profiler);            // 结束阶段2
+        TEST_CHECK(profiler.phases[2].count == n + 1);
+        TEST_CHECK(profiler.current == PROFILER_PHASE_NONE);
+        TEST_CHECK(cycle_us >= 1100);
+    }
+
+    // 周期结束后不再有打开的阶段, 再次结束只记录整个周期
+    Profiler_CycleEnd(&profiler);
+    TEST_CHECK(profiler.phases[2].count == 5);
+    TEST_CHECK(profiler.cycle.count == 6);
+
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_CHECK(Profiler_GetSummary(&profiler, i, &phase_summary[i]));
+        TEST_CHECK(phase_summary[i].count == 5);
+    }
+    TEST_CHECK(phase_summary[0].min_us >= 200.0f);
+    TEST_CHECK(phase_summary[1].min_us >= 500.0f);
+    TEST_CHECK(phase_summary[2].min_us >= 300.0f);
+    TEST_CHECK(phase_summary[0].hist[8] + phase_summary[0].hist[9] + phase_summary[0].hist[10] == 5);
+
+    // 整个周期覆盖各阶段和阶段之间的时间
+    TEST_CHECK(Profiler_GetSummary(&profiler, PROFILER_PHASE_NONE, &summary));
+    TEST_CHECK(summary.max_us >= phase_summary[0].max_us + phase_summary[2].min_us + 600.0f);
+
+    // 复位: 统计清零, 最小值重新开始
+    Profiler_Reset(&profiler);
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_CHECK(Profiler_GetSummary(&profiler, i, &summary));
+        TEST_CHECK(summary.count == 0 && summary.max_us == 0.0f);
+        TEST_CHECK(profiler.phases[i].min_cycles == UINT32_MAX);
+        TEST_CHECK(profiler.phases[i].total_cycles == 0);
+    }
+    TEST_CHECK(profiler.cycle.count == 0);
+    for (uint8_t b = 0; b < PROFILER_HIST_BINS; b++) {
+        TEST_CHECK(profiler.cycle.hist[b] == 0 && profiler.phases[0].hist[b] == 0);
+    }
+
+    Profiler_CycleBegin(&profiler);
+    Profiler_Phase(&profiler, 1);
+    Profiler_CycleEnd(&profiler);
+    TEST_CHECK(profiler.phases[1].count == 1 && profiler.phases[1].min_cycles == profiler.phases[1].max_cycles);
+
+    // 阶段数超出上限时截断
+    Profiler_Init(&profiler, NULL, PROFILER_MAX_PHASES + 2);
+    TEST_CHECK(profiler.phase_count == PROFILER_MAX_PHASES);
+    TEST_CHECK(Profiler_GetSummary(&profiler, 0, &summary) && summary.name == NULL);
+}
+
+// 连续的标记之间没有其他工作, 阶段耗时即单个标记的开销 (读计数器 + Profiler_Record)
+static void Test_MarkerOverhead(void)
+{
+    profiler_t profiler;
+    profiler_summary_t summary;
+
+    Profiler_Init(&profiler, g_phase_names, 3);
+
+    Profiler_CycleBegin(&profiler);
+    for (uint32_t n = 0; n < OVERHEAD_MARKERS; n++) {
+        Profiler_Phase(&profiler, 0);
+    }
+    Profiler_CycleEnd(&profiler);
+
+    TEST_CHECK(Profiler_GetSummary(&profiler, 0, &summary));
+    TEST_CHECK(summary.count == OVERHEAD_MARKERS);
+    printf("host marker overhead: min %.0f ns, mean %.1f ns over %u markers\n",
+           summary.min_us * NS_PER_US, summary.mean_us * NS_PER_US, summary.count);
+    TEST_CHECK(summary.mean_us < 10.0f);
+}
+
+int main(void)
+{
+    Test_HistBin();
+    Test_Record();
+    Test_Phases();
+    Test_MarkerOverhead();
+
+    return TEST_RESULT();
+}
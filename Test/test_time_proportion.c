@@ -0,0 +1,295 @@
+/**
+ ******************************************************************************
+ * @file    test_time_proportion.c
+ * @brief   继电器时间比例输出主机测试
+ * @author  Ink Supply Control System Development Team
+ * @version V3.0.0
+ * @date    2025-01-23
+ ******************************************************************************
+ * @attention
+ *
+ * - 配置检查
+ * - 占空比精度: 各需求下长期导通比例, 调用周期整除/不整除窗口
+ * - 窗口周期: 调用周期不整除窗口时相邻窗口起点平均间隔仍为窗口长度
+ * - 最小导通/关断时间, 需求撤销提前关断, 复位立即关断
+ * - 相位错开: 三路30%需求的导通段互不重叠
+ * - 热负载仿真: 与原>50%阈值开关比较开关次数和温度波动
+ ******************************************************************************
+ */
+
+#include "time_proportion.h"
+#include "test_common.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const time_proportion_config_t g_config = { 1000, 50, 50 };
+
+/* ========================================================================== */
+/* 配置 */
+/* ========================================================================== */
+
+static void Test_Config(void)
+{
+    time_proportion_t tp;
+    const time_proportion_config_t zero = { 0, 0, 0 };
+    const time_proportion_config_t tight = { 100, 60, 50 };
+    const time_proportion_config_t exact = { 100, 50, 50 };
+
+    TEST_CHECK(!TimeProportion_CheckConfig(NULL));
+    TEST_CHECK(!TimeProportion_CheckConfig(&zero));
+    TEST_CHECK(!TimeProportion_CheckConfig(&tight));
+    TEST_CHECK(TimeProportion_CheckConfig(&exact));
+    TEST_CHECK(!TimeProportion_Init(&tp, &tight, 0));
+    TEST_CHECK(TimeProportion_Init(&tp, &g_config, 1500));
+    TEST_CHECK(tp.phase_ms == 500);
+    TEST_CHECK(!tp.output);
+    TEST_CHECK(!TimeProportion_Update(&tp, 50.0f, 0));
+}
+
+/* ========================================================================== */
+/* 占空比和窗口周期 */
+/* ========================================================================== */
+
+typedef struct {
+    uint32_t on_ms;
+    uint32_t total_ms;
+    uint32_t rising_edges;
+    uint32_t first_rise_ms;
+    uint32_t last_rise_ms;
+    uint32_t min_on_ms;
+    uint32_t min_off_ms;
+} duty_result_t;
+
+// 恒定需求运行duration_ms, 统计导通时间/上升沿/最短导通段和关断段 (不含首尾不完整段)
+static void RunConstant(float demand, uint32_t elapsed_ms, uint32_t duration_ms, duty_result_t *result)
+{
+    time_proportion_t tp;
+    bool last = false;
+    bool seen_edge = false;
+    uint32_t segment_ms = 0;
+
+    memset(result, 0, sizeof(duty_result_t));
+    result->min_on_ms = UINT32_MAX;
+    result->min_off_ms = UINT32_MAX;
+    TimeProportion_Init(&tp, &g_config, 0);
+
+    for (uint32_t t = 0; t < duration_ms; t += elapsed_ms) {
+        bool output = TimeProportion_Update(&tp, demand, elapsed_ms);
+
+        if (output != last) {
+            if (seen_edge) {
+                uint32_t *min_ms = last ? &result->min_on_ms : &result->min_off_ms;
+                if (segment_ms < *min_ms) *min_ms = segment_ms;
+            }
+            if (output) {
+                if (result->rising_edges == 0) result->first_rise_ms = t;
+                result->last_rise_ms = t;
+                result->rising_edges++;
+            }
+            seen_edge = true;
+            segment_ms = 0;
+            last = output;
+        }
+        segment_ms += elapsed_ms;
+        result->on_ms += output ? elapsed_ms : 0;
+        result->total_ms += elapsed_ms;
+    }
+}
+
+static void Test_DutyAccuracy(void)
+{
+    const float demands[] = { 2.0f, 5.0f, 10.0f, 25.0f, 50.0f, 77.0f, 96.0f, 100.0f };
+    const uint32_t periods[] = { 10, 30, 7 };
+    double max_error = 0.0;
+    duty_result_t r;
+
+    for (size_t p = 0; p < sizeof(periods) / sizeof(periods[0]); p++) {
+        for (size_t d = 0; d < sizeof(demands) / sizeof(demands[0]); d++) {
+            RunConstant(demands[d], periods[p], 600000, &r);
+            double duty = 100.0 * r.on_ms / r.total_ms;
+
+            max_error = fmax(max_error, fabs(duty - demands[d]));
+            TEST_CHECK_NEAR(duty, demands[d], 0.2);
+            if (demands[d] < 100.0f) {
+                TEST_CHECK(r.min_on_ms >= g_config.min_on_ms);
+                TEST_CHECK(r.min_off_ms >= g_config.min_off_ms);
+            }
+        }
+    }
+    printf("duty: max error %.3f %% over 10/30/7 ms periods\n", max_error);
+}
+
+static void Test_WindowPeriod(void)
+{
+    const uint32_t periods[] = { 10, 30, 7, 300 };
+    duty_result_t r;
+
+    // 50%需求每窗口一个导通段: 上升沿平均间隔即窗口长度 (不按调用周期向上取整)
+    for (size_t p = 0; p < sizeof(periods) / sizeof(periods[0]); p++) {
+        RunConstant(50.0f, periods[p], 300000, &r);
+        double period = (double)(r.last_rise_ms - r.first_rise_ms) / (r.rising_edges - 1);
+
+        TEST_CHECK_NEAR(period, g_config.window_ms, 1.0);
+        TEST_CHECK(r.rising_edges >= 299 && r.rising_edges <= 300);
+    }
+}
+
+/* ========================================================================== */
+/* 需求撤销/复位 */
+/* ========================================================================== */
+
+static void Test_DemandDropAndReset(void)
+{
+    time_proportion_t tp;
+    uint32_t t;
+
+    // 导通20ms后需求撤销: 满足最小导通时间后立即关断, 不等导通段结束
+    TimeProportion_Init(&tp, &g_config, 0);
+    for (t = 0; t < 20; t += 10) {
+        TEST_CHECK(TimeProportion_Update(&tp, 80.0f, 10));
+    }
+    for (; t < g_config.min_on_ms; t += 10) {
+        TEST_CHECK(TimeProportion_Update(&tp, 0.0f, 10));
+    }
+    TEST_CHECK(!TimeProportion_Update(&tp, 0.0f, 10));
+
+    // 复位立即关断, 之后至少关断min_off_ms
+    TimeProportion_Init(&tp, &g_config, 0);
+    TEST_CHECK(TimeProportion_Update(&tp, 100.0f, 10));
+    TimeProportion_Reset(&tp);
+    TEST_CHECK(!tp.output);
+    TEST_CHECK(tp.switch_count == 2);
+    for (t = 0; t + 10 < g_config.min_off_ms; t += 10) {
+        TEST_CHECK(!TimeProportion_Update(&tp, 100.0f, 10));
+    }
+    // 复位后的残余窗口不导通, 下一窗口起点恢复
+    for (; tp.phase_ms != 0; t += 10) {
+        TimeProportion_Update(&tp, 100.0f, 10);
+    }
+    TEST_CHECK(TimeProportion_Update(&tp, 100.0f, 10));
+}
+
+/* ========================================================================== */
+/* 相位错开 */
+/* ========================================================================== */
+
+static void Test_PhaseStagger(void)
+{
+    const uint32_t periods[] = { 10, 30 };
+
+    // 与执行器任务相同的偏移 (window/3): 三路各30%时导通段不重叠
+    for (size_t p = 0; p < sizeof(periods) / sizeof(periods[0]); p++) {
+        time_proportion_t tp[3];
+        uint32_t overlap_ticks = 0;
+        uint32_t on_ticks = 0;
+
+        for (uint8_t i = 0; i < 3; i++) {
+            TimeProportion_Init(&tp[i], &g_config, i * g_config.window_ms / 3);
+        }
+        for (uint32_t t = 0; t < 300000; t += periods[p]) {
+            int on = 0;
+
+            for (uint8_t i = 0; i < 3; i++) {
+                on += TimeProportion_Update(&tp[i], 30.0f, periods[p]) ? 1 : 0;
+            }
+            overlap_ticks += (on > 1) ? 1 : 0;
+            on_ticks += (on > 0) ? 1 : 0;
+        }
+        TEST_CHECK(on_ticks > 0);
+        TEST_CHECK(overlap_ticks == 0);
+    }
+}
+
+/* ========================================================================== */
+/* 热负载仿真 */
+/* ========================================================================== */
+
+#define THERMAL_TICK_MS         10      // 执行器任务周期
+#define THERMAL_PID_MS          20      // 控制任务周期
+#define THERMAL_RUN_MS          3600000 // 1 h
+#define THERMAL_SETTLE_MS       600000  // 前10 min不计波动
+
+typedef struct {
+    uint32_t switches;
+    double ripple;          // 稳定后温度峰峰值 (°C)
+    double mean_error;      // 稳定后平均偏差 (°C)
+} thermal_result_t;
+
+// 加热块: tau=60 s, 全功率稳态高于环境60°C; 温度测量含±0.05°C噪声; PI同控制任务温度回路默认参数
+static void RunThermal(bool time_proportion, thermal_result_t *result)
+{
+    time_proportion_t tp;
+    double temperature = 20.0;
+    double integral = 0.0;
+    double t_min = 1e9, t_max = -1e9, error_sum = 0.0;
+    uint32_t error_count = 0;
+    float demand = 0.0f;
+    bool output = false;
+    bool last = false;
+
+    srand(11);
+    memset(result, 0, sizeof(thermal_result_t));
+    TimeProportion_Init(&tp, &g_config, 0);
+
+    for (uint32_t t = 0; t < THERMAL_RUN_MS; t += THERMAL_TICK_MS) {
+        if (t % THERMAL_PID_MS == 0) {
+            double measured = temperature + 0.1 * ((double)rand() / RAND_MAX - 0.5);
+            double error = 50.0 - measured;
+            double u;
+
+            integral += error * THERMAL_PID_MS / 1000.0;
+            if (integral > 1000.0) integral = 1000.0;
+            if (integral < -1000.0) integral = -1000.0;
+            u = 2.0 * error + 0.1 * integral;
+            demand = (float)((u > 100.0) ? 100.0 : ((u < 0.0) ? 0.0 : u));
+        }
+
+        output = time_proportion ? TimeProportion_Update(&tp, demand, THERMAL_TICK_MS) : (demand > 50.0f);
+        result->switches += (output != last) ? 1 : 0;
+        last = output;
+
+        temperature += (THERMAL_TICK_MS / 1000.0) * (-(temperature - 20.0) + (output ? 60.0 : 0.0)) / 60.0;
+
+        if (t >= THERMAL_SETTLE_MS) {
+            t_min = fmin(t_min, temperature);
+            t_max = fmax(t_max, temperature);
+            error_sum += temperature - 50.0;
+            error_count++;
+        }
+    }
+
+    result->ripple = t_max - t_min;
+    result->mean_error = error_sum / error_count;
+}
+
+static void Test_ThermalLoad(void)
+{
+    thermal_result_t threshold;
+    thermal_result_t proportion;
+
+    RunThermal(false, &threshold);
+    RunThermal(true, &proportion);
+    printf("thermal 1 h: threshold %lu switches, ripple %.3f C, mean error %.3f C\n",
+           (unsigned long)threshold.switches, threshold.ripple, threshold.mean_error);
+    printf("thermal 1 h: time-proportion %lu switches, ripple %.3f C, mean error %.3f C\n",
+           (unsigned long)proportion.switches, proportion.ripple, proportion.mean_error);
+
+    // 每窗口最多一次通断
+    TEST_CHECK(proportion.switches <= 2 * (THERMAL_RUN_MS / g_config.window_ms) + 2);
+    TEST_CHECK(proportion.switches * 5 < threshold.switches);
+    TEST_CHECK(fabs(proportion.mean_error) < 0.1);
+    TEST_CHECK(proportion.ripple < 1.0);
+}
+
+int main(void)
+{
+    Test_Config();
+    Test_DutyAccuracy();
+    Test_WindowPeriod();
+    Test_DemandDropAndReset();
+    Test_PhaseStagger();
+    Test_ThermalLoad();
+
+    return TEST_RESULT();
+}